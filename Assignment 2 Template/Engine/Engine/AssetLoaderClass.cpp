@@ -0,0 +1,293 @@
+//======================================================
+//				Filename: AssetLoaderClass.cpp
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "AssetLoaderClass.h"
+#include "ProfilerClass.h"
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		AssetLoaderClass
+
+Summary:	The default constructor for an AssetLoaderClass object.
+
+Modifies:	[m_Running, m_PendingCount].
+
+Returns:	AssetLoaderClass
+				the newly created AssetLoaderClass object.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+AssetLoaderClass::AssetLoaderClass()
+{
+	m_Running = false;
+	m_PendingCount = 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		AssetLoaderClass
+
+Summary:	The reference constructor for an AssetLoaderClass object.
+
+Args:		const AssetLoaderClass& other
+				the AssetLoaderClass object to create this one in the image of.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+AssetLoaderClass::AssetLoaderClass(const AssetLoaderClass & other)
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		~AssetLoaderClass
+
+Summary:	The default deconstructor for an AssetLoaderClass object.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+AssetLoaderClass::~AssetLoaderClass()
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Initialize
+
+Summary:	Starts the worker threads of the loader.
+
+Args:		int workerCount
+				the number of worker threads to start.
+				0 uses one less than the number of hardware threads.
+
+Modifies:	[m_Workers, m_Running].
+
+Returns:	bool
+				were the worker threads started successfully.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool AssetLoaderClass::Initialize(int workerCount)
+{
+	//Leave one hardware thread for the device thread if no count was given.
+	if (workerCount <= 0)
+	{
+		workerCount = (int)std::thread::hardware_concurrency() - 1;
+		if (workerCount < 1)
+			workerCount = 1;
+	}
+
+	m_Running = true;
+
+	try
+	{
+		for (int i = 0; i < workerCount; i++)
+			m_Workers.push_back(std::thread(&AssetLoaderClass::WorkerLoop, this));
+	}
+	catch (const std::exception&)
+	{
+		Shutdown();
+		return false;
+	}
+
+	return true;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Shutdown
+
+Summary:	Stops and joins every worker thread, then fails every request
+			that had not yet completed.
+
+Modifies:	[m_Workers, m_LoadQueue, m_FinalizeQueue, m_Running, m_PendingCount].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void AssetLoaderClass::Shutdown()
+{
+	//Ask the workers to stop and wake all of them up.
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Running = false;
+	}
+	m_Condition.notify_all();
+
+	//Wait for every worker to finish the request it is currently on.
+	for (std::vector<std::thread>::iterator iter = m_Workers.begin();
+		iter != m_Workers.end();
+		iter++)
+	{
+		if (iter->joinable())
+			iter->join();
+	}
+	m_Workers.clear();
+
+	//Fail anything that never completed so waiters are released.
+	while (!m_LoadQueue.empty())
+	{
+		m_LoadQueue.front()->promise.set_value(false);
+		delete m_LoadQueue.front();
+		m_LoadQueue.pop_front();
+	}
+	while (!m_FinalizeQueue.empty())
+	{
+		m_FinalizeQueue.front()->promise.set_value(false);
+		delete m_FinalizeQueue.front();
+		m_FinalizeQueue.pop_front();
+	}
+
+	m_PendingCount = 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Request
+
+Summary:	Queues an asset for loading and returns straight away.
+
+Args:		const char* name
+				a name for the asset, used when reporting failures.
+			LoadFunction load
+				the half of the request to run on a worker thread.
+			FinalizeFunction finalize
+				the half of the request to run on the device thread.
+
+Modifies:	[m_LoadQueue, m_PendingCount].
+
+Returns:	AssetHandle
+				a shared future which becomes true once the asset is ready.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+AssetLoaderClass::AssetHandle AssetLoaderClass::Request(const char * name, LoadFunction load, FinalizeFunction finalize)
+{
+	//Create the request.
+	AssetRequest* request = new AssetRequest();
+	request->name = name;
+	request->load = load;
+	request->finalize = finalize;
+	request->loaded = false;
+
+	AssetHandle handle = request->promise.get_future().share();
+
+	//Push it onto the load queue and wake a worker.
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_LoadQueue.push_back(request);
+		m_PendingCount++;
+	}
+	m_Condition.notify_one();
+
+	return handle;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Update
+
+Summary:	Runs the finalize half of requests whose load half has finished.
+			Must only be called from the device thread.
+
+Args:		ID3D11Device* device
+				the device to create resources with.
+			int maxFinalizes
+				the most requests to finalize this call, to bound the
+				amount of work added to a single frame.
+
+Modifies:	[m_FinalizeQueue, m_PendingCount].
+
+Returns:	int
+				the number of requests completed by this call.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+int AssetLoaderClass::Update(ID3D11Device * device, int maxFinalizes)
+{
+	int completed = 0;
+
+	while (completed < maxFinalizes)
+	{
+		//Take the next loaded request, if any.
+		AssetRequest* request;
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			if (m_FinalizeQueue.empty())
+				break;
+
+			request = m_FinalizeQueue.front();
+			m_FinalizeQueue.pop_front();
+		}
+
+		//Create the device resources, only if the load half succeeded.
+		bool result = request->loaded && request->finalize(device);
+		if (!result)
+		{
+			std::string message = "AssetLoaderClass: failed to load " + request->name + "\n";
+			OutputDebugStringA(message.c_str());
+		}
+
+		request->promise.set_value(result);
+		delete request;
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_PendingCount--;
+		}
+
+		completed++;
+	}
+
+	return completed;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetPendingCount
+
+Summary:	Returns the number of requests that have not yet completed.
+
+Modifies:	[none].
+
+Returns:	int
+				the number of requests still loading or waiting to finalize.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+int AssetLoaderClass::GetPendingCount()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	return m_PendingCount;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		WorkerLoop
+
+Summary:	The body of each worker thread. Waits for a request, runs its
+			load half and hands it back to the device thread.
+
+Modifies:	[m_LoadQueue, m_FinalizeQueue].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void AssetLoaderClass::WorkerLoop()
+{
+	PROFILE_THREAD_NAME("Asset loader");
+
+	for (;;)
+	{
+		//Wait for a request or for shutdown.
+		AssetRequest* request;
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_Condition.wait(lock, [this] { return !m_Running || !m_LoadQueue.empty(); });
+
+			if (!m_Running)
+				return;
+
+			request = m_LoadQueue.front();
+			m_LoadQueue.pop_front();
+		}
+
+		//Run the load half outside of the lock.
+		try
+		{
+			PROFILE_ZONE("AssetLoader load");
+			request->loaded = request->load();
+		}
+		catch (const std::exception&)
+		{
+			request->loaded = false;
+		}
+
+		//Hand the request back to the device thread.
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_FinalizeQueue.push_back(request);
+		}
+	}
+}
@@ -0,0 +1,135 @@
+#pragma once
+//======================================================
+//				Filename: AssetLoaderClass.h
+//======================================================
+
+
+//======================================================
+//					Include Guards.
+//======================================================
+#ifndef _ASSETLOADERCLASS_H_
+#define _ASSETLOADERCLASS_H_
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <d3d11_1.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		AssetLoaderClass
+
+Summary:	A small pool of background loader threads used to stream assets
+			in after the first frame has been presented.
+			Each request is split in two halves:
+				the load half (file I/O, parsing, tangent generation) runs on
+				a worker thread.
+				the finalize half (CreateBuffer / texture creation) is queued
+				back and only ever run on the device thread through Update().
+
+Types:		LoadFunction
+				a callable run on a worker thread, returns false on failure.
+			FinalizeFunction
+				a callable run on the device thread with the device to create
+				resources with, returns false on failure.
+			AssetHandle
+				a shared future that becomes true once the asset is ready to be
+				drawn, or false if either half of the request failed.
+
+Methods:	==================== PUBLIC ====================
+			AssetLoaderClass()
+				Default constructor.
+			AssetLoaderClass(const AssetLoaderClass&)
+				Reference constructor.
+			~AssetLoaderClass()
+				Default deconstructor.
+
+			bool Initialize(int workerCount)
+				Call after creation to start the worker threads.
+				a workerCount of 0 picks one less than the hardware thread count.
+			void Shutdown()
+				Call before deletion to stop and join the worker threads.
+				Any request that has not completed is failed.
+
+			AssetHandle Request(const char* name, LoadFunction, FinalizeFunction)
+				Use to queue an asset for loading. Returns immediately.
+			int Update(ID3D11Device* device, int maxFinalizes)
+				CALL EVERY FRAME on the device thread.
+				Runs the finalize half of at most maxFinalizes loaded requests.
+
+			int GetPendingCount()
+				Use to get the number of requests that are not yet ready or failed.
+
+			==================== PRIVATE ====================
+			void WorkerLoop()
+				The body of each worker thread.
+
+Members:	==================== PRIVATE ====================
+			std::vector<std::thread> m_Workers
+				the worker threads of the pool.
+			std::deque<AssetRequest*> m_LoadQueue
+				requests waiting for a worker.
+			std::deque<AssetRequest*> m_FinalizeQueue
+				requests whose load half has finished, waiting for the device thread.
+			std::mutex m_Mutex
+				guards both queues, m_Running and m_PendingCount.
+			std::condition_variable m_Condition
+				wakes workers when a request is queued or on shutdown.
+			bool m_Running
+				whether the worker threads should keep running.
+			int m_PendingCount
+				the number of requests not yet completed.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class AssetLoaderClass
+{
+public:
+	typedef std::function<bool()> LoadFunction;
+	typedef std::function<bool(ID3D11Device*)> FinalizeFunction;
+	typedef std::shared_future<bool> AssetHandle;
+
+private:
+	struct AssetRequest
+	{
+		std::string name;
+		LoadFunction load;
+		FinalizeFunction finalize;
+		std::promise<bool> promise;
+		bool loaded;
+	};
+
+public:
+	AssetLoaderClass();
+	AssetLoaderClass(const AssetLoaderClass&);
+	~AssetLoaderClass();
+
+	bool Initialize(int workerCount);
+	void Shutdown();
+
+	AssetHandle Request(const char* name, LoadFunction load, FinalizeFunction finalize);
+	int Update(ID3D11Device* device, int maxFinalizes);
+
+	int GetPendingCount();
+
+private:
+	void WorkerLoop();
+
+private:
+	std::vector<std::thread> m_Workers;
+	std::deque<AssetRequest*> m_LoadQueue;
+	std::deque<AssetRequest*> m_FinalizeQueue;
+	std::mutex m_Mutex;
+	std::condition_variable m_Condition;
+	bool m_Running;
+	int m_PendingCount;
+};
+
+#endif
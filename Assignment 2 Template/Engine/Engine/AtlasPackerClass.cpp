@@ -0,0 +1,297 @@
+//======================================================
+//				Filename: AtlasPackerClass.cpp
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "AtlasPackerClass.h"
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <algorithm>
+#include <cmath>
+
+
+//Returns the smallest power of two that is at least value.
+static int NextPowerOfTwo(int value)
+{
+	int result = 1;
+	while (result < value)
+		result *= 2;
+	return result;
+}
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		AtlasPackerClass
+
+Summary:	The default constructor for an AtlasPackerClass object.
+
+Modifies:	[none].
+
+Returns:	AtlasPackerClass
+				the newly created AtlasPackerClass object.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+AtlasPackerClass::AtlasPackerClass()
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		AtlasPackerClass
+
+Summary:	The reference constructor for an AtlasPackerClass object.
+
+Args:		const AtlasPackerClass& other
+				the AtlasPackerClass object to create this one in the image of.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+AtlasPackerClass::AtlasPackerClass(const AtlasPackerClass & other)
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		~AtlasPackerClass
+
+Summary:	The default deconstructor for an AtlasPackerClass object.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+AtlasPackerClass::~AtlasPackerClass()
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Pack
+
+Summary:	Places every rectangle without overlap in the narrowest power of
+			two wide atlas they fit in, then rounds the height used up to a
+			power of two.
+
+Args:		const std::vector<Rect>& sizes
+				the width and height of each rectangle. x and y are ignored.
+			int maxSize
+				the widest and tallest the atlas may be.
+			std::vector<Rect>& placed
+				filled with the position of each rectangle, in the same order
+				as sizes.
+			int& atlasWidth
+				set to the width of the atlas.
+			int& atlasHeight
+				set to the height of the atlas.
+
+Modifies:	[m_skyline].
+
+Returns:	bool
+				did every rectangle fit within maxSize.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool AtlasPackerClass::Pack(const std::vector<Rect>& sizes, int maxSize, std::vector<Rect>& placed, int & atlasWidth, int & atlasHeight)
+{
+	placed.assign(sizes.size(), Rect{ 0, 0, 0, 0 });
+	atlasWidth = 1;
+	atlasHeight = 1;
+
+	//Check every rectangle could fit at all and total their area.
+	double area = 0.0;
+	int widest = 1;
+	for (size_t i = 0; i < sizes.size(); i++)
+	{
+		if (sizes[i].width <= 0 || sizes[i].height <= 0 || sizes[i].width > maxSize || sizes[i].height > maxSize)
+			return false;
+
+		area += (double)sizes[i].width * sizes[i].height;
+		widest = std::max<int>(widest, sizes[i].width);
+	}
+
+	//Place the tallest rectangles first, breaking ties by width then index.
+	std::vector<int> order(sizes.size());
+	for (size_t i = 0; i < order.size(); i++)
+		order[i] = (int)i;
+
+	std::sort(order.begin(), order.end(), [&sizes](int a, int b)
+	{
+		if (sizes[a].height != sizes[b].height)
+			return sizes[a].height > sizes[b].height;
+		if (sizes[a].width != sizes[b].width)
+			return sizes[a].width > sizes[b].width;
+		return a < b;
+	});
+
+	//Start from a square atlas and widen it until everything fits.
+	int width = NextPowerOfTwo(std::max<int>(widest, (int)std::ceil(std::sqrt(area))));
+	for (; width <= maxSize; width *= 2)
+	{
+		int usedHeight;
+		if (PackWidth(order, sizes, width, maxSize, placed, usedHeight))
+		{
+			atlasWidth = width;
+			atlasHeight = NextPowerOfTwo(std::max<int>(usedHeight, 1));
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		PackWidth
+
+Summary:	Places every rectangle, in the given order, on a skyline of
+			the given width.
+
+Args:		const std::vector<int>& order
+				the indices of the rectangles in the order to place them.
+			const std::vector<Rect>& sizes
+				the width and height of each rectangle.
+			int width
+				the width of the atlas.
+			int maxHeight
+				the tallest the packed area may grow.
+			std::vector<Rect>& placed
+				filled with the position of each rectangle.
+			int& usedHeight
+				set to the height of the packed area.
+
+Modifies:	[m_skyline].
+
+Returns:	bool
+				did every rectangle fit.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool AtlasPackerClass::PackWidth(const std::vector<int>& order, const std::vector<Rect>& sizes, int width, int maxHeight,
+	std::vector<Rect>& placed, int & usedHeight)
+{
+	//Start with a single flat segment along the bottom.
+	m_skyline.clear();
+	m_skyline.push_back(SkylineNode{ 0, 0, width });
+	usedHeight = 0;
+
+	for (size_t i = 0; i < order.size(); i++)
+	{
+		const Rect& size = sizes[order[i]];
+
+		int y;
+		int node = FindPosition(size.width, width, y);
+		if (node < 0 || y + size.height > maxHeight)
+			return false;
+
+		Rect& rect = placed[order[i]];
+		rect.x = m_skyline[node].x;
+		rect.y = y;
+		rect.width = size.width;
+		rect.height = size.height;
+
+		AddSkylineNode(node, rect.x, y + size.height, size.width);
+		usedHeight = std::max<int>(usedHeight, y + size.height);
+	}
+
+	return true;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		FindPosition
+
+Summary:	Finds the skyline node to place a rectangle on, giving the
+			lowest bottom edge and then the leftmost position.
+
+Args:		int width
+				the width of the rectangle.
+			int atlasWidth
+				the width of the atlas.
+			int& y
+				set to the bottom edge the rectangle would be placed at.
+
+Modifies:	[none].
+
+Returns:	int
+				the index of the node the rectangle starts on, or -1 if it
+				does not fit across the atlas.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+int AtlasPackerClass::FindPosition(int width, int atlasWidth, int & y)
+{
+	int bestNode = -1;
+	int bestTop = 0;
+	y = 0;
+
+	for (size_t i = 0; i < m_skyline.size(); i++)
+	{
+		//Nodes are left to right so nothing further along fits either.
+		if (m_skyline[i].x + width > atlasWidth)
+			break;
+
+		//Rest the rectangle on the highest node it spans.
+		int top = 0;
+		int remaining = width;
+		for (size_t j = i; j < m_skyline.size() && remaining > 0; j++)
+		{
+			top = std::max<int>(top, m_skyline[j].y);
+			remaining -= m_skyline[j].width;
+		}
+
+		if (bestNode < 0 || top < bestTop)
+		{
+			bestNode = (int)i;
+			bestTop = top;
+		}
+	}
+
+	y = bestTop;
+	return bestNode;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		AddSkylineNode
+
+Summary:	Inserts the top edge of a newly placed rectangle into the
+			skyline, trims the nodes it covers and merges level neighbours.
+
+Args:		int index
+				the node the rectangle was placed on.
+			int x
+				the left edge of the rectangle.
+			int y
+				the top edge of the rectangle.
+			int width
+				the width of the rectangle.
+
+Modifies:	[m_skyline].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void AtlasPackerClass::AddSkylineNode(int index, int x, int y, int width)
+{
+	m_skyline.insert(m_skyline.begin() + index, SkylineNode{ x, y, width });
+
+	//Trim or remove the nodes now underneath the new one.
+	size_t i = index + 1;
+	while (i < m_skyline.size())
+	{
+		int right = m_skyline[i - 1].x + m_skyline[i - 1].width;
+		if (m_skyline[i].x >= right)
+			break;
+
+		int shrink = right - m_skyline[i].x;
+		m_skyline[i].x += shrink;
+		m_skyline[i].width -= shrink;
+
+		if (m_skyline[i].width > 0)
+			break;
+
+		m_skyline.erase(m_skyline.begin() + i);
+	}
+
+	//Merge neighbouring nodes at the same height.
+	for (size_t j = 0; j + 1 < m_skyline.size();)
+	{
+		if (m_skyline[j].y == m_skyline[j + 1].y)
+		{
+			m_skyline[j].width += m_skyline[j + 1].width;
+			m_skyline.erase(m_skyline.begin() + j + 1);
+		}
+		else
+		{
+			j++;
+		}
+	}
+}
@@ -0,0 +1,94 @@
+#pragma once
+//======================================================
+//				Filename: AtlasPackerClass.h
+//======================================================
+
+
+//======================================================
+//					Include Guards.
+//======================================================
+#ifndef _ATLASPACKERCLASS_H_
+#define _ATLASPACKERCLASS_H_
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <vector>
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		AtlasPackerClass
+
+Summary:	A skyline bottom-left rectangle packer used to lay out the
+			sub-images of a texture atlas. Knows nothing about textures so
+			it can be used on its own.
+			The output only depends on the input sizes: rectangles are
+			placed tallest first, ties broken by width and then by their
+			index, so the same inputs always give the same atlas.
+
+Structs:	Rect
+				a rectangle in pixels.
+			SkylineNode
+				one horizontal segment of the top edge of the packed area.
+
+Methods:	==================== PUBLIC ====================
+			AtlasPackerClass()
+				Default constructor.
+			AtlasPackerClass(const AtlasPackerClass&)
+				Reference constructor.
+			~AtlasPackerClass()
+				Default deconstructor.
+
+			bool Pack(const std::vector<Rect>&, int, std::vector<Rect>&, int&, int&)
+				Use to place rectangles in the smallest power of two atlas
+				found, no larger than the given size on either side.
+
+			==================== PRIVATE ====================
+			bool PackWidth(const std::vector<int>&, const std::vector<Rect>&, int, int, std::vector<Rect>&, int&)
+				Called by Pack() to try placing every rectangle in an atlas of
+				a fixed width.
+			int FindPosition(int, int, int&)
+				Finds the lowest, then leftmost, position a rectangle fits on
+				the skyline.
+			void AddSkylineNode(int, int, int, int)
+				Raises the skyline under a newly placed rectangle.
+
+Members:	==================== PRIVATE ====================
+			std::vector<SkylineNode> m_skyline
+				the top edge of the packed area, left to right.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class AtlasPackerClass
+{
+public:
+	struct Rect
+	{
+		int x, y;
+		int width, height;
+	};
+
+private:
+	struct SkylineNode
+	{
+		int x, y;
+		int width;
+	};
+
+public:
+	AtlasPackerClass();
+	AtlasPackerClass(const AtlasPackerClass&);
+	~AtlasPackerClass();
+
+	bool Pack(const std::vector<Rect>& sizes, int maxSize, std::vector<Rect>& placed, int& atlasWidth, int& atlasHeight);
+
+private:
+	bool PackWidth(const std::vector<int>& order, const std::vector<Rect>& sizes, int width, int maxHeight,
+		std::vector<Rect>& placed, int& usedHeight);
+	int FindPosition(int width, int atlasWidth, int& y);
+	void AddSkylineNode(int index, int x, int y, int width);
+
+private:
+	std::vector<SkylineNode> m_skyline;
+};
+
+#endif
@@ -0,0 +1,913 @@
+//======================================================
+//				Filename: BenchmarkClass.cpp
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "BenchmarkClass.h"
+#include "ProfilerClass.h"
+#include "MemoryTrackerClass.h"
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <psapi.h>
+#include <algorithm>
+#include <fstream>
+#include <math.h>
+#include <new>
+#include <sstream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#pragma comment(lib, "psapi.lib")
+
+
+//======================================================
+//					Constants.
+//======================================================
+const int BENCHMARK_SCREEN_WIDTH = 1280;
+const int BENCHMARK_SCREEN_HEIGHT = 720;
+const float BENCHMARK_SCREEN_DEPTH = 1000.0f;
+const float BENCHMARK_SCREEN_NEAR = 0.1f;
+const float BENCHMARK_TIMESTEP = 1.0f / 60.0f;
+const float BENCHMARK_GRID_SPACING = 4.0f;
+const int BENCHMARK_CHURN_LIFETIME = 8;
+const float BENCHMARK_SPIN_SPEED = 1.0f;
+const unsigned BENCHMARK_SEED = 1234;
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		BenchmarkClass
+
+Summary:	The default constructor for a BenchmarkClass.
+
+Modifies:	[m_D3D, m_Camera, m_Collision, m_CubeModel, m_BulletModel,
+				m_NinjaModel, m_JobSystem, m_Snapshot, m_modelLoadTime,
+				m_picks, m_pickHits].
+
+Returns:	BenchmarkClass
+				the newly created BenchmarkClass object.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+BenchmarkClass::BenchmarkClass()
+{
+	m_D3D = 0;
+	m_Camera = 0;
+	m_Collision = 0;
+	m_CubeModel = 0;
+	m_BulletModel = 0;
+	m_NinjaModel = 0;
+	m_JobSystem = 0;
+	m_Snapshot = 0;
+	m_modelLoadTime = 0.0;
+	m_picks = 0;
+	m_pickHits = 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		BenchmarkClass
+
+Summary:	The reference constructor for a BenchmarkClass.
+
+Args:		const BenchmarkClass& other
+				the BenchmarkClass to create this one from.
+
+Modifies:	[none].
+
+Returns:	BenchmarkClass
+				the newly created BenchmarkClass object.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+BenchmarkClass::BenchmarkClass(const BenchmarkClass & other)
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		~BenchmarkClass
+
+Summary:	The default deconstructor for a BenchmarkClass.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+BenchmarkClass::~BenchmarkClass()
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Initialize
+
+Summary:	Reads the settings from the command line, sets up the screen
+			matrices, camera and collision object without a device,
+			loads the cube and sphere models, timing the load, loads the
+			bump mapped ninja head and starts the job system.
+
+Args:		char* commandLine
+				the command line the engine was started with.
+
+Modifies:	[m_settings, m_D3D, m_Camera, m_Collision, m_CubeModel,
+				m_BulletModel, m_modelLoadTime, m_NinjaModel, m_JobSystem,
+				m_Snapshot].
+
+Returns:	bool
+				was everything set up successfully.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool BenchmarkClass::Initialize(char * commandLine)
+{
+	if (!ParseCommandLine(commandLine))
+		return false;
+
+	//Keep only the screen size and matrices, there is no window to draw to.
+	m_D3D = new D3DClass;
+	if (!m_D3D->InitializeHeadless(BENCHMARK_SCREEN_WIDTH, BENCHMARK_SCREEN_HEIGHT, BENCHMARK_SCREEN_DEPTH, BENCHMARK_SCREEN_NEAR))
+		return false;
+
+	m_Camera = new CameraClass;
+	XMMATRIX projectionMatrix;
+	m_D3D->GetProjectionMatrix(projectionMatrix);
+	m_Camera->SetProjectionMatrix(projectionMatrix);
+
+	m_Collision = new CollisionClass;
+	if (!m_Collision->Initialize(m_D3D, m_Camera))
+		return false;
+
+	//Load the vertex data and bounds of the models, timing the loaders.
+	int64_t start = ProfilerClass::Now();
+
+	m_CubeModel = new ModelClass;
+	if (!m_CubeModel->Initialize("../Engine/data/cube.txt"))
+		return false;
+
+	m_BulletModel = new ModelClass;
+	if (!m_BulletModel->Initialize("../Engine/data/sphere.txt"))
+		return false;
+
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	m_modelLoadTime = (ProfilerClass::Now() - start) * 1000.0 / (double)frequency.QuadPart;
+
+	//Kept out of the load time so it stays comparable with earlier runs.
+	m_NinjaModel = new BumpModelClass;
+	if (!m_NinjaModel->Initialize("../Engine/data/new-ninjaHead.txt"))
+		return false;
+
+	m_JobSystem = new JobSystemClass;
+	if (!m_JobSystem->Initialize(m_settings.workerThreads))
+		return false;
+
+	m_Snapshot = new FrameSnapshotClass;
+
+	return true;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Run
+
+Summary:	Runs the scenario named on the command line, or every scenario
+			for "all", and writes the results to the output file, and the
+			memory report if one was asked for. Fails if any scenario left
+			more allocations live than -maxgrowth allows.
+
+Modifies:	[none].
+
+Returns:	bool
+				did every scenario run, stay within the growth allowed and
+				the results get written.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool BenchmarkClass::Run()
+{
+	const char* scenarios[] = { "static", "projectiles", "picking", "churn", "rotated", "swarm", "occluded", "spinning", "tangents" };
+	std::vector<ScenarioResult> results;
+
+	for (int i = 0; i < 9; i++)
+	{
+		if (m_settings.scenario != "all" && m_settings.scenario != scenarios[i])
+			continue;
+
+		ScenarioResult result;
+		if (!RunScenario(scenarios[i], result))
+			return false;
+
+		results.push_back(result);
+	}
+
+	if (results.empty())
+	{
+		OutputDebugStringA("BenchmarkClass: unknown scenario\n");
+		return false;
+	}
+
+	if (!WriteResults(results))
+		return false;
+
+	if (!m_settings.memoryReportFile.empty() && !MemoryTrackerClass::WriteReport(m_settings.memoryReportFile.c_str()))
+		return false;
+
+	//Check for leaks once everything is written, so the numbers can be looked at.
+	for (size_t i = 0; m_settings.maxLiveGrowth >= 0 && i < results.size(); i++)
+	{
+		if (results[i].liveAllocationGrowth > m_settings.maxLiveGrowth)
+		{
+			std::string message = "BenchmarkClass: " + results[i].name + " left more allocations live than -maxgrowth allows\n";
+			OutputDebugStringA(message.c_str());
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Shutdown
+
+Summary:	Stops the job system and frees the snapshot, models, collision
+			object, camera and d3d class.
+
+Modifies:	[m_D3D, m_Camera, m_Collision, m_CubeModel, m_BulletModel,
+				m_NinjaModel, m_JobSystem, m_Snapshot].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void BenchmarkClass::Shutdown()
+{
+	if (m_Snapshot)
+	{
+		delete m_Snapshot;
+		m_Snapshot = 0;
+	}
+
+	if (m_JobSystem)
+	{
+		m_JobSystem->Shutdown();
+		delete m_JobSystem;
+		m_JobSystem = 0;
+	}
+
+	if (m_NinjaModel)
+	{
+		m_NinjaModel->Shutdown();
+		delete m_NinjaModel;
+		m_NinjaModel = 0;
+	}
+
+	if (m_BulletModel)
+	{
+		m_BulletModel->Shutdown();
+		delete m_BulletModel;
+		m_BulletModel = 0;
+	}
+
+	if (m_CubeModel)
+	{
+		m_CubeModel->Shutdown();
+		delete m_CubeModel;
+		m_CubeModel = 0;
+	}
+
+	if (m_Collision)
+	{
+		m_Collision->Shutdown();
+		delete m_Collision;
+		m_Collision = 0;
+	}
+
+	if (m_Camera)
+	{
+		delete m_Camera;
+		m_Camera = 0;
+	}
+
+	if (m_D3D)
+	{
+		m_D3D->Shutdown();
+		delete m_D3D;
+		m_D3D = 0;
+	}
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		IsRequested
+
+Summary:	Checks whether the command line asks for a benchmark run.
+
+Args:		char* commandLine
+				the command line the engine was started with.
+
+Modifies:	[none].
+
+Returns:	bool
+				does the command line contain "-benchmark".
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool BenchmarkClass::IsRequested(char * commandLine)
+{
+	return commandLine && strstr(commandLine, "-benchmark") != 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		ParseCommandLine
+
+Summary:	Reads the scenario and options from the command line, starting
+			from the defaults.
+
+Args:		char* commandLine
+				the command line the engine was started with.
+
+Modifies:	[m_settings].
+
+Returns:	bool
+				were the options valid.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool BenchmarkClass::ParseCommandLine(char * commandLine)
+{
+	m_settings.scenario = "all";
+	m_settings.frames = 600;
+	m_settings.warmupFrames = 30;
+	m_settings.objects = 1000;
+	m_settings.projectilesPerSecond = 600;
+	m_settings.picksPerFrame = 16;
+	m_settings.churnPerFrame = 100;
+	m_settings.workerThreads = 0;
+	m_settings.collisionMode = GameObjectManager::COLLISIONMODE_OBB;
+	m_settings.broadPhase = GameObjectManager::BROADPHASE_STATICTREE;
+	m_settings.gridCellSize = BENCHMARK_GRID_SPACING;
+	m_settings.swarmProjectiles = 1000;
+	m_settings.batchedTransforms = true;
+	m_settings.outputFile = "benchmark.json";
+	m_settings.memoryReportFile = "";
+	m_settings.depthDumpFile = "";
+	m_settings.maxLiveGrowth = -1;
+
+	std::istringstream stream(commandLine ? commandLine : "");
+	std::string token;
+	while (stream >> token)
+	{
+		if (token == "-benchmark")
+		{
+			//The scenario is optional, so only take the next word if it is not an option.
+			std::streampos position = stream.tellg();
+			std::string scenario;
+			if (stream >> scenario && scenario[0] != '-')
+				m_settings.scenario = scenario;
+			else
+			{
+				stream.clear();
+				stream.seekg(position);
+			}
+		}
+		else if (token == "-frames")
+			stream >> m_settings.frames;
+		else if (token == "-objects")
+			stream >> m_settings.objects;
+		else if (token == "-rate")
+			stream >> m_settings.projectilesPerSecond;
+		else if (token == "-picks")
+			stream >> m_settings.picksPerFrame;
+		else if (token == "-churn")
+			stream >> m_settings.churnPerFrame;
+		else if (token == "-threads")
+			stream >> m_settings.workerThreads;
+		else if (token == "-collision")
+		{
+			std::string mode;
+			stream >> mode;
+			if (mode == "aabb")
+				m_settings.collisionMode = GameObjectManager::COLLISIONMODE_AABB;
+			else if (mode == "obb")
+				m_settings.collisionMode = GameObjectManager::COLLISIONMODE_OBB;
+			else
+				return false;
+		}
+		else if (token == "-broadphase")
+		{
+			std::string broadPhase;
+			stream >> broadPhase;
+			if (broadPhase == "brute")
+				m_settings.broadPhase = GameObjectManager::BROADPHASE_BRUTEFORCE;
+			else if (broadPhase == "grid")
+				m_settings.broadPhase = GameObjectManager::BROADPHASE_HASHGRID;
+			else if (broadPhase == "tree")
+				m_settings.broadPhase = GameObjectManager::BROADPHASE_STATICTREE;
+			else
+				return false;
+		}
+		else if (token == "-cellsize")
+			stream >> m_settings.gridCellSize;
+		else if (token == "-swarm")
+			stream >> m_settings.swarmProjectiles;
+		else if (token == "-transforms")
+		{
+			std::string transforms;
+			stream >> transforms;
+			if (transforms == "batched")
+				m_settings.batchedTransforms = true;
+			else if (transforms == "object")
+				m_settings.batchedTransforms = false;
+			else
+				return false;
+		}
+		else if (token == "-out")
+			stream >> m_settings.outputFile;
+		else if (token == "-memreport")
+			stream >> m_settings.memoryReportFile;
+		else if (token == "-depthdump")
+			stream >> m_settings.depthDumpFile;
+		else if (token == "-maxgrowth")
+			stream >> m_settings.maxLiveGrowth;
+	}
+
+	return m_settings.frames > 0 && m_settings.objects >= 0 && m_settings.projectilesPerSecond >= 0 &&
+		m_settings.picksPerFrame >= 0 && m_settings.churnPerFrame >= 0 && m_settings.gridCellSize > 0.0f &&
+		m_settings.swarmProjectiles >= 0 && !m_settings.outputFile.empty();
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RunScenario
+
+Summary:	Builds the grid, runs the warm up and measured frames of a
+			scenario and tears the scene down again. Only the measured
+			frames are recorded, and only the work inside each frame is
+			counted towards allocations. The frame arena is reset before
+			each frame as BeginScene() would. Whatever the measured frames
+			leave allocated is recorded as growth.
+
+Args:		const std::string& name
+				the name of the scenario.
+			ScenarioResult& result
+				filled with the measurements.
+
+Modifies:	[m_random, m_picks, m_pickHits].
+
+Returns:	bool
+				did the scenario run.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool BenchmarkClass::RunScenario(const std::string & name, ScenarioResult & result)
+{
+	//Every scenario sees the same random numbers.
+	m_random.seed(BENCHMARK_SEED);
+	m_picks = 0;
+	m_pickHits = 0;
+
+	GameObjectManager* manager = new GameObjectManager();
+	manager->SetJobSystem(m_JobSystem);
+	manager->SetCollisionMode(m_settings.collisionMode);
+	manager->SetBatchedTransforms(m_settings.batchedTransforms);
+	if (!manager->SetBroadPhase(m_settings.broadPhase, m_settings.gridCellSize))
+	{
+		OutputDebugStringA("BenchmarkClass: could not set up the broad phase\n");
+		manager->Shutdown();
+		delete manager;
+		return false;
+	}
+
+	BuildScene(manager, name);
+
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	double msPerTick = 1000.0 / (double)frequency.QuadPart;
+
+	result.name = name;
+	result.frameTimes.reserve(m_settings.frames);
+	result.allocations = 0;
+	result.allocatedBytes = 0;
+	result.arenaOverflows = 0;
+
+	FrameArenaClass* arena = m_D3D->GetFrameArena();
+	FrameArenaClass::SetCurrent(arena);
+
+	float projectileBudget = 0.0f;
+	long long checksBefore = 0, rejectionsBefore = 0, occludedBefore = 0;
+	long long picksBefore = 0, pickHitsBefore = 0;
+	long long liveBefore = 0, liveBytesBefore = 0;
+
+	for (int frame = 0; frame < m_settings.warmupFrames + m_settings.frames; frame++)
+	{
+		bool measured = frame >= m_settings.warmupFrames;
+		if (frame == m_settings.warmupFrames)
+		{
+			checksBefore = manager->GetCollisionChecks();
+			rejectionsBefore = manager->GetOBBRejections();
+			occludedBefore = manager->GetOccludedObjects();
+			picksBefore = m_picks;
+			pickHitsBefore = m_pickHits;
+		}
+
+		//Reclaim the last frame's transient data, as BeginScene() does.
+		arena->Reset();
+
+		if (frame == m_settings.warmupFrames)
+		{
+			liveBefore = MemoryTrackerClass::GetLiveAllocations();
+			liveBytesBefore = MemoryTrackerClass::GetLiveBytes();
+		}
+
+		long long allocations = MemoryTrackerClass::GetAllocations();
+		long long overflows = arena->GetOverflows();
+		long long allocatedBytes = MemoryTrackerClass::GetAllocatedBytes();
+		int64_t start = ProfilerClass::Now();
+
+		RunFrame(name, manager, projectileBudget);
+
+		int64_t end = ProfilerClass::Now();
+		if (measured)
+		{
+			result.frameTimes.push_back((end - start) * msPerTick);
+			result.allocations += MemoryTrackerClass::GetAllocations() - allocations;
+			result.allocatedBytes += MemoryTrackerClass::GetAllocatedBytes() - allocatedBytes;
+			result.arenaOverflows += arena->GetOverflows() - overflows;
+		}
+
+		//Keep the profiler rings drained and the heap rates rolling as the engine loop would.
+		PROFILE_END_FRAME();
+		MemoryTrackerClass::EndFrame();
+	}
+
+	//Anything the measured frames left allocated, beyond the last frame's arena overflow, is growth.
+	arena->Reset();
+	result.liveAllocationGrowth = MemoryTrackerClass::GetLiveAllocations() - liveBefore;
+	result.liveByteGrowth = MemoryTrackerClass::GetLiveBytes() - liveBytesBefore;
+
+	result.collisionChecks = manager->GetCollisionChecks() - checksBefore;
+	result.obbRejections = manager->GetOBBRejections() - rejectionsBefore;
+	result.occludedObjects = manager->GetOccludedObjects() - occludedBefore;
+	result.picks = m_picks - picksBefore;
+	result.pickHits = m_pickHits - pickHitsBefore;
+	result.finalObjects = manager->GetList(GameObjectManager::OBJECTTYPE_STATIC)->size() +
+		manager->GetList(GameObjectManager::OBJECTTYPE_DYNAMIC)->size() +
+		manager->GetProjectileList()->size();
+
+	result.arenaHighWater = arena->GetHighWater();
+	FrameArenaClass::SetCurrent(0);
+
+	//Keep the last depth buffer drawn, to compare against a saved one.
+	bool saved = true;
+	if (name == "occluded" && !m_settings.depthDumpFile.empty())
+		saved = manager->GetOcclusionCuller()->SaveDepthBuffer(m_settings.depthDumpFile.c_str());
+
+	ReleaseScene(manager);
+	manager->Shutdown();
+	delete manager;
+
+	if (!saved)
+	{
+		OutputDebugStringA("BenchmarkClass: could not write the depth buffer\n");
+		return false;
+	}
+
+	return true;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		BuildScene
+
+Summary:	Adds a square grid of cubes on the ground and points the camera
+			down at it from behind. The cubes are static, except in the
+			spinning scenario. The rotated scenario turns each cube to a
+			random angle about every axis, which can blow its AABB up to
+			about 5 times its volume. The occluded scenario covers the far
+			half of the grid with a flat roof, marked as an occluder, that
+			hides the cubes beneath it. The tangents scenario has no grid.
+
+Args:		GameObjectManager* manager
+				the manager to add the cubes to.
+			const std::string& name
+				the name of the scenario.
+
+Modifies:	[m_cubes, m_Camera].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void BenchmarkClass::BuildScene(GameObjectManager * manager, const std::string & name)
+{
+	bool rotated = name == "rotated";
+	GameObjectManager::ObjectType cubeType = (name == "spinning") ? GameObjectManager::OBJECTTYPE_DYNAMIC : GameObjectManager::OBJECTTYPE_STATIC;
+
+	int side = (int)ceil(sqrt((double)m_settings.objects));
+	float halfWidth = side * BENCHMARK_GRID_SPACING * 0.5f;
+
+	std::uniform_real_distribution<float> angle(0.0f, XM_2PI);
+	XMFLOAT3 rotation(0.0f, 0.0f, 0.0f);
+	XMFLOAT3 scale(1.0f, 1.0f, 1.0f);
+
+	int objects = (name == "tangents") ? 0 : m_settings.objects;
+	for (int i = 0; i < objects; i++)
+	{
+		XMFLOAT3 position((i % side) * BENCHMARK_GRID_SPACING - halfWidth, 0.0f, (i / side) * BENCHMARK_GRID_SPACING - halfWidth);
+		if (rotated)
+			rotation = XMFLOAT3(angle(m_random), angle(m_random), angle(m_random));
+
+		TextureGameObject* cube = new TextureGameObject(m_CubeModel);
+		manager->AddItem(cubeType, cube, &position, &rotation, &scale);
+		m_cubes.push_back(cube);
+	}
+
+	//Stretch a cube into a roof over the far half of the grid.
+	if (name == "occluded")
+	{
+		XMFLOAT3 position(0.0f, 3.0f, halfWidth * 0.5f);
+		XMFLOAT3 roofRotation(0.0f, 0.0f, 0.0f);
+		XMFLOAT3 roofScale(halfWidth + BENCHMARK_GRID_SPACING, 0.25f, halfWidth * 0.5f + BENCHMARK_GRID_SPACING);
+
+		TextureGameObject* roof = new TextureGameObject(m_CubeModel);
+		roof->SetOccluder(true);
+		manager->AddItem(GameObjectManager::OBJECTTYPE_STATIC, roof, &position, &roofRotation, &roofScale);
+		m_cubes.push_back(roof);
+	}
+
+	//Look down over the whole grid so random picks and shots mostly land on it.
+	m_Camera->SetPosition(0.0f, halfWidth + 10.0f, -halfWidth - 10.0f);
+	m_Camera->SetRotation(45.0f, 0.0f, 0.0f);
+	m_Camera->Render();
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RunFrame
+
+Summary:	Runs one fixed step frame of a scenario: fires, spawns and turns
+			what the scenario asks for, updates the GameObjectManager and picks,
+			or snapshots the scene and culls what the occluders hide. The
+			tangents scenario only rebuilds the ninja head's tangent frames.
+
+Args:		const std::string& name
+				the name of the scenario.
+			GameObjectManager* manager
+				the manager holding the scene.
+			float& projectileBudget
+				the fraction of a projectile carried over between frames.
+
+Modifies:	[m_projectiles, m_churnCubes, m_cubes, m_random, m_picks,
+				m_pickHits, m_Snapshot, m_NinjaModel].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void BenchmarkClass::RunFrame(const std::string & name, GameObjectManager * manager, float & projectileBudget)
+{
+	std::uniform_int_distribution<int> screenX(0, BENCHMARK_SCREEN_WIDTH - 1);
+	std::uniform_int_distribution<int> screenY(0, BENCHMARK_SCREEN_HEIGHT - 1);
+
+	//Weld, build and smooth every tangent frame of the head again.
+	if (name == "tangents")
+	{
+		m_NinjaModel->CalculateModelVectors(m_JobSystem);
+		return;
+	}
+
+	//Fire projectiles at random points on screen, as ShootProjectile does.
+	if (name == "projectiles" || name == "rotated")
+	{
+		projectileBudget += m_settings.projectilesPerSecond * BENCHMARK_TIMESTEP;
+		int shots = (int)projectileBudget;
+		projectileBudget -= (float)shots;
+
+		//Unproject the whole burst as one batch of rays.
+		FrameVector<XMINT2> points(shots);
+		for (int i = 0; i < shots; i++)
+		{
+			points[i].x = screenX(m_random);
+			points[i].y = screenY(m_random);
+		}
+
+		FrameVector<CollisionClass::Ray> rays(shots);
+		CollisionClass::GetRays(m_D3D, m_Camera, points.data(), shots, rays.data());
+
+		for (int i = 0; i < shots; i++)
+		{
+			XMFLOAT3 velocity = rays[i].direction;
+			velocity.x *= PROJECTILE_SPEED;
+			velocity.y *= PROJECTILE_SPEED;
+			velocity.z *= PROJECTILE_SPEED;
+
+			XMFLOAT3 position = m_Camera->GetPosition();
+			XMFLOAT4 orientation = m_Camera->GetOrientation();
+
+			ProjectileObject* projectile = new ProjectileObject(m_BulletModel, 0, m_Camera, &velocity);
+			manager->AddProjectile(projectile, &position, &orientation);
+			m_projectiles.push_back(projectile);
+		}
+	}
+
+	//Keep the swarm topped up with projectiles gliding down across the grid in every direction.
+	if (name == "swarm")
+	{
+		float halfWidth = (float)ceil(sqrt((double)m_settings.objects)) * BENCHMARK_GRID_SPACING * 0.5f;
+		std::uniform_real_distribution<float> ground(-halfWidth, halfWidth);
+		std::uniform_real_distribution<float> height(1.0f, 10.0f);
+		std::uniform_real_distribution<float> heading(0.0f, XM_2PI);
+
+		XMFLOAT4 orientation(0.0f, 0.0f, 0.0f, 1.0f);
+
+		while ((int)manager->GetProjectileList()->size() < m_settings.swarmProjectiles)
+		{
+			XMFLOAT3 position(ground(m_random), height(m_random), ground(m_random));
+
+			float angle = heading(m_random);
+			XMFLOAT3 velocity(cosf(angle) * PROJECTILE_SPEED, -0.1f * PROJECTILE_SPEED, sinf(angle) * PROJECTILE_SPEED);
+
+			ProjectileObject* projectile = new ProjectileObject(m_BulletModel, 0, m_Camera, &velocity);
+			manager->AddProjectile(projectile, &position, &orientation);
+			m_projectiles.push_back(projectile);
+		}
+	}
+
+	//Spawn dynamic cubes over the grid and despawn the oldest.
+	if (name == "churn")
+	{
+		float halfWidth = (float)ceil(sqrt((double)m_settings.objects)) * BENCHMARK_GRID_SPACING * 0.5f;
+		std::uniform_real_distribution<float> ground(-halfWidth, halfWidth);
+
+		XMFLOAT3 rotation(0.0f, 0.0f, 0.0f);
+		XMFLOAT3 scale(1.0f, 1.0f, 1.0f);
+
+		for (int i = 0; i < m_settings.churnPerFrame; i++)
+		{
+			XMFLOAT3 position(ground(m_random), 3.0f, ground(m_random));
+
+			TextureGameObject* cube = new TextureGameObject(m_CubeModel);
+			manager->AddItem(GameObjectManager::OBJECTTYPE_DYNAMIC, cube, &position, &rotation, &scale);
+			m_churnCubes.push_back(cube);
+		}
+
+		while ((int)m_churnCubes.size() > m_settings.churnPerFrame * BENCHMARK_CHURN_LIFETIME)
+		{
+			manager->Delete(m_churnCubes.front());
+			delete m_churnCubes.front();
+			m_churnCubes.pop_front();
+		}
+	}
+
+	//Turn every cube a little, so every world matrix has to be rebuilt.
+	if (name == "spinning")
+	{
+		float spin = BENCHMARK_SPIN_SPEED * BENCHMARK_TIMESTEP;
+		XMVECTOR rotation = XMQuaternionRotationRollPitchYaw(spin, spin * 0.5f, 0.0f);
+		for (size_t i = 0; i < m_cubes.size(); i++)
+			m_cubes[i]->addRotation(rotation);
+	}
+
+	//Advance, reposition and collide everything.
+	manager->BeginStep();
+	manager->Update(BENCHMARK_TIMESTEP);
+
+	//Pick at random points on screen, as a mouse click does.
+	if (name == "picking")
+	{
+		XMFLOAT3 cameraPosition = m_Camera->GetPosition();
+		for (int i = 0; i < m_settings.picksPerFrame; i++)
+		{
+			GameObject* hit = m_Collision->CollisionTestLoop(screenX(m_random), screenY(m_random), manager, XMLoadFloat3(&cameraPosition));
+			m_picks++;
+			if (hit)
+				m_pickHits++;
+		}
+	}
+
+	//Snapshot the scene and cull it as RenderAll() does, without submitting anything.
+	if (name == "occluded")
+	{
+		manager->WriteSnapshot(1.0f, m_Snapshot->GetFrontFrame() + 1, m_Snapshot);
+		m_Snapshot->Swap();
+
+		XMMATRIX viewProjectionMatrix;
+		m_Camera->GetViewProjectionMatrix(viewProjectionMatrix);
+
+		const std::vector<FrameSnapshotClass::Entry>& entries = m_Snapshot->GetFront();
+		FrameVector<char> occluded(entries.size(), 0);
+		manager->FindOccluded(entries, viewProjectionMatrix, occluded);
+	}
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		ReleaseScene
+
+Summary:	Deletes every cube and projectile created for the scenario,
+			whether or not the GameObjectManager still holds it.
+
+Args:		GameObjectManager* manager
+				the manager holding the scene.
+
+Modifies:	[m_cubes, m_projectiles, m_churnCubes].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void BenchmarkClass::ReleaseScene(GameObjectManager * manager)
+{
+	manager->GetList(GameObjectManager::OBJECTTYPE_STATIC)->clear();
+	manager->GetList(GameObjectManager::OBJECTTYPE_DYNAMIC)->clear();
+	manager->GetProjectileList()->clear();
+
+	for (size_t i = 0; i < m_cubes.size(); i++)
+		delete m_cubes[i];
+	m_cubes.clear();
+
+	for (size_t i = 0; i < m_projectiles.size(); i++)
+		delete m_projectiles[i];
+	m_projectiles.clear();
+
+	for (size_t i = 0; i < m_churnCubes.size(); i++)
+		delete m_churnCubes[i];
+	m_churnCubes.clear();
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		WriteResults
+
+Summary:	Writes the settings, the results of every scenario and the peak
+			memory of the process to the output file as JSON.
+
+Args:		const std::vector<ScenarioResult>& results
+				the results of the scenarios that ran.
+
+Modifies:	[none].
+
+Returns:	bool
+				was the file written.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool BenchmarkClass::WriteResults(const std::vector<ScenarioResult>& results)
+{
+	std::ofstream fout;
+	fout.open(m_settings.outputFile.c_str());
+	if (fout.fail())
+	{
+		OutputDebugStringA("BenchmarkClass: could not open the output file\n");
+		return false;
+	}
+
+	char line[512];
+
+	sprintf_s(line, "{\n\"settings\":{\"frames\":%d,\"warmupFrames\":%d,\"objects\":%d,\"projectilesPerSecond\":%d,"
+		"\"picksPerFrame\":%d,\"churnPerFrame\":%d,\"swarmProjectiles\":%d,\"workerThreads\":%d,\"collision\":\"%s\","
+		"\"broadPhase\":\"%s\",\"cellSize\":%.2f,\"transforms\":\"%s\",\"timestep\":%.6f},\n",
+		m_settings.frames, m_settings.warmupFrames, m_settings.objects, m_settings.projectilesPerSecond,
+		m_settings.picksPerFrame, m_settings.churnPerFrame, m_settings.swarmProjectiles, m_JobSystem->GetWorkerCount(),
+		m_settings.collisionMode == GameObjectManager::COLLISIONMODE_OBB ? "obb" : "aabb",
+		m_settings.broadPhase == GameObjectManager::BROADPHASE_HASHGRID ? "grid" :
+			m_settings.broadPhase == GameObjectManager::BROADPHASE_STATICTREE ? "tree" : "brute",
+		m_settings.gridCellSize, m_settings.batchedTransforms ? "batched" : "object", BENCHMARK_TIMESTEP);
+	fout << line;
+
+	sprintf_s(line, "\"modelLoadMs\":%.3f,\n\"scenarios\":[\n", m_modelLoadTime);
+	fout << line;
+
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		const ScenarioResult& result = results[i];
+
+		std::vector<double> sorted(result.frameTimes);
+		std::sort(sorted.begin(), sorted.end());
+
+		double total = 0.0;
+		for (size_t j = 0; j < sorted.size(); j++)
+			total += sorted[j];
+
+		int frames = (int)sorted.size();
+		double seconds = total / 1000.0;
+
+		sprintf_s(line, "%s{\"name\":\"%s\",\"frameMs\":{\"mean\":%.4f,\"p50\":%.4f,\"p90\":%.4f,\"p99\":%.4f,\"max\":%.4f},",
+			i ? ",\n" : "", result.name.c_str(), total / frames,
+			Percentile(sorted, 0.5), Percentile(sorted, 0.9), Percentile(sorted, 0.99), sorted.back());
+		fout << line;
+
+		sprintf_s(line, "\"collisionChecks\":%lld,\"collisionChecksPerSecond\":%.0f,\"obbRejections\":%lld,\"picks\":%lld,\"pickHits\":%lld,"
+			"\"occludedObjects\":%lld,",
+			result.collisionChecks, seconds > 0.0 ? result.collisionChecks / seconds : 0.0, result.obbRejections,
+			result.picks, result.pickHits, result.occludedObjects);
+		fout << line;
+
+		sprintf_s(line, "\"allocationsPerFrame\":%.2f,\"allocatedBytesPerFrame\":%.1f,\"frameArenaHighWaterBytes\":%zu,"
+			"\"frameArenaOverflows\":%lld,\"liveAllocationGrowth\":%lld,\"liveByteGrowth\":%lld,\"finalObjects\":%zu}",
+			(double)result.allocations / frames, (double)result.allocatedBytes / frames, result.arenaHighWater,
+			result.arenaOverflows, result.liveAllocationGrowth, result.liveByteGrowth, result.finalObjects);
+		fout << line;
+	}
+
+	//Peak memory covers the whole process, so it is reported once.
+	PROCESS_MEMORY_COUNTERS memory;
+	ZeroMemory(&memory, sizeof(memory));
+	GetProcessMemoryInfo(GetCurrentProcess(), &memory, sizeof(memory));
+
+	sprintf_s(line, "\n],\n\"memoryTracking\":%s,\n\"peakWorkingSetBytes\":%zu,\n\"peakCommitBytes\":%zu\n}\n",
+		MemoryTrackerClass::IsTracking() ? "true" : "false", (size_t)memory.PeakWorkingSetSize, (size_t)memory.PeakPagefileUsage);
+	fout << line;
+
+	fout.close();
+
+	std::string message = "BenchmarkClass: wrote " + m_settings.outputFile + "\n";
+	OutputDebugStringA(message.c_str());
+
+	return true;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Percentile
+
+Summary:	Returns a percentile of a sorted list, by nearest rank.
+
+Args:		std::vector<double>& sortedTimes
+				the frame times, sorted smallest first.
+			double percentile
+				the percentile wanted, from 0 to 1.
+
+Modifies:	[none].
+
+Returns:	double
+				the value at that percentile.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+double BenchmarkClass::Percentile(std::vector<double>& sortedTimes, double percentile)
+{
+	int rank = (int)ceil(percentile * sortedTimes.size()) - 1;
+	rank = std::max<int>(0, std::min<int>(rank, (int)sortedTimes.size() - 1));
+	return sortedTimes[rank];
+}
@@ -0,0 +1,251 @@
+#pragma once
+//======================================================
+//				Filename: BenchmarkClass.h
+//======================================================
+
+
+//======================================================
+//					Include Guards.
+//======================================================
+#ifndef _BENCHMARKCLASS_H_
+#define _BENCHMARKCLASS_H_
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "d3dclass.h"
+#include "cameraclass.h"
+#include "modelclass.h"
+#include "bumpmodelclass.h"
+#include "CollisionClass.h"
+#include "GameObjectManager.h"
+#include "TextureGameObject.h"
+#include "ProjectileObject.h"
+#include "JobSystemClass.h"
+#include "FrameSnapshotClass.h"
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <stdint.h>
+#include <deque>
+#include <random>
+#include <string>
+#include <vector>
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		BenchmarkClass
+
+Summary:	Runs scripted stress scenarios through the GameObjectManager,
+			CollisionClass and model loaders without a window or device,
+			and writes the results as JSON so runs can be compared.
+			Started with "-benchmark [scenario]" on the command line.
+
+			Scenarios:
+				static		- a grid of static cubes.
+				projectiles	- the grid with projectiles fired at a fixed rate.
+				picking		- the grid with mouse picks every frame.
+				churn		- the grid with dynamic cubes spawned and
+							  despawned every frame.
+				rotated		- the projectiles scenario with every cube
+							  turned at random, counting the hits the OBBs
+							  reject that the AABBs alone would have made.
+				swarm		- the grid with a steady number of projectiles
+							  flying across it in every direction.
+				occluded	- the grid with its far half under a roof marked
+							  as an occluder, culling what the roof hides
+							  from a snapshot every frame.
+				spinning	- the grid as dynamic cubes, every one turned a
+							  little every frame, so every world matrix is
+							  rebuilt every step.
+				tangents	- no grid, the bump mapped tangent frames of the
+							  ninja head rebuilt every frame.
+				all			- every scenario above in turn.
+
+			Options:
+				-frames N	frames measured per scenario.
+				-objects N	static cubes in the grid.
+				-rate N		projectiles fired per simulated second.
+				-picks N	mouse picks per frame.
+				-churn N	dynamic cubes spawned and despawned per frame.
+				-threads N	job worker threads, 0 for one less than the
+							hardware threads, -1 to update on one thread.
+				-collision aabb|obb
+							the bounds projectiles collide against.
+				-broadphase brute|grid|tree
+							whether projectiles test every object, only
+							those sharing a spatial hash grid cell, or the
+							dynamic ones in the grid and the static ones
+							near them in the static hierarchy (default).
+				-cellsize N	the size of a grid cell, in world units.
+				-swarm N	projectiles kept flying by the swarm scenario.
+				-transforms batched|object
+							whether world matrices are built four objects at
+							a time in batches (default) or one at a time.
+				-depthdump file
+							a PFM image of the occlusion depth buffer at the
+							end of the occluded scenario, to compare against
+							a saved one.
+				-out file	the JSON file to write.
+				-memreport file
+							a MemoryTrackerClass report to write after the run.
+				-maxgrowth N
+							fail if a scenario's measured frames leave more
+							than N more allocations live than they started with.
+
+Structs:	Settings
+				the options read from the command line.
+			ScenarioResult
+				the measurements of one scenario.
+
+Methods:	==================== PUBLIC ====================
+			BenchmarkClass()
+				Default constructor.
+			BenchmarkClass(const BenchmarkClass&)
+				Reference constructor.
+			~BenchmarkClass()
+				Default deconstructor.
+
+			bool Initialize(char*)
+				Call after creation with the command line to read the settings
+				and load the models and start the job system.
+			bool Run()
+				Use to run the requested scenarios and write the results.
+			void Shutdown()
+				Call before deletion to free the models and stop the job system.
+
+			static bool IsRequested(char*)
+				Use to check whether the command line asks for a benchmark.
+
+			==================== PRIVATE ====================
+			bool ParseCommandLine(char*)
+				Called by Initialize() to read the settings.
+			bool RunScenario(const std::string&, ScenarioResult&)
+				Called by Run() to build a scene, run it and tear it down.
+			void BuildScene(GameObjectManager*, const std::string&)
+				Called by RunScenario() to add the grid of cubes and whatever
+				else the scenario needs.
+			void RunFrame(const std::string&, GameObjectManager*, float&)
+				Called by RunScenario() to run one frame of a scenario.
+			void ReleaseScene(GameObjectManager*)
+				Called by RunScenario() to free every object created.
+			bool WriteResults(const std::vector<ScenarioResult>&)
+				Called by Run() to write the JSON file.
+			static double Percentile(std::vector<double>&, double)
+				Returns a percentile of a sorted list of frame times.
+
+Members:	==================== PRIVATE ====================
+			Settings m_settings
+				the options read from the command line.
+			D3DClass* m_D3D
+				a d3d class holding only the screen size and matrices.
+			CameraClass* m_Camera
+				the camera picks and projectiles are fired from.
+			CollisionClass* m_Collision
+				the collision object used for picking.
+			ModelClass* m_CubeModel
+				the cube model shared by every cube.
+			ModelClass* m_BulletModel
+				the sphere model shared by every projectile.
+			BumpModelClass* m_NinjaModel
+				the bump mapped ninja head the tangents scenario rebuilds.
+			JobSystemClass* m_JobSystem
+				the job system every scenario's updates are spread across.
+			FrameSnapshotClass* m_Snapshot
+				the snapshot the occluded scenario culls from each frame.
+			double m_modelLoadTime
+				the time taken to load both models, in ms.
+			std::vector<TextureGameObject*> m_cubes
+				the grid cubes of the current scenario, static unless it is
+				the spinning one.
+			std::vector<ProjectileObject*> m_projectiles
+				every projectile fired in the current scenario, including
+				those the GameObjectManager has since culled.
+			std::deque<TextureGameObject*> m_churnCubes
+				the dynamic cubes spawned by the churn scenario, oldest first.
+			std::mt19937 m_random
+				the random numbers for positions and picks, reseeded per scenario.
+			long long m_picks, m_pickHits
+				the picks made and how many hit something.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class BenchmarkClass
+{
+private:
+	struct Settings
+	{
+		std::string scenario;
+		int frames;
+		int warmupFrames;
+		int objects;
+		int projectilesPerSecond;
+		int picksPerFrame;
+		int churnPerFrame;
+		int workerThreads;
+		GameObjectManager::CollisionMode collisionMode;
+		GameObjectManager::BroadPhase broadPhase;
+		float gridCellSize;
+		int swarmProjectiles;
+		bool batchedTransforms;
+		std::string outputFile;
+		std::string memoryReportFile;
+		std::string depthDumpFile;
+		long long maxLiveGrowth;
+	};
+
+	struct ScenarioResult
+	{
+		std::string name;
+		std::vector<double> frameTimes;
+		long long collisionChecks;
+		long long obbRejections;
+		long long occludedObjects;
+		long long picks, pickHits;
+		long long allocations, allocatedBytes;
+		long long arenaOverflows;
+		size_t arenaHighWater;
+		long long liveAllocationGrowth, liveByteGrowth;
+		size_t finalObjects;
+	};
+
+public:
+	BenchmarkClass();
+	BenchmarkClass(const BenchmarkClass&);
+	~BenchmarkClass();
+
+	bool Initialize(char* commandLine);
+	bool Run();
+	void Shutdown();
+
+	static bool IsRequested(char* commandLine);
+
+private:
+	bool ParseCommandLine(char* commandLine);
+	bool RunScenario(const std::string& name, ScenarioResult& result);
+	void BuildScene(GameObjectManager* manager, const std::string& name);
+	void RunFrame(const std::string& name, GameObjectManager* manager, float& projectileBudget);
+	void ReleaseScene(GameObjectManager* manager);
+	bool WriteResults(const std::vector<ScenarioResult>& results);
+	static double Percentile(std::vector<double>& sortedTimes, double percentile);
+
+private:
+	Settings m_settings;
+	D3DClass* m_D3D;
+	CameraClass* m_Camera;
+	CollisionClass* m_Collision;
+	ModelClass* m_CubeModel;
+	ModelClass* m_BulletModel;
+	BumpModelClass* m_NinjaModel;
+	JobSystemClass* m_JobSystem;
+	FrameSnapshotClass* m_Snapshot;
+	double m_modelLoadTime;
+	std::vector<TextureGameObject*> m_cubes;
+	std::vector<ProjectileObject*> m_projectiles;
+	std::deque<TextureGameObject*> m_churnCubes;
+	std::mt19937 m_random;
+	long long m_picks, m_pickHits;
+};
+
+#endif
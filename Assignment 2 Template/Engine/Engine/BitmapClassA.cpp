@@ -9,6 +9,12 @@ BitmapClassA::BitmapClassA()
 	m_vertexBuffer = 0;
 	m_indexBuffer = 0;
 	m_Texture = 0;
+
+	// Sample the whole texture unless it is a region of an atlas.
+	m_textureLeft = 0.0f;
+	m_textureTop = 0.0f;
+	m_textureRight = 1.0f;
+	m_textureBottom = 1.0f;
 }
 
 
@@ -57,6 +63,41 @@ bool BitmapClassA::Initialize(ID3D11Device* device, int screenWidth, int screenH
 }
 
 
+bool BitmapClassA::Initialize(ID3D11Device* device, int screenWidth, int screenHeight, TextureAtlasClass* atlas, char* regionName, int bitmapWidth, int bitmapHeight)
+{
+	bool result;
+
+
+	// Store the screen size.
+	m_screenWidth = screenWidth;
+	m_screenHeight = screenHeight;
+
+	// Store the size in pixels that this bitmap should be rendered at.
+	m_bitmapWidth = bitmapWidth;
+	m_bitmapHeight = bitmapHeight;
+
+	// Initialize the previous rendering position to negative one.
+	m_previousPosX = -1;
+	m_previousPosY = -1;
+
+	// Initialize the vertex and index buffers.
+	result = InitializeBuffers(device);
+	if (!result)
+	{
+		return false;
+	}
+
+	// Share the atlas texture and sample this bitmap's region of it.
+	result = LoadTexture(atlas, regionName);
+	if (!result)
+	{
+		return false;
+	}
+
+	return true;
+}
+
+
 void BitmapClassA::Shutdown()
 {
 	// Release the bitmap texture.
@@ -69,7 +110,7 @@ void BitmapClassA::Shutdown()
 }
 
 
-bool BitmapClassA::Render(ID3D11DeviceContext* deviceContext, int positionX, int positionY)
+bool BitmapClassA::Render(RenderContext* deviceContext, int positionX, int positionY)
 {
 	bool result;
 
@@ -210,10 +251,9 @@ void BitmapClassA::ShutdownBuffers()
 }
 
 
-bool BitmapClassA::UpdateBuffers(ID3D11DeviceContext* deviceContext, int positionX, int positionY)
+bool BitmapClassA::UpdateBuffers(RenderContext* deviceContext, int positionX, int positionY)
 {
 	float left, right, top, bottom;
-	VertexType* vertices;
 	D3D11_MAPPED_SUBRESOURCE mappedResource;
 	VertexType* verticesPtr;
 	HRESULT result;
@@ -242,33 +282,29 @@ bool BitmapClassA::UpdateBuffers(ID3D11DeviceContext* deviceContext, int positio
 	// Calculate the screen coordinates of the bottom of the bitmap.
 	bottom = top - (float)m_bitmapHeight;
 
-	// Create the vertex array.
-	vertices = new VertexType[m_vertexCount];
-	if (!vertices)
-	{
-		return false;
-	}
+	// Create the vertex array in the frame arena.
+	FrameVector<VertexType> vertices(m_vertexCount);
 
 	// Load the vertex array with data.
 	// First triangle.
 	vertices[0].position = XMFLOAT2(left, top);  // Top left.
-	vertices[0].texture = XMFLOAT2(0.0f, 0.0f);
+	vertices[0].texture = XMFLOAT2(m_textureLeft, m_textureTop);
 
 	vertices[1].position = XMFLOAT2(right, bottom);  // Bottom right.
-	vertices[1].texture = XMFLOAT2(1.0f, 1.0f);
+	vertices[1].texture = XMFLOAT2(m_textureRight, m_textureBottom);
 
 	vertices[2].position = XMFLOAT2(left, bottom);  // Bottom left.
-	vertices[2].texture = XMFLOAT2(0.0f, 1.0f);
+	vertices[2].texture = XMFLOAT2(m_textureLeft, m_textureBottom);
 
 	// Second triangle.
 	vertices[3].position = XMFLOAT2(left, top);  // Top left.
-	vertices[3].texture = XMFLOAT2(0.0f, 0.0f);
+	vertices[3].texture = XMFLOAT2(m_textureLeft, m_textureTop);
 
 	vertices[4].position = XMFLOAT2(right, top);  // Top right.
-	vertices[4].texture = XMFLOAT2(1.0f, 0.0f);
+	vertices[4].texture = XMFLOAT2(m_textureRight, m_textureTop);
 
 	vertices[5].position = XMFLOAT2(right, bottom);  // Bottom right.
-	vertices[5].texture = XMFLOAT2(1.0f, 1.0f);
+	vertices[5].texture = XMFLOAT2(m_textureRight, m_textureBottom);
 
 	// Lock the vertex buffer so it can be written to.
 	result = deviceContext->Map(m_vertexBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource);
@@ -281,20 +317,16 @@ bool BitmapClassA::UpdateBuffers(ID3D11DeviceContext* deviceContext, int positio
 	verticesPtr = (VertexType*)mappedResource.pData;
 
 	// Copy the data into the vertex buffer.
-	memcpy(verticesPtr, (void*)vertices, (sizeof(VertexType) * m_vertexCount));
+	memcpy(verticesPtr, (void*)vertices.data(), (sizeof(VertexType) * m_vertexCount));
 
 	// Unlock the vertex buffer.
 	deviceContext->Unmap(m_vertexBuffer, 0);
 
-	// Release the vertex array as it is no longer needed.
-	delete[] vertices;
-	vertices = 0;
-
 	return true;
 }
 
 
-void BitmapClassA::RenderBuffers(ID3D11DeviceContext* deviceContext)
+void BitmapClassA::RenderBuffers(RenderContext* deviceContext)
 {
 	unsigned int stride;
 	unsigned int offset;
@@ -340,6 +372,41 @@ bool BitmapClassA::LoadTexture(ID3D11Device* device, WCHAR* filename)
 }
 
 
+bool BitmapClassA::LoadTexture(TextureAtlasClass* atlas, char* regionName)
+{
+	TextureAtlasClass::AtlasRegion region;
+	bool result;
+
+
+	// Find where this bitmap was packed in the atlas.
+	result = atlas->GetRegion(regionName, region);
+	if (!result)
+	{
+		return false;
+	}
+
+	m_textureLeft = region.left;
+	m_textureTop = region.top;
+	m_textureRight = region.right;
+	m_textureBottom = region.bottom;
+
+	// Create the texture object holding a reference to the atlas.
+	m_Texture = new TextureClass;
+	if (!m_Texture)
+	{
+		return false;
+	}
+
+	result = m_Texture->Initialize(atlas->GetTexture());
+	if (!result)
+	{
+		return false;
+	}
+
+	return true;
+}
+
+
 void BitmapClassA::ReleaseTexture()
 {
 	// Release the texture object.
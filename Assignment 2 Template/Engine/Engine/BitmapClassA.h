@@ -17,6 +17,9 @@
 // MY CLASS INCLUDES //
 ///////////////////////
 #include "textureclass.h"
+#include "TextureAtlasClass.h"
+#include "RenderContext.h"
+#include "FrameArenaClass.h"
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -37,8 +40,9 @@ public:
 	~BitmapClassA();
 
 	bool Initialize(ID3D11Device*, int, int, WCHAR*, int, int);
+	bool Initialize(ID3D11Device*, int, int, TextureAtlasClass*, char*, int, int);
 	void Shutdown();
-	bool Render(ID3D11DeviceContext*, int, int);
+	bool Render(RenderContext*, int, int);
 
 	int GetIndexCount();
 	ID3D11ShaderResourceView* GetTexture();
@@ -46,10 +50,11 @@ public:
 private:
 	bool InitializeBuffers(ID3D11Device*);
 	void ShutdownBuffers();
-	bool UpdateBuffers(ID3D11DeviceContext*, int, int);
-	void RenderBuffers(ID3D11DeviceContext*);
+	bool UpdateBuffers(RenderContext*, int, int);
+	void RenderBuffers(RenderContext*);
 
 	bool LoadTexture(ID3D11Device*, WCHAR*);
+	bool LoadTexture(TextureAtlasClass*, char*);
 	void ReleaseTexture();
 
 private:
@@ -59,6 +64,7 @@ private:
 	int m_screenWidth, m_screenHeight;
 	int m_bitmapWidth, m_bitmapHeight;
 	int m_previousPosX, m_previousPosY;
+	float m_textureLeft, m_textureTop, m_textureRight, m_textureBottom;
 };
 
 #endif
\ No newline at end of file
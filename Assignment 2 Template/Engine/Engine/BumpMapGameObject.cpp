@@ -94,17 +94,14 @@ Modifies:	[none].
 Returns:	bool
 				was the rendering successful or not?
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-bool BumpMapGameObject::Render(ShaderManagerClass* shaderManager, ID3D11DeviceContext* device,
-	XMMATRIX &worldMatrix, const XMMATRIX &viewMatrix, const XMMATRIX &projectionMatrix)
+bool BumpMapGameObject::Render(ShaderManagerClass* shaderManager, RenderContext* device,
+	XMMATRIX &worldMatrix, const XMMATRIX &viewProjectionMatrix, float animationTime)
 {
 	//Render the model to the device.
 	GetModel()->Render(device);
 
-	//Calculate the worldMatrix based off this GameObject's transform data.
-	XMMATRIX* newWorldMatrix = this->CalcWorldMatrix(worldMatrix);
-
 	//Use the shaderManager's bumpMap shader to render this object.
-	return shaderManager->RenderBumpMapShader(device, GetModel()->GetIndexCount(), *newWorldMatrix, viewMatrix, projectionMatrix,
+	return shaderManager->RenderBumpMapShader(device, GetModel()->GetIndexCount(), worldMatrix, viewProjectionMatrix,
 		GetModel()->GetColorTexture(), GetModel()->GetNormalMapTexture(), m_Light->GetDirection(),
 		m_Light->GetDiffuseColor());
 }
@@ -151,16 +148,81 @@ Args:		BumpModelClass* baseModel
 				a pointer to a BumpModelClass object to setup this
 				gameObject with.
 
-Modifies:	[m_baseModel, m_min, m_max, m_transform, m_scale, m_rotation].
+Modifies:	[m_baseModel, m_min, m_max, m_transform, m_scale, m_orientation].
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 void BumpMapGameObject::Setup(BumpModelClass * baseModel)
 {
 	m_baseModel = baseModel;
-	m_min = new XMFLOAT3(m_baseModel->m_min->x, m_baseModel->m_min->y, m_baseModel->m_min->z);
-	m_max = new XMFLOAT3(m_baseModel->m_max->x, m_baseModel->m_max->y, m_baseModel->m_max->z);
+	m_min = new XMFLOAT3(-1.0f, -1.0f, -1.0f);
+	m_max = new XMFLOAT3(1.0f, 1.0f, 1.0f);
+	m_boundsPending = true;
+	CheckModelReady();
 	BoundingBox::CreateFromPoints(*m_AABB, XMLoadFloat3(m_min), XMLoadFloat3(m_max));
 	m_transform = new XMFLOAT3(0, 0, 0);
 	m_scale = new XMFLOAT3(1, 1, 1);
-	m_rotation = new XMFLOAT3(0, 0, 0);
+	m_orientation = new XMFLOAT4(0, 0, 0, 1);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		IsModelReady
+
+Summary:	An override of IsModelReady from GameObject.h that queries
+			the BumpModelClass instead.
+
+Returns:	bool
+				is the base model ready to be drawn.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool BumpMapGameObject::IsModelReady()
+{
+	return m_baseModel && m_baseModel->IsReady();
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RequestTextureDetail
+
+Summary:	An override of RequestTextureDetail from GameObject.h that
+			passes the size on screen to the BumpModelClass instead.
+
+Args:		float screenPixels
+				the size of the gameObject on screen, in pixels.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void BumpMapGameObject::RequestTextureDetail(float screenPixels)
+{
+	if (m_baseModel)
+		m_baseModel->RequestTextureSize(screenPixels);
 }
 
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetMeshBVH
+
+Summary:	An override of GetMeshBVH from GameObject.h that returns the
+			triangle hierarchy of the BumpModelClass instead.
+
+Modifies:	[none].
+
+Returns:	MeshBVHClass*
+				the hierarchy in model space, or 0 if the base model has
+				not finished streaming in.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+MeshBVHClass * BumpMapGameObject::GetMeshBVH()
+{
+	if (!IsModelReady())
+		return 0;
+
+	return m_baseModel->GetBVH();
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RefreshBounds
+
+Summary:	An override of RefreshBounds from GameObject.h that copies
+			the bounds of the BumpModelClass instead.
+
+Modifies:	[m_min, m_max, m_AABB].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void BumpMapGameObject::RefreshBounds()
+{
+	CopyBounds(m_baseModel->m_min, m_baseModel->m_max);
+}
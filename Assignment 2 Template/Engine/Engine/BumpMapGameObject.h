@@ -36,6 +36,12 @@ Methods:	==================== PUBLIC ====================
 				Implementation of Render from GameObject, call to
 				render this gameObject with its sizing data to
 				the specified device.
+			RequestTextureDetail(float)
+				Override of RequestTextureDetail from GameObject, passes the
+				on screen size to both textures of the BumpModelClass.
+			GetMeshBVH()
+				Override of GetMeshBVH from GameObject, returns the triangle
+				hierarchy of the BumpModelClass.
 
 			SetLight(LightClass*)
 				Used to change the light being used by the BumpMapGameObject.
@@ -50,6 +56,12 @@ Methods:	==================== PUBLIC ====================
 				the same function but use a BumpModelClass* object instead.
 				Used by Constructors 2 and 3 for setting up the gameObject.
 
+			bool IsModelReady()
+				Overrides IsModelReady from GameObject to query the BumpModelClass.
+			void RefreshBounds()
+				Overrides RefreshBounds from GameObject to copy the bounds of the
+				BumpModelClass once it has streamed in.
+
 Members:	==================== PRIVATE ====================
 			LightClass* m_Light
 				the light to be queried by this BumpMapGameObject's render function
@@ -66,8 +78,10 @@ public:
 	BumpMapGameObject(BumpModelClass* baseModel);
 	BumpMapGameObject(BumpModelClass* baseModel, LightClass* light);
 
-	virtual bool Render(ShaderManagerClass* shaderManager, ID3D11DeviceContext* device,
-		XMMATRIX &worldMatrix, const XMMATRIX &viewMatrix, const XMMATRIX &projectionMatrix) override;
+	virtual bool Render(ShaderManagerClass* shaderManager, RenderContext* device,
+		XMMATRIX &worldMatrix, const XMMATRIX &viewProjectionMatrix, float animationTime) override;
+	virtual void RequestTextureDetail(float screenPixels) override;
+	virtual MeshBVHClass* GetMeshBVH() override;
 
 	void SetLight(LightClass* light);
 
@@ -75,6 +89,9 @@ private:
 	BumpModelClass* GetModel();
 
 	void Setup(BumpModelClass* baseModel);
+
+	virtual bool IsModelReady() override;
+	virtual void RefreshBounds() override;
 	
 private:
 	LightClass* m_Light;
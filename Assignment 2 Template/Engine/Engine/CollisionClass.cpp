@@ -165,8 +165,8 @@ bool CollisionClass::TestRayAABBIntersect(int mouseX, int mouseY, BoundingBox* A
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
 Method:		CollisionTestLoop
 
-Summary:	Tests for a ray collision intersection by a ray at mouseX
-			and mouseY with all objects concerned by the GameObjectManager
+Summary:	Finds the closest object concerned by the GameObjectManager
+			hit by a ray at mouseX and mouseY.
 
 Args:		int mouseX
 				the x co-ordinate on the screen that the ray is shot into.
@@ -177,7 +177,7 @@ Args:		int mouseX
 				for testing ray collision against.
 			FXMVECTOR FXMcamPosition
 				an XMVECTOR storing the current world space position of
-				the camera.
+				the camera. Unused, as hits are ordered along the ray.
 
 Returns:	GameObject*
 				a pointer to the closest GameObject collided with.
@@ -186,51 +186,302 @@ M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 GameObject * CollisionClass::CollisionTestLoop(int mouseX, int mouseY, GameObjectManager * objManager, FXMVECTOR FXMcamPosition)
 {
 	//Calculate and store the ray information from the mouseX and mouseY
-	XMFLOAT3 rayOrigin, rayDirection;
-	GetRay(rayOrigin, rayDirection, mouseX, mouseY);
+	Ray ray;
+	XMINT2 point(mouseX, mouseY);
+	GetRays(m_D3D, m_Camera, &point, 1, &ray);
 
-	//Create a temporary list of objects collided with.
-	std::vector<GameObject*>* collidedList = new std::vector<GameObject*>();
+	//Find the first thing along it.
+	RayHit hit;
+	RayClosestHit(ray, objManager, hit);
 
-	//For all lists in the GameObjectManager - Check for a collision with the AABB, if so - push it onto the collidedlist vector.
+	return hit.object;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		ForEachMovingObject
+
+Summary:	Calls function with every dynamic object then every projectile
+			of the GameObjectManager, until it returns false. The static
+			objects are left out, as rays find those through the manager's
+			static hierarchy rather than testing each in turn.
+
+Args:		GameObjectManager* objManager
+				the manager holding the objects.
+			Function function
+				called with each GameObject*, returning whether to go on.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+template<typename Function>
+void CollisionClass::ForEachMovingObject(GameObjectManager * objManager, Function function)
+{
 	for (std::vector<GameObject*>::iterator iter = objManager->GetList(GameObjectManager::OBJECTTYPE_DYNAMIC)->begin();
 		iter != objManager->GetList(GameObjectManager::OBJECTTYPE_DYNAMIC)->end();
 		iter++)
 	{
-		GameObject* obj = *iter;
-		if (rayAABBIntersect(XMLoadFloat3(&rayOrigin), XMLoadFloat3(&rayDirection), obj->GetAABB()))
-			collidedList->push_back(obj);
-	}
-	for (std::vector<GameObject*>::iterator iter = objManager->GetList(GameObjectManager::OBJECTTYPE_STATIC)->begin();
-		iter != objManager->GetList(GameObjectManager::OBJECTTYPE_STATIC)->end();
-		iter++)
-	{
-		GameObject* obj = *iter;
-		if (rayAABBIntersect(XMLoadFloat3(&rayOrigin), XMLoadFloat3(&rayDirection), obj->GetAABB()))
-			collidedList->push_back(obj);
+		if (!function(*iter))
+			return;
 	}
 	for (std::vector<ProjectileObject*>::iterator iter = objManager->GetProjectileList()->begin();
 		iter != objManager->GetProjectileList()->end();
 		iter++)
 	{
-		GameObject* obj = *iter;
-		if (rayAABBIntersect(XMLoadFloat3(&rayOrigin), XMLoadFloat3(&rayDirection), obj->GetAABB()))
-			collidedList->push_back(obj);
+		if (!function(*iter))
+			return;
 	}
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RayClosestHit
+
+Summary:	Finds the closest object concerned by the GameObjectManager
+			that a ray hits, tracking the distance of the best hit so far.
+			Every object's AABB is tested first, and only those the ray
+			enters before the best hit go on to have the triangles of
+			their model tested, so nothing is collected or sorted.
+			Static objects are walked through the manager's static
+			hierarchy, nearest first, so most are never reached.
+
+Args:		const Ray& ray
+				the ray to cast.
+			GameObjectManager* objManager
+				the manager holding the objects to test.
+			RayHit& hit
+				set to the closest object hit and its distance, or nullptr
+				and the ray's maxDistance if nothing was hit.
+
+Returns:	bool
+				whether anything was hit.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool CollisionClass::RayClosestHit(const Ray & ray, GameObjectManager * objManager, RayHit & hit)
+{
+	XMVECTOR origin = XMLoadFloat3(&ray.origin);
+	XMVECTOR direction = XMLoadFloat3(&ray.direction);
+
+	hit.object = nullptr;
+	hit.distance = ray.maxDistance;
+
+	//Keep any object hit nearer than the best so far.
+	ForEachMovingObject(objManager, [&](GameObject* object)
+	{
+		if (RayObjectIntersect(origin, direction, object, hit.distance, false))
+			hit.object = object;
+		return true;
+	});
+
+	//Then any static object, skipping the nodes beyond the best hit.
+	std::vector<GameObject*>* statics = objManager->GetList(GameObjectManager::OBJECTTYPE_STATIC);
+	objManager->GetStaticTree()->Raycast(origin, direction, hit.distance, [&](int item, float& distance)
+	{
+		if (RayObjectIntersect(origin, direction, (*statics)[item], distance, false))
+			hit.object = (*statics)[item];
+		return true;
+	});
+
+	return hit.object != nullptr;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RayAnyHit
+
+Summary:	Checks whether a ray hits any object concerned by the
+			GameObjectManager before its maxDistance, stopping at the
+			first hit found rather than looking for the closest.
+
+Args:		const Ray& ray
+				the ray to cast.
+			GameObjectManager* objManager
+				the manager holding the objects to test.
+
+Returns:	bool
+				whether anything was hit.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool CollisionClass::RayAnyHit(const Ray & ray, GameObjectManager * objManager)
+{
+	XMVECTOR origin = XMLoadFloat3(&ray.origin);
+	XMVECTOR direction = XMLoadFloat3(&ray.direction);
 
+	bool hit = false;
+	ForEachMovingObject(objManager, [&](GameObject* object)
+	{
+		float distance = ray.maxDistance;
+		hit = RayObjectIntersect(origin, direction, object, distance, true);
+		return !hit;
+	});
+
+	if (hit)
+		return true;
 
-	//If the list is not 0 length
-	if (collidedList->size() > 0)
+	std::vector<GameObject*>* statics = objManager->GetList(GameObjectManager::OBJECTTYPE_STATIC);
+	float limit = ray.maxDistance;
+	objManager->GetStaticTree()->Raycast(origin, direction, limit, [&](int item, float& distance)
 	{
-		//Sort the collided list by distance from the camera.
-		Sort(collidedList, FXMcamPosition);
+		float objectDistance = distance;
+		hit = RayObjectIntersect(origin, direction, (*statics)[item], objectDistance, true);
+		return !hit;
+	});
+
+	return hit;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RayAllHits
+
+Summary:	Finds every object concerned by the GameObjectManager that a
+			ray hits before its maxDistance, writing them nearest first
+			into a buffer given by the caller. If more are hit than fit,
+			the nearest are kept, and once the buffer is full objects
+			entered beyond its farthest hit are skipped.
+
+Args:		const Ray& ray
+				the ray to cast.
+			GameObjectManager* objManager
+				the manager holding the objects to test.
+			RayHit* hits
+				the buffer to write the hits to.
+			int maxHits
+				the number of hits the buffer holds.
+
+Returns:	int
+				the number of hits written.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+int CollisionClass::RayAllHits(const Ray & ray, GameObjectManager * objManager, RayHit * hits, int maxHits)
+{
+	XMVECTOR origin = XMLoadFloat3(&ray.origin);
+	XMVECTOR direction = XMLoadFloat3(&ray.direction);
+
+	int count = 0;
+	if (maxHits <= 0)
+		return 0;
 
-		//Return the first 
-		return collidedList->at(0);
+	//Test an object, keeping its hit if it is among the nearest.
+	auto test = [&](GameObject* object)
+	{
+		//Look only as far as the farthest hit kept, once the buffer is full.
+		float distance = (count == maxHits) ? hits[count - 1].distance : ray.maxDistance;
+		if (!RayObjectIntersect(origin, direction, object, distance, false))
+			return true;
+
+		//Insert the hit in order, dropping the farthest if the buffer is full.
+		int i = (count < maxHits) ? count++ : count - 1;
+		while (i > 0 && hits[i - 1].distance > distance)
+		{
+			hits[i] = hits[i - 1];
+			i--;
+		}
+		hits[i].object = object;
+		hits[i].distance = distance;
+		return true;
+	};
+	ForEachMovingObject(objManager, test);
+
+	//Walk the static hierarchy only as far as the farthest hit kept, once the buffer is full.
+	std::vector<GameObject*>* statics = objManager->GetList(GameObjectManager::OBJECTTYPE_STATIC);
+	float limit = (count == maxHits) ? hits[count - 1].distance : ray.maxDistance;
+	objManager->GetStaticTree()->Raycast(origin, direction, limit, [&](int item, float& distance)
+	{
+		test((*statics)[item]);
+		if (count == maxHits)
+			distance = hits[count - 1].distance;
+		return true;
+	});
+
+	return count;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RayClosestHit
+
+Summary:	Finds the closest hit of each of a batch of rays, as for a
+			single ray. The bounds, triangle hierarchy and inverse world
+			matrix of every moving object are gathered once for the whole
+			batch, rather than once for each ray that reaches the object.
+			Static objects are found through the static hierarchy for each
+			ray, so only those near it are tested.
+
+Args:		const Ray* rays
+				the rays to cast.
+			int count
+				the number of rays.
+			GameObjectManager* objManager
+				the manager holding the objects to test.
+			RayHit* hits
+				the closest hit of each ray, as for a single ray.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void CollisionClass::RayClosestHit(const Ray * rays, int count, GameObjectManager * objManager, RayHit * hits)
+{
+	FrameVector<RayTarget> targets;
+	GatherTargets(objManager, targets);
+	SceneBVHClass* tree = objManager->GetStaticTree();
+	std::vector<GameObject*>* statics = objManager->GetList(GameObjectManager::OBJECTTYPE_STATIC);
+
+	for (int i = 0; i < count; i++)
+	{
+		XMVECTOR origin = XMLoadFloat3(&rays[i].origin);
+		XMVECTOR direction = XMLoadFloat3(&rays[i].direction);
+
+		hits[i].object = nullptr;
+		hits[i].distance = rays[i].maxDistance;
+
+		for (size_t j = 0; j < targets.size(); j++)
+		{
+			if (RayTargetIntersect(origin, direction, targets[j], hits[i].distance, false))
+				hits[i].object = targets[j].object;
+		}
+
+		tree->Raycast(origin, direction, hits[i].distance, [&](int item, float& distance)
+		{
+			if (RayObjectIntersect(origin, direction, (*statics)[item], distance, false))
+				hits[i].object = (*statics)[item];
+			return true;
+		});
 	}
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RayAnyHit
+
+Summary:	Checks whether each of a batch of rays hits anything, as for
+			a single ray, gathering every moving object once for the whole
+			batch.
+
+Args:		const Ray* rays
+				the rays to cast.
+			int count
+				the number of rays.
+			GameObjectManager* objManager
+				the manager holding the objects to test.
+			bool* hits
+				whether each ray hit anything.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void CollisionClass::RayAnyHit(const Ray * rays, int count, GameObjectManager * objManager, bool * hits)
+{
+	FrameVector<RayTarget> targets;
+	GatherTargets(objManager, targets);
+	SceneBVHClass* tree = objManager->GetStaticTree();
+	std::vector<GameObject*>* statics = objManager->GetList(GameObjectManager::OBJECTTYPE_STATIC);
 
-	//If this point is reached then nothing was collided with.
-	return nullptr;
+	for (int i = 0; i < count; i++)
+	{
+		XMVECTOR origin = XMLoadFloat3(&rays[i].origin);
+		XMVECTOR direction = XMLoadFloat3(&rays[i].direction);
+
+		hits[i] = false;
+		for (size_t j = 0; j < targets.size() && !hits[i]; j++)
+		{
+			float distance = rays[i].maxDistance;
+			hits[i] = RayTargetIntersect(origin, direction, targets[j], distance, true);
+		}
+
+		if (hits[i])
+			continue;
+
+		float limit = rays[i].maxDistance;
+		tree->Raycast(origin, direction, limit, [&](int item, float& distance)
+		{
+			float objectDistance = distance;
+			hits[i] = RayObjectIntersect(origin, direction, (*statics)[item], objectDistance, true);
+			return !hits[i];
+		});
+	}
 }
 
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -238,6 +489,7 @@ Method:		GetRay
 
 Summary:	A static function to get and return a vector for a ray
 			from the position of cam in the direction of mousex,mouseY.
+			A batch of one for GetRays().
 
 Args:		D3DClass* d3d
 				a pointer to the D3DClass being used.
@@ -250,45 +502,77 @@ Args:		D3DClass* d3d
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 void CollisionClass::GetRay(D3DClass* d3d, CameraClass* cam, XMFLOAT3 & directionOut, int mouseX, int mouseY)
 {
-	float pointX, pointY;
-	XMMATRIX mprojectionMatrix, mviewMatrix, minverseViewMatrix, mworldMatrix, minverseWorldMatrix;
-	XMFLOAT4X4 projectionMatrix, inverseViewMatrix;
-	XMFLOAT3 direction;
-
-	// Move the mouse cursor coordinates into the -1 to +1 range.
-	pointX = ((2.0f * (float)mouseX) / (float)d3d->m_screenWidth) - 1.0f;
-	pointY = (((2.0f * (float)mouseY) / (float)d3d->m_screenHeight) - 1.0f) * -1.0f;
-
-	// Adjust the points using the projection matrix to account for the aspect ratio of the viewport.
-	d3d->GetProjectionMatrix(mprojectionMatrix);
-	XMStoreFloat4x4(&projectionMatrix, mprojectionMatrix);
-	pointX = pointX / projectionMatrix._11;
-	pointY = pointY / projectionMatrix._22;
-
-	// Get the inverse of the view matrix.
-	cam->GetViewMatrix(mviewMatrix);
-	XMVECTOR viewDeterminant = XMMatrixDeterminant(mviewMatrix);
-	minverseViewMatrix = XMMatrixInverse(&viewDeterminant, mviewMatrix);
+	Ray ray;
+	XMINT2 point(mouseX, mouseY);
+	GetRays(d3d, cam, &point, 1, &ray);
 
-	XMStoreFloat4x4(&inverseViewMatrix, minverseViewMatrix);
+	directionOut = ray.direction;
 
-	// Calculate the direction of the picking ray in view space.
-	direction.x = (pointX * inverseViewMatrix._11) + (pointY * inverseViewMatrix._21) + inverseViewMatrix._31;
-	direction.y = (pointX * inverseViewMatrix._12) + (pointY * inverseViewMatrix._22) + inverseViewMatrix._32;
-	direction.z = (pointX * inverseViewMatrix._13) + (pointY * inverseViewMatrix._23) + inverseViewMatrix._33;
+	return;
+}
 
-	// Get the world matrix
-	d3d->GetWorldMatrix(mworldMatrix);
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetRays
 
-	// Now get the inverse of the translated world matrix.
-	XMVECTOR worldDeterminant = XMMatrixDeterminant(mworldMatrix);
-	minverseWorldMatrix = XMMatrixInverse(&worldDeterminant, mworldMatrix);
-	XMStoreFloat3(&directionOut, XMVector3TransformNormal(XMLoadFloat3(&direction), minverseWorldMatrix));
+Summary:	A static function to get a ray from the position of cam through
+			each of many points on the screen at once.
+			Everything the points share, the aspect ratio of the projection
+			and the camera's cached inverse view matrix, is folded into a
+			step along each screen axis and the direction through the top
+			left pixel before the loop, so each ray only costs two
+			multiply-adds and a normalize. The world matrix is the identity,
+			so the rays need no moving out of its space.
 
-	// Normalize the ray direction.
-	XMStoreFloat3(&directionOut, XMVector3Normalize(XMLoadFloat3(&directionOut)));
+Args:		D3DClass* d3d
+				a pointer to the D3DClass holding the size of the screen.
+			CameraClass* cam
+				a pointer to the Camera the rays are cast from.
+			const XMINT2* points
+				the positions on the screen to cast through.
+			int count
+				the number of points.
+			Ray* raysOut
+				a buffer of count rays to store the rays in, each of them
+				unbounded.
+
+Modifies:	[cam].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void CollisionClass::GetRays(D3DClass * d3d, CameraClass * cam, const XMINT2 * points, int count, Ray * raysOut)
+{
+	//Bring the cached matrices up to date with wherever the camera was last placed.
+	cam->Render();
+
+	XMMATRIX projectionMatrix, inverseViewMatrix;
+	cam->GetProjectionMatrix(projectionMatrix);
+	cam->GetInverseViewMatrix(inverseViewMatrix);
+
+	//A pixel's view space direction is (x * scaleX + offsetX, y * scaleY + offsetY, 1): the pixel
+	//moved into the -1 to +1 range, then divided by the projection to undo the aspect ratio.
+	float projectionX = XMVectorGetX(projectionMatrix.r[0]);
+	float projectionY = XMVectorGetY(projectionMatrix.r[1]);
+	float scaleX = 2.0f / ((float)d3d->m_screenWidth * projectionX);
+	float scaleY = -2.0f / ((float)d3d->m_screenHeight * projectionY);
+	float offsetX = -1.0f / projectionX;
+	float offsetY = 1.0f / projectionY;
+
+	//Rotate it into world space once for the whole batch.
+	XMVECTOR stepX = XMVectorScale(inverseViewMatrix.r[0], scaleX);
+	XMVECTOR stepY = XMVectorScale(inverseViewMatrix.r[1], scaleY);
+	XMVECTOR corner = XMVectorMultiplyAdd(XMVectorReplicate(offsetX), inverseViewMatrix.r[0],
+		XMVectorMultiplyAdd(XMVectorReplicate(offsetY), inverseViewMatrix.r[1], inverseViewMatrix.r[2]));
+
+	//Every ray starts at the camera.
+	XMFLOAT3 origin = cam->GetPosition();
+
+	for (int i = 0; i < count; i++)
+	{
+		XMVECTOR direction = XMVectorMultiplyAdd(XMVectorReplicate((float)points[i].x), stepX,
+			XMVectorMultiplyAdd(XMVectorReplicate((float)points[i].y), stepY, corner));
 
-	return;
+		raysOut[i].origin = origin;
+		XMStoreFloat3(&raysOut[i].direction, XMVector3Normalize(direction));
+		raysOut[i].maxDistance = (float)INFINITY;
+	}
 }
 
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -308,6 +592,37 @@ bool CollisionClass::Intersects(BoundingBox * a, BoundingBox * b)
 	return a->Intersects(*b);
 }
 
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Intersects
+
+Summary:	A static method to test two objects whose AABBs are already
+			known to overlap against the oriented boxes of whichever of
+			them are rotated, with a separating axis test. The AABB of a
+			rotated object can be far larger than the object, so many of
+			the pairs it lets through are rejected here.
+
+Args:		GameObject* a, b
+				pointers to the two objects to check intersection of.
+
+Returns:	bool
+				Whether or not the tightest bounds of the two objects intersect.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool CollisionClass::Intersects(GameObject * a, GameObject * b)
+{
+	BoundingOrientedBox* orientedA = a->GetOBB();
+	BoundingOrientedBox* orientedB = b->GetOBB();
+
+	//Objects that are not rotated are fitted exactly by their AABB.
+	if (orientedA && orientedB)
+		return orientedA->Intersects(*orientedB);
+	if (orientedA)
+		return orientedA->Intersects(*b->GetAABB());
+	if (orientedB)
+		return orientedB->Intersects(*a->GetAABB());
+
+	return a->GetAABB()->Intersects(*b->GetAABB());
+}
+
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
 Method:		RaySphereIntersect
 
@@ -417,19 +732,165 @@ bool CollisionClass::rayAABBIntersect(FXMVECTOR rayOrigin, FXMVECTOR rayDirectio
 	if (intersections[0].x > intersections[1].z || intersections[0].z > intersections[1].x)
 		return false;*/
 
-	float* infinity = new float;
-	*infinity = (float)INFINITY;
-	return AABB->Intersects(rayOrigin, rayDirection, *infinity);
+	float distance = (float)INFINITY;
+	return AABB->Intersects(rayOrigin, rayDirection, distance);
 
 	//If this point is reached then the intersection must be true.
 	return true;
 }
 
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RayObjectIntersect
+
+Summary:	Tests whether a ray hits an object nearer than distance.
+			The ray must enter the object's AABB before distance, and its
+			OBB too if it is rotated, then it is taken into the space of
+			the object's model by the inverse of its world matrix and
+			tested against the model's triangles. As the direction keeps
+			its length, distances along it stay in world units. Objects
+			with no triangle hierarchy count as hit where the ray enters
+			their AABB, and objects whose model is still streaming in are
+			never hit.
+
+Args:		FXMVECTOR rayOrigin
+				an XMVECTOR describing the origin point of the raycast.
+			FXMVECTOR rayDirection
+				an XMVECTOR describing the unit direction of the raycast.
+			GameObject* object
+				the object to test.
+			float& distance
+				the distance to beat, set to the distance of the hit if
+				there is one and anyHit is false.
+			bool anyHit
+				whether any hit will do, rather than the closest.
+
+Returns:	bool
+				whether the ray hit the object nearer than distance.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool CollisionClass::RayObjectIntersect(FXMVECTOR rayOrigin, FXMVECTOR rayDirection, GameObject* object, float& distance, bool anyHit)
+{
+	//An object still streaming in only has a placeholder box, so there is nothing to hit.
+	if (!object->HasBounds())
+		return false;
+
+	//Skip the object if the ray misses its AABB, or enters it beyond the closest hit.
+	float entry;
+	if (!object->GetAABB()->Intersects(rayOrigin, rayDirection, entry) || entry >= distance)
+		return false;
+
+	//The AABB of a rotated object reaches well beyond it, so check its OBB as well.
+	BoundingOrientedBox* orientedBounds = object->GetOBB();
+	if (orientedBounds && (!orientedBounds->Intersects(rayOrigin, rayDirection, entry) || entry >= distance))
+		return false;
+
+	//Without triangles the bounds are the best there is.
+	MeshBVHClass* bvh = object->GetMeshBVH();
+	if (!bvh)
+	{
+		distance = entry;
+		return true;
+	}
+
+	//Take the ray into model space and find the closest triangle it hits.
+	XMMATRIX inverseWorldMatrix = XMMatrixInverse(nullptr, object->GetWorldMatrix());
+	XMVECTOR origin = XMVector3TransformCoord(rayOrigin, inverseWorldMatrix);
+	XMVECTOR direction = XMVector3TransformNormal(rayDirection, inverseWorldMatrix);
+
+	if (anyHit)
+		return bvh->IntersectsAny(origin, direction, distance);
+
+	return bvh->Intersects(origin, direction, distance);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RayTargetIntersect
+
+Summary:	Tests whether a ray hits an object gathered for a batch of
+			rays nearer than distance, as RayObjectIntersect() does, using
+			the bounds and inverse world matrix gathered with it.
+
+Args:		FXMVECTOR rayOrigin
+				an XMVECTOR describing the origin point of the raycast.
+			FXMVECTOR rayDirection
+				an XMVECTOR describing the unit direction of the raycast.
+			const RayTarget& target
+				the gathered object to test.
+			float& distance
+				the distance to beat, set to the distance of the hit if
+				there is one and anyHit is false.
+			bool anyHit
+				whether any hit will do, rather than the closest.
+
+Returns:	bool
+				whether the ray hit the object nearer than distance.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool CollisionClass::RayTargetIntersect(FXMVECTOR rayOrigin, FXMVECTOR rayDirection, const RayTarget & target, float & distance, bool anyHit)
+{
+	float entry;
+	if (!target.bounds.Intersects(rayOrigin, rayDirection, entry) || entry >= distance)
+		return false;
+
+	if (target.rotated && (!target.orientedBounds.Intersects(rayOrigin, rayDirection, entry) || entry >= distance))
+		return false;
+
+	if (!target.bvh)
+	{
+		distance = entry;
+		return true;
+	}
+
+	XMMATRIX inverseWorldMatrix = XMLoadFloat4x4(&target.inverseWorldMatrix);
+	XMVECTOR origin = XMVector3TransformCoord(rayOrigin, inverseWorldMatrix);
+	XMVECTOR direction = XMVector3TransformNormal(rayDirection, inverseWorldMatrix);
+
+	if (anyHit)
+		return target.bvh->IntersectsAny(origin, direction, distance);
+
+	return target.bvh->Intersects(origin, direction, distance);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GatherTargets
+
+Summary:	Gathers the bounds, oriented box, triangle hierarchy and inverse
+			world matrix of every dynamic object and projectile, so a batch
+			of rays works them out once between them. Objects whose model
+			is still streaming in are left out.
+
+Args:		GameObjectManager* objManager
+				the manager holding the objects.
+			FrameVector<RayTarget>& targets
+				the list to gather into, in the frame arena.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void CollisionClass::GatherTargets(GameObjectManager * objManager, FrameVector<RayTarget>& targets)
+{
+	ForEachMovingObject(objManager, [&](GameObject* object)
+	{
+		//Leave out objects still streaming in, whose bounds are a placeholder.
+		if (!object->HasBounds())
+			return true;
+
+		RayTarget target;
+		target.object = object;
+		target.bounds = *object->GetAABB();
+		target.rotated = object->GetOBB() != 0;
+		if (target.rotated)
+			target.orientedBounds = *object->GetOBB();
+		target.bvh = object->GetMeshBVH();
+		if (target.bvh)
+			XMStoreFloat4x4(&target.inverseWorldMatrix, XMMatrixInverse(nullptr, object->GetWorldMatrix()));
+
+		targets.push_back(target);
+		return true;
+	});
+}
+
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
 Method:		getRay
 
 Summary:	Calculates a 'into-screen' ray at mouseX,mouseY and stores
-			the results in originOut and directionOut.
+			the results in originOut and directionOut, as a batch of one
+			for GetRays().
 
 Args:		XMFLOAT3 &originOut
 				a reference to an XMFLOAT3 object to store the rayOrigin data in
@@ -442,47 +903,12 @@ Args:		XMFLOAT3 &originOut
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 void CollisionClass::GetRay(XMFLOAT3 &originOut, XMFLOAT3 &directionOut, int mouseX, int mouseY)
 {
-	float pointX, pointY;
-	XMMATRIX mprojectionMatrix, mviewMatrix, minverseViewMatrix, mworldMatrix, mtranslateMatrix, minverseWorldMatrix;
-	XMFLOAT4X4 projectionMatrix, viewMatrix, inverseViewMatrix, worldMatrix, translateMatrix, inverseWorldMatrix;
-	XMFLOAT3 direction, origin;
-
-	// Move the mouse cursor coordinates into the -1 to +1 range.
-	pointX = ((2.0f * (float)mouseX) / (float)m_D3D->m_screenWidth) - 1.0f;
-	pointY = (((2.0f * (float)mouseY) / (float)m_D3D->m_screenHeight) - 1.0f) * -1.0f;
-
-	// Adjust the points using the projection matrix to account for the aspect ratio of the viewport.
-	m_D3D->GetProjectionMatrix(mprojectionMatrix);
-	XMStoreFloat4x4(&projectionMatrix, mprojectionMatrix);
-	pointX = pointX / projectionMatrix._11;
-	pointY = pointY / projectionMatrix._22;
-
-	// Get the inverse of the view matrix.
-	m_Camera->GetViewMatrix(mviewMatrix);
-	XMVECTOR viewDeterminant = XMMatrixDeterminant(mviewMatrix);
-	minverseViewMatrix = XMMatrixInverse(&viewDeterminant, mviewMatrix);
-
-	XMStoreFloat4x4(&inverseViewMatrix, minverseViewMatrix);
-
-	// Calculate the direction of the picking ray in view space.
-	direction.x = (pointX * inverseViewMatrix._11) + (pointY * inverseViewMatrix._21) + inverseViewMatrix._31;
-	direction.y = (pointX * inverseViewMatrix._12) + (pointY * inverseViewMatrix._22) + inverseViewMatrix._32;
-	direction.z = (pointX * inverseViewMatrix._13) + (pointY * inverseViewMatrix._23) + inverseViewMatrix._33;
-
-	// Get the origin of the picking ray which is the position of the camera.
-	origin = m_Camera->GetPosition();
-
-	// Get the world matrix and translate to the location of the sphere.
-	m_D3D->GetWorldMatrix(mworldMatrix);
-
-	// Now get the inverse of the translated world matrix.
-	XMVECTOR worldDeterminant = XMMatrixDeterminant(mworldMatrix);
-	minverseWorldMatrix = XMMatrixInverse(&worldDeterminant, mworldMatrix);
-	XMStoreFloat3(&originOut, XMVector3TransformCoord(XMLoadFloat3(&origin), minverseWorldMatrix));
-	XMStoreFloat3(&directionOut, XMVector3TransformNormal(XMLoadFloat3(&direction), minverseWorldMatrix));
-
-	// Normalize the ray direction.
-	XMStoreFloat3(&directionOut, XMVector3Normalize(XMLoadFloat3(&directionOut)));
+	Ray ray;
+	XMINT2 point(mouseX, mouseY);
+	GetRays(m_D3D, m_Camera, &point, 1, &ray);
+
+	originOut = ray.origin;
+	directionOut = ray.direction;
 
 	return;
 }
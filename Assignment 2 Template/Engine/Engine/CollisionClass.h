@@ -13,6 +13,7 @@
 #include "d3dclass.h"
 #include "GameObjectManager.h"
 #include "GameObject.h"
+#include "FrameArenaClass.h"
 
 //====================================================
 //					   Namespaces.
@@ -25,6 +26,15 @@ Class:		CollisionClass
 Summary:	A Class designed to provide various method for testing the
 				intersection between geometries.
 
+Structs:	Ray
+				a world space ray: its origin, unit direction and how far
+				along it to look.
+			RayHit
+				an object a ray hit and how far along the ray it was hit.
+			RayTarget
+				an object gathered once for a batch of rays, with its bounds,
+				oriented box, triangle hierarchy and inverse world matrix.
+
 Methods:	==================== PUBLIC ====================
 			CollisionClass();
 				Default Constructor.
@@ -47,39 +57,69 @@ Methods:	==================== PUBLIC ====================
 				and mouseY
 
 			CollisionTestLoop(int mouseX, int mouseY, GameObjectManager* objManager, FXMVECTOR FXMcamPosition)
-				Use to test collision for a ray at mouseX, mouseY with every object concerned
-				by the GameObjectManager using the FXMcamPosition as the current position of the camera.
+				Use to find the object concerned by the GameObjectManager that a ray at
+				mouseX, mouseY hits first. Objects whose AABB the ray passes through are
+				tested against the triangles of their model, so only what is drawn is hit.
 
 			static void GetRay(XMFLOAT3 &directionOut, int mouseX, int mouseY)
 				Use to get the direction of a ray from the camera at mouseX and mouseY on the screen.
+			static void GetRays(D3DClass*, CameraClass*, const XMINT2*, int, Ray*)
+				Use to get a ray from the camera through each of many points on
+				the screen at once, such as a burst of shots or a cone of picks.
 
 			static bool Intersects(BoundingBox* a, BoundingBox* b)
 				Use to test if two bounding boxes intersect each other.
+			static bool Intersects(GameObject* a, GameObject* b)
+				Use once the AABBs of two objects overlap to test the oriented
+				boxes of whichever of them are rotated.
+
+			static bool RayClosestHit(const Ray&, GameObjectManager*, RayHit&)
+				Use to find the object concerned by the GameObjectManager that a
+				ray hits first. Objects entered beyond the closest hit so far are
+				skipped without testing their triangles, and static objects are
+				found through the manager's static hierarchy.
+			static bool RayAnyHit(const Ray&, GameObjectManager*)
+				Use to check whether a ray hits anything at all, stopping at the
+				first hit, such as for a shadow or line of sight.
+			static int RayAllHits(const Ray&, GameObjectManager*, RayHit*, int)
+				Use to find every object a ray hits, nearest first, in a buffer
+				given by the caller. Keeps the nearest if there are more than fit.
+			static void RayClosestHit(const Ray*, int, GameObjectManager*, RayHit*)
+				Use to find the closest hit of many rays at once. The bounds and
+				inverse world matrix of each moving object are gathered once for
+				all of them.
+			static void RayAnyHit(const Ray*, int, GameObjectManager*, bool*)
+				Use to check whether each of many rays hits anything, at once.
 
 			==================== PRIVATE ====================
 			getRay(XMFLOAT3 &originOut, XMFLOAT3 &directionOut, int mouseX, int mouseY)
 				Called by both TestRaySphereIntersect functions
 				Gets and stores information to specify a ray at mouseX and mouseY
-				and stores then in the Out parameters.
+				and stores then in the Out parameters, through GetRays().
 
 			RaySphereIntersect(rayOrigin, rayDirection, radius);
 				Checks if the ray specified by param 1 & 2 intersects with a
 				sphere with given radius.
 			RayAABBIntersect(rayOrigin, rayDirection, AABB)
 				Checks if the specified ray intersects with AABB.
+			RayObjectIntersect(rayOrigin, rayDirection, GameObject*, float&, bool)
+				Checks if the specified ray hits the triangles of an object nearer
+				than the given distance, first checking its AABB then, if it is
+				rotated, its OBB.
+			RayTargetIntersect(rayOrigin, rayDirection, const RayTarget&, float&, bool)
+				Checks the same for an object gathered for a batch of rays.
+			GatherTargets(GameObjectManager*, FrameVector<RayTarget>&)
+				Gathers every dynamic object and projectile for a batch of rays,
+				in the frame arena.
+			ForEachMovingObject<Function>(GameObjectManager*, Function)
+				Calls the function with every dynamic object and projectile of
+				the GameObjectManager, until it returns false. Static objects
+				are left to the manager's static hierarchy.
 
 			==================== INLINE ====================
 			Swap<T>(T&, T&)
 				Swaps the two objects of type T around in memory.
 
-			Sort(vector<GameObject*>*, FXMVECTOR* fxmCamPosition)
-				Use to sort the specified list of GameObjects by distance from
-				the specified camera position with the smallest at the start.
-
-			VectorLengthToCamSq(FXMVECTOR* fxmCamPosition, GameObject* object)
-				Use to return a float representing the squared length between the fxmCamPosition
-				and the position of the object in worldspace.
-
 Members:	==================== PRIVATE ====================
 			D3DClass* m_D3D
 				a pointer to the D3D class for this CollisionClass to interface with.
@@ -88,6 +128,31 @@ Members:	==================== PRIVATE ====================
 C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
 class CollisionClass
 {
+public:
+	struct Ray
+	{
+		XMFLOAT3 origin;
+		XMFLOAT3 direction;
+		float maxDistance;
+	};
+
+	struct RayHit
+	{
+		GameObject* object;
+		float distance;
+	};
+
+private:
+	struct RayTarget
+	{
+		GameObject* object;
+		BoundingBox bounds;
+		BoundingOrientedBox orientedBounds;
+		bool rotated;
+		MeshBVHClass* bvh;
+		XMFLOAT4X4 inverseWorldMatrix;
+	};
+
 public:
 	CollisionClass();
 	CollisionClass(const CollisionClass&);
@@ -102,21 +167,28 @@ public:
 	GameObject* CollisionTestLoop(int mouseX, int mouseY, GameObjectManager* objManager, FXMVECTOR FXMcamPosition);
 
 	static void GetRay(D3DClass* d3d, CameraClass* cam, XMFLOAT3 &directionOut, int mouseX, int mouseY);
+	static void GetRays(D3DClass* d3d, CameraClass* cam, const XMINT2* points, int count, Ray* raysOut);
 
 	static bool Intersects(BoundingBox* a, BoundingBox* b);
+	static bool Intersects(GameObject* a, GameObject* b);
 
-	
+	static bool RayClosestHit(const Ray& ray, GameObjectManager* objManager, RayHit& hit);
+	static bool RayAnyHit(const Ray& ray, GameObjectManager* objManager);
+	static int RayAllHits(const Ray& ray, GameObjectManager* objManager, RayHit* hits, int maxHits);
+	static void RayClosestHit(const Ray* rays, int count, GameObjectManager* objManager, RayHit* hits);
+	static void RayAnyHit(const Ray* rays, int count, GameObjectManager* objManager, bool* hits);
 
 private:
 	void GetRay(XMFLOAT3 &originOut, XMFLOAT3 &directionOut, int mouseX, int mouseY);
 
 	bool RaySphereIntersect(FXMVECTOR vrayOrigin, FXMVECTOR vrayDirection, float radius);
 	bool rayAABBIntersect(FXMVECTOR rayOrigin, FXMVECTOR rayDirection, BoundingBox* AABB);
+	static bool RayObjectIntersect(FXMVECTOR rayOrigin, FXMVECTOR rayDirection, GameObject* object, float& distance, bool anyHit);
+	static bool RayTargetIntersect(FXMVECTOR rayOrigin, FXMVECTOR rayDirection, const RayTarget& target, float& distance, bool anyHit);
+	static void GatherTargets(GameObjectManager* objManager, FrameVector<RayTarget>& targets);
+	template<typename Function> static void ForEachMovingObject(GameObjectManager* objManager, Function function);
 
 	template<typename T> void Swap(T&, T&);
-	void Sort(std::vector<GameObject*>*, FXMVECTOR fxmCamPosition);
-
-	float VectorLengthToCamSq(FXMVECTOR fxmCamPosition, GameObject* object);
 
 private:
 	D3DClass * m_D3D;
@@ -140,61 +212,3 @@ inline void CollisionClass::Swap(T & a, T & b)
 	a = b;
 	b = temp;
 }
-
-/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-Method:		Sort
-
-Summary:	Sorts the specified list by squared length from fxmCamPosition
-			placing the lowest length at the start of the list.
-
-Args:		vector<GameObject*>* list
-				the vector list to sort.
-			FXMVECTOR fxmCamPosition.
-				
-
-Returns:	bool
-				Whether or not the raycast intersected the sphere.
-M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-inline void CollisionClass::Sort(std::vector<GameObject*>* list, FXMVECTOR fxmCamPosition)
-{
-	GameObject* key;
-	int i, j;
-	for (i = 1; i < list->size(); i++) {
-		key = list->at(i);
-		j = i - 1;
-
-		/* Move elements of arr[0..i-1], that are
-		  greater than key, to one position ahead
-		  of their current position */
-		while (j >= 0 && VectorLengthToCamSq(fxmCamPosition, list->at(j)) > VectorLengthToCamSq(fxmCamPosition, key)) 
-		{
-			list->at(j+1) = list->at(j);
-			j = j - 1;
-		}
-		list->at(j+1) = key;
-	}
-}
-
-/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-Method:		VectorLengthToCamSq
-
-Summary:	Returns the length squared between object and fxmCamPosition.
-
-Args:		FXMVECTOR fxmCamPosition
-				an XMVECTOR containing the world space position of the camera.
-			GameObject* object
-				a pointer to the GameObject to find the distance squared to.
-
-Returns:	float
-				The distance between fxmCamPosition and object.transform squared.
-M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-inline float CollisionClass::VectorLengthToCamSq(FXMVECTOR fxmCamPosition, GameObject * object)
-{
-	//Get the position of the GameObject as an XMVECTOR
-	XMVECTOR* objPosition = new XMVECTOR();
-	*objPosition = XMLoadFloat3(object->GetPosition());
-
-	//Return the distance squared between the two vectors.
-	return XMVectorGetByIndex(XMVector3LengthSq(*objPosition - fxmCamPosition), 0);
-	
-}
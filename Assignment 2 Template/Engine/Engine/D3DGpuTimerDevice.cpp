@@ -0,0 +1,159 @@
+//======================================================
+//				Filename: D3DGpuTimerDevice.cpp
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "D3DGpuTimerDevice.h"
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		D3DGpuTimerDevice
+
+Summary:	The preferred constructor for a D3DGpuTimerDevice.
+
+Args:		ID3D11Device* device
+				the device to create queries on.
+			ID3D11DeviceContext* deviceContext
+				the context to issue and read queries on.
+
+Modifies:	[m_device, m_deviceContext].
+
+Returns:	D3DGpuTimerDevice
+				the newly created D3DGpuTimerDevice object.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+D3DGpuTimerDevice::D3DGpuTimerDevice(ID3D11Device * device, ID3D11DeviceContext * deviceContext)
+{
+	m_device = device;
+	m_deviceContext = deviceContext;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		CreateQuery
+
+Summary:	Creates a D3D11_QUERY_TIMESTAMP or D3D11_QUERY_TIMESTAMP_DISJOINT
+			query.
+
+Args:		bool disjoint
+				create a disjoint query rather than a timestamp.
+
+Modifies:	[m_queries].
+
+Returns:	int
+				the handle of the query, or -1 on failure.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+int D3DGpuTimerDevice::CreateQuery(bool disjoint)
+{
+	D3D11_QUERY_DESC queryDesc;
+	queryDesc.Query = disjoint ? D3D11_QUERY_TIMESTAMP_DISJOINT : D3D11_QUERY_TIMESTAMP;
+	queryDesc.MiscFlags = 0;
+
+	ID3D11Query* query = 0;
+	HRESULT result = m_device->CreateQuery(&queryDesc, &query);
+	if (FAILED(result))
+		return -1;
+
+	m_queries.push_back(query);
+	return (int)m_queries.size() - 1;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		ReleaseQueries
+
+Summary:	Releases every query made by CreateQuery.
+
+Modifies:	[m_queries].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void D3DGpuTimerDevice::ReleaseQueries()
+{
+	for (size_t i = 0; i < m_queries.size(); i++)
+		m_queries[i]->Release();
+	m_queries.clear();
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Begin
+
+Summary:	Begins a disjoint query.
+
+Args:		int query
+				the handle of the query.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void D3DGpuTimerDevice::Begin(int query)
+{
+	m_deviceContext->Begin(m_queries[query]);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		End
+
+Summary:	Ends a disjoint query, or issues a timestamp query.
+
+Args:		int query
+				the handle of the query.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void D3DGpuTimerDevice::End(int query)
+{
+	m_deviceContext->End(m_queries[query]);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetTimestamp
+
+Summary:	Reads a timestamp query without flushing or waiting.
+
+Args:		int query
+				the handle of the query.
+			uint64_t& timestamp
+				set to the timestamp, in GPU ticks.
+
+Modifies:	[none].
+
+Returns:	bool
+				was the result available.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool D3DGpuTimerDevice::GetTimestamp(int query, uint64_t & timestamp)
+{
+	UINT64 data;
+	HRESULT result = m_deviceContext->GetData(m_queries[query], &data, sizeof(data), D3D11_ASYNC_GETDATA_DONOTFLUSH);
+	if (result != S_OK)
+		return false;
+
+	timestamp = data;
+	return true;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetDisjoint
+
+Summary:	Reads a disjoint query without flushing or waiting.
+
+Args:		int query
+				the handle of the query.
+			uint64_t& frequency
+				set to the GPU ticks per second.
+			bool& disjoint
+				set to whether the timestamps in the query are unreliable.
+
+Modifies:	[none].
+
+Returns:	bool
+				was the result available.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool D3DGpuTimerDevice::GetDisjoint(int query, uint64_t & frequency, bool & disjoint)
+{
+	D3D11_QUERY_DATA_TIMESTAMP_DISJOINT data;
+	HRESULT result = m_deviceContext->GetData(m_queries[query], &data, sizeof(data), D3D11_ASYNC_GETDATA_DONOTFLUSH);
+	if (result != S_OK)
+		return false;
+
+	frequency = data.Frequency;
+	disjoint = data.Disjoint != FALSE;
+	return true;
+}
@@ -0,0 +1,67 @@
+#pragma once
+//======================================================
+//				Filename: D3DGpuTimerDevice.h
+//======================================================
+
+
+//======================================================
+//					Include Guards.
+//======================================================
+#ifndef _D3DGPUTIMERDEVICE_H_
+#define _D3DGPUTIMERDEVICE_H_
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "GpuTimerDevice.h"
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <d3d11_1.h>
+#include <vector>
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		D3DGpuTimerDevice
+
+Summary:	The GpuTimerDevice used by the engine, issuing D3D11 timestamp
+			queries on a device context.
+
+Methods:	==================== PUBLIC ====================
+			D3DGpuTimerDevice(ID3D11Device*, ID3D11DeviceContext*)
+				Creates the timer device for the given device and context.
+
+			CreateQuery(...), ReleaseQueries(), Begin(...), End(...),
+			GetTimestamp(...), GetDisjoint(...)
+				Implementations of GpuTimerDevice.
+
+Members:	==================== PRIVATE ====================
+			ID3D11Device* m_device
+				the device queries are created on.
+			ID3D11DeviceContext* m_deviceContext
+				the context queries are issued and read on.
+			std::vector<ID3D11Query*> m_queries
+				every query created, indexed by handle.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class D3DGpuTimerDevice : public GpuTimerDevice
+{
+public:
+	D3DGpuTimerDevice(ID3D11Device* device, ID3D11DeviceContext* deviceContext);
+
+	virtual int CreateQuery(bool disjoint) override;
+	virtual void ReleaseQueries() override;
+	virtual void Begin(int query) override;
+	virtual void End(int query) override;
+	virtual bool GetTimestamp(int query, uint64_t& timestamp) override;
+	virtual bool GetDisjoint(int query, uint64_t& frequency, bool& disjoint) override;
+
+private:
+	ID3D11Device* m_device;
+	ID3D11DeviceContext* m_deviceContext;
+	std::vector<ID3D11Query*> m_queries;
+};
+
+#endif
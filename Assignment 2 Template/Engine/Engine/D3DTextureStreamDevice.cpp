@@ -0,0 +1,92 @@
+//======================================================
+//				Filename: D3DTextureStreamDevice.cpp
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "D3DTextureStreamDevice.h"
+#include "DDSTextureLoader.h"
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		D3DTextureStreamDevice
+
+Summary:	The preferred constructor for a D3DTextureStreamDevice.
+
+Args:		ID3D11Device* device
+				the device to create textures on.
+
+Modifies:	[m_device].
+
+Returns:	D3DTextureStreamDevice
+				the newly created D3DTextureStreamDevice object.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+D3DTextureStreamDevice::D3DTextureStreamDevice(ID3D11Device * device)
+{
+	m_device = device;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		CreateTexture
+
+Summary:	Creates a shader resource view from a DDS file held in memory,
+			using only the mip levels that fit within maxSize.
+
+Args:		const uint8_t* ddsData
+				the whole DDS file.
+			size_t ddsDataSize
+				the size of the DDS file in bytes.
+			size_t maxSize
+				the widest and tallest mip level to upload, 0 for all of them.
+
+Modifies:	[none].
+
+Returns:	StreamTexture*
+				the created shader resource view, or 0 on failure.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+StreamTexture * D3DTextureStreamDevice::CreateTexture(const uint8_t * ddsData, size_t ddsDataSize, size_t maxSize)
+{
+	ID3D11ShaderResourceView* texture = 0;
+
+	HRESULT result = CreateDDSTextureFromMemoryEx(m_device, ddsData, ddsDataSize, maxSize,
+		D3D11_USAGE_DEFAULT, D3D11_BIND_SHADER_RESOURCE, 0, 0, false, nullptr, &texture);
+	if (FAILED(result))
+		return 0;
+
+	return (StreamTexture*)texture;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		ReleaseTexture
+
+Summary:	Releases a texture made by CreateTexture.
+
+Args:		StreamTexture* texture
+				the texture to release, or 0.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void D3DTextureStreamDevice::ReleaseTexture(StreamTexture * texture)
+{
+	if (texture)
+		GetView(texture)->Release();
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetView
+
+Summary:	Returns the shader resource view behind a texture made by a
+			D3DTextureStreamDevice.
+
+Args:		StreamTexture* texture
+				the texture, or 0.
+
+Returns:	ID3D11ShaderResourceView*
+				the view to bind, or 0.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+ID3D11ShaderResourceView * D3DTextureStreamDevice::GetView(StreamTexture * texture)
+{
+	return (ID3D11ShaderResourceView*)texture;
+}
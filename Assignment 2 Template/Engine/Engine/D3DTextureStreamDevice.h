@@ -0,0 +1,64 @@
+#pragma once
+//======================================================
+//				Filename: D3DTextureStreamDevice.h
+//======================================================
+
+
+//======================================================
+//					Include Guards.
+//======================================================
+#ifndef _D3DTEXTURESTREAMDEVICE_H_
+#define _D3DTEXTURESTREAMDEVICE_H_
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "TextureStreamDevice.h"
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <d3d11_1.h>
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		D3DTextureStreamDevice
+
+Summary:	The TextureStreamDevice used by the engine, creating textures on
+			a Direct3D 11 device with the DDS texture loader. Each
+			StreamTexture it makes is a shader resource view.
+
+Methods:	==================== PUBLIC ====================
+			D3DTextureStreamDevice(ID3D11Device*)
+				Creates the stream device for the given device.
+
+			CreateTexture(...)
+				Implementation of CreateTexture from TextureStreamDevice.
+			ReleaseTexture(...)
+				Implementation of ReleaseTexture from TextureStreamDevice.
+
+			static ID3D11ShaderResourceView* GetView(StreamTexture*)
+				Use to get the shader resource view of a texture made by a
+				D3DTextureStreamDevice.
+
+Members:	==================== PRIVATE ====================
+			ID3D11Device* m_device
+				the device textures are created on.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class D3DTextureStreamDevice : public TextureStreamDevice
+{
+public:
+	D3DTextureStreamDevice(ID3D11Device* device);
+
+	virtual StreamTexture* CreateTexture(const uint8_t* ddsData, size_t ddsDataSize, size_t maxSize) override;
+	virtual void ReleaseTexture(StreamTexture* texture) override;
+
+	static ID3D11ShaderResourceView* GetView(StreamTexture* texture);
+
+private:
+	ID3D11Device* m_device;
+};
+
+#endif
@@ -0,0 +1,1070 @@
+//======================================================
+//				Filename: DDSFileClass.cpp
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "DDSFileClass.h"
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <algorithm>
+#include <string.h>
+
+
+//======================================================
+//					Constants.
+//======================================================
+const size_t DDS_MAX_MIP_LEVELS = 15;		//D3D11_REQ_MIP_LEVELS
+const size_t DDS_MAX_DIMENSION = 16384;	//D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION
+const size_t DDS_MAX_ARRAY_SIZE = 2048;	//D3D11_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		DDSFileClass
+
+Summary:	The default constructor for a DDSFileClass object.
+
+Modifies:	[m_data, m_header, m_format, m_dimension, m_width, m_height,
+			 m_depth, m_mipCount, m_arraySize, m_cubeMap].
+
+Returns:	DDSFileClass
+				the newly created DDSFileClass object.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+DDSFileClass::DDSFileClass()
+{
+	m_data = 0;
+	m_header = 0;
+	m_format = DXGI_FORMAT_UNKNOWN;
+	m_dimension = DIMENSION_UNKNOWN;
+	m_width = 0;
+	m_height = 0;
+	m_depth = 0;
+	m_mipCount = 0;
+	m_arraySize = 0;
+	m_cubeMap = false;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		DDSFileClass
+
+Summary:	The reference constructor for a DDSFileClass object.
+
+Args:		const DDSFileClass& other
+				the DDSFileClass object to create this one in the image of.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+DDSFileClass::DDSFileClass(const DDSFileClass & other)
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		~DDSFileClass
+
+Summary:	The default deconstructor for a DDSFileClass object.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+DDSFileClass::~DDSFileClass()
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Parse
+
+Summary:	Checks the magic number and headers of a whole .dds file, reads
+			its format and size and lays out every surface in it.
+
+Args:		const uint8_t* data
+				the whole .dds file.
+			size_t size
+				the size of the file in bytes.
+
+Modifies:	[m_data, m_header, m_format, m_dimension, m_width, m_height,
+			 m_depth, m_mipCount, m_arraySize, m_cubeMap, m_surfaces].
+
+Returns:	ParseResult
+				PARSE_OK, or why the file could not be used.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+DDSFileClass::ParseResult DDSFileClass::Parse(const uint8_t * data, size_t size)
+{
+	m_data = 0;
+	m_header = 0;
+	m_surfaces.clear();
+
+	//Need at least enough data to fill the header and magic number to be a valid DDS.
+	if (!data || size < sizeof(uint32_t) + sizeof(DDS_HEADER))
+		return PARSE_NOTDDS;
+
+	//DDS files always start with the same magic number ("DDS ").
+	uint32_t magic;
+	memcpy(&magic, data, sizeof(magic));
+	if (magic != DDS_MAGIC)
+		return PARSE_NOTDDS;
+
+	const DDS_HEADER* header = (const DDS_HEADER*)(data + sizeof(uint32_t));
+	if (header->size != sizeof(DDS_HEADER) || header->ddspf.size != sizeof(DDS_PIXELFORMAT))
+		return PARSE_NOTDDS;
+
+	//The pixels follow the headers, which may include the DX10 extension.
+	size_t offset = sizeof(uint32_t) + sizeof(DDS_HEADER);
+	if ((header->ddspf.flags & DDS_FOURCC) && MAKEFOURCC('D', 'X', '1', '0') == header->ddspf.fourCC)
+	{
+		if (size < offset + sizeof(DDS_HEADER_DXT10))
+			return PARSE_NOTDDS;
+
+		offset += sizeof(DDS_HEADER_DXT10);
+	}
+
+	m_data = data;
+	m_header = header;
+
+	ParseResult result = ReadFormat();
+	if (result != PARSE_OK)
+		return result;
+
+	return LayoutSurfaces(offset, size);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetHeader
+
+Summary:	Returns the header of the parsed file.
+
+Returns:	const DDS_HEADER*
+				the header, or 0 if nothing was parsed.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+const DDS_HEADER * DDSFileClass::GetHeader()
+{
+	return m_header;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetFormat
+
+Summary:	Returns the pixel format of the parsed file.
+
+Returns:	DXGI_FORMAT
+				the format of every surface.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+DXGI_FORMAT DDSFileClass::GetFormat()
+{
+	return m_format;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetDimension
+
+Summary:	Returns the kind of texture in the parsed file.
+
+Returns:	Dimension
+				a 1D, 2D or 3D texture.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+DDSFileClass::Dimension DDSFileClass::GetDimension()
+{
+	return m_dimension;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetWidth
+
+Summary:	Returns the width of the top mip level.
+
+Returns:	size_t
+				the width in pixels.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+size_t DDSFileClass::GetWidth()
+{
+	return m_width;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetHeight
+
+Summary:	Returns the height of the top mip level.
+
+Returns:	size_t
+				the height in pixels, 1 for 1D textures.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+size_t DDSFileClass::GetHeight()
+{
+	return m_height;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetDepth
+
+Summary:	Returns the depth of the top mip level.
+
+Returns:	size_t
+				the depth in pixels, 1 for 1D and 2D textures.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+size_t DDSFileClass::GetDepth()
+{
+	return m_depth;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetMipCount
+
+Summary:	Returns the number of mip levels in the parsed file.
+
+Returns:	size_t
+				the mip levels, at least 1.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+size_t DDSFileClass::GetMipCount()
+{
+	return m_mipCount;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetArraySize
+
+Summary:	Returns the number of array items in the parsed file.
+
+Returns:	size_t
+				the array items, 6 for each cube.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+size_t DDSFileClass::GetArraySize()
+{
+	return m_arraySize;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		IsCubeMap
+
+Summary:	Returns whether the array items of the parsed file are the
+			faces of cubes.
+
+Returns:	bool
+				is the texture a cube map.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool DDSFileClass::IsCubeMap()
+{
+	return m_cubeMap;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetSurface
+
+Summary:	Returns where a mip level of an array item lies in the file.
+
+Args:		size_t item
+				the array item, below GetArraySize().
+			size_t mip
+				the mip level, below GetMipCount().
+
+Returns:	const Surface&
+				the offset, size and pitches of the surface.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+const DDSFileClass::Surface & DDSFileClass::GetSurface(size_t item, size_t mip)
+{
+	return m_surfaces[item * m_mipCount + mip];
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetSurfaceData
+
+Summary:	Returns a pointer to the pixels of a mip level of an array item.
+
+Args:		size_t item
+				the array item, below GetArraySize().
+			size_t mip
+				the mip level, below GetMipCount().
+
+Returns:	const uint8_t*
+				the first byte of the surface.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+const uint8_t * DDSFileClass::GetSurfaceData(size_t item, size_t mip)
+{
+	return m_data + GetSurface(item, mip).offset;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetMipBytes
+
+Summary:	Returns the bytes of a mip level summed across every array item.
+
+Args:		size_t mip
+				the mip level, below GetMipCount().
+
+Returns:	size_t
+				the bytes of that level.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+size_t DDSFileClass::GetMipBytes(size_t mip)
+{
+	size_t bytes = 0;
+
+	for (size_t item = 0; item < m_arraySize; item++)
+		bytes += GetSurface(item, mip).size;
+
+	return bytes;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetFirstMip
+
+Summary:	Returns the finest mip level no wider, taller or deeper than a
+			size. Every level is used for a size of 0 or a single level file.
+
+Args:		size_t maxSize
+				the largest size allowed on any side, 0 for no limit.
+
+Returns:	size_t
+				the finest level that fits, or GetMipCount() if none do.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+size_t DDSFileClass::GetFirstMip(size_t maxSize)
+{
+	if (!maxSize || m_mipCount <= 1)
+		return 0;
+
+	for (size_t mip = 0; mip < m_mipCount; mip++)
+	{
+		const Surface& surface = GetSurface(0, mip);
+		if (surface.width <= maxSize && surface.height <= maxSize && surface.depth <= maxSize)
+			return mip;
+	}
+
+	return m_mipCount;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		BitsPerPixel
+
+Summary:	Returns the bits per pixel of a format.
+
+Args:		DXGI_FORMAT fmt
+				the format to measure.
+
+Returns:	size_t
+				the bits per pixel, or 0 for an unknown format.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+size_t DDSFileClass::BitsPerPixel(DXGI_FORMAT fmt)
+{
+	switch( fmt )
+	{
+	case DXGI_FORMAT_R32G32B32A32_TYPELESS:
+	case DXGI_FORMAT_R32G32B32A32_FLOAT:
+	case DXGI_FORMAT_R32G32B32A32_UINT:
+	case DXGI_FORMAT_R32G32B32A32_SINT:
+		return 128;
+
+	case DXGI_FORMAT_R32G32B32_TYPELESS:
+	case DXGI_FORMAT_R32G32B32_FLOAT:
+	case DXGI_FORMAT_R32G32B32_UINT:
+	case DXGI_FORMAT_R32G32B32_SINT:
+		return 96;
+
+	case DXGI_FORMAT_R16G16B16A16_TYPELESS:
+	case DXGI_FORMAT_R16G16B16A16_FLOAT:
+	case DXGI_FORMAT_R16G16B16A16_UNORM:
+	case DXGI_FORMAT_R16G16B16A16_UINT:
+	case DXGI_FORMAT_R16G16B16A16_SNORM:
+	case DXGI_FORMAT_R16G16B16A16_SINT:
+	case DXGI_FORMAT_R32G32_TYPELESS:
+	case DXGI_FORMAT_R32G32_FLOAT:
+	case DXGI_FORMAT_R32G32_UINT:
+	case DXGI_FORMAT_R32G32_SINT:
+	case DXGI_FORMAT_R32G8X24_TYPELESS:
+	case DXGI_FORMAT_D32_FLOAT_S8X24_UINT:
+	case DXGI_FORMAT_R32_FLOAT_X8X24_TYPELESS:
+	case DXGI_FORMAT_X32_TYPELESS_G8X24_UINT:
+	case DXGI_FORMAT_Y416:
+	case DXGI_FORMAT_Y210:
+	case DXGI_FORMAT_Y216:
+		return 64;
+
+	case DXGI_FORMAT_R10G10B10A2_TYPELESS:
+	case DXGI_FORMAT_R10G10B10A2_UNORM:
+	case DXGI_FORMAT_R10G10B10A2_UINT:
+	case DXGI_FORMAT_R11G11B10_FLOAT:
+	case DXGI_FORMAT_R8G8B8A8_TYPELESS:
+	case DXGI_FORMAT_R8G8B8A8_UNORM:
+	case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+	case DXGI_FORMAT_R8G8B8A8_UINT:
+	case DXGI_FORMAT_R8G8B8A8_SNORM:
+	case DXGI_FORMAT_R8G8B8A8_SINT:
+	case DXGI_FORMAT_R16G16_TYPELESS:
+	case DXGI_FORMAT_R16G16_FLOAT:
+	case DXGI_FORMAT_R16G16_UNORM:
+	case DXGI_FORMAT_R16G16_UINT:
+	case DXGI_FORMAT_R16G16_SNORM:
+	case DXGI_FORMAT_R16G16_SINT:
+	case DXGI_FORMAT_R32_TYPELESS:
+	case DXGI_FORMAT_D32_FLOAT:
+	case DXGI_FORMAT_R32_FLOAT:
+	case DXGI_FORMAT_R32_UINT:
+	case DXGI_FORMAT_R32_SINT:
+	case DXGI_FORMAT_R24G8_TYPELESS:
+	case DXGI_FORMAT_D24_UNORM_S8_UINT:
+	case DXGI_FORMAT_R24_UNORM_X8_TYPELESS:
+	case DXGI_FORMAT_X24_TYPELESS_G8_UINT:
+	case DXGI_FORMAT_R9G9B9E5_SHAREDEXP:
+	case DXGI_FORMAT_R8G8_B8G8_UNORM:
+	case DXGI_FORMAT_G8R8_G8B8_UNORM:
+	case DXGI_FORMAT_B8G8R8A8_UNORM:
+	case DXGI_FORMAT_B8G8R8X8_UNORM:
+	case DXGI_FORMAT_R10G10B10_XR_BIAS_A2_UNORM:
+	case DXGI_FORMAT_B8G8R8A8_TYPELESS:
+	case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+	case DXGI_FORMAT_B8G8R8X8_TYPELESS:
+	case DXGI_FORMAT_B8G8R8X8_UNORM_SRGB:
+	case DXGI_FORMAT_AYUV:
+	case DXGI_FORMAT_Y410:
+	case DXGI_FORMAT_YUY2:
+		return 32;
+
+	case DXGI_FORMAT_P010:
+	case DXGI_FORMAT_P016:
+		return 24;
+
+	case DXGI_FORMAT_R8G8_TYPELESS:
+	case DXGI_FORMAT_R8G8_UNORM:
+	case DXGI_FORMAT_R8G8_UINT:
+	case DXGI_FORMAT_R8G8_SNORM:
+	case DXGI_FORMAT_R8G8_SINT:
+	case DXGI_FORMAT_R16_TYPELESS:
+	case DXGI_FORMAT_R16_FLOAT:
+	case DXGI_FORMAT_D16_UNORM:
+	case DXGI_FORMAT_R16_UNORM:
+	case DXGI_FORMAT_R16_UINT:
+	case DXGI_FORMAT_R16_SNORM:
+	case DXGI_FORMAT_R16_SINT:
+	case DXGI_FORMAT_B5G6R5_UNORM:
+	case DXGI_FORMAT_B5G5R5A1_UNORM:
+	case DXGI_FORMAT_A8P8:
+	case DXGI_FORMAT_B4G4R4A4_UNORM:
+		return 16;
+
+	case DXGI_FORMAT_NV12:
+	case DXGI_FORMAT_420_OPAQUE:
+	case DXGI_FORMAT_NV11:
+		return 12;
+
+	case DXGI_FORMAT_R8_TYPELESS:
+	case DXGI_FORMAT_R8_UNORM:
+	case DXGI_FORMAT_R8_UINT:
+	case DXGI_FORMAT_R8_SNORM:
+	case DXGI_FORMAT_R8_SINT:
+	case DXGI_FORMAT_A8_UNORM:
+	case DXGI_FORMAT_AI44:
+	case DXGI_FORMAT_IA44:
+	case DXGI_FORMAT_P8:
+		return 8;
+
+	case DXGI_FORMAT_R1_UNORM:
+		return 1;
+
+	case DXGI_FORMAT_BC1_TYPELESS:
+	case DXGI_FORMAT_BC1_UNORM:
+	case DXGI_FORMAT_BC1_UNORM_SRGB:
+	case DXGI_FORMAT_BC4_TYPELESS:
+	case DXGI_FORMAT_BC4_UNORM:
+	case DXGI_FORMAT_BC4_SNORM:
+		return 4;
+
+	case DXGI_FORMAT_BC2_TYPELESS:
+	case DXGI_FORMAT_BC2_UNORM:
+	case DXGI_FORMAT_BC2_UNORM_SRGB:
+	case DXGI_FORMAT_BC3_TYPELESS:
+	case DXGI_FORMAT_BC3_UNORM:
+	case DXGI_FORMAT_BC3_UNORM_SRGB:
+	case DXGI_FORMAT_BC5_TYPELESS:
+	case DXGI_FORMAT_BC5_UNORM:
+	case DXGI_FORMAT_BC5_SNORM:
+	case DXGI_FORMAT_BC6H_TYPELESS:
+	case DXGI_FORMAT_BC6H_UF16:
+	case DXGI_FORMAT_BC6H_SF16:
+	case DXGI_FORMAT_BC7_TYPELESS:
+	case DXGI_FORMAT_BC7_UNORM:
+	case DXGI_FORMAT_BC7_UNORM_SRGB:
+		return 8;
+
+#if defined(_XBOX_ONE) && defined(_TITLE)
+
+	case DXGI_FORMAT_R10G10B10_7E3_A2_FLOAT:
+	case DXGI_FORMAT_R10G10B10_6E4_A2_FLOAT:
+		return 32;
+
+	case DXGI_FORMAT_D16_UNORM_S8_UINT:
+	case DXGI_FORMAT_R16_UNORM_X8_TYPELESS:
+	case DXGI_FORMAT_X16_TYPELESS_G8_UINT:
+		return 24;
+
+#endif // _XBOX_ONE && _TITLE
+
+	default:
+		return 0;
+	}
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetSurfaceInfo
+
+Summary:	Works out the size in bytes, the row pitch and the number of
+			rows of one surface of a format.
+
+Args:		size_t width
+				the width of the surface.
+			size_t height
+				the height of the surface.
+			DXGI_FORMAT fmt
+				the format of the surface.
+			size_t* outNumBytes
+				set to the bytes of the surface, if given.
+			size_t* outRowBytes
+				set to the bytes of one row, if given.
+			size_t* outNumRows
+				set to the number of rows, if given.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void DDSFileClass::GetSurfaceInfo(size_t width, size_t height, DXGI_FORMAT fmt,
+	size_t* outNumBytes, size_t* outRowBytes, size_t* outNumRows)
+{
+	size_t numBytes = 0;
+	size_t rowBytes = 0;
+	size_t numRows = 0;
+
+	bool bc = false;
+	bool packed = false;
+	bool planar = false;
+	size_t bpe = 0;
+	switch (fmt)
+	{
+	case DXGI_FORMAT_BC1_TYPELESS:
+	case DXGI_FORMAT_BC1_UNORM:
+	case DXGI_FORMAT_BC1_UNORM_SRGB:
+	case DXGI_FORMAT_BC4_TYPELESS:
+	case DXGI_FORMAT_BC4_UNORM:
+	case DXGI_FORMAT_BC4_SNORM:
+		bc=true;
+		bpe = 8;
+		break;
+
+	case DXGI_FORMAT_BC2_TYPELESS:
+	case DXGI_FORMAT_BC2_UNORM:
+	case DXGI_FORMAT_BC2_UNORM_SRGB:
+	case DXGI_FORMAT_BC3_TYPELESS:
+	case DXGI_FORMAT_BC3_UNORM:
+	case DXGI_FORMAT_BC3_UNORM_SRGB:
+	case DXGI_FORMAT_BC5_TYPELESS:
+	case DXGI_FORMAT_BC5_UNORM:
+	case DXGI_FORMAT_BC5_SNORM:
+	case DXGI_FORMAT_BC6H_TYPELESS:
+	case DXGI_FORMAT_BC6H_UF16:
+	case DXGI_FORMAT_BC6H_SF16:
+	case DXGI_FORMAT_BC7_TYPELESS:
+	case DXGI_FORMAT_BC7_UNORM:
+	case DXGI_FORMAT_BC7_UNORM_SRGB:
+		bc = true;
+		bpe = 16;
+		break;
+
+	case DXGI_FORMAT_R8G8_B8G8_UNORM:
+	case DXGI_FORMAT_G8R8_G8B8_UNORM:
+	case DXGI_FORMAT_YUY2:
+		packed = true;
+		bpe = 4;
+		break;
+
+	case DXGI_FORMAT_Y210:
+	case DXGI_FORMAT_Y216:
+		packed = true;
+		bpe = 8;
+		break;
+
+	case DXGI_FORMAT_NV12:
+	case DXGI_FORMAT_420_OPAQUE:
+		planar = true;
+		bpe = 2;
+		break;
+
+	case DXGI_FORMAT_P010:
+	case DXGI_FORMAT_P016:
+		planar = true;
+		bpe = 4;
+		break;
+
+#if defined(_XBOX_ONE) && defined(_TITLE)
+
+	case DXGI_FORMAT_D16_UNORM_S8_UINT:
+	case DXGI_FORMAT_R16_UNORM_X8_TYPELESS:
+	case DXGI_FORMAT_X16_TYPELESS_G8_UINT:
+		planar = true;
+		bpe = 4;
+		break;
+
+#endif
+	}
+
+	if (bc)
+	{
+		size_t numBlocksWide = 0;
+		if (width > 0)
+		{
+			numBlocksWide = std::max<size_t>( 1, (width + 3) / 4 );
+		}
+		size_t numBlocksHigh = 0;
+		if (height > 0)
+		{
+			numBlocksHigh = std::max<size_t>( 1, (height + 3) / 4 );
+		}
+		rowBytes = numBlocksWide * bpe;
+		numRows = numBlocksHigh;
+		numBytes = rowBytes * numBlocksHigh;
+	}
+	else if (packed)
+	{
+		rowBytes = ( ( width + 1 ) >> 1 ) * bpe;
+		numRows = height;
+		numBytes = rowBytes * height;
+	}
+	else if ( fmt == DXGI_FORMAT_NV11 )
+	{
+		rowBytes = ( ( width + 3 ) >> 2 ) * 4;
+		numRows = height * 2; // Direct3D makes this simplifying assumption, although it is larger than the 4:1:1 data
+		numBytes = rowBytes * numRows;
+	}
+	else if (planar)
+	{
+		rowBytes = ( ( width + 1 ) >> 1 ) * bpe;
+		numBytes = ( rowBytes * height ) + ( ( rowBytes * height + 1 ) >> 1 );
+		numRows = height + ( ( height + 1 ) >> 1 );
+	}
+	else
+	{
+		size_t bpp = BitsPerPixel( fmt );
+		rowBytes = ( width * bpp + 7 ) / 8; // round up to nearest byte
+		numRows = height;
+		numBytes = rowBytes * height;
+	}
+
+	if (outNumBytes)
+	{
+		*outNumBytes = numBytes;
+	}
+	if (outRowBytes)
+	{
+		*outRowBytes = rowBytes;
+	}
+	if (outNumRows)
+	{
+		*outNumRows = numRows;
+	}
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		ReadFormat
+
+Summary:	Reads the format, kind of texture, size, mip count and array
+			size from the headers, from the DX10 extension if there is
+			one, and checks they describe a texture that can be laid out.
+
+Modifies:	[m_format, m_dimension, m_width, m_height, m_depth, m_mipCount,
+			 m_arraySize, m_cubeMap].
+
+Returns:	ParseResult
+				PARSE_OK, or why the headers could not be used.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+DDSFileClass::ParseResult DDSFileClass::ReadFormat()
+{
+	m_width = m_header->width;
+	m_height = m_header->height;
+	m_depth = m_header->depth;
+	m_mipCount = std::max<size_t>(1, m_header->mipMapCount);
+	m_arraySize = 1;
+	m_format = DXGI_FORMAT_UNKNOWN;
+	m_dimension = DIMENSION_UNKNOWN;
+	m_cubeMap = false;
+
+	if ((m_header->ddspf.flags & DDS_FOURCC) && MAKEFOURCC('D', 'X', '1', '0') == m_header->ddspf.fourCC)
+	{
+		const DDS_HEADER_DXT10* d3d10ext = (const DDS_HEADER_DXT10*)((const uint8_t*)m_header + sizeof(DDS_HEADER));
+
+		m_arraySize = d3d10ext->arraySize;
+		if (m_arraySize == 0)
+			return PARSE_INVALID;
+
+		if (m_arraySize > DDS_MAX_ARRAY_SIZE)
+			return PARSE_UNSUPPORTED;
+
+		switch (d3d10ext->dxgiFormat)
+		{
+		case DXGI_FORMAT_AI44:
+		case DXGI_FORMAT_IA44:
+		case DXGI_FORMAT_P8:
+		case DXGI_FORMAT_A8P8:
+			return PARSE_UNSUPPORTED;
+
+		default:
+			if (BitsPerPixel(d3d10ext->dxgiFormat) == 0)
+				return PARSE_UNSUPPORTED;
+		}
+
+		m_format = d3d10ext->dxgiFormat;
+
+		switch (d3d10ext->resourceDimension)
+		{
+		case DIMENSION_TEXTURE1D:
+			//D3DX writes 1D textures with a fixed height of 1.
+			if ((m_header->flags & DDS_HEIGHT) && m_height != 1)
+				return PARSE_INVALID;
+			m_height = 1;
+			m_depth = 1;
+			break;
+
+		case DIMENSION_TEXTURE2D:
+			if (d3d10ext->miscFlag & DDS_RESOURCE_MISC_TEXTURECUBE)
+			{
+				m_arraySize *= 6;
+				m_cubeMap = true;
+			}
+			m_depth = 1;
+			break;
+
+		case DIMENSION_TEXTURE3D:
+			if (!(m_header->flags & DDS_HEADER_FLAGS_VOLUME))
+				return PARSE_INVALID;
+
+			if (m_arraySize > 1)
+				return PARSE_UNSUPPORTED;
+			break;
+
+		default:
+			return PARSE_UNSUPPORTED;
+		}
+
+		m_dimension = (Dimension)d3d10ext->resourceDimension;
+	}
+	else
+	{
+		m_format = GetDXGIFormat(m_header->ddspf);
+		if (m_format == DXGI_FORMAT_UNKNOWN)
+			return PARSE_UNSUPPORTED;
+
+		if (m_header->flags & DDS_HEADER_FLAGS_VOLUME)
+		{
+			m_dimension = DIMENSION_TEXTURE3D;
+		}
+		else
+		{
+			if (m_header->caps2 & DDS_CUBEMAP)
+			{
+				//Every one of the six faces has to be there.
+				if ((m_header->caps2 & DDS_CUBEMAP_ALLFACES) != DDS_CUBEMAP_ALLFACES)
+					return PARSE_UNSUPPORTED;
+
+				m_arraySize = 6;
+				m_cubeMap = true;
+			}
+
+			//There is no way for a legacy Direct3D 9 DDS to express a 1D texture.
+			m_depth = 1;
+			m_dimension = DIMENSION_TEXTURE2D;
+		}
+	}
+
+	//Keep the sizes small enough that laying out the surfaces can't overflow.
+	if (m_mipCount > DDS_MAX_MIP_LEVELS || m_width > DDS_MAX_DIMENSION ||
+		m_height > DDS_MAX_DIMENSION || m_depth > DDS_MAX_DIMENSION)
+		return PARSE_UNSUPPORTED;
+
+	if (m_width == 0 || m_height == 0 || m_depth == 0)
+		return PARSE_INVALID;
+
+	return PARSE_OK;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		LayoutSurfaces
+
+Summary:	Walks the pixel data after the headers, every mip level of the
+			first array item then every level of the next, recording
+			where each surface starts and how big it is. Volume levels hold
+			every slice of the level one after another.
+
+Args:		size_t offset
+				where the pixel data starts, just after the headers.
+			size_t size
+				the size of the whole file.
+
+Modifies:	[m_surfaces].
+
+Returns:	ParseResult
+				PARSE_OK, or PARSE_TRUNCATED if the file is too short to
+				hold every surface.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+DDSFileClass::ParseResult DDSFileClass::LayoutSurfaces(size_t offset, size_t size)
+{
+	//Every surface takes at least a byte, so check the count before reserving room for them.
+	if (m_arraySize > (size - offset) / m_mipCount)
+		return PARSE_TRUNCATED;
+
+	m_surfaces.reserve(m_arraySize * m_mipCount);
+
+	size_t position = offset;
+	for (size_t item = 0; item < m_arraySize; item++)
+	{
+		size_t width = m_width;
+		size_t height = m_height;
+		size_t depth = m_depth;
+
+		for (size_t mip = 0; mip < m_mipCount; mip++)
+		{
+			Surface surface;
+			GetSurfaceInfo(width, height, m_format, &surface.slicePitch, &surface.rowPitch, 0);
+			surface.offset = position;
+			surface.size = surface.slicePitch * depth;
+			surface.width = width;
+			surface.height = height;
+			surface.depth = depth;
+
+			if (surface.size > size - position)
+			{
+				m_surfaces.clear();
+				return PARSE_TRUNCATED;
+			}
+
+			m_surfaces.push_back(surface);
+			position += surface.size;
+
+			width = std::max<size_t>(1, width >> 1);
+			height = std::max<size_t>(1, height >> 1);
+			depth = std::max<size_t>(1, depth >> 1);
+		}
+	}
+
+	return PARSE_OK;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetDXGIFormat
+
+Summary:	Returns the format described by the legacy pixel format of a
+			file without the DX10 extension.
+
+Args:		const DDS_PIXELFORMAT& ddpf
+				the pixel format from the header.
+
+Returns:	DXGI_FORMAT
+				the matching format, or DXGI_FORMAT_UNKNOWN.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+#define ISBITMASK( r,g,b,a ) ( ddpf.RBitMask == r && ddpf.GBitMask == g && ddpf.BBitMask == b && ddpf.ABitMask == a )
+
+DXGI_FORMAT DDSFileClass::GetDXGIFormat(const DDS_PIXELFORMAT& ddpf)
+{
+	if (ddpf.flags & DDS_RGB)
+	{
+		// Note that sRGB formats are written using the "DX10" extended header
+
+		switch (ddpf.RGBBitCount)
+		{
+		case 32:
+			if (ISBITMASK(0x000000ff,0x0000ff00,0x00ff0000,0xff000000))
+			{
+				return DXGI_FORMAT_R8G8B8A8_UNORM;
+			}
+
+			if (ISBITMASK(0x00ff0000,0x0000ff00,0x000000ff,0xff000000))
+			{
+				return DXGI_FORMAT_B8G8R8A8_UNORM;
+			}
+
+			if (ISBITMASK(0x00ff0000,0x0000ff00,0x000000ff,0x00000000))
+			{
+				return DXGI_FORMAT_B8G8R8X8_UNORM;
+			}
+
+			// No DXGI format maps to ISBITMASK(0x000000ff,0x0000ff00,0x00ff0000,0x00000000) aka D3DFMT_X8B8G8R8
+
+			// Note that many common DDS reader/writers (including D3DX) swap the
+			// the RED/BLUE masks for 10:10:10:2 formats. We assumme
+			// below that the 'backwards' header mask is being used since it is most
+			// likely written by D3DX. The more robust solution is to use the 'DX10'
+			// header extension and specify the DXGI_FORMAT_R10G10B10A2_UNORM format directly
+
+			// For 'correct' writers, this should be 0x000003ff,0x000ffc00,0x3ff00000 for RGB data
+			if (ISBITMASK(0x3ff00000,0x000ffc00,0x000003ff,0xc0000000))
+			{
+				return DXGI_FORMAT_R10G10B10A2_UNORM;
+			}
+
+			// No DXGI format maps to ISBITMASK(0x000003ff,0x000ffc00,0x3ff00000,0xc0000000) aka D3DFMT_A2R10G10B10
+
+			if (ISBITMASK(0x0000ffff,0xffff0000,0x00000000,0x00000000))
+			{
+				return DXGI_FORMAT_R16G16_UNORM;
+			}
+
+			if (ISBITMASK(0xffffffff,0x00000000,0x00000000,0x00000000))
+			{
+				// Only 32-bit color channel format in D3D9 was R32F
+				return DXGI_FORMAT_R32_FLOAT; // D3DX writes this out as a FourCC of 114
+			}
+			break;
+
+		case 24:
+			// No 24bpp DXGI formats aka D3DFMT_R8G8B8
+			break;
+
+		case 16:
+			if (ISBITMASK(0x7c00,0x03e0,0x001f,0x8000))
+			{
+				return DXGI_FORMAT_B5G5R5A1_UNORM;
+			}
+			if (ISBITMASK(0xf800,0x07e0,0x001f,0x0000))
+			{
+				return DXGI_FORMAT_B5G6R5_UNORM;
+			}
+
+			// No DXGI format maps to ISBITMASK(0x7c00,0x03e0,0x001f,0x0000) aka D3DFMT_X1R5G5B5
+
+			if (ISBITMASK(0x0f00,0x00f0,0x000f,0xf000))
+			{
+				return DXGI_FORMAT_B4G4R4A4_UNORM;
+			}
+
+			// No DXGI format maps to ISBITMASK(0x0f00,0x00f0,0x000f,0x0000) aka D3DFMT_X4R4G4B4
+
+			// No 3:3:2, 3:3:2:8, or paletted DXGI formats aka D3DFMT_A8R3G3B2, D3DFMT_R3G3B2, D3DFMT_P8, D3DFMT_A8P8, etc.
+			break;
+		}
+	}
+	else if (ddpf.flags & DDS_LUMINANCE)
+	{
+		if (8 == ddpf.RGBBitCount)
+		{
+			if (ISBITMASK(0x000000ff,0x00000000,0x00000000,0x00000000))
+			{
+				return DXGI_FORMAT_R8_UNORM; // D3DX10/11 writes this out as DX10 extension
+			}
+
+			// No DXGI format maps to ISBITMASK(0x0f,0x00,0x00,0xf0) aka D3DFMT_A4L4
+		}
+
+		if (16 == ddpf.RGBBitCount)
+		{
+			if (ISBITMASK(0x0000ffff,0x00000000,0x00000000,0x00000000))
+			{
+				return DXGI_FORMAT_R16_UNORM; // D3DX10/11 writes this out as DX10 extension
+			}
+			if (ISBITMASK(0x000000ff,0x00000000,0x00000000,0x0000ff00))
+			{
+				return DXGI_FORMAT_R8G8_UNORM; // D3DX10/11 writes this out as DX10 extension
+			}
+		}
+	}
+	else if (ddpf.flags & DDS_ALPHA)
+	{
+		if (8 == ddpf.RGBBitCount)
+		{
+			return DXGI_FORMAT_A8_UNORM;
+		}
+	}
+	else if (ddpf.flags & DDS_FOURCC)
+	{
+		if (MAKEFOURCC( 'D', 'X', 'T', '1' ) == ddpf.fourCC)
+		{
+			return DXGI_FORMAT_BC1_UNORM;
+		}
+		if (MAKEFOURCC( 'D', 'X', 'T', '3' ) == ddpf.fourCC)
+		{
+			return DXGI_FORMAT_BC2_UNORM;
+		}
+		if (MAKEFOURCC( 'D', 'X', 'T', '5' ) == ddpf.fourCC)
+		{
+			return DXGI_FORMAT_BC3_UNORM;
+		}
+
+		// While pre-mulitplied alpha isn't directly supported by the DXGI formats,
+		// they are basically the same as these BC formats so they can be mapped
+		if (MAKEFOURCC( 'D', 'X', 'T', '2' ) == ddpf.fourCC)
+		{
+			return DXGI_FORMAT_BC2_UNORM;
+		}
+		if (MAKEFOURCC( 'D', 'X', 'T', '4' ) == ddpf.fourCC)
+		{
+			return DXGI_FORMAT_BC3_UNORM;
+		}
+
+		if (MAKEFOURCC( 'A', 'T', 'I', '1' ) == ddpf.fourCC)
+		{
+			return DXGI_FORMAT_BC4_UNORM;
+		}
+		if (MAKEFOURCC( 'B', 'C', '4', 'U' ) == ddpf.fourCC)
+		{
+			return DXGI_FORMAT_BC4_UNORM;
+		}
+		if (MAKEFOURCC( 'B', 'C', '4', 'S' ) == ddpf.fourCC)
+		{
+			return DXGI_FORMAT_BC4_SNORM;
+		}
+
+		if (MAKEFOURCC( 'A', 'T', 'I', '2' ) == ddpf.fourCC)
+		{
+			return DXGI_FORMAT_BC5_UNORM;
+		}
+		if (MAKEFOURCC( 'B', 'C', '5', 'U' ) == ddpf.fourCC)
+		{
+			return DXGI_FORMAT_BC5_UNORM;
+		}
+		if (MAKEFOURCC( 'B', 'C', '5', 'S' ) == ddpf.fourCC)
+		{
+			return DXGI_FORMAT_BC5_SNORM;
+		}
+
+		// BC6H and BC7 are written using the "DX10" extended header
+
+		if (MAKEFOURCC( 'R', 'G', 'B', 'G' ) == ddpf.fourCC)
+		{
+			return DXGI_FORMAT_R8G8_B8G8_UNORM;
+		}
+		if (MAKEFOURCC( 'G', 'R', 'G', 'B' ) == ddpf.fourCC)
+		{
+			return DXGI_FORMAT_G8R8_G8B8_UNORM;
+		}
+
+		if (MAKEFOURCC('Y','U','Y','2') == ddpf.fourCC)
+		{
+			return DXGI_FORMAT_YUY2;
+		}
+
+		// Check for D3DFORMAT enums being set here
+		switch( ddpf.fourCC )
+		{
+		case 36: // D3DFMT_A16B16G16R16
+			return DXGI_FORMAT_R16G16B16A16_UNORM;
+
+		case 110: // D3DFMT_Q16W16V16U16
+			return DXGI_FORMAT_R16G16B16A16_SNORM;
+
+		case 111: // D3DFMT_R16F
+			return DXGI_FORMAT_R16_FLOAT;
+
+		case 112: // D3DFMT_G16R16F
+			return DXGI_FORMAT_R16G16_FLOAT;
+
+		case 113: // D3DFMT_A16B16G16R16F
+			return DXGI_FORMAT_R16G16B16A16_FLOAT;
+
+		case 114: // D3DFMT_R32F
+			return DXGI_FORMAT_R32_FLOAT;
+
+		case 115: // D3DFMT_G32R32F
+			return DXGI_FORMAT_R32G32_FLOAT;
+
+		case 116: // D3DFMT_A32B32G32R32F
+			return DXGI_FORMAT_R32G32B32A32_FLOAT;
+		}
+	}
+
+	return DXGI_FORMAT_UNKNOWN;
+}
+
+#undef ISBITMASK
@@ -0,0 +1,400 @@
+#pragma once
+//======================================================
+//				Filename: DDSFileClass.h
+//======================================================
+
+
+//======================================================
+//					Include Guards.
+//======================================================
+#ifndef _DDSFILECLASS_H_
+#define _DDSFILECLASS_H_
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#ifdef _WIN32
+#include <dxgiformat.h>
+#endif
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+
+//======================================================
+//				DXGI formats.
+//
+// dxgiformat.h only ships with the Windows SDK. Off
+// Windows the formats are defined here with the SDK's
+// values, so the parser and its tests build on any OS.
+//======================================================
+#ifndef _WIN32
+enum DXGI_FORMAT : uint32_t
+{
+	DXGI_FORMAT_UNKNOWN = 0,
+	DXGI_FORMAT_R32G32B32A32_TYPELESS = 1,
+	DXGI_FORMAT_R32G32B32A32_FLOAT = 2,
+	DXGI_FORMAT_R32G32B32A32_UINT = 3,
+	DXGI_FORMAT_R32G32B32A32_SINT = 4,
+	DXGI_FORMAT_R32G32B32_TYPELESS = 5,
+	DXGI_FORMAT_R32G32B32_FLOAT = 6,
+	DXGI_FORMAT_R32G32B32_UINT = 7,
+	DXGI_FORMAT_R32G32B32_SINT = 8,
+	DXGI_FORMAT_R16G16B16A16_TYPELESS = 9,
+	DXGI_FORMAT_R16G16B16A16_FLOAT = 10,
+	DXGI_FORMAT_R16G16B16A16_UNORM = 11,
+	DXGI_FORMAT_R16G16B16A16_UINT = 12,
+	DXGI_FORMAT_R16G16B16A16_SNORM = 13,
+	DXGI_FORMAT_R16G16B16A16_SINT = 14,
+	DXGI_FORMAT_R32G32_TYPELESS = 15,
+	DXGI_FORMAT_R32G32_FLOAT = 16,
+	DXGI_FORMAT_R32G32_UINT = 17,
+	DXGI_FORMAT_R32G32_SINT = 18,
+	DXGI_FORMAT_R32G8X24_TYPELESS = 19,
+	DXGI_FORMAT_D32_FLOAT_S8X24_UINT = 20,
+	DXGI_FORMAT_R32_FLOAT_X8X24_TYPELESS = 21,
+	DXGI_FORMAT_X32_TYPELESS_G8X24_UINT = 22,
+	DXGI_FORMAT_R10G10B10A2_TYPELESS = 23,
+	DXGI_FORMAT_R10G10B10A2_UNORM = 24,
+	DXGI_FORMAT_R10G10B10A2_UINT = 25,
+	DXGI_FORMAT_R11G11B10_FLOAT = 26,
+	DXGI_FORMAT_R8G8B8A8_TYPELESS = 27,
+	DXGI_FORMAT_R8G8B8A8_UNORM = 28,
+	DXGI_FORMAT_R8G8B8A8_UNORM_SRGB = 29,
+	DXGI_FORMAT_R8G8B8A8_UINT = 30,
+	DXGI_FORMAT_R8G8B8A8_SNORM = 31,
+	DXGI_FORMAT_R8G8B8A8_SINT = 32,
+	DXGI_FORMAT_R16G16_TYPELESS = 33,
+	DXGI_FORMAT_R16G16_FLOAT = 34,
+	DXGI_FORMAT_R16G16_UNORM = 35,
+	DXGI_FORMAT_R16G16_UINT = 36,
+	DXGI_FORMAT_R16G16_SNORM = 37,
+	DXGI_FORMAT_R16G16_SINT = 38,
+	DXGI_FORMAT_R32_TYPELESS = 39,
+	DXGI_FORMAT_D32_FLOAT = 40,
+	DXGI_FORMAT_R32_FLOAT = 41,
+	DXGI_FORMAT_R32_UINT = 42,
+	DXGI_FORMAT_R32_SINT = 43,
+	DXGI_FORMAT_R24G8_TYPELESS = 44,
+	DXGI_FORMAT_D24_UNORM_S8_UINT = 45,
+	DXGI_FORMAT_R24_UNORM_X8_TYPELESS = 46,
+	DXGI_FORMAT_X24_TYPELESS_G8_UINT = 47,
+	DXGI_FORMAT_R8G8_TYPELESS = 48,
+	DXGI_FORMAT_R8G8_UNORM = 49,
+	DXGI_FORMAT_R8G8_UINT = 50,
+	DXGI_FORMAT_R8G8_SNORM = 51,
+	DXGI_FORMAT_R8G8_SINT = 52,
+	DXGI_FORMAT_R16_TYPELESS = 53,
+	DXGI_FORMAT_R16_FLOAT = 54,
+	DXGI_FORMAT_D16_UNORM = 55,
+	DXGI_FORMAT_R16_UNORM = 56,
+	DXGI_FORMAT_R16_UINT = 57,
+	DXGI_FORMAT_R16_SNORM = 58,
+	DXGI_FORMAT_R16_SINT = 59,
+	DXGI_FORMAT_R8_TYPELESS = 60,
+	DXGI_FORMAT_R8_UNORM = 61,
+	DXGI_FORMAT_R8_UINT = 62,
+	DXGI_FORMAT_R8_SNORM = 63,
+	DXGI_FORMAT_R8_SINT = 64,
+	DXGI_FORMAT_A8_UNORM = 65,
+	DXGI_FORMAT_R1_UNORM = 66,
+	DXGI_FORMAT_R9G9B9E5_SHAREDEXP = 67,
+	DXGI_FORMAT_R8G8_B8G8_UNORM = 68,
+	DXGI_FORMAT_G8R8_G8B8_UNORM = 69,
+	DXGI_FORMAT_BC1_TYPELESS = 70,
+	DXGI_FORMAT_BC1_UNORM = 71,
+	DXGI_FORMAT_BC1_UNORM_SRGB = 72,
+	DXGI_FORMAT_BC2_TYPELESS = 73,
+	DXGI_FORMAT_BC2_UNORM = 74,
+	DXGI_FORMAT_BC2_UNORM_SRGB = 75,
+	DXGI_FORMAT_BC3_TYPELESS = 76,
+	DXGI_FORMAT_BC3_UNORM = 77,
+	DXGI_FORMAT_BC3_UNORM_SRGB = 78,
+	DXGI_FORMAT_BC4_TYPELESS = 79,
+	DXGI_FORMAT_BC4_UNORM = 80,
+	DXGI_FORMAT_BC4_SNORM = 81,
+	DXGI_FORMAT_BC5_TYPELESS = 82,
+	DXGI_FORMAT_BC5_UNORM = 83,
+	DXGI_FORMAT_BC5_SNORM = 84,
+	DXGI_FORMAT_B5G6R5_UNORM = 85,
+	DXGI_FORMAT_B5G5R5A1_UNORM = 86,
+	DXGI_FORMAT_B8G8R8A8_UNORM = 87,
+	DXGI_FORMAT_B8G8R8X8_UNORM = 88,
+	DXGI_FORMAT_R10G10B10_XR_BIAS_A2_UNORM = 89,
+	DXGI_FORMAT_B8G8R8A8_TYPELESS = 90,
+	DXGI_FORMAT_B8G8R8A8_UNORM_SRGB = 91,
+	DXGI_FORMAT_B8G8R8X8_TYPELESS = 92,
+	DXGI_FORMAT_B8G8R8X8_UNORM_SRGB = 93,
+	DXGI_FORMAT_BC6H_TYPELESS = 94,
+	DXGI_FORMAT_BC6H_UF16 = 95,
+	DXGI_FORMAT_BC6H_SF16 = 96,
+	DXGI_FORMAT_BC7_TYPELESS = 97,
+	DXGI_FORMAT_BC7_UNORM = 98,
+	DXGI_FORMAT_BC7_UNORM_SRGB = 99,
+	DXGI_FORMAT_AYUV = 100,
+	DXGI_FORMAT_Y410 = 101,
+	DXGI_FORMAT_Y416 = 102,
+	DXGI_FORMAT_NV12 = 103,
+	DXGI_FORMAT_P010 = 104,
+	DXGI_FORMAT_P016 = 105,
+	DXGI_FORMAT_420_OPAQUE = 106,
+	DXGI_FORMAT_YUY2 = 107,
+	DXGI_FORMAT_Y210 = 108,
+	DXGI_FORMAT_Y216 = 109,
+	DXGI_FORMAT_NV11 = 110,
+	DXGI_FORMAT_AI44 = 111,
+	DXGI_FORMAT_IA44 = 112,
+	DXGI_FORMAT_P8 = 113,
+	DXGI_FORMAT_A8P8 = 114,
+	DXGI_FORMAT_B4G4R4A4_UNORM = 115,
+	DXGI_FORMAT_FORCE_UINT = 0xffffffff
+};
+#endif
+
+
+//======================================================
+//				.dds file layout.
+//
+// See DDS.h in the 'Texconv' sample and the 'DirectXTex' library.
+//======================================================
+#ifndef MAKEFOURCC
+	#define MAKEFOURCC(ch0, ch1, ch2, ch3)                              \
+				((uint32_t)(uint8_t)(ch0) | ((uint32_t)(uint8_t)(ch1) << 8) |       \
+				((uint32_t)(uint8_t)(ch2) << 16) | ((uint32_t)(uint8_t)(ch3) << 24 ))
+#endif
+
+#pragma pack(push,1)
+
+const uint32_t DDS_MAGIC = 0x20534444; // "DDS "
+
+struct DDS_PIXELFORMAT
+{
+	uint32_t    size;
+	uint32_t    flags;
+	uint32_t    fourCC;
+	uint32_t    RGBBitCount;
+	uint32_t    RBitMask;
+	uint32_t    GBitMask;
+	uint32_t    BBitMask;
+	uint32_t    ABitMask;
+};
+
+#define DDS_FOURCC      0x00000004  // DDPF_FOURCC
+#define DDS_RGB         0x00000040  // DDPF_RGB
+#define DDS_LUMINANCE   0x00020000  // DDPF_LUMINANCE
+#define DDS_ALPHA       0x00000002  // DDPF_ALPHA
+
+#define DDS_HEADER_FLAGS_VOLUME         0x00800000  // DDSD_DEPTH
+
+#define DDS_HEIGHT 0x00000002 // DDSD_HEIGHT
+#define DDS_WIDTH  0x00000004 // DDSD_WIDTH
+
+#define DDS_CUBEMAP_POSITIVEX 0x00000600 // DDSCAPS2_CUBEMAP | DDSCAPS2_CUBEMAP_POSITIVEX
+#define DDS_CUBEMAP_NEGATIVEX 0x00000a00 // DDSCAPS2_CUBEMAP | DDSCAPS2_CUBEMAP_NEGATIVEX
+#define DDS_CUBEMAP_POSITIVEY 0x00001200 // DDSCAPS2_CUBEMAP | DDSCAPS2_CUBEMAP_POSITIVEY
+#define DDS_CUBEMAP_NEGATIVEY 0x00002200 // DDSCAPS2_CUBEMAP | DDSCAPS2_CUBEMAP_NEGATIVEY
+#define DDS_CUBEMAP_POSITIVEZ 0x00004200 // DDSCAPS2_CUBEMAP | DDSCAPS2_CUBEMAP_POSITIVEZ
+#define DDS_CUBEMAP_NEGATIVEZ 0x00008200 // DDSCAPS2_CUBEMAP | DDSCAPS2_CUBEMAP_NEGATIVEZ
+
+#define DDS_CUBEMAP_ALLFACES ( DDS_CUBEMAP_POSITIVEX | DDS_CUBEMAP_NEGATIVEX |\
+                               DDS_CUBEMAP_POSITIVEY | DDS_CUBEMAP_NEGATIVEY |\
+                               DDS_CUBEMAP_POSITIVEZ | DDS_CUBEMAP_NEGATIVEZ )
+
+#define DDS_CUBEMAP 0x00000200 // DDSCAPS2_CUBEMAP
+
+#define DDS_RESOURCE_MISC_TEXTURECUBE 0x4 // D3D11_RESOURCE_MISC_TEXTURECUBE
+
+enum DDS_MISC_FLAGS2
+{
+	DDS_MISC_FLAGS2_ALPHA_MODE_MASK = 0x7L,
+};
+
+struct DDS_HEADER
+{
+	uint32_t        size;
+	uint32_t        flags;
+	uint32_t        height;
+	uint32_t        width;
+	uint32_t        pitchOrLinearSize;
+	uint32_t        depth; // only if DDS_HEADER_FLAGS_VOLUME is set in flags
+	uint32_t        mipMapCount;
+	uint32_t        reserved1[11];
+	DDS_PIXELFORMAT ddspf;
+	uint32_t        caps;
+	uint32_t        caps2;
+	uint32_t        caps3;
+	uint32_t        caps4;
+	uint32_t        reserved2;
+};
+
+struct DDS_HEADER_DXT10
+{
+	DXGI_FORMAT     dxgiFormat;
+	uint32_t        resourceDimension;
+	uint32_t        miscFlag; // see D3D11_RESOURCE_MISC_FLAG
+	uint32_t        arraySize;
+	uint32_t        miscFlags2;
+};
+
+#pragma pack(pop)
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		DDSFileClass
+
+Summary:	Reads the headers of a .dds file held in memory and lays out
+			where every mip level of every array item lies in it.
+			Makes no Direct3D or OS calls, so the DDS texture loader, the
+			texture streamer and the tests can all share it. Only points
+			into the data it was given, which must outlive it.
+
+Enums:		ParseResult
+				why a file could not be parsed, each matching one of the
+				errors the DDS texture loader returns.
+			Dimension
+				the kind of texture, with the same values as
+				D3D11_RESOURCE_DIMENSION.
+
+Structs:	Surface
+				where one mip level of one array item lies in the file and
+				its size.
+
+Methods:	==================== PUBLIC ====================
+			DDSFileClass()
+				Default constructor.
+			DDSFileClass(const DDSFileClass&)
+				Reference constructor.
+			~DDSFileClass()
+				Default deconstructor.
+
+			ParseResult Parse(const uint8_t*, size_t)
+				Use to read the headers of a whole .dds file and lay out its
+				surfaces, checking they all lie inside the file.
+
+			const DDS_HEADER* GetHeader()
+				Use to get the header of the parsed file.
+			DXGI_FORMAT GetFormat()
+				Use to get the pixel format of the parsed file.
+			Dimension GetDimension()
+				Use to get the kind of texture in the parsed file.
+			size_t GetWidth(), GetHeight(), GetDepth()
+				Use to get the size of the top mip level.
+			size_t GetMipCount()
+				Use to get the number of mip levels, at least 1.
+			size_t GetArraySize()
+				Use to get the number of array items, 6 per cube.
+			bool IsCubeMap()
+				Use to check whether the array items are cube faces.
+			const Surface& GetSurface(size_t, size_t)
+				Use to get where a mip level of an array item lies.
+			const uint8_t* GetSurfaceData(size_t, size_t)
+				Use to get a pointer to the pixels of a surface.
+			size_t GetMipBytes(size_t)
+				Use to get the bytes of a mip level across every array item.
+			size_t GetFirstMip(size_t)
+				Use to get the finest mip level no larger than a size.
+
+			static size_t BitsPerPixel(DXGI_FORMAT)
+				Returns the bits per pixel of a format, 0 if unknown.
+			static void GetSurfaceInfo(size_t, size_t, DXGI_FORMAT, size_t*, size_t*, size_t*)
+				Works out the bytes, row pitch and rows of a surface.
+
+			==================== PRIVATE ====================
+			ParseResult ReadFormat()
+				Called by Parse() to find the format, dimension and size of
+				the texture from the headers.
+			ParseResult LayoutSurfaces(size_t, size_t)
+				Called by Parse() to find where every surface lies.
+			static DXGI_FORMAT GetDXGIFormat(const DDS_PIXELFORMAT&)
+				Returns the format described by a legacy pixel format.
+
+Members:	==================== PRIVATE ====================
+			const uint8_t* m_data
+				the whole file.
+			const DDS_HEADER* m_header
+				the header inside m_data.
+			DXGI_FORMAT m_format
+				the pixel format.
+			Dimension m_dimension
+				the kind of texture.
+			size_t m_width, m_height, m_depth
+				the size of the top mip level.
+			size_t m_mipCount, m_arraySize
+				the mip levels and array items.
+			bool m_cubeMap
+				whether the array items are cube faces.
+			std::vector<Surface> m_surfaces
+				every surface, all the mips of the first item first.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class DDSFileClass
+{
+public:
+	enum ParseResult
+	{
+		PARSE_OK,
+		PARSE_NOTDDS,
+		PARSE_INVALID,
+		PARSE_UNSUPPORTED,
+		PARSE_TRUNCATED
+	};
+
+	enum Dimension
+	{
+		DIMENSION_UNKNOWN = 0,
+		DIMENSION_TEXTURE1D = 2,
+		DIMENSION_TEXTURE2D = 3,
+		DIMENSION_TEXTURE3D = 4
+	};
+
+	struct Surface
+	{
+		size_t offset;
+		size_t size;
+		size_t rowPitch;
+		size_t slicePitch;
+		size_t width, height, depth;
+	};
+
+public:
+	DDSFileClass();
+	DDSFileClass(const DDSFileClass&);
+	~DDSFileClass();
+
+	ParseResult Parse(const uint8_t* data, size_t size);
+
+	const DDS_HEADER* GetHeader();
+	DXGI_FORMAT GetFormat();
+	Dimension GetDimension();
+	size_t GetWidth();
+	size_t GetHeight();
+	size_t GetDepth();
+	size_t GetMipCount();
+	size_t GetArraySize();
+	bool IsCubeMap();
+	const Surface& GetSurface(size_t item, size_t mip);
+	const uint8_t* GetSurfaceData(size_t item, size_t mip);
+	size_t GetMipBytes(size_t mip);
+	size_t GetFirstMip(size_t maxSize);
+
+	static size_t BitsPerPixel(DXGI_FORMAT fmt);
+	static void GetSurfaceInfo(size_t width, size_t height, DXGI_FORMAT fmt,
+		size_t* outNumBytes, size_t* outRowBytes, size_t* outNumRows);
+
+private:
+	ParseResult ReadFormat();
+	ParseResult LayoutSurfaces(size_t offset, size_t size);
+	static DXGI_FORMAT GetDXGIFormat(const DDS_PIXELFORMAT& ddpf);
+
+private:
+	const uint8_t* m_data;
+	const DDS_HEADER* m_header;
+	DXGI_FORMAT m_format;
+	Dimension m_dimension;
+	size_t m_width, m_height, m_depth;
+	size_t m_mipCount, m_arraySize;
+	bool m_cubeMap;
+	std::vector<Surface> m_surfaces;
+};
+
+#endif
@@ -9,6 +9,13 @@
 #include "FireShaderGameObject.h"
 
 
+//=============================================
+//				  Constants.
+//=============================================
+//How fast the fire animation runs, in animation time per second.
+const float FIRE_ANIMATION_SPEED = 0.6f;
+
+
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
 Method:		FireShaderGameObject
 
@@ -75,31 +82,58 @@ Summary:	The implementation of render from GameObject.
 			uses the FireShader within the passed in shadermanager
 			to render the object to the screen.
 
-Modifies:	[frameTime].
+Modifies:	[none].
 
 Returns:	bool
 				was the rendering successful or not?
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-bool FireShaderGameObject::Render(ShaderManagerClass* shaderManager, ID3D11DeviceContext* device,
-	XMMATRIX &worldMatrix, const XMMATRIX &viewMatrix, const XMMATRIX &projectionMatrix)
+bool FireShaderGameObject::Render(ShaderManagerClass* shaderManager, RenderContext* device,
+	XMMATRIX &worldMatrix, const XMMATRIX &viewProjectionMatrix, float animationTime)
 {
-	//Increment this object's stored frame time 
-	frameTime += 0.01f;
-	if (frameTime > 1000.0f)
-		frameTime = 0.0f;
-	
 	//Render the model to the device.
 	GetModel()->Render(device);
 
-	//Calculate the worldMatrix for the object using its transform data.
-	const XMMATRIX* newWorldMatrix = this->CalcWorldMatrix(worldMatrix);
-
 	//Use the fire shader and the information stored on this device to render this model to the deviceContext
-	return shaderManager->RenderFireShader(device, GetModel()->GetIndexCount(), *newWorldMatrix, viewMatrix, projectionMatrix,
-		GetModel()->GetTexture1(), GetModel()->GetTexture2(), GetModel()->GetTexture3(), frameTime, *scrollSpeeds,
+	return shaderManager->RenderFireShader(device, GetModel()->GetIndexCount(), worldMatrix, viewProjectionMatrix,
+		GetModel()->GetTexture1(), GetModel()->GetTexture2(), GetModel()->GetTexture3(), animationTime, *scrollSpeeds,
 		*scales, *distortion1, *distortion2, *distortion3, distortionScale, distortionBias);
 }
 
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Frame
+
+Summary:	Advances the fire animation by one simulation step, so it runs
+			at the same speed whatever the frame rate.
+
+Args:		float deltaTime
+				the length of the step, in seconds.
+
+Modifies:	[frameTime].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void FireShaderGameObject::Frame(float deltaTime)
+{
+	//Increment this object's stored frame time 
+	frameTime += FIRE_ANIMATION_SPEED * deltaTime;
+	if (frameTime > 1000.0f)
+		frameTime = 0.0f;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetAnimationTime
+
+Summary:	Gets the time the fire animation has reached, so it can be
+			copied into a snapshot and drawn while the next step runs.
+
+Modifies:	[none].
+
+Returns:	float
+				the current frame time of the fire animation.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+float FireShaderGameObject::GetAnimationTime()
+{
+	return frameTime;
+}
+
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
 Method:		SetParameters
 
@@ -155,16 +189,81 @@ Args:		FireModelClass* baseModel
 				a pointer to the FireModelClass object to use as this
 				gameObject's base model.
 
-Modifies:	[m_baseModel, m_min, m_max, m_transform, m_scale, m_rotation].
+Modifies:	[m_baseModel, m_min, m_max, m_transform, m_scale, m_orientation].
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 void FireShaderGameObject::Setup(FireModelClass * baseModel)
 {
 	m_baseModel = baseModel;
-	m_min = new XMFLOAT3(m_baseModel->m_min->x, m_baseModel->m_min->y, m_baseModel->m_min->z);
-	m_max = new XMFLOAT3(m_baseModel->m_max->x, m_baseModel->m_max->y, m_baseModel->m_max->z);
+	m_min = new XMFLOAT3(-1.0f, -1.0f, -1.0f);
+	m_max = new XMFLOAT3(1.0f, 1.0f, 1.0f);
+	m_boundsPending = true;
+	CheckModelReady();
 	BoundingBox::CreateFromPoints(*m_AABB, XMLoadFloat3(m_min), XMLoadFloat3(m_max));
 	m_transform = new XMFLOAT3(0, 0, 0);
 	m_scale = new XMFLOAT3(1, 1, 1);
-	m_rotation = new XMFLOAT3(0, 0, 0);
+	m_orientation = new XMFLOAT4(0, 0, 0, 1);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		IsModelReady
+
+Summary:	An override of IsModelReady from GameObject.h that queries
+			the FireModelClass instead.
+
+Returns:	bool
+				is the base model ready to be drawn.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool FireShaderGameObject::IsModelReady()
+{
+	return m_baseModel && m_baseModel->IsReady();
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RefreshBounds
+
+Summary:	An override of RefreshBounds from GameObject.h that copies
+			the bounds of the FireModelClass instead.
+
+Modifies:	[m_min, m_max, m_AABB].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void FireShaderGameObject::RefreshBounds()
+{
+	CopyBounds(m_baseModel->m_min, m_baseModel->m_max);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RequestTextureDetail
+
+Summary:	An override of RequestTextureDetail from GameObject.h that
+			passes the size on screen to the FireModelClass instead.
+
+Args:		float screenPixels
+				the size of the gameObject on screen, in pixels.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void FireShaderGameObject::RequestTextureDetail(float screenPixels)
+{
+	if (m_baseModel)
+		m_baseModel->RequestTextureSize(screenPixels);
 }
 
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetMeshBVH
+
+Summary:	An override of GetMeshBVH from GameObject.h that returns the
+			triangle hierarchy of the FireModelClass instead.
+
+Modifies:	[none].
+
+Returns:	MeshBVHClass*
+				the hierarchy in model space, or 0 if the base model has
+				not finished streaming in.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+MeshBVHClass * FireShaderGameObject::GetMeshBVH()
+{
+	if (!IsModelReady())
+		return 0;
+
+	return m_baseModel->GetBVH();
+}
@@ -32,6 +32,18 @@ Methods:	==================== PUBLIC ====================
 				render this gameObject with its sizing data to
 				the specified device.
 
+			Frame(float)
+				Override of Frame from GameObject, call once per simulation
+				step to advance the fire animation.
+			GetAnimationTime()
+				Override of GetAnimationTime from GameObject, returns frameTime.
+			RequestTextureDetail(float)
+				Override of RequestTextureDetail from GameObject, passes the
+				on screen size to the textures of the FireModelClass.
+			GetMeshBVH()
+				Override of GetMeshBVH from GameObject, returns the triangle
+				hierarchy of the FireModelClass.
+
 			SetParameters(...)
 				Use to set the internal parameters of the fire shader.
 
@@ -47,6 +59,12 @@ Methods:	==================== PUBLIC ====================
 				Used by constrctor 2 to setup the GameObject and its
 					collision data.
 
+			IsModelReady()
+				Overrides IsModelReady from GameObject to query the FireModelClass.
+			RefreshBounds()
+				Overrides RefreshBounds from GameObject to copy the bounds of the
+					FireModelClass once it has streamed in.
+
 Members:	==================== PRIVATE ====================
 			FireModelClass* m_baseFireModel
 				a pointer to a fireModelClass that is used as the base model
@@ -72,8 +90,13 @@ public:
 	~FireShaderGameObject();
 	FireShaderGameObject(FireModelClass* baseModel);
 
-	virtual bool Render(ShaderManagerClass* shaderManager, ID3D11DeviceContext* device,
-		XMMATRIX &worldMatrix, const XMMATRIX &viewMatrix, const XMMATRIX &projectionMatrix) override;
+	virtual bool Render(ShaderManagerClass* shaderManager, RenderContext* device,
+		XMMATRIX &worldMatrix, const XMMATRIX &viewProjectionMatrix, float animationTime) override;
+
+	virtual void Frame(float deltaTime) override;
+	virtual float GetAnimationTime() override;
+	virtual void RequestTextureDetail(float screenPixels) override;
+	virtual MeshBVHClass* GetMeshBVH() override;
 
 	void SetParameters(XMFLOAT3* scrollSpeeds, XMFLOAT3* scales, XMFLOAT2* distortion1,
 		XMFLOAT2* distortion2, XMFLOAT2* distortion3, float distortionScale, float distortionBias);
@@ -83,6 +106,9 @@ private:
 
 	void Setup(FireModelClass* baseModel);
 
+	virtual bool IsModelReady() override;
+	virtual void RefreshBounds() override;
+
 private:
 	FireModelClass* m_baseModel;
 
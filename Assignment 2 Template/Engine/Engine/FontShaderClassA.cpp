@@ -50,14 +50,14 @@ void FontShaderClassA::Shutdown()
 }
 
 
-bool FontShaderClassA::Render(ID3D11DeviceContext* deviceContext, int indexCount, XMMATRIX worldMatrix, XMMATRIX viewMatrix,
-	XMMATRIX projectionMatrix, ID3D11ShaderResourceView* texture, FXMVECTOR pixelColor)
+bool FontShaderClassA::Render(RenderContext* deviceContext, int indexCount, XMMATRIX worldMatrix, XMMATRIX viewProjectionMatrix,
+	ID3D11ShaderResourceView* texture, FXMVECTOR pixelColor)
 {
 	bool result;
 
 
 	// Set the shader parameters that it will use for rendering.
-	result = SetShaderParameters(deviceContext, worldMatrix, viewMatrix, projectionMatrix, texture, pixelColor);
+	result = SetShaderParameters(deviceContext, worldMatrix, viewProjectionMatrix, texture, pixelColor);
 	if (!result)
 	{
 		return false;
@@ -323,8 +323,8 @@ void FontShaderClassA::OutputShaderErrorMessage(ID3D10Blob* errorMessage, HWND h
 }
 
 
-bool FontShaderClassA::SetShaderParameters(ID3D11DeviceContext* deviceContext, XMMATRIX worldMatrix, XMMATRIX viewMatrix,
-	XMMATRIX projectionMatrix, ID3D11ShaderResourceView* texture, FXMVECTOR pixelColor)
+bool FontShaderClassA::SetShaderParameters(RenderContext* deviceContext, XMMATRIX worldMatrix, XMMATRIX viewProjectionMatrix,
+	ID3D11ShaderResourceView* texture, FXMVECTOR pixelColor)
 {
 	HRESULT result;
 	D3D11_MAPPED_SUBRESOURCE mappedResource;
@@ -346,20 +346,14 @@ bool FontShaderClassA::SetShaderParameters(ID3D11DeviceContext* deviceContext, X
 	// Transpose the matrices to prepare them for the shader.
 	worldMatrix = XMMatrixTranspose(worldMatrix);
 	//D3DXMatrixTranspose(&worldMatrix, &worldMatrix);
-	viewMatrix = XMMatrixTranspose(viewMatrix);
-	//D3DXMatrixTranspose(&viewMatrix, &viewMatrix);
-	projectionMatrix = XMMatrixTranspose(projectionMatrix);
-	//D3DXMatrixTranspose(&projectionMatrix, &projectionMatrix);
+	viewProjectionMatrix = XMMatrixTranspose(viewProjectionMatrix);
 
 	
 
 	// Copy the matrices into the constant buffer.
 	//dataPtr->world = worldMatrix;
 	XMStoreFloat4x4(&dataPtr->world, worldMatrix);
-	//dataPtr->view = viewMatrix;
-	XMStoreFloat4x4(&dataPtr->view, viewMatrix);
-	//dataPtr->projection = projectionMatrix;
-	XMStoreFloat4x4(&dataPtr->projection, projectionMatrix);
+	XMStoreFloat4x4(&dataPtr->viewProjection, viewProjectionMatrix);
 
 	// Unlock the constant buffer.
 	deviceContext->Unmap(m_constantBuffer, 0);
@@ -400,7 +394,7 @@ bool FontShaderClassA::SetShaderParameters(ID3D11DeviceContext* deviceContext, X
 }
 
 
-void FontShaderClassA::RenderShader(ID3D11DeviceContext* deviceContext, int indexCount)
+void FontShaderClassA::RenderShader(RenderContext* deviceContext, int indexCount)
 {
 	// Set the vertex input layout.
 	deviceContext->IASetInputLayout(m_layout);
@@ -19,6 +19,12 @@ using namespace std;
 using namespace DirectX;
 
 
+///////////////////////
+// MY CLASS INCLUDES //
+///////////////////////
+#include "RenderContext.h"
+
+
 ////////////////////////////////////////////////////////////////////////////////
 // Class name: FontShaderClass
 ////////////////////////////////////////////////////////////////////////////////
@@ -28,8 +34,7 @@ private:
 	struct ConstantBufferType
 	{
 		XMFLOAT4X4 world;
-		XMFLOAT4X4 view;
-		XMFLOAT4X4 projection;
+		XMFLOAT4X4 viewProjection;
 	};
 
 	struct PixelBufferType
@@ -44,15 +49,15 @@ public:
 
 	bool Initialize(ID3D11Device*, HWND);
 	void Shutdown();
-	bool Render(ID3D11DeviceContext*, int, XMMATRIX, XMMATRIX, XMMATRIX, ID3D11ShaderResourceView*, FXMVECTOR);
+	bool Render(RenderContext*, int, XMMATRIX, XMMATRIX, ID3D11ShaderResourceView*, FXMVECTOR);
 
 private:
 	bool InitializeShader(ID3D11Device*, HWND, WCHAR*, WCHAR*);
 	void ShutdownShader();
 	void OutputShaderErrorMessage(ID3D10Blob*, HWND, WCHAR*);
 
-	bool SetShaderParameters(ID3D11DeviceContext*, XMMATRIX, XMMATRIX, XMMATRIX, ID3D11ShaderResourceView*, FXMVECTOR);
-	void RenderShader(ID3D11DeviceContext*, int);
+	bool SetShaderParameters(RenderContext*, XMMATRIX, XMMATRIX, ID3D11ShaderResourceView*, FXMVECTOR);
+	void RenderShader(RenderContext*, int);
 
 private:
 	ID3D11VertexShader * m_vertexShader;
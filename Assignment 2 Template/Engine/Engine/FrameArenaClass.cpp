@@ -0,0 +1,273 @@
+//======================================================
+//				Filename: FrameArenaClass.cpp
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "FrameArenaClass.h"
+
+
+//======================================================
+//				Library Headers.
+//======================================================
+#include <stdint.h>
+
+
+//The arena bound to the calling thread.
+static thread_local FrameArenaClass* t_arena = 0;
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		FrameArenaClass
+
+Summary:	The default constructor for an empty FrameArenaClass.
+
+Modifies:	[m_memory, m_capacity, m_offset, m_overflowBytes, m_highWater,
+				m_overflows].
+
+Returns:	FrameArenaClass
+				the newly created FrameArenaClass object.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+FrameArenaClass::FrameArenaClass()
+{
+	m_memory = 0;
+	m_capacity = 0;
+	m_offset = 0;
+	m_overflowBytes = 0;
+	m_highWater = 0;
+	m_overflows = 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		FrameArenaClass
+
+Summary:	The reference constructor for a FrameArenaClass.
+
+Args:		const FrameArenaClass& other
+				the FrameArenaClass to create this one in the image of.
+
+Modifies:	[none].
+
+Returns:	FrameArenaClass
+				the newly created FrameArenaClass object.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+FrameArenaClass::FrameArenaClass(const FrameArenaClass& other)
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		~FrameArenaClass
+
+Summary:	The default deconstructor for a FrameArenaClass.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+FrameArenaClass::~FrameArenaClass()
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Initialize
+
+Summary:	Allocates the block the arena bumps through.
+
+Args:		size_t capacity
+				the size of the block in bytes.
+
+Modifies:	[m_memory, m_capacity, m_offset].
+
+Returns:	bool
+				was the block allocated successfully.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool FrameArenaClass::Initialize(size_t capacity)
+{
+	m_memory = new (std::nothrow) char[capacity];
+	if (!m_memory)
+		return false;
+
+	m_capacity = capacity;
+	m_offset = 0;
+	return true;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Shutdown
+
+Summary:	Frees the block and anything that overflowed onto the heap.
+
+Modifies:	[m_memory, m_capacity, m_offset, m_overflow, m_overflowBytes].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void FrameArenaClass::Shutdown()
+{
+	Reset();
+
+	delete[] m_memory;
+	m_memory = 0;
+	m_capacity = 0;
+
+	if (t_arena == this)
+		t_arena = 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Allocate
+
+Summary:	Takes memory from the block by bumping the offset past it.
+			If the block is full the memory comes from the heap instead,
+			and is freed at the next Reset().
+
+Args:		size_t size
+				the number of bytes needed.
+			size_t alignment
+				the alignment needed, a power of two.
+
+Modifies:	[m_offset, m_overflow, m_overflowBytes, m_overflows].
+
+Returns:	void*
+				the memory, valid until the next Reset().
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void* FrameArenaClass::Allocate(size_t size, size_t alignment)
+{
+	//Round the start up to the alignment.
+	uintptr_t start = ((uintptr_t)(m_memory + m_offset) + alignment - 1) & ~(uintptr_t)(alignment - 1);
+	size_t end = (size_t)(start - (uintptr_t)m_memory) + size;
+
+	if (m_memory && end <= m_capacity)
+	{
+		m_offset = end;
+		return (void*)start;
+	}
+
+	//Overflow onto the heap, leaving room to align.
+	char* memory = (char*)::operator new(size + alignment);
+	m_overflow.push_back(memory);
+	m_overflowBytes += size + alignment;
+	m_overflows++;
+
+	return (void*)(((uintptr_t)memory + alignment - 1) & ~(uintptr_t)(alignment - 1));
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Reset
+
+Summary:	Reclaims everything allocated since the last call. If the
+			frame overflowed the block, the block is grown to hold the
+			whole frame, so the next one can stay off the heap.
+
+Modifies:	[m_memory, m_capacity, m_offset, m_overflow, m_overflowBytes,
+				m_highWater].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void FrameArenaClass::Reset()
+{
+	size_t used = m_offset + m_overflowBytes;
+	if (used > m_highWater)
+		m_highWater = used;
+
+	if (!m_overflow.empty())
+	{
+		for (std::vector<void*>::iterator iter = m_overflow.begin();
+			iter != m_overflow.end();
+			iter++)
+		{
+			::operator delete(*iter);
+		}
+		m_overflow.clear();
+
+		//Grow to at least double, so a frame that keeps growing settles quickly.
+		size_t capacity = m_capacity * 2 > used ? m_capacity * 2 : used;
+		char* memory = new (std::nothrow) char[capacity];
+		if (memory)
+		{
+			delete[] m_memory;
+			m_memory = memory;
+			m_capacity = capacity;
+		}
+	}
+
+	m_offset = 0;
+	m_overflowBytes = 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetCapacity
+
+Summary:	Gets the size of the block.
+
+Modifies:	[none].
+
+Returns:	size_t
+				the size of the block in bytes.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+size_t FrameArenaClass::GetCapacity()
+{
+	return m_capacity;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetHighWater
+
+Summary:	Gets the most bytes a frame has needed, as of the last Reset().
+
+Modifies:	[none].
+
+Returns:	size_t
+				the high water mark in bytes.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+size_t FrameArenaClass::GetHighWater()
+{
+	return m_highWater;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetOverflows
+
+Summary:	Gets the number of allocations that did not fit the block and
+			went to the heap.
+
+Modifies:	[none].
+
+Returns:	long long
+				the overflowing allocations since Initialize().
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+long long FrameArenaClass::GetOverflows()
+{
+	return m_overflows;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetCurrent
+
+Summary:	Gets the arena bound to the calling thread.
+
+Modifies:	[none].
+
+Returns:	FrameArenaClass*
+				the bound arena, or 0 if there is none.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+FrameArenaClass* FrameArenaClass::GetCurrent()
+{
+	return t_arena;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		SetCurrent
+
+Summary:	Binds an arena to the calling thread, so FrameAllocators made
+			on it allocate from the arena.
+
+Args:		FrameArenaClass* arena
+				the arena to bind, or 0 to use the heap.
+
+Modifies:	[none].
+
+Returns:	FrameArenaClass*
+				the arena that was bound before.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+FrameArenaClass* FrameArenaClass::SetCurrent(FrameArenaClass* arena)
+{
+	FrameArenaClass* previous = t_arena;
+	t_arena = arena;
+	return previous;
+}
@@ -0,0 +1,183 @@
+#pragma once
+//======================================================
+//				Filename: FrameArenaClass.h
+//======================================================
+
+
+//======================================================
+//					Include Guards.
+//======================================================
+#ifndef _FRAMEARENACLASS_H_
+#define _FRAMEARENACLASS_H_
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <stddef.h>
+#include <new>
+#include <vector>
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		FrameArenaClass
+
+Summary:	A linear allocator for data that only lives for one frame.
+			Allocating bumps an offset through one block of memory, freeing
+			does nothing, and Reset() reclaims everything at once.
+			If a frame needs more than the block holds, the rest comes from
+			the heap and the block is grown at the next Reset(), so a steady
+			frame settles on no heap allocations at all.
+			An arena is used by one thread at a time. Each thread can bind
+			an arena with SetCurrent() or a FrameArenaScope, which is what
+			FrameAllocator picks up by default.
+
+Methods:	==================== PUBLIC ====================
+			FrameArenaClass()
+				Default constructor.
+			FrameArenaClass(const FrameArenaClass&)
+				Reference constructor.
+			~FrameArenaClass()
+				Default deconstructor.
+
+			bool Initialize(size_t)
+				Call after creation to allocate the block.
+			void Shutdown()
+				Call before deletion to free the block and any overflow.
+
+			void* Allocate(size_t, size_t)
+				Use to take memory of the given size and alignment from the
+				arena. It is valid until the next Reset().
+			void Reset()
+				Use once per frame, when nothing allocated from the arena is
+				still in use, to reclaim everything.
+
+			size_t GetCapacity()
+				Use to get the size of the block in bytes.
+			size_t GetHighWater()
+				Use to get the most bytes any frame has needed.
+			long long GetOverflows()
+				Use to get the allocations so far that did not fit the block.
+
+			static FrameArenaClass* GetCurrent()
+				Use to get the arena bound to the calling thread, or 0.
+			static FrameArenaClass* SetCurrent(FrameArenaClass*)
+				Use to bind an arena to the calling thread. Returns the
+				arena that was bound before.
+
+Members:	==================== PRIVATE ====================
+			char* m_memory
+				the block allocations are bumped through.
+			size_t m_capacity
+				the size of the block in bytes.
+			size_t m_offset
+				the bytes of the block used since the last Reset().
+			size_t m_overflowBytes
+				the bytes taken from the heap since the last Reset().
+			size_t m_highWater
+				the most bytes, block and overflow, any frame has needed.
+			long long m_overflows
+				the allocations so far that did not fit the block.
+			std::vector<void*> m_overflow
+				the heap allocations to free at the next Reset().
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class FrameArenaClass
+{
+public:
+	FrameArenaClass();
+	FrameArenaClass(const FrameArenaClass&);
+	~FrameArenaClass();
+
+	bool Initialize(size_t capacity);
+	void Shutdown();
+
+	void* Allocate(size_t size, size_t alignment);
+	void Reset();
+
+	size_t GetCapacity();
+	size_t GetHighWater();
+	long long GetOverflows();
+
+	static FrameArenaClass* GetCurrent();
+	static FrameArenaClass* SetCurrent(FrameArenaClass* arena);
+
+private:
+	char* m_memory;
+	size_t m_capacity;
+	size_t m_offset;
+	size_t m_overflowBytes;
+	size_t m_highWater;
+	long long m_overflows;
+	std::vector<void*> m_overflow;
+};
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		FrameArenaScope
+
+Summary:	Binds an arena to the calling thread for the rest of the
+			enclosing scope, then puts back whatever was bound before.
+			Use at the top of a job that runs on whichever thread is free.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class FrameArenaScope
+{
+public:
+	explicit FrameArenaScope(FrameArenaClass* arena) : m_previous(FrameArenaClass::SetCurrent(arena)) {}
+	~FrameArenaScope() { FrameArenaClass::SetCurrent(m_previous); }
+
+private:
+	FrameArenaScope(const FrameArenaScope&);
+	FrameArenaScope& operator=(const FrameArenaScope&);
+
+	FrameArenaClass* m_previous;
+};
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		FrameAllocator
+
+Summary:	An STL allocator that takes memory from a FrameArenaClass, so
+			containers built and thrown away within a frame never touch
+			the heap. Defaults to the arena bound to the constructing
+			thread, falling back to the heap if there is none.
+			A container using one must not outlive the arena's next Reset().
+
+Types:		FrameVector<T>
+				a std::vector using a FrameAllocator.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+template <class T>
+class FrameAllocator
+{
+public:
+	typedef T value_type;
+
+	FrameAllocator() : m_arena(FrameArenaClass::GetCurrent()) {}
+	explicit FrameAllocator(FrameArenaClass* arena) : m_arena(arena) {}
+	template <class U> FrameAllocator(const FrameAllocator<U>& other) : m_arena(other.GetArena()) {}
+
+	T* allocate(size_t count)
+	{
+		if (m_arena)
+			return (T*)m_arena->Allocate(count * sizeof(T), alignof(T));
+		return (T*)::operator new(count * sizeof(T));
+	}
+
+	void deallocate(T* memory, size_t count)
+	{
+		if (!m_arena)
+			::operator delete(memory);
+	}
+
+	FrameArenaClass* GetArena() const { return m_arena; }
+
+	template <class U> bool operator==(const FrameAllocator<U>& other) const { return m_arena == other.GetArena(); }
+	template <class U> bool operator!=(const FrameAllocator<U>& other) const { return m_arena != other.GetArena(); }
+
+private:
+	FrameArenaClass* m_arena;
+};
+
+template <class T>
+using FrameVector = std::vector<T, FrameAllocator<T> >;
+
+#endif
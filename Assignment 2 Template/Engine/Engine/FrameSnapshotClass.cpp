@@ -0,0 +1,147 @@
+//======================================================
+//				Filename: FrameSnapshotClass.cpp
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "FrameSnapshotClass.h"
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		FrameSnapshotClass
+
+Summary:	The default constructor for a FrameSnapshotClass with two
+			empty buffers.
+
+Modifies:	[m_frames, m_front, m_backReady].
+
+Returns:	FrameSnapshotClass
+				the newly created FrameSnapshotClass object.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+FrameSnapshotClass::FrameSnapshotClass()
+{
+	m_frames[0] = -1;
+	m_frames[1] = -1;
+	m_front = 0;
+	m_backReady.store(false);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		FrameSnapshotClass
+
+Summary:	The reference constructor for a FrameSnapshotClass.
+
+Args:		const FrameSnapshotClass& other
+				the FrameSnapshotClass to create this one in the image of.
+
+Modifies:	[none].
+
+Returns:	FrameSnapshotClass
+				the newly created FrameSnapshotClass object.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+FrameSnapshotClass::FrameSnapshotClass(const FrameSnapshotClass& other)
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		~FrameSnapshotClass
+
+Summary:	The default deconstructor for a FrameSnapshotClass.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+FrameSnapshotClass::~FrameSnapshotClass()
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		BeginWrite
+
+Summary:	Empties the back buffer and stamps it with a frame number,
+			ready for the simulation to fill in. The buffer keeps its
+			capacity so steady scenes do not allocate.
+
+Args:		int frame
+				the number of the frame being written.
+
+Modifies:	[m_buffers, m_frames, m_backReady].
+
+Returns:	std::vector<Entry>&
+				the back buffer to write the entries into.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+std::vector<FrameSnapshotClass::Entry>& FrameSnapshotClass::BeginWrite(int frame)
+{
+	int back = 1 - m_front;
+
+	m_backReady.store(false, std::memory_order_relaxed);
+	m_frames[back] = frame;
+	m_buffers[back].clear();
+	return m_buffers[back];
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		EndWrite
+
+Summary:	Marks the back buffer as complete so the next Swap() hands it
+			to the renderer.
+
+Modifies:	[m_backReady].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void FrameSnapshotClass::EndWrite()
+{
+	m_backReady.store(true, std::memory_order_release);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Swap
+
+Summary:	Makes the back buffer the front one if it has been completed
+			since the last swap. Otherwise the front buffer is kept, so the
+			last complete frame is drawn again.
+
+Modifies:	[m_front, m_backReady].
+
+Returns:	bool
+				was a new snapshot swapped in.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool FrameSnapshotClass::Swap()
+{
+	if (!m_backReady.load(std::memory_order_acquire))
+		return false;
+
+	m_backReady.store(false, std::memory_order_relaxed);
+	m_front = 1 - m_front;
+	return true;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetFront
+
+Summary:	Gets the entries of the front buffer for drawing.
+
+Modifies:	[none].
+
+Returns:	const std::vector<Entry>&
+				the entries of the last snapshot swapped in.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+const std::vector<FrameSnapshotClass::Entry>& FrameSnapshotClass::GetFront()
+{
+	return m_buffers[m_front];
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetFrontFrame
+
+Summary:	Gets the frame number the front buffer was written for.
+
+Modifies:	[none].
+
+Returns:	int
+				the frame number, or -1 if nothing has been swapped in yet.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+int FrameSnapshotClass::GetFrontFrame()
+{
+	return m_frames[m_front];
+}
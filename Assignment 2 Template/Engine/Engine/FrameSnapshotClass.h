@@ -0,0 +1,114 @@
+#pragma once
+//======================================================
+//				Filename: FrameSnapshotClass.h
+//======================================================
+
+
+//======================================================
+//					Include Guards.
+//======================================================
+#ifndef _FRAMESNAPSHOTCLASS_H_
+#define _FRAMESNAPSHOTCLASS_H_
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <DirectXCollision.h>
+#include <DirectXMath.h>
+#include <atomic>
+#include <vector>
+using namespace DirectX;
+
+
+//======================================================
+//				Forward declarations.
+//======================================================
+class GameObject;
+class MeshBVHClass;
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		FrameSnapshotClass
+
+Summary:	A double buffered copy of everything needed to draw the scene,
+			so one frame can be submitted while the next is simulated.
+			The simulation writes the back buffer while the renderer reads
+			the front one; neither touches the buffer owned by the other.
+			Swap() hands a finished back buffer over to the renderer, and
+			must only be called by the reading thread while no write is
+			in progress.
+
+Structs:	Entry
+				the world matrix, bounds and visibility of one object, as
+				they were when the snapshot was written, and its triangles
+				if it is an occluder.
+
+Methods:	==================== PUBLIC ====================
+			FrameSnapshotClass()
+				Default constructor. Both buffers start empty.
+			FrameSnapshotClass(const FrameSnapshotClass&)
+				Reference constructor.
+			~FrameSnapshotClass()
+				Default deconstructor.
+
+			std::vector<Entry>& BeginWrite(int)
+				Use on the simulating thread to get the back buffer, emptied
+				and stamped with the given frame number.
+			void EndWrite()
+				Use on the simulating thread once the back buffer is complete.
+			bool Swap()
+				Use on the rendering thread to make a completed back buffer
+				the front one. Returns false if none was completed.
+
+			const std::vector<Entry>& GetFront()
+				Use on the rendering thread to get the entries to draw.
+			int GetFrontFrame()
+				Use on the rendering thread to get the frame number the
+				front buffer was written for, or -1 before the first swap.
+
+Members:	==================== PRIVATE ====================
+			std::vector<Entry> m_buffers[2]
+				the two buffers, reused from frame to frame.
+			int m_frames[2]
+				the frame number each buffer was written for.
+			int m_front
+				the index of the buffer owned by the renderer.
+			std::atomic<bool> m_backReady
+				whether the back buffer has been completed since the last
+				swap. Set with release order by EndWrite() so the entries
+				are visible to the thread that sees it.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class FrameSnapshotClass
+{
+public:
+	struct Entry
+	{
+		GameObject* object;
+		XMFLOAT4X4 worldMatrix;
+		BoundingBox bounds;
+		float animationTime;
+		bool visible;
+		MeshBVHClass* occluder;
+	};
+
+public:
+	FrameSnapshotClass();
+	FrameSnapshotClass(const FrameSnapshotClass&);
+	~FrameSnapshotClass();
+
+	std::vector<Entry>& BeginWrite(int frame);
+	void EndWrite();
+	bool Swap();
+
+	const std::vector<Entry>& GetFront();
+	int GetFrontFrame();
+
+private:
+	std::vector<Entry> m_buffers[2];
+	int m_frames[2];
+	int m_front;
+	std::atomic<bool> m_backReady;
+};
+
+#endif
@@ -16,7 +16,9 @@ Method:		GameObject
 
 Summary:	The Default Constructor for a gameObject.
 
-Modifies:	[m_baseModel, m_AABB, m_transform, m_scale, m_rotation].
+Modifies:	[m_baseModel, m_AABB, m_transform, m_scale, m_orientation, m_boundsPending,
+				m_rotated, m_boundsVersion, m_occluder, m_worldMatrix, m_dirty,
+				m_hasPrevState, m_movedThisStep].
 
 Returns:	GameObject
 				the newly created GameObject object.
@@ -27,7 +29,15 @@ GameObject::GameObject()
 	m_AABB = new BoundingBox();
 	m_transform = new XMFLOAT3(0, 0, 0);
 	m_scale = new XMFLOAT3(1, 1, 1);
-	m_rotation = new XMFLOAT3(0, 0, 0);
+	m_orientation = new XMFLOAT4(0, 0, 0, 1);
+	m_boundsPending = false;
+	m_rotated = false;
+	m_boundsVersion = 0;
+	m_occluder = false;
+	XMStoreFloat4x4(&m_worldMatrix, XMMatrixIdentity());
+	m_dirty = true;
+	m_hasPrevState = false;
+	m_movedThisStep = false;
 }
 
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -50,22 +60,38 @@ Summary:	The preferred constructor for a gameobject. Creates a
 Args:		ModelClass* baseModel
 				the ModelClass object ussed for this model.
 
-Modifies:	[m_baseModel, m_AABB, m_transform, m_scale].
+Modifies:	[m_baseModel, m_AABB, m_transform, m_scale, m_rotated,
+				m_boundsVersion, m_occluder, m_worldMatrix, m_dirty,
+				m_hasPrevState, m_movedThisStep].
 
 Returns:	GameObject
 				the newly created GameObject
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 GameObject::GameObject(ModelClass * baseModel)
 {
+	m_rotated = false;
+	m_boundsVersion = 0;
+	m_occluder = false;
+	XMStoreFloat4x4(&m_worldMatrix, XMMatrixIdentity());
+	m_dirty = true;
+	m_hasPrevState = false;
+	m_movedThisStep = false;
 	Setup(baseModel);
 }
 
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
 Method:		RenderAABB
 
-Summary:	Use to render the AABB of this gameObject to the screen.
+Summary:	Use to render the AABB of a gameObject to the screen. Takes the
+			bounds from a snapshot, so it never reads an object that may be
+			being simulated. The same unit box model is scaled and moved onto
+			every AABB, rather than building a model for each one.
 
-Args:		ShaderManagerClass* shaderManager
+Args:		const BoundingBox& bounds
+				the bounding box to draw.
+			ModelClass* boxModel
+				a box model with a center of 0 and extents of 1.
+			ShaderManagerClass* shaderManager
 				a pointer to the ShaderManagerClass object currently
 				being used.
 			D3DClass* d3d
@@ -76,34 +102,301 @@ Args:		ShaderManagerClass* shaderManager
 
 Modifies:	[none].
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-void GameObject::RenderAABB(ShaderManagerClass* shaderManager, D3DClass* d3d, CameraClass* cam)
+void GameObject::RenderAABB(const BoundingBox& bounds, ModelClass* boxModel, ShaderManagerClass* shaderManager, D3DClass* d3d, CameraClass* cam)
 {
 	//Turn on wireframe drawing in the d3d class.
 	d3d->TurnOnWireframe();
 
-	//Create a model to represent the boundingBox
-	ModelClass* aabb = new ModelClass();
-
-	//Initialize the model using the boundingBox stored within this model.
-	aabb->Initialize(d3d->GetDevice(), m_AABB);
-
 	//Render the boundingBoxModel to the device.
-	aabb->Render(d3d->GetDeviceContext());
+	boxModel->Render(d3d->GetRenderContext());
 
-	//Get the world, view and projection matrices for drawing.
-	XMMATRIX worldMatrix, viewMatrix, projectionMatrix;
+	//Get the world matrix and the camera's cached view projection matrix for drawing.
+	XMMATRIX worldMatrix, viewProjectionMatrix;
 	d3d->GetWorldMatrix(worldMatrix);
-	cam->GetViewMatrix(viewMatrix);
-	d3d->GetProjectionMatrix(projectionMatrix);
+	cam->GetViewProjectionMatrix(viewProjectionMatrix);
+
+	//Stretch the unit box over the bounds.
+	worldMatrix = XMMatrixScaling(bounds.Extents.x, bounds.Extents.y, bounds.Extents.z)
+		* XMMatrixTranslation(bounds.Center.x, bounds.Center.y, bounds.Center.z)
+		* worldMatrix;
 	
 	//use the shaderManager and the texture shader to render the boundingBoxModel to the device.
-	bool result = shaderManager->RenderTextureShader(d3d->GetDeviceContext(), aabb->GetIndexCount(), 
-		worldMatrix, viewMatrix, projectionMatrix, aabb->GetTexture());
+	bool result = shaderManager->RenderTextureShader(d3d->GetRenderContext(), boxModel->GetIndexCount(), 
+		worldMatrix, viewProjectionMatrix, boxModel->GetTexture());
 
 	//Turn off wireframe drawing in the d3d class.
 	d3d->TurnOffWireframe();
 }
 
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		CheckModelReady
+
+Summary:	Checks whether the base model of this gameObject has finished
+			streaming in. The first time it has, the placeholder bounds are
+			replaced with the real min and max points of the model.
+
+Modifies:	[m_min, m_max, m_AABB, m_boundsPending].
+
+Returns:	bool
+				is the base model ready to be drawn.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool GameObject::CheckModelReady()
+{
+	if (m_boundsPending && IsModelReady())
+	{
+		//Swap the placeholder bounds for the real ones.
+		RefreshBounds();
+		m_boundsPending = false;
+	}
+
+	return !m_boundsPending;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		HasBounds
+
+Summary:	Checks whether the real bounds of the base model have been
+			picked up by CheckModelReady(). Until they have, the AABB is
+			only a placeholder unit box, so picking and collision skip this
+			gameObject rather than test it. Unlike CheckModelReady() nothing
+			is changed, so it is safe to call from several threads at once.
+
+Modifies:	[none].
+
+Returns:	bool
+				does the AABB hold the real bounds of the base model.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool GameObject::HasBounds()
+{
+	return !m_boundsPending;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RenderPlaceholder
+
+Summary:	Draws the placeholder bounds of a gameObject in place of
+			its base model while the model is still streaming in. The
+			bounds were positioned by the last UpdateBounds() and copied
+			into a snapshot.
+
+Args:		const BoundingBox& bounds
+				the placeholder bounds to draw.
+			ModelClass* boxModel
+				a box model with a center of 0 and extents of 1.
+			ShaderManagerClass* shaderManager
+				a pointer to the ShaderManagerClass object currently
+				being used.
+			D3DClass* d3d
+				A pointer to the D3DClass object currently being used.
+			CameraClass* cam
+				A pointer to the CameraClass object being used to
+				represent the current user camera.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void GameObject::RenderPlaceholder(const BoundingBox& bounds, ModelClass* boxModel, ShaderManagerClass* shaderManager, D3DClass* d3d, CameraClass* cam)
+{
+	//Draw the bounding box as a wireframe box.
+	RenderAABB(bounds, boxModel, shaderManager, d3d, cam);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RequestTextureDetail
+
+Summary:	Passes the size of this gameObject on screen to the texture of
+			its base model, so a streamed texture can fetch the mips it needs.
+
+Args:		float screenPixels
+				the size of the gameObject on screen, in pixels.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void GameObject::RequestTextureDetail(float screenPixels)
+{
+	if (m_baseModel)
+		m_baseModel->RequestTextureSize(screenPixels);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		UpdateBounds
+
+Summary:	Picks up the real bounds of the base model if it has become
+			ready, then, if anything has changed since the last call,
+			rebuilds the world matrix of this gameObject from its current
+			state and repositions its AABB and OBB with it. Objects that
+			have not moved cost nothing.
+
+Modifies:	[m_worldMatrix, m_AABB, m_OBB, m_rotated, m_boundsVersion, m_dirty,
+				m_movedThisStep].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void GameObject::UpdateBounds()
+{
+	if (!NeedsBoundsUpdate())
+		return;
+
+	//Build the world matrix from where the object is now.
+	XMFLOAT4X4 worldMatrix;
+	XMStoreFloat4x4(&worldMatrix, CalcWorldMatrix(1.0f));
+	ApplyWorldMatrix(worldMatrix);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		NeedsBoundsUpdate
+
+Summary:	Picks up the real bounds of the base model if it has become
+			ready, then checks whether the world matrix needs rebuilding.
+
+Modifies:	[m_min, m_max, m_AABB, m_boundsPending, m_dirty].
+
+Returns:	bool
+				has the transform, scale, rotation or bounds changed since
+				the world matrix was last built.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool GameObject::NeedsBoundsUpdate()
+{
+	//Swap in the real bounds if the model has streamed in.
+	CheckModelReady();
+
+	return m_dirty;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		WriteTransform
+
+Summary:	Writes the current position, rotation and scale of this
+			gameObject into a slot of a transform batch, so its world matrix
+			can be built alongside many others.
+
+Args:		TransformBatchClass* batch
+				the batch to write to.
+			int index
+				the slot to fill.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void GameObject::WriteTransform(TransformBatchClass* batch, int index)
+{
+	batch->Set(index, *m_transform, XMLoadFloat4(m_orientation), *m_scale);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		ApplyWorldMatrix
+
+Summary:	Takes a world matrix built from the current state of this
+			gameObject and repositions its AABB and OBB with it.
+
+Args:		const XMFLOAT4X4& worldMatrix
+				the world matrix of where this gameObject is now.
+
+Modifies:	[m_worldMatrix, m_AABB, m_OBB, m_rotated, m_boundsVersion, m_dirty,
+				m_movedThisStep].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void GameObject::ApplyWorldMatrix(const XMFLOAT4X4& worldMatrix)
+{
+	m_worldMatrix = worldMatrix;
+	XMMATRIX world = XMLoadFloat4x4(&worldMatrix);
+
+	//Remake the bounding box in model space.
+	BoundingBox::CreateFromPoints(*m_AABB, XMLoadFloat3(m_min), XMLoadFloat3(m_max));
+
+	//Turn a copy of it with the object, which the AABB around it can be
+	//far larger than once the object is rotated.
+	m_rotated = m_orientation->x != 0.0f || m_orientation->y != 0.0f || m_orientation->z != 0.0f;
+	BoundingOrientedBox::CreateFromBoundingBox(m_OBB, *m_AABB);
+	m_OBB.Transform(m_OBB, world);
+
+	//Transform the bounding box using the new worldMatrix.
+	m_AABB->Transform(*m_AABB, world);
+	m_boundsVersion++;
+
+	m_dirty = false;
+	m_movedThisStep = true;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		WriteSnapshot
+
+Summary:	Writes everything needed to draw this gameObject into a snapshot
+			entry, so it can be drawn while the next step is simulated.
+			Anything placed since the last simulation step is picked up
+			first. For an object that moved during the step, the snapshot
+			stores the world matrix lerped by the interpolation alpha
+			between its previous and current step state. Any other object
+			stores its world matrix as it is.
+
+Args:		float interpolation
+				how far through the current simulation step the frame is,
+				from 0 to 1.
+			FrameSnapshotClass::Entry& entry
+				the entry to fill in.
+
+Modifies:	[m_worldMatrix, m_AABB, m_dirty].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void GameObject::WriteSnapshot(float interpolation, FrameSnapshotClass::Entry& entry)
+{
+	UpdateBounds();
+
+	if (m_hasPrevState && m_movedThisStep && interpolation < 1.0f)
+		XMStoreFloat4x4(&entry.worldMatrix, CalcWorldMatrix(interpolation));
+	else
+		entry.worldMatrix = m_worldMatrix;
+
+	entry.object = this;
+	entry.bounds = *m_AABB;
+	entry.animationTime = GetAnimationTime();
+	entry.visible = !m_boundsPending;
+	entry.occluder = (m_occluder && entry.visible) ? GetMeshBVH() : 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Frame
+
+Summary:	Advances this gameObject by one simulation step. A plain
+			gameObject only moves when told to, so does nothing.
+
+Args:		float deltaTime
+				the length of the step, in seconds.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void GameObject::Frame(float deltaTime)
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		SaveState
+
+Summary:	Keeps the current transform, scale and orientation so frames
+			drawn during the coming simulation step can interpolate from them.
+
+Modifies:	[m_prevTransform, m_prevScale, m_prevOrientation, m_hasPrevState,
+				m_movedThisStep].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void GameObject::SaveState()
+{
+	m_prevTransform = *m_transform;
+	m_prevScale = *m_scale;
+	m_prevOrientation = *m_orientation;
+	m_hasPrevState = true;
+	m_movedThisStep = false;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetAnimationTime
+
+Summary:	Gets the time the shader animation of this gameObject has
+			reached. A plain gameObject is not animated.
+
+Modifies:	[none].
+
+Returns:	float
+				the animation time passed to Render().
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+float GameObject::GetAnimationTime()
+{
+	return 0.0f;
+}
+
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
 Method:		setScale
 
@@ -116,7 +409,7 @@ Args:		float x
 			float z
 				the new z scale to be used.
 
-Modifies:	[m_scale].
+Modifies:	[m_scale, m_dirty].
 
 Returns:	bool
 				was the scale setting successful or not.
@@ -132,6 +425,7 @@ bool GameObject::setScale(float x, float y, float z)
 		m_scale->x = x;
 		m_scale->y = y;
 		m_scale->z = z;
+		m_dirty = true;
 	}
 	catch (exception e)
 	{
@@ -144,31 +438,47 @@ bool GameObject::setScale(float x, float y, float z)
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
 Method:		setRotation
 
-Summary:	The public method to change the rotation of the gameObject.
+Summary:	The public method to change the rotation of the gameObject from
+			euler angles, for setting objects up by hand. The angles are
+			turned into the orientation quaternion once here, so prefer the
+			quaternion overload for anything set every step.
 
 Args:		float x
-				the new x rotation to be used.
+				the new x rotation to be used, in radians.
 			float y
-				the new y rotation to be used.
+				the new y rotation to be used, in radians.
 			float z
-				the new z rotation to be used.
+				the new z rotation to be used, in radians.
 
-Modifies:	[m_rotation].
+Modifies:	[m_orientation, m_dirty].
 
 Returns:	bool
 				was the rotation setting successful or not.
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 bool GameObject::setRotation(float x, float y, float z)
+{
+	return setRotation(XMQuaternionRotationRollPitchYaw(x, y, z));
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		setRotation
+
+Summary:	The public method to change the orientation of the gameObject.
+
+Args:		FXMVECTOR orientation
+				the new orientation as a quaternion, normalized here.
+
+Modifies:	[m_orientation, m_dirty].
+
+Returns:	bool
+				was the rotation setting successful or not.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool GameObject::setRotation(FXMVECTOR orientation)
 {
 	try
 	{
-		float prevX = m_rotation->x;
-		float prevY = m_rotation->y;
-		float prevZ = m_rotation->z;
-
-		m_rotation->x = x;
-		m_rotation->y = y;
-		m_rotation->z = z;
+		XMStoreFloat4(m_orientation, XMQuaternionNormalize(orientation));
+		m_dirty = true;
 	}
 	catch (exception e)
 	{
@@ -189,7 +499,7 @@ Args:		float x
 			float z
 				the new z transform to be used.
 
-Modifies:	[m_transform].
+Modifies:	[m_transform, m_dirty].
 
 Returns:	bool
 				was the transform setting successful or not.
@@ -205,6 +515,7 @@ bool GameObject::setTransform(float x, float y, float z)
 		m_transform->x = x;
 		m_transform->y = y;
 		m_transform->z = z;
+		m_dirty = true;
 	}
 	catch (exception e)
 	{
@@ -216,31 +527,50 @@ bool GameObject::setTransform(float x, float y, float z)
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
 Method:		addRotation
 
-Summary:	The public method to add to the rotation of the gameObject.
+Summary:	The public method to turn the gameObject further by euler
+			angles, for turning objects by hand. The angles are turned into
+			a quaternion each call, so prefer the quaternion overload for
+			anything turned every step.
 
 Args:		float x
-				the x rotation to be added.
+				the x rotation to be added, in radians.
 			float y
-				the y rotation to be added.
+				the y rotation to be added, in radians.
 			float z
-				the z rotation to be added.
+				the z rotation to be added, in radians.
 
-Modifies:	[m_rotation].
+Modifies:	[m_orientation, m_dirty].
 
 Returns:	bool
 				was the rotation adding successful or not.
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 bool GameObject::addRotation(float x, float y, float z)
+{
+	return addRotation(XMQuaternionRotationRollPitchYaw(x, y, z));
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		addRotation
+
+Summary:	The public method to turn the gameObject further about the
+			world axes. The orientation is renormalized each time so
+			rounding never builds up.
+
+Args:		FXMVECTOR rotation
+				the rotation to add, as a unit quaternion.
+
+Modifies:	[m_orientation, m_dirty].
+
+Returns:	bool
+				was the rotation adding successful or not.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool GameObject::addRotation(FXMVECTOR rotation)
 {
 	try
 	{
-		float prevX = m_rotation->x;
-		float prevY = m_rotation->y;
-		float prevZ = m_rotation->z;
-
-		m_rotation->x += x;
-		m_rotation->y += y;
-		m_rotation->z += z;
+		XMVECTOR orientation = XMQuaternionMultiply(XMLoadFloat4(m_orientation), rotation);
+		XMStoreFloat4(m_orientation, XMQuaternionNormalize(orientation));
+		m_dirty = true;
 	}
 	catch (exception e)
 	{
@@ -261,7 +591,7 @@ Args:		float x
 			float z
 				the z transform to be added.
 
-Modifies:	[m_transform].
+Modifies:	[m_transform, m_dirty].
 
 Returns:	bool
 				was the transform adding successful or not.
@@ -277,6 +607,7 @@ bool GameObject::addTransform(float x, float y, float z)
 		m_transform->x += x;
 		m_transform->y += y;
 		m_transform->z += z;
+		m_dirty = true;
 	}
 	catch (exception e)
 	{
@@ -300,6 +631,120 @@ BoundingBox * GameObject::GetAABB()
 	return this->m_AABB;
 }
 
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetOBB
+
+Summary:	Public method to return a pointer to this GameObject's oriented
+			bounding box, as of the last UpdateBounds().
+
+Modifies:	[none].
+
+Returns:	BoundingOrientedBox*
+				a pointer to the oriented box, or 0 if this gameobject is not
+				rotated, as its AABB is then just as tight.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+BoundingOrientedBox * GameObject::GetOBB()
+{
+	if (!m_rotated)
+		return 0;
+
+	return &m_OBB;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetBoundsVersion
+
+Summary:	Public method to return how many times this GameObject's AABB
+			has been rebuilt, so anything built from it can tell when it
+			needs building again.
+
+Modifies:	[none].
+
+Returns:	unsigned int
+				the number of times UpdateBounds() has rebuilt the AABB.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+unsigned int GameObject::GetBoundsVersion()
+{
+	return m_boundsVersion;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetWorldMatrix
+
+Summary:	Public method to return the world matrix of this GameObject's
+			current state. Must not be called while a simulation step is
+			running.
+
+Modifies:	[none].
+
+Returns:	XMMATRIX
+				the world matrix built by the last UpdateBounds(), or a
+				fresh one if anything has changed since.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+XMMATRIX GameObject::GetWorldMatrix()
+{
+	if (m_dirty)
+		return CalcWorldMatrix(1.0f);
+
+	return XMLoadFloat4x4(&m_worldMatrix);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetMeshBVH
+
+Summary:	Public method to return the triangle hierarchy of this
+			GameObject's base model, for exact picking.
+
+			This should be overridden by derived classes if other ModelClass
+			types are used. Those that do not fall back to their AABB.
+
+Modifies:	[none].
+
+Returns:	MeshBVHClass*
+				the hierarchy in model space, or 0 if the base model has
+				none or has not finished streaming in.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+MeshBVHClass * GameObject::GetMeshBVH()
+{
+	if (!m_baseModel || !m_baseModel->IsReady())
+		return 0;
+
+	return m_baseModel->GetBVH();
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		SetOccluder
+
+Summary:	Public method to mark this GameObject as an occluder, so its
+			base model's triangles are drawn into the occlusion culler's
+			depth buffer each frame and hide whatever is wholly behind them.
+			Best kept to a few large, simple models such as walls.
+
+Args:		bool occluder
+				whether this GameObject hides what is behind it.
+
+Modifies:	[m_occluder].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void GameObject::SetOccluder(bool occluder)
+{
+	m_occluder = occluder;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		IsOccluder
+
+Summary:	Public method to return whether this GameObject is an occluder.
+
+Modifies:	[none].
+
+Returns:	bool
+				whether SetOccluder(true) has been called.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool GameObject::IsOccluder()
+{
+	return m_occluder;
+}
+
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
 Method:		GetPosition
 
@@ -359,12 +804,11 @@ M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 void GameObject::UpdateRotation(float prevX, float prevY, float prevZ)
 {
 	XMVECTOR rotDiff;
-	rotDiff = XMVectorSet(m_rotation->x - prevX, m_rotation->y - prevY, m_rotation->z - prevZ, 1.0f);
-	rotDiff = XMQuaternionRotationRollPitchYawFromVector(rotDiff);
-	XMVECTOR* vector = new XMVECTOR();
-	*vector = XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f);
+	rotDiff = XMQuaternionRotationRollPitchYaw(prevX, prevY, prevZ);
+	rotDiff = XMQuaternionMultiply(XMQuaternionInverse(rotDiff), XMLoadFloat4(m_orientation));
+	XMVECTOR vector = XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f);
 	
-	m_AABB->Transform(*m_AABB, 1.0f, rotDiff, *vector);
+	m_AABB->Transform(*m_AABB, 1.0f, rotDiff, vector);
 }
 
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -385,12 +829,10 @@ M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 [[deprecated("CalcWorldMatrix now handles all manipulations of the collision data.")]]
 void GameObject::UpdateTransform(float prevX, float prevY, float prevZ)
 {
-	XMVECTOR* transDiff = new XMVECTOR();
-	*transDiff = XMVectorSet(m_transform->x - prevX, m_transform->y - prevY, m_transform->z - prevZ, 1.0f);
-	XMVECTOR* vector = new XMVECTOR();
-	*vector = XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f);
-	*vector = XMQuaternionRotationRollPitchYawFromVector(*vector);
-	m_AABB->Transform(*m_AABB, 1.0f, *vector, *transDiff);
+	XMVECTOR transDiff = XMVectorSet(m_transform->x - prevX, m_transform->y - prevY, m_transform->z - prevZ, 1.0f);
+	XMVECTOR vector = XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f);
+	vector = XMQuaternionRotationRollPitchYawFromVector(vector);
+	m_AABB->Transform(*m_AABB, 1.0f, vector, transDiff);
 }
 
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -398,31 +840,44 @@ Method:		CalcWorldMatrix
 
 Summary:	Uses all data about this object to construct a resultant
 				world matrix for this object.
-			Then uses that worldMatrix to update and position the AABB
-				for this gameObject.
+			Between simulation steps the transform and scale are lerped
+				from the saved state, and so is the orientation, then
+				renormalized, which for the small turns of one step is as
+				good as a slerp without its trigonometry.
 
-Args:		XMMATRIX &initialWorldMatrix
-				an Initial world matrix to be copied and used for
-				the resultant calculation.
+Args:		float interpolation
+				how far from the saved state to the current one to place
+				this object, from 0 to 1.
 
-Modifies:	[m_AABB].
+Modifies:	[none].
 
-Returns:	XMMATRIX* 
-				a pointer to the calculated XMMATRIX object.
+Returns:	XMMATRIX
+				the calculated world matrix.
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-XMMATRIX * GameObject::CalcWorldMatrix(XMMATRIX &initialWorldMatrix)
+XMMATRIX GameObject::CalcWorldMatrix(float interpolation)
 {
-	//Create an initial XMMATRIX out of the initialWorldMatrix
-	XMMATRIX* worldMatrix = new XMMATRIX(initialWorldMatrix);
+	//Start from the current state.
+	XMVECTOR scale = XMLoadFloat3(m_scale);
+	XMVECTOR rotation = XMLoadFloat4(m_orientation);
+	XMVECTOR transform = XMLoadFloat3(m_transform);
+
+	//Blend back towards the state saved at the start of the simulation step.
+	if (m_hasPrevState && interpolation < 1.0f)
+	{
+		//Blend the short way round.
+		XMVECTOR prevRotation = XMLoadFloat4(&m_prevOrientation);
+		if (XMVectorGetX(XMVector4Dot(prevRotation, rotation)) < 0.0f)
+			prevRotation = XMVectorNegate(prevRotation);
+
+		scale = XMVectorLerp(XMLoadFloat3(&m_prevScale), scale, interpolation);
+		rotation = XMQuaternionNormalize(XMVectorLerp(prevRotation, rotation, interpolation));
+		transform = XMVectorLerp(XMLoadFloat3(&m_prevTransform), transform, interpolation);
+	}
 
 	//Scale, rotate and translate it.
-	*worldMatrix = XMMatrixMultiply(*worldMatrix, XMMatrixScaling(m_scale->x, m_scale->y, m_scale->z));
-	*worldMatrix = XMMatrixMultiply(*worldMatrix, XMMatrixRotationRollPitchYaw(m_rotation->x, m_rotation->y, m_rotation->z));
-	*worldMatrix = XMMatrixMultiply(*worldMatrix, XMMatrixTranslation(m_transform->x, m_transform->y, m_transform->z));
-	
-	//Remake the bounding box and transform it using the new worldMatrix.
-	BoundingBox::CreateFromPoints(*m_AABB, XMLoadFloat3(m_min), XMLoadFloat3(m_max));
-	m_AABB->Transform(*m_AABB, *worldMatrix);
+	XMMATRIX worldMatrix = XMMatrixScalingFromVector(scale);
+	worldMatrix = XMMatrixMultiply(worldMatrix, XMMatrixRotationQuaternion(rotation));
+	worldMatrix = XMMatrixMultiply(worldMatrix, XMMatrixTranslationFromVector(transform));
 
 	return worldMatrix;
 }
@@ -456,23 +911,81 @@ Args:		ModelClass* baseModel
 				a pointer to the ModelClass object that this gameObject
 				should use as its baseModel.
 
-Modifies:	[m_baseModel, m_min, m_max, m_transform, m_scale, m_rotation].
+Modifies:	[m_baseModel, m_min, m_max, m_transform, m_scale, m_orientation].
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 void GameObject::Setup(ModelClass* baseModel)
 {
 	//Point the baseModel correctly.
 	m_baseModel = baseModel;
 
-	//Initialize the min and max points of the base gameObject using the information in baseModel.
-	m_min = new XMFLOAT3(m_baseModel->m_min->x, m_baseModel->m_min->y, m_baseModel->m_min->z);
-	m_max = new XMFLOAT3(m_baseModel->m_max->x, m_baseModel->m_max->y, m_baseModel->m_max->z);
+	//Use unit placeholder bounds until the baseModel has streamed in.
+	m_min = new XMFLOAT3(-1.0f, -1.0f, -1.0f);
+	m_max = new XMFLOAT3(1.0f, 1.0f, 1.0f);
+	m_boundsPending = true;
 
-	//Create an initial bounding box using this data.
+	//Create an initial bounding box, using the real bounds if they are already there.
+	CheckModelReady();
 	BoundingBox::CreateFromPoints(*m_AABB, XMLoadFloat3(m_min), XMLoadFloat3(m_max));
 
-	//Initialize the transform, scale and rotation to acceptable default values.
+	//Initialize the transform, scale and orientation to acceptable default values.
 	m_transform = new XMFLOAT3(0, 0, 0);
 	m_scale = new XMFLOAT3(1, 1, 1);
-	m_rotation = new XMFLOAT3(0, 0, 0);
+	m_orientation = new XMFLOAT4(0, 0, 0, 1);
 }
 
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		IsModelReady
+
+Summary:	Returns whether the base model of this gameObject is ready
+			to be drawn.
+
+			This should be overridden by derived classes if other ModelClass
+			types are used.
+
+Returns:	bool
+				is the base model ready to be drawn.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool GameObject::IsModelReady()
+{
+	return m_baseModel && m_baseModel->IsReady();
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RefreshBounds
+
+Summary:	Copies the min and max points of the base model into this
+			gameObject once the base model is ready.
+
+			This should be overridden by derived classes if other ModelClass
+			types are used.
+
+Modifies:	[m_min, m_max, m_AABB].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void GameObject::RefreshBounds()
+{
+	CopyBounds(m_baseModel->m_min, m_baseModel->m_max);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		CopyBounds
+
+Summary:	Copies the given min and max points into this gameObject and
+			rebuilds its bounding box from them. The box is placed in the
+			world by the next UpdateBounds().
+
+Args:		XMFLOAT3* min
+				the minimum point to copy.
+			XMFLOAT3* max
+				the maximum point to copy.
+
+Modifies:	[m_min, m_max, m_AABB, m_dirty].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void GameObject::CopyBounds(XMFLOAT3* min, XMFLOAT3* max)
+{
+	*m_min = *min;
+	*m_max = *max;
+
+	BoundingBox::CreateFromPoints(*m_AABB, XMLoadFloat3(m_min), XMLoadFloat3(m_max));
+	m_dirty = true;
+}
@@ -15,6 +15,8 @@
 //======================================================
 #include "modelclass.h"
 #include "shadermanagerclass.h"
+#include "FrameSnapshotClass.h"
+#include "TransformBatchClass.h"
 
 
 //======================================================
@@ -42,7 +44,10 @@ Methods:	==================== PURE VIRTUAL ====================
 				A method that must be implemented to render the object
 				using whatever shader is needed.
 				The given parameters are used by every Render Method regardless
-				of shader.
+				of shader. The world matrix is the one this object is drawn
+				with, taken from a FrameSnapshotClass, as is the animation time.
+				The view and projection come already combined, as the camera
+				caches them, so each vertex is only multiplied by two matrices.
 
 			==================== PUBLIC ====================
 			1. GameObject()
@@ -58,26 +63,102 @@ Methods:	==================== PURE VIRTUAL ====================
 			SetScale(float x, float y, float z)
 				Use to change the scale of the gameobject at runtime.
 			SetRotation(float x, float y, float z)
-				Use to change the rotation of the gameObject at runtime.
+				Use to change the rotation of the gameObject from euler angles
+				when setting it up by hand.
+			SetRotation(FXMVECTOR orientation)
+				Use to change the orientation of the gameObject to a quaternion.
 			SetTransform(float x, float y, float z)
 				Use to change the transform of the gameObject at runtime.
 
 			AddRotation(float x, float y, float z)
-				Use to add to the rotation data of the gameObject at runtime.
+				Use to turn the gameObject further by euler angles when turning
+				it by hand.
+			AddRotation(FXMVECTOR rotation)
+				Use to turn the gameObject further by a quaternion, such as one
+				worked out once for a steady spin, with no trigonometry.
 			AddTransform(float x, float y, float z)
 				Use to add to the transform data of the gameObject at runtime.
 
 			GetAABB()
 				Use to get a pointer to the AABB being used by this GameObject.
-			RenderAABB(ShaderManagerClass*, D3DClass*, CameraClass*)
-				Use to render this GameObjects BoundingBox to the specified
-				D3D's device context.
+			GetOBB()
+				Use to get a pointer to the oriented box fitted to this GameObject,
+				or 0 if it is not rotated and the AABB already fits it exactly.
+			GetBoundsVersion()
+				Use to tell whether the AABB has been rebuilt since it was last
+				looked at, as the number goes up each time it is.
+			GetWorldMatrix()
+				Use between simulation steps to get the world matrix of where this
+				GameObject is now.
+			GetMeshBVH()
+				Use to get the triangle hierarchy of the base model, in model space,
+				or 0 if it has none, such as while it is still streaming in.
+				Override in derived classes that use other Model Types.
+			SetOccluder(bool occluder)
+				Use to mark a large GameObject, such as a wall, whose triangles
+				hide whatever is behind them from the occlusion culler.
+			IsOccluder()
+				Use to check whether this GameObject is marked as an occluder.
+			static RenderAABB(const BoundingBox&, ModelClass*, ShaderManagerClass*, D3DClass*, CameraClass*)
+				Use to render a BoundingBox taken from a snapshot to the specified
+				D3D's device context, by stretching a shared unit box model over it.
 
 			GetPosition()
 				Use to get a pointer to the XMFLOAT3 this GameObject uses to
 				store its position in world space.
 
+			CheckModelReady()
+				Use to check whether the base model has finished streaming in.
+				Picks up the real bounds of the model the first time it is ready.
+			HasBounds()
+				Use to check whether the AABB holds the real bounds of the model
+				rather than a placeholder, as of the last CheckModelReady().
+				Picking and collision skip the GameObject until it does.
+			static RenderPlaceholder(const BoundingBox&, ModelClass*, ShaderManagerClass*, D3DClass*, CameraClass*)
+				Use while the base model is still streaming in to draw the
+				placeholder bounds taken from a snapshot instead.
+			RequestTextureDetail(float screenPixels)
+				Use after rendering to pass the on screen size of this GameObject
+				to the texture of its base model.
+				Override in derived classes that use other Model Types.
+			UpdateBounds()
+				Use once per simulation step to rebuild the world matrix and AABB
+				of this GameObject if it has changed since the last call.
+			NeedsBoundsUpdate()
+				Use in place of UpdateBounds() when building many world matrices
+				together, to check whether this GameObject's needs rebuilding.
+			WriteTransform(TransformBatchClass*, int)
+				Use to write the position, rotation and scale of this GameObject
+				into a slot of a batch its world matrix is built in.
+			ApplyWorldMatrix(const XMFLOAT4X4&)
+				Use with the world matrix built from a batch to finish what
+				UpdateBounds() would have done.
+			WriteSnapshot(float interpolation, FrameSnapshotClass::Entry&)
+				Use on the simulating thread to write the world matrix this
+				GameObject is drawn with, lerped by the interpolation alpha between
+				the previous and current step state, along with its bounds, whether
+				its model has streamed in and its triangles if it is an occluder.
+
+			Frame(float deltaTime)
+				Use once per simulation step to advance this GameObject by
+				deltaTime seconds. Does nothing unless overridden.
+			SaveState()
+				Use at the start of each simulation step to keep the current
+				transform, scale and rotation to interpolate from.
+			GetAnimationTime()
+				Use to get the time the shader animation of this GameObject has
+				reached. Returns 0 unless overridden.
+
 			==================== PROTECTED ====================
+			IsModelReady()
+				Returns whether the base model is ready to draw.
+				Override in derived classes that use other Model Types.
+			RefreshBounds()
+				Copies the min and max points of the base model once it is ready.
+				Override in derived classes that use other Model Types.
+			CopyBounds(XMFLOAT3* min, XMFLOAT3* max)
+				Used by RefreshBounds() to copy a min and max point into this
+				GameObject and rebuild its BoundingBox.
 
 			=====================================================================
 			==================== DEPRECATED =====================================
@@ -95,11 +176,10 @@ Methods:	==================== PURE VIRTUAL ====================
 			==================== DEPRECATED =====================================
 			=====================================================================
 
-			XMMATRIX* CalcWorldMatrix(XMMATRIX &initialWorldMatrix)
-				Uses a reference to an initial world matrix to produce a resultant
-					world matrix using the scaling, rotation and transformation data
-					of this model.
-				Used by Render during the positioning stage.
+			XMMATRIX CalcWorldMatrix(float interpolation)
+				Produces a world matrix from the scaling, rotation and
+					transformation data of this model, blended from the saved state.
+				Used by UpdateBounds() and WriteSnapshot().
 
 			ModelClass* GetModel()
 				Returns a pointer to the Model Used by this GameObject.
@@ -110,12 +190,23 @@ Methods:	==================== PURE VIRTUAL ====================
 				Used by constructor 2 to perform basic setup on the gameObject.
 				Hide-Override this function in derived classes for use with other
 					Model Types.
+				Uses unit placeholder bounds until the base model is ready.
 
 Members:	==================== PROTECTED ====================
 			ModelClass* m_baseModel
 				a pointer to the baseModel data used for this GameObject.
 			BoundingBox* m_AABB
 				a pointer to the bounding box used for this gameobject.
+			BoundingOrientedBox m_OBB
+				the bounds of the base model turned with the gameobject, rebuilt
+				alongside m_AABB, which can be far larger once it is rotated.
+			bool m_rotated
+				whether the gameobject was rotated when m_OBB was last built.
+			unsigned int m_boundsVersion
+				the number of times m_AABB has been rebuilt.
+			bool m_occluder
+				whether the base model's triangles are drawn into the occlusion
+				culler's depth buffer to hide what is behind them.
 
 			XMFLOAT3* m_transform
 				an XMFLOAT3 keeping track of the current position of the
@@ -123,9 +214,10 @@ Members:	==================== PROTECTED ====================
 			XMFLOAT3* m_scale
 				an XMFLOAT3 keeping track of the current scale of the
 				gameObject.
-			XMFLOAT3* m_rotation
-				an XMFLOAT3 keeping track of the current rotation of
-				the gameObject.
+			XMFLOAT4* m_orientation
+				a unit quaternion keeping track of the current rotation
+				of the gameObject. Euler angles given to setRotation() and
+				addRotation() are turned into it there and never kept.
 
 			XMFLOAT3* m_min
 				an XMFLOAT3 object to represent the minimum point of
@@ -133,12 +225,34 @@ Members:	==================== PROTECTED ====================
 			XMFLOAT3* m_max
 				an XMFLOAT3 object to represent the maximum point of
 				this gameOBject's base model.
+
+			bool m_boundsPending
+				whether m_min and m_max still hold placeholder bounds
+				because the base model has not finished streaming in.
+
+			XMFLOAT4X4 m_worldMatrix
+				the world matrix of the current state, built by UpdateBounds().
+			bool m_dirty
+				whether the transform, scale, rotation or bounds have changed
+				since the world matrix was last built.
+
+			XMFLOAT3 m_prevTransform, m_prevScale
+				the transform and scale at the start of the current
+				simulation step.
+			XMFLOAT4 m_prevOrientation
+				the orientation at the start of the current simulation step.
+			bool m_hasPrevState
+				whether SaveState() has been called yet. Until it has the
+				current state is drawn as it is.
+			bool m_movedThisStep
+				whether the world matrix has been rebuilt since SaveState(),
+				so frames need to interpolate it.
 C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
 class GameObject
 {
 public:
-	virtual bool Render(ShaderManagerClass* shaderManager, ID3D11DeviceContext* device,
-		XMMATRIX &worldMatrix, const XMMATRIX &viewMatrix, const XMMATRIX &projectionMatrix) = 0;
+	virtual bool Render(ShaderManagerClass* shaderManager, RenderContext* device,
+		XMMATRIX &worldMatrix, const XMMATRIX &viewProjectionMatrix, float animationTime) = 0;
 public:
 	GameObject();
 	~GameObject();
@@ -146,41 +260,81 @@ public:
 
 	bool setScale(float x, float y, float z);
 	bool setRotation(float x, float y, float z);
+	bool setRotation(FXMVECTOR orientation);
 	bool setTransform(float x, float y, float z);
 
 	bool addRotation(float x, float y, float z);
+	bool addRotation(FXMVECTOR rotation);
 	bool addTransform(float x, float y, float z);
 
 	BoundingBox* GetAABB();
-	void RenderAABB(ShaderManagerClass* shaderManager, D3DClass* d3d, CameraClass* cam);
+	BoundingOrientedBox* GetOBB();
+	unsigned int GetBoundsVersion();
+	XMMATRIX GetWorldMatrix();
+	virtual MeshBVHClass* GetMeshBVH();
+	void SetOccluder(bool occluder);
+	bool IsOccluder();
+	static void RenderAABB(const BoundingBox& bounds, ModelClass* boxModel, ShaderManagerClass* shaderManager, D3DClass* d3d, CameraClass* cam);
 
 	XMFLOAT3* GetPosition();
 
-	
+	bool CheckModelReady();
+	bool HasBounds();
+	static void RenderPlaceholder(const BoundingBox& bounds, ModelClass* boxModel, ShaderManagerClass* shaderManager, D3DClass* d3d, CameraClass* cam);
+	virtual void RequestTextureDetail(float screenPixels);
+	void UpdateBounds();
+	bool NeedsBoundsUpdate();
+	void WriteTransform(TransformBatchClass* batch, int index);
+	void ApplyWorldMatrix(const XMFLOAT4X4& worldMatrix);
+	void WriteSnapshot(float interpolation, FrameSnapshotClass::Entry& entry);
+
+	virtual void Frame(float deltaTime);
+	void SaveState();
+	virtual float GetAnimationTime();
+
 
 protected:
 	void UpdateScale(float prevX, float prevY, float prevZ);
 	void UpdateRotation(float prevX, float prevY, float prevZ);
 	void UpdateTransform(float prevX, float prevY, float prevZ);
 
-	XMMATRIX* CalcWorldMatrix(XMMATRIX &initialWorldMatrix);
+	XMMATRIX CalcWorldMatrix(float interpolation);
 
 	ModelClass* GetModel();
 
 	void Setup(ModelClass* baseModel);
 
+	virtual bool IsModelReady();
+	virtual void RefreshBounds();
+	void CopyBounds(XMFLOAT3* min, XMFLOAT3* max);
+
 protected:
 	ModelClass * m_baseModel;
 
 	BoundingBox* m_AABB;
+	BoundingOrientedBox m_OBB;
+	bool m_rotated;
+	unsigned int m_boundsVersion;
+	bool m_occluder;
 
 	XMFLOAT3* m_transform;
 	XMFLOAT3* m_scale;
-	XMFLOAT3* m_rotation;
+	XMFLOAT4* m_orientation;
 
 protected:
 	XMFLOAT3* m_min;
 	XMFLOAT3* m_max;
+
+	bool m_boundsPending;
+
+	XMFLOAT4X4 m_worldMatrix;
+	bool m_dirty;
+
+	XMFLOAT3 m_prevTransform;
+	XMFLOAT3 m_prevScale;
+	XMFLOAT4 m_prevOrientation;
+	bool m_hasPrevState;
+	bool m_movedThisStep;
 };
 
 #endif
@@ -8,6 +8,22 @@
 //===============================================
 const int MAX_PROJECTILE_DISTANCE_FROM_00 = 1000;
 
+//The fewest objects worth handing to a job when updating every object.
+const int OBJECT_JOB_BATCH_SIZE = 64;
+
+//The fewest projectiles worth handing to a job when colliding, each one
+//is tested against every static and dynamic object.
+const int COLLISION_JOB_BATCH_SIZE = 4;
+
+//The size of a cell of the collision grid until SetBroadPhase() is given
+//another, about the size of the objects in the scene.
+const float DEFAULT_GRID_CELL_SIZE = 4.0f;
+
+//The size of the occlusion culler's depth buffer, coarse enough to fill on
+//the CPU every frame.
+const int OCCLUSION_BUFFER_WIDTH = 256;
+const int OCCLUSION_BUFFER_HEIGHT = 128;
+
 //===============================================
 //			   User Defined Headers.
 //===============================================
@@ -15,6 +31,10 @@ const int MAX_PROJECTILE_DISTANCE_FROM_00 = 1000;
 #include "cameraclass.h"
 #include "ProjectileObject.h"
 #include "CollisionClass.h"
+#include "ProfilerClass.h"
+#include "GpuProfilerClass.h"
+#include "JobSystemClass.h"
+#include "FrameArenaClass.h"
 
 
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -22,7 +42,11 @@ Method:		GameObjectManager()
 
 Summary:	The default constructor for a gameObjectManager object.
 
-Modifies:	[m_StaticList, m_DynamicList, m_BulletList].
+Modifies:	[m_StaticList, m_DynamicList, m_BulletList, m_JobSystem,
+				m_BoundsModel, m_HashGrid, m_StaticTree, m_OcclusionCuller,
+				m_collisionMode, m_broadPhase, m_collisionChecks, m_obbRejections,
+				m_pendingHits, m_pendingCulls, m_occlusionCulling,
+				m_occludedObjects, m_TransformBatch, m_batchedTransforms].
 
 Returns:	GameObjectManager
 				the newly created GameObjectManager object.
@@ -32,6 +56,23 @@ GameObjectManager::GameObjectManager()
 	m_StaticList = new std::vector<GameObject*>();
 	m_DynamicList = new std::vector<GameObject*>();
 	m_BulletList = new vector<ProjectileObject*>();
+	m_JobSystem = 0;
+	m_BoundsModel = 0;
+	m_HashGrid = new SpatialHashGridClass;
+	m_HashGrid->Initialize(DEFAULT_GRID_CELL_SIZE);
+	m_StaticTree = new SceneBVHClass;
+	m_OcclusionCuller = new OcclusionCullerClass;
+	m_OcclusionCuller->Initialize(OCCLUSION_BUFFER_WIDTH, OCCLUSION_BUFFER_HEIGHT);
+	m_TransformBatch = new TransformBatchClass;
+	m_collisionMode = COLLISIONMODE_OBB;
+	m_broadPhase = BROADPHASE_STATICTREE;
+	m_collisionChecks = 0;
+	m_obbRejections = 0;
+	m_pendingHits = 0;
+	m_pendingCulls = 0;
+	m_occlusionCulling = true;
+	m_occludedObjects = 0;
+	m_batchedTransforms = true;
 }
 
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -50,15 +91,157 @@ Method:		Shutdown()
 
 Summary:	Call before deletion to ensure memory is freed.
 
-Modifies:	[m_StaticList, m_DynamicList, m_BulletList].
+Modifies:	[m_StaticList, m_DynamicList, m_BulletList, m_BoundsModel, m_HashGrid,
+				m_StaticTree, m_OcclusionCuller, m_TransformBatch].
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 void GameObjectManager::Shutdown()
 {
+	if (m_BoundsModel)
+	{
+		m_BoundsModel->Shutdown();
+		delete m_BoundsModel;
+		m_BoundsModel = 0;
+	}
+
+	if (m_HashGrid)
+	{
+		m_HashGrid->Shutdown();
+		delete m_HashGrid;
+		m_HashGrid = 0;
+	}
+
+	if (m_StaticTree)
+	{
+		m_StaticTree->Shutdown();
+		delete m_StaticTree;
+		m_StaticTree = 0;
+	}
+
+	if (m_OcclusionCuller)
+	{
+		m_OcclusionCuller->Shutdown();
+		delete m_OcclusionCuller;
+		m_OcclusionCuller = 0;
+	}
+
+	if (m_TransformBatch)
+	{
+		m_TransformBatch->Shutdown();
+		delete m_TransformBatch;
+		m_TransformBatch = 0;
+	}
+
 	delete m_StaticList;
 	delete m_DynamicList;
 	delete m_BulletList;
 }
 
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		SetJobSystem
+
+Summary:	Sets the job system the update loops are spread across.
+			Without one every loop runs on the calling thread.
+
+Args:		JobSystemClass* jobSystem
+				the job system to use, or 0.
+
+Modifies:	[m_JobSystem].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void GameObjectManager::SetJobSystem(JobSystemClass* jobSystem)
+{
+	m_JobSystem = jobSystem;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		SetCollisionMode
+
+Summary:	Sets the bounds projectiles are collided against. With
+			COLLISIONMODE_AABB anything whose AABB a projectile overlaps
+			is hit, which for a rotated object includes a good deal of
+			empty space around it.
+
+Args:		CollisionMode collisionMode
+				the mode to collide with.
+
+Modifies:	[m_collisionMode].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void GameObjectManager::SetCollisionMode(CollisionMode collisionMode)
+{
+	m_collisionMode = collisionMode;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		SetBroadPhase
+
+Summary:	Sets how each projectile finds the objects to test. With
+			BROADPHASE_BRUTEFORCE it tests every static and dynamic object.
+			With BROADPHASE_HASHGRID they are sorted into a spatial hash
+			grid every step, and it only tests those sharing a cell with it,
+			which pays off once there are hundreds of projectiles.
+			With BROADPHASE_STATICTREE, the default, only the dynamic
+			objects are sorted into the grid, and the static ones are found
+			through a bounding volume hierarchy only rebuilt when they
+			change. Whichever is used, the same object is hit.
+
+Args:		BroadPhase broadPhase
+				the broad phase to use.
+			float cellSize
+				the size of a grid cell, in world units, best about the size
+				of the objects. Unused by BROADPHASE_BRUTEFORCE.
+
+Modifies:	[m_broadPhase, m_HashGrid].
+
+Returns:	bool
+				was the grid set up, if one is used.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool GameObjectManager::SetBroadPhase(BroadPhase broadPhase, float cellSize)
+{
+	m_broadPhase = broadPhase;
+	if (broadPhase == BROADPHASE_BRUTEFORCE)
+		return true;
+
+	if (!m_HashGrid->Initialize(cellSize))
+	{
+		m_broadPhase = BROADPHASE_BRUTEFORCE;
+		return false;
+	}
+
+	return true;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		SetOcclusionCulling
+
+Summary:	Sets whether RenderAll() skips objects hidden behind the
+			GameObjects marked as occluders.
+
+Args:		bool occlusionCulling
+				whether to cull hidden objects.
+
+Modifies:	[m_occlusionCulling].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void GameObjectManager::SetOcclusionCulling(bool occlusionCulling)
+{
+	m_occlusionCulling = occlusionCulling;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		SetBatchedTransforms
+
+Summary:	Sets whether Update() builds the world matrices of the objects
+			that moved four at a time in a TransformBatchClass, or one
+			object at a time. Both give the same matrices.
+
+Args:		bool batchedTransforms
+				whether to build them in batches.
+
+Modifies:	[m_batchedTransforms].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void GameObjectManager::SetBatchedTransforms(bool batchedTransforms)
+{
+	m_batchedTransforms = batchedTransforms;
+}
+
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
 Method:		AddItem
 
@@ -115,18 +298,18 @@ Args:		GameObject* projectile
 				a pointer to the gameObject to add.
 			XMFLOAT3* position
 				the x y z in world space to spawn the gameObject at.
-			XMFLOAT3* rotation
-				the x y z rotation in local space in radians to spawn
-				the gameObject at.
+			XMFLOAT4* orientation
+				the orientation as a quaternion to spawn the gameObject at,
+				such as the camera's.
 
 Modifies:	[none].
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-void GameObjectManager::AddProjectile(ProjectileObject * projectile, XMFLOAT3* position, XMFLOAT3* rotation)
+void GameObjectManager::AddProjectile(ProjectileObject * projectile, XMFLOAT3* position, XMFLOAT4* orientation)
 {
 	//Set initial properties of the projectile.
 	projectile->setTransform(position->x, position->y, position->z);
 	projectile->setScale(0.5f, 0.5f, 0.5f);
-	projectile->setRotation(rotation->x / 0.0174532925f, rotation->y / 0.0174532925f, rotation->z / 0.0174532925f);
+	projectile->setRotation(XMLoadFloat4(orientation));
 
 	//Push the reference to the projectile back onto the projectile list.
 	m_BulletList->push_back(projectile);
@@ -202,116 +385,409 @@ void GameObjectManager::Delete(GameObject * obj)
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
 Method:		Render
 
-Summary:	Use to render all objects within the scope of the GameObjectManager.
-			Renders them with their AABBs right now as well.
-
-Args:		ShaderManagerClass* shaderManager
+Summary:	Use to render all objects in the front buffer of a snapshot.
+			Renders their AABBs afterwards in a separate pass.
+			Objects whose model had not streamed in when the snapshot was
+			written are drawn as their placeholder bounds instead, and
+			objects hidden behind occluders or outside the camera's
+			frustum are not drawn at all.
+			Only submits draws from the snapshot, never reading where the
+			objects are now, so the next frame can be simulated meanwhile.
+
+Args:		FrameSnapshotClass* snapshot
+				the snapshot whose front buffer is drawn.
+			ShaderManagerClass* shaderManager
 				a pointer to the ShaderManagerClass object that is being
 				used to render the models.
 			D3DClass* d3d
 				a pointer to the d3d class containing the device context.
 			CameraClass* cam
-				A pointer to the camera object being used.
-			XMMATRIX &viewMatrix
-				a reference to an XMMATRIX representing the view of the
-				current user.
-			XMMATRIX &projectionMatrix
-				a reference to an XMMATRIX representing the projection
-				of the current camera.
+				A pointer to the camera object being used, already rendered
+				so its cached matrices are those of this frame.
+			TextureAtlasClass* atlas
+				the atlas holding the texture the AABBs are drawn with.
 
-Modifies:	[none].
+Modifies:	[m_BoundsModel, m_OcclusionCuller, m_occludedObjects].
 
 Returns:	bool	
 				was the rendering of every object successful.
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-bool GameObjectManager::RenderAll(ShaderManagerClass* shaderManager, D3DClass* d3d, CameraClass* cam, XMMATRIX &viewMatrix, XMMATRIX &projectionMatrix, TextClassA* text)
+bool GameObjectManager::RenderAll(FrameSnapshotClass* snapshot, ShaderManagerClass* shaderManager, D3DClass* d3d, CameraClass* cam, TextureAtlasClass* atlas)
 {
+	const std::vector<FrameSnapshotClass::Entry>& entries = snapshot->GetFront();
+
 	//Temporary storage for the worldMatrix.
-	XMMATRIX worldMatrix;
+	XMMATRIX initialWorldMatrix, worldMatrix;
 	bool result = true;
 
-	//If there is at least one element in the m_StaticList.
-	if (m_StaticList->size() != 0)
+	//Obtain the initial worldMatrix from the D3Dclass.
+	d3d->GetWorldMatrix(initialWorldMatrix);
+
+	//Take the matrices the camera cached, so the view and projection are multiplied once a frame rather than per vertex.
+	XMMATRIX viewProjectionMatrix, projectionMatrix;
+	cam->GetViewProjectionMatrix(viewProjectionMatrix);
+	cam->GetProjectionMatrix(projectionMatrix);
+	const BoundingFrustum& frustum = cam->GetFrustum();
+
+	//Find what the occluders hide before submitting anything.
+	FrameVector<char> occluded(entries.size(), 0);
 	{
-		//Iterate through the list.
-		for (std::vector<GameObject*>::iterator iter = m_StaticList->begin();
-			iter != m_StaticList->end();
+		PROFILE_ZONE("Occlusion culling");
+		FindOccluded(entries, viewProjectionMatrix, occluded);
+	}
+
+	//Draw the models, timing them on the GPU as one pass.
+	{
+		PROFILE_GPU_ZONE(d3d->GetGpuProfiler(), "GPU Scene");
+
+		for (std::vector<FrameSnapshotClass::Entry>::const_iterator iter = entries.begin();
+			iter != entries.end();
 			iter++)
 		{
-			//Dereference the iterator.
-			GameObject* a = *iter;
+			if (occluded[iter - entries.begin()])
+				continue;
 
-			//Obtain the worldMatrix from the D3Dclass.
-			d3d->GetWorldMatrix(worldMatrix);
+			//Skip anything outside the camera's cached frustum.
+			if (!frustum.Intersects(iter->bounds))
+				continue;
 
-			//Render the model.
-			result = a->Render(shaderManager, d3d->GetDeviceContext(), worldMatrix, viewMatrix, projectionMatrix);
+			//Draw placeholder bounds until the model has streamed in.
+			if (!iter->visible)
+			{
+				GameObject::RenderPlaceholder(iter->bounds, GetBoundsModel(d3d, atlas), shaderManager, d3d, cam);
+				continue;
+			}
+
+			//Render the model with the matrix it was snapshotted with.
+			worldMatrix = XMMatrixMultiply(initialWorldMatrix, XMLoadFloat4x4(&iter->worldMatrix));
+			result = iter->object->Render(shaderManager, d3d->GetRenderContext(), worldMatrix, viewProjectionMatrix, iter->animationTime);
 			if (!result)
 				return false;
 
-			//Render the model's AABB.
-			a->RenderAABB(shaderManager, d3d, cam);
+			//Request texture detail for the size the model was drawn at.
+			iter->object->RequestTextureDetail(ScreenSize(iter->bounds, cam, d3d, projectionMatrix));
 		}
 	}
 
-	//If the m_DynamicList has at least one item,
-	if (m_DynamicList->size() != 0)
+	//Draw the AABBs of the models drawn above as their own pass.
 	{
-		//Iterate through the list,
-		for (std::vector<GameObject*>::iterator iter = m_DynamicList->begin();
-			iter != m_DynamicList->end();
-			iter++)
-		{
-			//Dereference the iterator.
-			GameObject* a = *iter;
+		PROFILE_GPU_ZONE(d3d->GetGpuProfiler(), "GPU AABB debug");
+		RenderAABBs(entries, occluded, shaderManager, d3d, cam, atlas);
+	}
 
-			//Get the worldMatrix using the D3D class.
-			d3d->GetWorldMatrix(worldMatrix);
+	return true;
+}
 
-			//Render the model
-			result = a->Render(shaderManager, d3d->GetDeviceContext(), worldMatrix, viewMatrix, projectionMatrix);
-			if (!result)
-				return false;
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		FindOccluded
+
+Summary:	Draws the triangles of every occluder in a snapshot into the
+			occlusion culler's depth buffer, then marks every entry whose
+			AABB is wholly hidden behind them, or off screen. Nothing is
+			marked while occlusion culling is off or no occluder is drawn.
+			Reads nothing but the snapshot, so can run while the next frame
+			is simulated.
+
+Args:		const std::vector<FrameSnapshotClass::Entry>& entries
+				the snapshot entries to cull.
+			const XMMATRIX &viewProjectionMatrix
+				the view and projection matrices of the camera combined.
+			FrameVector<char>& occluded
+				one flag for each entry, set to 1 if it is hidden.
+
+Modifies:	[m_OcclusionCuller, m_occludedObjects].
+
+Returns:	int
+				the number of entries marked as hidden.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+int GameObjectManager::FindOccluded(const std::vector<FrameSnapshotClass::Entry>& entries, const XMMATRIX &viewProjectionMatrix, FrameVector<char>& occluded)
+{
+	if (!m_occlusionCulling)
+		return 0;
 
-			//Render the model's AABB.
-			a->RenderAABB(shaderManager, d3d, cam);
-		}
+	//Draw the occluders where they were snapshotted.
+	m_OcclusionCuller->Clear(viewProjectionMatrix);
+	for (size_t i = 0; i < entries.size(); i++)
+	{
+		if (entries[i].occluder)
+			m_OcclusionCuller->DrawOccluder(entries[i].occluder, XMLoadFloat4x4(&entries[i].worldMatrix));
 	}
 
-	//If the bullet list has at least one item.
-	if (m_BulletList->size() != 0)
+	if (m_OcclusionCuller->GetTrianglesDrawn() == 0)
+		return 0;
+
+	//Test every entry's AABB, occluders included, as one can hide another.
+	int count = 0;
+	for (size_t i = 0; i < entries.size(); i++)
 	{
-		//Cull the projectileList for any projectiles too far away.
-		CullProjectiles(text, d3d);
+		if (m_OcclusionCuller->IsVisible(entries[i].bounds))
+			continue;
 
-		//Iterate through the list.
-		for (vector<ProjectileObject*>::iterator iter = m_BulletList->begin();
-			iter != m_BulletList->end();
-			iter++)
-		{
-			//Dereference the iterator.
-			ProjectileObject* a = *iter;
+		occluded[i] = 1;
+		count++;
+	}
 
-			//Advance the projectileObjects.
-			a->Frame();
+	m_occludedObjects += count;
+	return count;
+}
 
-			//Get the world matrix using the d3d class.
-			d3d->GetWorldMatrix(worldMatrix);
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		WriteSnapshot
+
+Summary:	Writes the matrix every object is drawn with, interpolated
+			through the current simulation step, along with its bounds
+			and visibility, into the back buffer of a snapshot in parallel.
+			Call once per frame after the simulation steps, on the same
+			thread that ran them.
+
+Args:		float interpolation
+				how far through the current simulation step the frame is,
+				from 0 to 1.
+			int frame
+				the number of the frame the snapshot is drawn in.
+			FrameSnapshotClass* snapshot
+				the snapshot to write.
 
-			//render the model.
-			result = a->Render(shaderManager, d3d->GetDeviceContext(), worldMatrix, viewMatrix, projectionMatrix);
-			if (!result)
-				return false;
+Modifies:	[m_StaticList, m_DynamicList, m_BulletList].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void GameObjectManager::WriteSnapshot(float interpolation, int frame, FrameSnapshotClass* snapshot)
+{
+	int staticCount = (int)m_StaticList->size();
+	int dynamicCount = (int)m_DynamicList->size();
+	int count = staticCount + dynamicCount + (int)m_BulletList->size();
 
-			//render the model's aabb
-			a->RenderAABB(shaderManager, d3d, cam);
-		}
+	std::vector<FrameSnapshotClass::Entry>& entries = snapshot->BeginWrite(frame);
+	entries.resize(count);
+
+	//Each object only writes its own entry.
+	ParallelFor(count, OBJECT_JOB_BATCH_SIZE, [&](int begin, int end)
+	{
+		for (int i = begin; i < end; i++)
+			ObjectAt(i, staticCount, dynamicCount)->WriteSnapshot(interpolation, entries[i]);
+	});
+
+	snapshot->EndWrite();
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		BeginStep
+
+Summary:	Saves the state of every object at the start of a simulation
+			step, so frames drawn before the next step can interpolate
+			from it. Call before anything moves an object in the step.
+
+Modifies:	[m_StaticList, m_DynamicList, m_BulletList].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void GameObjectManager::BeginStep()
+{
+	ForEachObject([](GameObject* object) { object->SaveState(); });
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Update
+
+Summary:	Runs one fixed simulation step without drawing anything.
+			Culls far projectiles, advances every object, rebuilds the
+			world matrix and AABB of every object that moved and runs the
+			collision loop. Each stage is spread across the job system if
+			one is set.
+
+Args:		float deltaTime
+				the length of the step, in seconds.
+
+Modifies:	[m_BulletList, m_StaticList, m_DynamicList, m_TransformBatch,
+				m_transformObjects].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void GameObjectManager::Update(float deltaTime)
+{
+	//Cull the projectileList for any projectiles too far away.
+	{
+		PROFILE_ZONE("CullProjectiles");
+		CullProjectiles();
+	}
+
+	//Advance every object by the step.
+	{
+		PROFILE_ZONE("FrameObjects");
+		ForEachObject([deltaTime](GameObject* object) { object->Frame(deltaTime); });
+	}
+
+	//Rebuild the world matrix and AABB of everything that moved.
+	{
+		PROFILE_ZONE("UpdateBounds");
+		UpdateAllBounds();
 	}
 
 	//Perform collision Loop here for all AABBs
-	AABBCollisionLoop(text, d3d);
+	PROFILE_ZONE("AABBCollisionLoop");
+	AABBCollisionLoop();
+}
 
-	return true;
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		TakeScoreEvents
+
+Summary:	Collects the projectile hits and culls recorded by Update()
+			since the last call, so the score text can be changed on the
+			thread that draws it rather than the one simulating.
+
+Args:		int& hits
+				set to the objects destroyed by projectiles.
+			int& culls
+				set to the projectiles culled for flying too far.
+
+Modifies:	[m_pendingHits, m_pendingCulls].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void GameObjectManager::TakeScoreEvents(int& hits, int& culls)
+{
+	hits = m_pendingHits;
+	culls = m_pendingCulls;
+	m_pendingHits = 0;
+	m_pendingCulls = 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetCollisionChecks
+
+Summary:	Gets the number of AABB pair tests run by the collision loop.
+
+Modifies:	[none].
+
+Returns:	long long
+				the number of tests run since the GameObjectManager was created.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+long long GameObjectManager::GetCollisionChecks()
+{
+	return m_collisionChecks;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetOBBRejections
+
+Summary:	Gets the number of pair tests whose AABBs overlapped but whose
+			oriented boxes did not, each a hit the AABBs alone would have
+			wrongly counted. Always 0 in COLLISIONMODE_AABB.
+
+Modifies:	[none].
+
+Returns:	long long
+				the number of rejections since the GameObjectManager was created.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+long long GameObjectManager::GetOBBRejections()
+{
+	return m_obbRejections;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetOccludedObjects
+
+Summary:	Gets the number of snapshot entries FindOccluded() has found
+			hidden, and so were never submitted.
+
+Modifies:	[none].
+
+Returns:	long long
+				the number of entries culled since the GameObjectManager was
+				created.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+long long GameObjectManager::GetOccludedObjects()
+{
+	return m_occludedObjects;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetOcclusionCuller
+
+Summary:	Gets the occlusion culler, holding the depth buffer drawn by the
+			last call to FindOccluded().
+
+Modifies:	[none].
+
+Returns:	OcclusionCullerClass*
+				the occlusion culler.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+OcclusionCullerClass* GameObjectManager::GetOcclusionCuller()
+{
+	return m_OcclusionCuller;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetStaticTree
+
+Summary:	Gets the bounding volume hierarchy over the AABBs of the static
+			objects, rebuilding it first if they have changed since it was
+			last built. Box i of it is the ith static object.
+
+Modifies:	[m_StaticTree, m_staticTreeObjects, m_staticTreeVersions].
+
+Returns:	SceneBVHClass*
+				the hierarchy, valid until a static object next changes.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+SceneBVHClass* GameObjectManager::GetStaticTree()
+{
+	UpdateStaticTree();
+	return m_StaticTree;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RenderAABBs
+
+Summary:	Renders the AABB of every snapshotted object whose model had
+			streamed in and that was not occluded. Objects still streaming
+			are already drawn as their placeholder.
+
+Args:		const std::vector<FrameSnapshotClass::Entry>& entries
+				the front buffer of the snapshot being drawn.
+			const FrameVector<char>& occluded
+				whether each entry was hidden behind an occluder.
+			ShaderManagerClass* shaderManager
+				a pointer to the ShaderManagerClass object used to render.
+			D3DClass* d3d
+				a pointer to the d3d class containing the device context.
+			CameraClass* cam
+				A pointer to the camera object being used.
+			TextureAtlasClass* atlas
+				the atlas holding the texture the AABBs are drawn with.
+
+Modifies:	[m_BoundsModel].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void GameObjectManager::RenderAABBs(const std::vector<FrameSnapshotClass::Entry>& entries, const FrameVector<char>& occluded, ShaderManagerClass* shaderManager, D3DClass* d3d, CameraClass* cam, TextureAtlasClass* atlas)
+{
+	//Render the AABBs of every object drawn.
+	for (std::vector<FrameSnapshotClass::Entry>::const_iterator iter = entries.begin();
+		iter != entries.end();
+		iter++)
+	{
+		if (iter->visible && !occluded[iter - entries.begin()])
+			GameObject::RenderAABB(iter->bounds, GetBoundsModel(d3d, atlas), shaderManager, d3d, cam);
+	}
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetBoundsModel
+
+Summary:	Gets the unit box model every AABB and placeholder is drawn with,
+			building it the first time it is needed.
+
+Args:		D3DClass* d3d
+				a pointer to the d3d class containing the device.
+			TextureAtlasClass* atlas
+				the atlas holding the texture the box is drawn with.
+
+Modifies:	[m_BoundsModel].
+
+Returns:	ModelClass*
+				a box model with a center of 0 and extents of 1.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+ModelClass* GameObjectManager::GetBoundsModel(D3DClass* d3d, TextureAtlasClass* atlas)
+{
+	if (!m_BoundsModel)
+	{
+		BoundingBox unitBox(XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT3(1.0f, 1.0f, 1.0f));
+		m_BoundsModel = new ModelClass();
+		m_BoundsModel->Initialize(d3d->GetDevice(), &unitBox, atlas);
+	}
+
+	return m_BoundsModel;
 }
 
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -396,53 +872,46 @@ Method:		CullProjectiles.
 Summary:	Uses the MAX_PROJECTILE_DISTANCE_FROM_00 to look through the
 			bulletList and destroy any particles deemed to be over the
 			max distance away.
+			The distances are measured in parallel, the list is then
+			compacted on the calling thread.
 
-Modifies:	[m_BulletList].
+Modifies:	[m_BulletList, m_pendingCulls].
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-void GameObjectManager::CullProjectiles(TextClassA* text, D3DClass* d3d)
+void GameObjectManager::CullProjectiles()
 {
-	//Storage for the indices that need to be removed from the list.
-	vector<int> indices;
-
-	//i = the current index.
-	int i = 0;
+	//Storage for whether each projectile needs to be removed from the list, taken from the frame arena.
+	int count = (int)m_BulletList->size();
+	FrameVector<char> cull(count, 0);
 
-	//Iterate over the projectile list.
-	for (vector<ProjectileObject*>::iterator iter = m_BulletList->begin();
-		iter != m_BulletList->end();
-		iter++)
+	//Check each projectile's distance from the origin.
+	ParallelFor(count, OBJECT_JOB_BATCH_SIZE, [this, &cull](int begin, int end)
 	{
-		//Dereference the iterator.
-		ProjectileObject* a = *iter;
+		for (int i = begin; i < end; i++)
+		{
+			//Create an XMVECTOR to store the position of the object.
+			XMFLOAT3* position = (*m_BulletList)[i]->GetPosition();
 
-		//Create an XMVECTOR to store the position of the object.
-		XMVECTOR position;
-		position = XMVectorSet(a->GetPosition()->x, a->GetPosition()->y, a->GetPosition()->z, 1.0f);
+			//Use the length of the vector est.
+			XMVECTOR length = XMVector3LengthEst(XMVectorSet(position->x, position->y, position->z, 1.0f));
 
-		//Use the position vector to store the length of the vector est.
-		position = XMVector3LengthEst(position);
+			//If the length by estimate is greater than the maximum length from the origin, mark it.
+			cull[i] = XMVectorGetX(length) > MAX_PROJECTILE_DISTANCE_FROM_00;
+		}
+	});
 
-		//If the length by estimate is greater than the maximum length from the origin.
-		if (XMVectorGetByIndex(position, 0) > MAX_PROJECTILE_DISTANCE_FROM_00)
+	//Compact the list, keeping the order of the survivors.
+	int kept = 0;
+	for (int i = 0; i < count; i++)
+	{
+		if (!cull[i])
 		{
-			//Push the index number onto the indices vector,
-			indices.push_back(i);
+			(*m_BulletList)[kept++] = (*m_BulletList)[i];
+			continue;
 		}
 
-		//Increment the index being looked at.
-		i++;
-	}
-
-	//For each element in the indexes to remove.
-	for (int x = 0; x < indices.size(); x++)
-	{
-		//Erase the entry at the specified index, adjusted for the number of entries removed already.
-		//. start of list = begin()
-		//. increment by the index number.
-		//. x naturally equals no. entries removed already.
-		m_BulletList->erase(m_BulletList->begin() + indices.at(x) - x);
-		text->SetIntersection(false, d3d->GetDeviceContext(), 3);
+		m_pendingCulls++;
 	}
+	m_BulletList->resize(kept);
 }
 
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -450,122 +919,378 @@ Method:		AABBCollisionLoop
 
 Summary:	Checks every projectile against every static and dynamic
 			object for collision and handles this appropriately.
-
-Args		TextClassA* text
-				a reference to the score sentence
-			D3DClass* d3d
-				a reference to the d3d class
-
-Modifies:	[m_BulletList, m_StaticList, m_DynamicList].
+			Each projectile finds the first object it hits in parallel,
+			dynamic objects before static ones. AABBs are tested first,
+			then in COLLISIONMODE_OBB the oriented boxes of any pair that
+			overlaps and has a rotated object in it. Objects and
+			projectiles whose models are still streaming in only have
+			placeholder bounds, so they are skipped until they are ready.
+			With BROADPHASE_HASHGRID the objects are first sorted into the
+			grid, and each projectile only tests those sharing a cell with
+			it, keeping whichever hit comes first in the same order.
+			With BROADPHASE_STATICTREE only the dynamic objects go into the
+			grid, and a projectile that hits none of them tests the static
+			objects near it in the static hierarchy.
+			The hits are then resolved on the calling thread in list
+			order, so an object hit by several projectiles is only
+			removed once.
+
+Modifies:	[m_BulletList, m_StaticList, m_DynamicList, m_collisionChecks,
+				m_obbRejections, m_pendingHits].
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-void GameObjectManager::AABBCollisionLoop(TextClassA* text, D3DClass* d3d)
+void GameObjectManager::AABBCollisionLoop()
 {
-	//Keep a list of projectile, dynamic and static indices to cull.
-	vector<int> projInd, dynInd, statInd;
-
-	//Keep track of the projectile, dynamic and static indices.
-	int projI = 0;
-	int dynI = 0;
-	int statI = 0;
-
-	//Iterate through each projectile.
-	for (vector<ProjectileObject*>::iterator iter = m_BulletList->begin();
-		iter != m_BulletList->end();
-		iter++)
+	//What each projectile hit, if anything, and how many tests it took.
+	struct ProjectileHit
 	{
-		//Dereference the iterator.
-		ProjectileObject* proj = *iter;
+		std::vector<GameObject*>* list;
+		int index;
+		int checks;
+		int obbRejections;
+	};
+
+	int projectileCount = (int)m_BulletList->size();
+	FrameVector<ProjectileHit> hits(projectileCount);
+
+	//Number every target, dynamic objects first, in the order they are tested.
+	int dynamicCount = (int)m_DynamicList->size();
+	int targetCount = dynamicCount + (int)m_StaticList->size();
+
+	//Sort the targets into the grid by that number, only the dynamic ones if the static tree has the rest.
+	bool useTree = m_broadPhase == BROADPHASE_STATICTREE;
+	bool useGrid = m_broadPhase == BROADPHASE_HASHGRID || (useTree && dynamicCount > 0);
+	if (useGrid)
+	{
+		int gridCount = useTree ? dynamicCount : targetCount;
+		m_HashGrid->Clear();
+		for (int i = 0; i < gridCount; i++)
+			m_HashGrid->Add(*(i < dynamicCount ? (*m_DynamicList)[i] : (*m_StaticList)[i - dynamicCount])->GetAABB());
+		m_HashGrid->Build();
+	}
 
-		//Record no collision so far.
-		bool collisionFound = false;
+	if (useTree)
+		UpdateStaticTree();
 
-		//Reset the index stored to 0.
-		dynI = 0;
-		//Iterate through the dynamic list.
-		for (vector<GameObject*>::iterator dynIter = m_DynamicList->begin();
-			dynIter != m_DynamicList->end();
-			dynIter++)
+	//Find the first object each projectile collides with.
+	bool useOBBs = m_collisionMode == COLLISIONMODE_OBB;
+	ParallelFor(projectileCount, COLLISION_JOB_BATCH_SIZE, [this, &hits, useOBBs, useGrid, useTree, dynamicCount, targetCount](int begin, int end)
+	{
+		for (int i = begin; i < end; i++)
 		{
-			//Dereference the iterator.
-			GameObject* b = *dynIter;
-
-			//If the two collide, record and break.
-			if (CollisionClass::Intersects(proj->GetAABB(), b->GetAABB()))
+			GameObject* projectile = (*m_BulletList)[i];
+			BoundingBox* projectileBox = projectile->GetAABB();
+			ProjectileHit& hit = hits[i];
+			hit.list = nullptr;
+			hit.index = -1;
+			hit.checks = 0;
+			hit.obbRejections = 0;
+
+			//A projectile without its real bounds yet can't hit anything.
+			if (!projectile->HasBounds())
+				continue;
+
+			//Test a target, keeping it if it comes before the first hit so far.
+			int first = targetCount;
+			auto test = [&](int target)
 			{
-				//A collision has been recored.
-				collisionFound = true;
-
-				//Push back the indices of the respective elements onto the deletion vectors.
-				projInd.push_back(projI);
-				dynInd.push_back(dynI);
-
-				//The loop no longer needs to be continued.
-				break;
+				if (target >= first)
+					return;
+
+				//Skip objects whose bounds are still a placeholder box.
+				GameObject* object = target < dynamicCount ? (*m_DynamicList)[target] : (*m_StaticList)[target - dynamicCount];
+				if (!object->HasBounds())
+					return;
+
+				hit.checks++;
+				if (!CollisionClass::Intersects(projectileBox, object->GetAABB()))
+					return;
+
+				//Rotated objects only count once their oriented boxes overlap too.
+				if (useOBBs && !CollisionClass::Intersects(projectile, object))
+				{
+					hit.obbRejections++;
+					return;
+				}
+
+				first = target;
+			};
+
+			//Test only the targets near the projectile, or every one in turn until one is hit.
+			if (useGrid)
+				m_HashGrid->Query(*projectileBox, test);
+
+			//Any dynamic hit comes before every static object, so the tree is only needed without one.
+			if (useTree)
+			{
+				if (first == targetCount)
+					m_StaticTree->Query(*projectileBox, [&](int item) { test(dynamicCount + item); });
+			}
+			else if (!useGrid)
+			{
+				for (int target = 0; target < first; target++)
+					test(target);
 			}
 
-			//Increment the dynamicList index being looked at.
-			dynI++;
+			//Record the hit.
+			if (first < targetCount)
+			{
+				hit.list = first < dynamicCount ? m_DynamicList : m_StaticList;
+				hit.index = first < dynamicCount ? first : first - dynamicCount;
+			}
 		}
+	});
 
-		//If a collision has already been found, skip round the list again.
-		if (collisionFound)
+	//Mark everything to destroy, in projectile order, in lists taken from the frame arena.
+	FrameVector<char> removeProjectile(projectileCount, 0);
+	FrameVector<char> removeDynamic(m_DynamicList->size(), 0);
+	FrameVector<char> removeStatic(m_StaticList->size(), 0);
+	for (int i = 0; i < projectileCount; i++)
+	{
+		m_collisionChecks += hits[i].checks;
+		m_obbRejections += hits[i].obbRejections;
+		if (!hits[i].list)
 			continue;
 
-		//reset the index stored to 0.
-		statI = 0;
-		//Iterate through the static list.
-		for (vector<GameObject*>::iterator statIter = m_StaticList->begin();
-			statIter != m_StaticList->end();
-			statIter++)
-		{
-			//Dereference the iterator.
-			GameObject* b = *statIter;
+		removeProjectile[i] = 1;
 
-			//If the two collide, record and break.
-			if (CollisionClass::Intersects(proj->GetAABB(), b->GetAABB()))
-			{
-				//Push back the indices of the respective elements onto the deletion vectors.
-				projInd.push_back(projI);
-				statInd.push_back(statI);
+		FrameVector<char>& removeList = hits[i].list == m_DynamicList ? removeDynamic : removeStatic;
+		if (removeList[hits[i].index])
+			continue;
 
-				//The loop no longer needs to be continued.
-				break;
-			}
+		removeList[hits[i].index] = 1;
+		m_pendingHits++;
+	}
 
-			//Incremement the staticList index being looked at.
-			statI++;
-		}
+	//Perform destruction work on each of the lists, keeping the order of the survivors.
+	int kept = 0;
+	for (int i = 0; i < projectileCount; i++)
+	{
+		if (!removeProjectile[i])
+			(*m_BulletList)[kept++] = (*m_BulletList)[i];
+	}
+	m_BulletList->resize(kept);
+
+	kept = 0;
+	for (int i = 0; i < (int)removeDynamic.size(); i++)
+	{
+		if (!removeDynamic[i])
+			(*m_DynamicList)[kept++] = (*m_DynamicList)[i];
+	}
+	m_DynamicList->resize(kept);
 
-		//Increment the projectileList index being looked at.
-		projI++;
+	kept = 0;
+	for (int i = 0; i < (int)removeStatic.size(); i++)
+	{
+		if (!removeStatic[i])
+			(*m_StaticList)[kept++] = (*m_StaticList)[i];
 	}
+	m_StaticList->resize(kept);
+}
 
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		UpdateStaticTree
 
-	//Perform destruction work on each of the lists.
+Summary:	Rebuilds the static hierarchy if a static object has been added,
+			removed or reordered, or its AABB rebuilt, since it was last
+			built. Checking costs one pass over the static list, so the
+			hierarchy is only built again when the scene really changes.
+
+Modifies:	[m_StaticTree, m_staticTreeObjects, m_staticTreeVersions].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void GameObjectManager::UpdateStaticTree()
+{
+	int staticCount = (int)m_StaticList->size();
 
-	//For each element in the projectiles indices to remove.
-	for (int x = 0; x < projInd.size(); x++)
+	//Look for any change since the last build.
+	bool changed = staticCount != (int)m_staticTreeObjects.size();
+	for (int i = 0; i < staticCount && !changed; i++)
 	{
-		//Erase the entry at the specified index, adjusted for the number of entries removed already.
-		m_BulletList->erase(m_BulletList->begin() + projInd.at(x) - x);
+		GameObject* object = (*m_StaticList)[i];
+		changed = object != m_staticTreeObjects[i] || object->GetBoundsVersion() != m_staticTreeVersions[i];
 	}
 
-	//For each element in the indexes to remove.
-	for (int x = 0; x < dynInd.size(); x++)
+	if (!changed)
+		return;
+
+	//Build over every static object, box i being the ith object.
+	m_staticTreeObjects.resize(staticCount);
+	m_staticTreeVersions.resize(staticCount);
+	m_StaticTree->Clear();
+	for (int i = 0; i < staticCount; i++)
 	{
-		//Erase the entry at the specified index, adjusted for the number of entries removed already.
-		m_DynamicList->erase(m_DynamicList->begin() + dynInd.at(x) - x);
+		GameObject* object = (*m_StaticList)[i];
+		m_StaticTree->Add(*object->GetAABB());
+		m_staticTreeObjects[i] = object;
+		m_staticTreeVersions[i] = object->GetBoundsVersion();
+	}
+	m_StaticTree->Build();
+}
 
-		text->SetIntersection(true, d3d->GetDeviceContext(), 3);
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		UpdateAllBounds
+
+Summary:	Rebuilds the world matrix and AABB of every object that moved,
+			spread across the job system.
+			With batched transforms each job gathers the objects of its
+			range that moved into the same range of slots of the transform
+			batch, builds all of their matrices together, then hands each
+			back to its object. Jobs never share a slot.
+
+Modifies:	[m_StaticList, m_DynamicList, m_BulletList, m_TransformBatch,
+				m_transformObjects].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void GameObjectManager::UpdateAllBounds()
+{
+	if (!m_batchedTransforms)
+	{
+		ForEachObject([](GameObject* object) { object->UpdateBounds(); });
+		return;
 	}
 
-	//For each element in the indexes to remove.
-	for (int x = 0; x < statInd.size(); x++)
+	int staticCount = (int)m_StaticList->size();
+	int dynamicCount = (int)m_DynamicList->size();
+	int count = staticCount + dynamicCount + (int)m_BulletList->size();
+
+	m_TransformBatch->Resize(count);
+	if ((int)m_transformObjects.size() < count)
+		m_transformObjects.resize(count);
+
+	ParallelFor(count, OBJECT_JOB_BATCH_SIZE, [&](int begin, int end)
 	{
-		//Erase the entry at the specified index, adjusted for the number of entries removed already.
-		m_StaticList->erase(m_StaticList->begin() + statInd.at(x) - x);
+		//Pack the objects that moved to the front of this job's slots.
+		int last = begin;
+		for (int i = begin; i < end; i++)
+		{
+			GameObject* object = ObjectAt(i, staticCount, dynamicCount);
+			if (!object->NeedsBoundsUpdate())
+				continue;
+
+			object->WriteTransform(m_TransformBatch, last);
+			m_transformObjects[last++] = object;
+		}
 
-		text->SetIntersection(true, d3d->GetDeviceContext(), 3);
+		m_TransformBatch->Compose(begin, last);
+
+		for (int i = begin; i < last; i++)
+			m_transformObjects[i]->ApplyWorldMatrix(m_TransformBatch->GetWorldMatrix(i));
+	});
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		ParallelFor
+
+Summary:	Runs a function over the index range [0, count) split into
+			batches across the job system, and waits for every batch.
+			Without a job system the whole range runs on the calling thread.
+
+Args:		int count
+				the number of indices.
+			int minBatchSize
+				the fewest indices worth handing to a job.
+			const std::function<void(int, int)>& function
+				the work to run over each batch, given its begin and end.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void GameObjectManager::ParallelFor(int count, int minBatchSize, const std::function<void(int, int)>& function)
+{
+	if (!m_JobSystem)
+	{
+		if (count > 0)
+			function(0, count);
+		return;
 	}
 
+	JobCounter counter;
+	m_JobSystem->ParallelFor(count, minBatchSize, function, &counter);
+	m_JobSystem->Wait(&counter);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		ForEachObject
+
+Summary:	Runs a function on every static, dynamic and projectile object
+			across the job system, and waits for all of them. The function
+			must only touch the object it is given.
+
+Args:		const std::function<void(GameObject*)>& function
+				the work to run on each object.
+
+Modifies:	[m_StaticList, m_DynamicList, m_BulletList].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void GameObjectManager::ForEachObject(const std::function<void(GameObject*)>& function)
+{
+	int staticCount = (int)m_StaticList->size();
+	int dynamicCount = (int)m_DynamicList->size();
+	int projectileCount = (int)m_BulletList->size();
+
+	//Treat the three lists as one range so small lists share batches.
+	ParallelFor(staticCount + dynamicCount + projectileCount, OBJECT_JOB_BATCH_SIZE,
+		[&](int begin, int end)
+	{
+		for (int i = begin; i < end; i++)
+			function(ObjectAt(i, staticCount, dynamicCount));
+	});
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		ObjectAt
+
+Summary:	Finds an object by its index in the static, dynamic and
+			projectile lists taken one after the other.
+
+Args:		int index
+				the index into the three lists as one range.
+			int staticCount, dynamicCount
+				the sizes of the static and dynamic lists.
+
+Modifies:	[none].
+
+Returns:	GameObject*
+				the object at the index.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+GameObject* GameObjectManager::ObjectAt(int index, int staticCount, int dynamicCount)
+{
+	if (index < staticCount)
+		return (*m_StaticList)[index];
+	if (index < staticCount + dynamicCount)
+		return (*m_DynamicList)[index - staticCount];
+	return (*m_BulletList)[index - staticCount - dynamicCount];
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		ScreenSize
+
+Summary:	Estimates how many pixels tall a gameObject is on screen from
+			the bounding sphere of its AABB and its distance from the camera.
+
+Args:		const BoundingBox& bounds
+				the snapshotted bounds of the gameObject to measure.
+			CameraClass* cam
+				the camera the scene is being drawn from.
+			D3DClass* d3d
+				the d3d class holding the screen size.
+			const XMMATRIX &projectionMatrix
+				the projection the scene is being drawn with.
+
+Modifies:	[none].
+
+Returns:	float
+				the height of the gameObject on screen, in pixels.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+float GameObjectManager::ScreenSize(const BoundingBox& bounds, CameraClass* cam, D3DClass* d3d, const XMMATRIX &projectionMatrix)
+{
+	XMFLOAT3 camPosition = cam->GetPosition();
+
+	//Find the radius of the bounding sphere and its distance from the camera.
+	float radius = XMVectorGetX(XMVector3Length(XMLoadFloat3(&bounds.Extents)));
+	float distance = XMVectorGetX(XMVector3Length(XMLoadFloat3(&bounds.Center) - XMLoadFloat3(&camPosition)));
+
+	//If the camera is inside the sphere it fills the screen.
+	if (distance <= radius)
+		return d3d->m_screenHeight;
+
+	//Project the diameter of the sphere onto the screen.
+	float size = (radius / distance) * XMVectorGetY(projectionMatrix.r[1]) * d3d->m_screenHeight;
+	return size < d3d->m_screenHeight ? size : d3d->m_screenHeight;
 }
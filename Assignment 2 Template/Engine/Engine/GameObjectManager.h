@@ -10,12 +10,25 @@
 #include "GameObject.h"
 #include "shadermanagerclass.h"
 #include "d3dclass.h"
+#include "FrameSnapshotClass.h"
+#include "SpatialHashGridClass.h"
+#include "SceneBVHClass.h"
+#include "OcclusionCullerClass.h"
+#include "FrameArenaClass.h"
+#include "TransformBatchClass.h"
+
+
+//===============================================
+//				Library Headers.
+//===============================================
+#include <functional>
 
 
 //===============================================
 //				Forward declarations.
 //===============================================
 class ProjectileObject;
+class JobSystemClass;
 
 
 /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
@@ -27,6 +40,14 @@ Summary:	A class to provide various functions for storing, managing
 Enums:		==================== PUBLIC ====================
 			ObjectType {OBJECTTYPE_STATIC, ..._DYNAMIC, ..._PROJECTILE}
 				an enum to clarify the type of object being dealt with.
+			CollisionMode {COLLISIONMODE_AABB, ..._OBB}
+				whether projectiles hit whatever their AABBs overlap, or only
+				once the oriented boxes of rotated objects overlap as well.
+			BroadPhase {BROADPHASE_BRUTEFORCE, ..._HASHGRID, ..._STATICTREE}
+				whether each projectile is tested against every object, only
+				those sharing a cell of a spatial hash grid with it, or the
+				dynamic objects sharing a cell with it and the static objects
+				near it in a cached bounding volume hierarchy.
 
 Methods:	==================== PUBLIC ====================
 			GameObjectManager
@@ -34,24 +55,68 @@ Methods:	==================== PUBLIC ====================
 			~GameObjectManager
 				Default deconstructor
 
+			void SetJobSystem(JobSystemClass*)
+				Use to spread the update loops across a job system's threads.
+			void SetCollisionMode(CollisionMode)
+				Use to choose the bounds projectiles are collided against.
+			bool SetBroadPhase(BroadPhase, float)
+				Use to choose how projectiles find the objects to test, and the
+				cell size of the grid if one is used.
+			void SetOcclusionCulling(bool)
+				Use to turn skipping objects hidden behind occluders on or off.
+			void SetBatchedTransforms(bool)
+				Use to choose whether the world matrices of the objects that
+				moved are built together in batches or one object at a time.
+
 			void AddItem
 				Use to add an item of the specified type to the GameObjectManager.
 			void AddItem(+...)
 				An overload of AddItem to allow GameObjects to be added to the GameObjectManager
 				with an initial transform, rotation and scaling.
 
-			void AddProjectile(GameObject* projectile, XMFLOAT3* position, XMFLOAT3* rotation)
+			void AddProjectile(GameObject* projectile, XMFLOAT3* position, XMFLOAT4* orientation)
 				Use to add a projectile into consideration by the GameObjectManager
-				at the specified position and rotation(radians).
+				at the specified position and orientation quaternion.
 
 			GameObject* SearchFor
 				Use to check a specified gameObject exists within the GameObjectManager.
 			void Delete(GameObject*)
 				Use to delete the specified gameObject from consideration by the GameObjectManager.
 
+			void WriteSnapshot(float, int, FrameSnapshotClass*)
+				Use once per frame after the simulation steps to write every object's
+				matrix, interpolated between the last two simulation steps, and its
+				bounds and visibility into the back buffer of a snapshot.
 			void RenderAll(...)
-				Use to render all the objects within the scope of the GameObjectManager.
-				Also runs collision testing.
+				Use to submit the objects in the front buffer of a snapshot for
+				drawing. Never reads the objects' own transforms, so it can run
+				while the next frame is simulated.
+			int FindOccluded(const std::vector<FrameSnapshotClass::Entry>&, ...)
+				Use to draw the occluders of a snapshot into the occlusion
+				culler and mark every entry they hide.
+			void BeginStep()
+				Use at the start of each simulation step, before anything moves,
+				to save the state every object is interpolated from.
+			void Update(float)
+				Use to run one fixed simulation step without drawing anything:
+				culls, advances every object, rebuilds the matrix and AABB of every
+				object that moved and collides.
+			void TakeScoreEvents(int&, int&)
+				Use on the thread that owns the text to collect the projectile hits
+				and culls recorded by Update() since the last call.
+			long long GetCollisionChecks()
+				Use to get the number of AABB pair tests run so far.
+			long long GetOBBRejections()
+				Use to get the number of overlapping AABB pairs whose oriented
+				boxes did not overlap, so were not counted as hits, so far.
+			SceneBVHClass* GetStaticTree()
+				Use to get the hierarchy over the static objects' AABBs, rebuilt
+				first if any of them were added, removed or moved.
+			long long GetOccludedObjects()
+				Use to get the number of snapshot entries skipped as hidden
+				behind occluders so far.
+			OcclusionCullerClass* GetOcclusionCuller()
+				Use to get the occlusion culler, such as to save its depth buffer.
 			
 			std::vector<GameObject*>* GetList
 				Use to return the appropriate list according to the object type passed in.
@@ -66,8 +131,34 @@ Methods:	==================== PUBLIC ====================
 				Use to remove any projectiles further away from the origin than the max distance
 				specified in GameObjectManager.cpp
 
-			void AABBCollisionLoop(...)
-				Used by RenderAll() to do collision testing with the objects in the scene every frame.
+			void AABBCollisionLoop()
+				Used by Update() to do collision testing with the objects in the scene every step.
+			void UpdateStaticTree()
+				Used by AABBCollisionLoop() and GetStaticTree() to rebuild the static
+				hierarchy only when the static objects have changed.
+			void UpdateAllBounds()
+				Used by Update() to rebuild the world matrix and AABB of every object
+				that moved, in batches if asked.
+
+			void ParallelFor(int, int, const std::function<void(int, int)>&)
+				Used by the update loops to run a range across the job system and wait for it.
+			void ForEachObject(const std::function<void(GameObject*)>&)
+				Used by BeginStep(), Update() and UpdateAllBounds() to run a function
+				on every object in parallel.
+			GameObject* ObjectAt(int, int, int)
+				Used by ForEachObject(), UpdateAllBounds() and WriteSnapshot() to treat
+				the static, dynamic and projectile lists as one range.
+
+			float ScreenSize(const BoundingBox&, CameraClass*, D3DClass*, const XMMATRIX&)
+				Used by RenderAll() to estimate how many pixels tall a gameObject is on screen
+				so its texture can be streamed at the right detail.
+
+			void RenderAABBs(const std::vector<FrameSnapshotClass::Entry>&, const FrameVector<char>&, ...)
+				Used by RenderAll() to draw the AABBs of every streamed in object that
+				was not occluded as one pass.
+			ModelClass* GetBoundsModel(D3DClass*, TextureAtlasClass*)
+				Used by RenderAll() and RenderAABBs() to get the unit box model every AABB
+				is drawn with, building it on first use.
 
 Members:	==================== PRIVATE ====================
 			vector<GameObject*>* m_StaticList
@@ -77,11 +168,54 @@ Members:	==================== PRIVATE ====================
 
 			vector<GameObject*>* m_BulletList
 				A list of all the projectiles currently in the scene.
+
+			JobSystemClass* m_JobSystem
+				the job system the update loops are spread across, or 0.
+			ModelClass* m_BoundsModel
+				the unit box model stretched over each AABB when drawing it, or 0
+				until first used.
+			SpatialHashGridClass* m_HashGrid
+				the grid the objects are sorted into every step: all of them
+				with BROADPHASE_HASHGRID, the dynamic ones with ..._STATICTREE.
+			SceneBVHClass* m_StaticTree
+				the hierarchy over the static objects' AABBs, kept between steps.
+			OcclusionCullerClass* m_OcclusionCuller
+				the coarse depth buffer occluders are drawn into each frame.
+			TransformBatchClass* m_TransformBatch
+				the batch the world matrices of the objects that moved are
+				built in each step.
+			std::vector<GameObject*> m_transformObjects
+				the object whose transform is in each slot of m_TransformBatch.
+			std::vector<GameObject*> m_staticTreeObjects
+				the static objects m_StaticTree was last built over, in order.
+			std::vector<unsigned int> m_staticTreeVersions
+				the bounds version of each of those when it was built.
+
+			CollisionMode m_collisionMode
+				the bounds projectiles are collided against, OBBs by default.
+			BroadPhase m_broadPhase
+				how projectiles find the objects to test, the static tree and
+				dynamic grid by default.
+			long long m_collisionChecks
+				the number of AABB pair tests run by AABBCollisionLoop() so far.
+			long long m_obbRejections
+				the number of those whose AABBs overlapped but whose OBBs did not.
+			int m_pendingHits, m_pendingCulls
+				the projectile hits and culls not yet taken by TakeScoreEvents().
+			bool m_occlusionCulling
+				whether hidden objects are skipped when rendering, on by default.
+			long long m_occludedObjects
+				the number of snapshot entries skipped as hidden so far, only
+				touched by the rendering thread.
+			bool m_batchedTransforms
+				whether world matrices are built in batches, on by default.
 C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
 class GameObjectManager
 {
 public:
 	enum ObjectType{OBJECTTYPE_STATIC, OBJECTTYPE_DYNAMIC, OBJECTTYPE_PROJECTILE};
+	enum CollisionMode{COLLISIONMODE_AABB, COLLISIONMODE_OBB};
+	enum BroadPhase{BROADPHASE_BRUTEFORCE, BROADPHASE_HASHGRID, BROADPHASE_STATICTREE};
 
 public:
 	GameObjectManager();
@@ -89,15 +223,31 @@ public:
 
 	void Shutdown();
 
+	void SetJobSystem(JobSystemClass* jobSystem);
+	void SetCollisionMode(CollisionMode collisionMode);
+	bool SetBroadPhase(BroadPhase broadPhase, float cellSize);
+	void SetOcclusionCulling(bool occlusionCulling);
+	void SetBatchedTransforms(bool batchedTransforms);
+
 	void AddItem(ObjectType objectType, GameObject* object);
 	void AddItem(ObjectType objectType, GameObject* object, XMFLOAT3* transform, XMFLOAT3* rotation, XMFLOAT3* scaling);
 
-	void AddProjectile(ProjectileObject* projectile, XMFLOAT3* position, XMFLOAT3* rotation);
+	void AddProjectile(ProjectileObject* projectile, XMFLOAT3* position, XMFLOAT4* orientation);
 
 	GameObject* SearchFor(ObjectType objectType, GameObject* object);
 	void Delete(GameObject* obj);
 
-	bool RenderAll(ShaderManagerClass* shaderManager, D3DClass* d3d, CameraClass* cam, XMMATRIX &viewMatrix, XMMATRIX &projectionMatrix, TextClassA* text);
+	void WriteSnapshot(float interpolation, int frame, FrameSnapshotClass* snapshot);
+	bool RenderAll(FrameSnapshotClass* snapshot, ShaderManagerClass* shaderManager, D3DClass* d3d, CameraClass* cam, TextureAtlasClass* atlas);
+	int FindOccluded(const std::vector<FrameSnapshotClass::Entry>& entries, const XMMATRIX &viewProjectionMatrix, FrameVector<char>& occluded);
+	void BeginStep();
+	void Update(float deltaTime);
+	void TakeScoreEvents(int& hits, int& culls);
+	long long GetCollisionChecks();
+	long long GetOBBRejections();
+	SceneBVHClass* GetStaticTree();
+	long long GetOccludedObjects();
+	OcclusionCullerClass* GetOcclusionCuller();
 
 	std::vector<GameObject*>* GetList(ObjectType listType);
 	vector<ProjectileObject*>* GetProjectileList();
@@ -105,14 +255,45 @@ public:
 private:
 	GameObject* Search(std::vector<GameObject*>* list, GameObject* object);
 
-	void CullProjectiles(TextClassA* text, D3DClass* d3d);
+	void CullProjectiles();
+
+	void AABBCollisionLoop();
+	void UpdateStaticTree();
+	void UpdateAllBounds();
 
-	void AABBCollisionLoop(TextClassA* text, D3DClass* d3d);
+	void ParallelFor(int count, int minBatchSize, const std::function<void(int, int)>& function);
+	void ForEachObject(const std::function<void(GameObject*)>& function);
+	GameObject* ObjectAt(int index, int staticCount, int dynamicCount);
+
+	float ScreenSize(const BoundingBox& bounds, CameraClass* cam, D3DClass* d3d, const XMMATRIX &projectionMatrix);
+
+	void RenderAABBs(const std::vector<FrameSnapshotClass::Entry>& entries, const FrameVector<char>& occluded, ShaderManagerClass* shaderManager, D3DClass* d3d, CameraClass* cam, TextureAtlasClass* atlas);
+	ModelClass* GetBoundsModel(D3DClass* d3d, TextureAtlasClass* atlas);
 
 private:
 	std::vector<GameObject*>* m_StaticList;
 	std::vector<GameObject*>* m_DynamicList;
 
 	vector<ProjectileObject*>* m_BulletList;
+
+	JobSystemClass* m_JobSystem;
+	ModelClass* m_BoundsModel;
+	SpatialHashGridClass* m_HashGrid;
+	SceneBVHClass* m_StaticTree;
+	std::vector<GameObject*> m_staticTreeObjects;
+	std::vector<unsigned int> m_staticTreeVersions;
+	OcclusionCullerClass* m_OcclusionCuller;
+	TransformBatchClass* m_TransformBatch;
+	std::vector<GameObject*> m_transformObjects;
+
+	CollisionMode m_collisionMode;
+	BroadPhase m_broadPhase;
+	long long m_collisionChecks;
+	long long m_obbRejections;
+	int m_pendingHits;
+	int m_pendingCulls;
+	bool m_occlusionCulling;
+	long long m_occludedObjects;
+	bool m_batchedTransforms;
 };
 
@@ -0,0 +1,323 @@
+//======================================================
+//				Filename: GpuProfilerClass.cpp
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "GpuProfilerClass.h"
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GpuProfilerClass
+
+Summary:	The default constructor for a GpuProfilerClass.
+
+Modifies:	[m_device, m_maxZones, m_frame, m_current, m_lastFrameTime,
+				m_skippedFrames].
+
+Returns:	GpuProfilerClass
+				the newly created GpuProfilerClass object.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+GpuProfilerClass::GpuProfilerClass()
+{
+	m_device = 0;
+	m_maxZones = 0;
+	m_frame = 0;
+	m_current = 0;
+	m_lastFrameTime = 0.0;
+	m_skippedFrames = 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GpuProfilerClass
+
+Summary:	The reference constructor for a GpuProfilerClass.
+
+Args:		const GpuProfilerClass& other
+				the GpuProfilerClass to create this one from.
+
+Modifies:	[none].
+
+Returns:	GpuProfilerClass
+				the newly created GpuProfilerClass object.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+GpuProfilerClass::GpuProfilerClass(const GpuProfilerClass & other)
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		~GpuProfilerClass
+
+Summary:	The default deconstructor for a GpuProfilerClass.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+GpuProfilerClass::~GpuProfilerClass()
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Initialize
+
+Summary:	Creates the query sets of every frame in the ring.
+
+Args:		GpuTimerDevice* device
+				the device to issue queries through.
+			int maxZones
+				the most passes that can be timed in one frame.
+
+Modifies:	[m_device, m_frames, m_maxZones].
+
+Returns:	bool
+				were the queries created successfully.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool GpuProfilerClass::Initialize(GpuTimerDevice * device, int maxZones)
+{
+	m_device = device;
+	m_maxZones = maxZones;
+
+	for (int i = 0; i < FRAME_LATENCY; i++)
+	{
+		FrameQueries& frame = m_frames[i];
+		frame.disjoint = m_device->CreateQuery(true);
+		frame.frameBegin = m_device->CreateQuery(false);
+		frame.frameEnd = m_device->CreateQuery(false);
+		if (frame.disjoint < 0 || frame.frameBegin < 0 || frame.frameEnd < 0)
+			return false;
+
+		frame.zoneBegin.resize(maxZones);
+		frame.zoneEnd.resize(maxZones);
+		frame.zoneNames.resize(maxZones);
+		for (int j = 0; j < maxZones; j++)
+		{
+			frame.zoneBegin[j] = m_device->CreateQuery(false);
+			frame.zoneEnd[j] = m_device->CreateQuery(false);
+			if (frame.zoneBegin[j] < 0 || frame.zoneEnd[j] < 0)
+				return false;
+		}
+
+		frame.zoneCount = 0;
+		frame.pending = false;
+	}
+
+	return true;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Shutdown
+
+Summary:	Releases every query. Results still in flight are discarded.
+
+Modifies:	[m_device, m_current].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void GpuProfilerClass::Shutdown()
+{
+	if (m_device)
+	{
+		m_device->ReleaseQueries();
+		m_device = 0;
+	}
+
+	m_current = 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		BeginFrame
+
+Summary:	Starts timing the frame in the next query set of the ring.
+			If that set's results have still not been read the frame is
+			not timed, so the CPU never waits on the GPU.
+
+Modifies:	[m_frame, m_current, m_openZones, m_skippedFrames].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void GpuProfilerClass::BeginFrame()
+{
+	if (!m_device)
+		return;
+
+	FrameQueries& frame = m_frames[m_frame % FRAME_LATENCY];
+	m_frame++;
+	m_openZones.clear();
+
+	if (frame.pending)
+	{
+		m_skippedFrames++;
+		m_current = 0;
+		return;
+	}
+
+	m_current = &frame;
+	m_current->zoneCount = 0;
+	m_device->Begin(m_current->disjoint);
+	m_device->End(m_current->frameBegin);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		EndFrame
+
+Summary:	Stops timing the frame, then reads back every finished frame,
+			oldest first, and adds its passes to the ProfilerClass stats.
+
+Modifies:	[m_current, m_frames, m_lastFrameTime].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void GpuProfilerClass::EndFrame()
+{
+	if (!m_device)
+		return;
+
+	if (m_current)
+	{
+		//Close passes left open so every query in the set gets issued.
+		while (!m_openZones.empty())
+			EndZone();
+
+		m_device->End(m_current->frameEnd);
+		m_device->End(m_current->disjoint);
+		m_current->pending = true;
+		m_current = 0;
+	}
+
+	//The next set to be used is the oldest, stop at the first not yet finished.
+	for (int i = 0; i < FRAME_LATENCY; i++)
+	{
+		FrameQueries& frame = m_frames[(m_frame + i) % FRAME_LATENCY];
+		if (frame.pending && !ReadBack(frame))
+			break;
+	}
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		BeginZone
+
+Summary:	Starts timing a pass. Passes beyond the most given to
+			Initialize() are not timed.
+
+Args:		const char* name
+				the name of the pass. Must outlive the profiler, such as a
+				string literal.
+
+Modifies:	[m_current, m_openZones].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void GpuProfilerClass::BeginZone(const char * name)
+{
+	if (!m_current)
+		return;
+
+	if (m_current->zoneCount >= m_maxZones)
+	{
+		m_openZones.push_back(-1);
+		return;
+	}
+
+	int zone = m_current->zoneCount++;
+	m_current->zoneNames[zone] = name;
+	m_device->End(m_current->zoneBegin[zone]);
+	m_openZones.push_back(zone);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		EndZone
+
+Summary:	Stops timing the last pass started.
+
+Modifies:	[m_openZones].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void GpuProfilerClass::EndZone()
+{
+	if (!m_current || m_openZones.empty())
+		return;
+
+	int zone = m_openZones.back();
+	m_openZones.pop_back();
+
+	if (zone >= 0)
+		m_device->End(m_current->zoneEnd[zone]);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetLastFrameTime
+
+Summary:	Gets the GPU time of the last frame read back.
+
+Modifies:	[none].
+
+Returns:	double
+				the time between the frame's first and last timestamp, in ms.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+double GpuProfilerClass::GetLastFrameTime()
+{
+	return m_lastFrameTime;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetSkippedFrames
+
+Summary:	Gets how many frames were not timed because the GPU was more
+			than the ring's length behind.
+
+Modifies:	[none].
+
+Returns:	int
+				the number of frames skipped.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+int GpuProfilerClass::GetSkippedFrames()
+{
+	return m_skippedFrames;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		ReadBack
+
+Summary:	Reads a frame's queries if the GPU has finished them and adds
+			the frame and each of its passes to the ProfilerClass stats.
+			Frames whose timestamps are disjoint are thrown away.
+
+Args:		FrameQueries& frame
+				the frame to read.
+
+Modifies:	[frame, m_lastFrameTime].
+
+Returns:	bool
+				were the results ready.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool GpuProfilerClass::ReadBack(FrameQueries & frame)
+{
+	uint64_t frequency;
+	bool disjoint;
+	if (!m_device->GetDisjoint(frame.disjoint, frequency, disjoint))
+		return false;
+
+	uint64_t frameBegin, frameEnd;
+	if (!m_device->GetTimestamp(frame.frameBegin, frameBegin) ||
+		!m_device->GetTimestamp(frame.frameEnd, frameEnd))
+		return false;
+
+	std::vector<uint64_t> zoneBegin(frame.zoneCount), zoneEnd(frame.zoneCount);
+	for (int i = 0; i < frame.zoneCount; i++)
+	{
+		if (!m_device->GetTimestamp(frame.zoneBegin[i], zoneBegin[i]) ||
+			!m_device->GetTimestamp(frame.zoneEnd[i], zoneEnd[i]))
+			return false;
+	}
+
+	frame.pending = false;
+
+	//The clock changed frequency or was reset part way through, the ticks mean nothing.
+	if (disjoint || frequency == 0)
+		return true;
+
+	double msPerTick = 1000.0 / (double)frequency;
+
+	m_lastFrameTime = frameEnd > frameBegin ? (frameEnd - frameBegin) * msPerTick : 0.0;
+	ProfilerClass::AddFrameTime("GPU Frame", m_lastFrameTime);
+
+	for (int i = 0; i < frame.zoneCount; i++)
+	{
+		double ms = zoneEnd[i] > zoneBegin[i] ? (zoneEnd[i] - zoneBegin[i]) * msPerTick : 0.0;
+		ProfilerClass::AddFrameTime(frame.zoneNames[i], ms);
+	}
+
+	return true;
+}
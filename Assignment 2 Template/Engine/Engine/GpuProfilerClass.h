@@ -0,0 +1,180 @@
+#pragma once
+//======================================================
+//				Filename: GpuProfilerClass.h
+//======================================================
+
+
+//======================================================
+//					Include Guards.
+//======================================================
+#ifndef _GPUPROFILERCLASS_H_
+#define _GPUPROFILERCLASS_H_
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "GpuTimerDevice.h"
+#include "ProfilerClass.h"
+
+
+//======================================================
+//					Profiler Macros.
+//======================================================
+#if ENGINE_PROFILER_ENABLED
+#define PROFILE_GPU_ZONE(profiler, name) GpuProfileZone PROFILER_CONCAT(gpuProfileZone, __LINE__)(profiler, name)
+#else
+#define PROFILE_GPU_ZONE(profiler, name)
+#endif
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		GpuProfilerClass
+
+Summary:	Times named GPU passes with timestamp queries.
+			Each frame is bracketed by a disjoint query and a pair of
+			timestamps, and each pass adds a pair of timestamps of its own.
+			Frames use a ring of query sets so results are read back a few
+			frames later without waiting on the GPU. If the oldest set has
+			still not been read when it comes round again, that frame is
+			not timed rather than stalling.
+			Finished passes are added to the ProfilerClass stats next to the
+			CPU zones.
+
+Structs:	FrameQueries
+				the queries and pass names of one frame in the ring.
+
+Methods:	==================== PUBLIC ====================
+			GpuProfilerClass()
+				Default constructor.
+			GpuProfilerClass(const GpuProfilerClass&)
+				Reference constructor.
+			~GpuProfilerClass()
+				Default deconstructor.
+
+			bool Initialize(GpuTimerDevice*, int)
+				Call after creation to create the queries, with the most
+				passes that can be timed in one frame.
+			void Shutdown()
+				Call before deletion to release the queries.
+
+			void BeginFrame()
+				Call at the start of the frame on the device thread.
+			void EndFrame()
+				Call at the end of the frame, then reads back finished frames.
+			void BeginZone(const char*)
+				Use to start timing a pass. name must be a string literal.
+			void EndZone()
+				Use to stop timing the last pass started.
+
+			double GetLastFrameTime()
+				Use to get the GPU time of the last frame read back, in ms.
+			int GetSkippedFrames()
+				Use to get how many frames were not timed because the GPU
+				was too far behind.
+
+			==================== PRIVATE ====================
+			bool ReadBack(FrameQueries&)
+				Called by EndFrame() to read a frame's results if they are ready.
+
+Members:	==================== PRIVATE ====================
+			GpuTimerDevice* m_device
+				the device queries are issued through.
+			FrameQueries m_frames[FRAME_LATENCY]
+				the ring of query sets.
+			int m_maxZones
+				the most passes timed per frame.
+			int m_frame
+				the number of calls to BeginFrame() so far.
+			FrameQueries* m_current
+				the frame being recorded, or 0 if it is not being timed.
+			std::vector<int> m_openZones
+				the passes started but not yet ended this frame.
+			double m_lastFrameTime
+				the GPU time of the last frame read back, in ms.
+			int m_skippedFrames
+				the frames not timed because their query set was busy.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class GpuProfilerClass
+{
+private:
+	static const int FRAME_LATENCY = 3;
+
+	struct FrameQueries
+	{
+		int disjoint;
+		int frameBegin, frameEnd;
+		std::vector<int> zoneBegin, zoneEnd;
+		std::vector<const char*> zoneNames;
+		int zoneCount;
+		bool pending;
+	};
+
+public:
+	GpuProfilerClass();
+	GpuProfilerClass(const GpuProfilerClass&);
+	~GpuProfilerClass();
+
+	bool Initialize(GpuTimerDevice* device, int maxZones);
+	void Shutdown();
+
+	void BeginFrame();
+	void EndFrame();
+	void BeginZone(const char* name);
+	void EndZone();
+
+	double GetLastFrameTime();
+	int GetSkippedFrames();
+
+private:
+	bool ReadBack(FrameQueries& frame);
+
+private:
+	GpuTimerDevice* m_device;
+	FrameQueries m_frames[FRAME_LATENCY];
+	int m_maxZones;
+	int m_frame;
+	FrameQueries* m_current;
+	std::vector<int> m_openZones;
+	double m_lastFrameTime;
+	int m_skippedFrames;
+};
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		GpuProfileZone
+
+Summary:	Times the GPU work submitted in the scope it is created in.
+			Use through PROFILE_GPU_ZONE.
+
+Methods:	==================== PUBLIC ====================
+			GpuProfileZone(GpuProfilerClass*, const char*)
+				Starts the pass. Does nothing if the profiler is 0.
+			~GpuProfileZone()
+				Ends the pass.
+
+Members:	==================== PRIVATE ====================
+			GpuProfilerClass* m_profiler
+				the profiler timing the pass.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class GpuProfileZone
+{
+public:
+	GpuProfileZone(GpuProfilerClass* profiler, const char* name)
+	{
+		m_profiler = profiler;
+		if (m_profiler)
+			m_profiler->BeginZone(name);
+	}
+
+	~GpuProfileZone()
+	{
+		if (m_profiler)
+			m_profiler->EndZone();
+	}
+
+private:
+	GpuProfilerClass* m_profiler;
+};
+
+#endif
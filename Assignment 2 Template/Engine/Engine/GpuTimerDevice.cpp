@@ -0,0 +1,182 @@
+//======================================================
+//				Filename: GpuTimerDevice.cpp
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "GpuTimerDevice.h"
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		NullGpuTimerDevice
+
+Summary:	The preferred constructor for a NullGpuTimerDevice.
+
+Args:		uint64_t frequency
+				the ticks per second to report.
+			uint64_t step
+				the ticks the fake clock advances at each timestamp.
+			int delay
+				the frames before a result can be read.
+
+Modifies:	[m_frequency, m_step, m_clock, m_delay, m_framesEnded, m_disjoint].
+
+Returns:	NullGpuTimerDevice
+				the newly created NullGpuTimerDevice object.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+NullGpuTimerDevice::NullGpuTimerDevice(uint64_t frequency, uint64_t step, int delay)
+{
+	m_frequency = frequency;
+	m_step = step;
+	m_clock = 0;
+	m_delay = delay;
+	m_framesEnded = 0;
+	m_disjoint = false;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		CreateQuery
+
+Summary:	Creates a fake query.
+
+Args:		bool disjoint
+				create a disjoint query rather than a timestamp.
+
+Modifies:	[m_queries].
+
+Returns:	int
+				the handle of the query.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+int NullGpuTimerDevice::CreateQuery(bool disjoint)
+{
+	FakeQuery query = { disjoint, 0, -1, false };
+	m_queries.push_back(query);
+	return (int)m_queries.size() - 1;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		ReleaseQueries
+
+Summary:	Forgets every fake query.
+
+Modifies:	[m_queries].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void NullGpuTimerDevice::ReleaseQueries()
+{
+	m_queries.clear();
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Begin
+
+Summary:	Begins a fake disjoint query, making it unreadable until it ends.
+
+Args:		int query
+				the handle of the query.
+
+Modifies:	[m_queries].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void NullGpuTimerDevice::Begin(int query)
+{
+	m_queries[query].issuedFrame = -1;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		End
+
+Summary:	Ends a fake disjoint query, counting a frame and marking it
+			unreliable if set to, or stamps a fake timestamp query with the
+			advanced clock.
+
+Args:		int query
+				the handle of the query.
+
+Modifies:	[m_queries, m_clock, m_framesEnded].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void NullGpuTimerDevice::End(int query)
+{
+	FakeQuery& fake = m_queries[query];
+	fake.issuedFrame = m_framesEnded;
+
+	if (fake.disjoint)
+	{
+		fake.unreliable = m_disjoint;
+		m_framesEnded++;
+	}
+	else
+	{
+		m_clock += m_step;
+		fake.timestamp = m_clock;
+	}
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetTimestamp
+
+Summary:	Reads a fake timestamp once enough frames have ended.
+
+Args:		int query
+				the handle of the query.
+			uint64_t& timestamp
+				set to the timestamp.
+
+Modifies:	[none].
+
+Returns:	bool
+				was the result available.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool NullGpuTimerDevice::GetTimestamp(int query, uint64_t & timestamp)
+{
+	const FakeQuery& fake = m_queries[query];
+	if (fake.issuedFrame < 0 || m_framesEnded - fake.issuedFrame < m_delay)
+		return false;
+
+	timestamp = fake.timestamp;
+	return true;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetDisjoint
+
+Summary:	Reads a fake disjoint query once enough frames have ended.
+
+Args:		int query
+				the handle of the query.
+			uint64_t& frequency
+				set to the frequency given on construction.
+			bool& disjoint
+				set to whether the query was ended while SetDisjoint(true).
+
+Modifies:	[none].
+
+Returns:	bool
+				was the result available.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool NullGpuTimerDevice::GetDisjoint(int query, uint64_t & frequency, bool & disjoint)
+{
+	const FakeQuery& fake = m_queries[query];
+	if (fake.issuedFrame < 0 || m_framesEnded - fake.issuedFrame < m_delay)
+		return false;
+
+	frequency = m_frequency;
+	disjoint = fake.unreliable;
+	return true;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		SetDisjoint
+
+Summary:	Sets whether the disjoint queries ended from now on report their
+			timestamps as unreliable.
+
+Args:		bool disjoint
+				are the following frames disjoint.
+
+Modifies:	[m_disjoint].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void NullGpuTimerDevice::SetDisjoint(bool disjoint)
+{
+	m_disjoint = disjoint;
+}
@@ -0,0 +1,133 @@
+#pragma once
+//======================================================
+//				Filename: GpuTimerDevice.h
+//======================================================
+
+
+//======================================================
+//					Include Guards.
+//======================================================
+#ifndef _GPUTIMERDEVICE_H_
+#define _GPUTIMERDEVICE_H_
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <stdint.h>
+#include <vector>
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		GpuTimerDevice
+
+Summary:	The interface GpuProfilerClass issues its timestamp queries
+			through. Queries are referred to by integer handles so the
+			profiler's bookkeeping can be driven without Direct3D.
+
+Methods:	==================== PURE VIRTUAL ====================
+			int CreateQuery(bool)
+				Creates a timestamp query, or a timestamp disjoint query if
+				the argument is true. Returns -1 on failure.
+			void ReleaseQueries()
+				Releases every query made by CreateQuery.
+			void Begin(int)
+				Begins a disjoint query.
+			void End(int)
+				Ends a disjoint query, or issues a timestamp query.
+			bool GetTimestamp(int, uint64_t&)
+				Reads a timestamp without waiting. Returns false if the GPU
+				has not reached it yet.
+			bool GetDisjoint(int, uint64_t&, bool&)
+				Reads the tick frequency and whether the timestamps between
+				Begin and End are unreliable, without waiting. Returns false
+				if the GPU has not reached the End yet.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class GpuTimerDevice
+{
+public:
+	virtual ~GpuTimerDevice() {}
+
+	virtual int CreateQuery(bool disjoint) = 0;
+	virtual void ReleaseQueries() = 0;
+	virtual void Begin(int query) = 0;
+	virtual void End(int query) = 0;
+	virtual bool GetTimestamp(int query, uint64_t& timestamp) = 0;
+	virtual bool GetDisjoint(int query, uint64_t& frequency, bool& disjoint) = 0;
+};
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		NullGpuTimerDevice
+
+Summary:	A stand-in GpuTimerDevice with no GPU behind it. Each issued
+			timestamp advances a fake clock by a fixed step, and results
+			only become readable a set number of frames (disjoint query
+			Ends) after they were issued, like a real GPU running behind.
+			Frames the profiler skips end no query, so a delay longer than
+			the profiler's ring never completes. Frames can be marked
+			disjoint to check the profiler throws them away.
+
+Methods:	==================== PUBLIC ====================
+			NullGpuTimerDevice(uint64_t, uint64_t, int)
+				Creates the timer device with a tick frequency, the ticks
+				each timestamp advances the clock by, and the frames of delay.
+
+			CreateQuery(...), ReleaseQueries(), Begin(...), End(...),
+			GetTimestamp(...), GetDisjoint(...)
+				Implementations of GpuTimerDevice.
+
+			void SetDisjoint(bool)
+				Use to mark the disjoint queries ended from now on as
+				unreliable, as a GPU changing clock speed would.
+
+Members:	==================== PRIVATE ====================
+			std::vector<FakeQuery> m_queries
+				every query created, indexed by handle.
+			uint64_t m_frequency
+				the ticks per second reported by disjoint queries.
+			uint64_t m_step
+				the ticks the clock advances by at each timestamp.
+			uint64_t m_clock
+				the fake GPU clock.
+			int m_delay
+				the frames before a result can be read.
+			int m_framesEnded
+				the number of disjoint queries ended so far.
+			bool m_disjoint
+				are the disjoint queries ended now unreliable.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class NullGpuTimerDevice : public GpuTimerDevice
+{
+private:
+	struct FakeQuery
+	{
+		bool disjoint;
+		uint64_t timestamp;
+		int issuedFrame;
+		bool unreliable;
+	};
+
+public:
+	NullGpuTimerDevice(uint64_t frequency, uint64_t step, int delay);
+
+	virtual int CreateQuery(bool disjoint) override;
+	virtual void ReleaseQueries() override;
+	virtual void Begin(int query) override;
+	virtual void End(int query) override;
+	virtual bool GetTimestamp(int query, uint64_t& timestamp) override;
+	virtual bool GetDisjoint(int query, uint64_t& frequency, bool& disjoint) override;
+
+	void SetDisjoint(bool disjoint);
+
+private:
+	std::vector<FakeQuery> m_queries;
+	uint64_t m_frequency;
+	uint64_t m_step;
+	uint64_t m_clock;
+	int m_delay;
+	int m_framesEnded;
+	bool m_disjoint;
+};
+
+#endif
@@ -0,0 +1,667 @@
+//======================================================
+//				Filename: JobSystemClass.cpp
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "JobSystemClass.h"
+#include "ProfilerClass.h"
+
+
+//======================================================
+//					Constants
+//======================================================
+//The batches ParallelFor() aims to give each thread, so threads that finish
+//early can steal from those that do not.
+const int JOB_BATCHES_PER_THREAD = 4;
+
+
+//The job system the calling thread belongs to and the deque it owns.
+static thread_local JobSystemClass* t_jobSystem = 0;
+static thread_local int t_threadIndex = 0;
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		WorkDeque
+
+Summary:	The default constructor for an empty WorkDeque.
+
+Modifies:	[m_top, m_bottom, m_jobs].
+
+Returns:	WorkDeque
+				the newly created WorkDeque object.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+JobSystemClass::WorkDeque::WorkDeque()
+{
+	m_top.store(0);
+	m_bottom.store(0);
+	for (int64_t i = 0; i < CAPACITY; i++)
+		m_jobs[i].store(0);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Push
+
+Summary:	Pushes a job onto the bottom of the deque.
+			Must only be called by the thread that owns the deque.
+
+Args:		Job* job
+				the job to push.
+
+Modifies:	[m_bottom, m_jobs].
+
+Returns:	bool
+				was there room for the job.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool JobSystemClass::WorkDeque::Push(Job * job)
+{
+	int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+	int64_t top = m_top.load(std::memory_order_acquire);
+	if (bottom - top >= CAPACITY)
+		return false;
+
+	m_jobs[bottom & (CAPACITY - 1)].store(job, std::memory_order_relaxed);
+
+	//Publish the job with the new bottom so stealers never see an empty slot.
+	m_bottom.store(bottom + 1, std::memory_order_release);
+	return true;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Pop
+
+Summary:	Pops the newest job from the bottom of the deque.
+			Must only be called by the thread that owns the deque.
+
+Modifies:	[m_top, m_bottom].
+
+Returns:	Job*
+				the job popped, or 0 if the deque was empty or the last
+				job was stolen first.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+JobSystemClass::Job * JobSystemClass::WorkDeque::Pop()
+{
+	//Claim the bottom slot before looking at the top. Both are sequentially
+	//consistent so a stealer either sees the claim or is seen here.
+	int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+	m_bottom.store(bottom, std::memory_order_seq_cst);
+	int64_t top = m_top.load(std::memory_order_seq_cst);
+
+	//The deque was empty, put the bottom back.
+	if (top > bottom)
+	{
+		m_bottom.store(bottom + 1, std::memory_order_relaxed);
+		return 0;
+	}
+
+	Job* job = m_jobs[bottom & (CAPACITY - 1)].load(std::memory_order_relaxed);
+
+	//More than one job was left, no stealer can reach this one.
+	if (top < bottom)
+		return job;
+
+	//This is the last job, race the stealers for it.
+	if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+		job = 0;
+
+	m_bottom.store(bottom + 1, std::memory_order_relaxed);
+	return job;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Steal
+
+Summary:	Takes the oldest job from the top of the deque.
+			May be called by any thread.
+
+Modifies:	[m_top].
+
+Returns:	Job*
+				the job stolen, or 0 if the deque was empty or another
+				thread took the job first.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+JobSystemClass::Job * JobSystemClass::WorkDeque::Steal()
+{
+	int64_t top = m_top.load(std::memory_order_seq_cst);
+	int64_t bottom = m_bottom.load(std::memory_order_seq_cst);
+
+	if (top >= bottom)
+		return 0;
+
+	Job* job = m_jobs[top & (CAPACITY - 1)].load(std::memory_order_relaxed);
+
+	//Another stealer or the owner got there first.
+	if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+		return 0;
+
+	return job;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		JobSystemClass
+
+Summary:	The default constructor for a JobSystemClass object.
+
+Modifies:	[m_Running, m_QueuedJobs, m_SleepingWorkers].
+
+Returns:	JobSystemClass
+				the newly created JobSystemClass object.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+JobSystemClass::JobSystemClass()
+{
+	m_Running = false;
+	m_QueuedJobs.store(0);
+	m_SleepingWorkers.store(0);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		JobSystemClass
+
+Summary:	The reference constructor for a JobSystemClass object.
+
+Args:		const JobSystemClass& other
+				the JobSystemClass object to create this one in the image of.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+JobSystemClass::JobSystemClass(const JobSystemClass & other)
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		~JobSystemClass
+
+Summary:	The default deconstructor for a JobSystemClass object.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+JobSystemClass::~JobSystemClass()
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Initialize
+
+Summary:	Creates a deque for the calling thread and for each worker,
+			then starts the worker threads.
+
+Args:		int workerCount
+				the number of worker threads to start.
+				0 uses one less than the number of hardware threads.
+				Pass -1 to start none and run every job on the calling thread.
+
+Modifies:	[m_Workers, m_Deques, m_Running].
+
+Returns:	bool
+				were the worker threads started successfully.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool JobSystemClass::Initialize(int workerCount)
+{
+	//Leave the calling thread its own hardware thread if no count was given.
+	if (workerCount == 0)
+		workerCount = (int)std::thread::hardware_concurrency() - 1;
+	if (workerCount < 0)
+		workerCount = 0;
+
+	//The calling thread owns the first deque.
+	t_jobSystem = this;
+	t_threadIndex = 0;
+
+	for (int i = 0; i < workerCount + 1; i++)
+		m_Deques.push_back(new WorkDeque);
+
+	m_Running = true;
+
+	try
+	{
+		for (int i = 0; i < workerCount; i++)
+			m_Workers.push_back(std::thread(&JobSystemClass::WorkerLoop, this, i + 1));
+	}
+	catch (const std::exception&)
+	{
+		Shutdown();
+		return false;
+	}
+
+	return true;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Shutdown
+
+Summary:	Stops and joins every worker thread and frees the deques and
+			the free list. Jobs still queued are thrown away without running.
+
+Modifies:	[m_Workers, m_Deques, m_Running, m_QueuedJobs, m_FreeJobs].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void JobSystemClass::Shutdown()
+{
+	//Ask the workers to stop and wake all of them up.
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Running = false;
+	}
+	m_Condition.notify_all();
+
+	for (std::vector<std::thread>::iterator iter = m_Workers.begin();
+		iter != m_Workers.end();
+		iter++)
+	{
+		if (iter->joinable())
+			iter->join();
+	}
+	m_Workers.clear();
+
+	//Every thread has stopped, so the deques can be emptied from here.
+	for (std::vector<WorkDeque*>::iterator iter = m_Deques.begin();
+		iter != m_Deques.end();
+		iter++)
+	{
+		Job* job;
+		while ((job = (*iter)->Steal()) != 0)
+			delete job;
+
+		delete *iter;
+	}
+	m_Deques.clear();
+	m_QueuedJobs.store(0);
+
+	for (std::vector<Job*>::iterator iter = m_FreeJobs.begin();
+		iter != m_FreeJobs.end();
+		iter++)
+	{
+		delete *iter;
+	}
+	m_FreeJobs.clear();
+
+	if (t_jobSystem == this)
+		t_jobSystem = 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Run
+
+Summary:	Queues a job on the calling thread's deque.
+
+Args:		JobFunction function
+				the work to run.
+			JobCounter* counter
+				the counter to add the job to, or 0.
+
+Modifies:	[counter].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void JobSystemClass::Run(JobFunction function, JobCounter * counter)
+{
+	Job* job = AllocateJob();
+	job->function = function;
+	job->counter = counter;
+
+	if (counter)
+		counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+
+	Schedule(job);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RunAfter
+
+Summary:	Queues a job to start once every job on the dependency counter
+			has finished. The job counts as pending on its own counter
+			from now, so waiting on that counter also waits for the
+			dependency.
+
+Args:		JobCounter* dependency
+				the counter that must reach zero first.
+			JobFunction function
+				the work to run.
+			JobCounter* counter
+				the counter to add the job to, or 0.
+
+Modifies:	[dependency, counter].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void JobSystemClass::RunAfter(JobCounter * dependency, JobFunction function, JobCounter * counter)
+{
+	Job* job = AllocateJob();
+	job->function = function;
+	job->counter = counter;
+
+	if (counter)
+		counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+
+	//The count only reaches zero under the lock, so the job is either
+	//picked up by Finish() or seen to be ready here, never lost.
+	{
+		std::lock_guard<std::mutex> lock(dependency->m_mutex);
+		if (dependency->m_pending.load(std::memory_order_acquire) > 0)
+		{
+			dependency->m_continuations.push_back(job);
+			return;
+		}
+	}
+
+	Schedule(job);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		ParallelFor
+
+Summary:	Splits the range [0, count) into batches and queues a job for
+			each. Batches are sized so each thread gets a few to balance
+			uneven work, but never fewer indices than minBatchSize.
+			A range too small to split is run straight away on the
+			calling thread.
+			The batches call the function through a pointer rather than
+			each holding a copy, so it must stay alive until Wait() on
+			the counter returns.
+
+Args:		int count
+				the number of indices.
+			int minBatchSize
+				the fewest indices worth the cost of a job.
+			const RangeFunction& function
+				the work to run over each batch, given its begin and end.
+			JobCounter* counter
+				the counter to add the batches to, or 0.
+
+Modifies:	[counter].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void JobSystemClass::ParallelFor(int count, int minBatchSize, const RangeFunction& function, JobCounter * counter)
+{
+	if (count <= 0)
+		return;
+
+	int batches = (int)m_Deques.size() * JOB_BATCHES_PER_THREAD;
+	int batchSize = (count + batches - 1) / batches;
+	if (batchSize < minBatchSize)
+		batchSize = minBatchSize;
+
+	//Not worth a job, or no one else to run it.
+	if (batchSize >= count || m_Workers.empty())
+	{
+		function(0, count);
+		return;
+	}
+
+	for (int begin = 0; begin < count; begin += batchSize)
+	{
+		Job* job = AllocateJob();
+		job->range = &function;
+		job->begin = begin;
+		job->end = begin + batchSize < count ? begin + batchSize : count;
+		job->counter = counter;
+
+		if (counter)
+			counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+
+		Schedule(job);
+	}
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Wait
+
+Summary:	Runs queued jobs on the calling thread until every job on the
+			counter has finished. The counter may be destroyed once this
+			returns.
+
+Args:		JobCounter* counter
+				the counter to wait on.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void JobSystemClass::Wait(JobCounter * counter)
+{
+	int threadIndex = GetThreadIndex();
+
+	while (counter->m_pending.load(std::memory_order_acquire) > 0)
+	{
+		Job* job = FindJob(threadIndex);
+		if (job)
+			Execute(job);
+		else
+			std::this_thread::yield();
+	}
+
+	//Let the thread that finished the last job release the counter first.
+	std::lock_guard<std::mutex> lock(counter->m_mutex);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetWorkerCount
+
+Summary:	Gets the number of worker threads in the pool.
+
+Modifies:	[none].
+
+Returns:	int
+				the worker threads, not counting the initializing thread.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+int JobSystemClass::GetWorkerCount()
+{
+	return (int)m_Workers.size();
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		AllocateJob
+
+Summary:	Takes a finished job off the free list to reuse, or creates a
+			new one if there are none.
+
+Modifies:	[m_FreeJobs].
+
+Returns:	Job*
+				an empty job.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+JobSystemClass::Job * JobSystemClass::AllocateJob()
+{
+	Job* job = 0;
+	{
+		std::lock_guard<std::mutex> lock(m_FreeJobsMutex);
+		if (!m_FreeJobs.empty())
+		{
+			job = m_FreeJobs.back();
+			m_FreeJobs.pop_back();
+		}
+	}
+
+	if (!job)
+		job = new Job;
+
+	job->range = 0;
+	job->begin = 0;
+	job->end = 0;
+	job->counter = 0;
+	return job;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		FreeJob
+
+Summary:	Releases what a finished job captured and puts it on the free
+			list for the next one.
+
+Args:		Job* job
+				the finished job.
+
+Modifies:	[m_FreeJobs].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void JobSystemClass::FreeJob(Job * job)
+{
+	job->function = nullptr;
+
+	std::lock_guard<std::mutex> lock(m_FreeJobsMutex);
+	m_FreeJobs.push_back(job);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Schedule
+
+Summary:	Pushes a job onto the calling thread's deque and wakes a
+			sleeping worker to take it. If the deque is full the job is
+			run straight away instead.
+
+Args:		Job* job
+				the job to queue.
+
+Modifies:	[m_Deques, m_QueuedJobs].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void JobSystemClass::Schedule(Job * job)
+{
+	if (!m_Deques[GetThreadIndex()]->Push(job))
+	{
+		Execute(job);
+		return;
+	}
+
+	m_QueuedJobs.fetch_add(1);
+
+	//Workers count themselves as sleeping before checking for jobs, so
+	//either they see this job or this sees them and wakes one.
+	if (m_SleepingWorkers.load() > 0)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+		}
+		m_Condition.notify_one();
+	}
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		FindJob
+
+Summary:	Pops the newest job from a thread's own deque, or failing that
+			steals the oldest from each of the other deques in turn.
+
+Args:		int threadIndex
+				the deque owned by the calling thread.
+
+Modifies:	[m_Deques, m_QueuedJobs].
+
+Returns:	Job*
+				the job found, or 0 if there was none.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+JobSystemClass::Job * JobSystemClass::FindJob(int threadIndex)
+{
+	Job* job = m_Deques[threadIndex]->Pop();
+
+	//Start with the next thread along so stealers spread out.
+	int deques = (int)m_Deques.size();
+	for (int i = 1; !job && i < deques; i++)
+		job = m_Deques[(threadIndex + i) % deques]->Steal();
+
+	if (job)
+		m_QueuedJobs.fetch_sub(1);
+
+	return job;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Execute
+
+Summary:	Runs a job, returns it to the free list and finishes it on
+			its counter.
+
+Args:		Job* job
+				the job to run.
+
+Modifies:	[job, m_FreeJobs].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void JobSystemClass::Execute(Job * job)
+{
+	if (job->range)
+		(*job->range)(job->begin, job->end);
+	else
+		job->function();
+
+	JobCounter* counter = job->counter;
+	FreeJob(job);
+
+	if (counter)
+		Finish(counter);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Finish
+
+Summary:	Takes one finished job off a counter. If it was the last, the
+			jobs waiting on the counter are queued.
+
+Args:		JobCounter* counter
+				the counter the job was added to.
+
+Modifies:	[counter].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void JobSystemClass::Finish(JobCounter * counter)
+{
+	std::vector<Job*> ready;
+
+	//The counter is not touched after the lock is let go, a waiter may free it.
+	{
+		std::lock_guard<std::mutex> lock(counter->m_mutex);
+		if (counter->m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			ready.swap(counter->m_continuations);
+	}
+
+	for (std::vector<Job*>::iterator iter = ready.begin();
+		iter != ready.end();
+		iter++)
+	{
+		Schedule(*iter);
+	}
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetThreadIndex
+
+Summary:	Gets the deque owned by the calling thread. Threads outside the
+			pool share the first deque, so must be the initializing thread.
+
+Modifies:	[none].
+
+Returns:	int
+				the index into m_Deques of the calling thread's deque.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+int JobSystemClass::GetThreadIndex()
+{
+	return t_jobSystem == this ? t_threadIndex : 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		WorkerLoop
+
+Summary:	The body of each worker thread. Runs jobs while any can be
+			found and sleeps when there are none.
+
+Args:		int threadIndex
+				the deque owned by this worker.
+
+Modifies:	[m_SleepingWorkers].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void JobSystemClass::WorkerLoop(int threadIndex)
+{
+	PROFILE_THREAD_NAME("Job worker");
+
+	t_jobSystem = this;
+	t_threadIndex = threadIndex;
+
+	for (;;)
+	{
+		Job* job = FindJob(threadIndex);
+		if (job)
+		{
+			Execute(job);
+			continue;
+		}
+
+		//Nothing to do, sleep until a job is queued or for shutdown.
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		m_SleepingWorkers.fetch_add(1);
+		m_Condition.wait(lock, [this] { return !m_Running || m_QueuedJobs.load() > 0; });
+		m_SleepingWorkers.fetch_sub(1);
+
+		if (!m_Running)
+			return;
+	}
+}
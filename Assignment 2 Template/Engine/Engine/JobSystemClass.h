@@ -0,0 +1,251 @@
+#pragma once
+//======================================================
+//				Filename: JobSystemClass.h
+//======================================================
+
+
+//======================================================
+//					Include Guards.
+//======================================================
+#ifndef _JOBSYSTEMCLASS_H_
+#define _JOBSYSTEMCLASS_H_
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+//======================================================
+//				Forward declarations.
+//======================================================
+class JobCounter;
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		JobSystemClass
+
+Summary:	A fixed pool of worker threads that run short per-frame jobs,
+			such as the object update and collision loops.
+			Every thread of the pool, and the thread that called
+			Initialize(), owns a Chase-Lev work stealing deque. Jobs are
+			pushed onto the deque of the thread that made them and that
+			thread pops them newest first, while idle threads steal the
+			oldest from the other deques. Threads that find nothing to do
+			sleep until a job is queued.
+			Finished jobs are kept on a free list and reused, so a steady
+			frame queues jobs without touching the heap.
+			Jobs are grouped by JobCounters, which can be waited on or
+			used as the dependency of further jobs. Waiting runs queued
+			jobs on the waiting thread rather than blocking it.
+			Run(), ParallelFor() and Wait() may only be called from the
+			thread that called Initialize() or from inside a job.
+
+Types:		JobFunction
+				a callable run once as a job.
+			RangeFunction
+				a callable run over the index range [begin, end).
+
+Structs:	Job
+				a queued job, either a function or a batch of a range
+				function, and the counter it finishes.
+
+Classes:	WorkDeque
+				a fixed size Chase-Lev deque of jobs.
+
+Methods:	==================== PUBLIC ====================
+			JobSystemClass()
+				Default constructor.
+			JobSystemClass(const JobSystemClass&)
+				Reference constructor.
+			~JobSystemClass()
+				Default deconstructor.
+
+			bool Initialize(int)
+				Call after creation to start the worker threads.
+				a workerCount of 0 picks one less than the hardware thread count,
+				-1 starts none so every job runs on the calling thread.
+			void Shutdown()
+				Call before deletion, once every job has been waited on,
+				to stop and join the worker threads.
+
+			void Run(JobFunction, JobCounter*)
+				Use to queue a job, adding it to the counter if one is given.
+			void RunAfter(JobCounter*, JobFunction, JobCounter*)
+				Use to queue a job that only starts once the dependency
+				counter has reached zero.
+			void ParallelFor(int, int, const RangeFunction&, JobCounter*)
+				Use to split an index range into batches of at least the
+				given size and queue a job for each batch. The function is
+				not copied, so must outlive the wait on the counter.
+			void Wait(JobCounter*)
+				Use to run queued jobs until the counter reaches zero.
+
+			int GetWorkerCount()
+				Use to get the number of worker threads, not counting the
+				thread that called Initialize().
+
+			==================== PRIVATE ====================
+			Job* AllocateJob()
+				Takes a job from the free list, or creates one if it is empty.
+			void FreeJob(Job*)
+				Returns a finished job to the free list.
+			void Schedule(Job*)
+				Pushes a job onto the calling thread's deque and wakes a worker.
+			Job* FindJob(int)
+				Pops a job from a thread's own deque or steals one from another.
+			void Execute(Job*)
+				Runs a job and finishes it on its counter.
+			void Finish(JobCounter*)
+				Takes a finished job off a counter and queues the jobs
+				waiting on it once it reaches zero.
+			int GetThreadIndex()
+				Returns the deque owned by the calling thread.
+			void WorkerLoop(int)
+				The body of each worker thread.
+
+Members:	==================== PRIVATE ====================
+			std::vector<std::thread> m_Workers
+				the worker threads of the pool.
+			std::vector<WorkDeque*> m_Deques
+				the deque of every thread, the initializing thread's first.
+			std::mutex m_Mutex
+				guards m_Running and the sleep of the workers.
+			std::condition_variable m_Condition
+				wakes workers when a job is queued or on shutdown.
+			bool m_Running
+				whether the worker threads should keep running.
+			std::atomic<int> m_QueuedJobs
+				the jobs sitting in a deque, not yet taken by any thread.
+			std::atomic<int> m_SleepingWorkers
+				the workers waiting on m_Condition.
+			std::vector<Job*> m_FreeJobs
+				finished jobs kept for reuse.
+			std::mutex m_FreeJobsMutex
+				guards m_FreeJobs.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class JobSystemClass
+{
+	friend class JobCounter;
+
+public:
+	typedef std::function<void()> JobFunction;
+	typedef std::function<void(int, int)> RangeFunction;
+
+private:
+	struct Job
+	{
+		JobFunction function;
+		const RangeFunction* range;
+		int begin, end;
+		JobCounter* counter;
+	};
+
+	class WorkDeque
+	{
+	public:
+		static const int64_t CAPACITY = 4096;
+
+		WorkDeque();
+
+		bool Push(Job* job);
+		Job* Pop();
+		Job* Steal();
+
+	private:
+		std::atomic<int64_t> m_top;
+		std::atomic<int64_t> m_bottom;
+		std::atomic<Job*> m_jobs[CAPACITY];
+	};
+
+public:
+	JobSystemClass();
+	JobSystemClass(const JobSystemClass&);
+	~JobSystemClass();
+
+	bool Initialize(int workerCount);
+	void Shutdown();
+
+	void Run(JobFunction function, JobCounter* counter);
+	void RunAfter(JobCounter* dependency, JobFunction function, JobCounter* counter);
+	void ParallelFor(int count, int minBatchSize, const RangeFunction& function, JobCounter* counter);
+	void Wait(JobCounter* counter);
+
+	int GetWorkerCount();
+
+private:
+	Job* AllocateJob();
+	void FreeJob(Job* job);
+	void Schedule(Job* job);
+	Job* FindJob(int threadIndex);
+	void Execute(Job* job);
+	void Finish(JobCounter* counter);
+	int GetThreadIndex();
+	void WorkerLoop(int threadIndex);
+
+private:
+	std::vector<std::thread> m_Workers;
+	std::vector<WorkDeque*> m_Deques;
+	std::mutex m_Mutex;
+	std::condition_variable m_Condition;
+	bool m_Running;
+	std::atomic<int> m_QueuedJobs;
+	std::atomic<int> m_SleepingWorkers;
+	std::vector<Job*> m_FreeJobs;
+	std::mutex m_FreeJobsMutex;
+};
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		JobCounter
+
+Summary:	Counts the jobs of a group that have not yet finished.
+			Pass one to JobSystemClass::Run() or ParallelFor() to add jobs
+			to the group, then JobSystemClass::Wait() on it, or use it as
+			the dependency of jobs that must only start once the group
+			is done.
+			A counter must outlive every job added to it and must not be
+			destroyed until Wait() on it has returned.
+
+Methods:	==================== PUBLIC ====================
+			JobCounter()
+				Default constructor. Starts with no jobs.
+
+			bool IsDone()
+				Use to check whether every job added so far has finished.
+
+Members:	==================== PRIVATE ====================
+			std::atomic<int> m_pending
+				the jobs added that have not yet finished.
+			std::mutex m_mutex
+				guards m_continuations and the count reaching zero.
+			std::vector<JobSystemClass::Job*> m_continuations
+				the jobs waiting for this counter to reach zero.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class JobCounter
+{
+	friend class JobSystemClass;
+
+public:
+	JobCounter() : m_pending(0) {}
+
+	bool IsDone() { return m_pending.load(std::memory_order_acquire) == 0; }
+
+private:
+	JobCounter(const JobCounter&);
+	JobCounter& operator=(const JobCounter&);
+
+private:
+	std::atomic<int> m_pending;
+	std::mutex m_mutex;
+	std::vector<JobSystemClass::Job*> m_continuations;
+};
+
+#endif
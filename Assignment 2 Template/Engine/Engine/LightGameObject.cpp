@@ -98,17 +98,14 @@ Modifies:	[see GameObject.Render()].
 Returns:	bool
 				was the rendering successful or not?
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-bool LightGameObject::Render(ShaderManagerClass* shaderManager, ID3D11DeviceContext* device,
-	XMMATRIX &worldMatrix, const XMMATRIX &viewMatrix, const XMMATRIX &projectionMatrix)
+bool LightGameObject::Render(ShaderManagerClass* shaderManager, RenderContext* device,
+	XMMATRIX &worldMatrix, const XMMATRIX &viewProjectionMatrix, float animationTime)
 {
 	//Render the model to the deviceContext.
 	GetModel()->Render(device);
 
-	//Calculate the worldMatrix of the model.
-	const XMMATRIX* newWorldMatrix = this->CalcWorldMatrix(worldMatrix);
-
 	//Render the model using the LightShader.
-	return shaderManager->RenderLightShader(device, GetModel()->GetIndexCount(), *newWorldMatrix, viewMatrix, projectionMatrix, 
+	return shaderManager->RenderLightShader(device, GetModel()->GetIndexCount(), worldMatrix, viewProjectionMatrix, 
 		GetModel()->GetTexture(),
 		m_Light->GetDirection(), m_Light->GetAmbientColor(), m_Light->GetDiffuseColor(),
 		m_Camera->GetPosition(), m_Light->GetSpecularColor(), m_Light->GetSpecularPower());
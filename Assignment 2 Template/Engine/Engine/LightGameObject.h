@@ -57,8 +57,8 @@ public:
 	LightGameObject(ModelClass* baseModel);
 	LightGameObject(ModelClass* baseModel, LightClass* light, CameraClass* camera);
 
-	virtual bool Render(ShaderManagerClass* shaderManager, ID3D11DeviceContext* device,
-		XMMATRIX &worldMatrix, const XMMATRIX &viewMatrix, const XMMATRIX &projectionMatrix) override;
+	virtual bool Render(ShaderManagerClass* shaderManager, RenderContext* device,
+		XMMATRIX &worldMatrix, const XMMATRIX &viewProjectionMatrix, float animationTime) override;
 
 	void SetLight(LightClass* light);
 
@@ -0,0 +1,167 @@
+//======================================================
+//				Filename: MappedFileClass.cpp
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "MappedFileClass.h"
+
+
+//======================================================
+//					Constants.
+//======================================================
+const size_t MAPPED_FILE_PAGE_SIZE = 4096;
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		MappedFileClass
+
+Summary:	The default constructor for a MappedFileClass object.
+
+Modifies:	[m_view, m_size].
+
+Returns:	MappedFileClass
+				the newly created MappedFileClass object.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+MappedFileClass::MappedFileClass()
+{
+	m_view = 0;
+	m_size = 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		MappedFileClass
+
+Summary:	The reference constructor for a MappedFileClass object.
+
+Args:		const MappedFileClass& other
+				the MappedFileClass object to create this one in the image of.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+MappedFileClass::MappedFileClass(const MappedFileClass & other)
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		~MappedFileClass
+
+Summary:	The default deconstructor for a MappedFileClass object. Unmaps
+			the file if it is still open.
+
+Modifies:	[m_view, m_size].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+MappedFileClass::~MappedFileClass()
+{
+	Close();
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Open
+
+Summary:	Maps a whole file into memory read-only. Both handles are
+			closed straight away, the view keeps the mapping alive.
+
+Args:		const WCHAR* filename
+				a filepath to the file to map.
+
+Modifies:	[m_view, m_size].
+
+Returns:	bool
+				was the file mapped. Check GetLastError() for why not.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool MappedFileClass::Open(const WCHAR * filename)
+{
+	Close();
+
+	HANDLE file = CreateFileW(filename, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	//Reject empty files, which can't be mapped, and any too big for the address space.
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0 || (unsigned long long)size.QuadPart > (size_t)-1)
+	{
+		CloseHandle(file);
+		SetLastError(ERROR_FILE_INVALID);
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingW(file, 0, PAGE_READONLY, 0, 0, 0);
+	CloseHandle(file);
+	if (!mapping)
+		return false;
+
+	m_view = (uint8_t*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if (!m_view)
+		return false;
+
+	m_size = (size_t)size.QuadPart;
+
+	return true;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Close
+
+Summary:	Unmaps the file if it is open.
+
+Modifies:	[m_view, m_size].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void MappedFileClass::Close()
+{
+	if (m_view)
+	{
+		UnmapViewOfFile(m_view);
+		m_view = 0;
+	}
+
+	m_size = 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Prefetch
+
+Summary:	Reads one byte from every page of the view, so the whole file
+			is read from disk on the calling thread. Used by loaders on
+			worker threads so the device thread does not stall on page
+			faults when it creates the texture.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void MappedFileClass::Prefetch()
+{
+	volatile uint8_t sum = 0;
+
+	for (size_t offset = 0; offset < m_size; offset += MAPPED_FILE_PAGE_SIZE)
+		sum += m_view[offset];
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetData
+
+Summary:	Returns the first byte of the mapped file.
+
+Returns:	const uint8_t*
+				the view, or 0 if no file is open.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+const uint8_t * MappedFileClass::GetData()
+{
+	return m_view;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetSize
+
+Summary:	Returns the size of the mapped file.
+
+Returns:	size_t
+				the size in bytes, or 0 if no file is open.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+size_t MappedFileClass::GetSize()
+{
+	return m_size;
+}
@@ -0,0 +1,74 @@
+#pragma once
+//======================================================
+//				Filename: MappedFileClass.h
+//======================================================
+
+
+//======================================================
+//					Include Guards.
+//======================================================
+#ifndef _MAPPEDFILECLASS_H_
+#define _MAPPEDFILECLASS_H_
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <windows.h>
+#include <stdint.h>
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		MappedFileClass
+
+Summary:	A read-only view of a whole file mapped into memory, so it can
+			be read in place rather than copied onto the heap. Pages are
+			read from disk the first time they are touched.
+
+Methods:	==================== PUBLIC ====================
+			MappedFileClass()
+				Default constructor.
+			MappedFileClass(const MappedFileClass&)
+				Reference constructor.
+			~MappedFileClass()
+				Default deconstructor. Closes the view.
+
+			bool Open(const WCHAR*)
+				Use to map a whole file. Empty files can't be mapped.
+			void Close()
+				Use to unmap the file. Pointers into it become invalid.
+			void Prefetch()
+				Use to touch every page of the view so it is read from disk
+				now, on this thread, rather than when it is first used.
+
+			const uint8_t* GetData()
+				Use to get the first byte of the file, or 0 if not open.
+			size_t GetSize()
+				Use to get the size of the file in bytes.
+
+Members:	==================== PRIVATE ====================
+			uint8_t* m_view
+				the mapped view of the file.
+			size_t m_size
+				the size of the file in bytes.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class MappedFileClass
+{
+public:
+	MappedFileClass();
+	MappedFileClass(const MappedFileClass&);
+	~MappedFileClass();
+
+	bool Open(const WCHAR* filename);
+	void Close();
+	void Prefetch();
+
+	const uint8_t* GetData();
+	size_t GetSize();
+
+private:
+	uint8_t* m_view;
+	size_t m_size;
+};
+
+#endif
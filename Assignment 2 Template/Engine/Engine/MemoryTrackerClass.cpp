@@ -0,0 +1,682 @@
+//======================================================
+//				Filename: MemoryTrackerClass.cpp
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "MemoryTrackerClass.h"
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <windows.h>
+#include <algorithm>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+
+
+//======================================================
+//					Constants.
+//======================================================
+//How many frames old a live allocation has to be to count as long lived.
+const int MEMORY_LONG_LIVED_FRAMES = 600;
+
+//How many of the largest live allocations the report lists.
+const int MEMORY_REPORT_LARGEST = 16;
+
+//How many tags the overlay lists, busiest first.
+const int MEMORY_OVERLAY_TAGS = 4;
+
+
+//======================================================
+//					Static Members.
+//======================================================
+std::atomic<long long> MemoryTrackerClass::s_allocations(0);
+std::atomic<long long> MemoryTrackerClass::s_allocatedBytes(0);
+std::atomic<long long> MemoryTrackerClass::s_frees(0);
+MemoryTrackerClass::TagStats MemoryTrackerClass::s_tags[MemoryTrackerClass::MAX_TAGS];
+MemoryTrackerClass::TagStats MemoryTrackerClass::s_total;
+std::atomic<int> MemoryTrackerClass::s_tagCount(1);
+std::atomic<int> MemoryTrackerClass::s_frame(0);
+
+//The tag of the calling thread's allocations, 0 for untagged.
+static thread_local int t_tag = 0;
+
+//Guards the registering of tag names.
+static std::atomic_flag s_tagLock = ATOMIC_FLAG_INIT;
+
+#if ENGINE_MEMORY_TRACKING
+//The header in front of every tracked allocation, linking it into the live list.
+struct AllocationHeader
+{
+	AllocationHeader* prev;
+	AllocationHeader* next;
+	size_t size;
+	int tag;
+	int frame;
+};
+
+//Rounded up so the memory after the header keeps malloc's alignment.
+static const size_t HEADER_SIZE = (sizeof(AllocationHeader) + 15) & ~(size_t)15;
+
+//The newest live allocation, and the lock guarding the list. Both are
+//constant initialized, so allocations made before main() are listed too.
+static AllocationHeader* s_live = 0;
+static std::atomic_flag s_liveLock = ATOMIC_FLAG_INIT;
+#endif
+
+
+//Spins on a flag until it is taken. Never allocates, so it is safe inside operator new.
+static void Lock(std::atomic_flag& flag)
+{
+	while (flag.test_and_set(std::memory_order_acquire))
+		std::this_thread::yield();
+}
+
+static void Unlock(std::atomic_flag& flag)
+{
+	flag.clear(std::memory_order_release);
+}
+
+
+//======================================================
+//				Global Allocator.
+//======================================================
+//Replace the global allocator so every heap allocation in the process is
+//accounted for. Every form is replaced, as a tracked block starts after its
+//header and must never reach the runtime's own delete.
+void* operator new(size_t size)
+{
+	void* memory = MemoryTrackerClass::Allocate(size);
+	if (!memory)
+		throw std::bad_alloc();
+
+	return memory;
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	return MemoryTrackerClass::Allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	return MemoryTrackerClass::Allocate(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+	MemoryTrackerClass::Free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+	MemoryTrackerClass::Free(memory);
+}
+
+void operator delete(void* memory, size_t size) noexcept
+{
+	MemoryTrackerClass::Free(memory);
+}
+
+void operator delete[](void* memory, size_t size) noexcept
+{
+	MemoryTrackerClass::Free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept
+{
+	MemoryTrackerClass::Free(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept
+{
+	MemoryTrackerClass::Free(memory);
+}
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		EndFrame
+
+Summary:	Rolls the allocations made since the last call into the per
+			frame window of the total and of every tag.
+
+Modifies:	[s_tags, s_total, s_frame].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void MemoryTrackerClass::EndFrame()
+{
+	int slot = s_frame.load(std::memory_order_relaxed) % STATS_FRAMES;
+
+	s_total.allocations.store(s_allocations.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	s_total.bytes.store(s_allocatedBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	RollFrame(s_total, slot);
+
+	int tagCount = s_tagCount.load(std::memory_order_acquire);
+	for (int i = 0; i < tagCount; i++)
+		RollFrame(s_tags[i], slot);
+
+	s_frame.fetch_add(1, std::memory_order_relaxed);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetReport
+
+Summary:	Formats the average and most allocations and bytes per frame over
+			the stats window, and what is still live, for the whole heap
+			and then each tag that has allocated.
+
+Modifies:	[none].
+
+Returns:	std::string
+				one line for the heap and one per tag.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+std::string MemoryTrackerClass::GetReport()
+{
+	std::ostringstream report;
+	char line[256];
+
+	sprintf_s(line, "%-32s %12s %12s %12s %10s %12s\n", "Heap (per frame)", "allocs", "bytes", "max bytes", "live", "live bytes");
+	report << line;
+
+	double allocations, bytes;
+	long long maxBytes;
+	GetRates(s_total, allocations, bytes, maxBytes);
+	sprintf_s(line, "%-32s %12.1f %12.0f %12lld %10lld %12lld\n", "total",
+		allocations, bytes, maxBytes, GetLiveAllocations(), GetLiveBytes());
+	report << line;
+
+	//Only tracked allocations are tagged.
+	int tagCount = s_tagCount.load(std::memory_order_acquire);
+	for (int i = 0; IsTracking() && i < tagCount; i++)
+	{
+		const TagStats& stats = s_tags[i];
+		if (stats.allocations.load(std::memory_order_relaxed) == 0)
+			continue;
+
+		GetRates(stats, allocations, bytes, maxBytes);
+		sprintf_s(line, "%-32.32s %12.1f %12.0f %12lld %10lld %12lld\n", i ? stats.name : "(untagged)",
+			allocations, bytes, maxBytes, stats.liveAllocations.load(std::memory_order_relaxed),
+			stats.liveBytes.load(std::memory_order_relaxed));
+		report << line;
+	}
+
+	return report.str();
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetOverlay
+
+Summary:	Formats the heap's allocation rate and live size on one line,
+			followed by the tags allocating the most bytes per frame.
+
+Modifies:	[none].
+
+Returns:	std::string
+				a few short lines to draw on screen.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+std::string MemoryTrackerClass::GetOverlay()
+{
+	std::ostringstream overlay;
+	char line[128];
+
+	double allocations, bytes;
+	long long maxBytes;
+	GetRates(s_total, allocations, bytes, maxBytes);
+	sprintf_s(line, "Heap: %.1f allocs/frame, %.1f KB/frame, %lld live", allocations, bytes / 1024.0, GetLiveAllocations());
+	overlay << line;
+
+	if (!IsTracking())
+		return overlay.str();
+
+	sprintf_s(line, " (%.1f MB)", GetLiveBytes() / (1024.0 * 1024.0));
+	overlay << line;
+
+	//Find the busiest tags by bytes per frame.
+	int busiest[MEMORY_OVERLAY_TAGS];
+	double busiestBytes[MEMORY_OVERLAY_TAGS];
+	int found = 0;
+
+	int tagCount = s_tagCount.load(std::memory_order_acquire);
+	for (int i = 0; i < tagCount; i++)
+	{
+		GetRates(s_tags[i], allocations, bytes, maxBytes);
+		if (bytes <= 0.0)
+			continue;
+
+		if (found == MEMORY_OVERLAY_TAGS && busiestBytes[found - 1] >= bytes)
+			continue;
+
+		//Insert in order, busiest first, dropping the least busy if full.
+		int slot = found < MEMORY_OVERLAY_TAGS ? found++ : found - 1;
+		while (slot > 0 && busiestBytes[slot - 1] < bytes)
+		{
+			busiest[slot] = busiest[slot - 1];
+			busiestBytes[slot] = busiestBytes[slot - 1];
+			slot--;
+		}
+		busiest[slot] = i;
+		busiestBytes[slot] = bytes;
+	}
+
+	for (int i = 0; i < found; i++)
+	{
+		const TagStats& stats = s_tags[busiest[i]];
+		GetRates(stats, allocations, bytes, maxBytes);
+		sprintf_s(line, "\n  %.32s: %.1f allocs/frame, %.1f KB/frame, %.1f KB live", busiest[i] ? stats.name : "(untagged)",
+			allocations, bytes / 1024.0, stats.liveBytes.load(std::memory_order_relaxed) / 1024.0);
+		overlay << line;
+	}
+
+	return overlay.str();
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		WriteReport
+
+Summary:	Writes the report to a file. When tracking, walks the live list
+			and adds, for every tag, how much it holds, how old its oldest
+			allocation is and how much has lived longer than
+			MEMORY_LONG_LIVED_FRAMES, then the largest live allocations.
+			Allocations that keep piling up in the long lived column of a
+			tag that should only hold per frame data are leaks.
+
+Args:		const char* filename
+				the file to write.
+
+Modifies:	[none].
+
+Returns:	bool
+				was the file written.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool MemoryTrackerClass::WriteReport(const char* filename)
+{
+	std::ofstream fout(filename);
+	if (fout.fail())
+	{
+		OutputDebugStringA("MemoryTrackerClass: could not open the report file\n");
+		return false;
+	}
+
+	int frame = s_frame.load(std::memory_order_relaxed);
+	char line[256];
+
+	sprintf_s(line, "Frame %d, %lld allocations and %lld bytes allocated in total.\n\n",
+		frame, GetAllocations(), GetAllocatedBytes());
+	fout << line;
+	fout << GetReport();
+
+#if ENGINE_MEMORY_TRACKING
+	//Gather everything under the lock without allocating, as operator new takes it too.
+	long long count[MAX_TAGS] = {}, bytes[MAX_TAGS] = {};
+	long long longLived[MAX_TAGS] = {}, longLivedBytes[MAX_TAGS] = {};
+	int oldest[MAX_TAGS];
+	for (int i = 0; i < MAX_TAGS; i++)
+		oldest[i] = frame;
+
+	AllocationHeader largest[MEMORY_REPORT_LARGEST];
+	int largestCount = 0;
+
+	Lock(s_liveLock);
+	for (AllocationHeader* header = s_live; header; header = header->next)
+	{
+		int tag = header->tag;
+		count[tag]++;
+		bytes[tag] += header->size;
+		oldest[tag] = std::min<int>(oldest[tag], header->frame);
+		if (frame - header->frame >= MEMORY_LONG_LIVED_FRAMES)
+		{
+			longLived[tag]++;
+			longLivedBytes[tag] += header->size;
+		}
+
+		//Keep the largest allocations, biggest first.
+		if (largestCount < MEMORY_REPORT_LARGEST || largest[largestCount - 1].size < header->size)
+		{
+			int slot = largestCount < MEMORY_REPORT_LARGEST ? largestCount++ : MEMORY_REPORT_LARGEST - 1;
+			while (slot > 0 && largest[slot - 1].size < header->size)
+			{
+				largest[slot] = largest[slot - 1];
+				slot--;
+			}
+			largest[slot] = *header;
+		}
+	}
+	Unlock(s_liveLock);
+
+	sprintf_s(line, "\n%-32s %10s %12s %14s %12s %16s\n", "Live allocations", "count", "bytes", "oldest (frames)", "long lived", "long lived bytes");
+	fout << line;
+
+	int tagCount = s_tagCount.load(std::memory_order_acquire);
+	for (int i = 0; i < tagCount; i++)
+	{
+		if (count[i] == 0)
+			continue;
+
+		sprintf_s(line, "%-32.32s %10lld %12lld %14d %12lld %16lld\n", i ? s_tags[i].name : "(untagged)",
+			count[i], bytes[i], frame - oldest[i], longLived[i], longLivedBytes[i]);
+		fout << line;
+	}
+
+	sprintf_s(line, "\n%-32s %12s %14s\n", "Largest live allocations", "bytes", "age (frames)");
+	fout << line;
+
+	for (int i = 0; i < largestCount; i++)
+	{
+		sprintf_s(line, "%-32.32s %12zu %14d\n", largest[i].tag ? s_tags[largest[i].tag].name : "(untagged)",
+			largest[i].size, frame - largest[i].frame);
+		fout << line;
+	}
+#endif
+
+	fout.close();
+
+	std::string message = std::string("MemoryTrackerClass: wrote ") + filename + "\n";
+	OutputDebugStringA(message.c_str());
+	return true;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetAllocations
+
+Summary:	Gets the allocations made through operator new so far.
+
+Modifies:	[none].
+
+Returns:	long long
+				the number of allocations.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+long long MemoryTrackerClass::GetAllocations()
+{
+	return s_allocations.load(std::memory_order_relaxed);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetAllocatedBytes
+
+Summary:	Gets the bytes asked for through operator new so far.
+
+Modifies:	[none].
+
+Returns:	long long
+				the number of bytes.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+long long MemoryTrackerClass::GetAllocatedBytes()
+{
+	return s_allocatedBytes.load(std::memory_order_relaxed);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetLiveAllocations
+
+Summary:	Gets the allocations not yet freed.
+
+Modifies:	[none].
+
+Returns:	long long
+				the allocations made less those freed.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+long long MemoryTrackerClass::GetLiveAllocations()
+{
+	return s_allocations.load(std::memory_order_relaxed) - s_frees.load(std::memory_order_relaxed);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetLiveBytes
+
+Summary:	Gets the bytes not yet freed, summed over every tag.
+
+Modifies:	[none].
+
+Returns:	long long
+				the live bytes, or 0 without ENGINE_MEMORY_TRACKING.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+long long MemoryTrackerClass::GetLiveBytes()
+{
+	long long bytes = 0;
+
+	int tagCount = s_tagCount.load(std::memory_order_acquire);
+	for (int i = 0; i < tagCount; i++)
+		bytes += s_tags[i].liveBytes.load(std::memory_order_relaxed);
+
+	return bytes;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		IsTracking
+
+Summary:	Checks whether the tracker was built with ENGINE_MEMORY_TRACKING.
+
+Modifies:	[none].
+
+Returns:	bool
+				are allocations tagged and listed.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool MemoryTrackerClass::IsTracking()
+{
+	return ENGINE_MEMORY_TRACKING != 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Allocate
+
+Summary:	Takes memory from the heap and counts it. When tracking, the
+			memory is preceded by a header tagging it with the calling
+			thread's tag and the current frame, linked into the live list.
+
+Args:		size_t size
+				the number of bytes needed.
+
+Modifies:	[s_allocations, s_allocatedBytes, s_tags].
+
+Returns:	void*
+				the memory, or 0 if the heap is exhausted.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void* MemoryTrackerClass::Allocate(size_t size)
+{
+#if ENGINE_MEMORY_TRACKING
+	AllocationHeader* header = (AllocationHeader*)malloc(HEADER_SIZE + size);
+	if (!header)
+		return 0;
+
+	int tag = t_tag;
+	header->size = size;
+	header->tag = tag;
+	header->frame = s_frame.load(std::memory_order_relaxed);
+	header->prev = 0;
+
+	Lock(s_liveLock);
+	header->next = s_live;
+	if (s_live)
+		s_live->prev = header;
+	s_live = header;
+	Unlock(s_liveLock);
+
+	TagStats& stats = s_tags[tag];
+	stats.allocations.fetch_add(1, std::memory_order_relaxed);
+	stats.bytes.fetch_add((long long)size, std::memory_order_relaxed);
+	stats.liveAllocations.fetch_add(1, std::memory_order_relaxed);
+	stats.liveBytes.fetch_add((long long)size, std::memory_order_relaxed);
+
+	void* memory = (char*)header + HEADER_SIZE;
+#else
+	void* memory = malloc(size ? size : 1);
+	if (!memory)
+		return 0;
+#endif
+
+	s_allocations.fetch_add(1, std::memory_order_relaxed);
+	s_allocatedBytes.fetch_add((long long)size, std::memory_order_relaxed);
+	return memory;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Free
+
+Summary:	Returns memory from Allocate() to the heap and counts it. When
+			tracking, the allocation is unlinked from the live list and
+			taken off the live totals of the tag it was made under.
+
+Args:		void* memory
+				the memory to free, or 0 to do nothing.
+
+Modifies:	[s_frees, s_tags].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void MemoryTrackerClass::Free(void* memory)
+{
+	if (!memory)
+		return;
+
+	s_frees.fetch_add(1, std::memory_order_relaxed);
+
+#if ENGINE_MEMORY_TRACKING
+	AllocationHeader* header = (AllocationHeader*)((char*)memory - HEADER_SIZE);
+
+	Lock(s_liveLock);
+	if (header->prev)
+		header->prev->next = header->next;
+	else
+		s_live = header->next;
+	if (header->next)
+		header->next->prev = header->prev;
+	Unlock(s_liveLock);
+
+	TagStats& stats = s_tags[header->tag];
+	stats.liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+	stats.liveBytes.fetch_sub((long long)header->size, std::memory_order_relaxed);
+
+	free(header);
+#else
+	free(memory);
+#endif
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RegisterTag
+
+Summary:	Finds a tag by name, adding it if it is new. Tags with equal
+			names share an index wherever they are declared.
+
+Args:		const char* name
+				the name of the tag. Must outlive the tracker, such as a
+				string literal.
+
+Modifies:	[s_tags, s_tagCount].
+
+Returns:	int
+				the index of the tag, or 0 (untagged) once MAX_TAGS are used.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+int MemoryTrackerClass::RegisterTag(const char* name)
+{
+	Lock(s_tagLock);
+
+	int tagCount = s_tagCount.load(std::memory_order_relaxed);
+	int tag = 0;
+	for (int i = 1; i < tagCount && !tag; i++)
+	{
+		if (strcmp(s_tags[i].name, name) == 0)
+			tag = i;
+	}
+
+	if (!tag && tagCount < MAX_TAGS)
+	{
+		tag = tagCount;
+		s_tags[tag].name = name;
+		s_tagCount.store(tagCount + 1, std::memory_order_release);
+	}
+
+	Unlock(s_tagLock);
+	return tag;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		SetTag
+
+Summary:	Sets the tag of the calling thread's allocations.
+
+Args:		int tag
+				the index from RegisterTag(), or 0 for untagged.
+
+Modifies:	[none].
+
+Returns:	int
+				the tag that was set before.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+int MemoryTrackerClass::SetTag(int tag)
+{
+	int previous = t_tag;
+	t_tag = tag;
+	return previous;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RollFrame
+
+Summary:	Stores the allocations and bytes of one set of totals since the
+			last frame into a slot of its window.
+
+Args:		TagStats& stats
+				the totals to roll.
+			int slot
+				the slot of the window for this frame.
+
+Modifies:	[stats].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void MemoryTrackerClass::RollFrame(TagStats& stats, int slot)
+{
+	long long allocations = stats.allocations.load(std::memory_order_relaxed);
+	long long bytes = stats.bytes.load(std::memory_order_relaxed);
+
+	stats.frameAllocations[slot] = allocations - stats.lastAllocations;
+	stats.frameBytes[slot] = bytes - stats.lastBytes;
+	stats.lastAllocations = allocations;
+	stats.lastBytes = bytes;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetRates
+
+Summary:	Reads the average allocations and bytes per frame, and the most
+			bytes in any one frame, out of the window of a set of totals.
+
+Args:		const TagStats& stats
+				the totals to read.
+			double& allocations
+				set to the average allocations per frame.
+			double& bytes
+				set to the average bytes per frame.
+			long long& maxBytes
+				set to the most bytes allocated in one frame.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void MemoryTrackerClass::GetRates(const TagStats& stats, double& allocations, double& bytes, long long& maxBytes)
+{
+	int frames = s_frame.load(std::memory_order_relaxed);
+	if (frames > STATS_FRAMES)
+		frames = STATS_FRAMES;
+
+	long long totalAllocations = 0, totalBytes = 0;
+	maxBytes = 0;
+	for (int i = 0; i < frames; i++)
+	{
+		totalAllocations += stats.frameAllocations[i];
+		totalBytes += stats.frameBytes[i];
+		maxBytes = std::max<long long>(maxBytes, stats.frameBytes[i]);
+	}
+
+	allocations = frames ? (double)totalAllocations / frames : 0.0;
+	bytes = frames ? (double)totalBytes / frames : 0.0;
+}
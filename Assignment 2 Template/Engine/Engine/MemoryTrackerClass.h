@@ -0,0 +1,206 @@
+#pragma once
+//======================================================
+//				Filename: MemoryTrackerClass.h
+//======================================================
+
+
+//======================================================
+//					Include Guards.
+//======================================================
+#ifndef _MEMORYTRACKERCLASS_H_
+#define _MEMORYTRACKERCLASS_H_
+
+
+//======================================================
+//				Pre-processing Directives.
+//======================================================
+//Define ENGINE_MEMORY_TRACKING as 1 to tag every heap allocation and keep a
+//list of the live ones. Only the count of allocations and frees is kept
+//otherwise, and every MEMORY_TAG compiles out.
+#ifndef ENGINE_MEMORY_TRACKING
+#define ENGINE_MEMORY_TRACKING 0
+#endif
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <stddef.h>
+#include <atomic>
+#include <string>
+
+
+//======================================================
+//					Tracker Macros.
+//======================================================
+#if ENGINE_MEMORY_TRACKING
+#define MEMORY_CONCAT_INNER(a, b) a##b
+#define MEMORY_CONCAT(a, b) MEMORY_CONCAT_INNER(a, b)
+#define MEMORY_TAG(name) \
+	static const int MEMORY_CONCAT(memoryTagId, __LINE__) = MemoryTrackerClass::RegisterTag(name); \
+	MemoryTagScope MEMORY_CONCAT(memoryTag, __LINE__)(MEMORY_CONCAT(memoryTagId, __LINE__))
+#else
+#define MEMORY_TAG(name)
+#endif
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		MemoryTrackerClass
+
+Summary:	Accounts for every allocation made through the global operator
+			new, which it replaces.
+			The number of allocations and frees and the bytes allocated are
+			always counted. With ENGINE_MEMORY_TRACKING each allocation is
+			also given a small header holding its size, the frame it was
+			made in and the tag of the MEMORY_TAG(name) scope it was made
+			in, and is linked into a list of live allocations. That gives
+			the count and bytes of each tag, and what each tag still holds.
+			EndFrame() rolls the counts into a window of per frame rates.
+			All methods are static, as the allocator is global.
+
+Structs:	TagStats
+				the running totals and per frame window of one tag.
+
+Methods:	==================== PUBLIC ====================
+			static void EndFrame()
+				CALL ONCE PER FRAME on the main thread to roll this frame's
+				allocations into the per frame rates.
+			static std::string GetReport()
+				Use to get the per frame rates and live totals of every tag.
+			static std::string GetOverlay()
+				Use to get a few lines summarising the heap for the screen.
+			static bool WriteReport(const char*)
+				Use to write the report and the age of what every tag still
+				holds to a file.
+
+			static long long GetAllocations()
+				Use to get the allocations made so far.
+			static long long GetAllocatedBytes()
+				Use to get the bytes allocated so far.
+			static long long GetLiveAllocations()
+				Use to get the allocations not yet freed.
+			static long long GetLiveBytes()
+				Use to get the bytes not yet freed. Always 0 without
+				ENGINE_MEMORY_TRACKING, as the size of a freed block is unknown.
+			static bool IsTracking()
+				Use to check whether allocations are tagged and listed.
+
+			static void* Allocate(size_t)
+				Called by the global operator new.
+			static void Free(void*)
+				Called by the global operator delete.
+			static int RegisterTag(const char*)
+				Called by MEMORY_TAG to get the index of a tag name, adding
+				it the first time.
+			static int SetTag(int)
+				Called by MemoryTagScope to tag the calling thread's
+				allocations. Returns the tag it replaces.
+
+			==================== PRIVATE ====================
+			static void RollFrame(TagStats&, int)
+				Used by EndFrame() to store one frame of a set of totals.
+			static void GetRates(const TagStats&, double&, double&, long long&)
+				Used by the reports to read the per frame rates of a set of totals.
+
+Members:	==================== PRIVATE ====================
+			static std::atomic<long long> s_allocations
+				the allocations made so far.
+			static std::atomic<long long> s_allocatedBytes
+				the bytes allocated so far.
+			static std::atomic<long long> s_frees
+				the allocations freed so far.
+			static TagStats s_tags[MAX_TAGS]
+				the totals of every tag, with untagged allocations in the first.
+			static TagStats s_total
+				the per frame window of the whole heap, rolled from the counts above.
+			static std::atomic<int> s_tagCount
+				the number of tags registered.
+			static std::atomic<int> s_frame
+				the number of calls to EndFrame() so far.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class MemoryTrackerClass
+{
+public:
+	static const int MAX_TAGS = 64;
+	static const int STATS_FRAMES = 120;
+
+private:
+	struct TagStats
+	{
+		const char* name;
+		std::atomic<long long> allocations;
+		std::atomic<long long> bytes;
+		std::atomic<long long> liveAllocations;
+		std::atomic<long long> liveBytes;
+		long long lastAllocations, lastBytes;
+		long long frameAllocations[STATS_FRAMES];
+		long long frameBytes[STATS_FRAMES];
+	};
+
+public:
+	static void EndFrame();
+	static std::string GetReport();
+	static std::string GetOverlay();
+	static bool WriteReport(const char* filename);
+
+	static long long GetAllocations();
+	static long long GetAllocatedBytes();
+	static long long GetLiveAllocations();
+	static long long GetLiveBytes();
+	static bool IsTracking();
+
+	static void* Allocate(size_t size);
+	static void Free(void* memory);
+	static int RegisterTag(const char* name);
+	static int SetTag(int tag);
+
+private:
+	static void RollFrame(TagStats& stats, int slot);
+	static void GetRates(const TagStats& stats, double& allocations, double& bytes, long long& maxBytes);
+
+private:
+	static std::atomic<long long> s_allocations;
+	static std::atomic<long long> s_allocatedBytes;
+	static std::atomic<long long> s_frees;
+	static TagStats s_tags[MAX_TAGS];
+	static TagStats s_total;
+	static std::atomic<int> s_tagCount;
+	static std::atomic<int> s_frame;
+};
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		MemoryTagScope
+
+Summary:	Tags the allocations the calling thread makes for the rest of the
+			scope it is created in, then puts the previous tag back. Use
+			through MEMORY_TAG.
+
+Methods:	==================== PUBLIC ====================
+			MemoryTagScope(int)
+				Starts tagging with the index from RegisterTag().
+			~MemoryTagScope()
+				Puts the previous tag back.
+
+Members:	==================== PRIVATE ====================
+			int m_previous
+				the tag in use when the scope started.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class MemoryTagScope
+{
+public:
+	explicit MemoryTagScope(int tag)
+	{
+		m_previous = MemoryTrackerClass::SetTag(tag);
+	}
+
+	~MemoryTagScope()
+	{
+		MemoryTrackerClass::SetTag(m_previous);
+	}
+
+private:
+	int m_previous;
+};
+
+#endif
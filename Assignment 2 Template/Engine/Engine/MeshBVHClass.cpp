@@ -0,0 +1,558 @@
+//======================================================
+//				Filename: MeshBVHClass.cpp
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "MeshBVHClass.h"
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <algorithm>
+#include <math.h>
+#include <new>
+#include <vector>
+
+
+//======================================================
+//					Constants.
+//======================================================
+//How many bins the centroids are sorted into along each axis to price a split.
+const int BVH_BINS = 12;
+
+//Nodes with this many triangles or fewer are always leaves.
+const int BVH_LEAF_TRIANGLES = 2;
+
+//Nodes with more triangles than this are always split, however the split is priced.
+const int BVH_MAX_LEAF_TRIANGLES = 16;
+
+//How deep the hierarchy may go, which bounds the stack a query needs.
+const int BVH_MAX_DEPTH = 48;
+
+//The cost of visiting a node, relative to testing one triangle.
+const float BVH_TRAVERSAL_COST = 1.0f;
+
+
+//The box around a set of points while building.
+struct BuildBounds
+{
+	float min[3];
+	float max[3];
+
+	void Reset()
+	{
+		min[0] = min[1] = min[2] = INFINITY;
+		max[0] = max[1] = max[2] = -INFINITY;
+	}
+
+	void Grow(const float* point)
+	{
+		for (int i = 0; i < 3; i++)
+		{
+			min[i] = std::min(min[i], point[i]);
+			max[i] = std::max(max[i], point[i]);
+		}
+	}
+
+	void Grow(const BuildBounds& other)
+	{
+		for (int i = 0; i < 3; i++)
+		{
+			min[i] = std::min(min[i], other.min[i]);
+			max[i] = std::max(max[i], other.max[i]);
+		}
+	}
+
+	float Area() const
+	{
+		float x = max[0] - min[0], y = max[1] - min[1], z = max[2] - min[2];
+		return (x < 0.0f) ? 0.0f : 2.0f * (x * y + y * z + z * x);
+	}
+};
+
+//A node still to be built, with the range of triangles under it.
+struct BuildTask
+{
+	int node;
+	int first;
+	int count;
+	int depth;
+};
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		MeshBVHClass
+
+Summary:	The default constructor for an empty MeshBVHClass.
+
+Modifies:	[m_nodes, m_nodeCount, m_triangles, m_triangleCount].
+
+Returns:	MeshBVHClass
+				the newly created MeshBVHClass object.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+MeshBVHClass::MeshBVHClass()
+{
+	m_nodes = 0;
+	m_nodeCount = 0;
+	m_triangles = 0;
+	m_triangleCount = 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		MeshBVHClass
+
+Summary:	The reference constructor for a MeshBVHClass.
+
+Args:		const MeshBVHClass& other
+				the MeshBVHClass to create this one in the image of.
+
+Modifies:	[none].
+
+Returns:	MeshBVHClass
+				the newly created MeshBVHClass object.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+MeshBVHClass::MeshBVHClass(const MeshBVHClass& other)
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		~MeshBVHClass
+
+Summary:	The default deconstructor for a MeshBVHClass.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+MeshBVHClass::~MeshBVHClass()
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Initialize
+
+Summary:	Builds the hierarchy over a triangle list, every three positions
+			making one triangle.
+			Each node is split at whichever bin boundary, on whichever axis,
+			gives the lowest surface area cost, or left as a leaf if no split
+			is cheaper than testing all of its triangles.
+
+Args:		const float* positions
+				the x, y and z of the first vertex.
+			size_t stride
+				the bytes from one vertex to the next.
+			int vertexCount
+				the number of vertices, three per triangle.
+
+Modifies:	[m_nodes, m_nodeCount, m_triangles, m_triangleCount].
+
+Returns:	bool
+				was the hierarchy built successfully.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool MeshBVHClass::Initialize(const float* positions, size_t stride, int vertexCount)
+{
+	m_triangleCount = vertexCount / 3;
+	if (m_triangleCount <= 0)
+		return false;
+
+	//Gather the box and centre of every triangle.
+	std::vector<BuildBounds> bounds(m_triangleCount);
+	std::vector<float> centroids(m_triangleCount * 3);
+	std::vector<int> order(m_triangleCount);
+	for (int i = 0; i < m_triangleCount; i++)
+	{
+		bounds[i].Reset();
+		for (int corner = 0; corner < 3; corner++)
+			bounds[i].Grow((const float*)((const char*)positions + (i * 3 + corner) * stride));
+
+		for (int axis = 0; axis < 3; axis++)
+			centroids[i * 3 + axis] = (bounds[i].min[axis] + bounds[i].max[axis]) * 0.5f;
+
+		order[i] = i;
+	}
+
+	//A tree whose leaves each hold at least one triangle has at most 2n - 1 nodes.
+	m_nodes = new (std::nothrow) Node[m_triangleCount * 2 - 1];
+	if (!m_nodes)
+		return false;
+	m_nodeCount = 1;
+
+	std::vector<BuildTask> tasks;
+	BuildTask root = { 0, 0, m_triangleCount, 0 };
+	tasks.push_back(root);
+
+	while (!tasks.empty())
+	{
+		BuildTask task = tasks.back();
+		tasks.pop_back();
+		Node& node = m_nodes[task.node];
+
+		//Find the box of the triangles and of their centres.
+		BuildBounds nodeBounds, centroidBounds;
+		nodeBounds.Reset();
+		centroidBounds.Reset();
+		for (int i = task.first; i < task.first + task.count; i++)
+		{
+			nodeBounds.Grow(bounds[order[i]]);
+			centroidBounds.Grow(&centroids[order[i] * 3]);
+		}
+		node.min = XMFLOAT3(nodeBounds.min[0], nodeBounds.min[1], nodeBounds.min[2]);
+		node.max = XMFLOAT3(nodeBounds.max[0], nodeBounds.max[1], nodeBounds.max[2]);
+		node.first = task.first;
+		node.count = task.count;
+
+		if (task.count <= BVH_LEAF_TRIANGLES || task.depth >= BVH_MAX_DEPTH)
+			continue;
+
+		//Price a split at every bin boundary on every axis.
+		int bestAxis = -1, bestBin = 0;
+		float bestCost = INFINITY;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			float extent = centroidBounds.max[axis] - centroidBounds.min[axis];
+			if (extent <= 0.0f)
+				continue;
+
+			int binCounts[BVH_BINS] = { 0 };
+			BuildBounds binBounds[BVH_BINS];
+			for (int bin = 0; bin < BVH_BINS; bin++)
+				binBounds[bin].Reset();
+
+			float scale = BVH_BINS / extent;
+			for (int i = task.first; i < task.first + task.count; i++)
+			{
+				int bin = std::min((int)((centroids[order[i] * 3 + axis] - centroidBounds.min[axis]) * scale), BVH_BINS - 1);
+				binCounts[bin]++;
+				binBounds[bin].Grow(bounds[order[i]]);
+			}
+
+			//Sweep from the right to get the cost of everything past each boundary.
+			float rightCosts[BVH_BINS];
+			BuildBounds right;
+			right.Reset();
+			int rightCount = 0;
+			for (int bin = BVH_BINS - 1; bin > 0; bin--)
+			{
+				right.Grow(binBounds[bin]);
+				rightCount += binCounts[bin];
+				rightCosts[bin - 1] = rightCount * right.Area();
+			}
+
+			//Then from the left, adding what is before each boundary.
+			BuildBounds left;
+			left.Reset();
+			int leftCount = 0;
+			for (int bin = 0; bin < BVH_BINS - 1; bin++)
+			{
+				left.Grow(binBounds[bin]);
+				leftCount += binCounts[bin];
+				float cost = leftCount * left.Area() + rightCosts[bin];
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestAxis = axis;
+					bestBin = bin;
+				}
+			}
+		}
+
+		//Keep a leaf if testing its triangles is cheaper than any split.
+		float area = nodeBounds.Area();
+		if (task.count <= BVH_MAX_LEAF_TRIANGLES && (bestAxis < 0 || BVH_TRAVERSAL_COST * area + bestCost >= task.count * area))
+			continue;
+
+		//Move the triangles left of the boundary to the front of the range.
+		int leftCount = task.count / 2;
+		if (bestAxis >= 0)
+		{
+			float min = centroidBounds.min[bestAxis];
+			float scale = BVH_BINS / (centroidBounds.max[bestAxis] - min);
+			int* middle = std::partition(&order[task.first], &order[task.first] + task.count,
+				[&](int triangle)
+				{
+					return std::min((int)((centroids[triangle * 3 + bestAxis] - min) * scale), BVH_BINS - 1) <= bestBin;
+				});
+			leftCount = (int)(middle - &order[task.first]);
+		}
+
+		//Fall back to halving the range if every centre landed on one side.
+		if (leftCount == 0 || leftCount == task.count)
+			leftCount = task.count / 2;
+
+		//Turn the node into a parent of two new ones.
+		node.first = m_nodeCount;
+		node.count = 0;
+		m_nodeCount += 2;
+
+		BuildTask rightTask = { node.first + 1, task.first + leftCount, task.count - leftCount, task.depth + 1 };
+		BuildTask leftTask = { node.first, task.first, leftCount, task.depth + 1 };
+		tasks.push_back(rightTask);
+		tasks.push_back(leftTask);
+	}
+
+	//Store the triangles in leaf order, as a corner and two edges.
+	m_triangles = new (std::nothrow) Triangle[m_triangleCount];
+	if (!m_triangles)
+		return false;
+
+	for (int i = 0; i < m_triangleCount; i++)
+	{
+		const char* vertex = (const char*)positions + order[i] * 3 * stride;
+		XMVECTOR v0 = XMLoadFloat3((const XMFLOAT3*)vertex);
+		XMVECTOR v1 = XMLoadFloat3((const XMFLOAT3*)(vertex + stride));
+		XMVECTOR v2 = XMLoadFloat3((const XMFLOAT3*)(vertex + stride * 2));
+
+		XMStoreFloat3(&m_triangles[i].corner, v0);
+		XMStoreFloat3(&m_triangles[i].edge1, v1 - v0);
+		XMStoreFloat3(&m_triangles[i].edge2, v2 - v0);
+	}
+
+	return true;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Shutdown
+
+Summary:	Frees the nodes and triangles of the hierarchy.
+
+Modifies:	[m_nodes, m_nodeCount, m_triangles, m_triangleCount].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void MeshBVHClass::Shutdown()
+{
+	delete[] m_nodes;
+	m_nodes = 0;
+	m_nodeCount = 0;
+
+	delete[] m_triangles;
+	m_triangles = 0;
+	m_triangleCount = 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Intersects
+
+Summary:	Finds the closest triangle a ray hits, nearer than distance.
+			The ray is in the mesh's own space; its direction need not be
+			unit length, as distances are measured in lengths of it, so a
+			ray taken out of world space by an inverse world matrix gives
+			world space distances.
+
+Args:		FXMVECTOR origin
+				the start of the ray in mesh space.
+			FXMVECTOR direction
+				the direction of the ray in mesh space.
+			float& distance
+				the distance to beat, set to the distance of the hit if
+				there is one.
+
+Modifies:	[none].
+
+Returns:	bool
+				did the ray hit a triangle nearer than distance.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool MeshBVHClass::Intersects(FXMVECTOR origin, FXMVECTOR direction, float& distance)
+{
+	return Traverse(origin, direction, distance, false);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		IntersectsAny
+
+Summary:	Checks whether a ray hits any triangle nearer than distance,
+			stopping at the first one found rather than the closest, as
+			is all a shadow or line of sight test needs.
+			The ray is in the mesh's own space, as with Intersects().
+
+Args:		FXMVECTOR origin
+				the start of the ray in mesh space.
+			FXMVECTOR direction
+				the direction of the ray in mesh space.
+			float distance
+				how far along the ray to look.
+
+Modifies:	[none].
+
+Returns:	bool
+				did the ray hit a triangle nearer than distance.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool MeshBVHClass::IntersectsAny(FXMVECTOR origin, FXMVECTOR direction, float distance)
+{
+	return Traverse(origin, direction, distance, true);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Traverse
+
+Summary:	Walks the hierarchy for the triangles a ray hits nearer than
+			distance, nearer child first, skipping nodes the ray enters
+			beyond the closest hit so far.
+
+Args:		FXMVECTOR origin
+				the start of the ray in mesh space.
+			FXMVECTOR direction
+				the direction of the ray in mesh space.
+			float& distance
+				the distance to beat, set to the distance of the closest hit.
+			bool anyHit
+				whether to stop at the first hit rather than the closest.
+
+Modifies:	[none].
+
+Returns:	bool
+				did the ray hit a triangle nearer than distance.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool MeshBVHClass::Traverse(FXMVECTOR origin, FXMVECTOR direction, float& distance, bool anyHit)
+{
+	if (!m_nodes || !m_triangles)
+		return false;
+
+	XMFLOAT3 o, d;
+	XMStoreFloat3(&o, origin);
+	XMStoreFloat3(&d, direction);
+	XMFLOAT3 inverse(1.0f / d.x, 1.0f / d.y, 1.0f / d.z);
+
+	//Gets where the ray enters a node, or false if it misses or enters beyond the limit.
+	auto enterNode = [&](const Node& node, float limit, float& entry)
+	{
+		float x1 = (node.min.x - o.x) * inverse.x, x2 = (node.max.x - o.x) * inverse.x;
+		float y1 = (node.min.y - o.y) * inverse.y, y2 = (node.max.y - o.y) * inverse.y;
+		float z1 = (node.min.z - o.z) * inverse.z, z2 = (node.max.z - o.z) * inverse.z;
+
+		float entryDistance = std::max(std::max(std::min(x1, x2), std::min(y1, y2)), std::min(z1, z2));
+		float exitDistance = std::min(std::min(std::max(x1, x2), std::max(y1, y2)), std::max(z1, z2));
+
+		entry = entryDistance;
+		return exitDistance >= std::max(entryDistance, 0.0f) && entryDistance < limit;
+	};
+
+	float entry;
+	if (!enterNode(m_nodes[0], distance, entry))
+		return false;
+
+	//A node is only pushed once its parent is popped, so the depth bounds the stack.
+	int stack[BVH_MAX_DEPTH + 2];
+	int top = 0;
+	stack[top++] = 0;
+
+	bool hit = false;
+	while (top > 0)
+	{
+		const Node& node = m_nodes[stack[--top]];
+
+		if (node.count > 0)
+		{
+			//Test every triangle of the leaf, keeping the closest.
+			for (int i = node.first; i < node.first + node.count; i++)
+			{
+				const Triangle& triangle = m_triangles[i];
+
+				XMFLOAT3 p(d.y * triangle.edge2.z - d.z * triangle.edge2.y,
+					d.z * triangle.edge2.x - d.x * triangle.edge2.z,
+					d.x * triangle.edge2.y - d.y * triangle.edge2.x);
+				float determinant = triangle.edge1.x * p.x + triangle.edge1.y * p.y + triangle.edge1.z * p.z;
+				if (fabsf(determinant) < 1e-12f)
+					continue;
+				float inverseDeterminant = 1.0f / determinant;
+
+				XMFLOAT3 s(o.x - triangle.corner.x, o.y - triangle.corner.y, o.z - triangle.corner.z);
+				float u = (s.x * p.x + s.y * p.y + s.z * p.z) * inverseDeterminant;
+				if (u < 0.0f || u > 1.0f)
+					continue;
+
+				XMFLOAT3 q(s.y * triangle.edge1.z - s.z * triangle.edge1.y,
+					s.z * triangle.edge1.x - s.x * triangle.edge1.z,
+					s.x * triangle.edge1.y - s.y * triangle.edge1.x);
+				float v = (d.x * q.x + d.y * q.y + d.z * q.z) * inverseDeterminant;
+				if (v < 0.0f || u + v > 1.0f)
+					continue;
+
+				float t = (triangle.edge2.x * q.x + triangle.edge2.y * q.y + triangle.edge2.z * q.z) * inverseDeterminant;
+				if (t >= 0.0f && t < distance)
+				{
+					distance = t;
+					hit = true;
+
+					if (anyHit)
+						return true;
+				}
+			}
+			continue;
+		}
+
+		//Walk whichever children the ray enters before the closest hit, nearest first.
+		float leftEntry, rightEntry;
+		bool enterLeft = enterNode(m_nodes[node.first], distance, leftEntry);
+		bool enterRight = enterNode(m_nodes[node.first + 1], distance, rightEntry);
+
+		if (enterLeft && enterRight)
+		{
+			bool leftFirst = leftEntry <= rightEntry;
+			stack[top++] = leftFirst ? node.first + 1 : node.first;
+			stack[top++] = leftFirst ? node.first : node.first + 1;
+		}
+		else if (enterLeft)
+		{
+			stack[top++] = node.first;
+		}
+		else if (enterRight)
+		{
+			stack[top++] = node.first + 1;
+		}
+	}
+
+	return hit;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetTriangleCount
+
+Summary:	Gets the number of triangles in the hierarchy.
+
+Modifies:	[none].
+
+Returns:	int
+				the number of triangles.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+int MeshBVHClass::GetTriangleCount()
+{
+	return m_triangleCount;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetTriangle
+
+Summary:	Gets the three corners of a triangle of the mesh, in mesh space,
+			so the mesh can be drawn on the CPU without a copy of it.
+
+Args:		int index
+				the triangle to get, from 0 to GetTriangleCount() - 1, in
+				the order of the hierarchy rather than of the mesh.
+			XMFLOAT3* corners
+				an array of 3 to write the corners into.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void MeshBVHClass::GetTriangle(int index, XMFLOAT3 * corners)
+{
+	const Triangle& triangle = m_triangles[index];
+	corners[0] = triangle.corner;
+	corners[1] = XMFLOAT3(triangle.corner.x + triangle.edge1.x, triangle.corner.y + triangle.edge1.y, triangle.corner.z + triangle.edge1.z);
+	corners[2] = XMFLOAT3(triangle.corner.x + triangle.edge2.x, triangle.corner.y + triangle.edge2.y, triangle.corner.z + triangle.edge2.z);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetNodeCount
+
+Summary:	Gets the number of nodes in the hierarchy.
+
+Modifies:	[none].
+
+Returns:	int
+				the number of nodes.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+int MeshBVHClass::GetNodeCount()
+{
+	return m_nodeCount;
+}
@@ -0,0 +1,132 @@
+#pragma once
+//======================================================
+//				Filename: MeshBVHClass.h
+//======================================================
+
+
+//======================================================
+//					Include Guards.
+//======================================================
+#ifndef _MESHBVHCLASS_H_
+#define _MESHBVHCLASS_H_
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <stddef.h>
+#include <DirectXMath.h>
+
+
+//======================================================
+//					Namespaces.
+//======================================================
+using namespace DirectX;
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		MeshBVHClass
+
+Summary:	A bounding volume hierarchy over the triangles of one mesh, in
+			the mesh's own space, for finding exactly which triangle a ray
+			hits first.
+			It is built once when the mesh is loaded, splitting each node
+			where the surface area heuristic says a ray will test the fewest
+			triangles, chosen from a handful of bins along each axis.
+			A query walks the nearer child first and skips any node the ray
+			enters beyond the closest hit found so far.
+			Built on one thread, it can then be queried from any number.
+
+Structs:	Node
+				a box and either its two children or its triangles.
+			Triangle
+				a corner of a triangle and its two edges from that corner.
+
+Methods:	==================== PUBLIC ====================
+			MeshBVHClass()
+				Default constructor.
+			MeshBVHClass(const MeshBVHClass&)
+				Reference constructor.
+			~MeshBVHClass()
+				Default deconstructor.
+
+			bool Initialize(const float*, size_t, int)
+				Call after creation to build the hierarchy over a triangle
+				list of positions.
+			void Shutdown()
+				Call before deletion to free the hierarchy.
+
+			bool Intersects(FXMVECTOR, FXMVECTOR, float&)
+				Use to find the closest triangle a mesh space ray hits,
+				nearer than the given distance.
+			bool IntersectsAny(FXMVECTOR, FXMVECTOR, float)
+				Use to check whether a mesh space ray hits any triangle
+				nearer than the given distance, stopping at the first.
+
+			int GetTriangleCount()
+				Use to get the number of triangles in the hierarchy.
+			void GetTriangle(int, XMFLOAT3*)
+				Use to get the corners of a triangle, such as to draw the
+				mesh into a software depth buffer.
+			int GetNodeCount()
+				Use to get the number of nodes in the hierarchy.
+
+			==================== PRIVATE ====================
+			bool Traverse(FXMVECTOR, FXMVECTOR, float&, bool)
+				Used by Intersects() and IntersectsAny() to walk the hierarchy.
+
+Members:	==================== PRIVATE ====================
+			Node* m_nodes
+				the nodes of the hierarchy, the root first, with each pair
+				of children next to each other.
+			int m_nodeCount
+				the number of nodes.
+			Triangle* m_triangles
+				the triangles, ordered so those of each leaf are together.
+			int m_triangleCount
+				the number of triangles.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class MeshBVHClass
+{
+private:
+	struct Node
+	{
+		XMFLOAT3 min;
+		int first;
+		XMFLOAT3 max;
+		int count;
+	};
+
+	struct Triangle
+	{
+		XMFLOAT3 corner;
+		XMFLOAT3 edge1;
+		XMFLOAT3 edge2;
+	};
+
+public:
+	MeshBVHClass();
+	MeshBVHClass(const MeshBVHClass&);
+	~MeshBVHClass();
+
+	bool Initialize(const float* positions, size_t stride, int vertexCount);
+	void Shutdown();
+
+	bool Intersects(FXMVECTOR origin, FXMVECTOR direction, float& distance);
+	bool IntersectsAny(FXMVECTOR origin, FXMVECTOR direction, float distance);
+
+	int GetTriangleCount();
+	void GetTriangle(int index, XMFLOAT3* corners);
+	int GetNodeCount();
+
+private:
+	bool Traverse(FXMVECTOR origin, FXMVECTOR direction, float& distance, bool anyHit);
+
+private:
+	Node* m_nodes;
+	int m_nodeCount;
+	Triangle* m_triangles;
+	int m_triangleCount;
+};
+
+#endif
@@ -0,0 +1,511 @@
+//======================================================
+//				Filename: OcclusionCullerClass.cpp
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "OcclusionCullerClass.h"
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <algorithm>
+#include <fstream>
+#include <math.h>
+
+
+//======================================================
+//					Constants.
+//======================================================
+//Triangles covering less of the screen than this, in pixels, are skipped.
+const float OCCLUSION_MIN_TRIANGLE_AREA = 1e-4f;
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		OcclusionCullerClass
+
+Summary:	The default constructor for an OcclusionCullerClass.
+
+Modifies:	[m_depth, m_width, m_height, m_viewProjection, m_trianglesDrawn].
+
+Returns:	OcclusionCullerClass
+				the newly created OcclusionCullerClass object.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+OcclusionCullerClass::OcclusionCullerClass()
+{
+	m_depth = 0;
+	m_width = 0;
+	m_height = 0;
+	XMStoreFloat4x4(&m_viewProjection, XMMatrixIdentity());
+	m_trianglesDrawn = 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		OcclusionCullerClass
+
+Summary:	The reference constructor for an OcclusionCullerClass.
+
+Args:		const OcclusionCullerClass& other
+				the OcclusionCullerClass to create this one in the image of.
+
+Modifies:	[none].
+
+Returns:	OcclusionCullerClass
+				the newly created OcclusionCullerClass object.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+OcclusionCullerClass::OcclusionCullerClass(const OcclusionCullerClass& other)
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		~OcclusionCullerClass
+
+Summary:	The default deconstructor for an OcclusionCullerClass.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+OcclusionCullerClass::~OcclusionCullerClass()
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Initialize
+
+Summary:	Allocates an empty depth buffer of the given size. A quarter of
+			the screen's size or less in each direction is plenty, as only
+			large occluders are drawn into it.
+
+Args:		int width
+				the width of the depth buffer in pixels, a multiple of 4 so
+				every row is a whole number of 4 pixel groups.
+			int height
+				the height of the depth buffer in pixels.
+
+Modifies:	[m_depth, m_width, m_height].
+
+Returns:	bool
+				was the depth buffer allocated.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool OcclusionCullerClass::Initialize(int width, int height)
+{
+	if (width <= 0 || height <= 0 || width % 4 != 0)
+		return false;
+
+	m_depth = new float[width * height];
+	if (!m_depth)
+		return false;
+
+	m_width = width;
+	m_height = height;
+	std::fill(m_depth, m_depth + m_width * m_height, 1.0f);
+
+	return true;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Shutdown
+
+Summary:	Frees the depth buffer.
+
+Modifies:	[m_depth, m_width, m_height].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void OcclusionCullerClass::Shutdown()
+{
+	if (m_depth)
+	{
+		delete[] m_depth;
+		m_depth = 0;
+	}
+
+	m_width = 0;
+	m_height = 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Clear
+
+Summary:	Empties the depth buffer and sets the matrix taking world space
+			to clip space for everything drawn and tested until the next
+			Clear().
+
+Args:		CXMMATRIX viewProjection
+				the camera's view matrix multiplied by its projection matrix.
+
+Modifies:	[m_depth, m_viewProjection, m_trianglesDrawn].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void OcclusionCullerClass::Clear(CXMMATRIX viewProjection)
+{
+	std::fill(m_depth, m_depth + m_width * m_height, 1.0f);
+	XMStoreFloat4x4(&m_viewProjection, viewProjection);
+	m_trianglesDrawn = 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		DrawOccluder
+
+Summary:	Draws every triangle of a mesh into the depth buffer, taking
+			its corners straight to clip space with one matrix.
+
+Args:		MeshBVHClass* mesh
+				the triangles of the occluder, in model space.
+			CXMMATRIX worldMatrix
+				the world matrix of the occluder.
+
+Modifies:	[m_depth, m_trianglesDrawn].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void OcclusionCullerClass::DrawOccluder(MeshBVHClass * mesh, CXMMATRIX worldMatrix)
+{
+	XMMATRIX worldViewProjection = XMMatrixMultiply(worldMatrix, XMLoadFloat4x4(&m_viewProjection));
+
+	XMFLOAT3 corners[3];
+	int triangleCount = mesh->GetTriangleCount();
+	for (int i = 0; i < triangleCount; i++)
+	{
+		mesh->GetTriangle(i, corners);
+		DrawClipTriangle(XMVector3Transform(XMLoadFloat3(&corners[0]), worldViewProjection),
+			XMVector3Transform(XMLoadFloat3(&corners[1]), worldViewProjection),
+			XMVector3Transform(XMLoadFloat3(&corners[2]), worldViewProjection));
+	}
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		DrawTriangle
+
+Summary:	Draws one world space triangle into the depth buffer.
+
+Args:		FXMVECTOR a, b, c
+				the corners of the triangle, in either winding.
+
+Modifies:	[m_depth, m_trianglesDrawn].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void OcclusionCullerClass::DrawTriangle(FXMVECTOR a, FXMVECTOR b, FXMVECTOR c)
+{
+	XMMATRIX viewProjection = XMLoadFloat4x4(&m_viewProjection);
+	DrawClipTriangle(XMVector3Transform(a, viewProjection), XMVector3Transform(b, viewProjection), XMVector3Transform(c, viewProjection));
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		IsVisible
+
+Summary:	Checks whether any part of an AABB could be seen past the
+			occluders drawn so far. The box's corners are projected to find
+			the pixels it covers and its nearest depth, and it is visible if
+			that depth is no farther than the depth buffer at any of them.
+			Boxes reaching in front of the near plane are always visible,
+			and boxes wholly off screen never are.
+
+Args:		const BoundingBox& bounds
+				the world space AABB to test.
+
+Modifies:	[none].
+
+Returns:	bool
+				could any of the box be seen.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool OcclusionCullerClass::IsVisible(const BoundingBox & bounds)
+{
+	XMMATRIX viewProjection = XMLoadFloat4x4(&m_viewProjection);
+
+	//Find the screen rectangle and nearest depth of the box's corners.
+	float minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY, minZ = INFINITY;
+	for (int i = 0; i < 8; i++)
+	{
+		XMVECTOR corner = XMVectorSet(bounds.Center.x + ((i & 1) ? bounds.Extents.x : -bounds.Extents.x),
+			bounds.Center.y + ((i & 2) ? bounds.Extents.y : -bounds.Extents.y),
+			bounds.Center.z + ((i & 4) ? bounds.Extents.z : -bounds.Extents.z), 1.0f);
+
+		XMFLOAT4 clip;
+		XMStoreFloat4(&clip, XMVector4Transform(corner, viewProjection));
+		if (clip.z < 0.0f || clip.w <= 0.0f)
+			return true;
+
+		float inverseW = 1.0f / clip.w;
+		float x = (clip.x * inverseW * 0.5f + 0.5f) * m_width;
+		float y = (0.5f - clip.y * inverseW * 0.5f) * m_height;
+		minX = std::min(minX, x);
+		maxX = std::max(maxX, x);
+		minY = std::min(minY, y);
+		maxY = std::max(maxY, y);
+		minZ = std::min(minZ, clip.z * inverseW);
+	}
+
+	//Take every pixel the rectangle touches.
+	float left = std::max(floorf(minX), 0.0f);
+	float right = std::min(floorf(maxX), (float)(m_width - 1));
+	float top = std::max(floorf(minY), 0.0f);
+	float bottom = std::min(floorf(maxY), (float)(m_height - 1));
+	if (left > right || top > bottom)
+		return false;
+
+	//Test 4 pixels at a time, ignoring those either side of the rectangle.
+	XMVECTOR nearest = XMVectorReplicate(minZ);
+	XMVECTOR first = XMVectorReplicate(left);
+	XMVECTOR last = XMVectorReplicate(right);
+	XMVECTOR lanes = XMVectorSet(0.0f, 1.0f, 2.0f, 3.0f);
+
+	int startX = (int)left & ~3;
+	for (int y = (int)top; y <= (int)bottom; y++)
+	{
+		const float* row = m_depth + y * m_width;
+		for (int x = startX; x <= (int)right; x += 4)
+		{
+			XMVECTOR xs = XMVectorAdd(XMVectorReplicate((float)x), lanes);
+			XMVECTOR inside = XMVectorAndInt(XMVectorGreaterOrEqual(xs, first), XMVectorLessOrEqual(xs, last));
+			XMVECTOR seen = XMVectorAndInt(inside, XMVectorLessOrEqual(nearest, XMLoadFloat4((const XMFLOAT4*)(row + x))));
+			if (!XMVector4EqualInt(seen, XMVectorZero()))
+				return true;
+		}
+	}
+
+	return false;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetWidth
+
+Summary:	Gets the width of the depth buffer.
+
+Modifies:	[none].
+
+Returns:	int
+				the width in pixels.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+int OcclusionCullerClass::GetWidth()
+{
+	return m_width;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetHeight
+
+Summary:	Gets the height of the depth buffer.
+
+Modifies:	[none].
+
+Returns:	int
+				the height in pixels.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+int OcclusionCullerClass::GetHeight()
+{
+	return m_height;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetDepthBuffer
+
+Summary:	Gets the depth buffer as drawn so far.
+
+Modifies:	[none].
+
+Returns:	const float*
+				GetWidth() * GetHeight() depths, row by row from the top.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+const float * OcclusionCullerClass::GetDepthBuffer()
+{
+	return m_depth;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetTrianglesDrawn
+
+Summary:	Gets the number of occluder triangles drawn since Clear(),
+			including those wholly clipped away.
+
+Modifies:	[none].
+
+Returns:	int
+				the number of triangles.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+int OcclusionCullerClass::GetTrianglesDrawn()
+{
+	return m_trianglesDrawn;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		SaveDepthBuffer
+
+Summary:	Writes the depth buffer to a greyscale PFM image. The floats are
+			written as they are, so two saves of the same scene match byte
+			for byte.
+
+Args:		const char* filename
+				the file to write.
+
+Modifies:	[none].
+
+Returns:	bool
+				was the file written.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool OcclusionCullerClass::SaveDepthBuffer(const char * filename)
+{
+	std::ofstream fout(filename, std::ios::out | std::ios::binary);
+	if (fout.fail())
+		return false;
+
+	//A negative scale marks the floats as little endian.
+	fout << "Pf\n" << m_width << " " << m_height << "\n-1.0\n";
+
+	//PFM rows run from the bottom up.
+	for (int y = m_height - 1; y >= 0; y--)
+		fout.write((const char*)(m_depth + y * m_width), m_width * sizeof(float));
+
+	return !fout.fail();
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		DrawClipTriangle
+
+Summary:	Clips a clip space triangle to the near plane, keeping the part
+			beyond it as one or two triangles, projects them onto the depth
+			buffer and fills them.
+
+Args:		FXMVECTOR a, b, c
+				the corners of the triangle in clip space.
+
+Modifies:	[m_depth, m_trianglesDrawn].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void OcclusionCullerClass::DrawClipTriangle(FXMVECTOR a, FXMVECTOR b, FXMVECTOR c)
+{
+	m_trianglesDrawn++;
+
+	XMFLOAT4 corners[3];
+	XMStoreFloat4(&corners[0], a);
+	XMStoreFloat4(&corners[1], b);
+	XMStoreFloat4(&corners[2], c);
+
+	//Keep the corners beyond the near plane, and where each edge crosses it.
+	XMFLOAT4 clipped[4];
+	int count = 0;
+	for (int i = 0; i < 3; i++)
+	{
+		const XMFLOAT4& current = corners[i];
+		const XMFLOAT4& next = corners[(i + 1) % 3];
+
+		if (current.z >= 0.0f)
+			clipped[count++] = current;
+
+		if ((current.z >= 0.0f) != (next.z >= 0.0f))
+		{
+			float t = current.z / (current.z - next.z);
+			clipped[count++] = XMFLOAT4(current.x + (next.x - current.x) * t, current.y + (next.y - current.y) * t,
+				0.0f, current.w + (next.w - current.w) * t);
+		}
+	}
+
+	if (count < 3)
+		return;
+
+	//Project onto the depth buffer, pixel centres at half pixels.
+	XMFLOAT3 screen[4];
+	for (int i = 0; i < count; i++)
+	{
+		if (clipped[i].w <= 0.0f)
+			return;
+
+		float inverseW = 1.0f / clipped[i].w;
+		screen[i].x = (clipped[i].x * inverseW * 0.5f + 0.5f) * m_width;
+		screen[i].y = (0.5f - clipped[i].y * inverseW * 0.5f) * m_height;
+		screen[i].z = clipped[i].z * inverseW;
+	}
+
+	RasterizeTriangle(screen);
+	if (count == 4)
+	{
+		XMFLOAT3 second[3] = { screen[0], screen[2], screen[3] };
+		RasterizeTriangle(second);
+	}
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RasterizeTriangle
+
+Summary:	Fills a screen space triangle into the depth buffer, keeping the
+			nearer depth at every pixel it wholly covers. Edge and depth
+			equations are stepped across each row 4 pixels at a time.
+			Each pixel is given the farthest depth the triangle's plane
+			reaches across it, and pixels the triangle only partly covers
+			are left alone, so nothing behind it is wrongly hidden.
+
+Args:		const XMFLOAT3* screen
+				the 3 corners, x and y in pixels and z the depth.
+
+Modifies:	[m_depth].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void OcclusionCullerClass::RasterizeTriangle(const XMFLOAT3 * screen)
+{
+	XMFLOAT3 p0 = screen[0], p1 = screen[1], p2 = screen[2];
+
+	//Either winding is drawn, so turn every triangle to face the same way.
+	float area = (p1.x - p0.x) * (p2.y - p0.y) - (p1.y - p0.y) * (p2.x - p0.x);
+	if (area < 0.0f)
+	{
+		std::swap(p1, p2);
+		area = -area;
+	}
+	if (!(area > OCCLUSION_MIN_TRIANGLE_AREA))
+		return;
+
+	//Find the pixels wholly inside the triangle's box.
+	float left = std::max(ceilf(std::min(p0.x, std::min(p1.x, p2.x))), 0.0f);
+	float right = std::min(floorf(std::max(p0.x, std::max(p1.x, p2.x))) - 1.0f, (float)(m_width - 1));
+	float top = std::max(ceilf(std::min(p0.y, std::min(p1.y, p2.y))), 0.0f);
+	float bottom = std::min(floorf(std::max(p0.y, std::max(p1.y, p2.y))) - 1.0f, (float)(m_height - 1));
+	if (left > right || top > bottom)
+		return;
+
+	//Each edge's equation is positive inside the triangle, and is the weight of the corner opposite it.
+	float a0 = p1.y - p2.y, b0 = p2.x - p1.x, c0 = p1.x * p2.y - p1.y * p2.x;
+	float a1 = p2.y - p0.y, b1 = p0.x - p2.x, c1 = p2.x * p0.y - p2.y * p0.x;
+	float a2 = p0.y - p1.y, b2 = p1.x - p0.x, c2 = p0.x * p1.y - p0.y * p1.x;
+
+	//Moved in by the most each falls across half a pixel, they are positive at a pixel's centre only if all of it is inside.
+	float inner0 = c0 - 0.5f * (fabsf(a0) + fabsf(b0));
+	float inner1 = c1 - 0.5f * (fabsf(a1) + fabsf(b1));
+	float inner2 = c2 - 0.5f * (fabsf(a2) + fabsf(b2));
+
+	//The depth is a plane across the screen, pushed back to its farthest across a pixel.
+	float inverseArea = 1.0f / area;
+	float depthX = (a0 * p0.z + a1 * p1.z + a2 * p2.z) * inverseArea;
+	float depthY = (b0 * p0.z + b1 * p1.z + b2 * p2.z) * inverseArea;
+	float depthC = (c0 * p0.z + c1 * p1.z + c2 * p2.z) * inverseArea + 0.5f * (fabsf(depthX) + fabsf(depthY));
+
+	//Step 4 pixels at a time from the group holding the first pixel.
+	int startX = (int)left & ~3;
+	XMVECTOR lanes = XMVectorSet(0.5f, 1.5f, 2.5f, 3.5f);
+	XMVECTOR xs = XMVectorAdd(XMVectorReplicate((float)startX), lanes);
+	XMVECTOR stepEdge0 = XMVectorReplicate(a0 * 4.0f);
+	XMVECTOR stepEdge1 = XMVectorReplicate(a1 * 4.0f);
+	XMVECTOR stepEdge2 = XMVectorReplicate(a2 * 4.0f);
+	XMVECTOR stepDepth = XMVectorReplicate(depthX * 4.0f);
+	XMVECTOR zero = XMVectorZero();
+
+	for (int y = (int)top; y <= (int)bottom; y++)
+	{
+		float centreY = y + 0.5f;
+		XMVECTOR edge0 = XMVectorMultiplyAdd(XMVectorReplicate(a0), xs, XMVectorReplicate(b0 * centreY + inner0));
+		XMVECTOR edge1 = XMVectorMultiplyAdd(XMVectorReplicate(a1), xs, XMVectorReplicate(b1 * centreY + inner1));
+		XMVECTOR edge2 = XMVectorMultiplyAdd(XMVectorReplicate(a2), xs, XMVectorReplicate(b2 * centreY + inner2));
+		XMVECTOR depth = XMVectorMultiplyAdd(XMVectorReplicate(depthX), xs, XMVectorReplicate(depthY * centreY + depthC));
+
+		float* row = m_depth + y * m_width;
+		for (int x = startX; x <= (int)right; x += 4)
+		{
+			//Pixels outside the box still pass the edge tests correctly, so need no mask.
+			XMVECTOR inside = XMVectorAndInt(XMVectorAndInt(XMVectorGreaterOrEqual(edge0, zero), XMVectorGreaterOrEqual(edge1, zero)),
+				XMVectorGreaterOrEqual(edge2, zero));
+			if (!XMVector4EqualInt(inside, zero))
+			{
+				XMVECTOR stored = XMLoadFloat4((const XMFLOAT4*)(row + x));
+				XMStoreFloat4((XMFLOAT4*)(row + x), XMVectorSelect(stored, XMVectorMin(stored, depth), inside));
+			}
+
+			edge0 = XMVectorAdd(edge0, stepEdge0);
+			edge1 = XMVectorAdd(edge1, stepEdge1);
+			edge2 = XMVectorAdd(edge2, stepEdge2);
+			depth = XMVectorAdd(depth, stepDepth);
+		}
+	}
+}
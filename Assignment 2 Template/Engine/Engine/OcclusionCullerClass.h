@@ -0,0 +1,143 @@
+#pragma once
+//======================================================
+//				Filename: OcclusionCullerClass.h
+//======================================================
+
+
+//======================================================
+//					Include Guards.
+//======================================================
+#ifndef _OCCLUSIONCULLERCLASS_H_
+#define _OCCLUSIONCULLERCLASS_H_
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "MeshBVHClass.h"
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <DirectXMath.h>
+#include <DirectXCollision.h>
+
+
+//======================================================
+//					Namespaces.
+//======================================================
+using namespace DirectX;
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		OcclusionCullerClass
+
+Summary:	A software rasterizer drawing a few large occluder meshes into
+			a coarse depth buffer on the CPU, so any object whose AABB is
+			wholly behind them can be skipped before it is submitted.
+			Each frame it is cleared with the camera's view and projection,
+			the occluders are drawn with DrawOccluder(), then objects are
+			tested with IsVisible().
+			Four pixels of a row are covered and depth tested at once with
+			DirectXMath vectors. A pixel is only covered where a triangle
+			covers all of it, and is given the farthest depth of the
+			triangle across it, and an AABB is tested over every pixel it
+			touches, so an object is only culled when it is hidden, however
+			thin the gap it could be seen through. A pixel split between
+			two triangles is covered by neither, so the seams of an
+			occluder can let an object through that is hidden, but never
+			hide one that isn't.
+			Triangles crossing the near plane are clipped to it.
+			It needs nothing but memory, so a depth buffer can be drawn and
+			saved without a window or device and compared against one
+			saved before.
+
+Methods:	==================== PUBLIC ====================
+			OcclusionCullerClass()
+				Default constructor.
+			OcclusionCullerClass(const OcclusionCullerClass&)
+				Reference constructor.
+			~OcclusionCullerClass()
+				Default deconstructor.
+
+			bool Initialize(int, int)
+				Call after creation to allocate the depth buffer. The width
+				must be a multiple of 4.
+			void Shutdown()
+				Call before deletion to free the depth buffer.
+
+			void Clear(CXMMATRIX)
+				Use at the start of each frame to empty the depth buffer and
+				set the view projection matrix everything is drawn with.
+			void DrawOccluder(MeshBVHClass*, CXMMATRIX)
+				Use to draw every triangle of a mesh with a world matrix.
+			void DrawTriangle(FXMVECTOR, FXMVECTOR, FXMVECTOR)
+				Use to draw one world space triangle.
+			bool IsVisible(const BoundingBox&)
+				Use to check whether any of a world space AABB could be seen
+				past what has been drawn.
+
+			int GetWidth(), GetHeight()
+				Use to get the size of the depth buffer in pixels.
+			const float* GetDepthBuffer()
+				Use to get the depth buffer, row by row from the top, 1 where
+				nothing has been drawn.
+			int GetTrianglesDrawn()
+				Use to get the number of triangles drawn since Clear().
+			bool SaveDepthBuffer(const char*)
+				Use to write the depth buffer to a PFM image, exactly, to
+				compare against a saved one.
+
+			==================== PRIVATE ====================
+			void DrawClipTriangle(FXMVECTOR, FXMVECTOR, FXMVECTOR)
+				Used by DrawOccluder() and DrawTriangle() to clip a clip space
+				triangle to the near plane.
+			void RasterizeTriangle(const XMFLOAT3*)
+				Used by DrawClipTriangle() to fill a screen space triangle.
+
+Members:	==================== PRIVATE ====================
+			float* m_depth
+				the depth buffer, m_width by m_height, from 0 at the near
+				plane to 1 at the far one.
+			int m_width, m_height
+				the size of the depth buffer in pixels.
+			XMFLOAT4X4 m_viewProjection
+				the view projection matrix given to Clear().
+			int m_trianglesDrawn
+				the number of triangles drawn since Clear().
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class OcclusionCullerClass
+{
+public:
+	OcclusionCullerClass();
+	OcclusionCullerClass(const OcclusionCullerClass&);
+	~OcclusionCullerClass();
+
+	bool Initialize(int width, int height);
+	void Shutdown();
+
+	void Clear(CXMMATRIX viewProjection);
+	void DrawOccluder(MeshBVHClass* mesh, CXMMATRIX worldMatrix);
+	void DrawTriangle(FXMVECTOR a, FXMVECTOR b, FXMVECTOR c);
+	bool IsVisible(const BoundingBox& bounds);
+
+	int GetWidth();
+	int GetHeight();
+	const float* GetDepthBuffer();
+	int GetTrianglesDrawn();
+	bool SaveDepthBuffer(const char* filename);
+
+private:
+	void DrawClipTriangle(FXMVECTOR a, FXMVECTOR b, FXMVECTOR c);
+	void RasterizeTriangle(const XMFLOAT3* screen);
+
+private:
+	float* m_depth;
+	int m_width;
+	int m_height;
+	XMFLOAT4X4 m_viewProjection;
+	int m_trianglesDrawn;
+};
+
+#endif
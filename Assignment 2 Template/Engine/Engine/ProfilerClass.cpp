@@ -0,0 +1,465 @@
+//======================================================
+//				Filename: ProfilerClass.cpp
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "ProfilerClass.h"
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <windows.h>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdio.h>
+
+
+//======================================================
+//					Static Members.
+//======================================================
+std::mutex ProfilerClass::s_mutex;
+std::vector<ProfilerClass::ThreadBuffer*> ProfilerClass::s_threads;
+std::atomic<unsigned> ProfilerClass::s_generation(0);
+std::map<const char*, ProfilerClass::ZoneStats> ProfilerClass::s_stats;
+std::vector<ProfilerClass::ZoneEvent> ProfilerClass::s_trace;
+int ProfilerClass::s_traceFramesLeft = 0;
+std::string ProfilerClass::s_traceFilename;
+int ProfilerClass::s_frame = 0;
+
+//The calling thread's buffer and the generation it was created in.
+static thread_local void* t_buffer = 0;
+static thread_local unsigned t_generation = 0;
+
+
+//Converts performance counter ticks to nanoseconds, splitting off whole seconds so nothing overflows.
+static int64_t TicksToNanoseconds(int64_t ticks, int64_t frequency)
+{
+	return (ticks / frequency) * 1000000000LL + (ticks % frequency) * 1000000000LL / frequency;
+}
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		EndFrame
+
+Summary:	Drains every thread's ring buffer, converting each zone from
+			counter ticks to nanoseconds, adds it to the totals of this
+			frame and rolls the totals into the stats window.
+			Writes the trace file once the requested frames are captured.
+
+Modifies:	[s_stats, s_trace, s_traceFramesLeft, s_frame].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void ProfilerClass::EndFrame()
+{
+	int64_t frequency = GetFrequency();
+
+	{
+		std::lock_guard<std::mutex> lock(s_mutex);
+
+		for (size_t i = 0; i < s_threads.size(); i++)
+		{
+			ThreadBuffer* buffer = s_threads[i];
+
+			//Only the owning thread moves head, only this thread moves tail.
+			uint32_t tail = buffer->tail.load(std::memory_order_relaxed);
+			uint32_t head = buffer->head.load(std::memory_order_acquire);
+
+			for (; tail != head; tail++)
+			{
+				ZoneEvent zone = buffer->events[tail % RING_SIZE];
+				zone.start = TicksToNanoseconds(zone.start, frequency);
+				zone.end = TicksToNanoseconds(zone.end, frequency);
+
+				ZoneStats& stats = s_stats[zone.name];
+				stats.currentTotal += (zone.end - zone.start) / 1000000.0;
+				stats.currentCalls++;
+
+				if (s_traceFramesLeft > 0)
+					s_trace.push_back(zone);
+			}
+
+			buffer->tail.store(tail, std::memory_order_release);
+		}
+	}
+
+	//Roll this frame's totals into the window, including zones that did not run.
+	for (std::map<const char*, ZoneStats>::iterator iter = s_stats.begin();
+		iter != s_stats.end();
+		iter++)
+	{
+		ZoneStats& stats = iter->second;
+		stats.frameTotals[s_frame % STATS_FRAMES] = stats.currentTotal;
+		stats.frames = std::min<int>(stats.frames + 1, (int)STATS_FRAMES);
+		stats.lastCalls = stats.currentCalls;
+		stats.currentTotal = 0.0;
+		stats.currentCalls = 0;
+	}
+
+	s_frame++;
+
+	//Write the trace once enough frames have been captured.
+	if (s_traceFramesLeft > 0)
+	{
+		s_traceFramesLeft--;
+		if (s_traceFramesLeft == 0)
+		{
+			WriteTrace();
+			std::vector<ZoneEvent>().swap(s_trace);
+		}
+	}
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		CaptureTrace
+
+Summary:	Starts capturing every zone of the next frames. The trace is
+			written by EndFrame() once they have all been collected.
+			Does nothing if a capture is already running.
+
+Args:		int frames
+				the number of frames to capture.
+			const char* filename
+				the file to write the chrome://tracing JSON to.
+
+Modifies:	[s_trace, s_traceFramesLeft, s_traceFilename].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void ProfilerClass::CaptureTrace(int frames, const char * filename)
+{
+	if (s_traceFramesLeft > 0 || frames <= 0)
+		return;
+
+	s_trace.clear();
+	s_traceFramesLeft = frames;
+	s_traceFilename = filename;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetReport
+
+Summary:	Formats the min, average and max time spent in each zone per
+			frame over the stats window, with its calls in the last frame.
+			Zones with the same name in different files are reported together.
+
+Modifies:	[none].
+
+Returns:	std::string
+				one line per zone, and a line for any dropped zones.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+std::string ProfilerClass::GetReport()
+{
+	std::ostringstream report;
+	char line[256];
+
+	sprintf_s(line, "%-28s %10s %10s %10s %6s\n", "Zone (ms per frame)", "min", "avg", "max", "calls");
+	report << line;
+
+	//Merge zones whose names are equal but stored at different addresses.
+	std::map<std::string, ZoneStats> merged;
+	for (std::map<const char*, ZoneStats>::iterator iter = s_stats.begin();
+		iter != s_stats.end();
+		iter++)
+	{
+		//Every zone is rolled each frame, so the window lines up across zones.
+		ZoneStats& stats = merged[iter->first];
+		for (int i = 0; i < STATS_FRAMES; i++)
+			stats.frameTotals[i] += iter->second.frameTotals[i];
+		stats.frames = std::max<int>(stats.frames, iter->second.frames);
+		stats.lastCalls += iter->second.lastCalls;
+	}
+
+	for (std::map<std::string, ZoneStats>::iterator iter = merged.begin();
+		iter != merged.end();
+		iter++)
+	{
+		const ZoneStats& stats = iter->second;
+		if (stats.frames == 0)
+			continue;
+
+		//Read the last frames the zone has been seen for out of the window.
+		double minimum = stats.frameTotals[(s_frame - 1) % STATS_FRAMES];
+		double maximum = minimum;
+		double total = 0.0;
+		for (int i = 0; i < stats.frames; i++)
+		{
+			double frameTotal = stats.frameTotals[(s_frame - 1 - i) % STATS_FRAMES];
+			minimum = std::min<double>(minimum, frameTotal);
+			maximum = std::max<double>(maximum, frameTotal);
+			total += frameTotal;
+		}
+
+		sprintf_s(line, "%-28s %10.3f %10.3f %10.3f %6d\n", iter->first.c_str(),
+			minimum, total / stats.frames, maximum, stats.lastCalls);
+		report << line;
+	}
+
+	//Report zones lost to full ring buffers.
+	std::lock_guard<std::mutex> lock(s_mutex);
+	uint32_t dropped = 0;
+	for (size_t i = 0; i < s_threads.size(); i++)
+		dropped += s_threads[i]->dropped.load(std::memory_order_relaxed);
+
+	if (dropped > 0)
+	{
+		sprintf_s(line, "%u zones dropped, ring buffers were full\n", dropped);
+		report << line;
+	}
+
+	return report.str();
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		SetThreadName
+
+Summary:	Names the calling thread in captured traces.
+
+Args:		const char* name
+				the name of the thread.
+
+Modifies:	[s_threads].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void ProfilerClass::SetThreadName(const char * name)
+{
+	ThreadBuffer* buffer = GetThreadBuffer();
+
+	std::lock_guard<std::mutex> lock(s_mutex);
+	buffer->name = name;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Shutdown
+
+Summary:	Frees every thread buffer and clears the stats. Threads that
+			profile again afterwards create a new buffer.
+
+Modifies:	[s_threads, s_generation, s_stats, s_trace, s_traceFramesLeft].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void ProfilerClass::Shutdown()
+{
+	std::lock_guard<std::mutex> lock(s_mutex);
+
+	for (size_t i = 0; i < s_threads.size(); i++)
+		delete s_threads[i];
+	s_threads.clear();
+	s_generation++;
+
+	s_stats.clear();
+	std::vector<ZoneEvent>().swap(s_trace);
+	s_traceFramesLeft = 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Now
+
+Summary:	Reads the performance counter.
+
+Modifies:	[none].
+
+Returns:	int64_t
+				the current counter value in ticks.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+int64_t ProfilerClass::Now()
+{
+	LARGE_INTEGER value;
+	QueryPerformanceCounter(&value);
+	return value.QuadPart;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetFrequency
+
+Summary:	Reads the frequency of the performance counter, which is fixed
+			at boot, once.
+
+Modifies:	[none].
+
+Returns:	int64_t
+				the number of counter ticks per second.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+int64_t ProfilerClass::GetFrequency()
+{
+	static const int64_t frequency = []()
+	{
+		LARGE_INTEGER value;
+		QueryPerformanceFrequency(&value);
+		return (int64_t)value.QuadPart;
+	}();
+	return frequency;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Record
+
+Summary:	Pushes a finished zone to the calling thread's ring buffer.
+			The zone is counted as dropped if the buffer is full.
+
+Args:		const char* name
+				the name of the zone.
+			int64_t start
+				the counter value the zone started at.
+			int64_t end
+				the counter value the zone ended at.
+			int depth
+				how many zones this one was nested in.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void ProfilerClass::Record(const char * name, int64_t start, int64_t end, int depth)
+{
+	ThreadBuffer* buffer = GetThreadBuffer();
+	buffer->depth = depth;
+
+	uint32_t head = buffer->head.load(std::memory_order_relaxed);
+	if (head - buffer->tail.load(std::memory_order_acquire) >= RING_SIZE)
+	{
+		buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	ZoneEvent& zone = buffer->events[head % RING_SIZE];
+	zone.name = name;
+	zone.start = start;
+	zone.end = end;
+	zone.threadId = buffer->threadId;
+	zone.depth = depth;
+
+	//Publish the zone to EndFrame().
+	buffer->head.store(head + 1, std::memory_order_release);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		EnterZone
+
+Summary:	Increases the nesting depth of the calling thread.
+
+Modifies:	[none].
+
+Returns:	int
+				the depth of the zone being entered.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+int ProfilerClass::EnterZone()
+{
+	return GetThreadBuffer()->depth++;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		AddFrameTime
+
+Summary:	Adds time measured elsewhere, such as on the GPU, to a zone's
+			totals for this frame. Must be called on the main thread.
+
+Args:		const char* name
+				the name of the zone.
+			double ms
+				the time to add, in milliseconds.
+
+Modifies:	[s_stats].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void ProfilerClass::AddFrameTime(const char * name, double ms)
+{
+	ZoneStats& stats = s_stats[name];
+	stats.currentTotal += ms;
+	stats.currentCalls++;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetThreadBuffer
+
+Summary:	Returns the calling thread's ring buffer, creating and
+			registering one if the thread has none since the last Shutdown().
+
+Modifies:	[s_threads].
+
+Returns:	ThreadBuffer*
+				the calling thread's buffer.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+ProfilerClass::ThreadBuffer * ProfilerClass::GetThreadBuffer()
+{
+	unsigned generation = s_generation.load(std::memory_order_acquire);
+	if (t_buffer && t_generation == generation)
+		return (ThreadBuffer*)t_buffer;
+
+	ThreadBuffer* buffer = new ThreadBuffer();
+	buffer->head = 0;
+	buffer->tail = 0;
+	buffer->dropped = 0;
+	buffer->threadId = GetCurrentThreadId();
+	buffer->depth = 0;
+
+	{
+		std::lock_guard<std::mutex> lock(s_mutex);
+		s_threads.push_back(buffer);
+	}
+
+	t_buffer = buffer;
+	t_generation = generation;
+	return buffer;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		WriteTrace
+
+Summary:	Writes the captured zones as complete events in the
+			chrome://tracing JSON format, in microseconds from the first
+			captured zone, with a name for each named thread. The zones
+			were converted to nanoseconds as they were drained.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void ProfilerClass::WriteTrace()
+{
+	std::ofstream fout;
+	fout.open(s_traceFilename.c_str());
+	if (fout.fail())
+	{
+		OutputDebugStringA("ProfilerClass: could not open the trace file\n");
+		return;
+	}
+
+	int64_t origin = 0;
+	if (!s_trace.empty())
+	{
+		origin = s_trace[0].start;
+		for (size_t i = 1; i < s_trace.size(); i++)
+			origin = std::min<int64_t>(origin, s_trace[i].start);
+	}
+
+	char line[256];
+
+	fout << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+
+	//Name the threads first.
+	bool first = true;
+	{
+		std::lock_guard<std::mutex> lock(s_mutex);
+		for (size_t i = 0; i < s_threads.size(); i++)
+		{
+			if (s_threads[i]->name.empty())
+				continue;
+
+			sprintf_s(line, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+				first ? "" : ",\n", s_threads[i]->threadId, s_threads[i]->name.c_str());
+			fout << line;
+			first = false;
+		}
+	}
+
+	for (size_t i = 0; i < s_trace.size(); i++)
+	{
+		const ZoneEvent& zone = s_trace[i];
+		sprintf_s(line, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+			first ? "" : ",\n", zone.name, zone.threadId,
+			(zone.start - origin) / 1000.0, (zone.end - zone.start) / 1000.0);
+		fout << line;
+		first = false;
+	}
+
+	fout << "\n]}\n";
+	fout.close();
+
+	std::string message = "ProfilerClass: wrote " + s_traceFilename + "\n";
+	OutputDebugStringA(message.c_str());
+}
@@ -0,0 +1,231 @@
+#pragma once
+//======================================================
+//				Filename: ProfilerClass.h
+//======================================================
+
+
+//======================================================
+//					Include Guards.
+//======================================================
+#ifndef _PROFILERCLASS_H_
+#define _PROFILERCLASS_H_
+
+
+//======================================================
+//				Pre-processing Directives.
+//======================================================
+//Define ENGINE_PROFILER_ENABLED as 0 to compile every profiler zone out.
+#ifndef ENGINE_PROFILER_ENABLED
+#define ENGINE_PROFILER_ENABLED 1
+#endif
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <stdint.h>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+//======================================================
+//					Profiler Macros.
+//======================================================
+#if ENGINE_PROFILER_ENABLED
+#define PROFILER_CONCAT_INNER(a, b) a##b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name) ProfileZone PROFILER_CONCAT(profileZone, __LINE__)(name)
+#define PROFILE_THREAD_NAME(name) ProfilerClass::SetThreadName(name)
+#define PROFILE_END_FRAME() ProfilerClass::EndFrame()
+#else
+#define PROFILE_ZONE(name)
+#define PROFILE_THREAD_NAME(name)
+#define PROFILE_END_FRAME()
+#endif
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		ProfilerClass
+
+Summary:	A hierarchical CPU profiler driven by scoped markers.
+			PROFILE_ZONE(name) times the rest of the enclosing scope. Each
+			thread writes its zones into its own single producer ring
+			buffer without locking, and EndFrame() drains every buffer once
+			per frame on the main thread.
+			Zones are timed in performance counter ticks, which EndFrame()
+			converts to nanoseconds with the counter frequency as it drains
+			them, so the stats and traces are in real time units.
+			Keeps a rolling min/avg/max of the time spent in each zone per
+			frame, and can capture frames to a chrome://tracing JSON file.
+			All methods are static so zones can be placed anywhere.
+
+Structs:	ZoneEvent
+				one completed zone, in counter ticks while in a ring buffer
+				and in nanoseconds once drained.
+			ThreadBuffer
+				the ring buffer of zones written by one thread.
+			ZoneStats
+				the rolling per frame totals of one zone.
+
+Methods:	==================== PUBLIC ====================
+			static void EndFrame()
+				CALL ONCE PER FRAME on the main thread to collect the zones
+				finished since the last call.
+			static void CaptureTrace(int, const char*)
+				Use to record the next frames and write them to a trace file.
+			static std::string GetReport()
+				Use to get the rolling min/avg/max of every zone as text.
+			static void SetThreadName(const char*)
+				Use to name the calling thread in captured traces.
+			static void Shutdown()
+				Call once no other thread is profiling to free every buffer.
+
+			static int64_t Now()
+				Returns the current value of the performance counter.
+			static int64_t GetFrequency()
+				Returns the number of performance counter ticks per second.
+			static void Record(const char*, int64_t, int64_t, int)
+				Called by ProfileZone to push a finished zone to the calling
+				thread's buffer.
+			static int EnterZone()
+				Called by ProfileZone to get the nesting depth of a new zone.
+			static void AddFrameTime(const char*, double)
+				Use to add a time measured outside a zone, in ms, to this frame.
+
+			==================== PRIVATE ====================
+			static ThreadBuffer* GetThreadBuffer()
+				Returns the calling thread's buffer, creating it on first use.
+			static void WriteTrace()
+				Writes the captured events to the trace file.
+
+Members:	==================== PRIVATE ====================
+			static std::mutex s_mutex
+				guards the list of thread buffers and the thread names.
+			static std::vector<ThreadBuffer*> s_threads
+				the buffer of every thread that has profiled.
+			static std::atomic<unsigned> s_generation
+				bumped by Shutdown() so threads create a new buffer.
+			static std::map<const char*, ZoneStats> s_stats
+				the rolling totals of each zone, by the address of its name.
+			static std::vector<ZoneEvent> s_trace
+				the events captured so far for the trace file.
+			static int s_traceFramesLeft
+				the frames still to capture.
+			static std::string s_traceFilename
+				the file the trace is written to.
+			static int s_frame
+				the number of calls to EndFrame() so far.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class ProfilerClass
+{
+public:
+	struct ZoneEvent
+	{
+		const char* name;
+		int64_t start, end;
+		uint32_t threadId;
+		int depth;
+	};
+
+private:
+	static const uint32_t RING_SIZE = 4096;
+	static const int STATS_FRAMES = 120;
+
+	struct ThreadBuffer
+	{
+		ZoneEvent events[RING_SIZE];
+		std::atomic<uint32_t> head;
+		std::atomic<uint32_t> tail;
+		std::atomic<uint32_t> dropped;
+		uint32_t threadId;
+		int depth;
+		std::string name;
+	};
+
+	struct ZoneStats
+	{
+		double frameTotals[STATS_FRAMES];
+		double currentTotal;
+		int currentCalls;
+		int lastCalls;
+		int frames;
+	};
+
+public:
+	static void EndFrame();
+	static void CaptureTrace(int frames, const char* filename);
+	static std::string GetReport();
+	static void SetThreadName(const char* name);
+	static void Shutdown();
+
+	static int64_t Now();
+	static int64_t GetFrequency();
+	static void Record(const char* name, int64_t start, int64_t end, int depth);
+	static int EnterZone();
+	static void AddFrameTime(const char* name, double ms);
+
+private:
+	static ThreadBuffer* GetThreadBuffer();
+	static void WriteTrace();
+
+private:
+	static std::mutex s_mutex;
+	static std::vector<ThreadBuffer*> s_threads;
+	static std::atomic<unsigned> s_generation;
+	static std::map<const char*, ZoneStats> s_stats;
+	static std::vector<ZoneEvent> s_trace;
+	static int s_traceFramesLeft;
+	static std::string s_traceFilename;
+	static int s_frame;
+};
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		ProfileZone
+
+Summary:	Times the scope it is created in and records it with the
+			ProfilerClass when it is destroyed. Use through PROFILE_ZONE.
+
+Methods:	==================== PUBLIC ====================
+			ProfileZone(const char*)
+				Starts the zone. name must outlive the profiler, such as a
+				string literal.
+			~ProfileZone()
+				Ends the zone and records it.
+
+Members:	==================== PRIVATE ====================
+			const char* m_name
+				the name of the zone.
+			int64_t m_start
+				the counter value the zone started at.
+			int m_depth
+				how many zones this one is nested in.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class ProfileZone
+{
+public:
+	ProfileZone(const char* name)
+	{
+		m_name = name;
+		m_depth = ProfilerClass::EnterZone();
+		m_start = ProfilerClass::Now();
+	}
+
+	~ProfileZone()
+	{
+		ProfilerClass::Record(m_name, m_start, ProfilerClass::Now(), m_depth);
+	}
+
+private:
+	const char* m_name;
+	int64_t m_start;
+	int m_depth;
+};
+
+#endif
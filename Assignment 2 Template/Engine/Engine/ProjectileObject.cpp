@@ -145,13 +145,14 @@ Method:		Frame
 
 Summary:	A public method to ask this Projectile object to update its
 			position using the velocity stored for this object.
-			Should be called every frame that this object is in existence.
+			Should be called every simulation step that this object is in existence.
 
-Modifies:	[m_Transform].
+Args:		float deltaTime
+				the length of the step, in seconds.
+
+Modifies:	[m_Transform, m_dirty].
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-void ProjectileObject::Frame()
+void ProjectileObject::Frame(float deltaTime)
 {
-	m_transform->x += m_Velocity->x;
-	m_transform->y += m_Velocity->y;
-	m_transform->z += m_Velocity->z;
+	addTransform(m_Velocity->x * deltaTime, m_Velocity->y * deltaTime, m_Velocity->z * deltaTime);
 }
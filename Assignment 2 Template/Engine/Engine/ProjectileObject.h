@@ -10,6 +10,13 @@
 #include "LightGameObject.h"
 
 
+//=================================================
+//					Constants.
+//=================================================
+//The speed projectiles are fired at, in units per second.
+const float PROJECTILE_SPEED = 60.0f;
+
+
 /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
 Class:		ProjectileObject.
 
@@ -37,11 +44,13 @@ Methods:	==================== PUBLIC ====================
 				Use to return a pointer to the velocity of this ProjectileObject.
 
 			Frame(float)
-				Use to update the position of this object using its velocity
+				Use to update the position of this object using its velocity,
+				in units per second, over a simulation step.
 
 Members:	==================== PRIVATE ====================
 			XMFLOAT3* m_Velocity
-				an XMFLOAT3 to store the velocity of this projectileObject.
+				an XMFLOAT3 to store the velocity of this projectileObject,
+				in units per second.
 C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
 class ProjectileObject : public LightGameObject
 {
@@ -56,7 +65,7 @@ public:
 
 	XMFLOAT3* GetVelocity();
 
-	void Frame();
+	virtual void Frame(float deltaTime) override;
 
 private:
 	XMFLOAT3* m_Velocity;
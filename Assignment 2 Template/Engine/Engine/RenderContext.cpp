@@ -0,0 +1,904 @@
+//======================================================
+//				Filename: RenderContext.cpp
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "RenderContext.h"
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <fstream>
+#include <string.h>
+#include <stdio.h>
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		D3DRenderContext
+
+Summary:	The preferred constructor for a D3DRenderContext.
+
+Args:		ID3D11DeviceContext* deviceContext
+				the context to make every call on.
+
+Modifies:	[m_deviceContext].
+
+Returns:	D3DRenderContext
+				the newly created D3DRenderContext object.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+D3DRenderContext::D3DRenderContext(ID3D11DeviceContext * deviceContext)
+{
+	m_deviceContext = deviceContext;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Map
+
+Summary:	Maps a resource for the CPU to write to.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+HRESULT D3DRenderContext::Map(ID3D11Resource* resource, UINT subresource, D3D11_MAP mapType, UINT mapFlags, D3D11_MAPPED_SUBRESOURCE* mappedResource)
+{
+	return m_deviceContext->Map(resource, subresource, mapType, mapFlags, mappedResource);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Unmap
+
+Summary:	Unmaps a resource mapped by Map().
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void D3DRenderContext::Unmap(ID3D11Resource* resource, UINT subresource)
+{
+	m_deviceContext->Unmap(resource, subresource);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		IASetInputLayout
+
+Summary:	Binds the input layout.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void D3DRenderContext::IASetInputLayout(ID3D11InputLayout* inputLayout)
+{
+	m_deviceContext->IASetInputLayout(inputLayout);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		IASetVertexBuffers
+
+Summary:	Binds vertex buffers.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void D3DRenderContext::IASetVertexBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer* const* vertexBuffers, const UINT* strides, const UINT* offsets)
+{
+	m_deviceContext->IASetVertexBuffers(startSlot, numBuffers, vertexBuffers, strides, offsets);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		IASetIndexBuffer
+
+Summary:	Binds the index buffer.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void D3DRenderContext::IASetIndexBuffer(ID3D11Buffer* indexBuffer, DXGI_FORMAT format, UINT offset)
+{
+	m_deviceContext->IASetIndexBuffer(indexBuffer, format, offset);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		IASetPrimitiveTopology
+
+Summary:	Sets the primitive topology.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void D3DRenderContext::IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology)
+{
+	m_deviceContext->IASetPrimitiveTopology(topology);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		VSSetShader
+
+Summary:	Binds the vertex shader.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void D3DRenderContext::VSSetShader(ID3D11VertexShader* vertexShader, ID3D11ClassInstance* const* classInstances, UINT numClassInstances)
+{
+	m_deviceContext->VSSetShader(vertexShader, classInstances, numClassInstances);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		PSSetShader
+
+Summary:	Binds the pixel shader.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void D3DRenderContext::PSSetShader(ID3D11PixelShader* pixelShader, ID3D11ClassInstance* const* classInstances, UINT numClassInstances)
+{
+	m_deviceContext->PSSetShader(pixelShader, classInstances, numClassInstances);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		VSSetConstantBuffers
+
+Summary:	Binds vertex shader constant buffers.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void D3DRenderContext::VSSetConstantBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer* const* constantBuffers)
+{
+	m_deviceContext->VSSetConstantBuffers(startSlot, numBuffers, constantBuffers);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		PSSetConstantBuffers
+
+Summary:	Binds pixel shader constant buffers.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void D3DRenderContext::PSSetConstantBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer* const* constantBuffers)
+{
+	m_deviceContext->PSSetConstantBuffers(startSlot, numBuffers, constantBuffers);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		PSSetShaderResources
+
+Summary:	Binds pixel shader textures.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void D3DRenderContext::PSSetShaderResources(UINT startSlot, UINT numViews, ID3D11ShaderResourceView* const* shaderResourceViews)
+{
+	m_deviceContext->PSSetShaderResources(startSlot, numViews, shaderResourceViews);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		PSSetSamplers
+
+Summary:	Binds pixel shader samplers.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void D3DRenderContext::PSSetSamplers(UINT startSlot, UINT numSamplers, ID3D11SamplerState* const* samplers)
+{
+	m_deviceContext->PSSetSamplers(startSlot, numSamplers, samplers);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RSSetState
+
+Summary:	Binds the rasterizer state.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void D3DRenderContext::RSSetState(ID3D11RasterizerState* rasterizerState)
+{
+	m_deviceContext->RSSetState(rasterizerState);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RSSetViewports
+
+Summary:	Sets the viewports.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void D3DRenderContext::RSSetViewports(UINT numViewports, const D3D11_VIEWPORT* viewports)
+{
+	m_deviceContext->RSSetViewports(numViewports, viewports);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		OMSetRenderTargets
+
+Summary:	Binds the render targets and depth buffer.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void D3DRenderContext::OMSetRenderTargets(UINT numViews, ID3D11RenderTargetView* const* renderTargetViews, ID3D11DepthStencilView* depthStencilView)
+{
+	m_deviceContext->OMSetRenderTargets(numViews, renderTargetViews, depthStencilView);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		OMSetBlendState
+
+Summary:	Binds the blend state.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void D3DRenderContext::OMSetBlendState(ID3D11BlendState* blendState, const FLOAT blendFactor[4], UINT sampleMask)
+{
+	m_deviceContext->OMSetBlendState(blendState, blendFactor, sampleMask);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		OMSetDepthStencilState
+
+Summary:	Binds the depth stencil state.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void D3DRenderContext::OMSetDepthStencilState(ID3D11DepthStencilState* depthStencilState, UINT stencilRef)
+{
+	m_deviceContext->OMSetDepthStencilState(depthStencilState, stencilRef);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		ClearRenderTargetView
+
+Summary:	Clears a render target to a colour.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void D3DRenderContext::ClearRenderTargetView(ID3D11RenderTargetView* renderTargetView, const FLOAT colorRGBA[4])
+{
+	m_deviceContext->ClearRenderTargetView(renderTargetView, colorRGBA);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		ClearDepthStencilView
+
+Summary:	Clears a depth stencil view.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void D3DRenderContext::ClearDepthStencilView(ID3D11DepthStencilView* depthStencilView, UINT clearFlags, FLOAT depth, UINT8 stencil)
+{
+	m_deviceContext->ClearDepthStencilView(depthStencilView, clearFlags, depth, stencil);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		DrawIndexed
+
+Summary:	Draws indexed primitives.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void D3DRenderContext::DrawIndexed(UINT indexCount, UINT startIndexLocation, INT baseVertexLocation)
+{
+	m_deviceContext->DrawIndexed(indexCount, startIndexLocation, baseVertexLocation);
+}
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RecordingRenderContext
+
+Summary:	The preferred constructor for a RecordingRenderContext.
+
+Args:		RenderContext* inner
+				the context to pass calls on to, or 0 to record without a GPU.
+
+Modifies:	[m_inner, m_capturing, m_current, m_lastFrame, bound state].
+
+Returns:	RecordingRenderContext
+				the newly created RecordingRenderContext object.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+RecordingRenderContext::RecordingRenderContext(RenderContext* inner)
+{
+	m_inner = inner;
+	m_capturing = false;
+	memset(&m_current, 0, sizeof(m_current));
+	memset(&m_lastFrame, 0, sizeof(m_lastFrame));
+
+	m_inputLayout = 0;
+	m_topology = 0;
+	m_vertexShader = 0;
+	m_pixelShader = 0;
+	m_rasterizerState = 0;
+	m_blendState = 0;
+	m_depthStencilState = 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		BeginFrame
+
+Summary:	Resets the stats of the frame being recorded, and the log if
+			capturing. Bound state carries over from the last frame, as it
+			does on the device.
+
+Modifies:	[m_current, m_commands].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void RecordingRenderContext::BeginFrame()
+{
+	memset(&m_current, 0, sizeof(m_current));
+	m_commands.clear();
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		EndFrame
+
+Summary:	Keeps the stats of the frame being recorded as the last frame's.
+
+Modifies:	[m_lastFrame].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void RecordingRenderContext::EndFrame()
+{
+	m_lastFrame = m_current;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		SetCapturing
+
+Summary:	Starts or stops logging each command. Stats are counted either
+			way.
+
+Args:		bool capturing
+				should commands be logged.
+
+Modifies:	[m_capturing].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void RecordingRenderContext::SetCapturing(bool capturing)
+{
+	m_capturing = capturing;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		IsCapturing
+
+Summary:	Gets whether commands are being logged.
+
+Modifies:	[none].
+
+Returns:	bool
+				are commands being logged.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool RecordingRenderContext::IsCapturing()
+{
+	return m_capturing;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetCommands
+
+Summary:	Gets the commands logged since the frame began.
+
+Modifies:	[none].
+
+Returns:	const std::vector<Command>&
+				the commands, in the order they were made.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+const std::vector<RecordingRenderContext::Command>& RecordingRenderContext::GetCommands()
+{
+	return m_commands;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetFrameStats
+
+Summary:	Gets the stats of the last frame ended.
+
+Modifies:	[none].
+
+Returns:	const FrameStats&
+				the last frame's stats.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+const RecordingRenderContext::FrameStats& RecordingRenderContext::GetFrameStats()
+{
+	return m_lastFrame;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetSummary
+
+Summary:	Formats the last frame's stats as one line of text.
+
+Modifies:	[none].
+
+Returns:	std::string
+				the stats, ending in a newline.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+std::string RecordingRenderContext::GetSummary()
+{
+	char line[256];
+	sprintf_s(line, sizeof(line),
+		"Render: %d draws, %lld indices, %d state changes (%d redundant), %d bindings, %d maps, %lld bytes mapped\n",
+		m_lastFrame.drawCalls, m_lastFrame.indices, m_lastFrame.stateChanges, m_lastFrame.redundantStateChanges,
+		m_lastFrame.bindings, m_lastFrame.maps, m_lastFrame.bytesMapped);
+	return line;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		WriteLog
+
+Summary:	Writes the last frame's stats followed by every command logged,
+			one per line.
+
+Args:		const char* filename
+				the text file to write.
+
+Modifies:	[none].
+
+Returns:	bool
+				was the file written.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool RecordingRenderContext::WriteLog(const char * filename)
+{
+	std::ofstream fout;
+	fout.open(filename);
+	if (fout.fail())
+	{
+		OutputDebugStringA("RecordingRenderContext: could not open the log file\n");
+		return false;
+	}
+
+	fout << GetSummary();
+
+	char line[256];
+	for (size_t i = 0; i < m_commands.size(); i++)
+	{
+		const Command& command = m_commands[i];
+		sprintf_s(line, sizeof(line), "%5u %-26s slot=%u count=%u bytes=%llu object=%p\n", (unsigned int)i,
+			GetCommandName(command.type), command.slot, command.count, (unsigned long long)command.bytes, command.object);
+		fout << line;
+	}
+
+	fout.close();
+	return true;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetCommandName
+
+Summary:	Gets the name of a command type, matching the RenderContext
+			method that makes it.
+
+Args:		CommandType type
+				the command type.
+
+Modifies:	[none].
+
+Returns:	const char*
+				the name of the command.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+const char * RecordingRenderContext::GetCommandName(CommandType type)
+{
+	static const char* names[COMMAND_TYPE_COUNT] =
+	{
+		"Map", "Unmap", "IASetInputLayout", "IASetVertexBuffers", "IASetIndexBuffer",
+		"IASetPrimitiveTopology", "VSSetShader", "PSSetShader", "VSSetConstantBuffers",
+		"PSSetConstantBuffers", "PSSetShaderResources", "PSSetSamplers", "RSSetState",
+		"RSSetViewports", "OMSetRenderTargets", "OMSetBlendState", "OMSetDepthStencilState",
+		"ClearRenderTargetView", "ClearDepthStencilView", "DrawIndexed"
+	};
+
+	if (type < 0 || type >= COMMAND_TYPE_COUNT)
+		return "Unknown";
+	return names[type];
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Map
+
+Summary:	Counts a map of the whole resource. With no inner context the
+			caller is given scratch memory the size of the buffer.
+
+Args:		ID3D11Resource* resource
+				the resource to map.
+			UINT subresource
+				the subresource to map.
+			D3D11_MAP mapType
+				how the CPU will access the memory.
+			UINT mapFlags
+				what to do if the GPU is busy.
+			D3D11_MAPPED_SUBRESOURCE* mappedResource
+				set to the memory to write to.
+
+Modifies:	[m_current, m_commands, m_scratch].
+
+Returns:	HRESULT
+				the result of the inner Map(), or S_OK.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+HRESULT RecordingRenderContext::Map(ID3D11Resource* resource, UINT subresource, D3D11_MAP mapType, UINT mapFlags, D3D11_MAPPED_SUBRESOURCE* mappedResource)
+{
+	size_t bytes = GetResourceSize(resource);
+	m_current.maps++;
+	m_current.bytesMapped += bytes;
+	Record(COMMAND_MAP, subresource, 1, bytes, resource);
+
+	if (m_inner)
+		return m_inner->Map(resource, subresource, mapType, mapFlags, mappedResource);
+
+	//Headless resources may never have been created, so hand out the largest constant buffer allowed.
+	size_t scratchSize = bytes > 0 ? bytes : D3D11_REQ_CONSTANT_BUFFER_ELEMENT_COUNT * 16;
+	if (m_scratch.size() < scratchSize)
+		m_scratch.resize(scratchSize);
+
+	mappedResource->pData = &m_scratch[0];
+	mappedResource->RowPitch = (UINT)scratchSize;
+	mappedResource->DepthPitch = (UINT)scratchSize;
+	return S_OK;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Unmap
+
+Summary:	Records an unmap.
+
+Modifies:	[m_current, m_commands].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void RecordingRenderContext::Unmap(ID3D11Resource* resource, UINT subresource)
+{
+	Record(COMMAND_UNMAP, subresource, 1, 0, resource);
+
+	if (m_inner)
+		m_inner->Unmap(resource, subresource);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		IASetInputLayout
+
+Summary:	Records a change of input layout.
+
+Modifies:	[m_current, m_commands, m_inputLayout].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void RecordingRenderContext::IASetInputLayout(ID3D11InputLayout* inputLayout)
+{
+	SetState(COMMAND_SET_INPUT_LAYOUT, m_inputLayout, inputLayout);
+
+	if (m_inner)
+		m_inner->IASetInputLayout(inputLayout);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		IASetVertexBuffers
+
+Summary:	Records a binding of vertex buffers.
+
+Modifies:	[m_current, m_commands].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void RecordingRenderContext::IASetVertexBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer* const* vertexBuffers, const UINT* strides, const UINT* offsets)
+{
+	m_current.bindings++;
+	Record(COMMAND_SET_VERTEX_BUFFERS, startSlot, numBuffers, 0, numBuffers > 0 ? vertexBuffers[0] : 0);
+
+	if (m_inner)
+		m_inner->IASetVertexBuffers(startSlot, numBuffers, vertexBuffers, strides, offsets);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		IASetIndexBuffer
+
+Summary:	Records a binding of the index buffer.
+
+Modifies:	[m_current, m_commands].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void RecordingRenderContext::IASetIndexBuffer(ID3D11Buffer* indexBuffer, DXGI_FORMAT format, UINT offset)
+{
+	m_current.bindings++;
+	Record(COMMAND_SET_INDEX_BUFFER, 0, 1, 0, indexBuffer);
+
+	if (m_inner)
+		m_inner->IASetIndexBuffer(indexBuffer, format, offset);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		IASetPrimitiveTopology
+
+Summary:	Records a change of primitive topology.
+
+Modifies:	[m_current, m_commands, m_topology].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void RecordingRenderContext::IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology)
+{
+	SetState(COMMAND_SET_TOPOLOGY, m_topology, (const void*)(size_t)topology);
+
+	if (m_inner)
+		m_inner->IASetPrimitiveTopology(topology);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		VSSetShader
+
+Summary:	Records a change of vertex shader.
+
+Modifies:	[m_current, m_commands, m_vertexShader].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void RecordingRenderContext::VSSetShader(ID3D11VertexShader* vertexShader, ID3D11ClassInstance* const* classInstances, UINT numClassInstances)
+{
+	SetState(COMMAND_SET_VERTEX_SHADER, m_vertexShader, vertexShader);
+
+	if (m_inner)
+		m_inner->VSSetShader(vertexShader, classInstances, numClassInstances);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		PSSetShader
+
+Summary:	Records a change of pixel shader.
+
+Modifies:	[m_current, m_commands, m_pixelShader].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void RecordingRenderContext::PSSetShader(ID3D11PixelShader* pixelShader, ID3D11ClassInstance* const* classInstances, UINT numClassInstances)
+{
+	SetState(COMMAND_SET_PIXEL_SHADER, m_pixelShader, pixelShader);
+
+	if (m_inner)
+		m_inner->PSSetShader(pixelShader, classInstances, numClassInstances);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		VSSetConstantBuffers
+
+Summary:	Records a binding of vertex shader constant buffers.
+
+Modifies:	[m_current, m_commands].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void RecordingRenderContext::VSSetConstantBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer* const* constantBuffers)
+{
+	m_current.bindings++;
+	Record(COMMAND_SET_VS_CONSTANT_BUFFERS, startSlot, numBuffers, 0, numBuffers > 0 ? constantBuffers[0] : 0);
+
+	if (m_inner)
+		m_inner->VSSetConstantBuffers(startSlot, numBuffers, constantBuffers);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		PSSetConstantBuffers
+
+Summary:	Records a binding of pixel shader constant buffers.
+
+Modifies:	[m_current, m_commands].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void RecordingRenderContext::PSSetConstantBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer* const* constantBuffers)
+{
+	m_current.bindings++;
+	Record(COMMAND_SET_PS_CONSTANT_BUFFERS, startSlot, numBuffers, 0, numBuffers > 0 ? constantBuffers[0] : 0);
+
+	if (m_inner)
+		m_inner->PSSetConstantBuffers(startSlot, numBuffers, constantBuffers);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		PSSetShaderResources
+
+Summary:	Records a binding of pixel shader textures.
+
+Modifies:	[m_current, m_commands].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void RecordingRenderContext::PSSetShaderResources(UINT startSlot, UINT numViews, ID3D11ShaderResourceView* const* shaderResourceViews)
+{
+	m_current.bindings++;
+	Record(COMMAND_SET_PS_RESOURCES, startSlot, numViews, 0, numViews > 0 ? shaderResourceViews[0] : 0);
+
+	if (m_inner)
+		m_inner->PSSetShaderResources(startSlot, numViews, shaderResourceViews);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		PSSetSamplers
+
+Summary:	Records a binding of pixel shader samplers.
+
+Modifies:	[m_current, m_commands].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void RecordingRenderContext::PSSetSamplers(UINT startSlot, UINT numSamplers, ID3D11SamplerState* const* samplers)
+{
+	m_current.bindings++;
+	Record(COMMAND_SET_PS_SAMPLERS, startSlot, numSamplers, 0, numSamplers > 0 ? samplers[0] : 0);
+
+	if (m_inner)
+		m_inner->PSSetSamplers(startSlot, numSamplers, samplers);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RSSetState
+
+Summary:	Records a change of rasterizer state.
+
+Modifies:	[m_current, m_commands, m_rasterizerState].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void RecordingRenderContext::RSSetState(ID3D11RasterizerState* rasterizerState)
+{
+	SetState(COMMAND_SET_RASTERIZER_STATE, m_rasterizerState, rasterizerState);
+
+	if (m_inner)
+		m_inner->RSSetState(rasterizerState);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RSSetViewports
+
+Summary:	Records a change of viewports.
+
+Modifies:	[m_current, m_commands].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void RecordingRenderContext::RSSetViewports(UINT numViewports, const D3D11_VIEWPORT* viewports)
+{
+	m_current.stateChanges++;
+	Record(COMMAND_SET_VIEWPORTS, 0, numViewports, 0, viewports);
+
+	if (m_inner)
+		m_inner->RSSetViewports(numViewports, viewports);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		OMSetRenderTargets
+
+Summary:	Records a change of render targets.
+
+Modifies:	[m_current, m_commands].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void RecordingRenderContext::OMSetRenderTargets(UINT numViews, ID3D11RenderTargetView* const* renderTargetViews, ID3D11DepthStencilView* depthStencilView)
+{
+	m_current.stateChanges++;
+	Record(COMMAND_SET_RENDER_TARGETS, 0, numViews, 0, numViews > 0 ? renderTargetViews[0] : 0);
+
+	if (m_inner)
+		m_inner->OMSetRenderTargets(numViews, renderTargetViews, depthStencilView);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		OMSetBlendState
+
+Summary:	Records a change of blend state.
+
+Modifies:	[m_current, m_commands, m_blendState].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void RecordingRenderContext::OMSetBlendState(ID3D11BlendState* blendState, const FLOAT blendFactor[4], UINT sampleMask)
+{
+	SetState(COMMAND_SET_BLEND_STATE, m_blendState, blendState);
+
+	if (m_inner)
+		m_inner->OMSetBlendState(blendState, blendFactor, sampleMask);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		OMSetDepthStencilState
+
+Summary:	Records a change of depth stencil state.
+
+Modifies:	[m_current, m_commands, m_depthStencilState].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void RecordingRenderContext::OMSetDepthStencilState(ID3D11DepthStencilState* depthStencilState, UINT stencilRef)
+{
+	SetState(COMMAND_SET_DEPTH_STENCIL_STATE, m_depthStencilState, depthStencilState);
+
+	if (m_inner)
+		m_inner->OMSetDepthStencilState(depthStencilState, stencilRef);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		ClearRenderTargetView
+
+Summary:	Records a clear of a render target.
+
+Modifies:	[m_current, m_commands].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void RecordingRenderContext::ClearRenderTargetView(ID3D11RenderTargetView* renderTargetView, const FLOAT colorRGBA[4])
+{
+	Record(COMMAND_CLEAR_RENDER_TARGET, 0, 1, 0, renderTargetView);
+
+	if (m_inner)
+		m_inner->ClearRenderTargetView(renderTargetView, colorRGBA);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		ClearDepthStencilView
+
+Summary:	Records a clear of a depth stencil view.
+
+Modifies:	[m_current, m_commands].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void RecordingRenderContext::ClearDepthStencilView(ID3D11DepthStencilView* depthStencilView, UINT clearFlags, FLOAT depth, UINT8 stencil)
+{
+	Record(COMMAND_CLEAR_DEPTH_STENCIL, 0, 1, 0, depthStencilView);
+
+	if (m_inner)
+		m_inner->ClearDepthStencilView(depthStencilView, clearFlags, depth, stencil);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		DrawIndexed
+
+Summary:	Records a draw and counts its indices.
+
+Modifies:	[m_current, m_commands].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void RecordingRenderContext::DrawIndexed(UINT indexCount, UINT startIndexLocation, INT baseVertexLocation)
+{
+	m_current.drawCalls++;
+	m_current.indices += indexCount;
+	Record(COMMAND_DRAW_INDEXED, startIndexLocation, indexCount, 0, 0);
+
+	if (m_inner)
+		m_inner->DrawIndexed(indexCount, startIndexLocation, baseVertexLocation);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Record
+
+Summary:	Counts a command and, while capturing, appends it to the log.
+
+Args:		CommandType type
+				the command made.
+			UINT slot
+				the first slot, subresource or index used.
+			UINT count
+				the number of objects bound, or indices drawn.
+			size_t bytes
+				the bytes moved by the command.
+			const void* object
+				the first object bound or mapped, or 0.
+
+Modifies:	[m_current, m_commands].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void RecordingRenderContext::Record(CommandType type, UINT slot, UINT count, size_t bytes, const void * object)
+{
+	m_current.commands++;
+
+	if (!m_capturing)
+		return;
+
+	Command command = { type, slot, count, bytes, object };
+	m_commands.push_back(command);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		SetState
+
+Summary:	Records a state change, counting it as redundant if the object
+			is already bound.
+
+Args:		CommandType type
+				the command made.
+			const void*& bound
+				the object last bound by this command, updated to object.
+			const void* object
+				the object being bound.
+
+Modifies:	[m_current, m_commands, bound].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void RecordingRenderContext::SetState(CommandType type, const void *& bound, const void * object)
+{
+	m_current.stateChanges++;
+	if (bound == object)
+		m_current.redundantStateChanges++;
+	bound = object;
+
+	Record(type, 0, 1, 0, object);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetResourceSize
+
+Summary:	Gets the size of a buffer. Textures are not mapped by the
+			engine, so count as 0.
+
+Args:		ID3D11Resource* resource
+				the resource, or 0.
+
+Modifies:	[none].
+
+Returns:	size_t
+				the bytes in the buffer.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+size_t RecordingRenderContext::GetResourceSize(ID3D11Resource * resource)
+{
+	if (!resource)
+		return 0;
+
+	D3D11_RESOURCE_DIMENSION dimension;
+	resource->GetType(&dimension);
+	if (dimension != D3D11_RESOURCE_DIMENSION_BUFFER)
+		return 0;
+
+	D3D11_BUFFER_DESC bufferDesc;
+	static_cast<ID3D11Buffer*>(resource)->GetDesc(&bufferDesc);
+	return bufferDesc.ByteWidth;
+}
@@ -0,0 +1,342 @@
+#pragma once
+//======================================================
+//				Filename: RenderContext.h
+//======================================================
+
+
+//======================================================
+//					Include Guards.
+//======================================================
+#ifndef _RENDERCONTEXT_H_
+#define _RENDERCONTEXT_H_
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <d3d11_1.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		RenderContext
+
+Summary:	The interface every model, bitmap and shader submits its
+			per-frame work through. The methods mirror the
+			ID3D11DeviceContext calls the engine makes, so render code reads
+			the same whichever implementation is behind it.
+			Resources are still created on the ID3D11Device.
+
+Methods:	==================== PURE VIRTUAL ====================
+			HRESULT Map(...), void Unmap(...)
+				Maps a resource for writing, and unmaps it.
+			void IASetInputLayout(...), IASetVertexBuffers(...),
+			IASetIndexBuffer(...), IASetPrimitiveTopology(...)
+				Binds the input assembler state.
+			void VSSetShader(...), PSSetShader(...),
+			VSSetConstantBuffers(...), PSSetConstantBuffers(...),
+			PSSetShaderResources(...), PSSetSamplers(...)
+				Binds the shader stages and their resources.
+			void RSSetState(...), RSSetViewports(...)
+				Binds the rasterizer state.
+			void OMSetRenderTargets(...), OMSetBlendState(...),
+			OMSetDepthStencilState(...)
+				Binds the output merger state.
+			void ClearRenderTargetView(...), ClearDepthStencilView(...)
+				Clears a target.
+			void DrawIndexed(...)
+				Draws indexed primitives.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class RenderContext
+{
+public:
+	virtual ~RenderContext() {}
+
+	virtual HRESULT Map(ID3D11Resource* resource, UINT subresource, D3D11_MAP mapType, UINT mapFlags,
+		D3D11_MAPPED_SUBRESOURCE* mappedResource) = 0;
+	virtual void Unmap(ID3D11Resource* resource, UINT subresource) = 0;
+
+	virtual void IASetInputLayout(ID3D11InputLayout* inputLayout) = 0;
+	virtual void IASetVertexBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer* const* vertexBuffers,
+		const UINT* strides, const UINT* offsets) = 0;
+	virtual void IASetIndexBuffer(ID3D11Buffer* indexBuffer, DXGI_FORMAT format, UINT offset) = 0;
+	virtual void IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology) = 0;
+
+	virtual void VSSetShader(ID3D11VertexShader* vertexShader, ID3D11ClassInstance* const* classInstances,
+		UINT numClassInstances) = 0;
+	virtual void PSSetShader(ID3D11PixelShader* pixelShader, ID3D11ClassInstance* const* classInstances,
+		UINT numClassInstances) = 0;
+	virtual void VSSetConstantBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer* const* constantBuffers) = 0;
+	virtual void PSSetConstantBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer* const* constantBuffers) = 0;
+	virtual void PSSetShaderResources(UINT startSlot, UINT numViews, ID3D11ShaderResourceView* const* shaderResourceViews) = 0;
+	virtual void PSSetSamplers(UINT startSlot, UINT numSamplers, ID3D11SamplerState* const* samplers) = 0;
+
+	virtual void RSSetState(ID3D11RasterizerState* rasterizerState) = 0;
+	virtual void RSSetViewports(UINT numViewports, const D3D11_VIEWPORT* viewports) = 0;
+
+	virtual void OMSetRenderTargets(UINT numViews, ID3D11RenderTargetView* const* renderTargetViews,
+		ID3D11DepthStencilView* depthStencilView) = 0;
+	virtual void OMSetBlendState(ID3D11BlendState* blendState, const FLOAT blendFactor[4], UINT sampleMask) = 0;
+	virtual void OMSetDepthStencilState(ID3D11DepthStencilState* depthStencilState, UINT stencilRef) = 0;
+
+	virtual void ClearRenderTargetView(ID3D11RenderTargetView* renderTargetView, const FLOAT colorRGBA[4]) = 0;
+	virtual void ClearDepthStencilView(ID3D11DepthStencilView* depthStencilView, UINT clearFlags, FLOAT depth,
+		UINT8 stencil) = 0;
+
+	virtual void DrawIndexed(UINT indexCount, UINT startIndexLocation, INT baseVertexLocation) = 0;
+};
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		D3DRenderContext
+
+Summary:	The RenderContext used by the engine, passing every call
+			straight on to a D3D11 device context.
+
+Methods:	==================== PUBLIC ====================
+			D3DRenderContext(ID3D11DeviceContext*)
+				Creates the render context for the given device context.
+
+			Map(...), Unmap(...), IASet...(...), VSSet...(...),
+			PSSet...(...), RSSet...(...), OMSet...(...), Clear...(...),
+			DrawIndexed(...)
+				Implementations of RenderContext.
+
+Members:	==================== PRIVATE ====================
+			ID3D11DeviceContext* m_deviceContext
+				the context every call is made on.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class D3DRenderContext : public RenderContext
+{
+public:
+	D3DRenderContext(ID3D11DeviceContext* deviceContext);
+
+	virtual HRESULT Map(ID3D11Resource* resource, UINT subresource, D3D11_MAP mapType, UINT mapFlags,
+		D3D11_MAPPED_SUBRESOURCE* mappedResource) override;
+	virtual void Unmap(ID3D11Resource* resource, UINT subresource) override;
+
+	virtual void IASetInputLayout(ID3D11InputLayout* inputLayout) override;
+	virtual void IASetVertexBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer* const* vertexBuffers,
+		const UINT* strides, const UINT* offsets) override;
+	virtual void IASetIndexBuffer(ID3D11Buffer* indexBuffer, DXGI_FORMAT format, UINT offset) override;
+	virtual void IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology) override;
+
+	virtual void VSSetShader(ID3D11VertexShader* vertexShader, ID3D11ClassInstance* const* classInstances,
+		UINT numClassInstances) override;
+	virtual void PSSetShader(ID3D11PixelShader* pixelShader, ID3D11ClassInstance* const* classInstances,
+		UINT numClassInstances) override;
+	virtual void VSSetConstantBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer* const* constantBuffers) override;
+	virtual void PSSetConstantBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer* const* constantBuffers) override;
+	virtual void PSSetShaderResources(UINT startSlot, UINT numViews, ID3D11ShaderResourceView* const* shaderResourceViews) override;
+	virtual void PSSetSamplers(UINT startSlot, UINT numSamplers, ID3D11SamplerState* const* samplers) override;
+
+	virtual void RSSetState(ID3D11RasterizerState* rasterizerState) override;
+	virtual void RSSetViewports(UINT numViewports, const D3D11_VIEWPORT* viewports) override;
+
+	virtual void OMSetRenderTargets(UINT numViews, ID3D11RenderTargetView* const* renderTargetViews,
+		ID3D11DepthStencilView* depthStencilView) override;
+	virtual void OMSetBlendState(ID3D11BlendState* blendState, const FLOAT blendFactor[4], UINT sampleMask) override;
+	virtual void OMSetDepthStencilState(ID3D11DepthStencilState* depthStencilState, UINT stencilRef) override;
+
+	virtual void ClearRenderTargetView(ID3D11RenderTargetView* renderTargetView, const FLOAT colorRGBA[4]) override;
+	virtual void ClearDepthStencilView(ID3D11DepthStencilView* depthStencilView, UINT clearFlags, FLOAT depth,
+		UINT8 stencil) override;
+
+	virtual void DrawIndexed(UINT indexCount, UINT startIndexLocation, INT baseVertexLocation) override;
+
+private:
+	ID3D11DeviceContext* m_deviceContext;
+};
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		RecordingRenderContext
+
+Summary:	A RenderContext that counts every call into per-frame stats
+			and, while capturing, appends it to an inspectable command log.
+			Calls are passed on to an inner RenderContext if there is one.
+			With no inner context nothing reaches a GPU: Map() hands out
+			scratch memory, so the whole submission path can run headless.
+
+Structs:	Command
+				one recorded call: its type, slot, count, bytes moved and
+				the object bound or drawn with.
+			FrameStats
+				the totals of one frame: draws, indices, state changes,
+				redundant state changes, resource bindings, maps and
+				bytes mapped.
+
+Methods:	==================== PUBLIC ====================
+			RecordingRenderContext(RenderContext*)
+				Creates the recorder around an inner context, or 0 to
+				record without a GPU.
+
+			void BeginFrame()
+				Call at the start of a frame to reset the frame's stats, and
+				the log if capturing.
+			void EndFrame()
+				Call at the end of a frame to keep its stats.
+			void SetCapturing(bool)
+				Use to start or stop logging each command.
+			bool IsCapturing()
+				Use to check whether commands are being logged.
+			const std::vector<Command>& GetCommands()
+				Use to get the commands logged since the frame began.
+			const FrameStats& GetFrameStats()
+				Use to get the stats of the last frame ended.
+			std::string GetSummary()
+				Use to get the last frame's stats as one line of text.
+			bool WriteLog(const char*)
+				Use to write the stats and logged commands to a text file.
+			static const char* GetCommandName(CommandType)
+				Returns the name of a command type.
+
+			Map(...), Unmap(...), IASet...(...), VSSet...(...),
+			PSSet...(...), RSSet...(...), OMSet...(...), Clear...(...),
+			DrawIndexed(...)
+				Implementations of RenderContext.
+
+			==================== PRIVATE ====================
+			void Record(CommandType, UINT, UINT, size_t, const void*)
+				Called by every command to log it while capturing.
+			void SetState(CommandType, const void*&, const void*)
+				Called by state commands to count a change, or a redundant
+				change if the object is already bound.
+			static size_t GetResourceSize(ID3D11Resource*)
+				Returns the bytes in a buffer, or 0 for other resources.
+
+Members:	==================== PRIVATE ====================
+			RenderContext* m_inner
+				the context calls are passed on to, or 0.
+			bool m_capturing
+				are commands being logged.
+			std::vector<Command> m_commands
+				the commands logged since the frame began.
+			FrameStats m_current, m_lastFrame
+				the stats of the frame being recorded, and of the last one
+				ended.
+			const void* m_inputLayout, m_topology, m_vertexShader,
+			m_pixelShader, m_rasterizerState, m_blendState,
+			m_depthStencilState
+				the state last bound, to spot redundant changes.
+			std::vector<unsigned char> m_scratch
+				the memory handed out by Map() with no inner context.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class RecordingRenderContext : public RenderContext
+{
+public:
+	enum CommandType
+	{
+		COMMAND_MAP,
+		COMMAND_UNMAP,
+		COMMAND_SET_INPUT_LAYOUT,
+		COMMAND_SET_VERTEX_BUFFERS,
+		COMMAND_SET_INDEX_BUFFER,
+		COMMAND_SET_TOPOLOGY,
+		COMMAND_SET_VERTEX_SHADER,
+		COMMAND_SET_PIXEL_SHADER,
+		COMMAND_SET_VS_CONSTANT_BUFFERS,
+		COMMAND_SET_PS_CONSTANT_BUFFERS,
+		COMMAND_SET_PS_RESOURCES,
+		COMMAND_SET_PS_SAMPLERS,
+		COMMAND_SET_RASTERIZER_STATE,
+		COMMAND_SET_VIEWPORTS,
+		COMMAND_SET_RENDER_TARGETS,
+		COMMAND_SET_BLEND_STATE,
+		COMMAND_SET_DEPTH_STENCIL_STATE,
+		COMMAND_CLEAR_RENDER_TARGET,
+		COMMAND_CLEAR_DEPTH_STENCIL,
+		COMMAND_DRAW_INDEXED,
+		COMMAND_TYPE_COUNT
+	};
+
+	struct Command
+	{
+		CommandType type;
+		UINT slot;
+		UINT count;
+		size_t bytes;
+		const void* object;
+	};
+
+	struct FrameStats
+	{
+		int drawCalls;
+		long long indices;
+		int stateChanges;
+		int redundantStateChanges;
+		int bindings;
+		int maps;
+		long long bytesMapped;
+		int commands;
+	};
+
+public:
+	RecordingRenderContext(RenderContext* inner);
+
+	void BeginFrame();
+	void EndFrame();
+	void SetCapturing(bool capturing);
+	bool IsCapturing();
+	const std::vector<Command>& GetCommands();
+	const FrameStats& GetFrameStats();
+	std::string GetSummary();
+	bool WriteLog(const char* filename);
+	static const char* GetCommandName(CommandType type);
+
+	virtual HRESULT Map(ID3D11Resource* resource, UINT subresource, D3D11_MAP mapType, UINT mapFlags,
+		D3D11_MAPPED_SUBRESOURCE* mappedResource) override;
+	virtual void Unmap(ID3D11Resource* resource, UINT subresource) override;
+
+	virtual void IASetInputLayout(ID3D11InputLayout* inputLayout) override;
+	virtual void IASetVertexBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer* const* vertexBuffers,
+		const UINT* strides, const UINT* offsets) override;
+	virtual void IASetIndexBuffer(ID3D11Buffer* indexBuffer, DXGI_FORMAT format, UINT offset) override;
+	virtual void IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology) override;
+
+	virtual void VSSetShader(ID3D11VertexShader* vertexShader, ID3D11ClassInstance* const* classInstances,
+		UINT numClassInstances) override;
+	virtual void PSSetShader(ID3D11PixelShader* pixelShader, ID3D11ClassInstance* const* classInstances,
+		UINT numClassInstances) override;
+	virtual void VSSetConstantBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer* const* constantBuffers) override;
+	virtual void PSSetConstantBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer* const* constantBuffers) override;
+	virtual void PSSetShaderResources(UINT startSlot, UINT numViews, ID3D11ShaderResourceView* const* shaderResourceViews) override;
+	virtual void PSSetSamplers(UINT startSlot, UINT numSamplers, ID3D11SamplerState* const* samplers) override;
+
+	virtual void RSSetState(ID3D11RasterizerState* rasterizerState) override;
+	virtual void RSSetViewports(UINT numViewports, const D3D11_VIEWPORT* viewports) override;
+
+	virtual void OMSetRenderTargets(UINT numViews, ID3D11RenderTargetView* const* renderTargetViews,
+		ID3D11DepthStencilView* depthStencilView) override;
+	virtual void OMSetBlendState(ID3D11BlendState* blendState, const FLOAT blendFactor[4], UINT sampleMask) override;
+	virtual void OMSetDepthStencilState(ID3D11DepthStencilState* depthStencilState, UINT stencilRef) override;
+
+	virtual void ClearRenderTargetView(ID3D11RenderTargetView* renderTargetView, const FLOAT colorRGBA[4]) override;
+	virtual void ClearDepthStencilView(ID3D11DepthStencilView* depthStencilView, UINT clearFlags, FLOAT depth,
+		UINT8 stencil) override;
+
+	virtual void DrawIndexed(UINT indexCount, UINT startIndexLocation, INT baseVertexLocation) override;
+
+private:
+	void Record(CommandType type, UINT slot, UINT count, size_t bytes, const void* object);
+	void SetState(CommandType type, const void*& bound, const void* object);
+	static size_t GetResourceSize(ID3D11Resource* resource);
+
+private:
+	RenderContext* m_inner;
+	bool m_capturing;
+	std::vector<Command> m_commands;
+	FrameStats m_current, m_lastFrame;
+	const void* m_inputLayout;
+	const void* m_topology;
+	const void* m_vertexShader;
+	const void* m_pixelShader;
+	const void* m_rasterizerState;
+	const void* m_blendState;
+	const void* m_depthStencilState;
+	std::vector<unsigned char> m_scratch;
+};
+
+#endif
@@ -0,0 +1,359 @@
+//======================================================
+//				Filename: SceneBVHClass.cpp
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "SceneBVHClass.h"
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <algorithm>
+#include <math.h>
+
+
+//======================================================
+//					Constants.
+//======================================================
+//How many bins the centres are sorted into along each axis to price a split.
+const int SCENE_BVH_BINS = 12;
+
+//Nodes with this many boxes or fewer are always leaves.
+const int SCENE_BVH_LEAF_BOXES = 2;
+
+//Nodes with more boxes than this are always split, however the split is priced.
+const int SCENE_BVH_MAX_LEAF_BOXES = 8;
+
+//The cost of visiting a node, relative to testing one box.
+const float SCENE_BVH_TRAVERSAL_COST = 1.0f;
+
+
+//The box around a set of boxes while building.
+struct SceneBuildBounds
+{
+	float min[3];
+	float max[3];
+
+	void Reset()
+	{
+		min[0] = min[1] = min[2] = INFINITY;
+		max[0] = max[1] = max[2] = -INFINITY;
+	}
+
+	void Grow(const SceneBuildBounds& other)
+	{
+		for (int i = 0; i < 3; i++)
+		{
+			min[i] = std::min(min[i], other.min[i]);
+			max[i] = std::max(max[i], other.max[i]);
+		}
+	}
+
+	void Grow(const float* point)
+	{
+		for (int i = 0; i < 3; i++)
+		{
+			min[i] = std::min(min[i], point[i]);
+			max[i] = std::max(max[i], point[i]);
+		}
+	}
+
+	float Area() const
+	{
+		float x = max[0] - min[0], y = max[1] - min[1], z = max[2] - min[2];
+		return (x < 0.0f) ? 0.0f : 2.0f * (x * y + y * z + z * x);
+	}
+};
+
+//A node still to be built, with the range of boxes under it.
+struct SceneBuildTask
+{
+	int node;
+	int first;
+	int count;
+	int depth;
+};
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		SceneBVHClass
+
+Summary:	The default constructor for an empty SceneBVHClass.
+
+Modifies:	[none].
+
+Returns:	SceneBVHClass
+				the newly created SceneBVHClass object.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+SceneBVHClass::SceneBVHClass()
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		SceneBVHClass
+
+Summary:	The reference constructor for a SceneBVHClass.
+
+Args:		const SceneBVHClass& other
+				the SceneBVHClass to create this one in the image of.
+
+Modifies:	[none].
+
+Returns:	SceneBVHClass
+				the newly created SceneBVHClass object.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+SceneBVHClass::SceneBVHClass(const SceneBVHClass& other)
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		~SceneBVHClass
+
+Summary:	The default deconstructor for a SceneBVHClass.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+SceneBVHClass::~SceneBVHClass()
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Shutdown
+
+Summary:	Frees the boxes and nodes of the hierarchy.
+
+Modifies:	[m_bounds, m_nodes, m_items].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void SceneBVHClass::Shutdown()
+{
+	std::vector<BoundingBox>().swap(m_bounds);
+	std::vector<Node>().swap(m_nodes);
+	std::vector<int>().swap(m_items);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Clear
+
+Summary:	Drops every box and node, keeping the memory for the next build.
+
+Modifies:	[m_bounds, m_nodes, m_items].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void SceneBVHClass::Clear()
+{
+	m_bounds.clear();
+	m_nodes.clear();
+	m_items.clear();
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Add
+
+Summary:	Adds a box to be built into the hierarchy by the next Build().
+
+Args:		const BoundingBox& bounds
+				the box to add.
+
+Modifies:	[m_bounds].
+
+Returns:	int
+				the index the box is passed to queries with.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+int SceneBVHClass::Add(const BoundingBox & bounds)
+{
+	m_bounds.push_back(bounds);
+	return (int)m_bounds.size() - 1;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Build
+
+Summary:	Builds the hierarchy over every box added.
+			Each node is split at whichever bin boundary, on whichever axis,
+			gives the lowest surface area cost, or left as a leaf if no split
+			is cheaper than testing all of its boxes.
+
+Modifies:	[m_nodes, m_items].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void SceneBVHClass::Build()
+{
+	m_nodes.clear();
+	m_items.clear();
+
+	int count = (int)m_bounds.size();
+	if (count == 0)
+		return;
+
+	//Gather the box and centre of every box.
+	std::vector<SceneBuildBounds> bounds(count);
+	std::vector<float> centroids(count * 3);
+	m_items.resize(count);
+	for (int i = 0; i < count; i++)
+	{
+		const BoundingBox& box = m_bounds[i];
+		bounds[i].min[0] = box.Center.x - box.Extents.x;
+		bounds[i].min[1] = box.Center.y - box.Extents.y;
+		bounds[i].min[2] = box.Center.z - box.Extents.z;
+		bounds[i].max[0] = box.Center.x + box.Extents.x;
+		bounds[i].max[1] = box.Center.y + box.Extents.y;
+		bounds[i].max[2] = box.Center.z + box.Extents.z;
+
+		centroids[i * 3] = box.Center.x;
+		centroids[i * 3 + 1] = box.Center.y;
+		centroids[i * 3 + 2] = box.Center.z;
+
+		m_items[i] = i;
+	}
+
+	//A tree whose leaves each hold at least one box has at most 2n - 1 nodes.
+	m_nodes.resize(count * 2 - 1);
+	int nodeCount = 1;
+
+	std::vector<SceneBuildTask> tasks;
+	SceneBuildTask root = { 0, 0, count, 0 };
+	tasks.push_back(root);
+
+	while (!tasks.empty())
+	{
+		SceneBuildTask task = tasks.back();
+		tasks.pop_back();
+		Node& node = m_nodes[task.node];
+
+		//Find the box of the boxes and of their centres.
+		SceneBuildBounds nodeBounds, centroidBounds;
+		nodeBounds.Reset();
+		centroidBounds.Reset();
+		for (int i = task.first; i < task.first + task.count; i++)
+		{
+			nodeBounds.Grow(bounds[m_items[i]]);
+			centroidBounds.Grow(&centroids[m_items[i] * 3]);
+		}
+		node.min = XMFLOAT3(nodeBounds.min[0], nodeBounds.min[1], nodeBounds.min[2]);
+		node.max = XMFLOAT3(nodeBounds.max[0], nodeBounds.max[1], nodeBounds.max[2]);
+		node.first = task.first;
+		node.count = task.count;
+
+		if (task.count <= SCENE_BVH_LEAF_BOXES || task.depth >= MAX_DEPTH)
+			continue;
+
+		//Price a split at every bin boundary on every axis.
+		int bestAxis = -1, bestBin = 0;
+		float bestCost = INFINITY;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			float extent = centroidBounds.max[axis] - centroidBounds.min[axis];
+			if (extent <= 0.0f)
+				continue;
+
+			int binCounts[SCENE_BVH_BINS] = { 0 };
+			SceneBuildBounds binBounds[SCENE_BVH_BINS];
+			for (int bin = 0; bin < SCENE_BVH_BINS; bin++)
+				binBounds[bin].Reset();
+
+			float scale = SCENE_BVH_BINS / extent;
+			for (int i = task.first; i < task.first + task.count; i++)
+			{
+				int bin = std::min((int)((centroids[m_items[i] * 3 + axis] - centroidBounds.min[axis]) * scale), SCENE_BVH_BINS - 1);
+				binCounts[bin]++;
+				binBounds[bin].Grow(bounds[m_items[i]]);
+			}
+
+			//Sweep from the right to get the cost of everything past each boundary.
+			float rightCosts[SCENE_BVH_BINS];
+			SceneBuildBounds right;
+			right.Reset();
+			int rightCount = 0;
+			for (int bin = SCENE_BVH_BINS - 1; bin > 0; bin--)
+			{
+				right.Grow(binBounds[bin]);
+				rightCount += binCounts[bin];
+				rightCosts[bin - 1] = rightCount * right.Area();
+			}
+
+			//Then from the left, adding what is before each boundary.
+			SceneBuildBounds left;
+			left.Reset();
+			int leftCount = 0;
+			for (int bin = 0; bin < SCENE_BVH_BINS - 1; bin++)
+			{
+				left.Grow(binBounds[bin]);
+				leftCount += binCounts[bin];
+				float cost = leftCount * left.Area() + rightCosts[bin];
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestAxis = axis;
+					bestBin = bin;
+				}
+			}
+		}
+
+		//Keep a leaf if testing its boxes is cheaper than any split.
+		float area = nodeBounds.Area();
+		if (task.count <= SCENE_BVH_MAX_LEAF_BOXES && (bestAxis < 0 || SCENE_BVH_TRAVERSAL_COST * area + bestCost >= task.count * area))
+			continue;
+
+		//Move the boxes left of the boundary to the front of the range.
+		int leftCount = task.count / 2;
+		if (bestAxis >= 0)
+		{
+			float min = centroidBounds.min[bestAxis];
+			float scale = SCENE_BVH_BINS / (centroidBounds.max[bestAxis] - min);
+			int* middle = std::partition(&m_items[task.first], &m_items[task.first] + task.count,
+				[&](int item)
+				{
+					return std::min((int)((centroids[item * 3 + bestAxis] - min) * scale), SCENE_BVH_BINS - 1) <= bestBin;
+				});
+			leftCount = (int)(middle - &m_items[task.first]);
+		}
+
+		//Fall back to halving the range if every centre landed on one side.
+		if (leftCount == 0 || leftCount == task.count)
+			leftCount = task.count / 2;
+
+		//Turn the node into a parent of two new ones.
+		node.first = nodeCount;
+		node.count = 0;
+		nodeCount += 2;
+
+		SceneBuildTask rightTask = { node.first + 1, task.first + leftCount, task.count - leftCount, task.depth + 1 };
+		SceneBuildTask leftTask = { node.first, task.first, leftCount, task.depth + 1 };
+		tasks.push_back(rightTask);
+		tasks.push_back(leftTask);
+	}
+
+	m_nodes.resize(nodeCount);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetCount
+
+Summary:	Gets the number of boxes in the hierarchy.
+
+Modifies:	[none].
+
+Returns:	int
+				the number of boxes.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+int SceneBVHClass::GetCount()
+{
+	return (int)m_bounds.size();
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetNodeCount
+
+Summary:	Gets the number of nodes in the hierarchy.
+
+Modifies:	[none].
+
+Returns:	int
+				the number of nodes.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+int SceneBVHClass::GetNodeCount()
+{
+	return (int)m_nodes.size();
+}
@@ -0,0 +1,293 @@
+#pragma once
+//======================================================
+//				Filename: SceneBVHClass.h
+//======================================================
+
+
+//======================================================
+//					Include Guards.
+//======================================================
+#ifndef _SCENEBVHCLASS_H_
+#define _SCENEBVHCLASS_H_
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <vector>
+#include <DirectXMath.h>
+#include <DirectXCollision.h>
+
+
+//======================================================
+//					Namespaces.
+//======================================================
+using namespace DirectX;
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		SceneBVHClass
+
+Summary:	A bounding volume hierarchy over the world space boxes of a set
+			of objects that rarely move, such as the static objects of a
+			scene, so a query only visits the boxes near it.
+			It is built with Clear(), Add() for every box, then Build(),
+			splitting each node where the surface area heuristic says the
+			fewest boxes will be tested, and kept until the boxes change.
+			The nodes are stored flat, 32 bytes each, with each pair of
+			children next to each other and the boxes of every leaf
+			together, so a walk down it touches little memory.
+			Built on one thread, it can then be queried from any number.
+
+Structs:	Node
+				a box and either its two children or its boxes.
+
+Methods:	==================== PUBLIC ====================
+			SceneBVHClass()
+				Default constructor.
+			SceneBVHClass(const SceneBVHClass&)
+				Reference constructor.
+			~SceneBVHClass()
+				Default deconstructor.
+
+			void Shutdown()
+				Call before deletion to free the hierarchy.
+
+			void Clear()
+				Use to start a rebuild, dropping every box.
+			int Add(const BoundingBox&)
+				Use to add a box, returning its index, counted from 0 in
+				the order they were added.
+			void Build()
+				Use once every box has been added to build the hierarchy.
+			template<Function> void Query(const BoundingBox&, Function)
+				Use to call the function with the index of every box whose
+				leaf overlaps the given box.
+			template<Function> void Raycast(FXMVECTOR, FXMVECTOR, float&, Function)
+				Use to call the function with the index of every box whose
+				leaf a ray enters nearer than a distance the function may
+				shorten, nearest leaves first.
+
+			int GetCount()
+				Use to get the number of boxes in the hierarchy.
+			int GetNodeCount()
+				Use to get the number of nodes in the hierarchy.
+
+			==================== PRIVATE ====================
+			static bool EnterNode(const Node&, const XMFLOAT3&, const XMFLOAT3&, float, float&)
+				Used by Raycast() to find where a ray enters a node.
+
+Members:	==================== PRIVATE ====================
+			std::vector<BoundingBox> m_bounds
+				every box added, by index.
+			std::vector<Node> m_nodes
+				the nodes of the hierarchy, the root first.
+			std::vector<int> m_items
+				the indices of the boxes, ordered so those of each leaf are
+				together.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class SceneBVHClass
+{
+public:
+	static const int MAX_DEPTH = 48;
+
+private:
+	struct Node
+	{
+		XMFLOAT3 min;
+		int first;
+		XMFLOAT3 max;
+		int count;
+	};
+
+public:
+	SceneBVHClass();
+	SceneBVHClass(const SceneBVHClass&);
+	~SceneBVHClass();
+
+	void Shutdown();
+
+	void Clear();
+	int Add(const BoundingBox& bounds);
+	void Build();
+	template<typename Function> void Query(const BoundingBox& bounds, Function function);
+	template<typename Function> void Raycast(FXMVECTOR origin, FXMVECTOR direction, float& distance, Function function);
+
+	int GetCount();
+	int GetNodeCount();
+
+private:
+	static bool EnterNode(const Node& node, const XMFLOAT3& origin, const XMFLOAT3& inverseDirection, float limit, float& entry);
+
+private:
+	std::vector<BoundingBox> m_bounds;
+	std::vector<Node> m_nodes;
+	std::vector<int> m_items;
+};
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Query
+
+Summary:	Calls function with the index of every box in every leaf that
+			overlaps bounds. The boxes themselves are left for the
+			function to test.
+
+Args:		const BoundingBox& bounds
+				the box to look around.
+			Function function
+				called with the index of each box, as returned by Add().
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+template<typename Function>
+inline void SceneBVHClass::Query(const BoundingBox & bounds, Function function)
+{
+	if (m_nodes.empty())
+		return;
+
+	XMFLOAT3 min(bounds.Center.x - bounds.Extents.x, bounds.Center.y - bounds.Extents.y, bounds.Center.z - bounds.Extents.z);
+	XMFLOAT3 max(bounds.Center.x + bounds.Extents.x, bounds.Center.y + bounds.Extents.y, bounds.Center.z + bounds.Extents.z);
+
+	int stack[MAX_DEPTH + 2];
+	int top = 0;
+	stack[top++] = 0;
+
+	while (top > 0)
+	{
+		const Node& node = m_nodes[stack[--top]];
+		if (node.max.x < min.x || node.min.x > max.x ||
+			node.max.y < min.y || node.min.y > max.y ||
+			node.max.z < min.z || node.min.z > max.z)
+			continue;
+
+		if (node.count > 0)
+		{
+			for (int i = node.first; i < node.first + node.count; i++)
+				function(m_items[i]);
+			continue;
+		}
+
+		stack[top++] = node.first + 1;
+		stack[top++] = node.first;
+	}
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Raycast
+
+Summary:	Walks the hierarchy for the leaves a ray enters nearer than
+			distance, nearer child first, calling function with the index
+			of every box in them. The function may shorten distance as it
+			finds hits, and nodes the ray enters beyond it are skipped.
+
+Args:		FXMVECTOR origin
+				the start of the ray.
+			FXMVECTOR direction
+				the direction of the ray. Distances are measured in lengths
+				of it.
+			float& distance
+				how far along the ray to look, passed on to the function.
+			Function function
+				called with the index of each box and distance, returning
+				whether to go on.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+template<typename Function>
+inline void SceneBVHClass::Raycast(FXMVECTOR origin, FXMVECTOR direction, float & distance, Function function)
+{
+	if (m_nodes.empty())
+		return;
+
+	XMFLOAT3 o, d;
+	XMStoreFloat3(&o, origin);
+	XMStoreFloat3(&d, direction);
+	XMFLOAT3 inverse(1.0f / d.x, 1.0f / d.y, 1.0f / d.z);
+
+	float entry;
+	if (!EnterNode(m_nodes[0], o, inverse, distance, entry))
+		return;
+
+	//Keep where each node was entered, so it can be skipped once a nearer hit is found.
+	int stack[MAX_DEPTH + 2];
+	float entries[MAX_DEPTH + 2];
+	int top = 0;
+	stack[top] = 0;
+	entries[top++] = entry;
+
+	while (top > 0)
+	{
+		top--;
+		if (entries[top] >= distance)
+			continue;
+
+		const Node& node = m_nodes[stack[top]];
+		if (node.count > 0)
+		{
+			for (int i = node.first; i < node.first + node.count; i++)
+			{
+				if (!function(m_items[i], distance))
+					return;
+			}
+			continue;
+		}
+
+		//Walk whichever children the ray enters, nearest first.
+		float leftEntry, rightEntry;
+		bool enterLeft = EnterNode(m_nodes[node.first], o, inverse, distance, leftEntry);
+		bool enterRight = EnterNode(m_nodes[node.first + 1], o, inverse, distance, rightEntry);
+
+		if (enterLeft && enterRight)
+		{
+			bool leftFirst = leftEntry <= rightEntry;
+			stack[top] = leftFirst ? node.first + 1 : node.first;
+			entries[top++] = leftFirst ? rightEntry : leftEntry;
+			stack[top] = leftFirst ? node.first : node.first + 1;
+			entries[top++] = leftFirst ? leftEntry : rightEntry;
+		}
+		else if (enterLeft)
+		{
+			stack[top] = node.first;
+			entries[top++] = leftEntry;
+		}
+		else if (enterRight)
+		{
+			stack[top] = node.first + 1;
+			entries[top++] = rightEntry;
+		}
+	}
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		EnterNode
+
+Summary:	Finds where a ray enters the box of a node with a slab test.
+
+Args:		const Node& node
+				the node to test.
+			const XMFLOAT3& origin
+				the start of the ray.
+			const XMFLOAT3& inverseDirection
+				1 over each component of the direction of the ray.
+			float limit
+				how far along the ray to look.
+			float& entry
+				set to where the ray enters the box.
+
+Returns:	bool
+				does the ray pass through the box, entering it before limit.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+inline bool SceneBVHClass::EnterNode(const Node & node, const XMFLOAT3 & origin, const XMFLOAT3 & inverseDirection, float limit, float & entry)
+{
+	float x1 = (node.min.x - origin.x) * inverseDirection.x, x2 = (node.max.x - origin.x) * inverseDirection.x;
+	float y1 = (node.min.y - origin.y) * inverseDirection.y, y2 = (node.max.y - origin.y) * inverseDirection.y;
+	float z1 = (node.min.z - origin.z) * inverseDirection.z, z2 = (node.max.z - origin.z) * inverseDirection.z;
+
+	float entryX = x1 < x2 ? x1 : x2, exitX = x1 < x2 ? x2 : x1;
+	float entryY = y1 < y2 ? y1 : y2, exitY = y1 < y2 ? y2 : y1;
+	float entryZ = z1 < z2 ? z1 : z2, exitZ = z1 < z2 ? z2 : z1;
+
+	float entryDistance = entryX > entryY ? (entryX > entryZ ? entryX : entryZ) : (entryY > entryZ ? entryY : entryZ);
+	float exitDistance = exitX < exitY ? (exitX < exitZ ? exitX : exitZ) : (exitY < exitZ ? exitY : exitZ);
+
+	entry = entryDistance;
+	return exitDistance >= (entryDistance > 0.0f ? entryDistance : 0.0f) && entryDistance < limit;
+}
+
+#endif
@@ -0,0 +1,361 @@
+//======================================================
+//				Filename: SpatialHashGridClass.cpp
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "SpatialHashGridClass.h"
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <math.h>
+
+
+//======================================================
+//					Constants.
+//======================================================
+//Boxes covering more cells than this are tested by every query instead.
+const int GRID_MAX_CELLS_PER_BOX = 64;
+
+//The table is kept at least this many times larger than the cells in it,
+//so probes stay short.
+const int GRID_TABLE_SLACK = 2;
+
+//The smallest table built.
+const int GRID_MIN_TABLE_SIZE = 64;
+
+//Cell coordinates are clamped to this, so far off boxes cannot overflow them.
+const float GRID_MAX_CELL_COORDINATE = 1048576.0f;
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		SpatialHashGridClass
+
+Summary:	The default constructor for an empty SpatialHashGridClass.
+
+Modifies:	[m_cellSize, m_inverseCellSize, m_cellCount].
+
+Returns:	SpatialHashGridClass
+				the newly created SpatialHashGridClass object.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+SpatialHashGridClass::SpatialHashGridClass()
+{
+	m_cellSize = 1.0f;
+	m_inverseCellSize = 1.0f;
+	m_cellCount = 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		SpatialHashGridClass
+
+Summary:	The reference constructor for a SpatialHashGridClass.
+
+Args:		const SpatialHashGridClass& other
+				the SpatialHashGridClass to create this one in the image of.
+
+Modifies:	[none].
+
+Returns:	SpatialHashGridClass
+				the newly created SpatialHashGridClass object.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+SpatialHashGridClass::SpatialHashGridClass(const SpatialHashGridClass& other)
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		~SpatialHashGridClass
+
+Summary:	The default deconstructor for a SpatialHashGridClass.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+SpatialHashGridClass::~SpatialHashGridClass()
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Initialize
+
+Summary:	Sets the size of the cells. It works best at about the size of
+			the boxes most often added, so most are in only a few cells.
+
+Args:		float cellSize
+				the length of each side of a cell, in world units.
+
+Modifies:	[m_cellSize, m_inverseCellSize].
+
+Returns:	bool
+				was the cell size usable.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool SpatialHashGridClass::Initialize(float cellSize)
+{
+	if (!(cellSize > 0.0f))
+		return false;
+
+	m_cellSize = cellSize;
+	m_inverseCellSize = 1.0f / cellSize;
+	Clear();
+
+	return true;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Shutdown
+
+Summary:	Frees the table and every list.
+
+Modifies:	[m_boxes, m_oversized, m_cells, m_entrySlots, m_cellBoxes, m_cellCount].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void SpatialHashGridClass::Shutdown()
+{
+	std::vector<Box>().swap(m_boxes);
+	std::vector<int>().swap(m_oversized);
+	std::vector<Cell>().swap(m_cells);
+	std::vector<int>().swap(m_entrySlots);
+	std::vector<int>().swap(m_cellBoxes);
+	m_cellCount = 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Clear
+
+Summary:	Drops every box, keeping the memory of the lists for the next
+			build.
+
+Modifies:	[m_boxes, m_oversized, m_cells, m_entrySlots, m_cellBoxes, m_cellCount].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void SpatialHashGridClass::Clear()
+{
+	m_boxes.clear();
+	m_oversized.clear();
+	m_cells.clear();
+	m_entrySlots.clear();
+	m_cellBoxes.clear();
+	m_cellCount = 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Add
+
+Summary:	Adds a box to be sorted into cells by the next Build().
+
+Args:		const BoundingBox& bounds
+				the box to add.
+
+Modifies:	[m_boxes].
+
+Returns:	int
+				the index the box is passed to queries with.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+int SpatialHashGridClass::Add(const BoundingBox & bounds)
+{
+	Box box;
+	GetCellRange(bounds, box.cellMin, box.cellMax);
+
+	//Only how many cells up to one more than a box may be listed in matters.
+	long long cells = (long long)(box.cellMax[0] - box.cellMin[0] + 1) *
+		(box.cellMax[1] - box.cellMin[1] + 1) * (box.cellMax[2] - box.cellMin[2] + 1);
+	box.cells = cells > GRID_MAX_CELLS_PER_BOX ? GRID_MAX_CELLS_PER_BOX + 1 : (int)cells;
+
+	m_boxes.push_back(box);
+
+	return (int)m_boxes.size() - 1;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Build
+
+Summary:	Sorts every box added into the cells it overlaps.
+			First every cell of every box is found in the table, or added
+			to it, and counted, remembering the slot. A running total then
+			gives each cell where its boxes start, and a single pass over
+			the remembered slots places each box in its cell.
+
+Modifies:	[m_oversized, m_cells, m_entrySlots, m_cellBoxes, m_cellCount].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void SpatialHashGridClass::Build()
+{
+	m_oversized.clear();
+	m_entrySlots.clear();
+	m_cellCount = 0;
+
+	//Count the cells every box covers, setting aside those covering too many.
+	int entries = 0;
+	for (int i = 0; i < (int)m_boxes.size(); i++)
+	{
+		if (m_boxes[i].cells > GRID_MAX_CELLS_PER_BOX)
+			m_oversized.push_back(i);
+		else
+			entries += m_boxes[i].cells;
+	}
+
+	//Size the table so it is never more than half full.
+	int tableSize = GRID_MIN_TABLE_SIZE;
+	while (tableSize < entries * GRID_TABLE_SLACK)
+		tableSize *= 2;
+
+	Cell empty;
+	empty.x = empty.y = empty.z = 0;
+	empty.start = 0;
+	empty.count = 0;
+	m_cells.assign(tableSize, empty);
+
+	//Find the slot of each cell of each box and count the boxes in each.
+	m_entrySlots.reserve(entries);
+	for (int i = 0; i < (int)m_boxes.size(); i++)
+	{
+		const Box& box = m_boxes[i];
+		if (box.cells > GRID_MAX_CELLS_PER_BOX)
+			continue;
+
+		for (int x = box.cellMin[0]; x <= box.cellMax[0]; x++)
+		{
+			for (int y = box.cellMin[1]; y <= box.cellMax[1]; y++)
+			{
+				for (int z = box.cellMin[2]; z <= box.cellMax[2]; z++)
+				{
+					int slot = FindCell(x, y, z, true);
+					m_cells[slot].count++;
+					m_entrySlots.push_back(slot);
+				}
+			}
+		}
+	}
+
+	//Give each cell the start of its run, then reuse its count to fill it.
+	int start = 0;
+	for (int i = 0; i < tableSize; i++)
+	{
+		m_cells[i].start = start;
+		start += m_cells[i].count;
+		m_cells[i].count = 0;
+	}
+
+	//Place every box in its cells, in the order the slots were counted.
+	m_cellBoxes.resize(entries);
+	int entry = 0;
+	for (int i = 0; i < (int)m_boxes.size(); i++)
+	{
+		if (m_boxes[i].cells > GRID_MAX_CELLS_PER_BOX)
+			continue;
+
+		for (int j = 0; j < m_boxes[i].cells; j++, entry++)
+		{
+			Cell& cell = m_cells[m_entrySlots[entry]];
+			m_cellBoxes[cell.start + cell.count++] = i;
+		}
+	}
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetCellSize
+
+Summary:	Gets the size of the cells.
+
+Modifies:	[none].
+
+Returns:	float
+				the length of each side of a cell, in world units.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+float SpatialHashGridClass::GetCellSize()
+{
+	return m_cellSize;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetCellCount
+
+Summary:	Gets the number of cells the last Build() put anything in.
+
+Modifies:	[none].
+
+Returns:	int
+				the number of cells in use.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+int SpatialHashGridClass::GetCellCount()
+{
+	return m_cellCount;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetCellRange
+
+Summary:	Finds the first and last cell a box overlaps along each axis.
+
+Args:		const BoundingBox& bounds
+				the box to find the cells of.
+			int* cellMin, cellMax
+				arrays of 3 set to the first and last cell on each axis.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void SpatialHashGridClass::GetCellRange(const BoundingBox & bounds, int * cellMin, int * cellMax)
+{
+	const float center[3] = { bounds.Center.x, bounds.Center.y, bounds.Center.z };
+	const float extents[3] = { bounds.Extents.x, bounds.Extents.y, bounds.Extents.z };
+
+	for (int i = 0; i < 3; i++)
+	{
+		float low = floorf((center[i] - extents[i]) * m_inverseCellSize);
+		float high = floorf((center[i] + extents[i]) * m_inverseCellSize);
+
+		low = low < -GRID_MAX_CELL_COORDINATE ? -GRID_MAX_CELL_COORDINATE : (low > GRID_MAX_CELL_COORDINATE ? GRID_MAX_CELL_COORDINATE : low);
+		high = high < -GRID_MAX_CELL_COORDINATE ? -GRID_MAX_CELL_COORDINATE : (high > GRID_MAX_CELL_COORDINATE ? GRID_MAX_CELL_COORDINATE : high);
+
+		cellMin[i] = (int)low;
+		cellMax[i] = (int)high;
+	}
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		FindCell
+
+Summary:	Finds the slot of a cell in the table by hashing its
+			coordinates and probing the slots after it in turn.
+
+Args:		int x, y, z
+				the coordinates of the cell.
+			bool add
+				whether to take the first empty slot for the cell if it is
+				not in the table yet.
+
+Modifies:	[m_cells, m_cellCount].
+
+Returns:	int
+				the slot of the cell, or -1 if it is not in the table and
+				add is false.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+int SpatialHashGridClass::FindCell(int x, int y, int z, bool add)
+{
+	if (m_cells.empty())
+		return -1;
+
+	unsigned mask = (unsigned)m_cells.size() - 1;
+	unsigned slot = (((unsigned)x * 73856093u) ^ ((unsigned)y * 19349663u) ^ ((unsigned)z * 83492791u)) & mask;
+
+	//The table is never full, so an empty slot always ends the probe.
+	while (true)
+	{
+		Cell& cell = m_cells[slot];
+		if (cell.count == 0)
+		{
+			if (!add)
+				return -1;
+
+			cell.x = x;
+			cell.y = y;
+			cell.z = z;
+			m_cellCount++;
+			return (int)slot;
+		}
+
+		if (cell.x == x && cell.y == y && cell.z == z)
+			return (int)slot;
+
+		slot = (slot + 1) & mask;
+	}
+}
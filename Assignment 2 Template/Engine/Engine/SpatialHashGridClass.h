@@ -0,0 +1,211 @@
+#pragma once
+//======================================================
+//				Filename: SpatialHashGridClass.h
+//======================================================
+
+
+//======================================================
+//					Include Guards.
+//======================================================
+#ifndef _SPATIALHASHGRIDCLASS_H_
+#define _SPATIALHASHGRIDCLASS_H_
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <vector>
+#include <DirectXMath.h>
+#include <DirectXCollision.h>
+
+
+//======================================================
+//					Namespaces.
+//======================================================
+using namespace DirectX;
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		SpatialHashGridClass
+
+Summary:	A uniform grid of cubic cells over world space, hashed so only
+			the cells something is in take any room. Each box added is
+			listed in every cell it overlaps, and a query only visits the
+			cells of the box it is given, so small things are only tested
+			against what is near them.
+			It is rebuilt from scratch whenever anything moves: Clear(),
+			Add() every box, then Build(). Build() counts the boxes in each
+			cell of an open addressing table, then places them with one
+			counting sort pass, so every cell's boxes end up together.
+			Boxes spanning more than GRID_MAX_CELLS_PER_BOX cells are kept
+			aside and returned by every query instead.
+			Built on one thread, it can then be queried from any number.
+			Its lists keep their memory between builds.
+
+Structs:	Box
+				a box added to the grid, with the range of cells it covers.
+			Cell
+				a slot of the table: a cell, and where its boxes start and
+				how many there are.
+
+Methods:	==================== PUBLIC ====================
+			SpatialHashGridClass()
+				Default constructor.
+			SpatialHashGridClass(const SpatialHashGridClass&)
+				Reference constructor.
+			~SpatialHashGridClass()
+				Default deconstructor.
+
+			bool Initialize(float)
+				Call after creation to set the size of the cells.
+			void Shutdown()
+				Call before deletion to free the table and lists.
+
+			void Clear()
+				Use to start a rebuild, dropping every box.
+			int Add(const BoundingBox&)
+				Use to add a box, returning its index, counted from 0 in
+				the order they were added.
+			void Build()
+				Use once every box has been added to sort them into cells.
+			template<Function> void Query(const BoundingBox&, Function)
+				Use to call the function once with the index of every box
+				in the cells the given box overlaps. The boxes themselves
+				are left for the function to test.
+
+			float GetCellSize()
+				Use to get the size of the cells.
+			int GetCellCount()
+				Use to get the number of cells with something in.
+
+			==================== PRIVATE ====================
+			void GetCellRange(const BoundingBox&, int*, int*)
+				Used to find the first and last cell a box overlaps on each axis.
+			int FindCell(int, int, int, bool)
+				Used to find the slot of a cell in the table, adding it if asked.
+
+Members:	==================== PRIVATE ====================
+			float m_cellSize, m_inverseCellSize
+				the size of a cell, and 1 over it.
+			std::vector<Box> m_boxes
+				every box added, by index.
+			std::vector<int> m_oversized
+				the indices of boxes spanning too many cells to list.
+			std::vector<Cell> m_cells
+				the open addressing table, a power of 2 in size.
+			std::vector<int> m_entrySlots
+				the slot of each cell of each box, in the order they were
+				counted, so the counting sort need not hash again.
+			std::vector<int> m_cellBoxes
+				the indices of the boxes in every cell, each cell's together.
+			int m_cellCount
+				the number of slots of the table in use.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class SpatialHashGridClass
+{
+private:
+	struct Box
+	{
+		int cellMin[3];
+		int cellMax[3];
+		int cells;
+	};
+
+	struct Cell
+	{
+		int x, y, z;
+		int start;
+		int count;
+	};
+
+public:
+	SpatialHashGridClass();
+	SpatialHashGridClass(const SpatialHashGridClass&);
+	~SpatialHashGridClass();
+
+	bool Initialize(float cellSize);
+	void Shutdown();
+
+	void Clear();
+	int Add(const BoundingBox& bounds);
+	void Build();
+	template<typename Function> void Query(const BoundingBox& bounds, Function function);
+
+	float GetCellSize();
+	int GetCellCount();
+
+private:
+	void GetCellRange(const BoundingBox& bounds, int* cellMin, int* cellMax);
+	int FindCell(int x, int y, int z, bool add);
+
+private:
+	float m_cellSize;
+	float m_inverseCellSize;
+	std::vector<Box> m_boxes;
+	std::vector<int> m_oversized;
+	std::vector<Cell> m_cells;
+	std::vector<int> m_entrySlots;
+	std::vector<int> m_cellBoxes;
+	int m_cellCount;
+};
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Query
+
+Summary:	Calls function with the index of every box sharing a cell with
+			bounds, then every oversized box. A box in several of those
+			cells is only passed on in the first cell the two share, so
+			each is passed once. A query spanning too many cells is given
+			every box instead.
+
+Args:		const BoundingBox& bounds
+				the box to look around.
+			Function function
+				called with the index of each box, as returned by Add().
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+template<typename Function>
+inline void SpatialHashGridClass::Query(const BoundingBox & bounds, Function function)
+{
+	int cellMin[3], cellMax[3];
+	GetCellRange(bounds, cellMin, cellMax);
+
+	//Walking that many cells would cost more than testing everything.
+	long long cells = (long long)(cellMax[0] - cellMin[0] + 1) * (cellMax[1] - cellMin[1] + 1) * (cellMax[2] - cellMin[2] + 1);
+	if (cells > (long long)m_boxes.size())
+	{
+		for (int i = 0; i < (int)m_boxes.size(); i++)
+			function(i);
+		return;
+	}
+
+	for (int x = cellMin[0]; x <= cellMax[0]; x++)
+	{
+		for (int y = cellMin[1]; y <= cellMax[1]; y++)
+		{
+			for (int z = cellMin[2]; z <= cellMax[2]; z++)
+			{
+				int slot = FindCell(x, y, z, false);
+				if (slot < 0)
+					continue;
+
+				const Cell& cell = m_cells[slot];
+				for (int i = cell.start; i < cell.start + cell.count; i++)
+				{
+					//Only pass a box on in the first cell it shares with the query.
+					const Box& box = m_boxes[m_cellBoxes[i]];
+					if (x != (box.cellMin[0] > cellMin[0] ? box.cellMin[0] : cellMin[0]) ||
+						y != (box.cellMin[1] > cellMin[1] ? box.cellMin[1] : cellMin[1]) ||
+						z != (box.cellMin[2] > cellMin[2] ? box.cellMin[2] : cellMin[2]))
+						continue;
+
+					function(m_cellBoxes[i]);
+				}
+			}
+		}
+	}
+
+	for (size_t i = 0; i < m_oversized.size(); i++)
+		function(m_oversized[i]);
+}
+
+#endif
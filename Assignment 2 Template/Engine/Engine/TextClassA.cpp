@@ -11,6 +11,7 @@
 #include "FW1Font/sourceCode/FW1FontWrapper/Source/CFW1FontWrapper.h"
 #include "FW1Font/sourceCode/FW1FontWrapper/Source/FW1FontWrapper.h"
 #include "FW1Font/sourceCode/FW1FontWrapper/Source/FW1Precompiled.h"
+#include "MemoryTrackerClass.h"
 
 
 //================================================================
@@ -181,6 +182,12 @@ bool TextClassA::Render(ID3D11DeviceContext* deviceContext)
 		return false;
 	}
 
+	// Draw the stats lines under it in white.
+	if (!m_stats.empty())
+	{
+		m_pFontWrapper->DrawString(deviceContext, m_stats.c_str(), 16.0f, 10.0f, 70.0f, 0xFFFFFFFF, FW1_TOP | FW1_LEFT | FW1_RESTORESTATE);
+	}
+
 	return true;
 }
 
@@ -249,6 +256,7 @@ bool TextClassA::UpdateSentence(SentenceType* sentence, char* text, float red, f
 	sentence->blue = blue;
 
 	//Convert the Char array to a WCHAR for use with FW1FontWrapper
+	MEMORY_TAG("TextClassA::UpdateSentence");
 	size_t newsize = strlen(text) + 1;
 	wchar_t * wcstring = new wchar_t[newsize];
 	size_t convertedChars = 0;
@@ -396,4 +404,20 @@ bool TextClassA::SetIntersection(bool intersection, ID3D11DeviceContext* deviceC
 	return result;
 }
 
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		SetStats
+
+Summary:	Sets the lines of stats drawn under the intersection text.
+
+Args:		const char* text
+				the lines to draw, separated by '\n', or "" to draw none.
+
+Modifies:	[m_stats].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void TextClassA::SetStats(const char* text)
+{
+	//Convert the Char array to a WCHAR for use with FW1FontWrapper
+	m_stats.assign(text, text + strlen(text));
+}
+
 #pragma endregion
\ No newline at end of file
@@ -14,6 +14,12 @@
 #include "FW1Font/sourceCode/FW1FontWrapper/Source/FW1Precompiled.h"
 
 
+//===================================================
+//					Library Headers.
+//===================================================
+#include <string>
+
+
 //====================================================
 //					Forward declarations
 //====================================================
@@ -27,7 +33,8 @@ class GameObject;
 Class:		TextClassA
 
 Summary:	A class designed to provide an implementation of an intersection
-			status string at the top left of the screen.
+			status string at the top left of the screen, with optional lines
+			of stats underneath it.
 
 Methods:	================== PUBLIC ==================
 			TextClass();
@@ -49,6 +56,8 @@ Methods:	================== PUBLIC ==================
 			SetIntersection(bool, ID3D11DeviceContext*, float)
 				CALL WHEN INTERSECTION STATUS CHANGES:
 					Changes the sentence appropriately to reflect the float passed in.
+			SetStats(const char*)
+				Use to set the stats lines drawn under the score, or "" to hide them.
 
 			================== PRIVATE ==================
 			InitializeSentence(SentenceType**)
@@ -81,6 +90,7 @@ public:
 
 	bool Render(ID3D11DeviceContext*);
 	bool SetIntersection(bool, ID3D11DeviceContext*, float scoreToAdd);
+	void SetStats(const char* text);
 
 
 private:
@@ -91,6 +101,7 @@ private:
 
 private:
 	SentenceType* m_sentence1;
+	std::wstring m_stats;
 
 	IFW1Factory* m_pFW1Factory;
 	IFW1FontWrapper* m_pFontWrapper;
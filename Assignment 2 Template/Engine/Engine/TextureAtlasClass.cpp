@@ -0,0 +1,384 @@
+//======================================================
+//				Filename: TextureAtlasClass.cpp
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "TextureAtlasClass.h"
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <algorithm>
+#include <fstream>
+
+
+//======================================================
+//				.dds header layout.
+//======================================================
+const uint32_t DDS_MAGIC_NUMBER = 0x20534444;
+const size_t DDS_HEADER_BYTES = 128;
+const uint32_t DDS_PIXELFORMAT_ALPHA = 0x1;
+const uint32_t DDS_PIXELFORMAT_RGB = 0x40;
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		TextureAtlasClass
+
+Summary:	The default constructor for a TextureAtlasClass object.
+
+Modifies:	[m_width, m_height, m_texture].
+
+Returns:	TextureAtlasClass
+				the newly created TextureAtlasClass object.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+TextureAtlasClass::TextureAtlasClass()
+{
+	m_width = 0;
+	m_height = 0;
+	m_texture = 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		TextureAtlasClass
+
+Summary:	The reference constructor for a TextureAtlasClass object.
+
+Args:		const TextureAtlasClass& other
+				the TextureAtlasClass object to create this one in the image of.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+TextureAtlasClass::TextureAtlasClass(const TextureAtlasClass & other)
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		~TextureAtlasClass
+
+Summary:	The default deconstructor for a TextureAtlasClass object.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+TextureAtlasClass::~TextureAtlasClass()
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		AddTexture
+
+Summary:	Reads a .dds file to be packed by the next call to Build().
+
+Args:		char* name
+				the name to look the texture up by with GetRegion().
+			WCHAR* filename
+				a filepath to an uncompressed 32 bit .dds file.
+
+Modifies:	[m_sources].
+
+Returns:	bool
+				was the file read successfully.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool TextureAtlasClass::AddTexture(char * name, WCHAR * filename)
+{
+	SourceImage image;
+	image.name = name;
+
+	if (!ReadImage(filename, image))
+		return false;
+
+	m_sources.push_back(image);
+	return true;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Build
+
+Summary:	Packs every added texture with an AtlasPackerClass, copies their
+			pixels into place and creates the atlas texture.
+			Each texture's edge pixels are repeated into its padding so
+			filtering at the edge of a region does not pick up its neighbours.
+
+Args:		ID3D11Device* device
+				the device to create the atlas on.
+			int maxSize
+				the widest and tallest the atlas may be.
+			int padding
+				the pixels left around each texture.
+
+Modifies:	[m_sources, m_regions, m_pixels, m_width, m_height, m_texture].
+
+Returns:	bool
+				were the textures packed and the atlas created successfully.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool TextureAtlasClass::Build(ID3D11Device * device, int maxSize, int padding)
+{
+	if (m_sources.empty())
+		return false;
+
+	//Pack the padded size of each texture.
+	std::vector<AtlasPackerClass::Rect> sizes;
+	for (size_t i = 0; i < m_sources.size(); i++)
+	{
+		AtlasPackerClass::Rect size = { 0, 0, m_sources[i].width + padding * 2, m_sources[i].height + padding * 2 };
+		sizes.push_back(size);
+	}
+
+	AtlasPackerClass packer;
+	std::vector<AtlasPackerClass::Rect> placed;
+	if (!packer.Pack(sizes, maxSize, placed, m_width, m_height))
+	{
+		OutputDebugStringA("TextureAtlasClass: textures do not fit in the atlas\n");
+		return false;
+	}
+
+	//Copy each texture into place, clamping reads so the padding repeats its edges.
+	m_pixels.assign((size_t)m_width * m_height, 0);
+	for (size_t i = 0; i < m_sources.size(); i++)
+	{
+		const SourceImage& source = m_sources[i];
+
+		for (int y = 0; y < placed[i].height; y++)
+		{
+			int sourceY = std::min<int>(std::max<int>(y - padding, 0), source.height - 1);
+			uint32_t* row = &m_pixels[(size_t)(placed[i].y + y) * m_width + placed[i].x];
+
+			for (int x = 0; x < placed[i].width; x++)
+			{
+				int sourceX = std::min<int>(std::max<int>(x - padding, 0), source.width - 1);
+				row[x] = source.pixels[(size_t)sourceY * source.width + sourceX];
+			}
+		}
+
+		//Record the region inside the padding in the remap table.
+		AtlasRegion region;
+		region.x = placed[i].x + padding;
+		region.y = placed[i].y + padding;
+		region.width = source.width;
+		region.height = source.height;
+		region.left = (float)region.x / m_width;
+		region.top = (float)region.y / m_height;
+		region.right = (float)(region.x + region.width) / m_width;
+		region.bottom = (float)(region.y + region.height) / m_height;
+		m_regions[source.name] = region;
+	}
+
+	//The source pixels are no longer needed.
+	std::vector<SourceImage>().swap(m_sources);
+
+	//Create the atlas texture.
+	D3D11_TEXTURE2D_DESC textureDesc;
+	textureDesc.Width = m_width;
+	textureDesc.Height = m_height;
+	textureDesc.MipLevels = 1;
+	textureDesc.ArraySize = 1;
+	textureDesc.Format = DXGI_FORMAT_B8G8R8A8_UNORM;
+	textureDesc.SampleDesc.Count = 1;
+	textureDesc.SampleDesc.Quality = 0;
+	textureDesc.Usage = D3D11_USAGE_IMMUTABLE;
+	textureDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+	textureDesc.CPUAccessFlags = 0;
+	textureDesc.MiscFlags = 0;
+
+	D3D11_SUBRESOURCE_DATA textureData;
+	textureData.pSysMem = m_pixels.data();
+	textureData.SysMemPitch = m_width * sizeof(uint32_t);
+	textureData.SysMemSlicePitch = 0;
+
+	ID3D11Texture2D* texture = 0;
+	HRESULT result = device->CreateTexture2D(&textureDesc, &textureData, &texture);
+	if (FAILED(result))
+		return false;
+
+	result = device->CreateShaderResourceView(texture, nullptr, &m_texture);
+	texture->Release();
+	if (FAILED(result))
+		return false;
+
+	return true;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Save
+
+Summary:	Writes the atlas out as an uncompressed 32 bit .dds file so it
+			can be shipped prebuilt.
+
+Args:		WCHAR* filename
+				the filepath to write the .dds file to.
+
+Modifies:	[none].
+
+Returns:	bool
+				was the file written successfully.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool TextureAtlasClass::Save(WCHAR * filename)
+{
+	if (m_pixels.empty())
+		return false;
+
+	//Fill in a header for a single level B8G8R8A8 texture.
+	uint32_t header[DDS_HEADER_BYTES / sizeof(uint32_t)] = { 0 };
+	header[0] = DDS_MAGIC_NUMBER;
+	header[1] = 124;							//Header size.
+	header[2] = 0x100F;							//Caps, height, width, pitch and pixel format are set.
+	header[3] = m_height;
+	header[4] = m_width;
+	header[5] = m_width * sizeof(uint32_t);		//Pitch.
+	header[19] = 32;							//Pixel format size.
+	header[20] = DDS_PIXELFORMAT_RGB | DDS_PIXELFORMAT_ALPHA;
+	header[22] = 32;							//Bits per pixel.
+	header[23] = 0x00ff0000;
+	header[24] = 0x0000ff00;
+	header[25] = 0x000000ff;
+	header[26] = 0xff000000;
+	header[27] = 0x1000;						//Texture caps.
+
+	std::ofstream fout;
+	fout.open(filename, std::ios::binary);
+	if (fout.fail())
+		return false;
+
+	fout.write((char*)header, sizeof(header));
+	fout.write((char*)m_pixels.data(), m_pixels.size() * sizeof(uint32_t));
+	if (fout.fail())
+		return false;
+
+	fout.close();
+
+	return true;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Shutdown
+
+Summary:	Releases the atlas texture and clears the remap table.
+
+Modifies:	[m_sources, m_regions, m_pixels, m_width, m_height, m_texture].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void TextureAtlasClass::Shutdown()
+{
+	if (m_texture)
+	{
+		m_texture->Release();
+		m_texture = 0;
+	}
+
+	m_sources.clear();
+	m_regions.clear();
+	std::vector<uint32_t>().swap(m_pixels);
+	m_width = 0;
+	m_height = 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetRegion
+
+Summary:	Looks up where a named texture was packed.
+
+Args:		char* name
+				the name the texture was added under.
+			AtlasRegion& region
+				set to the region of the texture.
+
+Modifies:	[none].
+
+Returns:	bool
+				was a texture with that name packed.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool TextureAtlasClass::GetRegion(char * name, AtlasRegion & region)
+{
+	std::map<std::string, AtlasRegion>::iterator iter = m_regions.find(name);
+	if (iter == m_regions.end())
+		return false;
+
+	region = iter->second;
+	return true;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetTexture
+
+Summary:	Returns the atlas texture.
+
+Modifies:	[none].
+
+Returns:	ID3D11ShaderResourceView*
+				the atlas texture, or 0 before Build().
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+ID3D11ShaderResourceView * TextureAtlasClass::GetTexture()
+{
+	return m_texture;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		ReadImage
+
+Summary:	Reads the top level of an uncompressed 32 bit .dds file,
+			converting R8G8B8A8 files to the B8G8R8A8 layout of the atlas.
+
+Args:		WCHAR* filename
+				a filepath to the .dds file.
+			SourceImage& image
+				filled with the size and pixels of the file.
+
+Modifies:	[none].
+
+Returns:	bool
+				was the file read and in a supported format.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool TextureAtlasClass::ReadImage(WCHAR * filename, SourceImage & image)
+{
+	std::ifstream fin;
+	fin.open(filename, std::ios::binary);
+	if (fin.fail())
+		return false;
+
+	//Read and check the header.
+	uint32_t header[DDS_HEADER_BYTES / sizeof(uint32_t)];
+	fin.read((char*)header, sizeof(header));
+	if (fin.fail() || header[0] != DDS_MAGIC_NUMBER)
+		return false;
+
+	uint32_t formatFlags = header[20];
+	uint32_t bitCount = header[22];
+	uint32_t redMask = header[23];
+	if (!(formatFlags & DDS_PIXELFORMAT_RGB) || bitCount != 32)
+	{
+		OutputDebugStringA("TextureAtlasClass: only uncompressed 32 bit .dds files can be added\n");
+		return false;
+	}
+
+	image.height = (int)header[3];
+	image.width = (int)header[4];
+	if (image.width <= 0 || image.height <= 0)
+		return false;
+
+	//Read the top level, which comes straight after the header.
+	image.pixels.resize((size_t)image.width * image.height);
+	fin.read((char*)image.pixels.data(), image.pixels.size() * sizeof(uint32_t));
+	if (fin.fail())
+		return false;
+
+	fin.close();
+
+	for (size_t i = 0; i < image.pixels.size(); i++)
+	{
+		uint32_t pixel = image.pixels[i];
+
+		//Swap red and blue if the file is R8G8B8A8.
+		if (redMask == 0x000000ff)
+			pixel = (pixel & 0xff00ff00) | ((pixel & 0x00ff0000) >> 16) | ((pixel & 0x000000ff) << 16);
+
+		//Make the pixel opaque if the file has no alpha.
+		if (!(formatFlags & DDS_PIXELFORMAT_ALPHA))
+			pixel |= 0xff000000;
+
+		image.pixels[i] = pixel;
+	}
+
+	return true;
+}
@@ -0,0 +1,124 @@
+#pragma once
+//======================================================
+//				Filename: TextureAtlasClass.h
+//======================================================
+
+
+//======================================================
+//					Include Guards.
+//======================================================
+#ifndef _TEXTUREATLASCLASS_H_
+#define _TEXTUREATLASCLASS_H_
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "AtlasPackerClass.h"
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <d3d11_1.h>
+#include <stdint.h>
+#include <map>
+#include <string>
+#include <vector>
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		TextureAtlasClass
+
+Summary:	Merges small uncompressed 32 bit .dds textures into a single
+			texture at startup so that HUD and debug drawing share one
+			shader resource. Keeps a table of the UV rectangle each source
+			texture was packed into.
+
+Structs:	AtlasRegion
+				where a source texture sits in the atlas, in pixels and UVs.
+			SourceImage
+				the pixels of a source texture waiting to be packed.
+
+Methods:	==================== PUBLIC ====================
+			TextureAtlasClass()
+				Default constructor.
+			TextureAtlasClass(const TextureAtlasClass&)
+				Reference constructor.
+			~TextureAtlasClass()
+				Default deconstructor.
+
+			bool AddTexture(char*, WCHAR*)
+				Call before Build() to read a .dds file into the atlas under a name.
+			bool Build(ID3D11Device*, int, int)
+				Call after adding every texture to pack them and create the atlas.
+			bool Save(WCHAR*)
+				Use after Build() to write the atlas out as a .dds file.
+			void Shutdown()
+				Call before deletion to release the atlas.
+
+			bool GetRegion(char*, AtlasRegion&)
+				Use to find where a named texture was packed.
+			ID3D11ShaderResourceView* GetTexture()
+				Use to get the atlas texture.
+
+			==================== PRIVATE ====================
+			bool ReadImage(WCHAR*, SourceImage&)
+				Called by AddTexture() to read the top level of a .dds file
+				as B8G8R8A8 pixels.
+
+Members:	==================== PRIVATE ====================
+			std::vector<SourceImage> m_sources
+				the textures added since the last Build().
+			std::map<std::string, AtlasRegion> m_regions
+				the UV remap table, by texture name.
+			std::vector<uint32_t> m_pixels
+				the B8G8R8A8 pixels of the atlas.
+			int m_width, m_height
+				the size of the atlas in pixels.
+			ID3D11ShaderResourceView* m_texture
+				the atlas texture.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class TextureAtlasClass
+{
+public:
+	struct AtlasRegion
+	{
+		int x, y;
+		int width, height;
+		float left, top, right, bottom;
+	};
+
+private:
+	struct SourceImage
+	{
+		std::string name;
+		int width, height;
+		std::vector<uint32_t> pixels;
+	};
+
+public:
+	TextureAtlasClass();
+	TextureAtlasClass(const TextureAtlasClass&);
+	~TextureAtlasClass();
+
+	bool AddTexture(char* name, WCHAR* filename);
+	bool Build(ID3D11Device* device, int maxSize, int padding);
+	bool Save(WCHAR* filename);
+	void Shutdown();
+
+	bool GetRegion(char* name, AtlasRegion& region);
+	ID3D11ShaderResourceView* GetTexture();
+
+private:
+	bool ReadImage(WCHAR* filename, SourceImage& image);
+
+private:
+	std::vector<SourceImage> m_sources;
+	std::map<std::string, AtlasRegion> m_regions;
+	std::vector<uint32_t> m_pixels;
+	int m_width, m_height;
+	ID3D11ShaderResourceView* m_texture;
+};
+
+#endif
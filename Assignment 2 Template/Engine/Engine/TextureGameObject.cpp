@@ -68,16 +68,13 @@ Modifies:	[see GameObject.Render()].
 Returns:	bool
 				was the rendering successful or not?
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-bool TextureGameObject::Render(ShaderManagerClass* shaderManager, ID3D11DeviceContext* device,
-	XMMATRIX &worldMatrix, const XMMATRIX &viewMatrix, const XMMATRIX &projectionMatrix)
+bool TextureGameObject::Render(ShaderManagerClass* shaderManager, RenderContext* device,
+	XMMATRIX &worldMatrix, const XMMATRIX &viewProjectionMatrix, float animationTime)
 {
 	//Render the model to the deviceContext.
 	GetModel()->Render(device);
 
-	//Calculate the worldMatrix of the Model.
-	const XMMATRIX* newWorldMatrix = this->CalcWorldMatrix(worldMatrix);
-
 	//Render the model using the textureshader.
-	return shaderManager->RenderTextureShader(device, GetModel()->GetIndexCount(), *newWorldMatrix, viewMatrix, projectionMatrix,
+	return shaderManager->RenderTextureShader(device, GetModel()->GetIndexCount(), worldMatrix, viewProjectionMatrix,
 		GetModel()->GetTexture());
 }
@@ -39,7 +39,7 @@ public:
 	~TextureGameObject();
 	TextureGameObject(ModelClass* baseModel);
 
-	virtual bool Render(ShaderManagerClass* shaderManager, ID3D11DeviceContext* device,
-		XMMATRIX &worldMatrix, const XMMATRIX &viewMatrix, const XMMATRIX &projectionMatrix) override;
+	virtual bool Render(ShaderManagerClass* shaderManager, RenderContext* device,
+		XMMATRIX &worldMatrix, const XMMATRIX &viewProjectionMatrix, float animationTime) override;
 };
 
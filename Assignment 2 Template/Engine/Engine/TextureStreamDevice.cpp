@@ -0,0 +1,183 @@
+//======================================================
+//				Filename: TextureStreamDevice.cpp
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "TextureStreamDevice.h"
+#include "DDSFileClass.h"
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RecordingTextureStreamDevice
+
+Summary:	The default constructor for a RecordingTextureStreamDevice.
+
+Modifies:	[m_failCreates].
+
+Returns:	RecordingTextureStreamDevice
+				the newly created RecordingTextureStreamDevice object.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+RecordingTextureStreamDevice::RecordingTextureStreamDevice()
+{
+	m_failCreates = false;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		CreateTexture
+
+Summary:	Lays out a DDS file held in memory and logs the mip levels that
+			fit within maxSize as one upload, the same levels the DDS
+			texture loader would put on a device.
+
+Args:		const uint8_t* ddsData
+				the whole DDS file.
+			size_t ddsDataSize
+				the size of the DDS file in bytes.
+			size_t maxSize
+				the widest and tallest mip level to upload, 0 for all of them.
+
+Modifies:	[m_uploads, m_liveBytes].
+
+Returns:	StreamTexture*
+				a handle to the new texture, or 0 if the file could not be
+				used or creates are set to fail.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+StreamTexture * RecordingTextureStreamDevice::CreateTexture(const uint8_t * ddsData, size_t ddsDataSize, size_t maxSize)
+{
+	DDSFileClass dds;
+	if (m_failCreates || dds.Parse(ddsData, ddsDataSize) != DDSFileClass::PARSE_OK)
+		return 0;
+
+	size_t firstMip = dds.GetFirstMip(maxSize);
+	if (firstMip >= dds.GetMipCount())
+		return 0;
+
+	size_t bytes = 0;
+	for (size_t mip = firstMip; mip < dds.GetMipCount(); mip++)
+		bytes += dds.GetMipBytes(mip);
+
+	//Handles count up from 1 so none is ever 0.
+	m_liveBytes.push_back(bytes);
+	StreamTexture* texture = (StreamTexture*)m_liveBytes.size();
+
+	Upload upload = { texture, firstMip, bytes };
+	m_uploads.push_back(upload);
+
+	return texture;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		ReleaseTexture
+
+Summary:	Logs the release of a texture made by CreateTexture.
+
+Args:		StreamTexture* texture
+				the texture to release, or 0.
+
+Modifies:	[m_releases, m_liveBytes].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void RecordingTextureStreamDevice::ReleaseTexture(StreamTexture * texture)
+{
+	if (!texture)
+		return;
+
+	m_releases.push_back(texture);
+	m_liveBytes[(size_t)texture - 1] = 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		SetFailCreates
+
+Summary:	Sets whether every following CreateTexture fails.
+
+Args:		bool fail
+				should creates fail.
+
+Modifies:	[m_failCreates].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void RecordingTextureStreamDevice::SetFailCreates(bool fail)
+{
+	m_failCreates = fail;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetUploads
+
+Summary:	Returns every upload logged so far.
+
+Returns:	const std::vector<Upload>&
+				the uploads, oldest first.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+const std::vector<RecordingTextureStreamDevice::Upload>& RecordingTextureStreamDevice::GetUploads()
+{
+	return m_uploads;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetReleases
+
+Summary:	Returns every release logged so far.
+
+Returns:	const std::vector<StreamTexture*>&
+				the released textures, oldest first.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+const std::vector<StreamTexture*>& RecordingTextureStreamDevice::GetReleases()
+{
+	return m_releases;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetLiveTextures
+
+Summary:	Returns the number of textures created and not yet released.
+
+Returns:	int
+				the live textures.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+int RecordingTextureStreamDevice::GetLiveTextures()
+{
+	int live = 0;
+
+	for (size_t i = 0; i < m_liveBytes.size(); i++)
+	{
+		if (m_liveBytes[i])
+			live++;
+	}
+
+	return live;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetLiveBytes
+
+Summary:	Returns the bytes held by the textures not yet released.
+
+Returns:	size_t
+				the live bytes.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+size_t RecordingTextureStreamDevice::GetLiveBytes()
+{
+	size_t bytes = 0;
+
+	for (size_t i = 0; i < m_liveBytes.size(); i++)
+		bytes += m_liveBytes[i];
+
+	return bytes;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		ClearLog
+
+Summary:	Forgets the uploads and releases logged so far. The live
+			textures are kept.
+
+Modifies:	[m_uploads, m_releases].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void RecordingTextureStreamDevice::ClearLog()
+{
+	m_uploads.clear();
+	m_releases.clear();
+}
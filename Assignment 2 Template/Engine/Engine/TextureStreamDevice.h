@@ -0,0 +1,129 @@
+#pragma once
+//======================================================
+//				Filename: TextureStreamDevice.h
+//======================================================
+
+
+//======================================================
+//					Include Guards.
+//======================================================
+#ifndef _TEXTURESTREAMDEVICE_H_
+#define _TEXTURESTREAMDEVICE_H_
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+
+//A texture made by a TextureStreamDevice. Only ever handled through a pointer,
+//what it points to is up to the device that made it.
+struct StreamTexture;
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		TextureStreamDevice
+
+Summary:	The interface TextureStreamerClass uploads textures through.
+			Textures are opaque StreamTexture handles, so the residency
+			logic of the streamer has no Direct3D in it and can be driven
+			by a device that only records uploads.
+
+Methods:	==================== PURE VIRTUAL ====================
+			StreamTexture* CreateTexture(const uint8_t*, size_t, size_t)
+				Creates a texture from a whole DDS file held in memory, skipping
+				every mip level wider or taller than maxSize. Returns 0 on
+				failure.
+			void ReleaseTexture(StreamTexture*)
+				Releases a texture made by CreateTexture. Ignores 0.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class TextureStreamDevice
+{
+public:
+	virtual ~TextureStreamDevice() {}
+
+	virtual StreamTexture* CreateTexture(const uint8_t* ddsData, size_t ddsDataSize, size_t maxSize) = 0;
+	virtual void ReleaseTexture(StreamTexture* texture) = 0;
+};
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		RecordingTextureStreamDevice
+
+Summary:	A stand-in TextureStreamDevice with no GPU behind it. Each
+			texture is a numbered handle, and every upload and release is
+			logged along with the mip levels and bytes it would have put on
+			a device, so the streamer's residency can be checked against
+			what was really uploaded.
+
+Structs:	Upload
+				one call to CreateTexture: the texture made, the finest mip
+				level uploaded and the bytes of every level uploaded.
+
+Methods:	==================== PUBLIC ====================
+			RecordingTextureStreamDevice()
+				Default constructor.
+
+			CreateTexture(...), ReleaseTexture(...)
+				Implementations of TextureStreamDevice.
+
+			void SetFailCreates(bool)
+				Use to make every following CreateTexture fail, as a device
+				out of memory would.
+			const std::vector<Upload>& GetUploads()
+				Use to get every upload so far, oldest first.
+			const std::vector<StreamTexture*>& GetReleases()
+				Use to get every texture released so far, oldest first.
+			int GetLiveTextures()
+				Use to get the textures created and not yet released.
+			size_t GetLiveBytes()
+				Use to get the bytes held by the live textures.
+			void ClearLog()
+				Use to forget the uploads and releases so far. Live textures
+				are kept.
+
+Members:	==================== PRIVATE ====================
+			std::vector<Upload> m_uploads
+				every upload so far.
+			std::vector<StreamTexture*> m_releases
+				every texture released so far.
+			std::vector<size_t> m_liveBytes
+				the bytes of every texture made, indexed by handle - 1, 0
+				once released.
+			bool m_failCreates
+				does CreateTexture fail.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class RecordingTextureStreamDevice : public TextureStreamDevice
+{
+public:
+	struct Upload
+	{
+		StreamTexture* texture;
+		size_t firstMip;
+		size_t bytes;
+	};
+
+public:
+	RecordingTextureStreamDevice();
+
+	virtual StreamTexture* CreateTexture(const uint8_t* ddsData, size_t ddsDataSize, size_t maxSize) override;
+	virtual void ReleaseTexture(StreamTexture* texture) override;
+
+	void SetFailCreates(bool fail);
+	const std::vector<Upload>& GetUploads();
+	const std::vector<StreamTexture*>& GetReleases();
+	int GetLiveTextures();
+	size_t GetLiveBytes();
+	void ClearLog();
+
+private:
+	std::vector<Upload> m_uploads;
+	std::vector<StreamTexture*> m_releases;
+	std::vector<size_t> m_liveBytes;
+	bool m_failCreates;
+};
+
+#endif
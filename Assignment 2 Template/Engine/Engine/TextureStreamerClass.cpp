@@ -0,0 +1,472 @@
+//======================================================
+//				Filename: TextureStreamerClass.cpp
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "TextureStreamerClass.h"
+#include "FrameArenaClass.h"
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <algorithm>
+#include <cmath>
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		TextureStreamerClass
+
+Summary:	The default constructor for a TextureStreamerClass object.
+
+Modifies:	[m_device, m_budget, m_residentBytes, m_tailSize,
+			 m_maxUploadsPerFrame, m_frame].
+
+Returns:	TextureStreamerClass
+				the newly created TextureStreamerClass object.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+TextureStreamerClass::TextureStreamerClass()
+{
+	m_device = 0;
+	m_budget = 0;
+	m_residentBytes = 0;
+	m_tailSize = 0;
+	m_maxUploadsPerFrame = 0;
+	m_frame = 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		TextureStreamerClass
+
+Summary:	The reference constructor for a TextureStreamerClass object.
+
+Args:		const TextureStreamerClass& other
+				the TextureStreamerClass object to create this one in the image of.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+TextureStreamerClass::TextureStreamerClass(const TextureStreamerClass & other)
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		~TextureStreamerClass
+
+Summary:	The default deconstructor for a TextureStreamerClass object.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+TextureStreamerClass::~TextureStreamerClass()
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Initialize
+
+Summary:	Sets up the streamer for use.
+
+Args:		TextureStreamDevice* device
+				the device to upload textures through.
+			size_t budget
+				the most bytes that may be resident.
+			int tailSize
+				the widest or tallest mip level kept resident at all times.
+			int maxUploadsPerFrame
+				the most textures recreated by one Update().
+
+Modifies:	[m_device, m_budget, m_tailSize, m_maxUploadsPerFrame].
+
+Returns:	bool
+				was the streamer set up successfully.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool TextureStreamerClass::Initialize(TextureStreamDevice * device, size_t budget, int tailSize, int maxUploadsPerFrame)
+{
+	if (!device || tailSize < 1 || maxUploadsPerFrame < 1)
+		return false;
+
+	m_device = device;
+	m_budget = budget;
+	m_tailSize = tailSize;
+	m_maxUploadsPerFrame = maxUploadsPerFrame;
+
+	return true;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Shutdown
+
+Summary:	Releases every texture and unmaps the file held for it.
+
+Modifies:	[m_textures, m_residentBytes].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void TextureStreamerClass::Shutdown()
+{
+	for (std::vector<StreamedTexture*>::iterator iter = m_textures.begin();
+		iter != m_textures.end();
+		iter++)
+	{
+		m_device->ReleaseTexture((*iter)->texture);
+		delete (*iter)->file;
+		delete *iter;
+	}
+	m_textures.clear();
+
+	m_residentBytes = 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Register
+
+Summary:	Takes ownership of a mapped DDS file and makes its mip tail
+			resident.
+
+Args:		MappedFileClass* file
+				the whole DDS file. Owned by the streamer on success, left
+				with the caller on failure.
+
+Modifies:	[m_textures, m_residentBytes].
+
+Returns:	int
+				a handle to the texture, or -1 on failure.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+int TextureStreamerClass::Register(MappedFileClass* file)
+{
+	if (!file)
+		return -1;
+
+	StreamedTexture* texture = new StreamedTexture();
+	texture->file = file;
+	texture->texture = 0;
+	texture->lastUsedFrame = 0;
+
+	//Read the layout of the file.
+	if (!ParseLayout(texture))
+	{
+		delete texture;
+		return -1;
+	}
+
+	//Upload the mip tail.
+	texture->residentMip = texture->mipCount;
+	texture->requestedMip = texture->mipCount;
+	if (!MakeResident(texture, texture->tailMip))
+	{
+		delete texture;
+		return -1;
+	}
+
+	m_textures.push_back(texture);
+	return (int)m_textures.size() - 1;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RequestSize
+
+Summary:	Asks for a texture to be sharp at the given size on screen.
+			The finest request made between two calls to Update() wins.
+
+Args:		int handle
+				the texture to request.
+			float screenPixels
+				the size the texture covers on screen, in pixels.
+
+Modifies:	[m_textures].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void TextureStreamerClass::RequestSize(int handle, float screenPixels)
+{
+	if (handle < 0 || handle >= (int)m_textures.size())
+		return;
+
+	StreamedTexture* texture = m_textures[handle];
+	texture->requestedMip = std::min<int>(texture->requestedMip, MipForSize(texture, screenPixels));
+	texture->lastUsedFrame = m_frame;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Update
+
+Summary:	Streams in finer mips for the textures that asked for them,
+			the blurriest first, up to m_maxUploadsPerFrame uploads.
+			Makes room in the budget by evicting textures that were not
+			used since the last call, and settles for a coarser level
+			when even that is not enough.
+
+Modifies:	[m_textures, m_residentBytes, m_frame].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void TextureStreamerClass::Update()
+{
+	//Find every texture that wants a finer level than it has, in the frame arena.
+	FrameVector<StreamedTexture*> candidates;
+	for (std::vector<StreamedTexture*>::iterator iter = m_textures.begin();
+		iter != m_textures.end();
+		iter++)
+	{
+		if ((*iter)->requestedMip < (*iter)->residentMip)
+			candidates.push_back(*iter);
+	}
+
+	//Serve the textures furthest from what they asked for first.
+	std::stable_sort(candidates.begin(), candidates.end(),
+		[](StreamedTexture* a, StreamedTexture* b)
+		{
+			return (a->residentMip - a->requestedMip) > (b->residentMip - b->requestedMip);
+		});
+
+	int uploads = 0;
+	for (FrameVector<StreamedTexture*>::iterator iter = candidates.begin();
+		iter != candidates.end() && uploads < m_maxUploadsPerFrame;
+		iter++)
+	{
+		StreamedTexture* texture = *iter;
+
+		//Try the requested level, then coarser ones until one fits.
+		for (int mip = texture->requestedMip; mip < texture->residentMip; mip++)
+		{
+			size_t extra = BytesFrom(texture, mip) - BytesFrom(texture, texture->residentMip);
+			if (m_residentBytes + extra > m_budget)
+				EvictFor(extra, texture);
+
+			if (m_residentBytes + extra <= m_budget)
+			{
+				if (MakeResident(texture, mip))
+					uploads++;
+				break;
+			}
+		}
+	}
+
+	//Clear the requests ready for the next frame.
+	for (std::vector<StreamedTexture*>::iterator iter = m_textures.begin();
+		iter != m_textures.end();
+		iter++)
+	{
+		(*iter)->requestedMip = (*iter)->mipCount;
+	}
+
+	m_frame++;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetTexture
+
+Summary:	Returns the current texture for a handle.
+
+Args:		int handle
+				the texture to return.
+
+Returns:	StreamTexture*
+				the texture, or 0 for an invalid handle.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+StreamTexture * TextureStreamerClass::GetTexture(int handle)
+{
+	if (handle < 0 || handle >= (int)m_textures.size())
+		return 0;
+
+	return m_textures[handle]->texture;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetResidentMip
+
+Summary:	Returns the finest resident mip level for a handle.
+
+Args:		int handle
+				the texture to query.
+
+Returns:	int
+				the finest resident mip level, or -1 for an invalid handle.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+int TextureStreamerClass::GetResidentMip(int handle)
+{
+	if (handle < 0 || handle >= (int)m_textures.size())
+		return -1;
+
+	return m_textures[handle]->residentMip;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetResidentBytes
+
+Summary:	Returns the bytes currently resident across every texture.
+
+Returns:	size_t
+				the resident bytes.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+size_t TextureStreamerClass::GetResidentBytes()
+{
+	return m_residentBytes;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		ParseLayout
+
+Summary:	Lays out the DDS file of a texture and reads the size, mip
+			count and exact bytes of each mip level from it.
+
+Args:		StreamedTexture* texture
+				the texture holding the mapped file.
+
+Modifies:	[texture].
+
+Returns:	bool
+				was the file a DDS file with every level inside it.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool TextureStreamerClass::ParseLayout(StreamedTexture * texture)
+{
+	DDSFileClass& layout = texture->layout;
+
+
+	if (layout.Parse(texture->file->GetData(), texture->file->GetSize()) != DDSFileClass::PARSE_OK)
+		return false;
+
+	texture->width = (int)layout.GetWidth();
+	texture->height = (int)layout.GetHeight();
+	texture->mipCount = (int)layout.GetMipCount();
+
+	texture->mipBytes.resize(texture->mipCount);
+	for (int mip = 0; mip < texture->mipCount; mip++)
+		texture->mipBytes[mip] = layout.GetMipBytes(mip);
+
+	//The tail is the finest level that fits within m_tailSize.
+	texture->tailMip = texture->mipCount - 1;
+	for (int mip = 0; mip < texture->mipCount; mip++)
+	{
+		if (std::max<int>(texture->width >> mip, texture->height >> mip) <= m_tailSize)
+		{
+			texture->tailMip = mip;
+			break;
+		}
+	}
+
+	return true;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		BytesFrom
+
+Summary:	Returns the bytes a texture has resident when mip is its finest
+			level.
+
+Args:		StreamedTexture* texture
+				the texture to measure.
+			int mip
+				the finest resident level.
+
+Returns:	size_t
+				the bytes of every level from mip down to the coarsest.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+size_t TextureStreamerClass::BytesFrom(StreamedTexture * texture, int mip)
+{
+	size_t bytes = 0;
+
+	for (int level = mip; level < texture->mipCount; level++)
+		bytes += texture->mipBytes[level];
+
+	return bytes;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		MipForSize
+
+Summary:	Returns the mip level needed to draw a texture without
+			minification at the given size on screen.
+
+Args:		StreamedTexture* texture
+				the texture being drawn.
+			float screenPixels
+				the size the texture covers on screen, in pixels.
+
+Returns:	int
+				a mip level between 0 and the tail of the texture.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+int TextureStreamerClass::MipForSize(StreamedTexture * texture, float screenPixels)
+{
+	if (screenPixels < 1.0f)
+		return texture->tailMip;
+
+	float ratio = (float)std::max<int>(texture->width, texture->height) / screenPixels;
+	int mip = ratio > 1.0f ? (int)std::floor(std::log2(ratio)) : 0;
+
+	return std::min<int>(mip, texture->tailMip);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		MakeResident
+
+Summary:	Recreates a texture on the device with the given finest mip
+			level and swaps it in for the old one.
+
+Args:		StreamedTexture* texture
+				the texture to recreate.
+			int mip
+				the finest level to upload.
+
+Modifies:	[texture, m_residentBytes].
+
+Returns:	bool
+				was the texture recreated.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool TextureStreamerClass::MakeResident(StreamedTexture * texture, int mip)
+{
+	//Every level no wider or taller than this is uploaded.
+	size_t maxSize = (size_t)std::max<int>(1, std::max<int>(texture->width >> mip, texture->height >> mip));
+
+	StreamTexture* created = m_device->CreateTexture(texture->file->GetData(), texture->file->GetSize(), maxSize);
+	if (!created)
+		return false;
+
+	//Swap the new texture in and update the resident bytes.
+	m_device->ReleaseTexture(texture->texture);
+	texture->texture = created;
+
+	m_residentBytes -= BytesFrom(texture, texture->residentMip);
+	m_residentBytes += BytesFrom(texture, mip);
+	texture->residentMip = mip;
+
+	return true;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		EvictFor
+
+Summary:	Drops textures that were not used since the last Update() back
+			to their mip tail, least recently used first, until the given
+			number of bytes fit in the budget.
+
+Args:		size_t bytes
+				the bytes that need to fit.
+			StreamedTexture* exclude
+				the texture the room is being made for.
+
+Modifies:	[m_textures, m_residentBytes].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void TextureStreamerClass::EvictFor(size_t bytes, StreamedTexture * exclude)
+{
+	//Find the textures holding more than their tail that were not used this frame.
+	FrameVector<StreamedTexture*> victims;
+	for (std::vector<StreamedTexture*>::iterator iter = m_textures.begin();
+		iter != m_textures.end();
+		iter++)
+	{
+		StreamedTexture* texture = *iter;
+		if (texture != exclude && texture->residentMip < texture->tailMip && texture->lastUsedFrame < m_frame)
+			victims.push_back(texture);
+	}
+
+	//Oldest first.
+	std::stable_sort(victims.begin(), victims.end(),
+		[](StreamedTexture* a, StreamedTexture* b)
+		{
+			return a->lastUsedFrame < b->lastUsedFrame;
+		});
+
+	for (FrameVector<StreamedTexture*>::iterator iter = victims.begin();
+		iter != victims.end() && m_residentBytes + bytes > m_budget;
+		iter++)
+	{
+		MakeResident(*iter, (*iter)->tailMip);
+	}
+}
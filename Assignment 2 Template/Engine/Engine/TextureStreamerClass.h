@@ -0,0 +1,154 @@
+#pragma once
+//======================================================
+//				Filename: TextureStreamerClass.h
+//======================================================
+
+
+//======================================================
+//					Include Guards.
+//======================================================
+#ifndef _TEXTURESTREAMERCLASS_H_
+#define _TEXTURESTREAMERCLASS_H_
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "TextureStreamDevice.h"
+#include "DDSFileClass.h"
+#include "MappedFileClass.h"
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <vector>
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		TextureStreamerClass
+
+Summary:	Keeps the DDS files of streamed textures mapped and decides
+			which of their mip levels are resident on the device.
+			Each texture starts with only its mip tail resident. Finer mips
+			are streamed in from the on-screen size rendered objects request,
+			within a budget of resident bytes. When the budget is full the
+			least recently used textures drop back to their mip tail.
+
+Structs:	StreamedTexture
+				the mapped file, mip layout and residency of one texture.
+
+Methods:	==================== PUBLIC ====================
+			TextureStreamerClass()
+				Default constructor.
+			TextureStreamerClass(const TextureStreamerClass&)
+				Reference constructor.
+			~TextureStreamerClass()
+				Default deconstructor.
+
+			bool Initialize(TextureStreamDevice*, size_t, int, int)
+				Call after creation to set the device, the budget of resident
+				bytes, the size of the mip tail and the uploads allowed per frame.
+			void Shutdown()
+				Call before deletion to release every texture.
+
+			int Register(MappedFileClass*)
+				Use to take ownership of a mapped DDS file and make its mip
+				tail resident. Returns a handle to the texture, or -1 on
+				failure, when the caller keeps the file.
+			void RequestSize(int, float)
+				Use while rendering to ask for a texture to be sharp at the
+				given size on screen, in pixels.
+			void Update()
+				CALL EVERY FRAME on the device thread to act on the requests
+				made since the last call.
+
+			StreamTexture* GetTexture(int)
+				Use to get the current texture for a handle, as made by the
+				device.
+			int GetResidentMip(int)
+				Use to get the finest resident mip level of a handle.
+			size_t GetResidentBytes()
+				Use to get the bytes currently resident across every texture.
+
+			==================== PRIVATE ====================
+			bool ParseLayout(StreamedTexture*)
+				Called by Register() to lay out the DDS file and find the
+				bytes of each mip level.
+			size_t BytesFrom(StreamedTexture*, int)
+				Returns the bytes resident when mip is the finest level.
+			int MipForSize(StreamedTexture*, float)
+				Returns the mip level needed to draw a texture at a given size.
+			bool MakeResident(StreamedTexture*, int)
+				Recreates a texture with the given finest mip level.
+			void EvictFor(size_t, StreamedTexture*)
+				Drops the least recently used textures back to their mip tail
+				until the given number of bytes fit in the budget.
+
+Members:	==================== PRIVATE ====================
+			TextureStreamDevice* m_device
+				the device textures are uploaded through.
+			std::vector<StreamedTexture*> m_textures
+				every registered texture, indexed by handle.
+			size_t m_budget
+				the most bytes that may be resident. Mip tails are kept
+				resident even past it.
+			size_t m_residentBytes
+				the bytes currently resident.
+			int m_tailSize
+				the widest or tallest mip level kept resident at all times.
+			int m_maxUploadsPerFrame
+				the most textures recreated by one Update().
+			unsigned long long m_frame
+				the number of calls to Update() so far.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class TextureStreamerClass
+{
+private:
+	struct StreamedTexture
+	{
+		MappedFileClass* file;
+		DDSFileClass layout;
+		int width, height, mipCount;
+		std::vector<size_t> mipBytes;
+		int tailMip;
+		int residentMip;
+		int requestedMip;
+		unsigned long long lastUsedFrame;
+		StreamTexture* texture;
+	};
+
+public:
+	TextureStreamerClass();
+	TextureStreamerClass(const TextureStreamerClass&);
+	~TextureStreamerClass();
+
+	bool Initialize(TextureStreamDevice* device, size_t budget, int tailSize, int maxUploadsPerFrame);
+	void Shutdown();
+
+	int Register(MappedFileClass* file);
+	void RequestSize(int handle, float screenPixels);
+	void Update();
+
+	StreamTexture* GetTexture(int handle);
+	int GetResidentMip(int handle);
+	size_t GetResidentBytes();
+
+private:
+	bool ParseLayout(StreamedTexture* texture);
+	size_t BytesFrom(StreamedTexture* texture, int mip);
+	int MipForSize(StreamedTexture* texture, float screenPixels);
+	bool MakeResident(StreamedTexture* texture, int mip);
+	void EvictFor(size_t bytes, StreamedTexture* exclude);
+
+private:
+	TextureStreamDevice* m_device;
+	std::vector<StreamedTexture*> m_textures;
+	size_t m_budget;
+	size_t m_residentBytes;
+	int m_tailSize;
+	int m_maxUploadsPerFrame;
+	unsigned long long m_frame;
+};
+
+#endif
@@ -0,0 +1,303 @@
+//======================================================
+//				Filename: TransformBatchClass.cpp
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "TransformBatchClass.h"
+
+
+//======================================================
+//					Constants.
+//======================================================
+//How many slots are composed together, one to each lane of a vector.
+const int TRANSFORM_BATCH_LANES = 4;
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		TransformBatchClass
+
+Summary:	The default constructor for an empty TransformBatchClass.
+
+Modifies:	[m_count].
+
+Returns:	TransformBatchClass
+				the newly created TransformBatchClass object.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+TransformBatchClass::TransformBatchClass()
+{
+	m_count = 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		TransformBatchClass
+
+Summary:	The reference constructor for a TransformBatchClass.
+
+Args:		const TransformBatchClass& other
+				the TransformBatchClass to create this one in the image of.
+
+Modifies:	[m_count].
+
+Returns:	TransformBatchClass
+				the newly created TransformBatchClass object.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+TransformBatchClass::TransformBatchClass(const TransformBatchClass& other)
+{
+	m_count = 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		~TransformBatchClass
+
+Summary:	The default deconstructor for a TransformBatchClass.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+TransformBatchClass::~TransformBatchClass()
+{
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Shutdown
+
+Summary:	Frees every array.
+
+Modifies:	[m_position, m_rotation, m_scale, m_worldMatrices, m_count].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void TransformBatchClass::Shutdown()
+{
+	for (int i = 0; i < 3; i++)
+	{
+		std::vector<float>().swap(m_position[i]);
+		std::vector<float>().swap(m_scale[i]);
+	}
+	for (int i = 0; i < 4; i++)
+		std::vector<float>().swap(m_rotation[i]);
+	std::vector<XMFLOAT4X4>().swap(m_worldMatrices);
+
+	m_count = 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Resize
+
+Summary:	Sets the number of slots. The arrays only ever grow, so once
+			they are big enough a batch costs no allocations.
+			Call on one thread, before any slot is set.
+
+Args:		int count
+				the number of slots wanted.
+
+Modifies:	[m_position, m_rotation, m_scale, m_worldMatrices, m_count].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void TransformBatchClass::Resize(int count)
+{
+	if (count > (int)m_worldMatrices.size())
+	{
+		for (int i = 0; i < 3; i++)
+		{
+			m_position[i].resize(count);
+			m_scale[i].resize(count);
+		}
+		for (int i = 0; i < 4; i++)
+			m_rotation[i].resize(count);
+		m_worldMatrices.resize(count);
+	}
+
+	m_count = count;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Set
+
+Summary:	Fills a slot with what its world matrix is built from.
+
+Args:		int index
+				the slot to fill, from 0 to GetCount() - 1.
+			const XMFLOAT3& position
+				the position of the object.
+			FXMVECTOR rotation
+				the rotation of the object as a unit quaternion.
+			const XMFLOAT3& scale
+				the scale of the object along each of its axes.
+
+Modifies:	[m_position, m_rotation, m_scale].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void TransformBatchClass::Set(int index, const XMFLOAT3 & position, FXMVECTOR rotation, const XMFLOAT3 & scale)
+{
+	XMFLOAT4 quaternion;
+	XMStoreFloat4(&quaternion, rotation);
+
+	m_position[0][index] = position.x;
+	m_position[1][index] = position.y;
+	m_position[2][index] = position.z;
+
+	m_rotation[0][index] = quaternion.x;
+	m_rotation[1][index] = quaternion.y;
+	m_rotation[2][index] = quaternion.z;
+	m_rotation[3][index] = quaternion.w;
+
+	m_scale[0][index] = scale.x;
+	m_scale[1][index] = scale.y;
+	m_scale[2][index] = scale.z;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Compose
+
+Summary:	Builds the world matrices of the slots [begin, end), four at a
+			time. Each matrix is the same as scaling, then rotating, then
+			translating, as XMMatrixScaling(), XMMatrixRotationQuaternion()
+			and XMMatrixTranslation() multiplied together would give.
+			Only the slots in the range are read or written, so ranges that
+			do not overlap can be composed on different threads.
+
+Args:		int begin
+				the first slot to build.
+			int end
+				one past the last slot to build.
+
+Modifies:	[m_worldMatrices].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void TransformBatchClass::Compose(int begin, int end)
+{
+	for (int i = begin; i < end; i += TRANSFORM_BATCH_LANES)
+		ComposeGroup(i, (end - i < TRANSFORM_BATCH_LANES) ? end - i : TRANSFORM_BATCH_LANES);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetWorldMatrix
+
+Summary:	Gets the world matrix last built for a slot.
+
+Args:		int index
+				the slot, from 0 to GetCount() - 1.
+
+Modifies:	[none].
+
+Returns:	const XMFLOAT4X4&
+				the world matrix.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+const XMFLOAT4X4 & TransformBatchClass::GetWorldMatrix(int index)
+{
+	return m_worldMatrices[index];
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetCount
+
+Summary:	Gets the number of slots.
+
+Modifies:	[none].
+
+Returns:	int
+				the number of slots given to Resize().
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+int TransformBatchClass::GetCount()
+{
+	return m_count;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		ComposeGroup
+
+Summary:	Builds the world matrices of up to four slots at once, each
+			lane of every vector holding one slot.
+
+Args:		int first
+				the first slot of the group.
+			int count
+				the number of slots in the group, from 1 to 4.
+
+Modifies:	[m_worldMatrices].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void TransformBatchClass::ComposeGroup(int first, int count)
+{
+	XMVECTOR x = LoadLanes(m_rotation[0], first, count);
+	XMVECTOR y = LoadLanes(m_rotation[1], first, count);
+	XMVECTOR z = LoadLanes(m_rotation[2], first, count);
+	XMVECTOR w = LoadLanes(m_rotation[3], first, count);
+
+	//The products of the quaternion every rotation element is made from.
+	XMVECTOR x2 = XMVectorAdd(x, x);
+	XMVECTOR y2 = XMVectorAdd(y, y);
+	XMVECTOR z2 = XMVectorAdd(z, z);
+
+	XMVECTOR xx = XMVectorMultiply(x, x2);
+	XMVECTOR yy = XMVectorMultiply(y, y2);
+	XMVECTOR zz = XMVectorMultiply(z, z2);
+	XMVECTOR xy = XMVectorMultiply(x, y2);
+	XMVECTOR xz = XMVectorMultiply(x, z2);
+	XMVECTOR yz = XMVectorMultiply(y, z2);
+	XMVECTOR wx = XMVectorMultiply(w, x2);
+	XMVECTOR wy = XMVectorMultiply(w, y2);
+	XMVECTOR wz = XMVectorMultiply(w, z2);
+
+	//Each row of the rotation is scaled by the scale along that axis.
+	XMVECTOR one = XMVectorSplatOne();
+	XMVECTOR zero = XMVectorZero();
+	XMVECTOR scaleX = LoadLanes(m_scale[0], first, count);
+	XMVECTOR scaleY = LoadLanes(m_scale[1], first, count);
+	XMVECTOR scaleZ = LoadLanes(m_scale[2], first, count);
+
+	XMMATRIX row0(
+		XMVectorMultiply(XMVectorSubtract(one, XMVectorAdd(yy, zz)), scaleX),
+		XMVectorMultiply(XMVectorAdd(xy, wz), scaleX),
+		XMVectorMultiply(XMVectorSubtract(xz, wy), scaleX),
+		zero);
+	XMMATRIX row1(
+		XMVectorMultiply(XMVectorSubtract(xy, wz), scaleY),
+		XMVectorMultiply(XMVectorSubtract(one, XMVectorAdd(xx, zz)), scaleY),
+		XMVectorMultiply(XMVectorAdd(yz, wx), scaleY),
+		zero);
+	XMMATRIX row2(
+		XMVectorMultiply(XMVectorAdd(xz, wy), scaleZ),
+		XMVectorMultiply(XMVectorSubtract(yz, wx), scaleZ),
+		XMVectorMultiply(XMVectorSubtract(one, XMVectorAdd(xx, yy)), scaleZ),
+		zero);
+	XMMATRIX row3(
+		LoadLanes(m_position[0], first, count),
+		LoadLanes(m_position[1], first, count),
+		LoadLanes(m_position[2], first, count),
+		one);
+
+	//Turn each element across the lanes into each lane's row.
+	row0 = XMMatrixTranspose(row0);
+	row1 = XMMatrixTranspose(row1);
+	row2 = XMMatrixTranspose(row2);
+	row3 = XMMatrixTranspose(row3);
+
+	for (int lane = 0; lane < count; lane++)
+		XMStoreFloat4x4(&m_worldMatrices[first + lane], XMMATRIX(row0.r[lane], row1.r[lane], row2.r[lane], row3.r[lane]));
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		LoadLanes
+
+Summary:	Loads one component of up to four slots into the lanes of a
+			vector. A group short of four fills its spare lanes with its
+			first slot rather than reading past the end of its range.
+
+Args:		const std::vector<float>& component
+				the array of the component.
+			int first
+				the first slot to load.
+			int count
+				the number of slots to load, from 1 to 4.
+
+Modifies:	[none].
+
+Returns:	XMVECTOR
+				the component of each slot, one to a lane.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+XMVECTOR TransformBatchClass::LoadLanes(const std::vector<float>& component, int first, int count)
+{
+	const float* values = &component[first];
+	if (count == TRANSFORM_BATCH_LANES)
+		return XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(values));
+
+	return XMVectorSet(values[0], values[count > 1 ? 1 : 0], values[count > 2 ? 2 : 0], values[0]);
+}
@@ -0,0 +1,112 @@
+#pragma once
+//======================================================
+//				Filename: TransformBatchClass.h
+//======================================================
+
+
+//======================================================
+//					Include Guards.
+//======================================================
+#ifndef _TRANSFORMBATCHCLASS_H_
+#define _TRANSFORMBATCHCLASS_H_
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <vector>
+#include <DirectXMath.h>
+
+
+//======================================================
+//					Namespaces.
+//======================================================
+using namespace DirectX;
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		TransformBatchClass
+
+Summary:	Builds the world matrices of many objects at once from their
+			positions, rotation quaternions and scales.
+			Each component is kept in its own array, so four objects'
+			worth of it loads into one vector, and every matrix element of
+			four objects is worked out together: the rotation is written
+			straight from the quaternion and scaled row by row, with no
+			matrix multiplies and no trigonometry, then the four matrices
+			are transposed out next to each other.
+			Slots are filled with Set() and built with Compose(), and
+			different ranges can be set and composed from different threads
+			at once.
+
+Methods:	==================== PUBLIC ====================
+			TransformBatchClass()
+				Default constructor.
+			TransformBatchClass(const TransformBatchClass&)
+				Reference constructor.
+			~TransformBatchClass()
+				Default deconstructor.
+
+			void Shutdown()
+				Call before deletion to free the arrays.
+
+			void Resize(int)
+				Use to set the number of slots, keeping the memory of any
+				more used before.
+			void Set(int, const XMFLOAT3&, FXMVECTOR, const XMFLOAT3&)
+				Use to fill a slot with a position, rotation quaternion and
+				scale.
+			void Compose(int, int)
+				Use to build the world matrices of a range of slots.
+			const XMFLOAT4X4& GetWorldMatrix(int)
+				Use to get the world matrix built for a slot.
+			int GetCount()
+				Use to get the number of slots.
+
+			==================== PRIVATE ====================
+			void ComposeGroup(int, int)
+				Used by Compose() to build up to four slots' matrices at once.
+			static XMVECTOR LoadLanes(const std::vector<float>&, int, int)
+				Used by ComposeGroup() to load one component of up to four
+				slots into a vector.
+
+Members:	==================== PRIVATE ====================
+			std::vector<float> m_position[3]
+				the x, y and z of every slot's position.
+			std::vector<float> m_rotation[4]
+				the x, y, z and w of every slot's rotation quaternion.
+			std::vector<float> m_scale[3]
+				the x, y and z of every slot's scale.
+			std::vector<XMFLOAT4X4> m_worldMatrices
+				the world matrix built for every slot.
+			int m_count
+				the number of slots.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class TransformBatchClass
+{
+public:
+	TransformBatchClass();
+	TransformBatchClass(const TransformBatchClass&);
+	~TransformBatchClass();
+
+	void Shutdown();
+
+	void Resize(int count);
+	void Set(int index, const XMFLOAT3& position, FXMVECTOR rotation, const XMFLOAT3& scale);
+	void Compose(int begin, int end);
+	const XMFLOAT4X4& GetWorldMatrix(int index);
+	int GetCount();
+
+private:
+	void ComposeGroup(int first, int count);
+	static XMVECTOR LoadLanes(const std::vector<float>& component, int first, int count);
+
+private:
+	std::vector<float> m_position[3];
+	std::vector<float> m_rotation[4];
+	std::vector<float> m_scale[3];
+	std::vector<XMFLOAT4X4> m_worldMatrices;
+	int m_count;
+};
+
+#endif
@@ -50,15 +50,15 @@ void BumpMapShaderClass::Shutdown()
 }
 
 
-bool BumpMapShaderClass::Render(ID3D11DeviceContext* deviceContext, int indexCount, const XMMATRIX &worldMatrix, const XMMATRIX &viewMatrix,
-	const XMMATRIX &projectionMatrix, ID3D11ShaderResourceView* colorTexture, ID3D11ShaderResourceView* normalMapTexture,
+bool BumpMapShaderClass::Render(RenderContext* deviceContext, int indexCount, const XMMATRIX &worldMatrix, const XMMATRIX &viewProjectionMatrix,
+	ID3D11ShaderResourceView* colorTexture, ID3D11ShaderResourceView* normalMapTexture,
 	XMFLOAT3 lightDirection, XMFLOAT4 diffuseColor)
 {
 	bool result;
 
 
 	// Set the shader parameters that it will use for rendering.
-	result = SetShaderParameters(deviceContext, worldMatrix, viewMatrix, projectionMatrix, colorTexture, normalMapTexture, 
+	result = SetShaderParameters(deviceContext, worldMatrix, viewProjectionMatrix, colorTexture, normalMapTexture, 
 								 lightDirection, diffuseColor);
 	if(!result)
 	{
@@ -345,8 +345,8 @@ void BumpMapShaderClass::OutputShaderErrorMessage(ID3D10Blob* errorMessage, HWND
 }
 
 
-bool BumpMapShaderClass::SetShaderParameters(ID3D11DeviceContext* deviceContext, const XMMATRIX &worldMatrix,
-	const XMMATRIX &viewMatrix, const XMMATRIX &projectionMatrix,
+bool BumpMapShaderClass::SetShaderParameters(RenderContext* deviceContext, const XMMATRIX &worldMatrix,
+	const XMMATRIX &viewProjectionMatrix,
 											 ID3D11ShaderResourceView* colorTexture, ID3D11ShaderResourceView* normalMapTexture, 
 											 XMFLOAT3 lightDirection, XMFLOAT4 diffuseColor)
 {
@@ -371,8 +371,7 @@ bool BumpMapShaderClass::SetShaderParameters(ID3D11DeviceContext* deviceContext,
 
 	// Copy the matrices into the constant buffer.
 	dataPtr->world = XMMatrixTranspose(worldMatrix);
-	dataPtr->view = XMMatrixTranspose(viewMatrix);
-	dataPtr->projection = XMMatrixTranspose(projectionMatrix);
+	dataPtr->viewProjection = XMMatrixTranspose(viewProjectionMatrix);
 
 	// Unlock the matrix constant buffer.
     deviceContext->Unmap(m_matrixBuffer, 0);
@@ -414,7 +413,7 @@ bool BumpMapShaderClass::SetShaderParameters(ID3D11DeviceContext* deviceContext,
 }
 
 
-void BumpMapShaderClass::RenderShader(ID3D11DeviceContext* deviceContext, int indexCount)
+void BumpMapShaderClass::RenderShader(RenderContext* deviceContext, int indexCount)
 {
 	// Set the vertex input layout.
 	deviceContext->IASetInputLayout(m_layout);
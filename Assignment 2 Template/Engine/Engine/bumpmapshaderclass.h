@@ -17,6 +17,12 @@ using namespace DirectX;
 using namespace std;
 
 
+///////////////////////
+// MY CLASS INCLUDES //
+///////////////////////
+#include "RenderContext.h"
+
+
 ////////////////////////////////////////////////////////////////////////////////
 // Class name: BumpMapShaderClass
 ////////////////////////////////////////////////////////////////////////////////
@@ -26,8 +32,7 @@ private:
 	struct MatrixBufferType
 	{
 		XMMATRIX world;
-		XMMATRIX view;
-		XMMATRIX projection;
+		XMMATRIX viewProjection;
 	};
 
 	struct LightBufferType
@@ -44,7 +49,7 @@ public:
 
 	bool Initialize(ID3D11Device*, HWND);
 	void Shutdown();
-	bool Render(ID3D11DeviceContext*, int, const XMMATRIX&, const XMMATRIX&, const XMMATRIX&, ID3D11ShaderResourceView*,
+	bool Render(RenderContext*, int, const XMMATRIX&, const XMMATRIX&, ID3D11ShaderResourceView*,
 		ID3D11ShaderResourceView*, XMFLOAT3, XMFLOAT4);
 
 private:
@@ -52,9 +57,9 @@ private:
 	void ShutdownShader();
 	void OutputShaderErrorMessage(ID3D10Blob*, HWND, WCHAR*);
 
-	bool SetShaderParameters(ID3D11DeviceContext*, const XMMATRIX&, const XMMATRIX&, const XMMATRIX&, ID3D11ShaderResourceView*,
+	bool SetShaderParameters(RenderContext*, const XMMATRIX&, const XMMATRIX&, ID3D11ShaderResourceView*,
 		ID3D11ShaderResourceView*, XMFLOAT3, XMFLOAT4);
-	void RenderShader(ID3D11DeviceContext*, int);
+	void RenderShader(RenderContext*, int);
 
 private:
 	ID3D11VertexShader* m_vertexShader;
@@ -16,7 +16,7 @@ Summary:	Creates a new BumpModelClass object.
 			points all initial pointer objects to zero.
 
 Modifies:	[m_vertexBuffer, m_indexBuffer, m_model, m_ColorTexture, 
-			 m_NormalMapTexture, m_AABB, m_min, m_max].
+			 m_NormalMapTexture, m_AABB, m_BVH, m_min, m_max, m_ready].
 
 Returns:	BumpModelClass
 				The newly created bumpModelClass object.
@@ -30,8 +30,11 @@ BumpModelClass::BumpModelClass()
 	m_NormalMapTexture = 0;
 
 	m_AABB = 0;
+	m_BVH = 0;
 	m_min = 0;
 	m_max = 0;
+
+	m_ready = false;
 }
 
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -89,21 +92,13 @@ bool BumpModelClass::Initialize(ID3D11Device* device, char* modelFilename, WCHAR
 {
 	bool result;
 
-	// Load in the model data,
-	result = LoadModel(modelFilename);
+	// Load in the model data, its tangent space, bounding box and triangle hierarchy.
+	result = LoadMeshData(modelFilename);
 	if(!result)
 	{
 		return false;
 	}
 
-	// Calculate the tangent and binormal vectors for the model.
-	CalculateModelVectors();
-
-	//Setup the boundingbox.
-	result = SetupBoundingBox();
-	if (!result)
-		return false;
-
 	// Initialize the vertex and index buffers.
 	result = InitializeBuffers(device);
 	if(!result)
@@ -118,9 +113,104 @@ bool BumpModelClass::Initialize(ID3D11Device* device, char* modelFilename, WCHAR
 		return false;
 	}
 
+	m_ready = true;
+
+	return true;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Initialize
+
+Summary:	Loads only the vertex data, tangent frames, bounding box and
+			triangle hierarchy of a model, without creating buffers or textures, so it can be
+			used with no device such as by the headless benchmark.
+			The model counts as ready but must never be rendered.
+
+Args:		char* modelFilename
+				a filepath to the model file to be used for this model.
+
+Modifies:	[m_ready].
+
+Returns:	bool
+				was the model data loaded successfully.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool BumpModelClass::Initialize(char* modelFilename)
+{
+	// Load in the model data, its tangent space, bounding box and triangle hierarchy.
+	if (!LoadMeshData(modelFilename))
+		return false;
+
+	m_ready = true;
+
 	return true;
 }
 
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		InitializeAsync
+
+Summary:	Queues this BumpModelClass object to be streamed in by the asset
+			loader. Parsing the model, calculating the tangent and binormal
+			vectors, building the triangle hierarchy and reading both texture
+			files happen on a worker thread;
+			only the buffer and texture creation happen on the device thread.
+
+Args:		AssetLoaderClass* loader
+				the asset loader to queue the model on.
+			char* modelFilename
+				a filepath to the model file to be used for this model.
+			WCHAR* textureFilename1
+				a filepath to the colour texture to be used for this model.
+			WCHAR* textureFilename2
+				a filepath to the normal map texture to be used for this model.
+			TextureStreamerClass* streamer
+				a texture streamer to hand both textures to, or 0 to create
+				them at full resolution.
+
+Modifies:	[m_ColorTexture, m_NormalMapTexture, m_ready].
+
+Returns:	AssetLoaderClass::AssetHandle
+				a handle which becomes true once the model is ready to draw.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+AssetLoaderClass::AssetHandle BumpModelClass::InitializeAsync(AssetLoaderClass* loader, char* modelFilename, WCHAR* textureFilename1, WCHAR* textureFilename2,
+	TextureStreamerClass* streamer)
+{
+	std::string modelPath(modelFilename);
+	std::wstring colorPath(textureFilename1);
+	std::wstring normalPath(textureFilename2);
+
+	m_ready = false;
+
+	// Create the texture objects up front so the worker only has to fill them.
+	m_ColorTexture = new TextureClass;
+	m_NormalMapTexture = new TextureClass;
+
+	return loader->Request(modelFilename,
+		[this, modelPath, colorPath, normalPath]()
+		{
+			// Load in the model data, its tangent space, bounding box and triangle hierarchy.
+			if (!LoadMeshData((char*)modelPath.c_str()))
+				return false;
+
+			// Read both texture files ready for creation on the device thread.
+			return m_ColorTexture->LoadFileData((WCHAR*)colorPath.c_str()) &&
+				m_NormalMapTexture->LoadFileData((WCHAR*)normalPath.c_str());
+		},
+		[this, streamer](ID3D11Device* device)
+		{
+			// Create the vertex and index buffers.
+			if (!InitializeBuffers(device))
+				return false;
+
+			// Create the textures, or hand them to the streamer.
+			if (streamer ? !m_ColorTexture->Initialize(streamer) || !m_NormalMapTexture->Initialize(streamer)
+				: !m_ColorTexture->Initialize(device) || !m_NormalMapTexture->Initialize(device))
+				return false;
+
+			m_ready = true;
+			return true;
+		});
+}
+
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
 Method:		Shutdown
 
@@ -144,6 +234,11 @@ void BumpModelClass::Shutdown()
 	//Release the boundingbox collision data.
 	ReleaseBoundingBox();
 
+	//Release the triangle hierarchy.
+	ReleaseBVH();
+
+	m_ready = false;
+
 	return;
 }
 
@@ -153,12 +248,12 @@ Method:		Render
 Summary:	Puts the vertex and index buffers on the graphics pipeline
 			to prepare them for drawing.
 
-Args:		ID3D11DeviceContext* deviceContext
+Args:		RenderContext* deviceContext
 				the deviceContext that the model will be rendered to.
 
 Modifies:	[none].
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-void BumpModelClass::Render(ID3D11DeviceContext* deviceContext)
+void BumpModelClass::Render(RenderContext* deviceContext)
 {
 	// Put the vertex and index buffers on the graphics pipeline to prepare them for drawing.
 	RenderBuffers(deviceContext);
@@ -223,6 +318,54 @@ BoundingBox * BumpModelClass::GetAABB()
 	return this->m_AABB;
 }
 
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetBVH
+
+Summary:	Returns the hierarchy over the triangles of this model.
+
+Returns:	MeshBVHClass*
+				A pointer to the triangle hierarchy of this model, in model
+				space, or 0 if it has not been loaded.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+MeshBVHClass* BumpModelClass::GetBVH()
+{
+	return m_BVH;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		IsReady
+
+Summary:	Returns whether the buffers and textures of this model have
+			been created and it can be drawn.
+
+Returns:	bool
+				true once the model is ready to draw.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool BumpModelClass::IsReady()
+{
+	return m_ready;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RequestTextureSize
+
+Summary:	Tells both textures of this model how large the model is on
+			screen, so streamed textures can fetch the mips they need.
+
+Args:		float screenPixels
+				the size of the model on screen, in pixels.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void BumpModelClass::RequestTextureSize(float screenPixels)
+{
+	if (m_ColorTexture)
+		m_ColorTexture->RequestSize(screenPixels);
+
+	if (m_NormalMapTexture)
+		m_NormalMapTexture->RequestSize(screenPixels);
+}
+
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
 Method:		InitializeBuffers
 
@@ -358,12 +501,12 @@ Method:		RenderBuffers
 Summary:	Used to activate the index and vertex buffers so that they
 			will be rendered by the deviceContext.
 
-Args:		ID3D11DeviceContext* deviceContext
+Args:		RenderContext* deviceContext
 				The device context to prepare the buffers for rendering on.
 
 Modifies:	[none].
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-void BumpModelClass::RenderBuffers(ID3D11DeviceContext* deviceContext)
+void BumpModelClass::RenderBuffers(RenderContext* deviceContext)
 {
 	unsigned int stride;
 	unsigned int offset;
@@ -470,6 +613,35 @@ void BumpModelClass::ReleaseTextures()
 	return;
 }
 
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		LoadMeshData
+
+Summary:	Loads the Model data from a .txt file along with everything
+				built from it: the tangent frames, bounding box and
+				triangle hierarchy.
+			Shared by every Initialize, so a streamed model builds them on
+				the loader's worker thread.
+
+Args:		char* filename
+				a filepath to the .txt file containing the model's
+				vertex data.
+
+Modifies:	[m_vertexCount, m_indexCount, m_model, m_min, m_max, m_AABB, m_BVH].
+
+Returns:	bool
+				was the model data loaded and everything built from it.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool BumpModelClass::LoadMeshData(char* filename)
+{
+	if (!LoadModel(filename))
+		return false;
+
+	// Calculate the tangent and binormal vectors for the model.
+	CalculateModelVectors();
+
+	return SetupBoundingBox() && SetupBVH();
+}
+
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
 Method:		LoadModel
 
@@ -608,158 +780,350 @@ void BumpModelClass::ReleaseModel()
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
 Method:		CalculateModelVectors
 
-Summary:	Uses the existing vertex normal data to calculate a normal
-			for each face of the mesh. (Tris)
-
-Modifies:	[none].
+Summary:	Calculates a smoothed tangent and binormal for every vertex
+			of the mesh.
+				1. Vertices sharing a position, texture co-ordinate and
+				   normal are welded together.
+				2. A tangent frame is calculated for every face, four
+				   faces at a time.
+				3. The face frames around each welded vertex are weighted
+				   by corner angle, summed and orthonormalized against the
+				   vertex normal, MikkTSpace style.
+			Steps 2 and 3 are split across the job system for large
+			meshes. Models streamed in on a loader thread pass none, as
+			the loader's threads already keep the cores busy and can't
+			queue jobs, so they build their frames on that thread alone.
+
+Args:		JobSystemClass* jobSystem
+				the job system to split large meshes across, or 0 to
+				run every step on the calling thread. Must be called from
+				the thread that initialized it, or from inside a job.
+
+Modifies:	[m_model].
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-void BumpModelClass::CalculateModelVectors()
+void BumpModelClass::CalculateModelVectors(JobSystemClass* jobSystem)
 {
-	int faceCount, i, index;
-	TempVertexType vertex1, vertex2, vertex3;
-	VectorType tangent, binormal;
+	int faceCount, weldCount, i;
 
 
 	// Calculate the number of faces in the model.
 	faceCount = m_vertexCount / 3;
+	if (faceCount == 0)
+		return;
+
+	// Weld the vertices of the mesh.
+	std::vector<int> weldIndex(m_vertexCount);
+	weldCount = WeldVertices(weldIndex.data());
+
+	// Build a list of the corners that make up each welded vertex.
+	std::vector<int> weldOffsets(weldCount + 1, 0);
+	std::vector<int> weldCorners(faceCount * 3);
+	for (i = 0; i < faceCount * 3; i++)
+		weldOffsets[weldIndex[i] + 1]++;
+	for (i = 0; i < weldCount; i++)
+		weldOffsets[i + 1] += weldOffsets[i];
+
+	std::vector<int> cursor(weldOffsets.begin(), weldOffsets.end() - 1);
+	for (i = 0; i < faceCount * 3; i++)
+		weldCorners[cursor[weldIndex[i]]++] = i;
+
+	// Calculate the tangent frame and corner weights of every face.
+	std::vector<XMFLOAT3> faceTangents(faceCount), faceBinormals(faceCount);
+	std::vector<float> cornerWeights(faceCount * 3);
+	RunParallel(jobSystem, (faceCount + 3) / 4, TANGENT_PARALLEL_MIN_WORK / 4,
+		[&](int first, int last)
+		{
+			CalculateFaceTangents(first * 4, std::min<int>(last * 4, faceCount),
+				faceTangents.data(), faceBinormals.data(), cornerWeights.data());
+		});
+
+	// Sum and orthonormalize the frames around every welded vertex.
+	RunParallel(jobSystem, weldCount, TANGENT_PARALLEL_MIN_WORK,
+		[&](int first, int last)
+		{
+			AccumulateVertexTangents(first, last, weldOffsets.data(), weldCorners.data(),
+				faceTangents.data(), faceBinormals.data(), cornerWeights.data());
+		});
+
+	return;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		WeldVertices
+
+Summary:	Finds the vertices of the mesh that share a position, texture
+			co-ordinate and normal so their tangent frames can be shared.
+
+Args:		int* weldIndex
+				an array of m_vertexCount ints to store the welded vertex
+				index of each vertex in.
+
+Modifies:	[none].
+
+Returns:	int
+				the number of unique welded vertices.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+int BumpModelClass::WeldVertices(int* weldIndex)
+{
+	std::unordered_map<WeldKey, int, WeldKeyHash> welded;
+	WeldKey key;
+	int i;
+
 
-	// Initialize the index to the model data.
-	index = 0;
+	welded.reserve(m_vertexCount);
 
-	// Go through all the faces and calculate the the tangent, binormal, and normal vectors.
-	for(i=0; i<faceCount; i++)
+	for (i = 0; i < m_vertexCount; i++)
 	{
-		// Get the three vertices for this face from the model.
-		vertex1.x = m_model[index].x;
-		vertex1.y = m_model[index].y;
-		vertex1.z = m_model[index].z;
-		vertex1.tu = m_model[index].tu;
-		vertex1.tv = m_model[index].tv;
-		vertex1.nx = m_model[index].nx;
-		vertex1.ny = m_model[index].ny;
-		vertex1.nz = m_model[index].nz;
-		index++;
-
-		vertex2.x = m_model[index].x;
-		vertex2.y = m_model[index].y;
-		vertex2.z = m_model[index].z;
-		vertex2.tu = m_model[index].tu;
-		vertex2.tv = m_model[index].tv;
-		vertex2.nx = m_model[index].nx;
-		vertex2.ny = m_model[index].ny;
-		vertex2.nz = m_model[index].nz;
-		index++;
-
-		vertex3.x = m_model[index].x;
-		vertex3.y = m_model[index].y;
-		vertex3.z = m_model[index].z;
-		vertex3.tu = m_model[index].tu;
-		vertex3.tv = m_model[index].tv;
-		vertex3.nx = m_model[index].nx;
-		vertex3.ny = m_model[index].ny;
-		vertex3.nz = m_model[index].nz;
-		index++;
-
-		// Calculate the tangent and binormal of that face.
-		CalculateTangentBinormal(vertex1, vertex2, vertex3, tangent, binormal);
-
-		// Store the normal, tangent, and binormal for this face back in the model structure.
-		m_model[index-1].tx = tangent.x;
-		m_model[index-1].ty = tangent.y;
-		m_model[index-1].tz = tangent.z;
-		m_model[index-1].bx = binormal.x;
-		m_model[index-1].by = binormal.y;
-		m_model[index-1].bz = binormal.z;
-
-		m_model[index-2].tx = tangent.x;
-		m_model[index-2].ty = tangent.y;
-		m_model[index-2].tz = tangent.z;
-		m_model[index-2].bx = binormal.x;
-		m_model[index-2].by = binormal.y;
-		m_model[index-2].bz = binormal.z;
-
-		m_model[index-3].tx = tangent.x;
-		m_model[index-3].ty = tangent.y;
-		m_model[index-3].tz = tangent.z;
-		m_model[index-3].bx = binormal.x;
-		m_model[index-3].by = binormal.y;
-		m_model[index-3].bz = binormal.z;
+		key.values[0] = m_model[i].x;
+		key.values[1] = m_model[i].y;
+		key.values[2] = m_model[i].z;
+		key.values[3] = m_model[i].tu;
+		key.values[4] = m_model[i].tv;
+		key.values[5] = m_model[i].nx;
+		key.values[6] = m_model[i].ny;
+		key.values[7] = m_model[i].nz;
+
+		// Reuse the index of an identical vertex, or give this one a new index.
+		weldIndex[i] = welded.insert(std::make_pair(key, (int)welded.size())).first->second;
 	}
 
-	return;
+	return (int)welded.size();
 }
 
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-Method:		CalculateTangentBinormal
-
-Summary:	Calculate a resultant tangent and Binormal to the three
-			specified TempVertexTypes and store the result in
-			tangent and bionormal.
-
-Args:		TempVertexType vertex1, vertex2, vertex3
-				the three vertices comprising a triangle within
-				the model mesh.
-			VectorType& tangent
-				A reference to the vectorType struct instance to store
-				the result tangent in.
-			VectorType& binormal
-				A reference to the vectorType struct instance to store
-				the result binormal in.
+Method:		CalculateFaceTangents
+
+Summary:	Calculates a normalized tangent and binormal for a range of
+			faces, along with the angle at each of their corners.
+			Faces are processed four at a time, with one face in each
+			lane of the SIMD registers.
+
+Args:		int firstFace
+				the first face to process.
+			int lastFace
+				one past the last face to process.
+			XMFLOAT3* faceTangents
+				an array to store the tangent of each face in.
+			XMFLOAT3* faceBinormals
+				an array to store the binormal of each face in.
+			float* cornerWeights
+				an array to store the angle at each corner in.
 
 Modifies:	[none].
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-void BumpModelClass::CalculateTangentBinormal(TempVertexType vertex1, TempVertexType vertex2, TempVertexType vertex3,
-										  VectorType& tangent, VectorType& binormal)
+void BumpModelClass::CalculateFaceTangents(int firstFace, int lastFace, XMFLOAT3* faceTangents,
+	XMFLOAT3* faceBinormals, float* cornerWeights)
 {
-	float vector1[3], vector2[3];
-	float tuVector[2], tvVector[2];
-	float den;
-	float length;
+	const XMVECTOR epsilon = XMVectorReplicate(1e-20f);
+	int face, lane, lanes;
+	int corner[4];
+	float tangent[3][4], binormal[3][4], weight[3][4];
+
 
+	for (face = firstFace; face < lastFace; face += 4)
+	{
+		// Repeat the last face to fill any unused lanes.
+		lanes = std::min<int>(4, lastFace - face);
+		for (lane = 0; lane < 4; lane++)
+			corner[lane] = (face + std::min<int>(lane, lanes - 1)) * 3;
+
+		// Gather one component of one corner from each of the four faces.
+		auto gather = [&](int offset, float ModelType::* member)
+		{
+			return XMVectorSet(m_model[corner[0] + offset].*member, m_model[corner[1] + offset].*member,
+				m_model[corner[2] + offset].*member, m_model[corner[3] + offset].*member);
+		};
+
+		XMVECTOR x0 = gather(0, &ModelType::x), y0 = gather(0, &ModelType::y), z0 = gather(0, &ModelType::z);
+		XMVECTOR x1 = gather(1, &ModelType::x), y1 = gather(1, &ModelType::y), z1 = gather(1, &ModelType::z);
+		XMVECTOR x2 = gather(2, &ModelType::x), y2 = gather(2, &ModelType::y), z2 = gather(2, &ModelType::z);
+		XMVECTOR u0 = gather(0, &ModelType::tu), v0 = gather(0, &ModelType::tv);
+		XMVECTOR u1 = gather(1, &ModelType::tu), v1 = gather(1, &ModelType::tv);
+		XMVECTOR u2 = gather(2, &ModelType::tu), v2 = gather(2, &ModelType::tv);
+
+		// Calculate the two edge vectors and the tu and tv texture space vectors.
+		XMVECTOR e1x = x1 - x0, e1y = y1 - y0, e1z = z1 - z0;
+		XMVECTOR e2x = x2 - x0, e2y = y2 - y0, e2z = z2 - z0;
+		XMVECTOR du1 = u1 - u0, dv1 = v1 - v0;
+		XMVECTOR du2 = u2 - u0, dv2 = v2 - v0;
+
+		// Calculate the denominator, zeroing faces with a degenerate texture mapping.
+		XMVECTOR det = du1 * dv2 - du2 * dv1;
+		XMVECTOR valid = XMVectorGreater(XMVectorAbs(det), epsilon);
+		XMVECTOR den = XMVectorSelect(XMVectorZero(), XMVectorReciprocal(det), valid);
+
+		// Calculate the tangent and binormal.
+		XMVECTOR tanX = (dv2 * e1x - dv1 * e2x) * den;
+		XMVECTOR tanY = (dv2 * e1y - dv1 * e2y) * den;
+		XMVECTOR tanZ = (dv2 * e1z - dv1 * e2z) * den;
+		XMVECTOR binX = (du1 * e2x - du2 * e1x) * den;
+		XMVECTOR binY = (du1 * e2y - du2 * e1y) * den;
+		XMVECTOR binZ = (du1 * e2z - du2 * e1z) * den;
+
+		// Normalize them, leaving zero length vectors as zero.
+		XMVECTOR tanScale = XMVectorSelect(XMVectorZero(),
+			XMVectorReciprocalSqrt(XMVectorMax(tanX * tanX + tanY * tanY + tanZ * tanZ, epsilon)), valid);
+		XMVECTOR binScale = XMVectorSelect(XMVectorZero(),
+			XMVectorReciprocalSqrt(XMVectorMax(binX * binX + binY * binY + binZ * binZ, epsilon)), valid);
+		XMStoreFloat4((XMFLOAT4*)tangent[0], tanX * tanScale);
+		XMStoreFloat4((XMFLOAT4*)tangent[1], tanY * tanScale);
+		XMStoreFloat4((XMFLOAT4*)tangent[2], tanZ * tanScale);
+		XMStoreFloat4((XMFLOAT4*)binormal[0], binX * binScale);
+		XMStoreFloat4((XMFLOAT4*)binormal[1], binY * binScale);
+		XMStoreFloat4((XMFLOAT4*)binormal[2], binZ * binScale);
+
+		// Calculate the angle at each corner from the normalized edges leaving it.
+		XMVECTOR e3x = x2 - x1, e3y = y2 - y1, e3z = z2 - z1;
+		XMVECTOR len1 = XMVectorReciprocalSqrt(XMVectorMax(e1x * e1x + e1y * e1y + e1z * e1z, epsilon));
+		XMVECTOR len2 = XMVectorReciprocalSqrt(XMVectorMax(e2x * e2x + e2y * e2y + e2z * e2z, epsilon));
+		XMVECTOR len3 = XMVectorReciprocalSqrt(XMVectorMax(e3x * e3x + e3y * e3y + e3z * e3z, epsilon));
+		XMVECTOR cos0 = (e1x * e2x + e1y * e2y + e1z * e2z) * len1 * len2;
+		XMVECTOR cos1 = -(e1x * e3x + e1y * e3y + e1z * e3z) * len1 * len3;
+		XMVECTOR cos2 = (e2x * e3x + e2y * e3y + e2z * e3z) * len2 * len3;
+		XMStoreFloat4((XMFLOAT4*)weight[0], XMVectorACos(XMVectorClamp(cos0, g_XMNegativeOne, g_XMOne)));
+		XMStoreFloat4((XMFLOAT4*)weight[1], XMVectorACos(XMVectorClamp(cos1, g_XMNegativeOne, g_XMOne)));
+		XMStoreFloat4((XMFLOAT4*)weight[2], XMVectorACos(XMVectorClamp(cos2, g_XMNegativeOne, g_XMOne)));
+
+		// Store the results of the lanes that hold real faces.
+		for (lane = 0; lane < lanes; lane++)
+		{
+			faceTangents[face + lane] = XMFLOAT3(tangent[0][lane], tangent[1][lane], tangent[2][lane]);
+			faceBinormals[face + lane] = XMFLOAT3(binormal[0][lane], binormal[1][lane], binormal[2][lane]);
+			cornerWeights[(face + lane) * 3 + 0] = weight[0][lane];
+			cornerWeights[(face + lane) * 3 + 1] = weight[1][lane];
+			cornerWeights[(face + lane) * 3 + 2] = weight[2][lane];
+		}
+	}
 
-	// Calculate the two vectors for this face.
-	vector1[0] = vertex2.x - vertex1.x;
-	vector1[1] = vertex2.y - vertex1.y;
-	vector1[2] = vertex2.z - vertex1.z;
+	return;
+}
 
-	vector2[0] = vertex3.x - vertex1.x;
-	vector2[1] = vertex3.y - vertex1.y;
-	vector2[2] = vertex3.z - vertex1.z;
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		AccumulateVertexTangents
+
+Summary:	Builds the final tangent and binormal of a range of welded
+			vertices and writes them to every vertex welded to it.
+			Each face tangent is projected onto the plane of the vertex
+			normal and weighted by its corner angle. The binormal is
+			rebuilt from the normal and tangent, flipped to match the
+			handedness of the summed face binormals.
+
+Args:		int firstWeld
+				the first welded vertex to process.
+			int lastWeld
+				one past the last welded vertex to process.
+			const int* weldOffsets
+				the offset of the first corner of each welded vertex in
+				weldCorners.
+			const int* weldCorners
+				the corners of each welded vertex.
+			const XMFLOAT3* faceTangents
+				the normalized tangent of each face.
+			const XMFLOAT3* faceBinormals
+				the normalized binormal of each face.
+			const float* cornerWeights
+				the angle at each corner.
+
+Modifies:	[m_model].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void BumpModelClass::AccumulateVertexTangents(int firstWeld, int lastWeld, const int* weldOffsets, const int* weldCorners,
+	const XMFLOAT3* faceTangents, const XMFLOAT3* faceBinormals, const float* cornerWeights)
+{
+	int weld, i, corner;
 
-	// Calculate the tu and tv texture space vectors.
-	tuVector[0] = vertex2.tu - vertex1.tu;
-	tvVector[0] = vertex2.tv - vertex1.tv;
 
-	tuVector[1] = vertex3.tu - vertex1.tu;
-	tvVector[1] = vertex3.tv - vertex1.tv;
+	for (weld = firstWeld; weld < lastWeld; weld++)
+	{
+		// Skip vertices that are not part of a whole face.
+		if (weldOffsets[weld] == weldOffsets[weld + 1])
+			continue;
+
+		// Every corner of a welded vertex shares the same normal.
+		corner = weldCorners[weldOffsets[weld]];
+		XMVECTOR normal = XMVector3Normalize(XMVectorSet(m_model[corner].nx, m_model[corner].ny, m_model[corner].nz, 0.0f));
+
+		// Sum the weighted face frames, keeping the tangents in the plane of the normal.
+		XMVECTOR tangent = XMVectorZero();
+		XMVECTOR binormal = XMVectorZero();
+		for (i = weldOffsets[weld]; i < weldOffsets[weld + 1]; i++)
+		{
+			corner = weldCorners[i];
+			XMVECTOR weight = XMVectorReplicate(cornerWeights[corner]);
+			XMVECTOR faceTangent = XMLoadFloat3(&faceTangents[corner / 3]);
+
+			faceTangent -= normal * XMVector3Dot(normal, faceTangent);
+			tangent += XMVector3Normalize(faceTangent) * weight;
+			binormal += XMLoadFloat3(&faceBinormals[corner / 3]) * weight;
+		}
+
+		// Fall back to any vector perpendicular to the normal if nothing contributed.
+		if (XMVectorGetX(XMVector3LengthSq(tangent)) < 1e-12f)
+		{
+			tangent = XMVector3Cross(normal, g_XMIdentityR1);
+			if (XMVectorGetX(XMVector3LengthSq(tangent)) < 1e-12f)
+				tangent = XMVector3Cross(normal, g_XMIdentityR0);
+		}
+		tangent = XMVector3Normalize(tangent);
+
+		// Rebuild the binormal from the normal and tangent with the summed handedness.
+		XMVECTOR rebuilt = XMVector3Cross(normal, tangent);
+		if (XMVectorGetX(XMVector3Dot(rebuilt, binormal)) < 0.0f)
+			rebuilt = XMVectorNegate(rebuilt);
+
+		XMFLOAT3 t, b;
+		XMStoreFloat3(&t, tangent);
+		XMStoreFloat3(&b, rebuilt);
+
+		// Store the frame in every vertex welded to this one.
+		for (i = weldOffsets[weld]; i < weldOffsets[weld + 1]; i++)
+		{
+			corner = weldCorners[i];
+			m_model[corner].tx = t.x;
+			m_model[corner].ty = t.y;
+			m_model[corner].tz = t.z;
+			m_model[corner].bx = b.x;
+			m_model[corner].by = b.y;
+			m_model[corner].bz = b.z;
+		}
+	}
 
-	// Calculate the denominator of the tangent/binormal equation.
-	den = 1.0f / (tuVector[0] * tvVector[1] - tuVector[1] * tvVector[0]);
+	return;
+}
 
-	// Calculate the cross products and multiply by the coefficient to get the tangent and binormal.
-	tangent.x = (tvVector[1] * vector1[0] - tvVector[0] * vector2[0]) * den;
-	tangent.y = (tvVector[1] * vector1[1] - tvVector[0] * vector2[1]) * den;
-	tangent.z = (tvVector[1] * vector1[2] - tvVector[0] * vector2[2]) * den;
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RunParallel
+
+Summary:	Splits a range of work items into batches queued on the job
+			system, then waits for them all, running queued jobs on the
+			calling thread meanwhile. Without a job system, or for ranges
+			too small to split, the range is run on the calling thread.
+
+Args:		JobSystemClass* jobSystem
+				the job system to queue the batches on, or 0.
+			int count
+				the number of work items.
+			int minBatchSize
+				the fewest work items worth handing to a job.
+			const std::function<void(int, int)>& body
+				the work to run on each [first, last) batch.
 
-	binormal.x = (tuVector[0] * vector2[0] - tuVector[1] * vector1[0]) * den;
-	binormal.y = (tuVector[0] * vector2[1] - tuVector[1] * vector1[1]) * den;
-	binormal.z = (tuVector[0] * vector2[2] - tuVector[1] * vector1[2]) * den;
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void BumpModelClass::RunParallel(JobSystemClass* jobSystem, int count, int minBatchSize, const std::function<void(int, int)>& body)
+{
+	if (count <= 0)
+		return;
 
-	// Calculate the length of this normal.
-	length = sqrt((tangent.x * tangent.x) + (tangent.y * tangent.y) + (tangent.z * tangent.z));
-			
-	// Normalize the normal and then store it
-	tangent.x = tangent.x / length;
-	tangent.y = tangent.y / length;
-	tangent.z = tangent.z / length;
+	// Run it here if there is nothing to split it across, or it isn't worth splitting.
+	if (!jobSystem || jobSystem->GetWorkerCount() == 0 || count < minBatchSize * 2)
+	{
+		body(0, count);
+		return;
+	}
 
-	// Calculate the length of this normal.
-	length = sqrt((binormal.x * binormal.x) + (binormal.y * binormal.y) + (binormal.z * binormal.z));
-			
-	// Normalize the normal and then store it
-	binormal.x = binormal.x / length;
-	binormal.y = binormal.y / length;
-	binormal.z = binormal.z / length;
+	JobCounter counter;
+	jobSystem->ParallelFor(count, minBatchSize, body, &counter);
+	jobSystem->Wait(&counter);
 
 	return;
 }
@@ -802,3 +1166,40 @@ void BumpModelClass::ReleaseBoundingBox()
 		m_AABB = 0;
 	}
 }
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		SetupBVH
+
+Summary:	Builds a hierarchy over the triangles of the loaded model data,
+				so a ray can find exactly which triangle it hits.
+
+Modifies:	[m_BVH].
+
+Returns:	bool
+				was the creation of the hierarchy successful.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool BumpModelClass::SetupBVH()
+{
+	//Create a new hierarchy.
+	m_BVH = new MeshBVHClass;
+
+	//Build it over the positions of every vertex, three to a triangle.
+	return m_BVH->Initialize(&m_model[0].x, sizeof(ModelType), m_vertexCount);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		ReleaseBVH
+
+Summary:	Shuts down, deletes and de-points the triangle hierarchy.
+
+Modifies:	[m_BVH].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void BumpModelClass::ReleaseBVH()
+{
+	if (m_BVH)
+	{
+		m_BVH->Shutdown();
+		delete m_BVH;
+		m_BVH = 0;
+	}
+}
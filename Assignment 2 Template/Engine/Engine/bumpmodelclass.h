@@ -17,11 +17,20 @@
 #include <directXMath.h>
 #include <fstream>
 #include <DirectXCollision.h>
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <unordered_map>
+#include <vector>
 
 //================================================
 //	User Defined Headers.
 //================================================
 #include "textureclass.h"
+#include "AssetLoaderClass.h"
+#include "RenderContext.h"
+#include "MeshBVHClass.h"
+#include "JobSystemClass.h"
 
 
 //================================================
@@ -31,6 +40,12 @@ using namespace std;
 using namespace DirectX;
 
 
+//================================================
+//	Constants.
+//================================================
+const int TANGENT_PARALLEL_MIN_WORK = 4096;
+
+
 
 
 /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
@@ -46,12 +61,11 @@ Structs:	VertexType
 					tangent and binormal.
 			ModelType
 				A struct to represent co-ordinates for each vertexType value.
-			TempVertexType
-				A struct to represent vertexType without tangent and binormal
-				before they have been calculated.
-			VectorType
-				A struct to represent the 3 values of a vector
-					x,y,z.
+			WeldKey
+				A struct to represent the position, texture and normal of a
+				vertex, used to find vertices that should share a tangent frame.
+			WeldKeyHash
+				A hash function for WeldKey.
 
 Methods:	==================== PUBLIC ====================
 			BumpModelClass();
@@ -63,9 +77,18 @@ Methods:	==================== PUBLIC ====================
 
 			bool Initialize(ID3D11Device*, char*, WCHAR*, WCHAR*)
 				Call after creating to set up BumpModelClass object for use.
+			bool Initialize(char*)
+				Call after creating to load only the vertex data, tangent
+				frames and bounds, with no buffers or textures, for running
+				without a device. Must never be rendered.
+			AssetLoaderClass::AssetHandle InitializeAsync(AssetLoaderClass*, char*, WCHAR*, WCHAR*, TextureStreamerClass*)
+				Call after creating to stream the BumpModelClass object in on the
+				loader's worker threads instead. Not drawable until IsReady().
+				If a TextureStreamerClass is given both textures' mips are
+				streamed by it.
 			void Shutdown()
 				Call before finished using to tear down the object.
-			void Render(ID3D11DeviceContext*)
+			void Render(RenderContext*)
 				Call during the rendering loop to draw this model to the screen.
 
 			int GetIndexCount()
@@ -75,13 +98,27 @@ Methods:	==================== PUBLIC ====================
 			ID3D11ShaderResourceView* GetNormalMapTexture()
 				a utility function to return the normal map texture used for this model
 				as a resource.
+			MeshBVHClass* GetBVH()
+				a utility function to return the triangle hierarchy of this model,
+				for picking.
+			bool IsReady()
+				a utility function to return whether the buffers and textures of
+				this model have been created.
+			void RequestTextureSize(float)
+				Use while rendering to tell streamed textures how large the
+				model is on screen, in pixels.
+
+			void CalculateModelVectors(JobSystemClass*)
+				Called by LoadMeshData() to calculate a smoothed tangent and
+				binormal for each point. Public so the benchmark can time it.
+				Large meshes are split across the job system if one is given.
 
 			==================== PRIVATE ====================
 			InitializeBuffers(ID3D11Device*)
 				Called by Initialize() to initialize the index and vertex buffer in memory.
 			ShutdownBuffers()
 				Called by Shutdown() to clear the vertex and index buffers from memory.
-			RenderBuffers(ID3D11DeviceContext)
+			RenderBuffers(RenderContext)
 				Called by Render to activate the vertex and index buffer for rendering.
 
 			bool LoadTextures(ID3D11Device*, WCHAR*, WCHAR*)
@@ -90,26 +127,42 @@ Methods:	==================== PUBLIC ====================
 			void ReleaseTextures()
 				Called by Shutdown() to release the texture objects from memory.
 
+			bool LoadMeshData(char*)
+				Called by Initialize() and InitializeAsync() to load the vertex
+				data of the specified model and build its tangent frames,
+				bounding box and triangle hierarchy.
 			bool LoadModel(char*)
-				Called by Initialize() to create and initialize a ModelType
+				Called by LoadMeshData() to create and initialize a ModelType
 				array for the vertex data of the specified model.
 				Also calculates the min and max points of the model.
 			void ReleaseModel()
 				Called by Shutdown() to release the ModelType data and
 				the min and max points from memory.
 
-			void CalculateModelVectors()
-				Called by Initialize() to calculate the Binormal, tangent
-				and normal vectors for each point.
-			void Calculate TangentBinormal(...)
-				Called by CalculateModelVectors() to find a tangent
-				and binormal for an entire face.
+			int WeldVertices(int*)
+				Called by CalculateModelVectors() to find the vertices that
+				share a position, texture co-ordinate and normal.
+			void CalculateFaceTangents(...)
+				Called by CalculateModelVectors() to find a tangent and
+				binormal for a range of faces, four faces at a time.
+			void AccumulateVertexTangents(...)
+				Called by CalculateModelVectors() to sum and orthonormalize
+				the face frames around a range of welded vertices.
+			static void RunParallel(JobSystemClass*, int, int, const function<void(int, int)>&)
+				Called by CalculateModelVectors() to split a range of work
+				across the job system, or run it on the calling thread without one.
 
 			bool SetupBoundingBox()
-				called by Initialize() to create a bounding box structure from the 
+				called by LoadMeshData() to create a bounding box structure from the 
 				precalculated min and max points of the model.
 			void ReleaseBoundingBox()
 				called by shutdown() to release the bounding box from memory.
+
+			bool SetupBVH()
+				called by LoadMeshData() to build a triangle hierarchy for picking
+				from the loaded model data.
+			void ReleaseBVH()
+				called by shutdown() to release the triangle hierarchy from memory.
 				
 
 Members:	==================== PRIVATE ====================
@@ -135,6 +188,12 @@ Members:	==================== PRIVATE ====================
 
 			BoundingBox* m_AABB
 				A boundingBox representing the collision data of this model.
+			MeshBVHClass* m_BVH
+				A hierarchy over the triangles of this model, in model space, for
+				finding exactly where a ray hits it.
+
+			bool m_ready
+				whether the buffers and textures of this model have been created.
 
 			XMFLOAT3* m_min
 				A pointer to an XMFLOAT3 object to be used to store the minimum
@@ -164,16 +223,27 @@ private:
 		float bx, by, bz;
 	};
 
-	struct TempVertexType
+	struct WeldKey
 	{
-		float x, y, z;
-		float tu, tv;
-		float nx, ny, nz;
+		float values[8];
+
+		bool operator==(const WeldKey& other) const
+		{
+			return memcmp(values, other.values, sizeof(values)) == 0;
+		}
 	};
 
-	struct VectorType
+	struct WeldKeyHash
 	{
-		float x, y, z;
+		size_t operator()(const WeldKey& key) const
+		{
+			// FNV-1a over the raw bytes of the key.
+			const unsigned char* bytes = (const unsigned char*)key.values;
+			size_t hash = 2166136261u;
+			for (size_t i = 0; i < sizeof(key.values); i++)
+				hash = (hash ^ bytes[i]) * 16777619u;
+			return hash;
+		}
 	};
 
 public:
@@ -182,32 +252,45 @@ public:
 	~BumpModelClass();
 
 	bool Initialize(ID3D11Device*, char*, WCHAR*, WCHAR*);
+	bool Initialize(char*);
+	AssetLoaderClass::AssetHandle InitializeAsync(AssetLoaderClass*, char*, WCHAR*, WCHAR*, TextureStreamerClass* = 0);
 	void Shutdown();
-	void Render(ID3D11DeviceContext*);
+	void Render(RenderContext*);
 
 	int GetIndexCount();
 	ID3D11ShaderResourceView* GetColorTexture();
 	ID3D11ShaderResourceView* GetNormalMapTexture();
 
 	BoundingBox* GetAABB();
+	MeshBVHClass* GetBVH();
+	bool IsReady();
+	void RequestTextureSize(float);
+
+	void CalculateModelVectors(JobSystemClass* jobSystem = 0);
 
 private:
 	bool InitializeBuffers(ID3D11Device*);
 	void ShutdownBuffers();
-	void RenderBuffers(ID3D11DeviceContext*);
+	void RenderBuffers(RenderContext*);
 
 	bool LoadTextures(ID3D11Device*, WCHAR*, WCHAR*);
 	void ReleaseTextures();
 
+	bool LoadMeshData(char*);
 	bool LoadModel(char*);
 	void ReleaseModel();
 
-	void CalculateModelVectors();
-	void CalculateTangentBinormal(TempVertexType, TempVertexType, TempVertexType, VectorType&, VectorType&);
+	int WeldVertices(int*);
+	void CalculateFaceTangents(int, int, XMFLOAT3*, XMFLOAT3*, float*);
+	void AccumulateVertexTangents(int, int, const int*, const int*, const XMFLOAT3*, const XMFLOAT3*, const float*);
+	static void RunParallel(JobSystemClass*, int, int, const function<void(int, int)>&);
 
 	bool SetupBoundingBox();
 	void ReleaseBoundingBox();
 
+	bool SetupBVH();
+	void ReleaseBVH();
+
 private:
 	ID3D11Buffer *m_vertexBuffer, *m_indexBuffer;
 	int m_vertexCount, m_indexCount;
@@ -217,6 +300,10 @@ private:
 
 	BoundingBox* m_AABB;
 
+	MeshBVHClass* m_BVH;
+
+	bool m_ready;
+
 public:
 	XMFLOAT3* m_min;
 	XMFLOAT3* m_max;
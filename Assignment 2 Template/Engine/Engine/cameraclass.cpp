@@ -14,7 +14,18 @@ CameraClass::CameraClass()
 	m_rotationY = 0.0f;
 	m_rotationZ = 0.0f;
 
-	m_LookAt = new XMFLOAT3(0.f, 0.f, 1.f);
+	m_orientation = XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f);
+	m_reflectionOrientation = XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f);
+
+	m_viewMatrix = XMMatrixIdentity();
+	m_projectionMatrix = XMMatrixIdentity();
+	m_viewProjectionMatrix = XMMatrixIdentity();
+	m_inverseViewMatrix = XMMatrixIdentity();
+
+	// Nothing has been built yet, so the first Render() must build everything.
+	m_dirty = true;
+
+	m_lookDirection = XMFLOAT3(0.0f, 0.0f, 1.0f);
 }
 
 
@@ -30,6 +41,13 @@ CameraClass::~CameraClass()
 
 void CameraClass::SetPosition(float x, float y, float z)
 {
+	// Keep the cached matrices if the camera has not moved.
+	if (x == m_positionX && y == m_positionY && z == m_positionZ)
+	{
+		return;
+	}
+
+	m_dirty = true;
 	m_positionX = x;
 	m_positionY = y;
 	m_positionZ = z;
@@ -39,9 +57,20 @@ void CameraClass::SetPosition(float x, float y, float z)
 
 void CameraClass::SetRotation(float x, float y, float z)
 {
+	// Keep the cached orientations and matrices if the camera has not turned.
+	if (x == m_rotationX && y == m_rotationY && z == m_rotationZ)
+	{
+		return;
+	}
+
+	m_dirty = true;
 	m_rotationX = x;
 	m_rotationY = y;
 	m_rotationZ = z;
+
+	// Turn the degrees into orientations once here, so the view matrices never need trigonometry.
+	XMStoreFloat4(&m_orientation, XMQuaternionRotationRollPitchYaw(x * 0.0174532925f, y * 0.0174532925f, z * 0.0174532925f));
+	XMStoreFloat4(&m_reflectionOrientation, XMQuaternionRotationRollPitchYaw(-x * 0.0174532925f, y * 0.0174532925f, z * 0.0174532925f));
 	return;
 }
 
@@ -58,12 +87,34 @@ XMFLOAT3 CameraClass::GetRotation()
 }
 
 
+XMFLOAT4 CameraClass::GetOrientation()
+{
+	return m_orientation;
+}
+
+
+void CameraClass::SetProjectionMatrix(const XMMATRIX& projectionMatrix)
+{
+	m_projectionMatrix = projectionMatrix;
+
+	// The view space frustum only changes with the projection, so build it once here.
+	BoundingFrustum::CreateFromMatrix(m_viewFrustum, m_projectionMatrix);
+
+	m_dirty = true;
+	return;
+}
+
+
 void CameraClass::Render()
 {
-	XMVECTOR up, position, lookAt;
-	float yaw, pitch, roll;
-	XMMATRIX rotationMatrix;
+	XMVECTOR up, position, lookAt, orientation;
+
 
+	// Keep the cached matrices and frustum if nothing has changed since they were built.
+	if (!m_dirty)
+	{
+		return;
+	}
 
 	// Setup the vector that points upwards.
 	up = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
@@ -74,29 +125,30 @@ void CameraClass::Render()
 	// Setup where the camera is looking by default.
 	lookAt = XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f);
 
-	// Set the yaw (Y axis), pitch (X axis), and roll (Z axis) rotations in radians.
-	pitch = m_rotationX * 0.0174532925f;
-	yaw   = m_rotationY * 0.0174532925f;
-	roll  = m_rotationZ * 0.0174532925f;
+	// Load the orientation worked out by SetRotation(), so no trigonometry is needed here.
+	orientation = XMLoadFloat4(&m_orientation);
 
-	// Create the rotation matrix from the yaw, pitch, and roll values.
-	rotationMatrix = XMMatrixRotationRollPitchYaw(pitch, yaw, roll); //Is the order correct, Xu 13/11/2015
-
-	// Transform the lookAt and up vector by the rotation matrix so the view is correctly rotated at the origin.
-	lookAt = XMVector3TransformCoord(lookAt, rotationMatrix);
+	// Rotate the lookAt and up vector by the orientation so the view is correctly rotated at the origin.
+	lookAt = XMVector3Rotate(lookAt, orientation);
 
 	//Set the up vector.
-	up = XMVector3TransformCoord(up, rotationMatrix);
+	up = XMVector3Rotate(up, orientation);
 
 	// Translate the rotated camera position to the location of the viewer.
 	lookAt = position + lookAt;
 
-	//Store the LookAt vector
-	XMStoreFloat3(m_LookAt, lookAt);
-
 	// Finally create the view matrix from the three updated vectors.
 	m_viewMatrix = XMMatrixLookAtLH(position, lookAt, up);
 
+	// Cache the matrices built from the view, so the shaders and picking need not build them.
+	m_viewProjectionMatrix = XMMatrixMultiply(m_viewMatrix, m_projectionMatrix);
+	m_inverseViewMatrix = XMMatrixInverse(nullptr, m_viewMatrix);
+
+	// Move the view space frustum out to where the camera is in the world.
+	m_viewFrustum.Transform(m_frustum, m_inverseViewMatrix);
+
+	m_dirty = false;
+
 	return;
 }
 
@@ -108,11 +160,36 @@ void CameraClass::GetViewMatrix(XMMATRIX& viewMatrix)
 }
 
 
+void CameraClass::GetProjectionMatrix(XMMATRIX& projectionMatrix)
+{
+	projectionMatrix = m_projectionMatrix;
+	return;
+}
+
+
+void CameraClass::GetViewProjectionMatrix(XMMATRIX& viewProjectionMatrix)
+{
+	viewProjectionMatrix = m_viewProjectionMatrix;
+	return;
+}
+
+
+void CameraClass::GetInverseViewMatrix(XMMATRIX& inverseViewMatrix)
+{
+	inverseViewMatrix = m_inverseViewMatrix;
+	return;
+}
+
+
+const BoundingFrustum& CameraClass::GetFrustum()
+{
+	return m_frustum;
+}
+
+
 void CameraClass::GenerateBaseViewMatrix()
 {
-	XMVECTOR up, position, lookAt;
-	float yaw, pitch, roll;
-	XMMATRIX rotationMatrix;
+	XMVECTOR up, position, lookAt, orientation;
 
 
 	// Setup the vector that points upwards.
@@ -124,18 +201,13 @@ void CameraClass::GenerateBaseViewMatrix()
 	// Setup where the camera is looking by default.
 	lookAt = XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f);
 
-	// Set the yaw (Y axis), pitch (X axis), and roll (Z axis) rotations in radians.
-	pitch = m_rotationX * 0.0174532925f;
-	yaw = m_rotationY * 0.0174532925f;
-	roll = m_rotationZ * 0.0174532925f;
-
-	// Create the rotation matrix from the yaw, pitch, and roll values.
-	rotationMatrix = XMMatrixRotationRollPitchYaw(pitch, yaw, roll); //Is the order correct, Xu 13/11/2015
+	// Load the orientation worked out by SetRotation(), so no trigonometry is needed here.
+	orientation = XMLoadFloat4(&m_orientation);
 
-	// Transform the lookAt and up vector by the rotation matrix so the view is correctly rotated at the origin.
-	lookAt = XMVector3TransformCoord(lookAt, rotationMatrix);
+	// Rotate the lookAt and up vector by the orientation so the view is correctly rotated at the origin.
+	lookAt = XMVector3Rotate(lookAt, orientation);
 
-	up = XMVector3TransformCoord(up, rotationMatrix);
+	up = XMVector3Rotate(up, orientation);
 
 	// Finally create the baseView matrix from the three updated vectors.
 	m_baseViewMatrix = XMMatrixLookAtLH(position, lookAt, up);
@@ -153,9 +225,7 @@ void CameraClass::GetBaseViewMatrix(XMMATRIX& viewMatrix)
 
 void CameraClass::RenderReflection(float height)
 {
-	XMVECTOR up, position, lookAt;
-	float yaw, pitch, roll;
-	XMMATRIX rotationMatrix;
+	XMVECTOR up, position, lookAt, orientation;
 
 	// Setup the vector that points upwards.
 	up = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
@@ -166,18 +236,13 @@ void CameraClass::RenderReflection(float height)
 	// Setup where the camera is looking by default.
 	lookAt = XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f);
 
-	// Set the yaw (Y axis), pitch (X axis), and roll (Z axis) rotations in radians.
-	pitch = -m_rotationX * 0.0174532925f;
-	yaw = m_rotationY * 0.0174532925f;
-	roll = m_rotationZ * 0.0174532925f;
+	// Load the orientation with the pitch flipped, worked out by SetRotation().
+	orientation = XMLoadFloat4(&m_reflectionOrientation);
 
-	// Create the rotation matrix from the yaw, pitch, and roll values.
-	rotationMatrix = XMMatrixRotationRollPitchYaw(pitch, yaw, roll); //Is the order correct, Xu 13/11/2015
+	// Rotate the lookAt and up vector by the orientation so the view is correctly rotated at the origin.
+	lookAt = XMVector3Rotate(lookAt, orientation);
 
-	// Transform the lookAt and up vector by the rotation matrix so the view is correctly rotated at the origin.
-	lookAt = XMVector3TransformCoord(lookAt, rotationMatrix);
-
-	up = XMVector3TransformCoord(up, rotationMatrix);
+	up = XMVector3Rotate(up, orientation);
 
 	// Translate the rotated camera position to the location of the viewer.
 	lookAt = position + lookAt;
@@ -197,13 +262,9 @@ void CameraClass::GetReflectionViewMatrix(XMMATRIX& viewMatrix)
 
 XMFLOAT3 * CameraClass::GetLookAt()
 {
-	//Create a XMVECTOR with the rotation values in degrees.
-	XMVECTOR oldRotation;
-	oldRotation = XMVectorSet(-m_rotationX * 0.0174532925f, m_rotationY * 0.0174532925f, m_rotationZ * 0.0174532925f, 1.0f);
-
-	//Create an XMVECTOR for rotation as a quaternion using the oldRotation vector.
+	//Load the orientation with the pitch flipped, as a quaternion worked out by SetRotation().
 	XMVECTOR rotation;
-	rotation = XMQuaternionRotationRollPitchYawFromVector(oldRotation);
+	rotation = XMLoadFloat4(&m_reflectionOrientation);
 
 	//Set the initial forwards vector.
 	XMVECTOR forwards;
@@ -212,10 +273,9 @@ XMFLOAT3 * CameraClass::GetLookAt()
 	//Use the quaternion to rotate the forwards vector.
 	forwards = XMVector3Rotate(forwards, rotation);
 
-	//Initialize and store the look at float3
-	m_LookAt = new XMFLOAT3(0.0f, 0.0f, 0.0f);
-	XMStoreFloat3(m_LookAt, forwards);
+	//Store the look at float3 in the camera rather than allocating one each call.
+	XMStoreFloat3(&m_lookDirection, forwards);
 
 	//Return the address to the calculated look at vector.
-	return m_LookAt;
+	return &m_lookDirection;
 }
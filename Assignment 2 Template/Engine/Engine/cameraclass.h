@@ -9,6 +9,7 @@
 // INCLUDES //
 //////////////
 #include <DirectXMath.h> 
+#include <DirectXCollision.h>
 using namespace DirectX;
 ////////////////////////////////////////////////////////////////////////////////
 // Class name: CameraClass
@@ -25,9 +26,16 @@ public:
 
 	XMFLOAT3 GetPosition();
 	XMFLOAT3 GetRotation();
+	XMFLOAT4 GetOrientation();
+
+	void SetProjectionMatrix(const XMMATRIX&);
 
 	void Render();
 	void GetViewMatrix(XMMATRIX&);
+	void GetProjectionMatrix(XMMATRIX&);
+	void GetViewProjectionMatrix(XMMATRIX&);
+	void GetInverseViewMatrix(XMMATRIX&);
+	const BoundingFrustum& GetFrustum();
 
 	void GenerateBaseViewMatrix();
 	void GetBaseViewMatrix(XMMATRIX&);
@@ -40,9 +48,13 @@ public:
 private:
 	float m_positionX, m_positionY, m_positionZ;
 	float m_rotationX, m_rotationY, m_rotationZ;
+	XMFLOAT4 m_orientation, m_reflectionOrientation;
 	XMMATRIX m_viewMatrix, m_baseViewMatrix, m_reflectionViewMatrix;
+	XMMATRIX m_projectionMatrix, m_viewProjectionMatrix, m_inverseViewMatrix;
+	BoundingFrustum m_viewFrustum, m_frustum;
+	bool m_dirty;
 
-	XMFLOAT3* m_LookAt;
+	XMFLOAT3 m_lookDirection;
 };
 
 #endif
\ No newline at end of file
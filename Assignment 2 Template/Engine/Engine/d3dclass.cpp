@@ -17,6 +17,15 @@ D3DClass::D3DClass()
 
 	m_alphaEnableBlendingState = 0;
 	m_alphaDisableBlendingState = 0;
+
+	m_GpuTimerDevice = 0;
+	m_GpuProfiler = 0;
+
+	m_FrameArena = 0;
+
+	m_RenderContext = 0;
+	m_RenderRecorder = 0;
+	m_renderCaptureFile = 0;
 }
 
 
@@ -378,10 +387,95 @@ bool D3DClass::Initialize(int screenWidth, int screenHeight, bool vsync, HWND hw
 	// Create the viewport.
 	m_deviceContext->RSSetViewports(1, &viewport);
 
+#if ENGINE_PROFILER_ENABLED
+	// Create the GPU pass timer, reading its queries back a few frames late so it never stalls.
+	m_GpuTimerDevice = new D3DGpuTimerDevice(m_device, m_deviceContext);
+	if(!m_GpuTimerDevice)
+	{
+		return false;
+	}
+
+	m_GpuProfiler = new GpuProfilerClass;
+	if(!m_GpuProfiler)
+	{
+		return false;
+	}
+
+	if(!m_GpuProfiler->Initialize(m_GpuTimerDevice, GPU_PROFILER_MAX_ZONES))
+	{
+		return false;
+	}
+#endif
+
+	// Create the render context every frame is submitted through, counting each call on its way to the device context.
+	m_RenderContext = new D3DRenderContext(m_deviceContext);
+	if(!m_RenderContext)
+	{
+		return false;
+	}
+
+	m_RenderRecorder = new RecordingRenderContext(m_RenderContext);
+	if(!m_RenderRecorder)
+	{
+		return false;
+	}
+
+	// Create the arena the render thread's per-frame data is taken from.
+	if(!InitializeFrameArena())
+	{
+		return false;
+	}
+
     return true;
 }
 
 
+bool D3DClass::InitializeHeadless(int screenWidth, int screenHeight, float screenDepth, float screenNear)
+{
+	float fieldOfView, screenAspect;
+
+
+	// Store the screen size without creating a window, device or swap chain.
+	m_screenWidth = (float)screenWidth;
+	m_screenHeight = (float)screenHeight;
+	m_vsync_enabled = false;
+
+	// Create the same projection, world and ortho matrices as Initialize so picking and culling match.
+	fieldOfView = (float)XM_PI / 4.0f;
+	screenAspect = (float)screenWidth / (float)screenHeight;
+	m_projectionMatrix = XMMatrixPerspectiveFovLH(fieldOfView, screenAspect, screenNear, screenDepth);
+	m_worldMatrix = XMMatrixIdentity();
+	m_orthoMatrix = XMMatrixOrthographicLH((float)screenWidth, (float)screenHeight, screenNear, screenDepth);
+
+	// Record frames without passing them on, so the render path can run with no GPU behind it.
+	m_RenderRecorder = new RecordingRenderContext(0);
+	if(!m_RenderRecorder)
+	{
+		return false;
+	}
+
+	// Create the arena the render thread's per-frame data is taken from.
+	if(!InitializeFrameArena())
+	{
+		return false;
+	}
+
+	return true;
+}
+
+
+bool D3DClass::InitializeFrameArena()
+{
+	m_FrameArena = new FrameArenaClass;
+	if(!m_FrameArena)
+	{
+		return false;
+	}
+
+	return m_FrameArena->Initialize(FRAME_ARENA_SIZE);
+}
+
+
 void D3DClass::Shutdown()
 {
 	// Before shutting down set to windowed mode or when you release the swap chain it will throw an exception.
@@ -390,6 +484,41 @@ void D3DClass::Shutdown()
 		m_swapChain->SetFullscreenState(false, NULL);
 	}
 
+	// Release the per-frame arena, unbinding it from this thread.
+	if(m_FrameArena)
+	{
+		m_FrameArena->Shutdown();
+		delete m_FrameArena;
+		m_FrameArena = 0;
+	}
+
+	// Release the render contexts before the device context they pass calls on to.
+	if(m_RenderRecorder)
+	{
+		delete m_RenderRecorder;
+		m_RenderRecorder = 0;
+	}
+
+	if(m_RenderContext)
+	{
+		delete m_RenderContext;
+		m_RenderContext = 0;
+	}
+
+	// Release the GPU pass timer before the device it was created on.
+	if(m_GpuProfiler)
+	{
+		m_GpuProfiler->Shutdown();
+		delete m_GpuProfiler;
+		m_GpuProfiler = 0;
+	}
+
+	if(m_GpuTimerDevice)
+	{
+		delete m_GpuTimerDevice;
+		m_GpuTimerDevice = 0;
+	}
+
 	if(m_rasterState)
 	{
 		m_rasterState->Release();
@@ -453,11 +582,28 @@ void D3DClass::BeginScene(float red, float green, float blue, float alpha)
 	color[2] = blue;
 	color[3] = alpha;
 
+	// Reclaim last frame's transient data and bind the arena to the rendering thread.
+	m_FrameArena->Reset();
+	FrameArenaClass::SetCurrent(m_FrameArena);
+
+	// Start recording the frame, logging every command if a capture was asked for.
+	if(m_renderCaptureFile)
+	{
+		m_RenderRecorder->SetCapturing(true);
+	}
+	m_RenderRecorder->BeginFrame();
+
 	// Clear the back buffer.
-	m_deviceContext->ClearRenderTargetView(m_renderTargetView, color);
+	m_RenderRecorder->ClearRenderTargetView(m_renderTargetView, color);
     
 	// Clear the depth buffer.
-	m_deviceContext->ClearDepthStencilView(m_depthStencilView, D3D11_CLEAR_DEPTH, 1.0f, 0);
+	m_RenderRecorder->ClearDepthStencilView(m_depthStencilView, D3D11_CLEAR_DEPTH, 1.0f, 0);
+
+	// Start timing the frame on the GPU.
+	if(m_GpuProfiler)
+	{
+		m_GpuProfiler->BeginFrame();
+	}
 
 	return;
 }
@@ -465,6 +611,28 @@ void D3DClass::BeginScene(float red, float green, float blue, float alpha)
 
 void D3DClass::EndScene()
 {
+	// Stop timing the frame and read back any frame the GPU has finished.
+	if(m_GpuProfiler)
+	{
+		m_GpuProfiler->EndFrame();
+	}
+
+	// Finish recording the frame and write the log if it was being captured.
+	m_RenderRecorder->EndFrame();
+	if(m_renderCaptureFile)
+	{
+		OutputDebugStringA(m_RenderRecorder->GetSummary().c_str());
+		m_RenderRecorder->WriteLog(m_renderCaptureFile);
+		m_RenderRecorder->SetCapturing(false);
+		m_renderCaptureFile = 0;
+	}
+
+	// There is nothing to present to when running headless.
+	if(!m_swapChain)
+	{
+		return;
+	}
+
 	// Present the back buffer to the screen since rendering is complete.
 	if(m_vsync_enabled)
 	{
@@ -481,6 +649,18 @@ void D3DClass::EndScene()
 }
 
 
+GpuProfilerClass* D3DClass::GetGpuProfiler()
+{
+	return m_GpuProfiler;
+}
+
+
+FrameArenaClass* D3DClass::GetFrameArena()
+{
+	return m_FrameArena;
+}
+
+
 ID3D11Device* D3DClass::GetDevice()
 {
 	return m_device;
@@ -493,6 +673,27 @@ ID3D11DeviceContext* D3DClass::GetDeviceContext()
 }
 
 
+RenderContext* D3DClass::GetRenderContext()
+{
+	return m_RenderRecorder;
+}
+
+
+RecordingRenderContext* D3DClass::GetRenderRecorder()
+{
+	return m_RenderRecorder;
+}
+
+
+void D3DClass::CaptureRenderFrame(const char* filename)
+{
+	// Log every command of the next frame and write them to the file when it ends.
+	m_renderCaptureFile = filename;
+
+	return;
+}
+
+
 void D3DClass::GetProjectionMatrix(XMMATRIX& projectionMatrix)
 {
 	projectionMatrix = m_projectionMatrix;
@@ -534,7 +735,7 @@ void D3DClass::TurnOnAlphaBlending()
 	blendFactor[3] = 0.0f;
 
 	// Turn on the alpha blending.
-	m_deviceContext->OMSetBlendState(m_alphaEnableBlendingState, blendFactor, 0xffffffff);
+	m_RenderRecorder->OMSetBlendState(m_alphaEnableBlendingState, blendFactor, 0xffffffff);
 
 	return;
 }
@@ -552,17 +753,17 @@ void D3DClass::TurnOffAlphaBlending()
 	blendFactor[3] = 0.0f;
 
 	// Turn off the alpha blending.
-	m_deviceContext->OMSetBlendState(m_alphaDisableBlendingState, blendFactor, 0xffffffff);
+	m_RenderRecorder->OMSetBlendState(m_alphaDisableBlendingState, blendFactor, 0xffffffff);
 
 	return;
 }
 
 void D3DClass::TurnOnWireframe()
 {
-	m_deviceContext->RSSetState(m_wireframeState);
+	m_RenderRecorder->RSSetState(m_wireframeState);
 }
 
 void D3DClass::TurnOffWireframe()
 {
-	m_deviceContext->RSSetState(m_rasterState);
+	m_RenderRecorder->RSSetState(m_rasterState);
 }
\ No newline at end of file
@@ -21,10 +21,23 @@
 #include <d3d11_1.h>
 #include <DirectXMath.h>
 #include "TextClassA.h"
+#include "GpuProfilerClass.h"
+#include "D3DGpuTimerDevice.h"
+#include "RenderContext.h"
+#include "FrameArenaClass.h"
 
 using namespace DirectX;
 
 
+/////////////
+// GLOBALS //
+/////////////
+const int GPU_PROFILER_MAX_ZONES = 16;
+
+// The starting size of the per-frame arena, it grows if a frame needs more.
+const size_t FRAME_ARENA_SIZE = 1024 * 1024;
+
+
 ////////////////////////////////////////////////////////////////////////////////
 // Class name: D3DClass
 ////////////////////////////////////////////////////////////////////////////////
@@ -36,6 +49,7 @@ public:
 	~D3DClass();
 
 	bool Initialize(int, int, bool, HWND, bool, float, float);
+	bool InitializeHeadless(int, int, float, float);
 	void Shutdown();
 	
 	void BeginScene(float, float, float, float);
@@ -43,6 +57,9 @@ public:
 
 	ID3D11Device* GetDevice();
 	ID3D11DeviceContext* GetDeviceContext();
+	RenderContext* GetRenderContext();
+	RecordingRenderContext* GetRenderRecorder();
+	void CaptureRenderFrame(const char*);
 
 	void GetProjectionMatrix(XMMATRIX&);
 	void GetWorldMatrix(XMMATRIX&);
@@ -50,6 +67,9 @@ public:
 
 	void GetVideoCardInfo(char*, int&);
 
+	GpuProfilerClass* GetGpuProfiler();
+	FrameArenaClass* GetFrameArena();
+
 
 	void TurnOnAlphaBlending();
 	void TurnOffAlphaBlending();
@@ -63,6 +83,9 @@ public:
 	
 
 
+private:
+	bool InitializeFrameArena();
+
 private:
 	bool m_vsync_enabled;
 	int m_videoCardMemory;
@@ -85,6 +108,15 @@ private:
 	ID3D11BlendState* m_alphaEnableBlendingState;
 	ID3D11BlendState* m_alphaDisableBlendingState;
 
+	D3DGpuTimerDevice* m_GpuTimerDevice;
+	GpuProfilerClass* m_GpuProfiler;
+
+	FrameArenaClass* m_FrameArena;
+
+	D3DRenderContext* m_RenderContext;
+	RecordingRenderContext* m_RenderRecorder;
+	const char* m_renderCaptureFile;
+
 	
 };
 
@@ -14,7 +14,7 @@ Method:		FireModelClass
 Summary:	The default constructor for a FireModelClass object.
 
 Modifies:	[m_vertexBuffer, m_indexBuffer, m_Texture1, m_Texture2, m_Texture3, m_model,
-			 m_AABB, m_min, m_max].
+			 m_AABB, m_BVH, m_min, m_max, m_ready].
 
 Returns:	FireModelClass
 				The constructed FireModelClass object.
@@ -29,8 +29,11 @@ FireModelClass::FireModelClass()
 	m_model = 0;
 
 	m_AABB = 0;
+	m_BVH = 0;
 	m_min = 0;
 	m_max = 0;
+
+	m_ready = false;
 }
 
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -95,18 +98,13 @@ bool FireModelClass::Initialize(ID3D11Device* device, char* modelFilename, WCHAR
 	bool result;
 
 
-	// Load in the model data,
-	result = LoadModel(modelFilename);
+	// Load in the model data, its bounding box and its triangle hierarchy.
+	result = LoadMeshData(modelFilename);
 	if(!result)
 	{
 		return false;
 	}
 
-	//Setup the bounding box
-	result = SetupBoundingBox();
-	if (!result)
-		return false;
-
 	// Initialize the vertex and index buffers.
 	result = InitializeBuffers(device);
 	if(!result)
@@ -121,9 +119,115 @@ bool FireModelClass::Initialize(ID3D11Device* device, char* modelFilename, WCHAR
 		return false;
 	}
 
+	m_ready = true;
+
+	return true;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Initialize
+
+Summary:	================= CALL AFTER CREATION =================
+			Loads only the vertex data, bounding box and triangle hierarchy
+			of a model, without creating buffers or textures, so it can be
+			used with no device such as by the headless benchmark.
+			The model counts as ready but must never be rendered.
+
+Args:		char* modelFilename
+				a filepath to the .txt file containing the vertex data
+				for this model.
+
+Modifies:	[m_ready].
+
+Returns:	bool
+				was the model data loaded successfully.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool FireModelClass::Initialize(char* modelFilename)
+{
+	// Load in the model data, its bounding box and its triangle hierarchy.
+	if (!LoadMeshData(modelFilename))
+		return false;
+
+	m_ready = true;
+
 	return true;
 }
 
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		InitializeAsync
+
+Summary:	================= CALL AFTER CREATION =================
+			Queues this FireModelClass object to be streamed in by the asset
+			loader. Parsing the model, building its triangle hierarchy and
+			reading the three texture files happen on a worker thread; only the buffer and texture creation happen on
+			the device thread.
+
+Args:		AssetLoaderClass* loader
+				the asset loader to queue the model on.
+			char* modelFilename
+				a filepath to the .txt file containing the vertex data
+				for this model.
+			WCHAR* textureFilename1
+				a filepath to the ARGB8 .dds file used for the texture
+				of this model.
+			WCHAR* textureFilename2
+				a filepath to the ARGB8 .dds file used for the second
+				texture of this model.
+			WCHAR* textureFilename3
+				a filepath for the ARGB8 .dds file used for the third
+				texture of this model.
+			TextureStreamerClass* streamer
+				a texture streamer to hand the textures to, or 0 to create
+				them at full resolution.
+
+Modifies:	[m_Texture1, m_Texture2, m_Texture3, m_ready].
+
+Returns:	AssetLoaderClass::AssetHandle
+				a handle which becomes true once the model is ready to draw.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+AssetLoaderClass::AssetHandle FireModelClass::InitializeAsync(AssetLoaderClass* loader, char* modelFilename, WCHAR* textureFilename1,
+	WCHAR* textureFilename2, WCHAR* textureFilename3, TextureStreamerClass* streamer)
+{
+	std::string modelPath(modelFilename);
+	std::wstring texturePath1(textureFilename1);
+	std::wstring texturePath2(textureFilename2);
+	std::wstring texturePath3(textureFilename3);
+
+	m_ready = false;
+
+	// Create the texture objects up front so the worker only has to fill them.
+	m_Texture1 = new TextureClass;
+	m_Texture2 = new TextureClass;
+	m_Texture3 = new TextureClass;
+
+	return loader->Request(modelFilename,
+		[this, modelPath, texturePath1, texturePath2, texturePath3]()
+		{
+			// Load in the model data, its bounding box and its triangle hierarchy.
+			if (!LoadMeshData((char*)modelPath.c_str()))
+				return false;
+
+			// Read the texture files ready for creation on the device thread.
+			return m_Texture1->LoadFileData((WCHAR*)texturePath1.c_str()) &&
+				m_Texture2->LoadFileData((WCHAR*)texturePath2.c_str()) &&
+				m_Texture3->LoadFileData((WCHAR*)texturePath3.c_str());
+		},
+		[this, streamer](ID3D11Device* device)
+		{
+			// Create the vertex and index buffers.
+			if (!InitializeBuffers(device))
+				return false;
+
+			// Create the textures, or hand them to the streamer.
+			if (streamer ? !m_Texture1->Initialize(streamer) || !m_Texture2->Initialize(streamer) || !m_Texture3->Initialize(streamer)
+				: !m_Texture1->Initialize(device) || !m_Texture2->Initialize(device) || !m_Texture3->Initialize(device))
+				return false;
+
+			m_ready = true;
+			return true;
+		});
+}
+
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
 Method:		Shutdown()
 
@@ -147,6 +251,11 @@ void FireModelClass::Shutdown()
 	//Release the boundingBox collision data.
 	ReleaseBoundingBox();
 
+	//Release the triangle hierarchy.
+	ReleaseBVH();
+
+	m_ready = false;
+
 	return;
 }
 
@@ -156,12 +265,12 @@ Method:		Render
 Summary:	Puts the stored vertex and index buffers on the graphics
 			pipeline to draw them
 
-Args:		ID3D11DeviceContext* deviceContext
+Args:		RenderContext* deviceContext
 				the device context that the model should be rendered to,
 
 Modifies:	[none].
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-void FireModelClass::Render(ID3D11DeviceContext* deviceContext)
+void FireModelClass::Render(RenderContext* deviceContext)
 {
 	// Put the vertex and index buffers on the graphics pipeline to prepare them for drawing.
 	RenderBuffers(deviceContext);
@@ -197,6 +306,57 @@ BoundingBox* FireModelClass::GetAABB()
 	return this->m_AABB;
 }
 
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetBVH
+
+Summary:	Returns the hierarchy over the triangles of this model.
+
+Returns:	MeshBVHClass*
+				A pointer to the triangle hierarchy of this model, in model
+				space, or 0 if it has not been loaded.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+MeshBVHClass* FireModelClass::GetBVH()
+{
+	return m_BVH;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		IsReady
+
+Summary:	Returns whether the buffers and textures of this model have
+			been created and it can be drawn.
+
+Returns:	bool
+				true once the model is ready to draw.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool FireModelClass::IsReady()
+{
+	return m_ready;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RequestTextureSize
+
+Summary:	Tells the three textures of this model how large the model is
+			on screen, so streamed textures can fetch the mips they need.
+
+Args:		float screenPixels
+				the size of the model on screen, in pixels.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void FireModelClass::RequestTextureSize(float screenPixels)
+{
+	if (m_Texture1)
+		m_Texture1->RequestSize(screenPixels);
+
+	if (m_Texture2)
+		m_Texture2->RequestSize(screenPixels);
+
+	if (m_Texture3)
+		m_Texture3->RequestSize(screenPixels);
+}
+
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
 Method:		InitializeBuffers
 
@@ -328,12 +488,12 @@ Method:		RenderBuffers
 Summary:	Used to activate the index and vertex buffers so that they
 			will be rendered by the deviceContext.
 
-Args:		ID3D11DeviceContext* deviceContext
+Args:		RenderContext* deviceContext
 				The device context to prepare the buffers for rendering on.
 
 Modifies:	[none].
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-void FireModelClass::RenderBuffers(ID3D11DeviceContext* deviceContext)
+void FireModelClass::RenderBuffers(RenderContext* deviceContext)
 {
 	unsigned int stride;
 	unsigned int offset;
@@ -510,6 +670,28 @@ ID3D11ShaderResourceView* FireModelClass::GetTexture3()
 	return m_Texture3->GetTexture();
 }
 
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		LoadMeshData
+
+Summary:	Loads the Model data from a .txt file along with everything
+				built from it: the bounding box and triangle hierarchy.
+			Shared by every Initialize, so a streamed model builds them on
+				the loader's worker thread.
+
+Args:		char* filename
+				a filepath to the .txt file containing the model's
+				vertex data.
+
+Modifies:	[m_vertexCount, m_indexCount, m_model, m_min, m_max, m_AABB, m_BVH].
+
+Returns:	bool
+				was the model data loaded and everything built from it.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool FireModelClass::LoadMeshData(char* filename)
+{
+	return LoadModel(filename) && SetupBoundingBox() && SetupBVH();
+}
+
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
 Method:		LoadModel
 
@@ -683,4 +865,41 @@ void FireModelClass::ReleaseBoundingBox()
 		delete m_AABB;
 		m_AABB = 0;
 	}
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		SetupBVH
+
+Summary:	Builds a hierarchy over the triangles of the loaded model data,
+				so a ray can find exactly which triangle it hits.
+
+Modifies:	[m_BVH].
+
+Returns:	bool
+				was the creation of the hierarchy successful.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool FireModelClass::SetupBVH()
+{
+	//Create a new hierarchy.
+	m_BVH = new MeshBVHClass;
+
+	//Build it over the positions of every vertex, three to a triangle.
+	return m_BVH->Initialize(&m_model[0].x, sizeof(ModelType), m_vertexCount);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		ReleaseBVH
+
+Summary:	Shuts down, deletes and de-points the triangle hierarchy.
+
+Modifies:	[m_BVH].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void FireModelClass::ReleaseBVH()
+{
+	if (m_BVH)
+	{
+		m_BVH->Shutdown();
+		delete m_BVH;
+		m_BVH = 0;
+	}
 }
\ No newline at end of file
@@ -24,6 +24,9 @@
 //			User Defined Headers
 //===========================================
 #include "textureclass.h"
+#include "AssetLoaderClass.h"
+#include "RenderContext.h"
+#include "MeshBVHClass.h"
 
 
 //===========================================
@@ -57,9 +60,18 @@ Methods:	==================== PUBLIC ====================
 
 			bool Initialize(ID3D11Device*, char*, WCHAR*, WCHAR*, WCHAR*)
 				Call after creation to set up the FireModelObject for use.
+			bool Initialize(char*)
+				Call after creation to load only the vertex data, bounds and
+				triangle hierarchy, with no buffers or textures, for running
+				without a device. Must never be rendered.
+			AssetLoaderClass::AssetHandle InitializeAsync(AssetLoaderClass*, char*, WCHAR*, WCHAR*, WCHAR*, TextureStreamerClass*)
+				Call after creation to stream the FireModelObject in on the loader's
+				worker threads instead. Not drawable until IsReady(). If a
+				TextureStreamerClass is given the three textures' mips are
+				streamed by it.
 			void Shutdown()
 				Call before deletion to free memory used by this FireModelClass object.
-			void Render(ID3D11DeviceContext*)
+			void Render(RenderContext*)
 				Call during the rendering loop to render this FireModelClass object to
 				the specified device context.
 
@@ -75,13 +87,22 @@ Methods:	==================== PUBLIC ====================
 
 			BoundingBox* GetAABB
 				A utility function to return the bounding box used by this base model.
+			MeshBVHClass* GetBVH
+				A utility function to return the triangle hierarchy of this model,
+				for picking.
+			bool IsReady
+				A utility function to return whether the buffers and textures of this
+				model have been created.
+			void RequestTextureSize(float)
+				Use while rendering to tell streamed textures how large the model
+				is on screen, in pixels.
 
 			==================== PRIVATE ====================
 			bool InitializeBuffers(ID3D11Device*)
 				Called by Initialize() to initialize the index and vertex buffer in memory.
 			void ShutdownBuffers()
 				Called by Shutdown() to clear the vertex and index buffers from memory.
-			void RenderBuffers(ID3D11DeviceContext)
+			void RenderBuffers(RenderContext)
 				Called by Render to activate the vertex and index buffer for rendering.
 
 			bool LoadTextures(ID3D11Device*, WCHAR*, WCHAR*, WCHAR*)
@@ -90,18 +111,27 @@ Methods:	==================== PUBLIC ====================
 			void ReleaseTextures()
 				Called by shutdown to release the texture objects from memory.
 
+			bool LoadMeshData(char*)
+				Called by both Initializes and InitializeAsync to load the model file and
+				build its bounding box and triangle hierarchy.
 			bool LoadModel(char*)
-				Called by initialize to load the model file specified into an array of
+				Called by LoadMeshData to load the model file specified into an array of
 				ModelType structs.
 			void ReleaseModel()
 				Called by shutdown to release the modelType array from memory.
 
 			bool SetupBoundingBox()
-				Called by initialize to create the bounding box using the precalculated 
+				Called by LoadMeshData to create the bounding box using the precalculated 
 				min and max points.
 			void ReleaseBoundingBox()
 				Called by shutdown to release the boundingbox from memory.
 
+			bool SetupBVH()
+				Called by LoadMeshData to build a triangle hierarchy for picking from
+				the loaded model data.
+			void ReleaseBVH()
+				Called by shutdown to release the triangle hierarchy from memory.
+
 Members:	==================== PRIVATE ====================
 			ID3D11Buffer *m_vertexBuffer
 				a Buffer object to store the vertices of the model in memory.
@@ -119,6 +149,15 @@ Members:	==================== PRIVATE ====================
 
 			ModelType* m_model.
 				an array of ModelType structs to hold the data of the model.
+
+			BoundingBox* m_AABB
+				a BoundingBox object representing the collision data of this model.
+			MeshBVHClass* m_BVH
+				a hierarchy over the triangles of this model, in model space, for
+				finding exactly where a ray hits it.
+
+			bool m_ready
+				whether the buffers and textures of this model have been created.
 C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
 class FireModelClass
 {
@@ -142,8 +181,10 @@ public:
 	~FireModelClass();
 
 	bool Initialize(ID3D11Device*, char*, WCHAR*, WCHAR*, WCHAR*);
+	bool Initialize(char*);
+	AssetLoaderClass::AssetHandle InitializeAsync(AssetLoaderClass*, char*, WCHAR*, WCHAR*, WCHAR*, TextureStreamerClass* = 0);
 	void Shutdown();
-	void Render(ID3D11DeviceContext*);
+	void Render(RenderContext*);
 
 	int GetIndexCount();
 
@@ -152,21 +193,28 @@ public:
 	ID3D11ShaderResourceView* GetTexture3();
 
 	BoundingBox* GetAABB();
+	MeshBVHClass* GetBVH();
+	bool IsReady();
+	void RequestTextureSize(float);
 
 private:
 	bool InitializeBuffers(ID3D11Device*);
 	void ShutdownBuffers();
-	void RenderBuffers(ID3D11DeviceContext*);
+	void RenderBuffers(RenderContext*);
 
 	bool LoadTextures(ID3D11Device*, WCHAR*, WCHAR*, WCHAR*);
 	void ReleaseTextures();
 
+	bool LoadMeshData(char*);
 	bool LoadModel(char*);
 	void ReleaseModel();
 
 	bool SetupBoundingBox();
 	void ReleaseBoundingBox();
 
+	bool SetupBVH();
+	void ReleaseBVH();
+
 private:
 	ID3D11Buffer *m_vertexBuffer, *m_indexBuffer;
 	int m_vertexCount, m_indexCount;
@@ -175,6 +223,10 @@ private:
 
 	BoundingBox* m_AABB;
 
+	MeshBVHClass* m_BVH;
+
+	bool m_ready;
+
 public:
 	XMFLOAT3* m_min;
 	XMFLOAT3* m_max;
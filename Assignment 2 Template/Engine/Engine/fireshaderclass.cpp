@@ -52,8 +52,8 @@ void FireShaderClass::Shutdown()
 }
 
 
-bool FireShaderClass::Render(ID3D11DeviceContext* deviceContext, int indexCount, const XMMATRIX& worldMatrix, const XMMATRIX& viewMatrix,
-	const XMMATRIX& projectionMatrix, ID3D11ShaderResourceView* fireTexture,
+bool FireShaderClass::Render(RenderContext* deviceContext, int indexCount, const XMMATRIX& worldMatrix, const XMMATRIX& viewProjectionMatrix,
+	ID3D11ShaderResourceView* fireTexture,
 							 ID3D11ShaderResourceView* noiseTexture, ID3D11ShaderResourceView* alphaTexture, float frameTime,
 	XMFLOAT3 scrollSpeeds, XMFLOAT3 scales, XMFLOAT2 distortion1, XMFLOAT2 distortion2,
 	XMFLOAT2 distortion3, float distortionScale, float distortionBias)
@@ -62,7 +62,7 @@ bool FireShaderClass::Render(ID3D11DeviceContext* deviceContext, int indexCount,
 
 
 	// Set the shader parameters that it will use for rendering.
-	result = SetShaderParameters(deviceContext, worldMatrix, viewMatrix, projectionMatrix, fireTexture, noiseTexture, alphaTexture, 
+	result = SetShaderParameters(deviceContext, worldMatrix, viewProjectionMatrix, fireTexture, noiseTexture, alphaTexture, 
 								 frameTime, scrollSpeeds, scales, distortion1, distortion2, distortion3, distortionScale, 
 								 distortionBias);
 	if(!result)
@@ -378,8 +378,8 @@ void FireShaderClass::OutputShaderErrorMessage(ID3D10Blob* errorMessage, HWND hw
 }
 
 
-bool FireShaderClass::SetShaderParameters(ID3D11DeviceContext* deviceContext, const XMMATRIX& worldMatrix, const XMMATRIX& viewMatrix,
-	const XMMATRIX& projectionMatrix, ID3D11ShaderResourceView* fireTexture,
+bool FireShaderClass::SetShaderParameters(RenderContext* deviceContext, const XMMATRIX& worldMatrix, const XMMATRIX& viewProjectionMatrix,
+	ID3D11ShaderResourceView* fireTexture,
 										  ID3D11ShaderResourceView* noiseTexture, ID3D11ShaderResourceView* alphaTexture, 
 										  float frameTime, XMFLOAT3 scrollSpeeds, XMFLOAT3 scales, XMFLOAT2 distortion1,
 	XMFLOAT2 distortion2, XMFLOAT2 distortion3, float distortionScale,
@@ -406,8 +406,7 @@ bool FireShaderClass::SetShaderParameters(ID3D11DeviceContext* deviceContext, co
 
 	// Copy the matrices into the constant buffer.
 	dataPtr->world = XMMatrixTranspose(worldMatrix);
-	dataPtr->view = XMMatrixTranspose(viewMatrix);
-	dataPtr->projection = XMMatrixTranspose(projectionMatrix);
+	dataPtr->viewProjection = XMMatrixTranspose(viewProjectionMatrix);
 
 	// Unlock the constant buffer.
 	deviceContext->Unmap(m_matrixBuffer, 0);
@@ -478,7 +477,7 @@ bool FireShaderClass::SetShaderParameters(ID3D11DeviceContext* deviceContext, co
 }
 
 
-void FireShaderClass::RenderShader(ID3D11DeviceContext* deviceContext, int indexCount)
+void FireShaderClass::RenderShader(RenderContext* deviceContext, int indexCount)
 {
 	// Set the vertex input layout.
 	deviceContext->IASetInputLayout(m_layout);
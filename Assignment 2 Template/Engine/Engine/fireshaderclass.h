@@ -17,6 +17,12 @@ using namespace DirectX;
 using namespace std;
 
 
+///////////////////////
+// MY CLASS INCLUDES //
+///////////////////////
+#include "RenderContext.h"
+
+
 ////////////////////////////////////////////////////////////////////////////////
 // Class name: FireShaderClass
 ////////////////////////////////////////////////////////////////////////////////
@@ -26,8 +32,7 @@ private:
 	struct MatrixBufferType
 	{
 		XMMATRIX  world;
-		XMMATRIX  view;
-		XMMATRIX  projection;
+		XMMATRIX  viewProjection;
 	};
 
 	struct NoiseBufferType
@@ -54,7 +59,7 @@ public:
 
 	bool Initialize(ID3D11Device*, HWND);
 	void Shutdown();
-	bool Render(ID3D11DeviceContext*, int, const XMMATRIX&, const XMMATRIX&, const XMMATRIX&, ID3D11ShaderResourceView*, ID3D11ShaderResourceView*,
+	bool Render(RenderContext*, int, const XMMATRIX&, const XMMATRIX&, ID3D11ShaderResourceView*, ID3D11ShaderResourceView*,
 				ID3D11ShaderResourceView*, float, XMFLOAT3, XMFLOAT3, XMFLOAT2, XMFLOAT2, XMFLOAT2, float, float);
 
 private:
@@ -62,12 +67,12 @@ private:
 	void ShutdownShader();
 	void OutputShaderErrorMessage(ID3D10Blob*, HWND, WCHAR*);
 
-	bool SetShaderParameters(ID3D11DeviceContext*, const XMMATRIX&, const XMMATRIX&, const XMMATRIX&, ID3D11ShaderResourceView*,
+	bool SetShaderParameters(RenderContext*, const XMMATRIX&, const XMMATRIX&, ID3D11ShaderResourceView*,
 							 ID3D11ShaderResourceView*, ID3D11ShaderResourceView*, float, XMFLOAT3, XMFLOAT3, XMFLOAT2,
 		XMFLOAT2, XMFLOAT2, float, float);
 
 
-	void RenderShader(ID3D11DeviceContext*, int);
+	void RenderShader(RenderContext*, int);
 
 private:
 	ID3D11VertexShader* m_vertexShader;
@@ -18,7 +18,9 @@ Summary:	Default constructor for a GraphicsClass object.
 Modifies:	[m_Input, m_D3D, m_Timer, m_ShaderManager, m_Light, m_Position,
 			 m_Camera, m_Text, m_Bitmap, m_CollisionObject,
 			 m_renderingList, m_GameObjectManager, bumpCube, metalNinja,
-			 m_BulletModel].
+			 m_BulletModel, m_AssetLoader, m_JobSystem, m_SimulationCounter,
+			 m_FrameSnapshot, m_SimulationArena, m_TextureStreamDevice, m_TextureStreamer,
+			 m_TextureAtlas].
 
 Returns:	GraphicsClass
 				the new GraphicsClass object.
@@ -43,6 +45,14 @@ GraphicsClass::GraphicsClass()
 
 	m_CollisionObject = 0;
 	m_GameObjectManager = new GameObjectManager();
+	m_AssetLoader = 0;
+	m_JobSystem = 0;
+	m_SimulationCounter = 0;
+	m_FrameSnapshot = 0;
+	m_SimulationArena = 0;
+	m_TextureStreamDevice = 0;
+	m_TextureStreamer = 0;
+	m_TextureAtlas = 0;
 	
 }
 
@@ -92,7 +102,9 @@ Args:		HINSTANCE hinstance
 Modifies:	[m_Input, m_D3D, m_ShaderManager, m_Timer, m_Position,
 			 m_Camera, m_Light, m_Text, m_Bitmap,
 			 m_CollisionObject, m_GameObjectManager, m_beginCheck,
-			 metalNinja, bumpCube, m_BulletModel, m_BeginSpawn].
+			 metalNinja, bumpCube, m_BulletModel, m_BeginSpawn, m_AssetLoader,
+			 m_JobSystem, m_SimulationCounter, m_FrameSnapshot, m_SimulationArena,
+			 m_TextureStreamDevice, m_TextureStreamer, m_TextureAtlas, m_frameNumber].
 
 Returns:	bool
 				was the initialization of all member variables successful.
@@ -100,7 +112,7 @@ M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 bool GraphicsClass::Initialize(HINSTANCE hinstance, HWND hwnd, int screenWidth, int screenHeight)
 {
 	bool result;
-	XMMATRIX baseViewMatrix;
+	XMMATRIX baseViewMatrix, projectionMatrix;
 
 	// Create the input object.  The input object will be used to handle reading the keyboard and mouse input from the user.
 	m_Input = new InputClass;
@@ -145,6 +157,10 @@ bool GraphicsClass::Initialize(HINSTANCE hinstance, HWND hwnd, int screenWidth,
 
 	// Create the camera object.
 	m_Camera = new CameraClass;
+
+	// Give the camera the projection, so it can cache the combined matrices and frustum it builds from it.
+	m_D3D->GetProjectionMatrix(projectionMatrix);
+	m_Camera->SetProjectionMatrix(projectionMatrix);
 	m_Camera->GetBaseViewMatrix(baseViewMatrix);
 
 	// Create the light object.
@@ -164,9 +180,20 @@ bool GraphicsClass::Initialize(HINSTANCE hinstance, HWND hwnd, int screenWidth,
 		return false;
 	}
 
+	// Create the texture atlas object and pack the small HUD and debug textures into it.
+	m_TextureAtlas = new TextureAtlasClass;
+	result = m_TextureAtlas->AddTexture("mouse", L"../Engine/data/mouse.dds") &&
+		m_TextureAtlas->AddTexture("blue", L"../Engine/data/blue.dds") &&
+		m_TextureAtlas->Build(m_D3D->GetDevice(), TEXTURE_ATLAS_MAX_SIZE, TEXTURE_ATLAS_PADDING);
+	if (!result)
+	{
+		MessageBox(hwnd, L"Could not initialize the texture atlas object.", L"Error", MB_OK);
+		return false;
+	}
+
 	// Create the bitmap object.
 	m_Bitmap = new BitmapClassA;
-	result = m_Bitmap->Initialize(m_D3D->GetDevice(), screenWidth, screenHeight, L"../Engine/data/mouse.dds", 32, 32);
+	result = m_Bitmap->Initialize(m_D3D->GetDevice(), screenWidth, screenHeight, m_TextureAtlas, "mouse", 32, 32);
 	if (!result)
 	{
 		MessageBox(hwnd, L"Could not initialize the bitmap object.", L"Error", MB_OK);
@@ -182,24 +209,61 @@ bool GraphicsClass::Initialize(HINSTANCE hinstance, HWND hwnd, int screenWidth,
 		return false;
 	}
 
-	//Initialize a blue cube
-	ModelClass* testCube = new ModelClass();
-	result = testCube->Initialize(m_D3D->GetDevice(), "../Engine/data/cube.txt", L"../Engine/data/blue.dds");
+	//Create the asset loader object.
+	m_AssetLoader = new AssetLoaderClass;
+	result = m_AssetLoader->Initialize(ASSET_LOADER_THREADS);
 	if (!result)
 	{
-		MessageBox(hwnd, L"Failed to initialize GameoOject", L"ERROR", MB_OK);
+		MessageBox(hwnd, L"Could not initialize the asset loader object.", L"Error", MB_OK);
 		return false;
 	}
 
-	//Initialize the BulletModel.
-	m_BulletModel = new ModelClass();
-	result = m_BulletModel->Initialize(m_D3D->GetDevice(), "../Engine/data/sphere.txt", L"../Engine/data/bullet.dds");
+	//Create the job system and spread the object updates across it.
+	m_JobSystem = new JobSystemClass;
+	result = m_JobSystem->Initialize(JOB_WORKER_THREADS);
+	if (!result)
+	{
+		MessageBox(hwnd, L"Could not initialize the job system object.", L"Error", MB_OK);
+		return false;
+	}
+	m_GameObjectManager->SetJobSystem(m_JobSystem);
+
+	//Create the counter the simulation of the next frame runs under, and the
+	//snapshot it hands over to the renderer.
+	m_SimulationCounter = new JobCounter;
+	m_FrameSnapshot = new FrameSnapshotClass;
+
+	//Create the arena the simulation's per-frame data is taken from.
+	m_SimulationArena = new FrameArenaClass;
+	result = m_SimulationArena->Initialize(FRAME_ARENA_SIZE);
+	if (!result)
+	{
+		MessageBox(hwnd, L"Could not initialize the simulation arena.", L"Error", MB_OK);
+		return false;
+	}
+
+	//Create the texture streamer object.
+	m_TextureStreamDevice = new D3DTextureStreamDevice(m_D3D->GetDevice());
+	m_TextureStreamer = new TextureStreamerClass;
+	result = m_TextureStreamer->Initialize(m_TextureStreamDevice, TEXTURE_STREAM_BUDGET,
+		TEXTURE_STREAM_TAIL_SIZE, TEXTURE_UPLOADS_PER_FRAME);
 	if (!result)
 	{
-		MessageBox(hwnd, L"Failed to initialize bullet model", L"ERROR", MB_OK);
+		MessageBox(hwnd, L"Could not initialize the texture streamer object.", L"Error", MB_OK);
 		return false;
 	}
 
+	//Queue a blue cube. Models below stream in on the asset loader and
+	//their gameObjects draw as placeholder bounds until they are ready.
+	ModelClass* testCube = new ModelClass();
+	testCube->InitializeAsync(m_AssetLoader, "../Engine/data/cube.txt", L"../Engine/data/blue.dds",
+		m_TextureStreamer);
+
+	//Queue the BulletModel.
+	m_BulletModel = new ModelClass();
+	m_BulletModel->InitializeAsync(m_AssetLoader, "../Engine/data/sphere.txt", L"../Engine/data/bullet.dds",
+		m_TextureStreamer);
+
 	//Create and add objects to the GameObject manager.
 	{
 		//Add 3 new Objects to the gameObjectManager.
@@ -212,61 +276,37 @@ bool GraphicsClass::Initialize(HINSTANCE hinstance, HWND hwnd, int screenWidth,
 
 		//Create and add a bumpmap cube to the gameobjectmanager.
 		BumpModelClass* testCubeBump = new BumpModelClass();
-		result = testCubeBump->Initialize(m_D3D->GetDevice(), "../Engine/data/cube.txt", L"../Engine/data/stone.dds",
-			L"../Engine/data/normal.dds");
-		if (!result)
-		{
-			MessageBox(hwnd, L"Failed to initialize BumpGameObject", L"ERROR", MB_OK);
-			return false;
-		}
+		testCubeBump->InitializeAsync(m_AssetLoader, "../Engine/data/cube.txt", L"../Engine/data/stone.dds",
+			L"../Engine/data/normal.dds", m_TextureStreamer);
 		m_GameObjectManager->AddItem(GameObjectManager::OBJECTTYPE_STATIC, new BumpMapGameObject(testCubeBump, m_Light),
 			new XMFLOAT3(0.0f, 0.0f, -5.0f), new XMFLOAT3(45.0f, 0.0f, 0.0f), new XMFLOAT3(1.0f, 1.0f, 1.0f));
 
 		//Create and add a fire animation ninja head to the gameObjectManager.
 		FireModelClass* testCubeFire = new FireModelClass();
-		result = testCubeFire->Initialize(m_D3D->GetDevice(), "../Engine/data/cube.txt", L"../Engine/data/fire01.dds", //square or cube
-			L"../Engine/data/noise01.dds", L"../Engine/data/alpha01.dds");
-		if (!result)
-		{
-			MessageBox(hwnd, L"Failed to initialize the firecube", L"ERROR", MB_OK);
-			return false;
-		}
+		testCubeFire->InitializeAsync(m_AssetLoader, "../Engine/data/cube.txt", L"../Engine/data/fire01.dds", //square or cube
+			L"../Engine/data/noise01.dds", L"../Engine/data/alpha01.dds", m_TextureStreamer);
 		m_GameObjectManager->AddItem(GameObjectManager::OBJECTTYPE_STATIC, new FireShaderGameObject(testCubeFire),
 			new XMFLOAT3(0.0f, 7.5f, 0.0f), new XMFLOAT3(0.0f, 0.0f, 45.0f), new XMFLOAT3(1.0f, 2.0f, 1.0f));
 
 		//Create and add a firemodel cube to the gameObjectManager.
 		FireModelClass* m_Model4 = new FireModelClass();
-		result = m_Model4->Initialize(m_D3D->GetDevice(), "../Engine/data/new-ninjaHead.txt", L"../Engine/data/fire01.dds", //square or cube
-			L"../Engine/data/noise01.dds", L"../Engine/data/alpha01.dds");
-		if (!result)
-		{
-			MessageBox(hwnd, L"Could not initialize the fourth model object.", L"Error", MB_OK);
-			return false;
-		}
+		m_Model4->InitializeAsync(m_AssetLoader, "../Engine/data/new-ninjaHead.txt", L"../Engine/data/fire01.dds", //square or cube
+			L"../Engine/data/noise01.dds", L"../Engine/data/alpha01.dds", m_TextureStreamer);
 		m_GameObjectManager->AddItem(GameObjectManager::OBJECTTYPE_STATIC, new FireShaderGameObject(m_Model4),
 			new XMFLOAT3(0.0f, 2.0f, -1.0f), new XMFLOAT3(0.0f, 0.0f, 0.0f), new XMFLOAT3(0.03f, 0.03f, 0.03f));
 
 		//Create and add a metal ninja head to the gameObjectManager.
 		ModelClass* m_MetalNinja = new ModelClass;
-		result = m_MetalNinja->Initialize(m_D3D->GetDevice(), "../Engine/data/new-ninjaHead.txt", L"../Engine/data/metal.dds");
-		if (!result)
-		{
-			MessageBox(hwnd, L"Could not initialize the second model object.", L"Error", MB_OK);
-			return false;
-		}
+		m_MetalNinja->InitializeAsync(m_AssetLoader, "../Engine/data/new-ninjaHead.txt", L"../Engine/data/metal.dds",
+			m_TextureStreamer);
 		metalNinja = new LightGameObject(m_MetalNinja, m_Light, m_Camera);
 		m_GameObjectManager->AddItem(GameObjectManager::OBJECTTYPE_DYNAMIC, metalNinja,
 			new XMFLOAT3(0.0f, -2.0f, 0.0f), new XMFLOAT3(0.0f, 0.0f, 0.0f), new XMFLOAT3(0.03f, 0.03f, 0.03f));
 
 		//Create and add a stone cube to the gameObjectManager.
 		BumpModelClass* m_StoneCube = new BumpModelClass();
-		result = m_StoneCube->Initialize(m_D3D->GetDevice(), "../Engine/data/cube.txt", L"../Engine/data/stone.dds",
-			L"../Engine/data/normal.dds");
-		if (!result)
-		{
-			MessageBox(hwnd, L"Could not initialize the third model object.", L"Error", MB_OK);
-			return false;
-		}
+		m_StoneCube->InitializeAsync(m_AssetLoader, "../Engine/data/cube.txt", L"../Engine/data/stone.dds",
+			L"../Engine/data/normal.dds", m_TextureStreamer);
 		bumpCube = new BumpMapGameObject(m_StoneCube, m_Light);
 		m_GameObjectManager->AddItem(GameObjectManager::OBJECTTYPE_DYNAMIC, bumpCube,
 			new XMFLOAT3(3.5f, 0.0f, 0.0f), new XMFLOAT3(0.0f, 0.0f, 0.0f), new XMFLOAT3(1.0f, 1.0f, 1.0f));
@@ -275,6 +315,16 @@ bool GraphicsClass::Initialize(HINSTANCE hinstance, HWND hwnd, int screenWidth,
 	// Initialize that the user has not clicked on the screen to try an intersection test yet.
 	m_beginCheck = false;
 	m_BeginSpawn = false;
+	m_BeginProfile = false;
+	m_BeginRenderCapture = false;
+	m_BeginMemoryReport = false;
+	m_BeginMemoryOverlay = false;
+	m_showMemoryOverlay = false;
+
+	// Start the simulation with no time owed and the scene unrotated.
+	m_simulationTime = 0.0f;
+	m_sceneRotation = 0.0f;
+	m_frameNumber = 0;
 
 	return true;
 }
@@ -288,10 +338,67 @@ Summary:	Releases and depoints all member variables of the
 Modifies:	[m_Light, m_Camera,
 			 m_Position, m_ShaderManager, m_Timer, m_D3D,
 			 m_Input, m_Bitmap, m_Text, m_CollisionObject
-			 m_GameObjectManager, metalNinja, bumpCube, m_BulletModel].
+			 m_GameObjectManager, metalNinja, bumpCube, m_BulletModel,
+			 m_AssetLoader, m_JobSystem, m_SimulationCounter, m_FrameSnapshot,
+			 m_TextureStreamDevice, m_TextureStreamer, m_TextureAtlas].
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 void GraphicsClass::Shutdown()
 {
+	// Let the simulation still running from the last frame finish first.
+	if (m_JobSystem && m_SimulationCounter)
+	{
+		m_JobSystem->Wait(m_SimulationCounter);
+	}
+
+	// Stop the asset loader before anything it may still be loading into is released.
+	if (m_AssetLoader)
+	{
+		m_AssetLoader->Shutdown();
+		delete m_AssetLoader;
+		m_AssetLoader = 0;
+	}
+
+	// Stop the job workers, nothing is updated after this point.
+	if (m_JobSystem)
+	{
+		m_GameObjectManager->SetJobSystem(0);
+		m_JobSystem->Shutdown();
+		delete m_JobSystem;
+		m_JobSystem = 0;
+	}
+
+	// Release the simulation counter, the frame snapshot and the simulation arena.
+	if (m_SimulationCounter)
+	{
+		delete m_SimulationCounter;
+		m_SimulationCounter = 0;
+	}
+	if (m_FrameSnapshot)
+	{
+		delete m_FrameSnapshot;
+		m_FrameSnapshot = 0;
+	}
+	if (m_SimulationArena)
+	{
+		m_SimulationArena->Shutdown();
+		delete m_SimulationArena;
+		m_SimulationArena = 0;
+	}
+
+	// Release every streamed texture while the device is still alive.
+	if (m_TextureStreamer)
+	{
+		m_TextureStreamer->Shutdown();
+		delete m_TextureStreamer;
+		m_TextureStreamer = 0;
+	}
+
+	// Release the texture stream device.
+	if (m_TextureStreamDevice)
+	{
+		delete m_TextureStreamDevice;
+		m_TextureStreamDevice = 0;
+	}
 
 	// Release the light object.
 	if(m_Light)
@@ -353,6 +460,14 @@ void GraphicsClass::Shutdown()
 		m_Bitmap = 0;
 	}
 
+	// Release the texture atlas object.
+	if (m_TextureAtlas)
+	{
+		m_TextureAtlas->Shutdown();
+		delete m_TextureAtlas;
+		m_TextureAtlas = 0;
+	}
+
 	// Release the text object.
 	if (m_Text)
 	{
@@ -406,11 +521,23 @@ void GraphicsClass::Shutdown()
 Method:		Frame
 
 Summary:	Performs the actions required every frame:
+				Collecting the simulation started last frame.
 				Timer update.
+				Streamed asset finalizing.
 				Input handling.
+				Starting the fixed step simulation of the next frame.
 				Rendering.
-
-Modifies:	[none].
+			The simulation runs in SIMULATION_STEP steps whatever the frame
+			rate, carrying the time left over to the next frame, and the
+			frame is drawn interpolated through the current step.
+			At most SIMULATION_MAX_STEPS run in one frame; time beyond that
+			is dropped so a slow frame cannot snowball.
+			The steps run as a job while this frame draws the snapshot the
+			last frame's steps wrote, so on several cores a frame takes as
+			long as the slower of the two rather than both, at the cost of
+			drawing one frame behind the simulation.
+
+Modifies:	[m_simulationTime, m_frameNumber, m_FrameSnapshot].
 
 Returns:	bool
 				did the frame execute successfully.
@@ -418,12 +545,53 @@ M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 bool GraphicsClass::Frame()
 {
 	bool result;
+	int hits, culls;
+
+	// Finish the simulation started last frame and take the snapshot it wrote.
+	// Nothing below touches the gameObjects until the next one is started.
+	{
+		PROFILE_ZONE("WaitForSimulation");
+		m_JobSystem->Wait(m_SimulationCounter);
+		m_FrameSnapshot->Swap();
+	}
+
+	// Update the score with what the projectiles did during those steps.
+	m_GameObjectManager->TakeScoreEvents(hits, culls);
+	if (culls > 0)
+	{
+		SetIntersectionText(false, 3.0f * culls);
+	}
+	if (hits > 0)
+	{
+		SetIntersectionText(true, 3.0f * hits);
+	}
+
+	// Refresh the heap stats under the score a few times a second.
+	if (m_showMemoryOverlay && m_frameNumber % MEMORY_OVERLAY_REFRESH_FRAMES == 0)
+	{
+		m_Text->SetStats(MemoryTrackerClass::GetOverlay().c_str());
+	}
 
 	// Update the system stats.
 	m_Timer->Frame();
 
+	// Create the device resources of any assets that finished loading.
+	{
+		PROFILE_ZONE("AssetLoader::Update");
+		m_AssetLoader->Update(m_D3D->GetDevice(), ASSET_FINALIZES_PER_FRAME);
+	}
+
+	// Stream texture mip levels in or out from last frame's requests.
+	{
+		PROFILE_ZONE("TextureStreamer::Update");
+		m_TextureStreamer->Update();
+	}
+
 	// Read the user input.
-	result = m_Input->Frame();
+	{
+		PROFILE_ZONE("InputClass::Frame");
+		result = m_Input->Frame();
+	}
 	if (!result)
 	{
 		return false;
@@ -436,14 +604,23 @@ bool GraphicsClass::Frame()
 	}
 
 	// Do the frame input processing.
-	result = HandleMovementInput(m_Timer->GetTime());
+	{
+		PROFILE_ZONE("HandleMovementInput");
+		result = HandleMovementInput(m_Timer->GetTime());
+	}
 	if (!result)
 	{
 		return false;
 	}
 
+	// Simulate the next frame on the job system while this one is drawn.
+	StartSimulation(m_Timer->GetTime() / 1000.0f);
+
 	// Render the graphics.
-	result = Render();
+	{
+		PROFILE_ZONE("Render");
+		result = Render();
+	}
 	if (!result)
 	{
 		return false;
@@ -452,6 +629,61 @@ bool GraphicsClass::Frame()
 	return true;
 }
 
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		StartSimulation
+
+Summary:	Works out how many fixed steps the time passed covers, then
+			queues a job that runs them and writes the snapshot the next
+			frame draws. The job runs under m_SimulationCounter, which
+			Frame() waits on before touching any gameObject again.
+			Whichever thread picks the job up takes its per-frame data from
+			m_SimulationArena, which only the job uses.
+
+Args:		float elapsedTime
+				the time passed since the last frame, in seconds.
+
+Modifies:	[m_simulationTime, m_frameNumber].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void GraphicsClass::StartSimulation(float elapsedTime)
+{
+	// Count the steps owed, dropping any time beyond the most allowed.
+	m_simulationTime += elapsedTime;
+
+	int steps = 0;
+	while (m_simulationTime >= SIMULATION_STEP)
+	{
+		if (steps == SIMULATION_MAX_STEPS)
+		{
+			m_simulationTime = fmodf(m_simulationTime, SIMULATION_STEP);
+			break;
+		}
+
+		m_simulationTime -= SIMULATION_STEP;
+		steps++;
+	}
+
+	float interpolation = m_simulationTime / SIMULATION_STEP;
+	int frame = ++m_frameNumber;
+
+	// Run the steps and write the snapshot off the main thread.
+	m_JobSystem->Run([this, steps, interpolation, frame]()
+	{
+		PROFILE_ZONE("Simulation");
+		MEMORY_TAG("Simulation");
+
+		//Reclaim the last job's transient data and take this job's from the arena.
+		m_SimulationArena->Reset();
+		FrameArenaScope arenaScope(m_SimulationArena);
+
+		for (int i = 0; i < steps; i++)
+		{
+			Update(SIMULATION_STEP);
+		}
+
+		m_GameObjectManager->WriteSnapshot(interpolation, frame, m_FrameSnapshot);
+	}, m_SimulationCounter);
+}
+
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
 Method:		HandleMovementInput
 
@@ -461,7 +693,8 @@ Args:		float frameTime
 				the amount of time that has passed between the last frame
 				and this one.
 
-Modifies:	[m_Position, m_beginCheck, m_BeginSpawn].
+Modifies:	[m_Position, m_beginCheck, m_BeginSpawn, m_BeginRenderCapture,
+			 m_BeginMemoryReport, m_BeginMemoryOverlay, m_showMemoryOverlay].
 
 Returns:	bool
 				was all movement handled succesfully.
@@ -555,16 +788,111 @@ bool GraphicsClass::HandleMovementInput(float frameTime)
 		m_BeginSpawn = false;
 	}
 
+	//If F9 is pressed, write the profiler report and capture a trace of the next frames.
+	if (m_Input->IsF9Pressed() == true)
+	{
+		if (m_BeginProfile == false)
+		{
+			m_BeginProfile = true;
+
+			OutputDebugStringA(ProfilerClass::GetReport().c_str());
+			ProfilerClass::CaptureTrace(PROFILER_TRACE_FRAMES, PROFILER_TRACE_FILE);
+		}
+	}
+	else
+	{
+		m_BeginProfile = false;
+	}
+
+	//If F10 is pressed, log every render command of the next frame.
+	if (m_Input->IsF10Pressed() == true)
+	{
+		if (m_BeginRenderCapture == false)
+		{
+			m_BeginRenderCapture = true;
+
+			m_D3D->CaptureRenderFrame(RENDER_CAPTURE_FILE);
+		}
+	}
+	else
+	{
+		m_BeginRenderCapture = false;
+	}
+
+	//If F7 is pressed, write what the heap holds to a file.
+	if (m_Input->IsF7Pressed() == true)
+	{
+		if (m_BeginMemoryReport == false)
+		{
+			m_BeginMemoryReport = true;
+
+			MemoryTrackerClass::WriteReport(MEMORY_REPORT_FILE);
+		}
+	}
+	else
+	{
+		m_BeginMemoryReport = false;
+	}
+
+	//If F8 is pressed, toggle the heap summary on screen.
+	if (m_Input->IsF8Pressed() == true)
+	{
+		if (m_BeginMemoryOverlay == false)
+		{
+			m_BeginMemoryOverlay = true;
+
+			m_showMemoryOverlay = !m_showMemoryOverlay;
+			m_Text->SetStats(m_showMemoryOverlay ? MemoryTrackerClass::GetOverlay().c_str() : "");
+		}
+	}
+	else
+	{
+		m_BeginMemoryOverlay = false;
+	}
+
 	return true;
 }
 
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Update
+
+Summary:	Runs one fixed simulation step: spins the rotating objects,
+			then has the gameObjectManager advance and collide everything.
+
+Args:		float deltaTime
+				the length of the step, in seconds.
+
+Modifies:	[m_sceneRotation, m_GameObjectManager].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void GraphicsClass::Update(float deltaTime)
+{
+	// Keep where everything was so frames before the next step can interpolate.
+	m_GameObjectManager->BeginStep();
+
+	// Update the rotation variable each step.
+	m_sceneRotation += SCENE_ROTATION_SPEED * deltaTime;
+
+	//Dynamic object alteration.
+	GameObject* metalNinjaRef = m_GameObjectManager->SearchFor(GameObjectManager::OBJECTTYPE_DYNAMIC, metalNinja);
+	if (metalNinjaRef != nullptr)
+		metalNinjaRef->setRotation(0.0f, m_sceneRotation, 0.0f);
+	GameObject* bumpCubeRef = m_GameObjectManager->SearchFor(GameObjectManager::OBJECTTYPE_DYNAMIC, bumpCube);
+	if (bumpCubeRef != nullptr)
+		bumpCubeRef->setRotation(m_sceneRotation / 3.0f, 0.0f, 0.0f);
+
+	// Advance the projectiles and animations, then collide everything.
+	m_GameObjectManager->Update(deltaTime);
+}
+
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
 Method:		Render
 
 Summary:	Translates and renders each model.
-			Requests the gameObjectManager to render all models it is
-			concerned by, then renders models the GraphicsClass is
-			responsible for.
+			Requests the gameObjectManager to render all models in the
+			front buffer of the frame snapshot, then renders models the
+			GraphicsClass is responsible for.
+			Runs alongside the simulation of the next frame, so must not
+			read or change any gameObject.
 
 Modifies:	[m_D3D].
 
@@ -573,54 +901,46 @@ Returns:	bool
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 bool GraphicsClass::Render()
 {
-	XMMATRIX worldMatrix, viewMatrix, projectionMatrix, translateMatrix, orthoMatrix;
+	XMMATRIX orthoMatrix;
 	bool result;
 	int mouseX, mouseY;
 
-	static float rotation = 0.0f;
-
-	// Update the rotation variable each frame.
-	rotation += (float)XM_PI * 0.0005f * m_Timer->GetTime();
-
 	// Clear the buffers to begin the scene.
 	m_D3D->BeginScene(0.0f, 0.0f, 0.0f, 1.0f);
 
-	// Generate the view matrix based on the camera's position.
+	// Generate the view matrix based on the camera's position, if it has moved since the last frame.
 	m_Camera->Render();
 
-	// Get the view, projection and ortho matrices from the camera and d3d objects.
-	m_Camera->GetViewMatrix(viewMatrix);
-	m_D3D->GetProjectionMatrix(projectionMatrix);
-	m_D3D->GetOrthoMatrix(orthoMatrix);
-
-	//Dynamic object alteration.
-	GameObject* metalNinjaRef = m_GameObjectManager->SearchFor(GameObjectManager::OBJECTTYPE_DYNAMIC, metalNinja);
-	if (metalNinjaRef != nullptr)
-		metalNinjaRef->setRotation(0.0f, rotation, 0.0f);
-	GameObject* bumpCubeRef = m_GameObjectManager->SearchFor(GameObjectManager::OBJECTTYPE_DYNAMIC, bumpCube);
-	if (bumpCubeRef != nullptr)
-		bumpCubeRef->setRotation(rotation / 3.0f, 0.0f, 0.0f);
-
 	//Turn on alpha blending
 	m_D3D->TurnOnAlphaBlending();
 
-	//Use the gameObjectManager to render all the objects it holds.
-	m_GameObjectManager->RenderAll(m_ShaderManager, m_D3D, m_Camera, viewMatrix, projectionMatrix, m_Text);
+	//Render every object where the last snapshot placed it.
+	{
+		PROFILE_ZONE("RenderAll");
+		m_GameObjectManager->RenderAll(m_FrameSnapshot, m_ShaderManager, m_D3D, m_Camera, m_TextureAtlas);
+	}
 
 	// Get the location of the mouse from the input object and the ortho matrix.
 	m_Input->GetMouseLocation(mouseX, mouseY);
 	m_D3D->GetOrthoMatrix(orthoMatrix);
 
 	// Render the mouse cursor with the texture shader.
-	result = m_Bitmap->Render(m_D3D->GetDeviceContext(), mouseX, mouseY);  
-	if (!result) 
-		return false;
-	result = m_ShaderManager->RenderTextureShader(m_D3D->GetDeviceContext(), m_Bitmap->GetIndexCount(), XMMatrixIdentity(), XMMatrixIdentity(), orthoMatrix, m_Bitmap->GetTexture());
-	if (!result)
-		return false;
+	{
+		PROFILE_GPU_ZONE(m_D3D->GetGpuProfiler(), "GPU Cursor");
+		result = m_Bitmap->Render(m_D3D->GetRenderContext(), mouseX, mouseY);  
+		if (!result) 
+			return false;
+		result = m_ShaderManager->RenderTextureShader(m_D3D->GetRenderContext(), m_Bitmap->GetIndexCount(), XMMatrixIdentity(), orthoMatrix, m_Bitmap->GetTexture());
+		if (!result)
+			return false;
+	}
 
 	// Render the text strings.
-	result = m_Text->Render(m_D3D->GetDeviceContext());
+	{
+		PROFILE_ZONE("TextClassA::Render");
+		PROFILE_GPU_ZONE(m_D3D->GetGpuProfiler(), "GPU Text");
+		result = m_Text->Render(m_D3D->GetDeviceContext());
+	}
 	if (!result)
 		return false;
 
@@ -628,7 +948,10 @@ bool GraphicsClass::Render()
 	m_D3D->TurnOffAlphaBlending();
 
 	// Present the rendered scene to the screen.
-	m_D3D->EndScene();
+	{
+		PROFILE_ZONE("EndScene");
+		m_D3D->EndScene();
+	}
 
 	return true;
 }
@@ -669,7 +992,15 @@ void GraphicsClass::ShootProjectile()
 	//Use the collision class to get a direction vector from the camera to the mouse co-ordinates.
 	CollisionClass::GetRay(m_D3D, m_Camera, mouseRayVelocity, mouseX, mouseY);
 
+	//Fire along the direction at the projectile speed.
+	mouseRayVelocity.x *= PROJECTILE_SPEED;
+	mouseRayVelocity.y *= PROJECTILE_SPEED;
+	mouseRayVelocity.z *= PROJECTILE_SPEED;
+
 	//Add a projectile into consideration by the gameObject using the calculated velocity.
-	m_GameObjectManager->AddProjectile(new ProjectileObject(m_BulletModel, m_Light, m_Camera, &mouseRayVelocity), &m_Camera->GetPosition(), &m_Camera->GetRotation());
+	MEMORY_TAG("Projectiles");
+	XMFLOAT3 position = m_Camera->GetPosition();
+	XMFLOAT4 orientation = m_Camera->GetOrientation();
+	m_GameObjectManager->AddProjectile(new ProjectileObject(m_BulletModel, m_Light, m_Camera, &mouseRayVelocity), &position, &orientation);
 }
 
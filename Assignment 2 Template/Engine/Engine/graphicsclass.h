@@ -26,6 +26,15 @@
 #include "BumpMapGameObject.h"
 #include "FireShaderGameObject.h"
 #include "GameObjectManager.h"
+#include "AssetLoaderClass.h"
+#include "JobSystemClass.h"
+#include "FrameSnapshotClass.h"
+#include "FrameArenaClass.h"
+#include "TextureStreamerClass.h"
+#include "D3DTextureStreamDevice.h"
+#include "TextureAtlasClass.h"
+#include "ProfilerClass.h"
+#include "MemoryTrackerClass.h"
 
 //==============================================
 //	  Global Constants/Program parameters 
@@ -34,6 +43,22 @@ const bool FULL_SCREEN = false;
 const bool VSYNC_ENABLED = true;
 const float SCREEN_DEPTH = 1000.0f;
 const float SCREEN_NEAR = 0.1f;
+const int ASSET_LOADER_THREADS = 0;
+const int ASSET_FINALIZES_PER_FRAME = 4;
+const int JOB_WORKER_THREADS = 0;
+const size_t TEXTURE_STREAM_BUDGET = 32 * 1024 * 1024;
+const int TEXTURE_STREAM_TAIL_SIZE = 64;
+const int TEXTURE_UPLOADS_PER_FRAME = 2;
+const int TEXTURE_ATLAS_MAX_SIZE = 1024;
+const int TEXTURE_ATLAS_PADDING = 1;
+const int PROFILER_TRACE_FRAMES = 120;
+const char* const PROFILER_TRACE_FILE = "profile-trace.json";
+const char* const RENDER_CAPTURE_FILE = "render-capture.txt";
+const char* const MEMORY_REPORT_FILE = "memory-report.txt";
+const int MEMORY_OVERLAY_REFRESH_FRAMES = 30;
+const float SIMULATION_STEP = 1.0f / 120.0f;
+const int SIMULATION_MAX_STEPS = 8;
+const float SCENE_ROTATION_SPEED = XM_PI * 0.5f;
 
 
 /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
@@ -60,16 +85,24 @@ Methods:	==================== PUBLIC ====================
 				Used to cleanup and free all memory used by the
 				GraphicsClass object.
 			Frame()
-				Use to render a single frame of the scene.
+				Use to render a single frame of the scene, while the fixed
+				simulation steps the time since the last frame covers run
+				on the job system.
 
 			==================== PRIVATE ====================
 			HandleMovementInput(float)
 				Called by Frame() to handle user input every frame.
+			StartSimulation(float)
+				Called by Frame() to queue the simulation steps of the next
+				frame and the writing of its snapshot as a job.
+			Update(float)
+				Called by the simulation job to run one fixed simulation step.
 			Render()
-				Called by Frame() to render every object.
+				Called by Frame() to render every object from the front buffer
+				of the frame snapshot.
 
 			SetIntersectionText(bool intersection, float scoreToAdd)
-				Called by HandleMovementInput() to process the result of intersection testing
+				Called by HandleMovementInput() and Frame() to process the result of intersection testing
 				and add score to be displayed.
 
 			ShootProjectile()
@@ -94,6 +127,24 @@ Members:	==================== PRIVATE ====================
 				A utility object for various forms of collision checking.
 			GameObjectManager* m_GameObjectManager
 				A utility object to manage and keep track of all the objects in the scene.
+			AssetLoaderClass* m_AssetLoader
+				An object to stream models and textures in on background threads.
+			JobSystemClass* m_JobSystem
+				A pool of worker threads the per step object updates are spread across.
+			JobCounter* m_SimulationCounter
+				The counter the simulation of the next frame runs under.
+			FrameSnapshotClass* m_FrameSnapshot
+				The matrices and visibility of every object, written by the
+				simulation and drawn by the following frame.
+			FrameArenaClass* m_SimulationArena
+				The arena the simulation job's per-frame data is taken from,
+				reset at the start of each job.
+			D3DTextureStreamDevice* m_TextureStreamDevice
+				The device the texture streamer uploads mip levels through.
+			TextureStreamerClass* m_TextureStreamer
+				An object to keep texture mip levels resident within a budget.
+			TextureAtlasClass* m_TextureAtlas
+				An atlas of the small HUD and debug textures, sharing one texture.
 
 			LightGameObject* metalNinja
 				a pointer to a dynamic object within the scene.
@@ -110,6 +161,23 @@ Members:	==================== PRIVATE ====================
 			
 			bool m_beginCheck
 				A 'global' variable to handle mouse testing.
+			bool m_BeginProfile
+				A 'global' variable so holding F9 only captures one profile.
+			bool m_BeginRenderCapture
+				A 'global' variable so holding F10 only captures one frame.
+			bool m_BeginMemoryReport
+				A 'global' variable so holding F7 only writes one memory report.
+			bool m_BeginMemoryOverlay
+				A 'global' variable so holding F8 only toggles the overlay once.
+			bool m_showMemoryOverlay
+				whether the heap stats are drawn under the score.
+
+			float m_simulationTime
+				the time passed that has not yet been simulated, in seconds.
+			float m_sceneRotation
+				the rotation of the spinning objects in the scene, in radians.
+			int m_frameNumber
+				the number of the last frame whose simulation was started.
 C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
 class GraphicsClass
 {
@@ -124,6 +192,8 @@ public:
 
 private:
 	bool HandleMovementInput(float);
+	void StartSimulation(float);
+	void Update(float);
 	bool Render();
 
 	void SetIntersectionText(bool intersection, float scoreToAdd);
@@ -140,6 +210,14 @@ private:
 	LightClass* m_Light;
 	CollisionClass* m_CollisionObject;
 	GameObjectManager* m_GameObjectManager;
+	AssetLoaderClass* m_AssetLoader;
+	JobSystemClass* m_JobSystem;
+	JobCounter* m_SimulationCounter;
+	FrameSnapshotClass* m_FrameSnapshot;
+	FrameArenaClass* m_SimulationArena;
+	D3DTextureStreamDevice* m_TextureStreamDevice;
+	TextureStreamerClass* m_TextureStreamer;
+	TextureAtlasClass* m_TextureAtlas;
 
 	LightGameObject* metalNinja;
 	BumpMapGameObject* bumpCube;
@@ -151,6 +229,15 @@ private:
 
 	bool m_beginCheck;
 	bool m_BeginSpawn;
+	bool m_BeginProfile;
+	bool m_BeginRenderCapture;
+	bool m_BeginMemoryReport;
+	bool m_BeginMemoryOverlay;
+	bool m_showMemoryOverlay;
+
+	float m_simulationTime;
+	float m_sceneRotation;
+	int m_frameNumber;
 
 	
 
@@ -49,6 +49,10 @@ public:
 	bool IsZPressed();
 	bool IsPgUpPressed();
 	bool IsPgDownPressed();
+	bool IsF7Pressed();
+	bool IsF8Pressed();
+	bool IsF9Pressed();
+	bool IsF10Pressed();
 	bool IsLeftMouseButtonDown();
 	bool IsRightMouseButtonDown();
 
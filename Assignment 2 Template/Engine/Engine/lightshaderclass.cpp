@@ -51,15 +51,15 @@ void LightShaderClass::Shutdown()
 }
 
 
-bool LightShaderClass::Render(ID3D11DeviceContext* deviceContext, int indexCount, const XMMATRIX &worldMatrix, const XMMATRIX &viewMatrix,
-	const XMMATRIX &projectionMatrix, ID3D11ShaderResourceView* texture, XMFLOAT3 lightDirection, XMFLOAT4 ambientColor,
+bool LightShaderClass::Render(RenderContext* deviceContext, int indexCount, const XMMATRIX &worldMatrix, const XMMATRIX &viewProjectionMatrix,
+	ID3D11ShaderResourceView* texture, XMFLOAT3 lightDirection, XMFLOAT4 ambientColor,
 	XMFLOAT4 diffuseColor, XMFLOAT3 cameraPosition, XMFLOAT4 specularColor, float specularPower)
 {
 	bool result;
 
 
 	// Set the shader parameters that it will use for rendering.
-	result = SetShaderParameters(deviceContext, worldMatrix, viewMatrix, projectionMatrix, texture, lightDirection, ambientColor, diffuseColor, 
+	result = SetShaderParameters(deviceContext, worldMatrix, viewProjectionMatrix, texture, lightDirection, ambientColor, diffuseColor, 
 								 cameraPosition, specularColor, specularPower);
 	if(!result)
 	{
@@ -351,8 +351,8 @@ void LightShaderClass::OutputShaderErrorMessage(ID3D10Blob* errorMessage, HWND h
 }
 
 
-bool LightShaderClass::SetShaderParameters(ID3D11DeviceContext* deviceContext, const XMMATRIX &worldMatrix, const XMMATRIX &viewMatrix,
-	const XMMATRIX &projectionMatrix, ID3D11ShaderResourceView* texture, XMFLOAT3 lightDirection,
+bool LightShaderClass::SetShaderParameters(RenderContext* deviceContext, const XMMATRIX &worldMatrix, const XMMATRIX &viewProjectionMatrix,
+	ID3D11ShaderResourceView* texture, XMFLOAT3 lightDirection,
 	XMFLOAT4 ambientColor, XMFLOAT4 diffuseColor, XMFLOAT3 cameraPosition, XMFLOAT4 specularColor,
 										   float specularPower)
 {
@@ -378,8 +378,7 @@ bool LightShaderClass::SetShaderParameters(ID3D11DeviceContext* deviceContext, c
 
 	// Copy the matrices into the constant buffer.
 	dataPtr->world = XMMatrixTranspose(worldMatrix);
-	dataPtr->view = XMMatrixTranspose(viewMatrix);
-	dataPtr->projection = XMMatrixTranspose(projectionMatrix);
+	dataPtr->viewProjection = XMMatrixTranspose(viewProjectionMatrix);
 
 	// Unlock the constant buffer.
     deviceContext->Unmap(m_matrixBuffer, 0);
@@ -446,7 +445,7 @@ bool LightShaderClass::SetShaderParameters(ID3D11DeviceContext* deviceContext, c
 }
 
 
-void LightShaderClass::RenderShader(ID3D11DeviceContext* deviceContext, int indexCount)
+void LightShaderClass::RenderShader(RenderContext* deviceContext, int indexCount)
 {
 	// Set the vertex input layout.
 	deviceContext->IASetInputLayout(m_layout);
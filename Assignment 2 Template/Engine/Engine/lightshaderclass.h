@@ -17,6 +17,12 @@ using namespace DirectX;
 using namespace std;
 
 
+///////////////////////
+// MY CLASS INCLUDES //
+///////////////////////
+#include "RenderContext.h"
+
+
 ////////////////////////////////////////////////////////////////////////////////
 // Class name: LightShaderClass
 ////////////////////////////////////////////////////////////////////////////////
@@ -26,8 +32,7 @@ private:
 	struct MatrixBufferType
 	{
 		XMMATRIX  world;
-		XMMATRIX  view;
-		XMMATRIX  projection;
+		XMMATRIX  viewProjection;
 	};
 
 	struct CameraBufferType
@@ -52,7 +57,7 @@ public:
 
 	bool Initialize(ID3D11Device*, HWND);
 	void Shutdown();
-	bool Render(ID3D11DeviceContext*, int, const XMMATRIX&, const XMMATRIX&, const XMMATRIX&, ID3D11ShaderResourceView*, XMFLOAT3, XMFLOAT4, XMFLOAT4,
+	bool Render(RenderContext*, int, const XMMATRIX&, const XMMATRIX&, ID3D11ShaderResourceView*, XMFLOAT3, XMFLOAT4, XMFLOAT4,
 		XMFLOAT3, XMFLOAT4, float);
 
 private:
@@ -60,9 +65,9 @@ private:
 	void ShutdownShader();
 	void OutputShaderErrorMessage(ID3D10Blob*, HWND, WCHAR*);
 
-	bool SetShaderParameters(ID3D11DeviceContext*, const XMMATRIX&, const XMMATRIX&, const XMMATRIX&, ID3D11ShaderResourceView*, XMFLOAT3, XMFLOAT4, XMFLOAT4,
+	bool SetShaderParameters(RenderContext*, const XMMATRIX&, const XMMATRIX&, ID3D11ShaderResourceView*, XMFLOAT3, XMFLOAT4, XMFLOAT4,
 		XMFLOAT3, XMFLOAT4, float);
-	void RenderShader(ID3D11DeviceContext*, int);
+	void RenderShader(RenderContext*, int);
 
 private:
 	ID3D11VertexShader* m_vertexShader;
@@ -2,6 +2,7 @@
 // Filename: main.cpp
 ////////////////////////////////////////////////////////////////////////////////
 #include "systemclass.h"
+#include "BenchmarkClass.h"
 
 
 int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR pScmdline, int iCmdshow)
@@ -10,6 +11,24 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR pScmdline,
 	bool result;
 	
 	
+	// Run the headless benchmark instead of the game if it was asked for.
+	if(BenchmarkClass::IsRequested(pScmdline))
+	{
+		BenchmarkClass* Benchmark = new BenchmarkClass;
+
+		result = Benchmark->Initialize(pScmdline);
+		if(result)
+		{
+			result = Benchmark->Run();
+		}
+
+		Benchmark->Shutdown();
+		delete Benchmark;
+		Benchmark = 0;
+
+		return result ? 0 : 1;
+	}
+
 	// Create the system object.
 	System = new SystemClass;
 	if(!System)
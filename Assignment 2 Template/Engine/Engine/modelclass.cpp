@@ -13,7 +13,8 @@ Method:		ModelClass
 
 Summary:	The default constructor for a ModelClass object.
 
-Modifies:	[m_vertexBuffer, m_indexBuffer, m_Texture, m_model, m_AABB, m_min, m_max].
+Modifies:	[m_vertexBuffer, m_indexBuffer, m_Texture, m_model, m_AABB, m_BVH, m_min,
+			 m_max, m_ready].
 
 Returns:	ModelClass
 				The constructed ModelClass object.
@@ -25,8 +26,10 @@ ModelClass::ModelClass()
 	m_Texture = 0;
 	m_model = 0;
 	m_AABB = 0;
+	m_BVH = 0;
 	m_min = 0;
 	m_max = 0;
+	m_ready = false;
 }
 
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -63,20 +66,25 @@ Method:		Initialize
 
 Summary:	An overload of Initialize that uses a boundingbox to create
 			a model (using the center and extents of the boundingbox).
+			With no device, as when running headless, only the vertex
+			data is made.
 
 Args:		ID3D11Device* device
 				a pointer to the ID3D11Device object that should be used
-				to load the boundingBoxModel texture with.
+				to load the boundingBoxModel texture with, or 0.
 			BoundingBox* AABB
 				a pointer to the bounding box which contains the data
 				with which to query for the points of the bounding box.
+			TextureAtlasClass* atlas
+				an atlas holding the "blue" texture to share, or 0 to
+				load blue.dds from disk.
 
 Modifies:	[none].
 
 Returns:	bool
 				was the initialization of all the subparts successful?
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-bool ModelClass::Initialize(ID3D11Device* device, BoundingBox* AABB)
+bool ModelClass::Initialize(ID3D11Device* device, BoundingBox* AABB, TextureAtlasClass* atlas)
 {
 	bool result;
 
@@ -106,16 +114,48 @@ bool ModelClass::Initialize(ID3D11Device* device, BoundingBox* AABB)
 	if (!result)
 		return false;
 
+	//Sample the middle of the atlas region rather than the corner of a whole texture.
+	TextureAtlasClass::AtlasRegion region;
+	if (atlas && atlas->GetRegion("blue", region))
+	{
+		for (int i = 0; i < m_vertexCount; i++)
+		{
+			m_model[i].tu = (region.left + region.right) * 0.5f;
+			m_model[i].tv = (region.top + region.bottom) * 0.5f;
+		}
+	}
+	else
+	{
+		atlas = 0;
+	}
+
+	//Headless there is nothing to create the buffers or texture on.
+	if (!device)
+	{
+		m_ready = true;
+		return true;
+	}
+
 	//Initialize the vertex and index buffers.
 	result = InitializeBuffers(device);
 	if (!result)
 		return false;
 
-	//Initialize the texture
-	result = LoadTexture(device, L"../Engine/Data/blue.dds");
+	//Initialize the texture, sharing the atlas if there is one.
+	if (atlas)
+	{
+		m_Texture = new TextureClass;
+		result = m_Texture->Initialize(atlas->GetTexture());
+	}
+	else
+	{
+		result = LoadTexture(device, L"../Engine/Data/blue.dds");
+	}
 	if (!result)
 		return false;
 
+	m_ready = true;
+
 	return true;
 }
 
@@ -145,20 +185,13 @@ bool ModelClass::Initialize(ID3D11Device* device, char* modelFilename, WCHAR* te
 	bool result;
 
 
-	// Load in the model data,
-	result = LoadModel(modelFilename);
+	// Load in the model data, its bounding box and its triangle hierarchy.
+	result = LoadMeshData(modelFilename);
 	if(!result)
 	{
 		return false;
 	}
 
-	//Setup the bounding box.
-	result = SetupBoundingBox();
-	if (!result)
-	{
-		return false;
-	}
-
 	// Initialize the vertex and index buffers.
 	result = InitializeBuffers(device);
 	if(!result)
@@ -173,9 +206,103 @@ bool ModelClass::Initialize(ID3D11Device* device, char* modelFilename, WCHAR* te
 		return false;
 	}
 
+	m_ready = true;
+
 	return true;
 }
 
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Initialize
+
+Summary:	================= CALL AFTER CREATION =================
+			Loads only the vertex data and bounding box of a model, without
+			creating buffers or a texture, so it can be used for collision
+			with no device such as by the headless benchmark.
+			The model counts as ready, but must only be rendered through
+			a headless D3DClass, whose recorder accepts its null buffers.
+
+Args:		char* modelFilename
+				a filepath to the .txt file containing the vertex data
+				for this model.
+
+Modifies:	[m_ready].
+
+Returns:	bool
+				was the model data loaded successfully.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool ModelClass::Initialize(char* modelFilename)
+{
+	// Load in the model data, its bounding box and its triangle hierarchy.
+	if (!LoadMeshData(modelFilename))
+		return false;
+
+	m_ready = true;
+
+	return true;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		InitializeAsync
+
+Summary:	================= CALL AFTER CREATION =================
+			Queues this ModelClass object to be streamed in by the asset loader.
+			Parsing the model file, the bounding box and reading the texture
+			file happen on a worker thread; only the buffer and texture
+			creation happen on the device thread during AssetLoaderClass::Update.
+
+Args:		AssetLoaderClass* loader
+				the asset loader to queue the model on.
+			char* modelFilename
+				a filepath to the .txt file containing the vertex data
+				for this model.
+			WCHAR* textureFilename
+				a filepath to the ARGB8 .dds file used for the texture
+				of this model.
+			TextureStreamerClass* streamer
+				a texture streamer to hand the texture to, or 0 to create
+				it at full resolution.
+
+Modifies:	[m_Texture, m_ready].
+
+Returns:	AssetLoaderClass::AssetHandle
+				a handle which becomes true once the model is ready to draw.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+AssetLoaderClass::AssetHandle ModelClass::InitializeAsync(AssetLoaderClass* loader, char* modelFilename, WCHAR* textureFilename,
+	TextureStreamerClass* streamer)
+{
+	std::string modelPath(modelFilename);
+	std::wstring texturePath(textureFilename);
+
+	m_ready = false;
+
+	// Create the texture object up front so the worker only has to fill it.
+	m_Texture = new TextureClass;
+
+	return loader->Request(modelFilename,
+		[this, modelPath, texturePath]()
+		{
+			// Load in the model data, its bounding box and its triangle hierarchy.
+			if (!LoadMeshData((char*)modelPath.c_str()))
+				return false;
+
+			// Read the texture file ready for creation on the device thread.
+			return m_Texture->LoadFileData((WCHAR*)texturePath.c_str());
+		},
+		[this, streamer](ID3D11Device* device)
+		{
+			// Create the vertex and index buffers.
+			if (!InitializeBuffers(device))
+				return false;
+
+			// Create the texture, or hand it to the streamer.
+			if (!(streamer ? m_Texture->Initialize(streamer) : m_Texture->Initialize(device)))
+				return false;
+
+			m_ready = true;
+			return true;
+		});
+}
+
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
 Method:		Shutdown()
 
@@ -199,6 +326,11 @@ void ModelClass::Shutdown()
 	//Release the boundingBox collision data.
 	ReleaseBoundingBox();
 
+	//Release the triangle hierarchy.
+	ReleaseBVH();
+
+	m_ready = false;
+
 	return;
 }
 
@@ -208,12 +340,12 @@ Method:		Render
 Summary:	Puts the stored vertex and index buffers on the graphics
 			pipeline to draw them
 
-Args:		ID3D11DeviceContext* deviceContext
+Args:		RenderContext* deviceContext
 				the device context that the model should be rendered to, 
 
 Modifies:	[none].
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-void ModelClass::Render(ID3D11DeviceContext* deviceContext)
+void ModelClass::Render(RenderContext* deviceContext)
 {
 	// Put the vertex and index buffers on the graphics pipeline to prepare them for drawing.
 	RenderBuffers(deviceContext);
@@ -244,10 +376,13 @@ Summary:	Gets a reference to the resource view containing the texture
 
 Returns:	ID3D11ShaderResourceView*
 				A pointer to a resource view containing the texture being
-				used by the model.
+				used by the model, or 0 if the model was loaded without one.
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 ID3D11ShaderResourceView* ModelClass::GetTexture()
 {
+	if (!m_Texture)
+		return 0;
+
 	return m_Texture->GetTexture();
 }
 
@@ -264,6 +399,51 @@ BoundingBox* ModelClass::GetAABB()
 	return this->m_AABB;
 }
 
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetBVH
+
+Summary:	Returns the hierarchy over the triangles of this model.
+
+Returns:	MeshBVHClass*
+				A pointer to the triangle hierarchy of this model, in model
+				space, or 0 if it was not loaded from a file.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+MeshBVHClass* ModelClass::GetBVH()
+{
+	return m_BVH;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		IsReady
+
+Summary:	Returns whether the buffers and texture of this model have
+			been created and it can be drawn.
+
+Returns:	bool
+				true once the model is ready to draw.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool ModelClass::IsReady()
+{
+	return m_ready;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RequestTextureSize
+
+Summary:	Tells the texture of this model how large the model is on
+			screen, so a streamed texture can fetch the mips it needs.
+
+Args:		float screenPixels
+				the size of the model on screen, in pixels.
+
+Modifies:	[none].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void ModelClass::RequestTextureSize(float screenPixels)
+{
+	if (m_Texture)
+		m_Texture->RequestSize(screenPixels);
+}
+
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
 Method:		InitializeBuffers
 
@@ -397,12 +577,12 @@ Method:		RenderBuffers
 Summary:	Used to activate the index and vertex buffers so that they
 			will be rendered by the deviceContext.
 
-Args:		ID3D11DeviceContext* deviceContext
+Args:		RenderContext* deviceContext
 				The device context to prepare the buffers for rendering on.
 
 Modifies:	[none].
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-void ModelClass::RenderBuffers(ID3D11DeviceContext* deviceContext)
+void ModelClass::RenderBuffers(RenderContext* deviceContext)
 {
 	unsigned int stride;
 	unsigned int offset;
@@ -485,6 +665,28 @@ void ModelClass::ReleaseTexture()
 	return;
 }
 
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		LoadMeshData
+
+Summary:	Loads the Model data from a .txt file along with everything
+				built from it: the bounding box and triangle hierarchy.
+			Shared by every Initialize, so a streamed model builds them on
+				the loader's worker thread.
+
+Args:		char* filename
+				a filepath to the .txt file containing the model's
+				vertex data.
+
+Modifies:	[m_vertexCount, m_indexCount, m_model, m_min, m_max, m_AABB, m_BVH].
+
+Returns:	bool
+				was the model data loaded and everything built from it.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool ModelClass::LoadMeshData(char* filename)
+{
+	return LoadModel(filename) && SetupBoundingBox() && SetupBVH();
+}
+
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
 Method:		LoadModel
 
@@ -709,4 +911,41 @@ void ModelClass::ReleaseBoundingBox()
 		delete m_AABB;
 		m_AABB = 0;
 	}
-}
\ No newline at end of file
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		SetupBVH
+
+Summary:	Builds a hierarchy over the triangles of the loaded model data,
+				so a ray can find exactly which triangle it hits.
+
+Modifies:	[m_BVH].
+
+Returns:	bool
+				was the creation of the hierarchy successful.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+bool ModelClass::SetupBVH()
+{
+	//Create a new hierarchy.
+	m_BVH = new MeshBVHClass;
+
+	//Build it over the positions of every vertex, three to a triangle.
+	return m_BVH->Initialize(&m_model[0].x, sizeof(ModelType), m_vertexCount);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		ReleaseBVH
+
+Summary:	Shuts down, deletes and de-points the triangle hierarchy.
+
+Modifies:	[m_BVH].
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+void ModelClass::ReleaseBVH()
+{
+	if (m_BVH)
+	{
+		m_BVH->Shutdown();
+		delete m_BVH;
+		m_BVH = 0;
+	}
+}
@@ -19,6 +19,10 @@
 //				User defined headers.
 //===========================================
 #include "textureclass.h"
+#include "AssetLoaderClass.h"
+#include "TextureAtlasClass.h"
+#include "RenderContext.h"
+#include "MeshBVHClass.h"
 
 //===========================================
 //					Namespaces.
@@ -47,14 +51,24 @@ Methods:	==================== PUBLIC ====================
 			~ModelClass();
 				Deconstructor.
 
-			Initialize(ID3D11Device* BoundingBox*)
+			Initialize(ID3D11Device* BoundingBox*, TextureAtlasClass*)
 				Call after creating to set up a ModelClass using a boundingBox.
+				Samples the "blue" region of the atlas if one is given.
 			Initialize(ID3D11Device*, char*, WCHAR*);
 				Call after creating to setup Model Class for use.
+			Initialize(char*)
+				Call after creating to load only the vertex data and bounds,
+				with no buffers or texture, for running without a device.
+				The model reports IsReady() but must never be rendered.
+			InitializeAsync(AssetLoaderClass*, char*, WCHAR*, TextureStreamerClass*)
+				Call after creating to stream the Model Class in on the loader's
+				worker threads instead. The model is not drawable until IsReady().
+				If a TextureStreamerClass is given the texture's mips are streamed
+				by it.
 			Shutdown();
 				Call when finished using to tear down the object.
 
-			Render(ID3D11DeviceContext*)
+			Render(RenderContext*)
 				Call during the rendering loop to draw this model to the screen.
 
 			GetIndexCount();
@@ -64,13 +78,22 @@ Methods:	==================== PUBLIC ====================
 				as a resource.
 			GetAABB()
 				a utility function to return the Bounding box used for this model.
+			GetBVH()
+				a utility function to return the triangle hierarchy of this model,
+				or 0 if it has none.
+			IsReady()
+				a utility function to return whether the buffers and texture of
+				this model have been created.
+			RequestTextureSize(float)
+				Use while rendering to tell a streamed texture how large the
+				model is on screen, in pixels.
 
 			==================== PRIVATE ====================
 			InitializeBuffers(ID3D11Device*)
 				Called by Initialize() to initialize the index and vertex buffer in memory.
 			ShutdownBuffers()
 				Called by Shutdown() to clear the vertex and index buffers from memory.
-			RenderBuffers(ID3D11DeviceContext)
+			RenderBuffers(RenderContext)
 				Called by Render to activate the vertex and index buffer for rendering.
 
 			LoadTexture(ID3D11Device*, WCHAR*)
@@ -79,8 +102,11 @@ Methods:	==================== PUBLIC ====================
 			ReleaseTexture()
 				Called on Shutdown() to release the texture object from memory.
 
+			LoadMeshData(char*)
+				Called by Initialize() and InitializeAsync() to load the vertex data of
+				the specified model and build its bounding box and triangle hierarchy.
 			LoadModel(char*)
-				Called by Initialize() to create and initialize a ModelType array for
+				Called by LoadMeshData() to create and initialize a ModelType array for
 				the vertex data of the specified model. Also calculates the min and max
 				points of the model.
 			LoadModel(vector<XMFLOAT3*>*)
@@ -91,11 +117,17 @@ Methods:	==================== PUBLIC ====================
 				points from memory.
 
 			SetupBoundingBox()
-				Called by Initialize() to create a bounding box structure from the
+				Called by LoadMeshData() to create a bounding box structure from the
 				precalculated min and max points of the model.
 			ReleaseBoundingBox()
 				Called by Shutdown() to release the bounding box from memory.
 
+			SetupBVH()
+				Called by LoadMeshData() to build a triangle hierarchy for picking
+				from the loaded model data.
+			ReleaseBVH()
+				Called by Shutdown() to release the triangle hierarchy from memory.
+
 Members:	==================== PRIVATE ====================
 			ID3D11Buffer *m_vertexBuffer
 				a Buffer object to store the vertices of the model in memory.
@@ -116,12 +148,19 @@ Members:	==================== PRIVATE ====================
 			BoundingBox* m_AABB
 				a BoundingBox object representing the collision data of this model.
 
+			MeshBVHClass* m_BVH
+				a hierarchy over the triangles of this model, in model space, for
+				finding exactly where a ray hits it.
+
 			XMFLOAT3* m_min
 				a pointer to an XMFLOAT3 object to be used to store the minimum
 				point of the model.
 			XMFLOAT3* m_max
 				a pointer to an XMFLOAT3 object to be used to store the maximum
 				point of the model.
+
+			bool m_ready
+				whether the buffers and texture of this model have been created.
 C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
 class ModelClass
 {
@@ -145,25 +184,31 @@ public:
 	ModelClass(const ModelClass&);
 	~ModelClass();
 
-	bool Initialize(ID3D11Device*, BoundingBox*);
+	bool Initialize(ID3D11Device*, BoundingBox*, TextureAtlasClass*);
 	bool Initialize(ID3D11Device*, char*, WCHAR*);
+	bool Initialize(char*);
+	AssetLoaderClass::AssetHandle InitializeAsync(AssetLoaderClass*, char*, WCHAR*, TextureStreamerClass* = 0);
 	void Shutdown();
 
-	void Render(ID3D11DeviceContext*);
+	void Render(RenderContext*);
 
 	int GetIndexCount();
 	ID3D11ShaderResourceView* GetTexture();
 	BoundingBox* GetAABB();
+	MeshBVHClass* GetBVH();
+	bool IsReady();
+	void RequestTextureSize(float);
 
 
 private:
 	bool InitializeBuffers(ID3D11Device*);
 	void ShutdownBuffers();
-	void RenderBuffers(ID3D11DeviceContext*);
+	void RenderBuffers(RenderContext*);
 
 	bool LoadTexture(ID3D11Device*, WCHAR*);
 	void ReleaseTexture();
 
+	bool LoadMeshData(char*);
 	bool LoadModel(char*);
 	bool LoadModel(std::vector<XMFLOAT3*>*);
 	void ReleaseModel();
@@ -173,6 +218,9 @@ private:
 	bool SetupBoundingBox();
 	void ReleaseBoundingBox();
 
+	bool SetupBVH();
+	void ReleaseBVH();
+
 
 
 private:
@@ -186,6 +234,10 @@ private:
 
 	BoundingBox* m_AABB;
 
+	MeshBVHClass* m_BVH;
+
+	bool m_ready;
+
 public:
 	XMFLOAT3* m_min;
 	XMFLOAT3* m_max;
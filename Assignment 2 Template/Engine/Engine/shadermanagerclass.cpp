@@ -92,6 +92,38 @@ bool ShaderManagerClass::Initialize(ID3D11Device* device, HWND hwnd)
 }
 
 
+bool ShaderManagerClass::InitializeHeadless()
+{
+	// Create the shader objects without compiling them. Their shaders and buffers stay
+	// null, which a headless D3DClass's recorder takes in place of real ones.
+	m_TextureShader = new TextureShaderClass;
+	if(!m_TextureShader)
+	{
+		return false;
+	}
+
+	m_LightShader = new LightShaderClass;
+	if(!m_LightShader)
+	{
+		return false;
+	}
+
+	m_BumpMapShader = new BumpMapShaderClass;
+	if(!m_BumpMapShader)
+	{
+		return false;
+	}
+
+	m_FireShader = new FireShaderClass;
+	if(!m_FireShader)
+	{
+		return false;
+	}
+
+	return true;
+}
+
+
 void ShaderManagerClass::Shutdown()
 {
 	// Release the bump map shader object.
@@ -130,14 +162,14 @@ void ShaderManagerClass::Shutdown()
 }
 
 
-bool ShaderManagerClass::RenderTextureShader(ID3D11DeviceContext* device, int indexCount, const XMMATRIX &worldMatrix, const XMMATRIX &viewMatrix, const XMMATRIX &projectionMatrix,
+bool ShaderManagerClass::RenderTextureShader(RenderContext* device, int indexCount, const XMMATRIX &worldMatrix, const XMMATRIX &viewProjectionMatrix,
 											 ID3D11ShaderResourceView* texture)
 {
 	bool result;
 
 
 	// Render the model using the texture shader.
-	result = m_TextureShader->Render(device, indexCount, worldMatrix, viewMatrix, projectionMatrix, texture);
+	result = m_TextureShader->Render(device, indexCount, worldMatrix, viewProjectionMatrix, texture);
 	if(!result)
 	{
 		return false;
@@ -147,7 +179,7 @@ bool ShaderManagerClass::RenderTextureShader(ID3D11DeviceContext* device, int in
 }
 
 
-bool ShaderManagerClass::RenderLightShader(ID3D11DeviceContext* deviceContext, int indexCount, const XMMATRIX &worldMatrix, const XMMATRIX &viewMatrix, const XMMATRIX &projectionMatrix,
+bool ShaderManagerClass::RenderLightShader(RenderContext* deviceContext, int indexCount, const XMMATRIX &worldMatrix, const XMMATRIX &viewProjectionMatrix,
 	ID3D11ShaderResourceView* texture, XMFLOAT3 lightDirection, XMFLOAT4 ambient, XMFLOAT4 diffuse,
 	XMFLOAT3 cameraPosition, XMFLOAT4 specular, float specularPower)
 {
@@ -155,7 +187,7 @@ bool ShaderManagerClass::RenderLightShader(ID3D11DeviceContext* deviceContext, i
 
 
 	// Render the model using the light shader.
-	result = m_LightShader->Render(deviceContext, indexCount, worldMatrix, viewMatrix, projectionMatrix, texture, lightDirection, ambient, diffuse, cameraPosition, 
+	result = m_LightShader->Render(deviceContext, indexCount, worldMatrix, viewProjectionMatrix, texture, lightDirection, ambient, diffuse, cameraPosition, 
 								   specular, specularPower);
 	if(!result)
 	{
@@ -166,7 +198,7 @@ bool ShaderManagerClass::RenderLightShader(ID3D11DeviceContext* deviceContext, i
 }
 
 
-bool ShaderManagerClass::RenderBumpMapShader(ID3D11DeviceContext* deviceContext, int indexCount, const XMMATRIX &worldMatrix, const XMMATRIX &viewMatrix, const XMMATRIX &projectionMatrix,
+bool ShaderManagerClass::RenderBumpMapShader(RenderContext* deviceContext, int indexCount, const XMMATRIX &worldMatrix, const XMMATRIX &viewProjectionMatrix,
 	ID3D11ShaderResourceView* colorTexture, ID3D11ShaderResourceView* normalTexture, XMFLOAT3 lightDirection,
 											 XMFLOAT4 diffuse)
 {
@@ -174,7 +206,7 @@ bool ShaderManagerClass::RenderBumpMapShader(ID3D11DeviceContext* deviceContext,
 
 
 	// Render the model using the bump map shader.
-	result = m_BumpMapShader->Render(deviceContext, indexCount, worldMatrix, viewMatrix, projectionMatrix, colorTexture, normalTexture, lightDirection, diffuse);
+	result = m_BumpMapShader->Render(deviceContext, indexCount, worldMatrix, viewProjectionMatrix, colorTexture, normalTexture, lightDirection, diffuse);
 	if(!result)
 	{
 		return false;
@@ -183,8 +215,8 @@ bool ShaderManagerClass::RenderBumpMapShader(ID3D11DeviceContext* deviceContext,
 	return true;
 }
 
-bool ShaderManagerClass::RenderFireShader(ID3D11DeviceContext* deviceContext, int indexCount, const XMMATRIX& worldMatrix, const XMMATRIX& viewMatrix,
-	const XMMATRIX& projectionMatrix, ID3D11ShaderResourceView* fireTexture,
+bool ShaderManagerClass::RenderFireShader(RenderContext* deviceContext, int indexCount, const XMMATRIX& worldMatrix, const XMMATRIX& viewProjectionMatrix,
+	ID3D11ShaderResourceView* fireTexture,
 	ID3D11ShaderResourceView* noiseTexture, ID3D11ShaderResourceView* alphaTexture, float frameTime,
 	XMFLOAT3 scrollSpeeds, XMFLOAT3 scales, XMFLOAT2 distortion1, XMFLOAT2 distortion2,
 	XMFLOAT2 distortion3, float distortionScale, float distortionBias)
@@ -193,7 +225,7 @@ bool ShaderManagerClass::RenderFireShader(ID3D11DeviceContext* deviceContext, in
 
 
 	// Render the model using the fire shader.
-	result = m_FireShader->Render(deviceContext, indexCount, worldMatrix, viewMatrix, projectionMatrix, fireTexture, noiseTexture, alphaTexture, frameTime, scrollSpeeds, scales, distortion1, distortion2,
+	result = m_FireShader->Render(deviceContext, indexCount, worldMatrix, viewProjectionMatrix, fireTexture, noiseTexture, alphaTexture, frameTime, scrollSpeeds, scales, distortion1, distortion2,
 		distortion3, distortionScale, distortionBias);
 
 	if (!result)
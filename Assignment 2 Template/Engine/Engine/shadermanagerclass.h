@@ -26,17 +26,18 @@ public:
 	~ShaderManagerClass();
 
 	bool Initialize(ID3D11Device*, HWND);
+	bool InitializeHeadless();
 	void Shutdown();
 
-	bool RenderTextureShader(ID3D11DeviceContext*, int, const XMMATRIX&, const XMMATRIX&, const XMMATRIX&, ID3D11ShaderResourceView*);
+	bool RenderTextureShader(RenderContext*, int, const XMMATRIX&, const XMMATRIX&, ID3D11ShaderResourceView*);
 
-	bool RenderLightShader(ID3D11DeviceContext*, int, const XMMATRIX&, const XMMATRIX&, const XMMATRIX&, ID3D11ShaderResourceView*,
+	bool RenderLightShader(RenderContext*, int, const XMMATRIX&, const XMMATRIX&, ID3D11ShaderResourceView*,
 		XMFLOAT3, XMFLOAT4, XMFLOAT4, XMFLOAT3, XMFLOAT4, float);
 
-	bool RenderBumpMapShader(ID3D11DeviceContext*, int, const XMMATRIX&, const XMMATRIX&, const XMMATRIX&, ID3D11ShaderResourceView*,
+	bool RenderBumpMapShader(RenderContext*, int, const XMMATRIX&, const XMMATRIX&, ID3D11ShaderResourceView*,
 		ID3D11ShaderResourceView*, XMFLOAT3, XMFLOAT4);
 
-	bool RenderFireShader(ID3D11DeviceContext*, int, const XMMATRIX&, const XMMATRIX&, const XMMATRIX&, ID3D11ShaderResourceView*, ID3D11ShaderResourceView*,
+	bool RenderFireShader(RenderContext*, int, const XMMATRIX&, const XMMATRIX&, ID3D11ShaderResourceView*, ID3D11ShaderResourceView*,
 		ID3D11ShaderResourceView*, float, XMFLOAT3, XMFLOAT3, XMFLOAT2, XMFLOAT2, XMFLOAT2, float, float);
 
 private:
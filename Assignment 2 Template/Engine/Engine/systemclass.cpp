@@ -79,6 +79,9 @@ void SystemClass::Shutdown()
 		m_Input = 0;
 	}
 
+	// Release the profiler buffers now no other thread is running.
+	ProfilerClass::Shutdown();
+
 	// Shutdown the window.
 	ShutdownWindows();
 
@@ -114,11 +117,20 @@ void SystemClass::Run()
 		else
 		{
 			// Otherwise do the frame processing.
-			result = Frame();
+			{
+				PROFILE_ZONE("Frame");
+				result = Frame();
+			}
 			if (!result)
 			{
 				done = true;
 			}
+
+			// Collect the profiler zones of the frame.
+			PROFILE_END_FRAME();
+
+			// Roll the frame's allocations into the per frame rates.
+			MemoryTrackerClass::EndFrame();
 		}
 
 	}
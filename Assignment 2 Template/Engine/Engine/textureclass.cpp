@@ -2,11 +2,15 @@
 // Filename: textureclass.cpp
 ////////////////////////////////////////////////////////////////////////////////
 #include "textureclass.h"
+#include "DDSFileClass.h"
 
 
 TextureClass::TextureClass()
 {
 	m_texture = 0;
+	m_file = 0;
+	m_streamer = 0;
+	m_streamHandle = -1;
 }
 
 
@@ -37,6 +41,110 @@ bool TextureClass::Initialize(ID3D11Device* device, WCHAR* filename)
 }
 
 
+bool TextureClass::LoadFileData(WCHAR* filename)
+{
+	DDSFileClass dds;
+
+
+	// Map the file rather than copy it, the texture is created straight from the view later by Initialize(ID3D11Device*).
+	m_file = new MappedFileClass;
+	if(!m_file)
+	{
+		return false;
+	}
+
+	// Check the headers and that every mip level lies inside the file while still on this thread.
+	if(!m_file->Open(filename) || dds.Parse(m_file->GetData(), m_file->GetSize()) != DDSFileClass::PARSE_OK)
+	{
+		delete m_file;
+		m_file = 0;
+		return false;
+	}
+
+	// Page the file in now so the device thread does not stall reading it from disk.
+	m_file->Prefetch();
+
+	return true;
+}
+
+
+bool TextureClass::Initialize(ID3D11Device* device)
+{
+	HRESULT result;
+
+
+	if(!m_file)
+	{
+		return false;
+	}
+
+	// Create the texture from the file mapped by LoadFileData.
+	result = CreateDDSTextureFromMemory(device, m_file->GetData(), m_file->GetSize(), NULL, &m_texture);
+
+	// The file is no longer needed once the texture has been created.
+	delete m_file;
+	m_file = 0;
+
+	if(FAILED(result))
+	{
+		return false;
+	}
+
+	return true;
+}
+
+
+bool TextureClass::Initialize(TextureStreamerClass* streamer)
+{
+	if(!m_file)
+	{
+		return false;
+	}
+
+	// Hand the file mapped by LoadFileData over to the streamer, which owns it from then on.
+	m_streamHandle = streamer->Register(m_file);
+	if(m_streamHandle < 0)
+	{
+		delete m_file;
+		m_file = 0;
+		return false;
+	}
+
+	m_file = 0;
+
+	m_streamer = streamer;
+
+	return true;
+}
+
+
+void TextureClass::RequestSize(float screenPixels)
+{
+	// Only streamed textures change with their size on screen.
+	if(m_streamer)
+	{
+		m_streamer->RequestSize(m_streamHandle, screenPixels);
+	}
+
+	return;
+}
+
+
+bool TextureClass::Initialize(ID3D11ShaderResourceView* texture)
+{
+	if(!texture)
+	{
+		return false;
+	}
+
+	// Take a reference so the texture outlives its owner until Shutdown.
+	texture->AddRef();
+	m_texture = texture;
+
+	return true;
+}
+
+
 void TextureClass::Shutdown()
 {
 	// Release the texture resource.
@@ -46,11 +154,28 @@ void TextureClass::Shutdown()
 		m_texture = 0;
 	}
 
+	// Unmap the file if the texture was never created from it.
+	if(m_file)
+	{
+		delete m_file;
+		m_file = 0;
+	}
+
+	// Streamed textures are owned by the streamer.
+	m_streamer = 0;
+	m_streamHandle = -1;
+
 	return;
 }
 
 
 ID3D11ShaderResourceView* TextureClass::GetTexture()
 {
+	if(m_streamer)
+	{
+		// The engine's streamer uploads through a D3DTextureStreamDevice.
+		return D3DTextureStreamDevice::GetView(m_streamer->GetTexture(m_streamHandle));
+	}
+
 	return m_texture;
 }
\ No newline at end of file
@@ -10,6 +10,9 @@
 //////////////
 #include <d3d11_1.h>
 #include "DDSTextureLoader.h"
+#include "MappedFileClass.h"
+#include "TextureStreamerClass.h"
+#include "D3DTextureStreamDevice.h"
 
 using namespace DirectX;
 
@@ -27,10 +30,24 @@ public:
 	bool Initialize(ID3D11Device*, WCHAR*);
 	void Shutdown();
 
+	// Split loading: map and page in the file on any thread, create the texture on the device thread.
+	bool LoadFileData(WCHAR*);
+	bool Initialize(ID3D11Device*);
+
+	// Streamed loading: hand the file mapped by LoadFileData to a texture streamer instead.
+	bool Initialize(TextureStreamerClass*);
+	void RequestSize(float);
+
+	// Shared loading: hold a reference to a texture owned elsewhere, such as a texture atlas.
+	bool Initialize(ID3D11ShaderResourceView*);
+
 	ID3D11ShaderResourceView* GetTexture();
 
 private:
 	ID3D11ShaderResourceView* m_texture;
+	MappedFileClass* m_file;
+	TextureStreamerClass* m_streamer;
+	int m_streamHandle;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,186 @@
+//======================================================
+//				Filename: AtlasPackerTests.cpp
+//
+// Tests AtlasPackerClass places every rectangle inside
+// the atlas without overlap, and fails when they can't
+// fit within the maximum size.
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "TestFramework.h"
+#include "../Engine/AtlasPackerClass.h"
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <vector>
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		IsPowerOfTwo
+
+Summary:	Returns whether a size is a power of two.
+
+Args:		int size
+				the size to check.
+
+Returns:	bool
+				is it a power of two.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static bool IsPowerOfTwo(int size)
+{
+	return size > 0 && (size & (size - 1)) == 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		CheckPacking
+
+Summary:	Checks a packed atlas is a power of two no larger than maxSize,
+			and every rectangle keeps its size, lies inside the atlas and
+			overlaps no other.
+
+Args:		const std::vector<AtlasPackerClass::Rect>& sizes
+				the rectangles given to the packer.
+			const std::vector<AtlasPackerClass::Rect>& placed
+				where the packer put them.
+			int maxSize
+				the largest atlas allowed.
+			int atlasWidth, atlasHeight
+				the size of the atlas the packer chose.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static void CheckPacking(const std::vector<AtlasPackerClass::Rect>& sizes, const std::vector<AtlasPackerClass::Rect>& placed,
+	int maxSize, int atlasWidth, int atlasHeight)
+{
+	CHECK(IsPowerOfTwo(atlasWidth));
+	CHECK(IsPowerOfTwo(atlasHeight));
+	CHECK(atlasWidth <= maxSize);
+	CHECK(atlasHeight <= maxSize);
+
+	REQUIRE(placed.size() == sizes.size());
+	for (size_t i = 0; i < placed.size(); i++)
+	{
+		const AtlasPackerClass::Rect& rect = placed[i];
+		CHECK_EQUAL(sizes[i].width, rect.width);
+		CHECK_EQUAL(sizes[i].height, rect.height);
+
+		CHECK(rect.x >= 0 && rect.y >= 0);
+		CHECK(rect.x + rect.width <= atlasWidth);
+		CHECK(rect.y + rect.height <= atlasHeight);
+
+		for (size_t j = i + 1; j < placed.size(); j++)
+		{
+			const AtlasPackerClass::Rect& other = placed[j];
+			bool separate = rect.x + rect.width <= other.x || other.x + other.width <= rect.x ||
+				rect.y + rect.height <= other.y || other.y + other.height <= rect.y;
+			CHECK(separate);
+		}
+	}
+}
+
+
+TEST(AtlasPacker_PacksMixedSizesWithoutOverlap)
+{
+	//A fixed mix of sizes, from a simple generator so it is the same every run.
+	std::vector<AtlasPackerClass::Rect> sizes;
+	unsigned int seed = 12345;
+	for (int i = 0; i < 60; i++)
+	{
+		seed = seed * 1103515245 + 12345;
+		int width = 4 + (int)((seed >> 16) % 60);
+		seed = seed * 1103515245 + 12345;
+		int height = 4 + (int)((seed >> 16) % 60);
+		sizes.push_back(AtlasPackerClass::Rect{ 0, 0, width, height });
+	}
+
+	AtlasPackerClass packer;
+	std::vector<AtlasPackerClass::Rect> placed;
+	int atlasWidth, atlasHeight;
+	REQUIRE(packer.Pack(sizes, 1024, placed, atlasWidth, atlasHeight));
+
+	CheckPacking(sizes, placed, 1024, atlasWidth, atlasHeight);
+}
+
+TEST(AtlasPacker_FillsExactFit)
+{
+	//Four quarters fill the atlas with no space left over.
+	std::vector<AtlasPackerClass::Rect> sizes(4, AtlasPackerClass::Rect{ 0, 0, 64, 64 });
+
+	AtlasPackerClass packer;
+	std::vector<AtlasPackerClass::Rect> placed;
+	int atlasWidth, atlasHeight;
+	REQUIRE(packer.Pack(sizes, 128, placed, atlasWidth, atlasHeight));
+
+	CHECK_EQUAL(128, atlasWidth);
+	CHECK_EQUAL(128, atlasHeight);
+	CheckPacking(sizes, placed, 128, atlasWidth, atlasHeight);
+}
+
+TEST(AtlasPacker_IsDeterministic)
+{
+	std::vector<AtlasPackerClass::Rect> sizes;
+	sizes.push_back(AtlasPackerClass::Rect{ 0, 0, 32, 16 });
+	sizes.push_back(AtlasPackerClass::Rect{ 0, 0, 16, 32 });
+	sizes.push_back(AtlasPackerClass::Rect{ 0, 0, 32, 16 });
+	sizes.push_back(AtlasPackerClass::Rect{ 0, 0, 8, 8 });
+
+	AtlasPackerClass first, second;
+	std::vector<AtlasPackerClass::Rect> placedFirst, placedSecond;
+	int widthFirst, heightFirst, widthSecond, heightSecond;
+	REQUIRE(first.Pack(sizes, 256, placedFirst, widthFirst, heightFirst));
+	REQUIRE(second.Pack(sizes, 256, placedSecond, widthSecond, heightSecond));
+
+	CHECK_EQUAL(widthFirst, widthSecond);
+	CHECK_EQUAL(heightFirst, heightSecond);
+	for (size_t i = 0; i < sizes.size(); i++)
+	{
+		CHECK_EQUAL(placedFirst[i].x, placedSecond[i].x);
+		CHECK_EQUAL(placedFirst[i].y, placedSecond[i].y);
+	}
+}
+
+TEST(AtlasPacker_FailsOnItemWiderThanMax)
+{
+	std::vector<AtlasPackerClass::Rect> sizes;
+	sizes.push_back(AtlasPackerClass::Rect{ 0, 0, 16, 16 });
+	sizes.push_back(AtlasPackerClass::Rect{ 0, 0, 257, 8 });
+
+	AtlasPackerClass packer;
+	std::vector<AtlasPackerClass::Rect> placed;
+	int atlasWidth, atlasHeight;
+	CHECK(!packer.Pack(sizes, 256, placed, atlasWidth, atlasHeight));
+}
+
+TEST(AtlasPacker_FailsOnItemTallerThanMax)
+{
+	std::vector<AtlasPackerClass::Rect> sizes(1, AtlasPackerClass::Rect{ 0, 0, 8, 257 });
+
+	AtlasPackerClass packer;
+	std::vector<AtlasPackerClass::Rect> placed;
+	int atlasWidth, atlasHeight;
+	CHECK(!packer.Pack(sizes, 256, placed, atlasWidth, atlasHeight));
+}
+
+TEST(AtlasPacker_FailsWhenItemsOverfillMax)
+{
+	//Each fits alone, but five quarters can't share one atlas.
+	std::vector<AtlasPackerClass::Rect> sizes(5, AtlasPackerClass::Rect{ 0, 0, 64, 64 });
+
+	AtlasPackerClass packer;
+	std::vector<AtlasPackerClass::Rect> placed;
+	int atlasWidth, atlasHeight;
+	CHECK(!packer.Pack(sizes, 128, placed, atlasWidth, atlasHeight));
+}
+
+TEST(AtlasPacker_FailsOnEmptyItem)
+{
+	std::vector<AtlasPackerClass::Rect> sizes(1, AtlasPackerClass::Rect{ 0, 0, 0, 16 });
+
+	AtlasPackerClass packer;
+	std::vector<AtlasPackerClass::Rect> placed;
+	int atlasWidth, atlasHeight;
+	CHECK(!packer.Pack(sizes, 256, placed, atlasWidth, atlasHeight));
+}
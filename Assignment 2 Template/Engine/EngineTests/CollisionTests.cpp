@@ -0,0 +1,244 @@
+//======================================================
+//				Filename: CollisionTests.cpp
+//
+// Tests the oriented box checks on pairs of rotated
+// cubes whose AABBs all overlap: boxes just touching
+// and just apart, boxes apart only along the cross of
+// two of their edges, and boxes inside one another.
+// Each pair is checked with CollisionClass directly and
+// through a GameObjectManager step, which must count a
+// hit or an OBB rejection for it. Objects whose model
+// has not streamed in yet must be skipped by both the
+// step and rays, rather than tested as a unit box.
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "TestFramework.h"
+#include "../Engine/modelclass.h"
+#include "../Engine/CollisionClass.h"
+#include "../Engine/GameObjectManager.h"
+#include "../Engine/TextureGameObject.h"
+#include "../Engine/ProjectileObject.h"
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <math.h>
+
+
+//======================================================
+//					Constants.
+//======================================================
+//The cube spans -1 to 1, projectiles are spawned at half that size.
+const float COLLISION_TEST_TARGET_HALF = 1.0f;
+const float COLLISION_TEST_PROJECTILE_HALF = 0.5f;
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Degrees
+
+Summary:	Converts an angle to the radians the game objects are turned by.
+
+Args:		float degrees
+				the angle, in degrees.
+
+Returns:	float
+				the angle, in radians.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static float Degrees(float degrees)
+{
+	return XMConvertToRadians(degrees);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		AlongYaw
+
+Summary:	Returns a point a distance along +z once turned about y.
+
+Args:		float distance
+				how far the point is from the origin.
+			float yaw
+				the turn about y, in radians.
+
+Returns:	XMFLOAT3
+				the point.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static XMFLOAT3 AlongYaw(float distance, float yaw)
+{
+	return XMFLOAT3(distance * sinf(yaw), 0.0f, distance * cosf(yaw));
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		CheckPair
+
+Summary:	Places a rotated cube at the origin and a rotated projectile
+			near it, runs one step of a GameObjectManager over them, then
+			checks the pair's AABBs overlap, whether its OBBs do, and that
+			the step counted either a hit or an OBB rejection to match.
+
+Args:		XMFLOAT3 targetRotation
+				the pitch, yaw and roll of the cube, in radians.
+			float targetScale
+				the scale of the cube.
+			XMFLOAT3 projectilePosition
+				where the projectile is.
+			XMFLOAT3 projectileRotation
+				the pitch, yaw and roll of the projectile, in radians.
+			GameObjectManager::CollisionMode collisionMode
+				the mode to run the step in.
+			bool expectOBBHit
+				should the oriented boxes overlap.
+			bool expectHit
+				should the step count a hit.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static void CheckPair(XMFLOAT3 targetRotation, float targetScale, XMFLOAT3 projectilePosition, XMFLOAT3 projectileRotation,
+	GameObjectManager::CollisionMode collisionMode, bool expectOBBHit, bool expectHit)
+{
+	ModelClass cube;
+	REQUIRE(cube.Initialize("../Engine/data/cube.txt"));
+
+	GameObjectManager* manager = new GameObjectManager;
+	manager->SetCollisionMode(collisionMode);
+
+	XMFLOAT3 origin(0.0f, 0.0f, 0.0f);
+	XMFLOAT3 scale(targetScale, targetScale, targetScale);
+	TextureGameObject* target = new TextureGameObject(&cube);
+	manager->AddItem(GameObjectManager::OBJECTTYPE_STATIC, target, &origin, &targetRotation, &scale);
+
+	XMFLOAT4 orientation;
+	XMStoreFloat4(&orientation, XMQuaternionRotationRollPitchYaw(projectileRotation.x, projectileRotation.y, projectileRotation.z));
+	ProjectileObject* projectile = new ProjectileObject(&cube);
+	manager->AddProjectile(projectile, &projectilePosition, &orientation);
+
+	//Nothing moves, so the step only places the boxes and tests them.
+	manager->BeginStep();
+	manager->Update(0.0f);
+
+	int hits = 0, culls = 0;
+	manager->TakeScoreEvents(hits, culls);
+
+	//Both are rotated, so the OBBs are tested against each other.
+	CHECK(target->GetOBB() != 0);
+	CHECK(projectile->GetOBB() != 0);
+	CHECK(CollisionClass::Intersects(projectile->GetAABB(), target->GetAABB()));
+	CHECK_EQUAL(expectOBBHit, CollisionClass::Intersects(projectile, target));
+
+	CHECK_EQUAL(expectHit ? 1 : 0, hits);
+	CHECK_EQUAL(0, culls);
+	CHECK_EQUAL(1LL, manager->GetCollisionChecks());
+	CHECK_EQUAL(expectHit ? 0LL : 1LL, manager->GetOBBRejections());
+
+	//The manager doesn't own the objects, take back any it didn't remove.
+	manager->GetList(GameObjectManager::OBJECTTYPE_STATIC)->clear();
+	manager->GetProjectileList()->clear();
+	manager->Shutdown();
+	delete manager;
+
+	delete target;
+	delete projectile;
+	cube.Shutdown();
+}
+
+
+TEST(Collision_FacesTouching)
+{
+	//Both turned 45 degrees, so a face of each points along the diagonal. Lined
+	//up on it they meet face to face, while their AABBs overlap far more.
+	XMFLOAT3 rotation(0.0f, Degrees(45.0f), 0.0f);
+	float touching = COLLISION_TEST_TARGET_HALF + COLLISION_TEST_PROJECTILE_HALF;
+
+	CheckPair(rotation, 1.0f, AlongYaw(touching - 0.01f, Degrees(45.0f)), rotation, GameObjectManager::COLLISIONMODE_OBB, true, true);
+	CheckPair(rotation, 1.0f, AlongYaw(touching + 0.01f, Degrees(45.0f)), rotation, GameObjectManager::COLLISIONMODE_OBB, false, false);
+}
+
+TEST(Collision_SeparatedOnEdgeCrossAxis)
+{
+	//The cube is turned 75 degrees about y, the projectile is pitched 45 and
+	//turned 30, and sits along its own turn. No face of either box keeps them
+	//apart, only the cross of the cube's y edge and the projectile's x edge,
+	//which they are apart on by the gap beyond where those edges meet.
+	XMFLOAT3 targetRotation(0.0f, Degrees(75.0f), 0.0f);
+	XMFLOAT3 projectileRotation(Degrees(45.0f), Degrees(30.0f), 0.0f);
+	float edgesMeet = (COLLISION_TEST_TARGET_HALF + COLLISION_TEST_PROJECTILE_HALF) * sqrtf(2.0f);
+
+	CheckPair(targetRotation, 1.0f, AlongYaw(edgesMeet + 0.1f, Degrees(30.0f)), projectileRotation,
+		GameObjectManager::COLLISIONMODE_OBB, false, false);
+	CheckPair(targetRotation, 1.0f, AlongYaw(edgesMeet - 0.1f, Degrees(30.0f)), projectileRotation,
+		GameObjectManager::COLLISIONMODE_OBB, true, true);
+}
+
+TEST(Collision_SeparatedPairHitsInAABBMode)
+{
+	//Without the OBB test the same pair is a hit, and nothing is rejected.
+	XMFLOAT3 targetRotation(0.0f, Degrees(75.0f), 0.0f);
+	XMFLOAT3 projectileRotation(Degrees(45.0f), Degrees(30.0f), 0.0f);
+	float edgesMeet = (COLLISION_TEST_TARGET_HALF + COLLISION_TEST_PROJECTILE_HALF) * sqrtf(2.0f);
+
+	CheckPair(targetRotation, 1.0f, AlongYaw(edgesMeet + 0.1f, Degrees(30.0f)), projectileRotation,
+		GameObjectManager::COLLISIONMODE_AABB, false, true);
+}
+
+TEST(Collision_Nested)
+{
+	//The projectile inside the cube, then a small cube inside the projectile.
+	//Neither box has a face outside the other for the test to find.
+	XMFLOAT3 targetRotation(0.0f, Degrees(75.0f), 0.0f);
+	XMFLOAT3 projectileRotation(Degrees(20.0f), Degrees(40.0f), Degrees(10.0f));
+	XMFLOAT3 inside(0.05f, -0.05f, 0.02f);
+
+	CheckPair(targetRotation, 1.0f, inside, projectileRotation, GameObjectManager::COLLISIONMODE_OBB, true, true);
+	CheckPair(targetRotation, 0.2f, inside, projectileRotation, GameObjectManager::COLLISIONMODE_OBB, true, true);
+}
+
+TEST(Collision_SkipsObjectsStillLoading)
+{
+	//A model that was never loaded leaves its object with placeholder bounds.
+	ModelClass loading;
+	ModelClass cube;
+	REQUIRE(cube.Initialize("../Engine/data/cube.txt"));
+
+	GameObjectManager* manager = new GameObjectManager;
+	XMFLOAT3 origin(0.0f, 0.0f, 0.0f);
+	XMFLOAT3 scale(1.0f, 1.0f, 1.0f);
+	TextureGameObject* target = new TextureGameObject(&loading);
+	manager->AddItem(GameObjectManager::OBJECTTYPE_DYNAMIC, target, &origin, &origin, &scale);
+	CHECK(!target->HasBounds());
+
+	//A ray straight through the placeholder box hits nothing.
+	CollisionClass::Ray ray;
+	ray.origin = XMFLOAT3(0.0f, 0.0f, -5.0f);
+	ray.direction = XMFLOAT3(0.0f, 0.0f, 1.0f);
+	ray.maxDistance = 100.0f;
+	CollisionClass::RayHit hit;
+	CHECK(!CollisionClass::RayClosestHit(ray, manager, hit));
+	CHECK(!CollisionClass::RayAnyHit(ray, manager));
+	CollisionClass::RayClosestHit(&ray, 1, manager, &hit);
+	CHECK(hit.object == nullptr);
+
+	//Nor does a projectile sat inside it, and the pair is never tested.
+	XMFLOAT4 orientation(0.0f, 0.0f, 0.0f, 1.0f);
+	ProjectileObject* projectile = new ProjectileObject(&cube);
+	manager->AddProjectile(projectile, &origin, &orientation);
+
+	manager->BeginStep();
+	manager->Update(0.0f);
+
+	int hits = 0, culls = 0;
+	manager->TakeScoreEvents(hits, culls);
+	CHECK_EQUAL(0, hits);
+	CHECK_EQUAL(0LL, manager->GetCollisionChecks());
+	CHECK_EQUAL(1, (int)manager->GetList(GameObjectManager::OBJECTTYPE_DYNAMIC)->size());
+
+	manager->GetList(GameObjectManager::OBJECTTYPE_DYNAMIC)->clear();
+	manager->GetProjectileList()->clear();
+	manager->Shutdown();
+	delete manager;
+
+	delete target;
+	delete projectile;
+	cube.Shutdown();
+}
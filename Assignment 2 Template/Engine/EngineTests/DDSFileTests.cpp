@@ -0,0 +1,167 @@
+//======================================================
+//				Filename: DDSFileTests.cpp
+//
+// Tests DDSFileClass against the .dds files bundled
+// with the engine and against files of known layout.
+// Only the parser is used, so these build on any OS.
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "TestFramework.h"
+#include "TestData.h"
+
+
+//======================================================
+//					Constants.
+//======================================================
+const size_t DDS_HEADERS_SIZE = sizeof(uint32_t) + sizeof(DDS_HEADER);
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		CheckBundledTexture
+
+Summary:	Checks a bundled texture parses as the 512x512 single mip
+			B8G8R8A8_UNORM 2D texture the engine ships, with its pixels
+			straight after the headers.
+
+Args:		const char* filename
+				a filepath to the texture.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static void CheckBundledTexture(const char* filename)
+{
+	std::vector<uint8_t> data;
+	REQUIRE(ReadTestFile(filename, data));
+
+	DDSFileClass dds;
+	REQUIRE(dds.Parse(&data[0], data.size()) == DDSFileClass::PARSE_OK);
+
+	CHECK_EQUAL(DXGI_FORMAT_B8G8R8A8_UNORM, dds.GetFormat());
+	CHECK_EQUAL(DDSFileClass::DIMENSION_TEXTURE2D, dds.GetDimension());
+	CHECK_EQUAL(512u, dds.GetWidth());
+	CHECK_EQUAL(512u, dds.GetHeight());
+	CHECK_EQUAL(1u, dds.GetDepth());
+	CHECK_EQUAL(1u, dds.GetMipCount());
+	CHECK_EQUAL(1u, dds.GetArraySize());
+	CHECK(!dds.IsCubeMap());
+
+	const DDSFileClass::Surface& surface = dds.GetSurface(0, 0);
+	CHECK_EQUAL(DDS_HEADERS_SIZE, surface.offset);
+	CHECK_EQUAL(512u * 512u * 4u, surface.size);
+	CHECK_EQUAL(512u * 4u, surface.rowPitch);
+	CHECK_EQUAL(surface.offset + surface.size, data.size());
+	CHECK(dds.GetSurfaceData(0, 0) == &data[DDS_HEADERS_SIZE]);
+	CHECK_EQUAL(surface.size, dds.GetMipBytes(0));
+}
+
+
+TEST(DDSFile_ParsesMetal)
+{
+	CheckBundledTexture("../Engine/data/metal.dds");
+}
+
+TEST(DDSFile_ParsesStone)
+{
+	CheckBundledTexture("../Engine/data/stone.dds");
+}
+
+TEST(DDSFile_ParsesNormal)
+{
+	CheckBundledTexture("../Engine/data/normal.dds");
+}
+
+TEST(DDSFile_ParsesBullet)
+{
+	CheckBundledTexture("../Engine/data/bullet.dds");
+}
+
+TEST(DDSFile_RejectsBadMagic)
+{
+	std::vector<uint8_t> data = MakeTestDDS(4, 4, 1);
+	data[0] = 'X';
+
+	DDSFileClass dds;
+	CHECK_EQUAL(DDSFileClass::PARSE_NOTDDS, dds.Parse(&data[0], data.size()));
+}
+
+TEST(DDSFile_RejectsShortHeader)
+{
+	std::vector<uint8_t> data = MakeTestDDS(4, 4, 1);
+
+	DDSFileClass dds;
+	CHECK_EQUAL(DDSFileClass::PARSE_NOTDDS, dds.Parse(&data[0], DDS_HEADERS_SIZE - 1));
+}
+
+TEST(DDSFile_RejectsTruncatedBundledFile)
+{
+	std::vector<uint8_t> data;
+	REQUIRE(ReadTestFile("../Engine/data/metal.dds", data));
+
+	DDSFileClass dds;
+	CHECK_EQUAL(DDSFileClass::PARSE_TRUNCATED, dds.Parse(&data[0], data.size() - 1));
+}
+
+TEST(DDSFile_LaysOutMipChain)
+{
+	std::vector<uint8_t> data = MakeTestDDS(64, 32, 7);
+
+	DDSFileClass dds;
+	REQUIRE(dds.Parse(&data[0], data.size()) == DDSFileClass::PARSE_OK);
+	REQUIRE(dds.GetMipCount() == 7);
+
+	size_t offset = DDS_HEADERS_SIZE;
+	size_t width = 64, height = 32;
+	for (size_t mip = 0; mip < 7; mip++)
+	{
+		const DDSFileClass::Surface& surface = dds.GetSurface(0, mip);
+		CHECK_EQUAL(offset, surface.offset);
+		CHECK_EQUAL(width, surface.width);
+		CHECK_EQUAL(height, surface.height);
+		CHECK_EQUAL(width * 4, surface.rowPitch);
+		CHECK_EQUAL(width * height * 4, surface.size);
+		CHECK_EQUAL(surface.size, dds.GetMipBytes(mip));
+		CHECK_EQUAL((uint8_t)mip, *dds.GetSurfaceData(0, mip));
+
+		offset += surface.size;
+		width = width > 1 ? width / 2 : 1;
+		height = height > 1 ? height / 2 : 1;
+	}
+
+	CHECK_EQUAL(data.size(), offset);
+}
+
+TEST(DDSFile_RejectsMissingMip)
+{
+	std::vector<uint8_t> data = MakeTestDDS(64, 32, 7);
+
+	//Drop the 1x1 level.
+	DDSFileClass dds;
+	CHECK_EQUAL(DDSFileClass::PARSE_TRUNCATED, dds.Parse(&data[0], data.size() - 4));
+}
+
+TEST(DDSFile_FindsFirstMipUnderSize)
+{
+	std::vector<uint8_t> data = MakeTestDDS(64, 32, 7);
+
+	DDSFileClass dds;
+	REQUIRE(dds.Parse(&data[0], data.size()) == DDSFileClass::PARSE_OK);
+
+	CHECK_EQUAL(0u, dds.GetFirstMip(0));
+	CHECK_EQUAL(0u, dds.GetFirstMip(64));
+	CHECK_EQUAL(1u, dds.GetFirstMip(63));
+	CHECK_EQUAL(1u, dds.GetFirstMip(32));
+	CHECK_EQUAL(3u, dds.GetFirstMip(8));
+	CHECK_EQUAL(6u, dds.GetFirstMip(1));
+}
+
+TEST(DDSFile_FirstMipIgnoresSizeForSingleMip)
+{
+	std::vector<uint8_t> data = MakeTestDDS(64, 32, 1);
+
+	DDSFileClass dds;
+	REQUIRE(dds.Parse(&data[0], data.size()) == DDSFileClass::PARSE_OK);
+
+	CHECK_EQUAL(0u, dds.GetFirstMip(8));
+}
@@ -0,0 +1,242 @@
+//======================================================
+//				Filename: FrameSnapshotTests.cpp
+//
+// Tests FrameSnapshotClass pipelined on a JobSystemClass
+// the way GraphicsClass::Frame() runs it: each frame the
+// next snapshot is written by a job, split over the
+// workers, while the front one is read. Every front
+// buffer must hold exactly one whole frame.
+//
+// The test uses no Windows or D3D calls, so it can also
+// be built with ThreadSanitizer, which MSVC lacks. From
+// EngineTests, with the DirectXMath headers (and the
+// sal.h they need) on the include path:
+//
+//   clang++ -std=c++14 -g -O1 -fsanitize=thread -pthread
+//     -DENGINE_PROFILER_ENABLED=0 -I<DirectXMath>/Inc
+//     TestMain.cpp FrameSnapshotTests.cpp
+//     ../Engine/FrameSnapshotClass.cpp
+//     ../Engine/JobSystemClass.cpp -o snapshot_tsan
+//
+// and run ./snapshot_tsan. Any data race between the
+// writing jobs and the reading thread is reported there.
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "TestFramework.h"
+#include "../Engine/FrameSnapshotClass.h"
+#include "../Engine/JobSystemClass.h"
+#include "../Engine/ProfilerClass.h"
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <vector>
+
+
+//======================================================
+//					Constants.
+//======================================================
+const int SNAPSHOT_TEST_FRAMES = 2000;
+const int SNAPSHOT_TEST_BATCH = 16;
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		EntryCount
+
+Summary:	Returns how many entries the snapshot of a frame holds. It
+			changes from frame to frame so the buffers grow and shrink.
+
+Args:		int frame
+				the frame the snapshot was written for.
+
+Returns:	int
+				the number of entries.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static int EntryCount(int frame)
+{
+	return 50 + frame % 200;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		StampEntry
+
+Summary:	Fills every field of an entry with its frame and index.
+
+Args:		FrameSnapshotClass::Entry& entry
+				the entry to fill.
+			int frame
+				the frame being written.
+			int index
+				the index of the entry in the snapshot.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static void StampEntry(FrameSnapshotClass::Entry& entry, int frame, int index)
+{
+	entry.object = 0;
+	for (int row = 0; row < 4; row++)
+	{
+		for (int column = 0; column < 4; column++)
+			entry.worldMatrix.m[row][column] = (float)frame;
+	}
+	entry.bounds.Center = XMFLOAT3((float)index, (float)frame, 0.0f);
+	entry.bounds.Extents = XMFLOAT3(1.0f, 1.0f, 1.0f);
+	entry.animationTime = (float)frame;
+	entry.visible = (frame & 1) != 0;
+	entry.occluder = 0;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		CountTornEntries
+
+Summary:	Checks the front buffer of a snapshot holds exactly the frame
+			it is stamped with: the right number of entries, each in order
+			and written for that frame alone.
+
+Args:		FrameSnapshotClass& snapshot
+				the snapshot to read the front buffer of.
+
+Returns:	int
+				the number of entries, plus one for a wrong count, that do
+				not belong to the front frame.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static int CountTornEntries(FrameSnapshotClass& snapshot)
+{
+	const std::vector<FrameSnapshotClass::Entry>& front = snapshot.GetFront();
+	int frame = snapshot.GetFrontFrame();
+	int torn = 0;
+
+	if ((int)front.size() != EntryCount(frame))
+		torn++;
+
+	for (size_t i = 0; i < front.size(); i++)
+	{
+		const FrameSnapshotClass::Entry& entry = front[i];
+		bool stamped = entry.animationTime == (float)frame && entry.visible == ((frame & 1) != 0) &&
+			entry.bounds.Center.x == (float)i && entry.bounds.Center.y == (float)frame;
+
+		for (int row = 0; row < 4; row++)
+		{
+			for (int column = 0; column < 4; column++)
+				stamped = stamped && entry.worldMatrix.m[row][column] == (float)frame;
+		}
+
+		if (!stamped)
+			torn++;
+	}
+
+	return torn;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RunPipeline
+
+Summary:	Runs the snapshot pipeline for SNAPSHOT_TEST_FRAMES frames, as
+			GraphicsClass::Frame() does: wait for the last frame's job, swap
+			in its snapshot, queue the job writing the next one, then read
+			the front buffer while that job runs.
+
+Args:		int workerCount
+				the worker threads to start, as given to
+				JobSystemClass::Initialize().
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static void RunPipeline(int workerCount)
+{
+	JobSystemClass jobSystem;
+	REQUIRE(jobSystem.Initialize(workerCount));
+
+	FrameSnapshotClass snapshot;
+	JobCounter simulationCounter;
+	int torn = 0, missed = 0;
+
+	for (int frame = 1; frame <= SNAPSHOT_TEST_FRAMES; frame++)
+	{
+		//Finish the job started last frame and take its snapshot.
+		jobSystem.Wait(&simulationCounter);
+		if (!snapshot.Swap() && frame > 1)
+			missed++;
+
+		//Write the next snapshot off this thread, split over the workers.
+		jobSystem.Run([&jobSystem, &snapshot, frame]()
+		{
+			std::vector<FrameSnapshotClass::Entry>& entries = snapshot.BeginWrite(frame);
+			entries.resize(EntryCount(frame));
+
+			//ParallelFor doesn't copy the function, so it is kept until the wait.
+			JobSystemClass::RangeFunction stamp = [&entries, frame](int begin, int end)
+			{
+				for (int i = begin; i < end; i++)
+					StampEntry(entries[i], frame, i);
+			};
+
+			JobCounter counter;
+			jobSystem.ParallelFor((int)entries.size(), SNAPSHOT_TEST_BATCH, stamp, &counter);
+			jobSystem.Wait(&counter);
+
+			snapshot.EndWrite();
+		}, &simulationCounter);
+
+		//Read the last frame's snapshot while the next is written.
+		if (frame > 1)
+		{
+			if (snapshot.GetFrontFrame() != frame - 1)
+				missed++;
+			torn += CountTornEntries(snapshot);
+		}
+	}
+
+	jobSystem.Wait(&simulationCounter);
+	jobSystem.Shutdown();
+
+	//Free the profiler buffers the workers named themselves into, as the engine does on exit.
+#if ENGINE_PROFILER_ENABLED
+	ProfilerClass::Shutdown();
+#endif
+
+	CHECK_EQUAL(0, missed);
+	CHECK_EQUAL(0, torn);
+}
+
+
+TEST(FrameSnapshot_PipelinesOverWorkers)
+{
+	RunPipeline(3);
+}
+
+TEST(FrameSnapshot_PipelinesWithoutWorkers)
+{
+	//Every job runs on this thread, inside Wait().
+	RunPipeline(-1);
+}
+
+TEST(FrameSnapshot_SwapKeepsFrontUntilWriteEnds)
+{
+	FrameSnapshotClass snapshot;
+	CHECK_EQUAL(-1, snapshot.GetFrontFrame());
+	CHECK(!snapshot.Swap());
+
+	std::vector<FrameSnapshotClass::Entry>& entries = snapshot.BeginWrite(1);
+	entries.resize(EntryCount(1));
+	for (int i = 0; i < EntryCount(1); i++)
+		StampEntry(entries[i], 1, i);
+	snapshot.EndWrite();
+
+	REQUIRE(snapshot.Swap());
+	CHECK_EQUAL(1, snapshot.GetFrontFrame());
+	CHECK_EQUAL(0, CountTornEntries(snapshot));
+
+	//A write begun but not ended is not swapped in, the last frame is drawn again.
+	snapshot.BeginWrite(2).resize(EntryCount(2));
+	CHECK(!snapshot.Swap());
+	CHECK_EQUAL(1, snapshot.GetFrontFrame());
+	CHECK_EQUAL(0, CountTornEntries(snapshot));
+
+	//Nor is one already swapped in.
+	snapshot.EndWrite();
+	REQUIRE(snapshot.Swap());
+	CHECK(!snapshot.Swap());
+	CHECK_EQUAL(2, snapshot.GetFrontFrame());
+}
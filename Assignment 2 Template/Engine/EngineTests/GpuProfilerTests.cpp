@@ -0,0 +1,173 @@
+//======================================================
+//				Filename: GpuProfilerTests.cpp
+//
+// Tests GpuProfilerClass on a NullGpuTimerDevice: frame
+// times read back late and from the right query set as
+// the ring wraps, frames skipped when the GPU falls too
+// far behind, and disjoint frames thrown away.
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "TestFramework.h"
+#include "../Engine/GpuProfilerClass.h"
+
+
+//======================================================
+//					Constants.
+//======================================================
+//One timestamp every millisecond.
+const uint64_t GPU_TEST_FREQUENCY = 1000000;
+const uint64_t GPU_TEST_STEP = 1000;
+
+const int GPU_TEST_MAX_ZONES = 4;
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RunFrame
+
+Summary:	Profiles one frame with a number of passes in it. On the fake
+			clock every timestamp is a millisecond apart, so a frame with
+			n passes times at 2n + 1 ms.
+
+Args:		GpuProfilerClass& profiler
+				the profiler to run the frame on.
+			int zones
+				the passes in the frame.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static void RunFrame(GpuProfilerClass& profiler, int zones)
+{
+	profiler.BeginFrame();
+
+	for (int i = 0; i < zones; i++)
+	{
+		GpuProfileZone zone(&profiler, "GPU Test Pass");
+	}
+
+	profiler.EndFrame();
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		FrameTime
+
+Summary:	Returns the time RunFrame gives a frame with a number of passes.
+
+Args:		int zones
+				the passes in the frame.
+
+Returns:	double
+				the frame time, in ms.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static double FrameTime(int zones)
+{
+	return (double)(2 * zones + 1);
+}
+
+
+TEST(GpuProfiler_ReadsBackAfterDelay)
+{
+	NullGpuTimerDevice device(GPU_TEST_FREQUENCY, GPU_TEST_STEP, 2);
+	GpuProfilerClass profiler;
+	REQUIRE(profiler.Initialize(&device, GPU_TEST_MAX_ZONES));
+
+	//Nothing is readable until two frames have ended.
+	RunFrame(profiler, 1);
+	CHECK_EQUAL(0.0, profiler.GetLastFrameTime());
+
+	RunFrame(profiler, 2);
+	CHECK_EQUAL(FrameTime(1), profiler.GetLastFrameTime());
+
+	RunFrame(profiler, 3);
+	CHECK_EQUAL(FrameTime(2), profiler.GetLastFrameTime());
+
+	CHECK_EQUAL(0, profiler.GetSkippedFrames());
+	profiler.Shutdown();
+}
+
+TEST(GpuProfiler_WrapsRingWithoutSkipping)
+{
+	//The longest delay the three query sets can hide.
+	NullGpuTimerDevice device(GPU_TEST_FREQUENCY, GPU_TEST_STEP, 3);
+	GpuProfilerClass profiler;
+	REQUIRE(profiler.Initialize(&device, GPU_TEST_MAX_ZONES));
+
+	//Each frame reads back the one two before it, freeing its set just in time for the next frame.
+	for (int frame = 0; frame < 20; frame++)
+	{
+		RunFrame(profiler, frame % GPU_TEST_MAX_ZONES);
+
+		if (frame >= 2)
+			CHECK_EQUAL(FrameTime((frame - 2) % GPU_TEST_MAX_ZONES), profiler.GetLastFrameTime());
+	}
+
+	CHECK_EQUAL(0, profiler.GetSkippedFrames());
+	profiler.Shutdown();
+}
+
+TEST(GpuProfiler_SkipsFramesWhenGpuIsTooFarBehind)
+{
+	//Longer than the ring, so the first set is still pending when it comes round.
+	NullGpuTimerDevice device(GPU_TEST_FREQUENCY, GPU_TEST_STEP, 4);
+	GpuProfilerClass profiler;
+	REQUIRE(profiler.Initialize(&device, GPU_TEST_MAX_ZONES));
+
+	for (int frame = 0; frame < 10; frame++)
+		RunFrame(profiler, 1);
+
+	//Only the first three frames were timed, none finished.
+	CHECK_EQUAL(7, profiler.GetSkippedFrames());
+	CHECK_EQUAL(0.0, profiler.GetLastFrameTime());
+	profiler.Shutdown();
+}
+
+TEST(GpuProfiler_DropsDisjointFrames)
+{
+	NullGpuTimerDevice device(GPU_TEST_FREQUENCY, GPU_TEST_STEP, 1);
+	GpuProfilerClass profiler;
+	REQUIRE(profiler.Initialize(&device, GPU_TEST_MAX_ZONES));
+
+	RunFrame(profiler, 1);
+	CHECK_EQUAL(FrameTime(1), profiler.GetLastFrameTime());
+
+	//A disjoint frame is read back and its set reused, but its time is not kept.
+	device.SetDisjoint(true);
+	RunFrame(profiler, 3);
+	CHECK_EQUAL(FrameTime(1), profiler.GetLastFrameTime());
+
+	device.SetDisjoint(false);
+	for (int frame = 0; frame < 3; frame++)
+		RunFrame(profiler, 2);
+	CHECK_EQUAL(FrameTime(2), profiler.GetLastFrameTime());
+
+	CHECK_EQUAL(0, profiler.GetSkippedFrames());
+	profiler.Shutdown();
+}
+
+TEST(GpuProfiler_IgnoresPassesBeyondMax)
+{
+	NullGpuTimerDevice device(GPU_TEST_FREQUENCY, GPU_TEST_STEP, 1);
+	GpuProfilerClass profiler;
+	REQUIRE(profiler.Initialize(&device, 2));
+
+	//Only the first two passes issue timestamps.
+	RunFrame(profiler, 5);
+	CHECK_EQUAL(FrameTime(2), profiler.GetLastFrameTime());
+
+	profiler.Shutdown();
+}
+
+TEST(GpuProfiler_ClosesPassesLeftOpen)
+{
+	NullGpuTimerDevice device(GPU_TEST_FREQUENCY, GPU_TEST_STEP, 1);
+	GpuProfilerClass profiler;
+	REQUIRE(profiler.Initialize(&device, GPU_TEST_MAX_ZONES));
+
+	profiler.BeginFrame();
+	profiler.BeginZone("GPU Test Pass");
+	profiler.EndFrame();
+
+	CHECK_EQUAL(FrameTime(1), profiler.GetLastFrameTime());
+	profiler.Shutdown();
+}
@@ -0,0 +1,338 @@
+//======================================================
+//				Filename: HeadlessRenderTests.cpp
+//
+// Renders a small scene through a headless D3DClass and
+// checks the draws and state changes its recorder logs.
+// Needs no GPU, the shaders and buffers are all null.
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "TestFramework.h"
+#include "../Engine/d3dclass.h"
+#include "../Engine/cameraclass.h"
+#include "../Engine/modelclass.h"
+#include "../Engine/shadermanagerclass.h"
+#include "../Engine/GameObjectManager.h"
+#include "../Engine/TextureGameObject.h"
+#include "../Engine/FrameSnapshotClass.h"
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <vector>
+
+
+//======================================================
+//					Constants.
+//======================================================
+const int HEADLESS_SCREEN_WIDTH = 800;
+const int HEADLESS_SCREEN_HEIGHT = 600;
+const float HEADLESS_SCREEN_DEPTH = 1000.0f;
+const float HEADLESS_SCREEN_NEAR = 0.1f;
+
+//The unit box the AABBs are drawn with is 8 unindexed corners.
+const int HEADLESS_BOUNDS_INDICES = 8;
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		HeadlessScene
+
+Summary:	Three cubes in front of the camera and one behind it, rendered
+			by a headless D3DClass with uncompiled shaders.
+
+Methods:	==================== PUBLIC ====================
+			bool Initialize()
+				Use to set up the renderer and the scene.
+			void Shutdown()
+				Use to free everything.
+			void RenderFrame()
+				Use to snapshot the scene and render it as GraphicsClass
+				does, logging every command.
+
+Members:	==================== PUBLIC ====================
+			D3DClass* d3d
+				the headless renderer.
+			CameraClass* camera
+				the camera, at the origin looking down +z.
+			ShaderManagerClass* shaders
+				the uncompiled shaders.
+			ModelClass* cube
+				the cube model, vertex data only.
+			GameObjectManager* manager
+				the scene.
+			FrameSnapshotClass* snapshot
+				the snapshot each frame is drawn from.
+			std::vector<TextureGameObject*> objects
+				the cubes, deleted on shutdown.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class HeadlessScene
+{
+public:
+	HeadlessScene()
+	{
+		d3d = 0;
+		camera = 0;
+		shaders = 0;
+		cube = 0;
+		manager = 0;
+		snapshot = 0;
+	}
+
+	bool Initialize()
+	{
+		d3d = new D3DClass;
+		if (!d3d->InitializeHeadless(HEADLESS_SCREEN_WIDTH, HEADLESS_SCREEN_HEIGHT, HEADLESS_SCREEN_DEPTH, HEADLESS_SCREEN_NEAR))
+			return false;
+
+		camera = new CameraClass;
+		XMMATRIX projectionMatrix;
+		d3d->GetProjectionMatrix(projectionMatrix);
+		camera->SetProjectionMatrix(projectionMatrix);
+		camera->SetPosition(0.0f, 0.0f, 0.0f);
+		camera->SetRotation(0.0f, 0.0f, 0.0f);
+
+		shaders = new ShaderManagerClass;
+		if (!shaders->InitializeHeadless())
+			return false;
+
+		cube = new ModelClass;
+		if (!cube->Initialize("../Engine/data/cube.txt"))
+			return false;
+
+		manager = new GameObjectManager;
+		snapshot = new FrameSnapshotClass;
+
+		XMFLOAT3 positions[] = { XMFLOAT3(-3.0f, 0.0f, 10.0f), XMFLOAT3(0.0f, 0.0f, 10.0f), XMFLOAT3(3.0f, 0.0f, 10.0f),
+			XMFLOAT3(0.0f, 0.0f, -10.0f) };
+		XMFLOAT3 rotation(0.0f, 0.0f, 0.0f);
+		XMFLOAT3 scale(1.0f, 1.0f, 1.0f);
+		for (int i = 0; i < 4; i++)
+		{
+			TextureGameObject* object = new TextureGameObject(cube);
+			manager->AddItem(GameObjectManager::OBJECTTYPE_STATIC, object, &positions[i], &rotation, &scale);
+			objects.push_back(object);
+		}
+
+		return true;
+	}
+
+	void Shutdown()
+	{
+		if (manager)
+		{
+			manager->GetList(GameObjectManager::OBJECTTYPE_STATIC)->clear();
+			manager->Shutdown();
+			delete manager;
+			manager = 0;
+		}
+
+		for (size_t i = 0; i < objects.size(); i++)
+			delete objects[i];
+		objects.clear();
+
+		delete snapshot;
+		snapshot = 0;
+
+		if (cube)
+		{
+			cube->Shutdown();
+			delete cube;
+			cube = 0;
+		}
+
+		if (shaders)
+		{
+			shaders->Shutdown();
+			delete shaders;
+			shaders = 0;
+		}
+
+		delete camera;
+		camera = 0;
+
+		if (d3d)
+		{
+			d3d->Shutdown();
+			delete d3d;
+			d3d = 0;
+		}
+	}
+
+	void RenderFrame()
+	{
+		//Settle the bounds and snapshot the scene, as the simulation thread does.
+		manager->BeginStep();
+		manager->Update(1.0f / 60.0f);
+		manager->WriteSnapshot(1.0f, snapshot->GetFrontFrame() + 1, snapshot);
+		snapshot->Swap();
+
+		camera->Render();
+
+		//Log every command of the frame.
+		d3d->GetRenderRecorder()->SetCapturing(true);
+		d3d->BeginScene(0.0f, 0.0f, 0.0f, 1.0f);
+		manager->RenderAll(snapshot, shaders, d3d, camera, 0);
+		d3d->EndScene();
+	}
+
+public:
+	D3DClass* d3d;
+	CameraClass* camera;
+	ShaderManagerClass* shaders;
+	ModelClass* cube;
+	GameObjectManager* manager;
+	FrameSnapshotClass* snapshot;
+	std::vector<TextureGameObject*> objects;
+};
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		CountCommands
+
+Summary:	Counts the commands of one type in a recorded frame.
+
+Args:		const std::vector<RecordingRenderContext::Command>& commands
+				the recorded frame.
+			RecordingRenderContext::CommandType type
+				the type to count.
+
+Returns:	int
+				the number of commands of that type.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static int CountCommands(const std::vector<RecordingRenderContext::Command>& commands, RecordingRenderContext::CommandType type)
+{
+	int count = 0;
+
+	for (size_t i = 0; i < commands.size(); i++)
+	{
+		if (commands[i].type == type)
+			count++;
+	}
+
+	return count;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetDrawnIndices
+
+Summary:	Lists the index count of every draw in a recorded frame, in order.
+
+Args:		const std::vector<RecordingRenderContext::Command>& commands
+				the recorded frame.
+
+Returns:	std::vector<int>
+				the index count of each draw.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static std::vector<int> GetDrawnIndices(const std::vector<RecordingRenderContext::Command>& commands)
+{
+	std::vector<int> draws;
+
+	for (size_t i = 0; i < commands.size(); i++)
+	{
+		if (commands[i].type == RecordingRenderContext::COMMAND_DRAW_INDEXED)
+			draws.push_back((int)commands[i].count);
+	}
+
+	return draws;
+}
+
+
+TEST(HeadlessRender_DrawsModelsThenBoundsInFrustum)
+{
+	HeadlessScene scene;
+	REQUIRE(scene.Initialize());
+
+	scene.RenderFrame();
+
+	RecordingRenderContext* recorder = scene.d3d->GetRenderRecorder();
+	const std::vector<RecordingRenderContext::Command>& commands = recorder->GetCommands();
+	const RecordingRenderContext::FrameStats& stats = recorder->GetFrameStats();
+
+	//The frame starts by clearing the back and depth buffers.
+	REQUIRE(commands.size() >= 2);
+	CHECK_EQUAL(RecordingRenderContext::COMMAND_CLEAR_RENDER_TARGET, commands[0].type);
+	CHECK_EQUAL(RecordingRenderContext::COMMAND_CLEAR_DEPTH_STENCIL, commands[1].type);
+
+	//The three cubes in front of the camera, then their AABBs. The one behind is culled.
+	std::vector<int> draws = GetDrawnIndices(commands);
+	REQUIRE(draws.size() == 6);
+	for (int i = 0; i < 3; i++)
+	{
+		CHECK_EQUAL(scene.cube->GetIndexCount(), draws[i]);
+		CHECK_EQUAL(HEADLESS_BOUNDS_INDICES, draws[3 + i]);
+	}
+
+	CHECK_EQUAL(6, stats.drawCalls);
+	CHECK_EQUAL(3LL * scene.cube->GetIndexCount() + 3LL * HEADLESS_BOUNDS_INDICES, stats.indices);
+
+	//Every draw maps its matrices once.
+	CHECK_EQUAL(6, stats.maps);
+	CHECK_EQUAL(6, CountCommands(commands, RecordingRenderContext::COMMAND_MAP));
+	CHECK_EQUAL(6, CountCommands(commands, RecordingRenderContext::COMMAND_UNMAP));
+
+	scene.Shutdown();
+}
+
+TEST(HeadlessRender_RecordsStateChangesPerDraw)
+{
+	HeadlessScene scene;
+	REQUIRE(scene.Initialize());
+
+	scene.RenderFrame();
+
+	RecordingRenderContext* recorder = scene.d3d->GetRenderRecorder();
+	const std::vector<RecordingRenderContext::Command>& commands = recorder->GetCommands();
+	const RecordingRenderContext::FrameStats& stats = recorder->GetFrameStats();
+
+	//Each draw sets its topology, input layout and shaders.
+	CHECK_EQUAL(6, CountCommands(commands, RecordingRenderContext::COMMAND_SET_TOPOLOGY));
+	CHECK_EQUAL(6, CountCommands(commands, RecordingRenderContext::COMMAND_SET_INPUT_LAYOUT));
+	CHECK_EQUAL(6, CountCommands(commands, RecordingRenderContext::COMMAND_SET_VERTEX_SHADER));
+	CHECK_EQUAL(6, CountCommands(commands, RecordingRenderContext::COMMAND_SET_PIXEL_SHADER));
+
+	//Each AABB turns wireframe on and back off.
+	CHECK_EQUAL(6, CountCommands(commands, RecordingRenderContext::COMMAND_SET_RASTERIZER_STATE));
+	CHECK_EQUAL(6 * 4 + 6, stats.stateChanges);
+
+	//Only the AABB draws are wrapped in rasterizer state changes.
+	bool wireframe = false;
+	int wireframeDraws = 0;
+	for (size_t i = 0; i < commands.size(); i++)
+	{
+		if (commands[i].type == RecordingRenderContext::COMMAND_SET_RASTERIZER_STATE)
+			wireframe = !wireframe;
+		else if (commands[i].type == RecordingRenderContext::COMMAND_DRAW_INDEXED && wireframe)
+		{
+			CHECK_EQUAL((UINT)HEADLESS_BOUNDS_INDICES, commands[i].count);
+			wireframeDraws++;
+		}
+	}
+	CHECK(!wireframe);
+	CHECK_EQUAL(3, wireframeDraws);
+
+	//Every command counted was logged.
+	CHECK_EQUAL((int)commands.size(), stats.commands);
+
+	scene.Shutdown();
+}
+
+TEST(HeadlessRender_FollowsCamera)
+{
+	HeadlessScene scene;
+	REQUIRE(scene.Initialize());
+
+	//Turned around, only the cube that was behind the camera is drawn.
+	scene.camera->SetRotation(0.0f, 180.0f, 0.0f);
+	scene.RenderFrame();
+
+	std::vector<int> draws = GetDrawnIndices(scene.d3d->GetRenderRecorder()->GetCommands());
+	REQUIRE(draws.size() == 2);
+	CHECK_EQUAL(scene.cube->GetIndexCount(), draws[0]);
+	CHECK_EQUAL(HEADLESS_BOUNDS_INDICES, draws[1]);
+
+	scene.Shutdown();
+}
@@ -0,0 +1,44 @@
+//======================================================
+//				Filename: MappedFileTests.cpp
+//
+// Tests MappedFileClass against the .dds files bundled
+// with the engine, checking the mapped view matches a
+// copy read from disk and parses the same.
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "TestFramework.h"
+#include "TestData.h"
+#include "../Engine/MappedFileClass.h"
+
+
+TEST(MappedFile_MapsBundledTexture)
+{
+	std::vector<uint8_t> data;
+	REQUIRE(ReadTestFile("../Engine/data/stone.dds", data));
+
+	MappedFileClass file;
+	REQUIRE(file.Open(L"../Engine/data/stone.dds"));
+	REQUIRE(file.GetSize() == data.size());
+	CHECK(memcmp(file.GetData(), &data[0], data.size()) == 0);
+
+	file.Prefetch();
+
+	//The mapped view parses the same as the copy.
+	DDSFileClass dds;
+	CHECK_EQUAL(DDSFileClass::PARSE_OK, dds.Parse(file.GetData(), file.GetSize()));
+
+	file.Close();
+	CHECK(file.GetData() == 0);
+	CHECK_EQUAL(0u, file.GetSize());
+}
+
+TEST(MappedFile_FailsOnMissingFile)
+{
+	MappedFileClass file;
+	CHECK(!file.Open(L"../Engine/data/missing.dds"));
+	CHECK(file.GetData() == 0);
+}
@@ -0,0 +1,125 @@
+//======================================================
+//				Filename: MeshBVHTests.cpp
+//
+// Tests every model type builds a triangle hierarchy
+// when its vertex data is loaded, and every game object
+// type hands it out for picking once its model is ready.
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "TestFramework.h"
+#include "../Engine/modelclass.h"
+#include "../Engine/bumpmodelclass.h"
+#include "../Engine/firemodelclass.h"
+#include "../Engine/TextureGameObject.h"
+#include "../Engine/BumpMapGameObject.h"
+#include "../Engine/FireShaderGameObject.h"
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <float.h>
+#include <math.h>
+
+
+//======================================================
+//					Constants.
+//======================================================
+//The cube is 36 unindexed vertices spanning -1 to 1 on each axis.
+const int BVH_TEST_CUBE_TRIANGLES = 12;
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		CheckCubeBVH
+
+Summary:	Checks a hierarchy was built over the whole cube, and a ray
+			through it hits its near face and a ray beside it misses.
+
+Args:		MeshBVHClass* bvh
+				the hierarchy of a model loaded from cube.txt.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static void CheckCubeBVH(MeshBVHClass* bvh)
+{
+	REQUIRE(bvh != 0);
+	CHECK_EQUAL(BVH_TEST_CUBE_TRIANGLES, bvh->GetTriangleCount());
+
+	float distance = FLT_MAX;
+	CHECK(bvh->Intersects(XMVectorSet(0.25f, 0.5f, -5.0f, 1.0f), XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f), distance));
+	CHECK(fabsf(distance - 4.0f) < 1e-4f);
+
+	distance = FLT_MAX;
+	CHECK(!bvh->Intersects(XMVectorSet(1.5f, 0.0f, -5.0f, 1.0f), XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f), distance));
+}
+
+
+TEST(MeshBVH_ModelBuildsOnLoad)
+{
+	ModelClass model;
+	REQUIRE(model.Initialize("../Engine/data/cube.txt"));
+
+	CheckCubeBVH(model.GetBVH());
+
+	model.Shutdown();
+	CHECK(model.GetBVH() == 0);
+}
+
+TEST(MeshBVH_BumpModelBuildsOnLoad)
+{
+	BumpModelClass model;
+	REQUIRE(model.Initialize("../Engine/data/cube.txt"));
+
+	CheckCubeBVH(model.GetBVH());
+
+	model.Shutdown();
+	CHECK(model.GetBVH() == 0);
+}
+
+TEST(MeshBVH_FireModelBuildsOnLoad)
+{
+	FireModelClass model;
+	REQUIRE(model.Initialize("../Engine/data/cube.txt"));
+
+	CheckCubeBVH(model.GetBVH());
+
+	model.Shutdown();
+	CHECK(model.GetBVH() == 0);
+}
+
+TEST(MeshBVH_GameObjectsPickOnTheirModel)
+{
+	ModelClass model;
+	BumpModelClass bumpModel;
+	FireModelClass fireModel;
+	REQUIRE(model.Initialize("../Engine/data/cube.txt"));
+	REQUIRE(bumpModel.Initialize("../Engine/data/cube.txt"));
+	REQUIRE(fireModel.Initialize("../Engine/data/cube.txt"));
+
+	TextureGameObject textureObject(&model);
+	BumpMapGameObject bumpObject(&bumpModel);
+	FireShaderGameObject fireObject(&fireModel);
+
+	CHECK(textureObject.GetMeshBVH() == model.GetBVH());
+	CHECK(bumpObject.GetMeshBVH() == bumpModel.GetBVH());
+	CHECK(fireObject.GetMeshBVH() == fireModel.GetBVH());
+
+	model.Shutdown();
+	bumpModel.Shutdown();
+	fireModel.Shutdown();
+}
+
+TEST(MeshBVH_GameObjectsHaveNoneBeforeLoad)
+{
+	//Models that have not streamed in yet fall back to their AABB.
+	BumpModelClass bumpModel;
+	FireModelClass fireModel;
+
+	BumpMapGameObject bumpObject(&bumpModel);
+	FireShaderGameObject fireObject(&fireModel);
+
+	CHECK(bumpObject.GetMeshBVH() == 0);
+	CHECK(fireObject.GetMeshBVH() == 0);
+}
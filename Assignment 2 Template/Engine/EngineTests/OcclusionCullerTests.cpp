@@ -0,0 +1,456 @@
+//======================================================
+//				Filename: OcclusionCullerTests.cpp
+//
+// Draws the benchmark's occluded scenario, a flat roof
+// over half a grid of cubes, into an
+// OcclusionCullerClass and diffs the depth buffer
+// against golden ones saved in data/. A buffer that
+// doesn't match is saved beside the test as
+// <name>_actual.pfm, to be looked at and, if the change
+// was meant, copied over the golden one.
+// Also checks every cube culled is hidden behind the
+// roof, and that nothing is culled through a gap
+// narrower than a pixel.
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "TestFramework.h"
+#include "../Engine/OcclusionCullerClass.h"
+#include "../Engine/MeshBVHClass.h"
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <algorithm>
+#include <fstream>
+#include <math.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+
+//======================================================
+//					Constants.
+//======================================================
+//The depth buffer and camera GameObjectManager and the benchmark use.
+const int OCCLUSION_TEST_WIDTH = 256;
+const int OCCLUSION_TEST_HEIGHT = 128;
+const float OCCLUSION_TEST_ASPECT = 1280.0f / 720.0f;
+const float OCCLUSION_TEST_NEAR = 0.1f;
+const float OCCLUSION_TEST_DEPTH = 1000.0f;
+
+//The benchmark's grid of 1000 cubes, 32 to a side.
+const int OCCLUSION_TEST_CUBES = 1000;
+const int OCCLUSION_TEST_SIDE = 32;
+const float OCCLUSION_TEST_SPACING = 4.0f;
+const float OCCLUSION_TEST_HALF_WIDTH = OCCLUSION_TEST_SIDE * OCCLUSION_TEST_SPACING * 0.5f;
+
+//Other compilers round the matrix maths differently, which moves a depth by far
+//less than the tolerance, but may flip a pixel lying right on an edge.
+const float OCCLUSION_TEST_DEPTH_TOLERANCE = 1e-5f;
+const int OCCLUSION_TEST_MAX_DIFFERENT_PIXELS = 8;
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		LoadCubeMesh
+
+Summary:	Reads the corners of cube.txt into a triangle hierarchy, as
+			ModelClass does, without needing a device.
+
+Args:		MeshBVHClass& mesh
+				the hierarchy to build.
+
+Returns:	bool
+				was the file read and the hierarchy built.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static bool LoadCubeMesh(MeshBVHClass& mesh)
+{
+	std::ifstream fin("../Engine/data/cube.txt");
+	if (fin.fail())
+		return false;
+
+	//Skip to the vertex count, then to the data.
+	char input = 0;
+	while (fin.get(input) && input != ':');
+	int vertexCount = 0;
+	fin >> vertexCount;
+	while (fin.get(input) && input != ':');
+
+	//Each vertex is a position, texture coordinate and normal.
+	std::vector<float> positions(vertexCount * 3);
+	for (int i = 0; i < vertexCount; i++)
+	{
+		float tu, tv, nx, ny, nz;
+		fin >> positions[i * 3] >> positions[i * 3 + 1] >> positions[i * 3 + 2] >> tu >> tv >> nx >> ny >> nz;
+	}
+	if (fin.fail() || vertexCount <= 0)
+		return false;
+
+	return mesh.Initialize(&positions[0], 3 * sizeof(float), vertexCount);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetViewProjection
+
+Summary:	Builds the view projection matrix of a camera pitched about x, as
+			CameraClass and D3DClass do.
+
+Args:		XMFLOAT3 eye
+				where the camera is.
+			float pitch
+				how far the camera looks down, in degrees.
+
+Returns:	XMMATRIX
+				the view matrix multiplied by the projection matrix.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static XMMATRIX GetViewProjection(XMFLOAT3 eye, float pitch)
+{
+	float radians = XMConvertToRadians(pitch);
+	XMVECTOR position = XMVectorSet(eye.x, eye.y, eye.z, 1.0f);
+	XMVECTOR forward = XMVectorSet(0.0f, -sinf(radians), cosf(radians), 0.0f);
+	XMVECTOR up = XMVectorSet(0.0f, cosf(radians), sinf(radians), 0.0f);
+
+	XMMATRIX view = XMMatrixLookAtLH(position, XMVectorAdd(position, forward), up);
+	XMMATRIX projection = XMMatrixPerspectiveFovLH(XM_PI / 4.0f, OCCLUSION_TEST_ASPECT, OCCLUSION_TEST_NEAR, OCCLUSION_TEST_DEPTH);
+	return XMMatrixMultiply(view, projection);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetRoofBounds
+
+Summary:	Gets the box the benchmark stretches a cube into to roof over the
+			far half of the grid.
+
+Returns:	BoundingBox
+				the roof, in world space.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static BoundingBox GetRoofBounds()
+{
+	BoundingBox roof;
+	roof.Center = XMFLOAT3(0.0f, 3.0f, OCCLUSION_TEST_HALF_WIDTH * 0.5f);
+	roof.Extents = XMFLOAT3(OCCLUSION_TEST_HALF_WIDTH + OCCLUSION_TEST_SPACING, 0.25f, OCCLUSION_TEST_HALF_WIDTH * 0.5f + OCCLUSION_TEST_SPACING);
+	return roof;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		GetCubeBounds
+
+Summary:	Gets the AABB of a cube of the benchmark's grid.
+
+Args:		int index
+				the cube, from 0 to OCCLUSION_TEST_CUBES - 1.
+
+Returns:	BoundingBox
+				the cube, in world space.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static BoundingBox GetCubeBounds(int index)
+{
+	BoundingBox cube;
+	cube.Center = XMFLOAT3((index % OCCLUSION_TEST_SIDE) * OCCLUSION_TEST_SPACING - OCCLUSION_TEST_HALF_WIDTH, 0.0f,
+		(index / OCCLUSION_TEST_SIDE) * OCCLUSION_TEST_SPACING - OCCLUSION_TEST_HALF_WIDTH);
+	cube.Extents = XMFLOAT3(1.0f, 1.0f, 1.0f);
+	return cube;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		DrawRoof
+
+Summary:	Clears the culler for a camera and draws the roof into it.
+
+Args:		OcclusionCullerClass& culler
+				the culler to draw into.
+			MeshBVHClass& cube
+				the cube mesh the roof is stretched from.
+			XMFLOAT3 eye
+				where the camera is.
+			float pitch
+				how far the camera looks down, in degrees.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static void DrawRoof(OcclusionCullerClass& culler, MeshBVHClass& cube, XMFLOAT3 eye, float pitch)
+{
+	BoundingBox roof = GetRoofBounds();
+	XMMATRIX worldMatrix = XMMatrixMultiply(XMMatrixScaling(roof.Extents.x, roof.Extents.y, roof.Extents.z),
+		XMMatrixTranslation(roof.Center.x, roof.Center.y, roof.Center.z));
+
+	culler.Clear(GetViewProjection(eye, pitch));
+	culler.DrawOccluder(&cube, worldMatrix);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		ReadDepthBuffer
+
+Summary:	Reads a depth buffer saved by SaveDepthBuffer().
+
+Args:		const std::string& filename
+				the PFM image to read.
+			int& width, height
+				set to the size of the buffer.
+			std::vector<float>& depth
+				filled with the depths, row by row from the top.
+
+Returns:	bool
+				was the file read.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static bool ReadDepthBuffer(const std::string& filename, int& width, int& height, std::vector<float>& depth)
+{
+	std::ifstream fin(filename.c_str(), std::ios::in | std::ios::binary);
+	if (fin.fail())
+		return false;
+
+	std::string format;
+	float scale;
+	fin >> format >> width >> height >> scale;
+	fin.get();
+	if (fin.fail() || format != "Pf" || scale >= 0.0f || width <= 0 || height <= 0)
+		return false;
+
+	//PFM rows run from the bottom up.
+	depth.resize(width * height);
+	for (int y = height - 1; y >= 0; y--)
+		fin.read((char*)&depth[y * width], width * sizeof(float));
+
+	return !fin.fail();
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		CheckAgainstGolden
+
+Summary:	Diffs the culler's depth buffer against a golden one in data/,
+			saving it as <name>_actual.pfm if they differ.
+
+Args:		OcclusionCullerClass& culler
+				the culler drawn into.
+			const std::string& name
+				the name of the golden buffer, without its extension.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static void CheckAgainstGolden(OcclusionCullerClass& culler, const std::string& name)
+{
+	int width = 0, height = 0;
+	std::vector<float> golden;
+	bool read = ReadDepthBuffer("data/" + name + ".pfm", width, height, golden);
+	CHECK(read);
+
+	int different = 0;
+	if (read && width == culler.GetWidth() && height == culler.GetHeight())
+	{
+		const float* depth = culler.GetDepthBuffer();
+		for (int i = 0; i < width * height; i++)
+		{
+			if (!(fabsf(depth[i] - golden[i]) <= OCCLUSION_TEST_DEPTH_TOLERANCE))
+				different++;
+		}
+	}
+	else
+	{
+		different = culler.GetWidth() * culler.GetHeight();
+	}
+
+	CHECK(different <= OCCLUSION_TEST_MAX_DIFFERENT_PIXELS);
+	if (different > 0)
+	{
+		printf("  %s: %d pixels differ, saved as %s_actual.pfm\n", name.c_str(), different, name.c_str());
+		culler.SaveDepthBuffer((name + "_actual.pfm").c_str());
+	}
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		IsPointHidden
+
+Summary:	Checks whether the line from the camera to a point passes
+			through a box before reaching it, with the slab test.
+
+Args:		XMFLOAT3 eye
+				where the camera is.
+			XMFLOAT3 point
+				the point looked at.
+			const BoundingBox& box
+				the box that may hide it.
+
+Returns:	bool
+				is the point behind the box.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static bool IsPointHidden(XMFLOAT3 eye, XMFLOAT3 point, const BoundingBox& box)
+{
+	float start[3] = { eye.x, eye.y, eye.z };
+	float end[3] = { point.x, point.y, point.z };
+	float centre[3] = { box.Center.x, box.Center.y, box.Center.z };
+	float extents[3] = { box.Extents.x, box.Extents.y, box.Extents.z };
+
+	//Find where along the line it is inside all three slabs.
+	float enter = 0.0f, exit = 1.0f;
+	for (int axis = 0; axis < 3; axis++)
+	{
+		float along = end[axis] - start[axis];
+		float low = centre[axis] - extents[axis] - start[axis];
+		float high = centre[axis] + extents[axis] - start[axis];
+		if (along == 0.0f)
+		{
+			if (low > 0.0f || high < 0.0f)
+				return false;
+			continue;
+		}
+
+		float first = low / along, second = high / along;
+		enter = std::max(enter, std::min(first, second));
+		exit = std::min(exit, std::max(first, second));
+	}
+
+	return enter <= exit && enter < 1.0f;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		CountSeenPoints
+
+Summary:	Samples a grid of points over each face of a box and counts those
+			on screen that the camera can see past a blocking box.
+
+Args:		XMFLOAT3 eye
+				where the camera is.
+			CXMMATRIX viewProjection
+				the camera's view projection matrix.
+			const BoundingBox& bounds
+				the box sampled.
+			const BoundingBox& blocker
+				the box that may hide it.
+
+Returns:	int
+				the number of points that can be seen.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static int CountSeenPoints(XMFLOAT3 eye, CXMMATRIX viewProjection, const BoundingBox& bounds, const BoundingBox& blocker)
+{
+	const int steps = 8;
+	int seen = 0;
+
+	for (int face = 0; face < 6; face++)
+	{
+		for (int i = 0; i <= steps; i++)
+		{
+			for (int j = 0; j <= steps; j++)
+			{
+				//Place the point on the face in the box's -1 to 1 space.
+				float offset[3];
+				int axis = face / 2;
+				offset[axis] = (face % 2) ? 1.0f : -1.0f;
+				offset[(axis + 1) % 3] = -1.0f + 2.0f * i / steps;
+				offset[(axis + 2) % 3] = -1.0f + 2.0f * j / steps;
+
+				XMFLOAT3 point(bounds.Center.x + offset[0] * bounds.Extents.x, bounds.Center.y + offset[1] * bounds.Extents.y,
+					bounds.Center.z + offset[2] * bounds.Extents.z);
+
+				//Only points on screen can be seen.
+				XMFLOAT4 clip;
+				XMStoreFloat4(&clip, XMVector4Transform(XMVectorSet(point.x, point.y, point.z, 1.0f), viewProjection));
+				if (clip.w <= 0.0f || fabsf(clip.x) > clip.w || fabsf(clip.y) > clip.w)
+					continue;
+
+				if (!IsPointHidden(eye, point, blocker))
+					seen++;
+			}
+		}
+	}
+
+	return seen;
+}
+
+
+TEST(OcclusionCuller_MatchesGoldenFromAbove)
+{
+	//The benchmark's camera, looking down over the whole grid.
+	MeshBVHClass cube;
+	REQUIRE(LoadCubeMesh(cube));
+
+	OcclusionCullerClass culler;
+	REQUIRE(culler.Initialize(OCCLUSION_TEST_WIDTH, OCCLUSION_TEST_HEIGHT));
+
+	DrawRoof(culler, cube, XMFLOAT3(0.0f, OCCLUSION_TEST_HALF_WIDTH + 10.0f, -OCCLUSION_TEST_HALF_WIDTH - 10.0f), 45.0f);
+	CHECK_EQUAL(cube.GetTriangleCount(), culler.GetTrianglesDrawn());
+	CheckAgainstGolden(culler, "occluded_above");
+
+	culler.Shutdown();
+	cube.Shutdown();
+}
+
+TEST(OcclusionCuller_MatchesGoldenFromUnderRoof)
+{
+	//Standing under the back of the roof looking up and out past its edge, so
+	//the underside is clipped to the near plane.
+	MeshBVHClass cube;
+	REQUIRE(LoadCubeMesh(cube));
+
+	OcclusionCullerClass culler;
+	REQUIRE(culler.Initialize(OCCLUSION_TEST_WIDTH, OCCLUSION_TEST_HEIGHT));
+
+	DrawRoof(culler, cube, XMFLOAT3(0.0f, 1.5f, OCCLUSION_TEST_HALF_WIDTH), -10.0f);
+	CheckAgainstGolden(culler, "occluded_under");
+
+	culler.Shutdown();
+	cube.Shutdown();
+}
+
+TEST(OcclusionCuller_CullsOnlyHiddenCubes)
+{
+	MeshBVHClass cube;
+	REQUIRE(LoadCubeMesh(cube));
+
+	OcclusionCullerClass culler;
+	REQUIRE(culler.Initialize(OCCLUSION_TEST_WIDTH, OCCLUSION_TEST_HEIGHT));
+
+	XMFLOAT3 eye(0.0f, OCCLUSION_TEST_HALF_WIDTH + 10.0f, -OCCLUSION_TEST_HALF_WIDTH - 10.0f);
+	XMMATRIX viewProjection = GetViewProjection(eye, 45.0f);
+	DrawRoof(culler, cube, eye, 45.0f);
+
+	//No part of a culled cube on screen may be seen past the roof.
+	BoundingBox roof = GetRoofBounds();
+	int culled = 0, underRoof = 0, wronglyCulled = 0;
+	for (int i = 0; i < OCCLUSION_TEST_CUBES; i++)
+	{
+		BoundingBox bounds = GetCubeBounds(i);
+		if (bounds.Center.z - bounds.Extents.z >= roof.Center.z - roof.Extents.z)
+			underRoof++;
+
+		if (culler.IsVisible(bounds))
+			continue;
+
+		culled++;
+		if (CountSeenPoints(eye, viewProjection, bounds, roof) > 0)
+			wronglyCulled++;
+	}
+
+	CHECK_EQUAL(0, wronglyCulled);
+
+	//And it still culls most of what is under the roof.
+	CHECK(culled * 10 >= underRoof * 9);
+
+	culler.Shutdown();
+	cube.Shutdown();
+}
+
+TEST(OcclusionCuller_SeesThroughGapNarrowerThanPixel)
+{
+	//Two walls 10 ahead of the camera leaving a slit far thinner than a pixel,
+	//which covers every pixel centre along it.
+	OcclusionCullerClass culler;
+	REQUIRE(culler.Initialize(OCCLUSION_TEST_WIDTH, OCCLUSION_TEST_HEIGHT));
+	culler.Clear(GetViewProjection(XMFLOAT3(0.0f, 0.0f, 0.0f), 0.0f));
+
+	float gap = 0.005f;
+	culler.DrawTriangle(XMVectorSet(-gap, -100.0f, 10.0f, 1.0f), XMVectorSet(-gap, 100.0f, 10.0f, 1.0f), XMVectorSet(-200.0f, 0.0f, 10.0f, 1.0f));
+	culler.DrawTriangle(XMVectorSet(gap, -100.0f, 10.0f, 1.0f), XMVectorSet(gap, 100.0f, 10.0f, 1.0f), XMVectorSet(200.0f, 0.0f, 10.0f, 1.0f));
+
+	//A box behind the slit can be seen through it.
+	BoundingBox behindGap;
+	behindGap.Center = XMFLOAT3(0.0f, 0.0f, 20.0f);
+	behindGap.Extents = XMFLOAT3(0.5f, 0.5f, 0.5f);
+	CHECK(culler.IsVisible(behindGap));
+
+	//One behind a wall is still culled.
+	BoundingBox behindWall = behindGap;
+	behindWall.Center.x = -4.0f;
+	CHECK(!culler.IsVisible(behindWall));
+
+	culler.Shutdown();
+}
@@ -0,0 +1,252 @@
+//======================================================
+//				Filename: ProfilerTests.cpp
+//
+// Tests ProfilerClass with zones of known length in
+// counter ticks: each thread's ring drained by
+// EndFrame(), zones dropped once a ring fills, the
+// min/avg/max report over several frames and traces
+// written in real time units rather than ticks.
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "TestFramework.h"
+#include "../Engine/ProfilerClass.h"
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+//======================================================
+//					Constants.
+//======================================================
+//The zones each thread's ring holds between calls to EndFrame().
+const int PROFILER_TEST_RING_SIZE = 4096;
+
+const char* const PROFILER_TEST_ZONE = "Profiler Test Zone";
+const char* const PROFILER_TEST_TRACE = "test_profiler_trace.json";
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Ticks
+
+Summary:	Converts a time to performance counter ticks, so zones of a
+			known length can be recorded.
+
+Args:		int64_t microseconds
+				the time, in microseconds.
+
+Returns:	int64_t
+				the time, in counter ticks.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static int64_t Ticks(int64_t microseconds)
+{
+	return microseconds * ProfilerClass::GetFrequency() / 1000000;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Near
+
+Summary:	Checks a time read back is within a microsecond of what was
+			recorded, as a counter that doesn't tick in whole microseconds
+			rounds the zones a little.
+
+Args:		double expected
+				the time recorded.
+			double actual
+				the time read back.
+			double microsecond
+				a microsecond in the units of the times.
+
+Returns:	bool
+				is actual close enough to expected.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static bool Near(double expected, double actual, double microsecond)
+{
+	return fabs(expected - actual) <= microsecond;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RecordZones
+
+Summary:	Records a number of zones of the same length on the calling
+			thread, one after another from one second in.
+
+Args:		int count
+				the zones to record.
+			int64_t microseconds
+				the length of each zone.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static void RecordZones(int count, int64_t microseconds)
+{
+	int64_t start = Ticks(1000000);
+	for (int i = 0; i < count; i++)
+	{
+		ProfilerClass::Record(PROFILER_TEST_ZONE, start, start + Ticks(microseconds), 0);
+		start += Ticks(microseconds);
+	}
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		ReadZone
+
+Summary:	Finds the test zone's line in the profiler's report and reads
+			its min, average and max time per frame and its calls.
+
+Args:		double& minimum, average, maximum
+				set to the zone's times, in ms.
+			int& calls
+				set to the zone's calls in the last frame.
+
+Returns:	bool
+				was the zone in the report.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static bool ReadZone(double& minimum, double& average, double& maximum, int& calls)
+{
+	std::istringstream report(ProfilerClass::GetReport());
+	std::string line;
+	size_t nameLength = strlen(PROFILER_TEST_ZONE);
+
+	while (std::getline(report, line))
+	{
+		if (line.compare(0, nameLength, PROFILER_TEST_ZONE) != 0)
+			continue;
+
+		return sscanf(line.c_str() + nameLength, "%lf %lf %lf %d", &minimum, &average, &maximum, &calls) == 4;
+	}
+
+	return false;
+}
+
+
+TEST(Profiler_ReportsMinAvgMaxInMilliseconds)
+{
+	ProfilerClass::Shutdown();
+
+	//One frame each of 1, 2 and 3 ms, the last in two zones.
+	RecordZones(1, 1000);
+	ProfilerClass::EndFrame();
+	RecordZones(1, 2000);
+	ProfilerClass::EndFrame();
+	RecordZones(2, 1500);
+	ProfilerClass::EndFrame();
+
+	double minimum, average, maximum;
+	int calls;
+	REQUIRE(ReadZone(minimum, average, maximum, calls));
+	CHECK(Near(1.0, minimum, 0.001));
+	CHECK(Near(2.0, average, 0.001));
+	CHECK(Near(3.0, maximum, 0.001));
+	CHECK_EQUAL(2, calls);
+
+	//A frame the zone didn't run in counts as 0 ms.
+	ProfilerClass::EndFrame();
+	REQUIRE(ReadZone(minimum, average, maximum, calls));
+	CHECK_EQUAL(0.0, minimum);
+	CHECK(Near(1.5, average, 0.001));
+	CHECK_EQUAL(0, calls);
+
+	ProfilerClass::Shutdown();
+}
+
+TEST(Profiler_DrainsEveryThreadsRing)
+{
+	ProfilerClass::Shutdown();
+
+	//Each thread writes its own ring, and EndFrame() collects them all.
+	std::vector<std::thread> threads;
+	for (int i = 0; i < 3; i++)
+		threads.push_back(std::thread(RecordZones, 10, 100));
+	for (size_t i = 0; i < threads.size(); i++)
+		threads[i].join();
+	RecordZones(10, 100);
+
+	ProfilerClass::EndFrame();
+
+	double minimum, average, maximum;
+	int calls;
+	REQUIRE(ReadZone(minimum, average, maximum, calls));
+	CHECK_EQUAL(40, calls);
+	CHECK(Near(4.0, maximum, 0.001));
+
+	//Drained zones are not collected again.
+	ProfilerClass::EndFrame();
+	REQUIRE(ReadZone(minimum, average, maximum, calls));
+	CHECK_EQUAL(0, calls);
+
+	ProfilerClass::Shutdown();
+}
+
+TEST(Profiler_DropsZonesWhenRingIsFull)
+{
+	ProfilerClass::Shutdown();
+
+	//Overfill the ring, the extra zones are dropped and reported.
+	RecordZones(PROFILER_TEST_RING_SIZE + 5, 1);
+	CHECK(ProfilerClass::GetReport().find("5 zones dropped") != std::string::npos);
+
+	ProfilerClass::EndFrame();
+
+	double minimum, average, maximum;
+	int calls;
+	REQUIRE(ReadZone(minimum, average, maximum, calls));
+	CHECK_EQUAL(PROFILER_TEST_RING_SIZE, calls);
+
+	//Once drained, the ring has room again.
+	RecordZones(PROFILER_TEST_RING_SIZE, 1);
+	ProfilerClass::EndFrame();
+	REQUIRE(ReadZone(minimum, average, maximum, calls));
+	CHECK_EQUAL(PROFILER_TEST_RING_SIZE, calls);
+	CHECK(ProfilerClass::GetReport().find("5 zones dropped") != std::string::npos);
+
+	ProfilerClass::Shutdown();
+}
+
+TEST(Profiler_WritesTraceInMicroseconds)
+{
+	ProfilerClass::Shutdown();
+
+	//Two 1.5 ms zones back to back.
+	ProfilerClass::CaptureTrace(1, PROFILER_TEST_TRACE);
+	RecordZones(2, 1500);
+	ProfilerClass::EndFrame();
+
+	std::ifstream trace(PROFILER_TEST_TRACE);
+	REQUIRE(trace.is_open());
+	std::stringstream contents;
+	contents << trace.rdbuf();
+	trace.close();
+	remove(PROFILER_TEST_TRACE);
+
+	//Read back each zone's start, from the first zone, and length.
+	std::string json = contents.str();
+	std::vector<double> times;
+	for (size_t at = json.find("\"ts\":"); at != std::string::npos; at = json.find("\"ts\":", at + 1))
+	{
+		double start, length;
+		REQUIRE(sscanf(json.c_str() + at, "\"ts\":%lf,\"dur\":%lf", &start, &length) == 2);
+		times.push_back(start);
+		times.push_back(length);
+	}
+
+	//In microseconds, whatever the counter frequency.
+	REQUIRE(times.size() == 4);
+	CHECK_EQUAL(0.0, times[0]);
+	CHECK(Near(1500.0, times[1], 1.0));
+	CHECK(Near(1500.0, times[2], 1.0));
+	CHECK(Near(1500.0, times[3], 1.0));
+
+	ProfilerClass::Shutdown();
+}
@@ -0,0 +1,364 @@
+//======================================================
+//				Filename: SceneBVHTests.cpp
+//
+// Tests SceneBVHClass against testing every box: the
+// nearest box hit by a ray and the boxes overlapping a
+// query must match looping over them all, over a fixed
+// scatter of boxes, a row walked nearest leaf first, and
+// boxes whose centres all sit on the same point, which
+// leave the binned build nothing to split on.
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "TestFramework.h"
+#include "../Engine/SceneBVHClass.h"
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <math.h>
+#include <vector>
+
+
+//======================================================
+//					Constants.
+//======================================================
+//The most boxes the build leaves in one leaf.
+const int SCENE_BVH_TEST_MAX_LEAF_BOXES = 8;
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		MakeBox
+
+Summary:	Makes a box from its centre and half its size.
+
+Args:		float x, y, z
+				the centre.
+			float halfX, halfY, halfZ
+				half the size along each axis.
+
+Returns:	BoundingBox
+				the box.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static BoundingBox MakeBox(float x, float y, float z, float halfX, float halfY, float halfZ)
+{
+	return BoundingBox(XMFLOAT3(x, y, z), XMFLOAT3(halfX, halfY, halfZ));
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		BuildTree
+
+Summary:	Adds every box to a hierarchy and builds it, checking each is
+			given the index of its place in the list and the tree has no
+			more nodes than a binary tree over them can.
+
+Args:		SceneBVHClass& tree
+				the hierarchy to build.
+			const std::vector<BoundingBox>& boxes
+				the boxes to add.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static void BuildTree(SceneBVHClass& tree, const std::vector<BoundingBox>& boxes)
+{
+	tree.Clear();
+	for (size_t i = 0; i < boxes.size(); i++)
+		CHECK_EQUAL((int)i, tree.Add(boxes[i]));
+	tree.Build();
+
+	CHECK_EQUAL((int)boxes.size(), tree.GetCount());
+	CHECK(tree.GetNodeCount() >= 1);
+	CHECK(tree.GetNodeCount() <= (int)boxes.size() * 2 - 1);
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RayBox
+
+Summary:	Finds where a ray first meets a box with a slab test, the same
+			way the hierarchy tests its nodes.
+
+Args:		const BoundingBox& box
+				the box.
+			const XMFLOAT3& origin
+				the start of the ray.
+			const XMFLOAT3& direction
+				the direction of the ray.
+			float& hit
+				set to how many lengths of direction along the ray it first
+				meets the box, 0 if it starts inside.
+
+Returns:	bool
+				does the ray meet the box, ahead of its start.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static bool RayBox(const BoundingBox& box, const XMFLOAT3& origin, const XMFLOAT3& direction, float& hit)
+{
+	const float start[3] = { origin.x, origin.y, origin.z };
+	const float step[3] = { direction.x, direction.y, direction.z };
+	const float center[3] = { box.Center.x, box.Center.y, box.Center.z };
+	const float extents[3] = { box.Extents.x, box.Extents.y, box.Extents.z };
+
+	float entryDistance = -INFINITY, exitDistance = INFINITY;
+	for (int i = 0; i < 3; i++)
+	{
+		float inverse = 1.0f / step[i];
+		float low = (center[i] - extents[i] - start[i]) * inverse;
+		float high = (center[i] + extents[i] - start[i]) * inverse;
+		entryDistance = fmaxf(entryDistance, fminf(low, high));
+		exitDistance = fminf(exitDistance, fmaxf(low, high));
+	}
+
+	hit = entryDistance > 0.0f ? entryDistance : 0.0f;
+	return exitDistance >= hit;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		CheckRay
+
+Summary:	Casts a ray through the hierarchy, keeping the nearest box the
+			function finds it hitting, and checks it hits something where
+			testing every box in turn does, and just as near. Boxes hit at
+			the same distance may be found in either order.
+
+Args:		SceneBVHClass& tree
+				the built hierarchy.
+			const std::vector<BoundingBox>& boxes
+				the boxes in it.
+			const XMFLOAT3& origin
+				the start of the ray.
+			const XMFLOAT3& direction
+				the direction of the ray.
+			float limit
+				how far along the ray to look.
+
+Returns:	int
+				the number of boxes the hierarchy passed to the function.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static int CheckRay(SceneBVHClass& tree, const std::vector<BoundingBox>& boxes, const XMFLOAT3& origin, const XMFLOAT3& direction, float limit)
+{
+	//Test every box.
+	int expected = -1;
+	float expectedDistance = limit;
+	for (size_t i = 0; i < boxes.size(); i++)
+	{
+		float hit;
+		if (RayBox(boxes[i], origin, direction, hit) && hit < expectedDistance)
+		{
+			expected = (int)i;
+			expectedDistance = hit;
+		}
+	}
+
+	//Then only those the hierarchy gives, shortening the ray as hits are found.
+	int nearest = -1, calls = 0;
+	float distance = limit;
+	tree.Raycast(XMLoadFloat3(&origin), XMLoadFloat3(&direction), distance, [&](int item, float& rayDistance)
+	{
+		calls++;
+		float hit;
+		if (RayBox(boxes[item], origin, direction, hit) && hit < rayDistance)
+		{
+			nearest = item;
+			rayDistance = hit;
+		}
+		return true;
+	});
+
+	CHECK_EQUAL(expected >= 0, nearest >= 0);
+	CHECK_EQUAL(expectedDistance, distance);
+
+	return calls;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		CheckQuery
+
+Summary:	Checks a query gives every box overlapping it exactly once, and
+			no box more than once.
+
+Args:		SceneBVHClass& tree
+				the built hierarchy.
+			const std::vector<BoundingBox>& boxes
+				the boxes in it.
+			const BoundingBox& query
+				the box to query with.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static void CheckQuery(SceneBVHClass& tree, const std::vector<BoundingBox>& boxes, const BoundingBox& query)
+{
+	std::vector<int> counts(boxes.size(), 0);
+	tree.Query(query, [&](int item)
+	{
+		REQUIRE(item >= 0 && item < (int)boxes.size());
+		counts[item]++;
+	});
+
+	for (size_t i = 0; i < boxes.size(); i++)
+	{
+		CHECK(counts[i] <= 1);
+		if (boxes[i].Intersects(query))
+			CHECK_EQUAL(1, counts[i]);
+	}
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Random
+
+Summary:	A small fixed sequence generator, so the scattered boxes and
+			rays are the same every run.
+
+Args:		unsigned& state
+				the generator's state, advanced each call.
+
+Returns:	float
+				the next number, from 0 up to 1.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static float Random(unsigned& state)
+{
+	state = state * 1664525u + 1013904223u;
+	return (state >> 8) / 16777216.0f;
+}
+
+
+TEST(SceneBVH_EmptyTreeFindsNothing)
+{
+	SceneBVHClass tree;
+	tree.Build();
+	CHECK_EQUAL(0, tree.GetNodeCount());
+
+	int calls = 0;
+	tree.Query(MakeBox(0.0f, 0.0f, 0.0f, 100.0f, 100.0f, 100.0f), [&](int) { calls++; });
+
+	XMFLOAT3 origin(0.0f, 0.0f, -10.0f), direction(0.0f, 0.0f, 1.0f);
+	float distance = INFINITY;
+	tree.Raycast(XMLoadFloat3(&origin), XMLoadFloat3(&direction), distance, [&](int, float&) { calls++; return true; });
+	CHECK_EQUAL(0, calls);
+
+	tree.Shutdown();
+}
+
+TEST(SceneBVH_MatchesEveryBoxOnScatteredBoxes)
+{
+	//Boxes of many sizes scattered through a cube, some overlapping.
+	unsigned state = 2024u;
+	std::vector<BoundingBox> boxes;
+	for (int i = 0; i < 300; i++)
+	{
+		float x = Random(state) * 40.0f - 20.0f;
+		float y = Random(state) * 40.0f - 20.0f;
+		float z = Random(state) * 40.0f - 20.0f;
+		boxes.push_back(MakeBox(x, y, z, 0.1f + Random(state) * 2.0f, 0.1f + Random(state) * 2.0f, 0.1f + Random(state) * 2.0f));
+	}
+
+	SceneBVHClass tree;
+	BuildTree(tree, boxes);
+
+	//Rays from all around aimed through the cube, some only looking a
+	//little way, and some with directions longer than a unit.
+	for (int i = 0; i < 400; i++)
+	{
+		XMFLOAT3 origin(Random(state) * 80.0f - 40.0f, Random(state) * 80.0f - 40.0f, Random(state) * 80.0f - 40.0f);
+		XMFLOAT3 target(Random(state) * 30.0f - 15.0f, Random(state) * 30.0f - 15.0f, Random(state) * 30.0f - 15.0f);
+		XMFLOAT3 direction(target.x - origin.x, target.y - origin.y, target.z - origin.z);
+
+		float limit = (i % 4 == 0) ? 0.5f : INFINITY;
+		CheckRay(tree, boxes, origin, direction, limit);
+	}
+
+	//A ray starting inside a box hits it straight away.
+	XMFLOAT3 inside(boxes[7].Center.x, boxes[7].Center.y, boxes[7].Center.z), up(0.1f, 1.0f, 0.2f);
+	CheckRay(tree, boxes, inside, up, INFINITY);
+
+	//Queries of each box, a box around it, and a point.
+	for (size_t i = 0; i < boxes.size(); i += 3)
+	{
+		CheckQuery(tree, boxes, boxes[i]);
+		CheckQuery(tree, boxes, MakeBox(boxes[i].Center.x, boxes[i].Center.y, boxes[i].Center.z, 4.0f, 1.0f, 4.0f));
+		CheckQuery(tree, boxes, MakeBox(boxes[i].Center.x + 1.0f, boxes[i].Center.y, boxes[i].Center.z, 0.0f, 0.0f, 0.0f));
+	}
+	CheckQuery(tree, boxes, MakeBox(0.0f, 0.0f, 0.0f, 100.0f, 100.0f, 100.0f));
+	CheckQuery(tree, boxes, MakeBox(0.0f, 60.0f, 0.0f, 1.0f, 1.0f, 1.0f));
+
+	tree.Shutdown();
+}
+
+TEST(SceneBVH_RaycastVisitsNearestLeafFirst)
+{
+	//A row of well spaced boxes along x, added out of order.
+	std::vector<BoundingBox> boxes;
+	for (int i = 0; i < 64; i++)
+		boxes.push_back(MakeBox((float)((i * 37) % 64) * 3.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f));
+
+	SceneBVHClass tree;
+	BuildTree(tree, boxes);
+
+	//Once the nearest box is hit, every other leaf starts beyond it, so
+	//only the boxes of the first leaf are ever tested.
+	XMFLOAT3 origin(-10.0f, 0.25f, 0.5f), along(1.0f, 0.0f, 0.0f), back(-1.0f, 0.0f, 0.0f);
+	CHECK(CheckRay(tree, boxes, origin, along, INFINITY) <= SCENE_BVH_TEST_MAX_LEAF_BOXES);
+
+	origin.x = 200.0f;
+	CHECK(CheckRay(tree, boxes, origin, back, INFINITY) <= SCENE_BVH_TEST_MAX_LEAF_BOXES);
+
+	//From between two boxes, only the one ahead is hit.
+	origin.x = 100.5f;
+	CHECK(CheckRay(tree, boxes, origin, along, INFINITY) <= SCENE_BVH_TEST_MAX_LEAF_BOXES);
+	CHECK(CheckRay(tree, boxes, origin, back, INFINITY) <= SCENE_BVH_TEST_MAX_LEAF_BOXES);
+
+	//A function that stops at the first hit ends the walk there.
+	int calls = 0;
+	float distance = INFINITY;
+	origin.x = -10.0f;
+	tree.Raycast(XMLoadFloat3(&origin), XMLoadFloat3(&along), distance, [&](int item, float&)
+	{
+		calls++;
+		float hit;
+		return !RayBox(boxes[item], origin, along, hit);
+	});
+	CHECK(calls <= SCENE_BVH_TEST_MAX_LEAF_BOXES);
+
+	tree.Shutdown();
+}
+
+TEST(SceneBVH_MatchesEveryBoxWithEqualCentroids)
+{
+	//Boxes of different sizes all centred on one point leave no bin to
+	//split at, so the build must still finish and keep every box.
+	unsigned state = 77u;
+	std::vector<BoundingBox> boxes;
+	for (int i = 0; i < 100; i++)
+		boxes.push_back(MakeBox(2.0f, -1.0f, 3.0f, 0.1f + Random(state) * 5.0f, 0.1f + Random(state) * 5.0f, 0.1f + Random(state) * 5.0f));
+
+	SceneBVHClass tree;
+	BuildTree(tree, boxes);
+
+	for (int i = 0; i < 200; i++)
+	{
+		XMFLOAT3 origin(Random(state) * 40.0f - 20.0f, Random(state) * 40.0f - 20.0f, Random(state) * 40.0f - 20.0f);
+		XMFLOAT3 direction(2.0f - origin.x + Random(state) * 8.0f - 4.0f, -1.0f - origin.y + Random(state) * 8.0f - 4.0f, 3.0f - origin.z);
+		CheckRay(tree, boxes, origin, direction, INFINITY);
+	}
+
+	for (int i = 0; i < 50; i++)
+	{
+		float x = Random(state) * 12.0f - 4.0f, y = Random(state) * 12.0f - 7.0f, z = Random(state) * 12.0f - 3.0f;
+		CheckQuery(tree, boxes, MakeBox(x, y, z, 0.5f, 0.5f, 0.5f));
+	}
+
+	//The same with the centres only equal along one axis, all on a plane.
+	for (size_t i = 0; i < boxes.size(); i++)
+		boxes[i].Center = XMFLOAT3(Random(state) * 20.0f - 10.0f, 4.0f, Random(state) * 20.0f - 10.0f);
+	BuildTree(tree, boxes);
+
+	for (int i = 0; i < 200; i++)
+	{
+		XMFLOAT3 origin(Random(state) * 40.0f - 20.0f, 30.0f, Random(state) * 40.0f - 20.0f);
+		XMFLOAT3 direction(Random(state) * 2.0f - 1.0f, -1.0f, Random(state) * 2.0f - 1.0f);
+		CheckRay(tree, boxes, origin, direction, INFINITY);
+	}
+
+	for (size_t i = 0; i < boxes.size(); i += 5)
+		CheckQuery(tree, boxes, boxes[i]);
+
+	tree.Shutdown();
+}
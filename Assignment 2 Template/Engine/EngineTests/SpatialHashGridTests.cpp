@@ -0,0 +1,395 @@
+//======================================================
+//				Filename: SpatialHashGridTests.cpp
+//
+// Tests SpatialHashGridClass against testing every box:
+// the build must count, total up and place every cell
+// of every box, including a cell shared by many boxes
+// and a table grown past its smallest size, and queries
+// must return each box they overlap exactly once, even
+// when both span several cells or meet on a boundary.
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "TestFramework.h"
+#include "../Engine/SpatialHashGridClass.h"
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <math.h>
+#include <set>
+#include <tuple>
+#include <vector>
+
+
+//======================================================
+//					Constants.
+//======================================================
+const float GRID_TEST_CELL_SIZE = 2.0f;
+
+//Boxes covering more cells than this are returned by every query.
+const int GRID_TEST_MAX_CELLS_PER_BOX = 64;
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		MakeBox
+
+Summary:	Makes a box from its lowest and highest corners.
+
+Args:		float minX, minY, minZ
+				the lowest corner.
+			float maxX, maxY, maxZ
+				the highest corner.
+
+Returns:	BoundingBox
+				the box.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static BoundingBox MakeBox(float minX, float minY, float minZ, float maxX, float maxY, float maxZ)
+{
+	return BoundingBox(XMFLOAT3((minX + maxX) * 0.5f, (minY + maxY) * 0.5f, (minZ + maxZ) * 0.5f),
+		XMFLOAT3((maxX - minX) * 0.5f, (maxY - minY) * 0.5f, (maxZ - minZ) * 0.5f));
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		BuildGrid
+
+Summary:	Adds every box to a grid and builds it, checking each is given
+			the index of its place in the list.
+
+Args:		SpatialHashGridClass& grid
+				the grid to build.
+			const std::vector<BoundingBox>& boxes
+				the boxes to add.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static void BuildGrid(SpatialHashGridClass& grid, const std::vector<BoundingBox>& boxes)
+{
+	grid.Clear();
+	for (size_t i = 0; i < boxes.size(); i++)
+		CHECK_EQUAL((int)i, grid.Add(boxes[i]));
+	grid.Build();
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		QueryCounts
+
+Summary:	Queries a grid, counting how many times each box is returned.
+
+Args:		SpatialHashGridClass& grid
+				the built grid.
+			int boxCount
+				the number of boxes in it.
+			const BoundingBox& query
+				the box to query with.
+
+Returns:	std::vector<int>
+				the times each box was returned, by index.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static std::vector<int> QueryCounts(SpatialHashGridClass& grid, int boxCount, const BoundingBox& query)
+{
+	std::vector<int> counts(boxCount, 0);
+	grid.Query(query, [&](int index)
+	{
+		REQUIRE(index >= 0 && index < boxCount);
+		counts[index]++;
+	});
+
+	return counts;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		CheckQuery
+
+Summary:	Checks a query returns no box more than once, and every box it
+			overlaps exactly once.
+
+Args:		SpatialHashGridClass& grid
+				the built grid.
+			const std::vector<BoundingBox>& boxes
+				the boxes in it.
+			const BoundingBox& query
+				the box to query with.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static void CheckQuery(SpatialHashGridClass& grid, const std::vector<BoundingBox>& boxes, const BoundingBox& query)
+{
+	std::vector<int> counts = QueryCounts(grid, (int)boxes.size(), query);
+
+	for (size_t i = 0; i < boxes.size(); i++)
+	{
+		CHECK(counts[i] <= 1);
+		if (boxes[i].Intersects(query))
+			CHECK_EQUAL(1, counts[i]);
+	}
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		CountCells
+
+Summary:	Counts the different cells a list of boxes covers between
+			them, leaving out boxes too big to be listed in their cells.
+
+Args:		const std::vector<BoundingBox>& boxes
+				the boxes.
+
+Returns:	int
+				the number of cells with a box in.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static int CountCells(const std::vector<BoundingBox>& boxes)
+{
+	std::set<std::tuple<int, int, int>> cells;
+	for (size_t i = 0; i < boxes.size(); i++)
+	{
+		const BoundingBox& box = boxes[i];
+		int low[3] = {
+			(int)floorf((box.Center.x - box.Extents.x) / GRID_TEST_CELL_SIZE),
+			(int)floorf((box.Center.y - box.Extents.y) / GRID_TEST_CELL_SIZE),
+			(int)floorf((box.Center.z - box.Extents.z) / GRID_TEST_CELL_SIZE) };
+		int high[3] = {
+			(int)floorf((box.Center.x + box.Extents.x) / GRID_TEST_CELL_SIZE),
+			(int)floorf((box.Center.y + box.Extents.y) / GRID_TEST_CELL_SIZE),
+			(int)floorf((box.Center.z + box.Extents.z) / GRID_TEST_CELL_SIZE) };
+
+		if ((high[0] - low[0] + 1) * (high[1] - low[1] + 1) * (high[2] - low[2] + 1) > GRID_TEST_MAX_CELLS_PER_BOX)
+			continue;
+
+		for (int x = low[0]; x <= high[0]; x++)
+			for (int y = low[1]; y <= high[1]; y++)
+				for (int z = low[2]; z <= high[2]; z++)
+					cells.insert(std::make_tuple(x, y, z));
+	}
+
+	return (int)cells.size();
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		Random
+
+Summary:	A small fixed sequence generator, so the scattered boxes are
+			the same every run.
+
+Args:		unsigned& state
+				the generator's state, advanced each call.
+
+Returns:	float
+				the next number, from 0 up to 1.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static float Random(unsigned& state)
+{
+	state = state * 1664525u + 1013904223u;
+	return (state >> 8) / 16777216.0f;
+}
+
+
+TEST(SpatialHashGrid_BuildPlacesEveryCell)
+{
+	SpatialHashGridClass grid;
+	REQUIRE(grid.Initialize(GRID_TEST_CELL_SIZE));
+
+	//One box inside cell (0,0,0), one over the 2x2x1 cells from there, and
+	//one on the far side of 0 in every axis.
+	std::vector<BoundingBox> boxes;
+	boxes.push_back(MakeBox(0.5f, 0.5f, 0.5f, 1.5f, 1.5f, 1.5f));
+	boxes.push_back(MakeBox(1.0f, 1.0f, 0.5f, 3.0f, 3.0f, 1.5f));
+	boxes.push_back(MakeBox(-1.5f, -1.5f, -1.5f, -0.5f, -0.5f, -0.5f));
+	BuildGrid(grid, boxes);
+
+	CHECK_EQUAL(5, grid.GetCellCount());
+	CHECK_EQUAL(CountCells(boxes), grid.GetCellCount());
+
+	//Each cell holds exactly the boxes over it.
+	std::vector<int> counts = QueryCounts(grid, 3, MakeBox(0.2f, 0.2f, 0.2f, 0.3f, 0.3f, 0.3f));
+	CHECK_EQUAL(1, counts[0]);
+	CHECK_EQUAL(1, counts[1]);
+	CHECK_EQUAL(0, counts[2]);
+
+	counts = QueryCounts(grid, 3, MakeBox(2.5f, 2.5f, 0.5f, 2.6f, 2.6f, 0.6f));
+	CHECK_EQUAL(0, counts[0]);
+	CHECK_EQUAL(1, counts[1]);
+	CHECK_EQUAL(0, counts[2]);
+
+	counts = QueryCounts(grid, 3, MakeBox(-1.0f, -1.0f, -1.0f, -0.9f, -0.9f, -0.9f));
+	CHECK_EQUAL(0, counts[0]);
+	CHECK_EQUAL(0, counts[1]);
+	CHECK_EQUAL(1, counts[2]);
+
+	//A cell nothing is in returns nothing.
+	counts = QueryCounts(grid, 3, MakeBox(10.5f, 0.5f, 0.5f, 10.6f, 0.6f, 0.6f));
+	CHECK_EQUAL(0, counts[0] + counts[1] + counts[2]);
+
+	grid.Shutdown();
+}
+
+TEST(SpatialHashGrid_BuildCountsCrowdedCells)
+{
+	SpatialHashGridClass grid;
+	REQUIRE(grid.Initialize(GRID_TEST_CELL_SIZE));
+
+	//Many boxes in one cell must each get their own place in its run, and
+	//a line of cells far larger than the smallest table must all be kept.
+	std::vector<BoundingBox> boxes;
+	for (int i = 0; i < 100; i++)
+		boxes.push_back(MakeBox(0.1f, 0.1f, 0.1f, 0.2f + i * 0.01f, 0.2f, 0.2f));
+	for (int i = 0; i < 500; i++)
+		boxes.push_back(MakeBox(i * GRID_TEST_CELL_SIZE + 0.5f, 5.0f, -3.0f, i * GRID_TEST_CELL_SIZE + 1.0f, 5.5f, -2.5f));
+	BuildGrid(grid, boxes);
+
+	CHECK_EQUAL(CountCells(boxes), grid.GetCellCount());
+	CHECK_EQUAL(501, grid.GetCellCount());
+
+	std::vector<int> counts = QueryCounts(grid, (int)boxes.size(), MakeBox(0.0f, 0.0f, 0.0f, 0.1f, 0.1f, 0.1f));
+	for (int i = 0; i < 100; i++)
+		CHECK_EQUAL(1, counts[i]);
+
+	for (int i = 0; i < 500; i += 50)
+		CheckQuery(grid, boxes, boxes[100 + i]);
+
+	//Rebuilding with fewer boxes drops the old cells.
+	boxes.resize(100);
+	BuildGrid(grid, boxes);
+	CHECK_EQUAL(1, grid.GetCellCount());
+	CheckQuery(grid, boxes, MakeBox(0.0f, 0.0f, 0.0f, 0.1f, 0.1f, 0.1f));
+
+	grid.Shutdown();
+}
+
+TEST(SpatialHashGrid_QueriesReturnSpanningBoxesOnce)
+{
+	SpatialHashGridClass grid;
+	REQUIRE(grid.Initialize(GRID_TEST_CELL_SIZE));
+
+	//A box over 3x3x3 cells, queried by boxes sharing anywhere from one of
+	//its cells to all of them.
+	std::vector<BoundingBox> boxes;
+	boxes.push_back(MakeBox(-2.0f, -2.0f, -2.0f, 3.9f, 3.9f, 3.9f));
+	BuildGrid(grid, boxes);
+	CHECK_EQUAL(27, grid.GetCellCount());
+
+	CheckQuery(grid, boxes, MakeBox(-1.0f, -1.0f, -1.0f, -0.5f, -0.5f, -0.5f));
+	CheckQuery(grid, boxes, MakeBox(1.0f, 1.0f, 1.0f, 2.5f, 2.5f, 2.5f));
+	CheckQuery(grid, boxes, MakeBox(-5.0f, -5.0f, -5.0f, 5.0f, 5.0f, 5.0f));
+	CheckQuery(grid, boxes, MakeBox(3.0f, -1.0f, 0.0f, 8.0f, 0.0f, 1.0f));
+
+	//Scattered boxes of many sizes, each queried with itself and with a
+	//box around it, must match testing every box.
+	unsigned state = 12345u;
+	boxes.clear();
+	for (int i = 0; i < 300; i++)
+	{
+		float x = Random(state) * 40.0f - 20.0f;
+		float y = Random(state) * 40.0f - 20.0f;
+		float z = Random(state) * 40.0f - 20.0f;
+		float size = Random(state) * Random(state) * 6.0f;
+		boxes.push_back(MakeBox(x, y, z, x + size, y + size * 0.5f, z + size));
+	}
+	BuildGrid(grid, boxes);
+	CHECK_EQUAL(CountCells(boxes), grid.GetCellCount());
+
+	for (size_t i = 0; i < boxes.size(); i++)
+	{
+		CheckQuery(grid, boxes, boxes[i]);
+
+		BoundingBox around = boxes[i];
+		around.Extents = XMFLOAT3(around.Extents.x + 2.5f, around.Extents.y + 2.5f, around.Extents.z + 2.5f);
+		CheckQuery(grid, boxes, around);
+	}
+
+	grid.Shutdown();
+}
+
+TEST(SpatialHashGrid_QueriesAcrossCellBoundaries)
+{
+	SpatialHashGridClass grid;
+	REQUIRE(grid.Initialize(GRID_TEST_CELL_SIZE));
+
+	//Boxes either side of the boundary at x = 0, one across it, and one
+	//ending on it, which floors into the cell beyond.
+	std::vector<BoundingBox> boxes;
+	boxes.push_back(MakeBox(-1.0f, 0.5f, 0.5f, -0.1f, 1.0f, 1.0f));
+	boxes.push_back(MakeBox(0.1f, 0.5f, 0.5f, 1.0f, 1.0f, 1.0f));
+	boxes.push_back(MakeBox(-0.5f, 0.5f, 0.5f, 0.5f, 1.0f, 1.0f));
+	boxes.push_back(MakeBox(-1.0f, 0.5f, 0.5f, 0.0f, 1.0f, 1.0f));
+	BuildGrid(grid, boxes);
+
+	//A query across the boundary finds all of them, once each.
+	std::vector<int> counts = QueryCounts(grid, 4, MakeBox(-0.05f, 0.6f, 0.6f, 0.05f, 0.7f, 0.7f));
+	for (int i = 0; i < 4; i++)
+		CHECK_EQUAL(1, counts[i]);
+
+	//A query just one side is given every box listed in its cell, including
+	//the one ending on the boundary, but nothing from the cell beyond.
+	counts = QueryCounts(grid, 4, MakeBox(0.2f, 0.6f, 0.6f, 0.3f, 0.7f, 0.7f));
+	CHECK_EQUAL(0, counts[0]);
+	CHECK_EQUAL(1, counts[1]);
+	CHECK_EQUAL(1, counts[2]);
+	CHECK_EQUAL(1, counts[3]);
+
+	counts = QueryCounts(grid, 4, MakeBox(-0.3f, 0.6f, 0.6f, -0.2f, 0.7f, 0.7f));
+	CHECK_EQUAL(1, counts[0]);
+	CHECK_EQUAL(0, counts[1]);
+	CHECK_EQUAL(1, counts[2]);
+	CHECK_EQUAL(1, counts[3]);
+
+	//The same along every axis, with the boundary at the far edge of a cell.
+	for (int axis = 0; axis < 3; axis++)
+	{
+		float low[3] = { 0.5f, 0.5f, 0.5f };
+		float high[3] = { 1.0f, 1.0f, 1.0f };
+		std::vector<BoundingBox> crossing;
+		for (int i = 0; i < 3; i++)
+		{
+			low[axis] = 1.0f + i * 0.9f;
+			high[axis] = low[axis] + 1.5f;
+			crossing.push_back(MakeBox(low[0], low[1], low[2], high[0], high[1], high[2]));
+		}
+		BuildGrid(grid, crossing);
+
+		low[axis] = 1.9f;
+		high[axis] = 2.1f;
+		CheckQuery(grid, crossing, MakeBox(low[0], low[1], low[2], high[0], high[1], high[2]));
+		low[axis] = 3.5f;
+		high[axis] = 4.5f;
+		CheckQuery(grid, crossing, MakeBox(low[0], low[1], low[2], high[0], high[1], high[2]));
+	}
+
+	grid.Shutdown();
+}
+
+TEST(SpatialHashGrid_OversizedBoxesReturnedByEveryQuery)
+{
+	SpatialHashGridClass grid;
+	REQUIRE(grid.Initialize(GRID_TEST_CELL_SIZE));
+
+	//The first box covers 5x5x5 cells, too many to list, so it is kept aside.
+	std::vector<BoundingBox> boxes;
+	boxes.push_back(MakeBox(0.0f, 0.0f, 0.0f, 9.0f, 9.0f, 9.0f));
+	boxes.push_back(MakeBox(20.5f, 0.5f, 0.5f, 21.0f, 1.0f, 1.0f));
+	BuildGrid(grid, boxes);
+	CHECK_EQUAL(1, grid.GetCellCount());
+
+	std::vector<int> counts = QueryCounts(grid, 2, MakeBox(20.6f, 0.6f, 0.6f, 20.7f, 0.7f, 0.7f));
+	CHECK_EQUAL(1, counts[0]);
+	CHECK_EQUAL(1, counts[1]);
+
+	counts = QueryCounts(grid, 2, MakeBox(-50.0f, -50.0f, -50.0f, -49.9f, -49.9f, -49.9f));
+	CHECK_EQUAL(1, counts[0]);
+	CHECK_EQUAL(0, counts[1]);
+
+	//A query over more cells than there are boxes is given every box once.
+	counts = QueryCounts(grid, 2, MakeBox(-100.0f, -100.0f, -100.0f, 100.0f, 100.0f, 100.0f));
+	CHECK_EQUAL(1, counts[0]);
+	CHECK_EQUAL(1, counts[1]);
+
+	grid.Shutdown();
+}
+
+TEST(SpatialHashGrid_RejectsBadCellSize)
+{
+	SpatialHashGridClass grid;
+	CHECK(!grid.Initialize(0.0f));
+	CHECK(!grid.Initialize(-1.0f));
+	CHECK(grid.Initialize(GRID_TEST_CELL_SIZE));
+	CHECK_EQUAL(GRID_TEST_CELL_SIZE, grid.GetCellSize());
+}
@@ -0,0 +1,110 @@
+#pragma once
+//======================================================
+//				Filename: TestData.h
+//
+// Helpers shared by the tests for reading the engine's
+// data files and making .dds files of known layout.
+// Only standard headers are used, so the tests of the
+// .dds parser build on any OS.
+//======================================================
+
+
+//======================================================
+//					Include Guards.
+//======================================================
+#ifndef _TESTDATA_H_
+#define _TESTDATA_H_
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "../Engine/DDSFileClass.h"
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		ReadTestFile
+
+Summary:	Reads a whole file into memory.
+
+Args:		const char* filename
+				a filepath, relative to the EngineTests folder.
+			std::vector<uint8_t>& data
+				filled with the contents of the file.
+
+Returns:	bool
+				was the file read.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+inline bool ReadTestFile(const char* filename, std::vector<uint8_t>& data)
+{
+	FILE* file = fopen(filename, "rb");
+	if (!file)
+		return false;
+
+	fseek(file, 0, SEEK_END);
+	long size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	data.resize(size > 0 ? (size_t)size : 0);
+	bool read = size > 0 && fread(&data[0], 1, data.size(), file) == data.size();
+
+	fclose(file);
+	return read;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		MakeTestDDS
+
+Summary:	Makes a legacy .dds file of a B8G8R8A8_UNORM 2D texture with a
+			full or partial mip chain. Every byte of mip level n is n, so a
+			test can tell which level it was given.
+
+Args:		size_t width, height
+				the size of the top mip level.
+			size_t mips
+				the mip levels to write.
+
+Returns:	std::vector<uint8_t>
+				the whole file.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+inline std::vector<uint8_t> MakeTestDDS(size_t width, size_t height, size_t mips)
+{
+	DDS_HEADER header;
+	memset(&header, 0, sizeof(header));
+	header.size = sizeof(DDS_HEADER);
+	header.flags = DDS_WIDTH | DDS_HEIGHT;
+	header.width = (uint32_t)width;
+	header.height = (uint32_t)height;
+	header.mipMapCount = (uint32_t)mips;
+	header.ddspf.size = sizeof(DDS_PIXELFORMAT);
+	header.ddspf.flags = DDS_RGB | 0x1; //DDPF_ALPHAPIXELS.
+	header.ddspf.RGBBitCount = 32;
+	header.ddspf.RBitMask = 0x00ff0000;
+	header.ddspf.GBitMask = 0x0000ff00;
+	header.ddspf.BBitMask = 0x000000ff;
+	header.ddspf.ABitMask = 0xff000000;
+
+	std::vector<uint8_t> data(sizeof(uint32_t) + sizeof(DDS_HEADER));
+	memcpy(&data[0], &DDS_MAGIC, sizeof(uint32_t));
+	memcpy(&data[sizeof(uint32_t)], &header, sizeof(header));
+
+	for (size_t mip = 0; mip < mips; mip++)
+	{
+		data.insert(data.end(), width * height * 4, (uint8_t)mip);
+		width = width > 1 ? width / 2 : 1;
+		height = height > 1 ? height / 2 : 1;
+	}
+
+	return data;
+}
+
+#endif
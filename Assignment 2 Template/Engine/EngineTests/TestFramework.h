@@ -0,0 +1,108 @@
+#pragma once
+//======================================================
+//				Filename: TestFramework.h
+//======================================================
+
+
+//======================================================
+//					Include Guards.
+//======================================================
+#ifndef _TESTFRAMEWORK_H_
+#define _TESTFRAMEWORK_H_
+
+
+//======================================================
+//					Library Headers.
+//======================================================
+#include <stdio.h>
+#include <vector>
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		TestRegistry
+
+Summary:	Holds every test in the EngineTests program. Tests are declared
+			with TEST(name), which registers them before main() runs, and
+			use CHECK macros which report a failure and carry on, so one run
+			shows every broken check.
+
+Structs:	Test
+				the name of a test and the function that runs it.
+
+Methods:	==================== PUBLIC ====================
+			static std::vector<Test>& GetTests()
+				Use to get every registered test.
+			static bool& CurrentFailed()
+				Use to get whether the running test has failed a check.
+			static bool Fail(const char*, int, const char*)
+				Called by the CHECK macros to report a failed check.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class TestRegistry
+{
+public:
+	struct Test
+	{
+		const char* name;
+		void(*run)();
+	};
+
+public:
+	static std::vector<Test>& GetTests()
+	{
+		static std::vector<Test> tests;
+		return tests;
+	}
+
+	static bool& CurrentFailed()
+	{
+		static bool failed = false;
+		return failed;
+	}
+
+	static bool Fail(const char* file, int line, const char* expression)
+	{
+		printf("  %s(%d): check failed: %s\n", file, line, expression);
+		CurrentFailed() = true;
+		return false;
+	}
+};
+
+
+/*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+Class:		TestRegistrar
+
+Summary:	A static instance of this is made by TEST(name) to add the test
+			to the registry before main() runs.
+C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+class TestRegistrar
+{
+public:
+	TestRegistrar(const char* name, void(*run)())
+	{
+		TestRegistry::Test test = { name, run };
+		TestRegistry::GetTests().push_back(test);
+	}
+};
+
+
+//======================================================
+//					Macros.
+//======================================================
+#define TEST(name)																\
+	static void Test_##name();													\
+	static TestRegistrar Registrar_##name(#name, &Test_##name);					\
+	static void Test_##name()
+
+//Reports a failure if the expression is false. Evaluates to the expression.
+#define CHECK(expression)														\
+	((expression) ? true : TestRegistry::Fail(__FILE__, __LINE__, #expression))
+
+#define CHECK_EQUAL(expected, actual)											\
+	CHECK((expected) == (actual))
+
+//Reports a failure and leaves the test if the expression is false, for checks
+//later ones depend on.
+#define REQUIRE(expression)														\
+	do { if (!CHECK(expression)) return; } while (0)
+
+#endif
@@ -0,0 +1,34 @@
+//======================================================
+//				Filename: TestMain.cpp
+//
+// Runs every test registered with TEST(name). Run from
+// the EngineTests folder so the engine's data paths
+// resolve. Returns the number of failed tests.
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "TestFramework.h"
+
+
+int main()
+{
+	std::vector<TestRegistry::Test>& tests = TestRegistry::GetTests();
+	int failures = 0;
+
+	for (size_t i = 0; i < tests.size(); i++)
+	{
+		TestRegistry::CurrentFailed() = false;
+		tests[i].run();
+
+		printf("%s %s\n", TestRegistry::CurrentFailed() ? "FAIL" : "ok  ", tests[i].name);
+		if (TestRegistry::CurrentFailed())
+			failures++;
+	}
+
+	printf("%d of %d tests passed.\n", (int)tests.size() - failures, (int)tests.size());
+
+	return failures;
+}
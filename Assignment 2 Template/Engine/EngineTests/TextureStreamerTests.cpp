@@ -0,0 +1,308 @@
+//======================================================
+//				Filename: TextureStreamerTests.cpp
+//
+// Tests the residency, eviction order and budget of
+// TextureStreamerClass on a RecordingTextureStreamDevice,
+// with mapped 256x256 textures of 9 mip levels.
+//======================================================
+
+
+//======================================================
+//				User Defined Headers.
+//======================================================
+#include "TestFramework.h"
+#include "TestData.h"
+#include "../Engine/TextureStreamerClass.h"
+
+
+//======================================================
+//					Constants.
+//======================================================
+const int STREAM_TEST_SIZE = 256;
+const int STREAM_TEST_MIPS = 9;
+const int STREAM_TEST_TAIL = 64;
+
+//The bytes resident with the 64x64 tail, mip 2, as the finest level.
+const size_t STREAM_TEST_TAIL_BYTES = 16384 + 4096 + 1024 + 256 + 64 + 16 + 4;
+//The bytes resident with every level.
+const size_t STREAM_TEST_FULL_BYTES = 262144 + 65536 + STREAM_TEST_TAIL_BYTES;
+
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		MapTestFile
+
+Summary:	Writes data to a file in the EngineTests folder and maps it, the
+			way the engine maps its textures. The file is left behind and
+			overwritten by the next run.
+
+Args:		const wchar_t* filename
+				the name of the file to write.
+			const std::vector<uint8_t>& data
+				the contents of the file.
+
+Returns:	MappedFileClass*
+				the mapped file, or 0 on failure. Owned by the caller.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static MappedFileClass* MapTestFile(const wchar_t* filename, const std::vector<uint8_t>& data)
+{
+	char path[MAX_PATH];
+	if (wcstombs(path, filename, MAX_PATH) == (size_t)-1)
+		return 0;
+
+	FILE* file = fopen(path, "wb");
+	if (!file)
+		return 0;
+
+	bool written = fwrite(&data[0], 1, data.size(), file) == data.size();
+	fclose(file);
+	if (!written)
+		return 0;
+
+	MappedFileClass* mapped = new MappedFileClass;
+	if (!mapped->Open(filename))
+	{
+		delete mapped;
+		return 0;
+	}
+
+	return mapped;
+}
+
+/*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+Method:		RegisterTestTexture
+
+Summary:	Maps a 256x256 test texture and registers it with a streamer.
+
+Args:		TextureStreamerClass& streamer
+				the streamer to register with.
+			const wchar_t* filename
+				the file to write the texture to, unique to the texture.
+
+Returns:	int
+				the handle of the texture, or -1 on failure.
+M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+static int RegisterTestTexture(TextureStreamerClass& streamer, const wchar_t* filename)
+{
+	MappedFileClass* file = MapTestFile(filename, MakeTestDDS(STREAM_TEST_SIZE, STREAM_TEST_SIZE, STREAM_TEST_MIPS));
+	if (!file)
+		return -1;
+
+	int handle = streamer.Register(file);
+	if (handle < 0)
+		delete file;
+
+	return handle;
+}
+
+
+TEST(TextureStreamer_RegisterMakesTailResident)
+{
+	RecordingTextureStreamDevice device;
+	TextureStreamerClass streamer;
+	REQUIRE(streamer.Initialize(&device, 4 * STREAM_TEST_FULL_BYTES, STREAM_TEST_TAIL, 4));
+
+	int handle = RegisterTestTexture(streamer, L"test_stream_tail.dds");
+	REQUIRE(handle == 0);
+
+	//Only the levels no larger than the tail were uploaded.
+	REQUIRE(device.GetUploads().size() == 1);
+	CHECK_EQUAL(2u, device.GetUploads()[0].firstMip);
+	CHECK_EQUAL(STREAM_TEST_TAIL_BYTES, device.GetUploads()[0].bytes);
+
+	CHECK_EQUAL(2, streamer.GetResidentMip(handle));
+	CHECK(streamer.GetTexture(handle) == device.GetUploads()[0].texture);
+	CHECK_EQUAL(STREAM_TEST_TAIL_BYTES, streamer.GetResidentBytes());
+	CHECK_EQUAL(device.GetLiveBytes(), streamer.GetResidentBytes());
+
+	streamer.Shutdown();
+	CHECK_EQUAL(0, device.GetLiveTextures());
+}
+
+TEST(TextureStreamer_RegisterFailsWithoutDevice)
+{
+	RecordingTextureStreamDevice device;
+	TextureStreamerClass streamer;
+	REQUIRE(streamer.Initialize(&device, 4 * STREAM_TEST_FULL_BYTES, STREAM_TEST_TAIL, 4));
+
+	device.SetFailCreates(true);
+	CHECK_EQUAL(-1, RegisterTestTexture(streamer, L"test_stream_fail.dds"));
+	CHECK_EQUAL(0u, streamer.GetResidentBytes());
+	CHECK(streamer.GetTexture(0) == 0);
+
+	streamer.Shutdown();
+}
+
+TEST(TextureStreamer_RequestStreamsInFinerMips)
+{
+	RecordingTextureStreamDevice device;
+	TextureStreamerClass streamer;
+	REQUIRE(streamer.Initialize(&device, 4 * STREAM_TEST_FULL_BYTES, STREAM_TEST_TAIL, 4));
+
+	int handle = RegisterTestTexture(streamer, L"test_stream_request.dds");
+	REQUIRE(handle >= 0);
+	StreamTexture* tail = streamer.GetTexture(handle);
+	device.ClearLog();
+
+	//128 pixels on screen only needs mip 1.
+	streamer.RequestSize(handle, 128.0f);
+	streamer.Update();
+
+	REQUIRE(device.GetUploads().size() == 1);
+	CHECK_EQUAL(1u, device.GetUploads()[0].firstMip);
+	CHECK_EQUAL(1, streamer.GetResidentMip(handle));
+
+	//The tail texture was swapped out and released.
+	REQUIRE(device.GetReleases().size() == 1);
+	CHECK(device.GetReleases()[0] == tail);
+	CHECK_EQUAL(1, device.GetLiveTextures());
+	CHECK_EQUAL(STREAM_TEST_FULL_BYTES - 262144, streamer.GetResidentBytes());
+	CHECK_EQUAL(device.GetLiveBytes(), streamer.GetResidentBytes());
+
+	//Full size on screen needs every level.
+	streamer.RequestSize(handle, 256.0f);
+	streamer.Update();
+
+	CHECK_EQUAL(0, streamer.GetResidentMip(handle));
+	CHECK_EQUAL(STREAM_TEST_FULL_BYTES, streamer.GetResidentBytes());
+	CHECK_EQUAL(device.GetLiveBytes(), streamer.GetResidentBytes());
+
+	//Asking for less keeps what is resident.
+	device.ClearLog();
+	streamer.RequestSize(handle, 16.0f);
+	streamer.Update();
+
+	CHECK(device.GetUploads().empty());
+	CHECK_EQUAL(0, streamer.GetResidentMip(handle));
+
+	streamer.Shutdown();
+	CHECK_EQUAL(0, device.GetLiveTextures());
+}
+
+TEST(TextureStreamer_StaysWithinBudget)
+{
+	//Room for both tails and one texture's finer levels.
+	RecordingTextureStreamDevice device;
+	TextureStreamerClass streamer;
+	REQUIRE(streamer.Initialize(&device, STREAM_TEST_FULL_BYTES + STREAM_TEST_TAIL_BYTES, STREAM_TEST_TAIL, 4));
+
+	int a = RegisterTestTexture(streamer, L"test_stream_budget_a.dds");
+	int b = RegisterTestTexture(streamer, L"test_stream_budget_b.dds");
+	REQUIRE(a >= 0 && b >= 0);
+
+	//Both ask for every level in the same frame. The first is served, the
+	//second is in use so can't evict it and keeps its tail.
+	streamer.RequestSize(a, 256.0f);
+	streamer.RequestSize(b, 256.0f);
+	streamer.Update();
+
+	CHECK_EQUAL(0, streamer.GetResidentMip(a));
+	CHECK_EQUAL(2, streamer.GetResidentMip(b));
+	CHECK_EQUAL(STREAM_TEST_FULL_BYTES + STREAM_TEST_TAIL_BYTES, streamer.GetResidentBytes());
+	CHECK_EQUAL(device.GetLiveBytes(), streamer.GetResidentBytes());
+
+	//Next frame only the second is used, so the first drops to its tail.
+	streamer.RequestSize(b, 256.0f);
+	streamer.Update();
+
+	CHECK_EQUAL(2, streamer.GetResidentMip(a));
+	CHECK_EQUAL(0, streamer.GetResidentMip(b));
+	CHECK(streamer.GetResidentBytes() <= STREAM_TEST_FULL_BYTES + STREAM_TEST_TAIL_BYTES);
+	CHECK_EQUAL(device.GetLiveBytes(), streamer.GetResidentBytes());
+
+	streamer.Shutdown();
+	CHECK_EQUAL(0, device.GetLiveTextures());
+}
+
+TEST(TextureStreamer_SettlesForCoarserMipOverBudget)
+{
+	//Room for the tail and mip 1, but not mip 0.
+	RecordingTextureStreamDevice device;
+	TextureStreamerClass streamer;
+	REQUIRE(streamer.Initialize(&device, STREAM_TEST_FULL_BYTES - 1, STREAM_TEST_TAIL, 4));
+
+	int handle = RegisterTestTexture(streamer, L"test_stream_coarser.dds");
+	REQUIRE(handle >= 0);
+
+	streamer.RequestSize(handle, 256.0f);
+	streamer.Update();
+
+	CHECK_EQUAL(1, streamer.GetResidentMip(handle));
+	CHECK(streamer.GetResidentBytes() < STREAM_TEST_FULL_BYTES);
+	CHECK_EQUAL(device.GetLiveBytes(), streamer.GetResidentBytes());
+
+	streamer.Shutdown();
+}
+
+TEST(TextureStreamer_EvictsLeastRecentlyUsedFirst)
+{
+	//Room for three tails and two textures' finer levels.
+	RecordingTextureStreamDevice device;
+	TextureStreamerClass streamer;
+	size_t budget = 2 * STREAM_TEST_FULL_BYTES + STREAM_TEST_TAIL_BYTES;
+	REQUIRE(streamer.Initialize(&device, budget, STREAM_TEST_TAIL, 4));
+
+	int a = RegisterTestTexture(streamer, L"test_stream_lru_a.dds");
+	int b = RegisterTestTexture(streamer, L"test_stream_lru_b.dds");
+	int c = RegisterTestTexture(streamer, L"test_stream_lru_c.dds");
+	REQUIRE(a >= 0 && b >= 0 && c >= 0);
+
+	//Frame 0 uses a, frame 1 uses b.
+	streamer.RequestSize(a, 256.0f);
+	streamer.Update();
+	streamer.RequestSize(b, 256.0f);
+	streamer.Update();
+	REQUIRE(streamer.GetResidentMip(a) == 0 && streamer.GetResidentMip(b) == 0);
+
+	//Frame 2 uses c, which only fits if one goes. a was used longest ago.
+	StreamTexture* fullA = streamer.GetTexture(a);
+	device.ClearLog();
+	streamer.RequestSize(c, 256.0f);
+	streamer.Update();
+
+	CHECK_EQUAL(2, streamer.GetResidentMip(a));
+	CHECK_EQUAL(0, streamer.GetResidentMip(b));
+	CHECK_EQUAL(0, streamer.GetResidentMip(c));
+
+	//a was recreated at its tail before c was uploaded.
+	REQUIRE(device.GetUploads().size() == 2);
+	CHECK(device.GetUploads()[0].texture == streamer.GetTexture(a));
+	CHECK_EQUAL(2u, device.GetUploads()[0].firstMip);
+	CHECK(device.GetUploads()[1].texture == streamer.GetTexture(c));
+	CHECK_EQUAL(0u, device.GetUploads()[1].firstMip);
+	CHECK(device.GetReleases()[0] == fullA);
+
+	CHECK(streamer.GetResidentBytes() <= budget);
+	CHECK_EQUAL(device.GetLiveBytes(), streamer.GetResidentBytes());
+
+	streamer.Shutdown();
+	CHECK_EQUAL(0, device.GetLiveTextures());
+}
+
+TEST(TextureStreamer_LimitsUploadsPerFrame)
+{
+	RecordingTextureStreamDevice device;
+	TextureStreamerClass streamer;
+	REQUIRE(streamer.Initialize(&device, 4 * STREAM_TEST_FULL_BYTES, STREAM_TEST_TAIL, 1));
+
+	int a = RegisterTestTexture(streamer, L"test_stream_limit_a.dds");
+	int b = RegisterTestTexture(streamer, L"test_stream_limit_b.dds");
+	REQUIRE(a >= 0 && b >= 0);
+	device.ClearLog();
+
+	//b is further from what it asks for, so it goes first.
+	streamer.RequestSize(a, 128.0f);
+	streamer.RequestSize(b, 256.0f);
+	streamer.Update();
+
+	CHECK_EQUAL(1u, device.GetUploads().size());
+	CHECK_EQUAL(2, streamer.GetResidentMip(a));
+	CHECK_EQUAL(0, streamer.GetResidentMip(b));
+
+	//a is served the next frame it asks.
+	streamer.RequestSize(a, 128.0f);
+	streamer.Update();
+
+	CHECK_EQUAL(1, streamer.GetResidentMip(a));
+
+	streamer.Shutdown();
+}